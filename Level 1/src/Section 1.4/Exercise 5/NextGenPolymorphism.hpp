@@ -5,11 +5,11 @@
 #ifndef ADVANCED_CPP_AND_MODERN_DESIGN_NEXTGENPOLYMORPHISM_HPP
 #define ADVANCED_CPP_AND_MODERN_DESIGN_NEXTGENPOLYMORPHISM_HPP
 
-#include <functional>
+#include "InplaceFunction.hpp"
 
-// using declaration to simplify code readability
+// using declaration to simplify code readability; the ctor's this->func = func copies the lambda without allocating
 template<typename T>
-using FunctionType = std::function<T (const T& t)>;
+using FunctionType = InplaceFunction<T (const T& t)>;
 
 /**
  * Illustrates a next generation design pattern using function wrappers to replace
@@ -2,15 +2,11 @@
 // Created by Michael Lewis on 6/3/23.
 //
 
-#include <functional>
+#include <cassert>
 #include <iostream>
 
 #include "NextGenPolymorphism.hpp"
 
-// using alias to simply readability of function wrapper
-template<typename T>
-using FunctionType = std::function<T (const T& t)>;
-
 /**
  * Test next generation design patterns to square a number using a composed function wrapper
  */
@@ -284,10 +284,10 @@ bool BitMatrix<M, N>::none() const noexcept
  * @tparam M The number of columns in this BitMatrix
  * @tparam N The number of rows in this BitMatrix
  * @param row The target row for this BitMatrix
- * @return std::bitset
+ * @return A const reference to the std::bitset in the specified row (no copy is made)
  */
 template<size_t M, size_t N>
-constexpr std::bitset<M> BitMatrix<M, N>::operator[](std::size_t row) const
+constexpr const std::bitset<M>& BitMatrix<M, N>::operator[](std::size_t row) const
 {
     return bitMatrix[row];
 }
@@ -299,7 +299,7 @@ constexpr std::bitset<M> BitMatrix<M, N>::operator[](std::size_t row) const
  * @return A list where each element represents the number of bits that are set to true in the corresponding bitset
  */
 template<size_t M, size_t N>
-std::list<size_t>&& BitMatrix<M, N>::count() const noexcept
+std::list<size_t> BitMatrix<M, N>::count() const
 {
     std::list<size_t> count;
     for (int i = 0; i < bitMatrix.size(); ++i)
@@ -307,7 +307,7 @@ std::list<size_t>&& BitMatrix<M, N>::count() const noexcept
         count.push_back(bitMatrix[i].count());
     }
 
-    return std::move(count);
+    return count;
 }
 
 #endif
\ No newline at end of file
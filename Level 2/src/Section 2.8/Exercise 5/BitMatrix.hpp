@@ -47,8 +47,8 @@ public:
     bool all() const noexcept;
     bool any() const noexcept;
     bool none() const noexcept;
-    constexpr std::bitset<M> operator[](std::size_t row) const;
-    std::list<std::size_t>&& count() const noexcept;
+    constexpr const std::bitset<M>& operator[](std::size_t row) const;
+    std::list<std::size_t> count() const;
 
 };
 
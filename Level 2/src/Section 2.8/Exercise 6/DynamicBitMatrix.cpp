@@ -0,0 +1,653 @@
+//
+// A DynamicBitMatrix is a runtime-sized matrix of bits stored as contiguous 64-bit words.
+// Each row is padded to a whole number of cache lines and the buffer itself is cache aligned, so
+// every row starts on a 64 byte boundary and row-wise boolean algebra can run over aligned SIMD lanes.
+// Bit j of a row is stored at bit (j % 64) of word (j / 64), i.e. little endian like std::bitset.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "DynamicBitMatrix.hpp"
+
+namespace
+{
+    using word_type = DynamicBitMatrix::word_type;
+
+    enum class BitOp { And, Or, Xor };
+
+    /**
+     * Combines two word arrays in place (dst = dst op src). Both arrays must be cache aligned and the word
+     * count must be a multiple of DynamicBitMatrix::WORDS_PER_LINE, which every DynamicBitMatrix guarantees.
+     * @tparam Op The boolean operation to apply to each pair of words
+     * @param dst The destination (and left hand operand) words
+     * @param src The right hand operand words
+     * @param n The number of words to combine
+     */
+    template<BitOp Op>
+    inline void combine(word_type* dst, const word_type* src, std::size_t n) noexcept
+    {
+#if defined(__AVX2__)
+        for (std::size_t i = 0; i < n; i += 4)
+        {
+            __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i));
+            __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i));
+            if constexpr (Op == BitOp::And) a = _mm256_and_si256(a, b);
+            else if constexpr (Op == BitOp::Or) a = _mm256_or_si256(a, b);
+            else a = _mm256_xor_si256(a, b);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), a);
+        }
+#elif defined(__SSE2__)
+        for (std::size_t i = 0; i < n; i += 2)
+        {
+            __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(dst + i));
+            __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(src + i));
+            if constexpr (Op == BitOp::And) a = _mm_and_si128(a, b);
+            else if constexpr (Op == BitOp::Or) a = _mm_or_si128(a, b);
+            else a = _mm_xor_si128(a, b);
+            _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), a);
+        }
+#else
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if constexpr (Op == BitOp::And) dst[i] &= src[i];
+            else if constexpr (Op == BitOp::Or) dst[i] |= src[i];
+            else dst[i] ^= src[i];
+        }
+#endif
+    }
+
+    /**
+     * Inverts every word of an array in place. Padding bits must be cleared by the caller afterwards.
+     * @param dst The words to invert
+     * @param n The number of words to invert
+     */
+    inline void invert(word_type* dst, std::size_t n) noexcept
+    {
+#if defined(__AVX2__)
+        const __m256i ones = _mm256_set1_epi64x(-1);
+        for (std::size_t i = 0; i < n; i += 4)
+        {
+            __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(a, ones));
+        }
+#elif defined(__SSE2__)
+        const __m128i ones = _mm_set1_epi64x(-1);
+        for (std::size_t i = 0; i < n; i += 2)
+        {
+            __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(dst + i));
+            _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(a, ones));
+        }
+#else
+        for (std::size_t i = 0; i < n; ++i) dst[i] = ~dst[i];
+#endif
+    }
+
+    /**
+     * Counts the set bits in an array of words
+     * @param src The words to count
+     * @param n The number of words to count
+     * @return The total number of set bits
+     */
+    inline std::size_t popcount(const word_type* src, std::size_t n) noexcept
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < n; ++i) total += std::popcount(src[i]);
+        return total;
+    }
+
+    // Number of words needed to hold a row of cols bits, rounded up to a whole cache line
+    inline std::size_t strideFor(std::size_t cols) noexcept
+    {
+        std::size_t used = (cols + DynamicBitMatrix::WORD_BITS - 1) / DynamicBitMatrix::WORD_BITS;
+        std::size_t lines = (used + DynamicBitMatrix::WORDS_PER_LINE - 1) / DynamicBitMatrix::WORDS_PER_LINE;
+        return lines * DynamicBitMatrix::WORDS_PER_LINE;
+    }
+}
+
+/**
+ * Allocates a zero-initialised, cache aligned array of words
+ * @param count The number of words to allocate
+ * @return An owning pointer to the words, or an empty pointer when count is zero
+ */
+std::unique_ptr<word_type[], DynamicBitMatrix::AlignedDeleter> DynamicBitMatrix::allocate(std::size_t count)
+{
+    if (count == 0) return {};
+
+    auto* ptr = static_cast<word_type*>(::operator new[](count * sizeof(word_type), std::align_val_t{CACHE_LINE}));
+    std::memset(ptr, 0, count * sizeof(word_type));
+    return std::unique_ptr<word_type[], AlignedDeleter>{ptr};
+}
+
+/**
+ * Default ctor. Creates an empty 0x0 DynamicBitMatrix
+ */
+DynamicBitMatrix::DynamicBitMatrix() : rows{0}, cols{0}, stride{0}, words{}
+{
+
+}
+
+/**
+ * Overloaded ctor
+ * @param rows The number of rows in this DynamicBitMatrix
+ * @param cols The number of columns in this DynamicBitMatrix
+ * @param value The initial value of every bit
+ */
+DynamicBitMatrix::DynamicBitMatrix(std::size_t rows, std::size_t cols, bool value)
+    : rows{rows}, cols{cols}, stride{strideFor(cols)}, words{allocate(rows * strideFor(cols))}
+{
+    if (value) set();
+}
+
+/**
+ * Copy ctor
+ * @param source A DynamicBitMatrix whose bits will be deep copied into this DynamicBitMatrix
+ */
+DynamicBitMatrix::DynamicBitMatrix(const DynamicBitMatrix& source)
+    : rows{source.rows}, cols{source.cols}, stride{source.stride}, words{allocate(source.rows * source.stride)}
+{
+    if (words) std::memcpy(words.get(), source.words.get(), rows * stride * sizeof(word_type));
+}
+
+/**
+ * Move ctor
+ * @param source A DynamicBitMatrix whose storage will be moved into this DynamicBitMatrix
+ */
+DynamicBitMatrix::DynamicBitMatrix(DynamicBitMatrix&& source) noexcept
+    : rows{source.rows}, cols{source.cols}, stride{source.stride}, words{std::move(source.words)}
+{
+    source.rows = source.cols = source.stride = 0;
+}
+
+/**
+ * Copy assignment operator
+ * @param source A DynamicBitMatrix whose bits will be deep copied into this DynamicBitMatrix
+ * @return A reference to this DynamicBitMatrix
+ */
+DynamicBitMatrix& DynamicBitMatrix::operator=(const DynamicBitMatrix& source)
+{
+    // Avoid self assignment
+    if (this == &source) return *this;
+
+    DynamicBitMatrix copy{source};
+    *this = std::move(copy);
+    return *this;
+}
+
+/**
+ * Move assignment operator
+ * @param source A DynamicBitMatrix whose storage will be moved into this DynamicBitMatrix
+ * @return A reference to this DynamicBitMatrix
+ */
+DynamicBitMatrix& DynamicBitMatrix::operator=(DynamicBitMatrix&& source) noexcept
+{
+    // Avoid self assignment
+    if (this == &source) return *this;
+
+    rows = source.rows;
+    cols = source.cols;
+    stride = source.stride;
+    words = std::move(source.words);
+    source.rows = source.cols = source.stride = 0;
+    return *this;
+}
+
+/**
+ * Equality comparison between two DynamicBitMatrix objects
+ * @param other The DynamicBitMatrix used as the rhs in the comparison
+ * @return True if both matrices have the same shape and the same bits; false otherwise.
+ */
+bool DynamicBitMatrix::operator==(const DynamicBitMatrix& other) const noexcept
+{
+    if (rows != other.rows || cols != other.cols) return false;
+    if (rows * stride == 0) return true;
+    return std::memcmp(words.get(), other.words.get(), rows * stride * sizeof(word_type)) == 0;
+}
+
+/**
+ * Sets the bits to the result of binary AND on corresponding pairs of bits of *this and other.
+ * @param other A DynamicBitMatrix with the same shape as this DynamicBitMatrix
+ * @return A reference to this DynamicBitMatrix
+ */
+DynamicBitMatrix& DynamicBitMatrix::operator&=(const DynamicBitMatrix& other)
+{
+    checkShape(other);
+    combine<BitOp::And>(words.get(), other.words.get(), rows * stride);
+    return *this;
+}
+
+/**
+ * Sets the bits to the result of binary OR on corresponding pairs of bits of *this and other.
+ * @param other A DynamicBitMatrix with the same shape as this DynamicBitMatrix
+ * @return A reference to this DynamicBitMatrix
+ */
+DynamicBitMatrix& DynamicBitMatrix::operator|=(const DynamicBitMatrix& other)
+{
+    checkShape(other);
+    combine<BitOp::Or>(words.get(), other.words.get(), rows * stride);
+    return *this;
+}
+
+/**
+ * Sets the bits to the result of binary XOR on corresponding pairs of bits of *this and other.
+ * @param other A DynamicBitMatrix with the same shape as this DynamicBitMatrix
+ * @return A reference to this DynamicBitMatrix
+ */
+DynamicBitMatrix& DynamicBitMatrix::operator^=(const DynamicBitMatrix& other)
+{
+    checkShape(other);
+    combine<BitOp::Xor>(words.get(), other.words.get(), rows * stride);
+    return *this;
+}
+
+/**
+ * Unary negation of this DynamicBitMatrix
+ * @return A new DynamicBitMatrix containing the complement of every bit in this DynamicBitMatrix
+ */
+DynamicBitMatrix DynamicBitMatrix::operator~() const
+{
+    DynamicBitMatrix complement{*this};
+    complement.flip();
+    return complement;
+}
+
+/**
+ * Unchecked element access
+ * @param row The row index
+ * @param col The column index
+ * @return The value of the bit at (row, col)
+ */
+bool DynamicBitMatrix::operator()(std::size_t row, std::size_t col) const noexcept
+{
+    return (words[row * stride + col / WORD_BITS] >> (col % WORD_BITS)) & 1U;
+}
+
+/**
+ * A non-owning view over the words of one row. No bits are copied.
+ * @param row The row index
+ * @return A span covering wordsPerRow() words
+ */
+std::span<const word_type> DynamicBitMatrix::row(std::size_t row) const noexcept
+{
+    return {words.get() + row * stride, stride};
+}
+
+/**
+ * A mutable non-owning view over the words of one row. Callers must leave the padding bits cleared.
+ * @param row The row index
+ * @return A span covering wordsPerRow() words
+ */
+std::span<word_type> DynamicBitMatrix::row(std::size_t row) noexcept
+{
+    return {words.get() + row * stride, stride};
+}
+
+/**
+ * Checked element access
+ * @param row The row index
+ * @param col The column index
+ * @return The value of the bit at (row, col)
+ */
+bool DynamicBitMatrix::test(std::size_t row, std::size_t col) const
+{
+    checkBounds(row, col);
+    return (*this)(row, col);
+}
+
+/**
+ * Sets all bits to true
+ * @return A reference to this DynamicBitMatrix
+ */
+DynamicBitMatrix& DynamicBitMatrix::set() noexcept
+{
+    if (words) std::memset(words.get(), 0xFF, rows * stride * sizeof(word_type));
+    clearPadding();
+    return *this;
+}
+
+/**
+ * Sets one bit to the specified value
+ * @param row The row index to be set
+ * @param col The column index to be set
+ * @param value The new value of the specified bit
+ * @return A reference to this DynamicBitMatrix
+ */
+DynamicBitMatrix& DynamicBitMatrix::set(std::size_t row, std::size_t col, bool value)
+{
+    checkBounds(row, col);
+    word_type& word = words[row * stride + col / WORD_BITS];
+    word_type mask = word_type{1} << (col % WORD_BITS);
+    word = value ? (word | mask) : (word & ~mask);
+    return *this;
+}
+
+/**
+ * Sets all bits to false
+ * @return A reference to this DynamicBitMatrix
+ */
+DynamicBitMatrix& DynamicBitMatrix::reset() noexcept
+{
+    if (words) std::memset(words.get(), 0, rows * stride * sizeof(word_type));
+    return *this;
+}
+
+/**
+ * Sets one bit to false
+ * @param row The row index to be reset
+ * @param col The column index to be reset
+ * @return A reference to this DynamicBitMatrix
+ */
+DynamicBitMatrix& DynamicBitMatrix::reset(std::size_t row, std::size_t col)
+{
+    return set(row, col, false);
+}
+
+/**
+ * Flips all bits (like operator~, but in-place)
+ * @return A reference to this DynamicBitMatrix
+ */
+DynamicBitMatrix& DynamicBitMatrix::flip() noexcept
+{
+    invert(words.get(), rows * stride);
+    clearPadding();
+    return *this;
+}
+
+/**
+ * Flips one bit
+ * @param row The row index to be flipped
+ * @param col The column index to be flipped
+ * @return A reference to this DynamicBitMatrix
+ */
+DynamicBitMatrix& DynamicBitMatrix::flip(std::size_t row, std::size_t col)
+{
+    checkBounds(row, col);
+    words[row * stride + col / WORD_BITS] ^= word_type{1} << (col % WORD_BITS);
+    return *this;
+}
+
+/**
+ * Checks if any bits are set to true
+ * @return true if any of the bits are set to true, otherwise false.
+ */
+bool DynamicBitMatrix::any() const noexcept
+{
+    const word_type* begin = words.get();
+    return std::any_of(begin, begin + rows * stride, [](word_type w) { return w != 0; });
+}
+
+/**
+ * Checks if none of the bits are set to true
+ * @return true if none of the bits are set to true, otherwise false.
+ */
+bool DynamicBitMatrix::none() const noexcept
+{
+    return !any();
+}
+
+/**
+ * Returns the number of bits that are set to true
+ * @return The population count of the whole DynamicBitMatrix
+ */
+std::size_t DynamicBitMatrix::count() const noexcept
+{
+    return popcount(words.get(), rows * stride);
+}
+
+/**
+ * Returns the number of bits that are set to true in one row
+ * @param row The row index
+ * @return The population count of the row
+ */
+std::size_t DynamicBitMatrix::count(std::size_t row) const
+{
+    if (row >= rows)
+    {
+        throw std::out_of_range("row is out of range. row must be between [0," + std::to_string(rows) + ")");
+    }
+
+    return popcount(words.get() + row * stride, stride);
+}
+
+/**
+ * Returns the number of bits that are set to true in every row
+ * @return A vector where element i is the population count of row i
+ */
+std::vector<std::size_t> DynamicBitMatrix::rowCounts() const
+{
+    std::vector<std::size_t> counts(rows);
+    for (std::size_t i = 0; i < rows; ++i) counts[i] = popcount(words.get() + i * stride, stride);
+    return counts;
+}
+
+/**
+ * Returns the number of bits that are set to true in every column. Each 64x64 block is transposed in
+ * registers so that a column becomes a word and can be counted with a single popcount.
+ * @return A vector where element j is the population count of column j
+ */
+std::vector<std::size_t> DynamicBitMatrix::columnCounts() const
+{
+    std::vector<std::size_t> counts(cols, 0);
+    const std::size_t usedWords = (cols + WORD_BITS - 1) / WORD_BITS;
+    word_type block[WORD_BITS];
+
+    for (std::size_t rb = 0; rb < rows; rb += WORD_BITS)
+    {
+        const std::size_t height = std::min(WORD_BITS, rows - rb);
+        for (std::size_t w = 0; w < usedWords; ++w)
+        {
+            for (std::size_t r = 0; r < WORD_BITS; ++r) block[r] = r < height ? words[(rb + r) * stride + w] : 0;
+            transpose64(block);
+
+            const std::size_t width = std::min(WORD_BITS, cols - w * WORD_BITS);
+            for (std::size_t c = 0; c < width; ++c) counts[w * WORD_BITS + c] += std::popcount(block[c]);
+        }
+    }
+
+    return counts;
+}
+
+/**
+ * Transposes this DynamicBitMatrix one 64x64 block at a time
+ * @return A new cols x rows DynamicBitMatrix
+ */
+DynamicBitMatrix DynamicBitMatrix::transpose() const
+{
+    DynamicBitMatrix result{cols, rows};
+    const std::size_t usedWords = (cols + WORD_BITS - 1) / WORD_BITS;
+    word_type block[WORD_BITS];
+
+    for (std::size_t rb = 0; rb < rows; rb += WORD_BITS)
+    {
+        const std::size_t height = std::min(WORD_BITS, rows - rb);
+        for (std::size_t w = 0; w < usedWords; ++w)
+        {
+            for (std::size_t r = 0; r < WORD_BITS; ++r) block[r] = r < height ? words[(rb + r) * stride + w] : 0;
+            transpose64(block);
+
+            const std::size_t width = std::min(WORD_BITS, cols - w * WORD_BITS);
+            for (std::size_t c = 0; c < width; ++c)
+            {
+                result.words[(w * WORD_BITS + c) * result.stride + rb / WORD_BITS] = block[c];
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Boolean matrix product C = A * B, where C(i, j) = OR_k (A(i, k) AND B(k, j)), using the Method of
+ * Four Russians. The inner dimension is processed 8 bits at a time: for each group of 8 rows of B a
+ * table holding the OR of every subset of those rows is built in increasing order, each entry being an
+ * earlier one (the subset without its lowest row) ORed with one row, after which each row of A needs a
+ * single table lookup and one row-wide OR per group.
+ * @param other The rhs matrix B. other.rowCount() must equal columnCount()
+ * @return A new rowCount() x other.columnCount() DynamicBitMatrix
+ */
+DynamicBitMatrix DynamicBitMatrix::multiply(const DynamicBitMatrix& other) const
+{
+    if (cols != other.rows)
+    {
+        throw std::invalid_argument("Inner dimensions do not agree: " + std::to_string(cols) + " != " +
+                                    std::to_string(other.rows));
+    }
+
+    constexpr std::size_t GROUP = 8;
+    constexpr std::size_t TABLE_SIZE = std::size_t{1} << GROUP;
+
+    DynamicBitMatrix product{rows, other.cols};
+    if (rows == 0 || other.cols == 0) return product;
+
+    const std::size_t bStride = other.stride;
+    auto table = allocate(TABLE_SIZE * bStride);
+
+    for (std::size_t k = 0; k < cols; k += GROUP)
+    {
+        // Build the subset table for rows [k, k + GROUP) of B. Entry 0 stays empty.
+        const std::size_t groupSize = std::min(GROUP, cols - k);
+        const std::size_t entries = std::size_t{1} << groupSize;
+        for (std::size_t s = 1; s < entries; ++s)
+        {
+            const std::size_t lowest = std::countr_zero(s);
+            word_type* entry = table.get() + s * bStride;
+            std::memcpy(entry, table.get() + (s & (s - 1)) * bStride, bStride * sizeof(word_type));
+            combine<BitOp::Or>(entry, other.words.get() + (k + lowest) * bStride, bStride);
+        }
+
+        // Each row of A contributes the table entry selected by its 8 bits of the inner dimension
+        const std::size_t wordIndex = k / WORD_BITS;
+        const std::size_t shift = k % WORD_BITS;
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            const std::size_t key = (words[i * stride + wordIndex] >> shift) & (TABLE_SIZE - 1);
+            if (key != 0) combine<BitOp::Or>(product.words.get() + i * bStride, table.get() + key * bStride, bStride);
+        }
+    }
+
+    return product;
+}
+
+/**
+ * The transitive closure R+ of a square relation R, computed by repeated squaring (R = R | R * R) until
+ * a fixed point is reached. Converges after at most ceil(log2(n)) + 1 products.
+ * @return A new DynamicBitMatrix where (i, j) is set if j is reachable from i by a path of length >= 1
+ */
+DynamicBitMatrix DynamicBitMatrix::transitiveClosure() const
+{
+    if (rows != cols)
+    {
+        throw std::invalid_argument("Transitive closure requires a square matrix");
+    }
+
+    DynamicBitMatrix closure{*this};
+    while (true)
+    {
+        DynamicBitMatrix next = closure.multiply(closure);
+        next |= closure;
+        if (next == closure) break;
+        closure = std::move(next);
+    }
+
+    return closure;
+}
+
+/**
+ * Creates a square identity DynamicBitMatrix
+ * @param size The number of rows and columns
+ * @return A new DynamicBitMatrix with only the diagonal set
+ */
+DynamicBitMatrix DynamicBitMatrix::identity(std::size_t size)
+{
+    DynamicBitMatrix result{size, size};
+    for (std::size_t i = 0; i < size; ++i) result.set(i, i);
+    return result;
+}
+
+/**
+ * Transposes a 64x64 bit block in place, where bit c of block[r] is element (r, c). The off-diagonal
+ * quadrants are swapped recursively with masks of 32, 16, 8, 4, 2 and 1 bits (Hacker's Delight 7-3),
+ * i.e. 6 * 32 word swaps instead of 4096 single bit moves.
+ * @param block The 64 words of the block
+ */
+void DynamicBitMatrix::transpose64(word_type block[WORD_BITS]) noexcept
+{
+    word_type mask = 0x00000000FFFFFFFFULL;
+    for (std::size_t j = 32; j != 0; j >>= 1, mask ^= (mask << j))
+    {
+        for (std::size_t k = 0; k < WORD_BITS; k = ((k | j) + 1) & ~j)
+        {
+            word_type t = ((block[k] >> j) ^ block[k | j]) & mask;
+            block[k] ^= t << j;
+            block[k | j] ^= t;
+        }
+    }
+}
+
+/**
+ * Inserts the matrix, one row per line with column 0 on the left
+ * @param out The output stream
+ * @param matrix The DynamicBitMatrix to insert into the stream
+ * @return The output stream
+ */
+std::ostream& operator<<(std::ostream& out, const DynamicBitMatrix& matrix)
+{
+    for (std::size_t i = 0; i < matrix.rows; ++i)
+    {
+        for (std::size_t j = 0; j < matrix.cols; ++j) out << (matrix(i, j) ? '1' : '0');
+        out << "\n";
+    }
+
+    return out;
+}
+
+// ********** Private helpers **********
+
+// Mask of the bits in the last used word of a row that belong to the matrix
+word_type DynamicBitMatrix::tailMask() const noexcept
+{
+    const std::size_t tail = cols % WORD_BITS;
+    return tail == 0 ? ~word_type{0} : (word_type{1} << tail) - 1;
+}
+
+// Clears the bits beyond the last column so that counts, comparisons and products stay exact
+void DynamicBitMatrix::clearPadding() noexcept
+{
+    const std::size_t usedWords = (cols + WORD_BITS - 1) / WORD_BITS;
+    const word_type mask = tailMask();
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        word_type* rowWords = words.get() + i * stride;
+        if (usedWords > 0) rowWords[usedWords - 1] &= mask;
+        std::fill(rowWords + usedWords, rowWords + stride, 0);
+    }
+}
+
+void DynamicBitMatrix::checkBounds(std::size_t row, std::size_t col) const
+{
+    if (row >= rows)
+    {
+        throw std::out_of_range("row is out of range. row must be between [0," + std::to_string(rows) + ")");
+    }
+    else if (col >= cols)
+    {
+        throw std::out_of_range("col is out of range. col must be between [0," + std::to_string(cols) + ")");
+    }
+}
+
+void DynamicBitMatrix::checkShape(const DynamicBitMatrix& other) const
+{
+    if (rows != other.rows || cols != other.cols)
+    {
+        throw std::invalid_argument("DynamicBitMatrix shapes do not agree");
+    }
+}
@@ -0,0 +1,104 @@
+//
+// A DynamicBitMatrix is a runtime-sized matrix of bits stored as contiguous 64-bit words.
+// Each row is padded to a whole number of cache lines and the buffer itself is cache aligned, so
+// every row starts on a 64 byte boundary and row-wise boolean algebra can run over aligned SIMD lanes.
+// Bit j of a row is stored at bit (j % 64) of word (j / 64), i.e. little endian like std::bitset.
+//
+// Unlike BitMatrix<M, N>, the dimensions are chosen at runtime, rows are accessed without copying, and
+// the class offers a 64x64 block transpose, a boolean matrix product (Method of Four Russians) and a
+// transitive closure built on top of the product.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_DYNAMICBITMATRIX_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_DYNAMICBITMATRIX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <span>
+#include <vector>
+
+class DynamicBitMatrix
+{
+public:
+    using word_type = std::uint64_t;
+    static constexpr std::size_t WORD_BITS = 64;
+    static constexpr std::size_t CACHE_LINE = 64;
+    static constexpr std::size_t WORDS_PER_LINE = CACHE_LINE / sizeof(word_type);
+
+private:
+    // Releases storage obtained from the aligned form of operator new
+    struct AlignedDeleter
+    {
+        void operator()(word_type* ptr) const noexcept { ::operator delete[](ptr, std::align_val_t{CACHE_LINE}); }
+    };
+
+    std::size_t rows;
+    std::size_t cols;
+    std::size_t stride;     // Words per row, rounded up to a whole cache line
+    std::unique_ptr<word_type[], AlignedDeleter> words;
+
+    static std::unique_ptr<word_type[], AlignedDeleter> allocate(std::size_t count);
+    word_type tailMask() const noexcept;
+    void clearPadding() noexcept;
+    void checkBounds(std::size_t row, std::size_t col) const;
+    void checkShape(const DynamicBitMatrix& other) const;
+
+public:
+    DynamicBitMatrix();
+    DynamicBitMatrix(std::size_t rows, std::size_t cols, bool value = false);
+    DynamicBitMatrix(const DynamicBitMatrix& source);
+    DynamicBitMatrix(DynamicBitMatrix&& source) noexcept;
+    ~DynamicBitMatrix() = default;
+
+    // Operator overloads
+    DynamicBitMatrix& operator=(const DynamicBitMatrix& source);
+    DynamicBitMatrix& operator=(DynamicBitMatrix&& source) noexcept;
+    bool operator==(const DynamicBitMatrix& other) const noexcept;
+    DynamicBitMatrix& operator&=(const DynamicBitMatrix& other);
+    DynamicBitMatrix& operator|=(const DynamicBitMatrix& other);
+    DynamicBitMatrix& operator^=(const DynamicBitMatrix& other);
+    DynamicBitMatrix operator~() const;
+    bool operator()(std::size_t row, std::size_t col) const noexcept;
+
+    // Accessors
+    std::size_t rowCount() const noexcept { return rows; }
+    std::size_t columnCount() const noexcept { return cols; }
+    std::size_t wordsPerRow() const noexcept { return stride; }
+    std::span<const word_type> row(std::size_t row) const noexcept;
+    std::span<word_type> row(std::size_t row) noexcept;
+    bool test(std::size_t row, std::size_t col) const;
+
+    // Mutators
+    DynamicBitMatrix& set() noexcept;
+    DynamicBitMatrix& set(std::size_t row, std::size_t col, bool value = true);
+    DynamicBitMatrix& reset() noexcept;
+    DynamicBitMatrix& reset(std::size_t row, std::size_t col);
+    DynamicBitMatrix& flip() noexcept;
+    DynamicBitMatrix& flip(std::size_t row, std::size_t col);
+
+    // Population counts
+    bool any() const noexcept;
+    bool none() const noexcept;
+    std::size_t count() const noexcept;
+    std::size_t count(std::size_t row) const;
+    std::vector<std::size_t> rowCounts() const;
+    std::vector<std::size_t> columnCounts() const;
+
+    // Matrix algebra
+    DynamicBitMatrix transpose() const;
+    DynamicBitMatrix multiply(const DynamicBitMatrix& other) const;
+    DynamicBitMatrix transitiveClosure() const;
+
+    // Utilities
+    static DynamicBitMatrix identity(std::size_t size);
+    static void transpose64(word_type block[WORD_BITS]) noexcept;
+
+    friend std::ostream& operator<<(std::ostream& out, const DynamicBitMatrix& matrix);
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_DYNAMICBITMATRIX_HPP
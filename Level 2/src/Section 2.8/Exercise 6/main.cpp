@@ -0,0 +1,220 @@
+//
+// Tests for the runtime-sized, word-packed DynamicBitMatrix. Products, transposes and closures are
+// checked against straightforward bit-by-bit reference implementations.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <cassert>
+#include <iostream>
+#include <random>
+
+#include "DynamicBitMatrix.hpp"
+#include "StopWatch.hpp"
+
+// Fills a DynamicBitMatrix with random bits where each bit is set with the given probability
+DynamicBitMatrix random(std::size_t rows, std::size_t cols, double density, std::mt19937_64& engine)
+{
+    std::bernoulli_distribution coin{density};
+    DynamicBitMatrix m{rows, cols};
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        for (std::size_t j = 0; j < cols; ++j)
+        {
+            if (coin(engine)) m.set(i, j);
+        }
+    }
+
+    return m;
+}
+
+// Reference boolean product computed one bit at a time
+DynamicBitMatrix naiveMultiply(const DynamicBitMatrix& a, const DynamicBitMatrix& b)
+{
+    DynamicBitMatrix c{a.rowCount(), b.columnCount()};
+    for (std::size_t i = 0; i < a.rowCount(); ++i)
+    {
+        for (std::size_t j = 0; j < b.columnCount(); ++j)
+        {
+            for (std::size_t k = 0; k < a.columnCount(); ++k)
+            {
+                if (a(i, k) && b(k, j))
+                {
+                    c.set(i, j);
+                    break;
+                }
+            }
+        }
+    }
+
+    return c;
+}
+
+void test_ValueConstructor()
+{
+    DynamicBitMatrix m1{3, 70, true};
+    assert(3 == m1.rowCount());
+    assert(70 == m1.columnCount());
+    assert(8 == m1.wordsPerRow());   // Rows are padded to a whole cache line
+    assert(210 == m1.count());
+    assert(70 == m1.count(2));
+
+    DynamicBitMatrix m2{5, 5};
+    assert(m2.none());
+    assert(!m2.any());
+}
+
+void test_SetResetFlip()
+{
+    DynamicBitMatrix m{4, 130};
+    m.set(0, 0).set(1, 64).set(3, 129);
+    assert(m.test(0, 0));
+    assert(m.test(1, 64));
+    assert(m.test(3, 129));
+    assert(3 == m.count());
+
+    m.reset(1, 64);
+    assert(!m.test(1, 64));
+
+    m.flip(2, 100);
+    assert(m.test(2, 100));
+
+    // Flipping everything must not leak into the padding bits
+    m.flip();
+    assert(4 * 130 - 3 == m.count());
+
+    bool thrown = false;
+    try { m.set(4, 0); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+}
+
+void test_BitwiseOperators()
+{
+    DynamicBitMatrix m1{2, 4};
+    DynamicBitMatrix m2{2, 4};
+    m1.set(0, 0).set(0, 3).set(1, 1);
+    m2.set(0, 0).set(0, 1).set(1, 2);
+
+    DynamicBitMatrix a{m1};
+    a &= m2;
+    assert(1 == a.count() && a(0, 0));
+
+    DynamicBitMatrix o{m1};
+    o |= m2;
+    assert(5 == o.count());
+
+    DynamicBitMatrix x{m1};
+    x ^= m2;
+    assert(4 == x.count() && !x(0, 0));
+
+    DynamicBitMatrix n = ~m1;
+    assert(5 == n.count());
+}
+
+void test_RowAndColumnCounts()
+{
+    std::mt19937_64 engine{42};
+    DynamicBitMatrix m = random(150, 200, 0.3, engine);
+
+    auto rowCounts = m.rowCounts();
+    auto colCounts = m.columnCounts();
+    for (std::size_t i = 0; i < m.rowCount(); ++i)
+    {
+        std::size_t expected = 0;
+        for (std::size_t j = 0; j < m.columnCount(); ++j) expected += m(i, j);
+        assert(expected == rowCounts[i]);
+    }
+
+    for (std::size_t j = 0; j < m.columnCount(); ++j)
+    {
+        std::size_t expected = 0;
+        for (std::size_t i = 0; i < m.rowCount(); ++i) expected += m(i, j);
+        assert(expected == colCounts[j]);
+    }
+}
+
+void test_Transpose()
+{
+    std::mt19937_64 engine{7};
+    DynamicBitMatrix m = random(100, 190, 0.5, engine);
+    DynamicBitMatrix t = m.transpose();
+    assert(190 == t.rowCount());
+    assert(100 == t.columnCount());
+
+    for (std::size_t i = 0; i < m.rowCount(); ++i)
+    {
+        for (std::size_t j = 0; j < m.columnCount(); ++j) assert(m(i, j) == t(j, i));
+    }
+
+    assert(m == t.transpose());
+}
+
+void test_Multiply()
+{
+    std::mt19937_64 engine{11};
+    DynamicBitMatrix a = random(70, 93, 0.05, engine);
+    DynamicBitMatrix b = random(93, 130, 0.05, engine);
+    assert(naiveMultiply(a, b) == a.multiply(b));
+
+    DynamicBitMatrix i = DynamicBitMatrix::identity(93);
+    assert(a == a.multiply(i));
+}
+
+void test_TransitiveClosure()
+{
+    // A simple chain 0 -> 1 -> 2 -> ... -> 99 reaches every later node
+    const std::size_t n = 100;
+    DynamicBitMatrix chain{n, n};
+    for (std::size_t i = 0; i + 1 < n; ++i) chain.set(i, i + 1);
+
+    DynamicBitMatrix closure = chain.transitiveClosure();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = 0; j < n; ++j) assert(closure(i, j) == (j > i));
+    }
+
+    // A cycle reaches every node, including itself
+    chain.set(n - 1, 0);
+    assert(n * n == chain.transitiveClosure().count());
+}
+
+// Times the boolean product and the closure of a sparse random reachability graph
+void benchmark_Reachability(std::size_t n)
+{
+    std::mt19937_64 engine{2026};
+    DynamicBitMatrix graph = random(n, n, 2.0 / static_cast<double>(n), engine);
+
+    StopWatch stopWatch;
+    stopWatch.Start();
+    DynamicBitMatrix product = graph.multiply(graph);
+    stopWatch.Stop();
+    double multiplyMs = 1e3 * stopWatch.ElapsedTime();
+
+    stopWatch.Start();
+    DynamicBitMatrix closure = graph.transitiveClosure();
+    stopWatch.Stop();
+    double closureMs = 1e3 * stopWatch.ElapsedTime();
+
+    std::cout << "n=" << n
+              << " multiply: " << multiplyMs << "ms"
+              << " closure: " << closureMs << "ms"
+              << " reachable pairs: " << closure.count() << " (product " << product.count() << ")" << std::endl;
+}
+
+int main()
+{
+    test_ValueConstructor();
+    test_SetResetFlip();
+    test_BitwiseOperators();
+    test_RowAndColumnCounts();
+    test_Transpose();
+    test_Multiply();
+    test_TransitiveClosure();
+
+    benchmark_Reachability(1024);
+    benchmark_Reachability(4096);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
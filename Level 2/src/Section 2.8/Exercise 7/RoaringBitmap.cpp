@@ -0,0 +1,1156 @@
+//
+// A RoaringBitmap is a compressed set of 32-bit unsigned integers. The value space is split into
+// 64K chunks keyed by the high 16 bits of each value, and each non-empty chunk stores its low 16 bits in
+// whichever container is smallest for its contents (array, bitmap or run).
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "RoaringBitmap.hpp"
+
+namespace
+{
+    enum class BitOp { And, Or, AndNot };
+
+    // Portable Roaring format constants
+    constexpr std::uint32_t SERIAL_COOKIE_NO_RUN = 12346;
+    constexpr std::uint32_t SERIAL_COOKIE = 12347;
+    constexpr std::size_t NO_OFFSET_THRESHOLD = 4;
+
+    /**
+     * Combines two 1024 word bitmaps in place (dst = dst op src), a SIMD register at a time
+     * @tparam Op The boolean operation to apply to each pair of words
+     * @param dst The destination (and left hand operand) words
+     * @param src The right hand operand words
+     */
+    template<BitOp Op>
+    void combine(std::uint64_t* dst, const std::uint64_t* src) noexcept
+    {
+        constexpr std::size_t n = RoaringBitmap::BITMAP_WORDS;
+#if defined(__AVX2__)
+        for (std::size_t i = 0; i < n; i += 4)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            if constexpr (Op == BitOp::And) a = _mm256_and_si256(a, b);
+            else if constexpr (Op == BitOp::Or) a = _mm256_or_si256(a, b);
+            else a = _mm256_andnot_si256(b, a);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), a);
+        }
+#elif defined(__SSE2__)
+        for (std::size_t i = 0; i < n; i += 2)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            if constexpr (Op == BitOp::And) a = _mm_and_si128(a, b);
+            else if constexpr (Op == BitOp::Or) a = _mm_or_si128(a, b);
+            else a = _mm_andnot_si128(b, a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), a);
+        }
+#else
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if constexpr (Op == BitOp::And) dst[i] &= src[i];
+            else if constexpr (Op == BitOp::Or) dst[i] |= src[i];
+            else dst[i] &= ~src[i];
+        }
+#endif
+    }
+
+    /**
+     * Walks the sorted array a and emits each value that is (Keep == true) or is not (Keep == false) found in
+     * the sorted array b. b is scanned in blocks of 8 lanes: whole blocks below the probe are skipped with one
+     * comparison and the remaining block is matched with a single SIMD equality test.
+     * @tparam Keep True to compute a intersect b, false to compute a minus b
+     * @param a The array whose values are probed
+     * @param b The array that is searched
+     * @param out The sorted result
+     */
+    template<bool Keep>
+    void probe(const std::vector<std::uint16_t>& a, const std::vector<std::uint16_t>& b, std::vector<std::uint16_t>& out)
+    {
+        const std::size_t nb = b.size();
+        std::size_t j = 0;
+        for (std::uint16_t v : a)
+        {
+            bool found;
+#if defined(__SSE2__)
+            while (j + 8 <= nb && b[j + 7] < v) j += 8;
+            if (j + 8 <= nb)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + j));
+                __m128i key = _mm_set1_epi16(static_cast<short>(v));
+                found = _mm_movemask_epi8(_mm_cmpeq_epi16(block, key)) != 0;
+            }
+            else
+#endif
+            {
+                while (j < nb && b[j] < v) ++j;
+                found = j < nb && b[j] == v;
+            }
+
+            if (found == Keep) out.push_back(v);
+        }
+    }
+
+    std::uint32_t popcount(const std::vector<std::uint64_t>& words) noexcept
+    {
+        std::uint32_t total = 0;
+        for (std::uint64_t w : words) total += std::popcount(w);
+        return total;
+    }
+
+    // Little endian writers and a bounds checked reader for the portable format
+    void write16(std::vector<std::byte>& out, std::uint16_t value)
+    {
+        out.push_back(static_cast<std::byte>(value & 0xFF));
+        out.push_back(static_cast<std::byte>(value >> 8));
+    }
+
+    void write32(std::vector<std::byte>& out, std::uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::byte>((value >> (8 * i)) & 0xFF));
+    }
+
+    void write64(std::vector<std::byte>& out, std::uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i) out.push_back(static_cast<std::byte>((value >> (8 * i)) & 0xFF));
+    }
+
+    struct Reader
+    {
+        std::span<const std::byte> bytes;
+        std::size_t pos = 0;
+
+        std::uint64_t read(std::size_t width)
+        {
+            if (pos + width > bytes.size()) throw std::out_of_range("Truncated RoaringBitmap serialization");
+
+            std::uint64_t value = 0;
+            for (std::size_t i = 0; i < width; ++i)
+            {
+                value |= static_cast<std::uint64_t>(std::to_integer<std::uint8_t>(bytes[pos + i])) << (8 * i);
+            }
+
+            pos += width;
+            return value;
+        }
+
+        void skip(std::size_t count)
+        {
+            if (pos + count > bytes.size()) throw std::out_of_range("Truncated RoaringBitmap serialization");
+            pos += count;
+        }
+    };
+}
+
+// ********** Container helpers **********
+
+/**
+ * Membership test within one container
+ * @param c The container to search
+ * @param low The low 16 bits of the value
+ * @return True if the container holds low
+ */
+bool RoaringBitmap::contains(const Container& c, std::uint16_t low) noexcept
+{
+    switch (c.type)
+    {
+        case ContainerType::Array:
+            return std::binary_search(c.array.begin(), c.array.end(), low);
+        case ContainerType::Bitmap:
+            return (c.bitmap[low >> 6] >> (low & 63)) & 1U;
+        case ContainerType::Run:
+        {
+            auto it = std::upper_bound(c.runs.begin(), c.runs.end(), low,
+                                       [](std::uint16_t v, const Run& r) { return v < r.start; });
+            if (it == c.runs.begin()) return false;
+            --it;
+            return low <= it->start + it->length;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Inserts a value into one container. Run containers are expanded first; arrays that outgrow
+ * ARRAY_MAX are converted into bitmaps.
+ * @param c The container to modify
+ * @param low The low 16 bits of the value
+ * @return True if the value was not already present
+ */
+bool RoaringBitmap::add(Container& c, std::uint16_t low)
+{
+    if (c.type == ContainerType::Run)
+    {
+        if (contains(c, low)) return false;
+        toArrayOrBitmap(c);
+    }
+
+    if (c.type == ContainerType::Array)
+    {
+        auto it = std::lower_bound(c.array.begin(), c.array.end(), low);
+        if (it != c.array.end() && *it == low) return false;
+        c.array.insert(it, low);
+        ++c.cardinality;
+
+        if (c.cardinality > ARRAY_MAX) c = fromBitmap(toBitmap(c));
+        return true;
+    }
+
+    std::uint64_t& word = c.bitmap[low >> 6];
+    const std::uint64_t mask = std::uint64_t{1} << (low & 63);
+    if (word & mask) return false;
+    word |= mask;
+    ++c.cardinality;
+    return true;
+}
+
+/**
+ * Removes a value from one container. Bitmaps that shrink to ARRAY_MAX are converted into arrays.
+ * @param c The container to modify
+ * @param low The low 16 bits of the value
+ * @return True if the value was present
+ */
+bool RoaringBitmap::remove(Container& c, std::uint16_t low)
+{
+    if (!contains(c, low)) return false;
+    if (c.type == ContainerType::Run) toArrayOrBitmap(c);
+
+    if (c.type == ContainerType::Array)
+    {
+        c.array.erase(std::lower_bound(c.array.begin(), c.array.end(), low));
+        --c.cardinality;
+        return true;
+    }
+
+    c.bitmap[low >> 6] &= ~(std::uint64_t{1} << (low & 63));
+    if (--c.cardinality <= ARRAY_MAX) c = fromBitmap(std::move(c.bitmap));
+    return true;
+}
+
+/**
+ * Number of values in the container that are less than or equal to low
+ * @param c The container to search
+ * @param low The low 16 bits of the value
+ * @return The rank of low within the container
+ */
+std::uint32_t RoaringBitmap::rank(const Container& c, std::uint16_t low) noexcept
+{
+    switch (c.type)
+    {
+        case ContainerType::Array:
+            return static_cast<std::uint32_t>(std::upper_bound(c.array.begin(), c.array.end(), low) - c.array.begin());
+        case ContainerType::Bitmap:
+        {
+            const std::size_t w = low >> 6;
+            const std::size_t b = low & 63;
+            std::uint32_t total = 0;
+            for (std::size_t i = 0; i < w; ++i) total += std::popcount(c.bitmap[i]);
+            const std::uint64_t mask = b == 63 ? ~std::uint64_t{0} : (std::uint64_t{1} << (b + 1)) - 1;
+            return total + std::popcount(c.bitmap[w] & mask);
+        }
+        case ContainerType::Run:
+        {
+            std::uint32_t total = 0;
+            for (const Run& r : c.runs)
+            {
+                if (r.start > low) break;
+                total += std::min<std::uint32_t>(low, r.start + r.length) - r.start + 1;
+            }
+            return total;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * The value at the given zero based position in the container
+ * @param c The container to search
+ * @param index A position less than the container's cardinality
+ * @return The low 16 bits of the selected value
+ */
+std::uint16_t RoaringBitmap::select(const Container& c, std::uint32_t index) noexcept
+{
+    switch (c.type)
+    {
+        case ContainerType::Array:
+            return c.array[index];
+        case ContainerType::Bitmap:
+            for (std::size_t w = 0; w < BITMAP_WORDS; ++w)
+            {
+                std::uint64_t word = c.bitmap[w];
+                const std::uint32_t count = std::popcount(word);
+                if (index < count)
+                {
+                    // Drop the lowest index set bits; the next set bit is the answer
+                    for (std::uint32_t k = 0; k < index; ++k) word &= word - 1;
+                    return static_cast<std::uint16_t>(w * 64 + std::countr_zero(word));
+                }
+                index -= count;
+            }
+            break;
+        case ContainerType::Run:
+            for (const Run& r : c.runs)
+            {
+                const std::uint32_t count = r.length + 1U;
+                if (index < count) return static_cast<std::uint16_t>(r.start + index);
+                index -= count;
+            }
+            break;
+    }
+
+    return 0;
+}
+
+/**
+ * Materializes any container into 1024 bitmap words
+ * @param c The container to convert
+ * @return The bitmap words
+ */
+std::vector<std::uint64_t> RoaringBitmap::toBitmap(const Container& c)
+{
+    if (c.type == ContainerType::Bitmap) return c.bitmap;
+
+    std::vector<std::uint64_t> words(BITMAP_WORDS, 0);
+    if (c.type == ContainerType::Array)
+    {
+        for (std::uint16_t v : c.array) words[v >> 6] |= std::uint64_t{1} << (v & 63);
+        return words;
+    }
+
+    for (const Run& r : c.runs)
+    {
+        // Fill [start, end] a word at a time
+        std::uint32_t start = r.start;
+        const std::uint32_t end = r.start + r.length;
+        while (start <= end)
+        {
+            const std::uint32_t w = start >> 6;
+            const std::uint32_t first = start & 63;
+            const std::uint32_t last = std::min<std::uint32_t>(63, end - (w << 6));
+            const std::uint64_t high = last == 63 ? ~std::uint64_t{0} : (std::uint64_t{1} << (last + 1)) - 1;
+            words[w] |= high & (~std::uint64_t{0} << first);
+            start = (w + 1) << 6;
+        }
+    }
+
+    return words;
+}
+
+/**
+ * Converts a run container into the array or bitmap container with the same contents
+ * @param c The container to convert
+ */
+void RoaringBitmap::toArrayOrBitmap(Container& c)
+{
+    if (c.type == ContainerType::Run) c = fromBitmap(toBitmap(c));
+}
+
+/**
+ * Builds the smaller of an array or bitmap container from bitmap words
+ * @param words 1024 bitmap words
+ * @return An array container when the cardinality is at most ARRAY_MAX, otherwise a bitmap container
+ */
+RoaringBitmap::Container RoaringBitmap::fromBitmap(std::vector<std::uint64_t>&& words)
+{
+    Container c;
+    c.cardinality = popcount(words);
+    if (c.cardinality > ARRAY_MAX)
+    {
+        c.type = ContainerType::Bitmap;
+        c.bitmap = std::move(words);
+        return c;
+    }
+
+    c.array.reserve(c.cardinality);
+    for (std::size_t w = 0; w < BITMAP_WORDS; ++w)
+    {
+        for (std::uint64_t word = words[w]; word != 0; word &= word - 1)
+        {
+            c.array.push_back(static_cast<std::uint16_t>(w * 64 + std::countr_zero(word)));
+        }
+    }
+
+    return c;
+}
+
+/**
+ * Builds the smaller of an array or bitmap container from sorted values
+ * @param values Sorted, unique low 16 bit values
+ * @return An array container when there are at most ARRAY_MAX values, otherwise a bitmap container
+ */
+RoaringBitmap::Container RoaringBitmap::fromArray(std::vector<std::uint16_t>&& values)
+{
+    Container c;
+    c.cardinality = static_cast<std::uint32_t>(values.size());
+    c.array = std::move(values);
+    if (c.cardinality > ARRAY_MAX) c = fromBitmap(toBitmap(c));
+    return c;
+}
+
+/**
+ * Converts the container into a run container if that is its smallest serialized representation
+ * @param c The container to optimize
+ */
+void RoaringBitmap::runOptimize(Container& c)
+{
+    if (c.type == ContainerType::Run) return;
+
+    // Collect the maximal intervals of consecutive values
+    std::vector<Run> runs;
+    auto extend = [&runs](std::uint16_t v)
+    {
+        if (!runs.empty() && runs.back().start + runs.back().length + 1U == v) ++runs.back().length;
+        else runs.push_back(Run{v, 0});
+    };
+
+    if (c.type == ContainerType::Array)
+    {
+        for (std::uint16_t v : c.array) extend(v);
+    }
+    else
+    {
+        for (std::size_t w = 0; w < BITMAP_WORDS; ++w)
+        {
+            for (std::uint64_t word = c.bitmap[w]; word != 0; word &= word - 1)
+            {
+                extend(static_cast<std::uint16_t>(w * 64 + std::countr_zero(word)));
+            }
+        }
+    }
+
+    const std::size_t runBytes = 2 + 4 * runs.size();
+    if (runBytes >= serializedSize(c)) return;
+
+    Container run;
+    run.type = ContainerType::Run;
+    run.cardinality = c.cardinality;
+    run.runs = std::move(runs);
+    c = std::move(run);
+}
+
+/**
+ * Number of bytes the container occupies in the portable format
+ * @param c The container to measure
+ * @return The container's payload size
+ */
+std::size_t RoaringBitmap::serializedSize(const Container& c) noexcept
+{
+    switch (c.type)
+    {
+        case ContainerType::Array: return 2 * c.array.size();
+        case ContainerType::Bitmap: return 8 * BITMAP_WORDS;
+        case ContainerType::Run: return 2 + 4 * c.runs.size();
+    }
+
+    return 0;
+}
+
+// ********** Pairwise container algebra **********
+
+/**
+ * Intersection of two containers
+ * @param a The lhs container
+ * @param b The rhs container
+ * @return A container holding the values present in both a and b
+ */
+RoaringBitmap::Container RoaringBitmap::intersect(const Container& a, const Container& b)
+{
+    if (a.type == ContainerType::Run && b.type == ContainerType::Run)
+    {
+        Container c;
+        c.type = ContainerType::Run;
+        std::size_t i = 0, j = 0;
+        while (i < a.runs.size() && j < b.runs.size())
+        {
+            const std::uint32_t aEnd = a.runs[i].start + a.runs[i].length;
+            const std::uint32_t bEnd = b.runs[j].start + b.runs[j].length;
+            const std::uint32_t start = std::max(a.runs[i].start, b.runs[j].start);
+            const std::uint32_t end = std::min(aEnd, bEnd);
+            if (start <= end)
+            {
+                c.runs.push_back(Run{static_cast<std::uint16_t>(start), static_cast<std::uint16_t>(end - start)});
+                c.cardinality += end - start + 1;
+            }
+
+            if (aEnd < bEnd) ++i;
+            else ++j;
+        }
+
+        return c;
+    }
+
+    if (a.type == ContainerType::Array && b.type == ContainerType::Array)
+    {
+        // Probe the smaller array against the larger one
+        std::vector<std::uint16_t> values;
+        const Container& small = a.cardinality <= b.cardinality ? a : b;
+        const Container& large = a.cardinality <= b.cardinality ? b : a;
+        values.reserve(small.cardinality);
+        probe<true>(small.array, large.array, values);
+        return fromArray(std::move(values));
+    }
+
+    if (a.type == ContainerType::Array || b.type == ContainerType::Array)
+    {
+        // Filter the array through the other container
+        const Container& array = a.type == ContainerType::Array ? a : b;
+        const Container& other = a.type == ContainerType::Array ? b : a;
+        std::vector<std::uint16_t> values;
+        values.reserve(array.cardinality);
+        for (std::uint16_t v : array.array)
+        {
+            if (contains(other, v)) values.push_back(v);
+        }
+        return fromArray(std::move(values));
+    }
+
+    // Bitmap with bitmap or run
+    std::vector<std::uint64_t> words = toBitmap(a);
+    const std::vector<std::uint64_t> rhs = toBitmap(b);
+    combine<BitOp::And>(words.data(), rhs.data());
+    return fromBitmap(std::move(words));
+}
+
+/**
+ * Union of two containers
+ * @param a The lhs container
+ * @param b The rhs container
+ * @return A container holding the values present in either a or b
+ */
+RoaringBitmap::Container RoaringBitmap::unite(const Container& a, const Container& b)
+{
+    if (a.type == ContainerType::Run && b.type == ContainerType::Run)
+    {
+        // Merge the intervals in start order, coalescing overlapping and adjacent runs
+        Container c;
+        c.type = ContainerType::Run;
+        std::vector<Run> merged;
+        merged.reserve(a.runs.size() + b.runs.size());
+        std::merge(a.runs.begin(), a.runs.end(), b.runs.begin(), b.runs.end(), std::back_inserter(merged),
+                   [](const Run& lhs, const Run& rhs) { return lhs.start < rhs.start; });
+
+        for (const Run& r : merged)
+        {
+            if (!c.runs.empty())
+            {
+                Run& last = c.runs.back();
+                const std::uint32_t lastEnd = last.start + last.length;
+                if (r.start <= lastEnd + 1U)
+                {
+                    const std::uint32_t end = std::max<std::uint32_t>(lastEnd, r.start + r.length);
+                    last.length = static_cast<std::uint16_t>(end - last.start);
+                    continue;
+                }
+            }
+            c.runs.push_back(r);
+        }
+
+        for (const Run& r : c.runs) c.cardinality += r.length + 1U;
+        return c;
+    }
+
+    if (a.type == ContainerType::Array && b.type == ContainerType::Array)
+    {
+        std::vector<std::uint16_t> values;
+        values.reserve(a.cardinality + b.cardinality);
+        std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(values));
+        return fromArray(std::move(values));
+    }
+
+    if (a.type == ContainerType::Array || b.type == ContainerType::Array)
+    {
+        // Set the array's bits in a copy of the other container's bitmap
+        const Container& array = a.type == ContainerType::Array ? a : b;
+        const Container& other = a.type == ContainerType::Array ? b : a;
+        std::vector<std::uint64_t> words = toBitmap(other);
+        for (std::uint16_t v : array.array) words[v >> 6] |= std::uint64_t{1} << (v & 63);
+        return fromBitmap(std::move(words));
+    }
+
+    std::vector<std::uint64_t> words = toBitmap(a);
+    const std::vector<std::uint64_t> rhs = toBitmap(b);
+    combine<BitOp::Or>(words.data(), rhs.data());
+    return fromBitmap(std::move(words));
+}
+
+/**
+ * Difference of two containers
+ * @param a The lhs container
+ * @param b The rhs container
+ * @return A container holding the values present in a but not in b
+ */
+RoaringBitmap::Container RoaringBitmap::subtract(const Container& a, const Container& b)
+{
+    if (a.type == ContainerType::Array)
+    {
+        std::vector<std::uint16_t> values;
+        values.reserve(a.cardinality);
+        if (b.type == ContainerType::Array) probe<false>(a.array, b.array, values);
+        else
+        {
+            for (std::uint16_t v : a.array)
+            {
+                if (!contains(b, v)) values.push_back(v);
+            }
+        }
+        return fromArray(std::move(values));
+    }
+
+    std::vector<std::uint64_t> words = toBitmap(a);
+    if (b.type == ContainerType::Array)
+    {
+        for (std::uint16_t v : b.array) words[v >> 6] &= ~(std::uint64_t{1} << (v & 63));
+    }
+    else
+    {
+        const std::vector<std::uint64_t> rhs = toBitmap(b);
+        combine<BitOp::AndNot>(words.data(), rhs.data());
+    }
+
+    return fromBitmap(std::move(words));
+}
+
+// ********** Chunk lookup **********
+
+std::optional<std::size_t> RoaringBitmap::find(std::uint16_t key) const noexcept
+{
+    auto it = std::lower_bound(keys.begin(), keys.end(), key);
+    if (it == keys.end() || *it != key) return std::nullopt;
+    return static_cast<std::size_t>(it - keys.begin());
+}
+
+std::size_t RoaringBitmap::findOrInsert(std::uint16_t key)
+{
+    auto it = std::lower_bound(keys.begin(), keys.end(), key);
+    const auto index = static_cast<std::size_t>(it - keys.begin());
+    if (it == keys.end() || *it != key)
+    {
+        keys.insert(it, key);
+        containers.insert(containers.begin() + static_cast<std::ptrdiff_t>(index), Container{});
+    }
+
+    return index;
+}
+
+// ********** Public interface **********
+
+/**
+ * Overloaded ctor
+ * @param values The initial values of this RoaringBitmap
+ */
+RoaringBitmap::RoaringBitmap(std::initializer_list<std::uint32_t> values)
+{
+    for (std::uint32_t v : values) add(v);
+}
+
+/**
+ * Equality comparison between two RoaringBitmaps
+ * @param other The RoaringBitmap used as the rhs in the comparison
+ * @return True if both RoaringBitmaps contain exactly the same values, regardless of container types
+ */
+bool RoaringBitmap::operator==(const RoaringBitmap& other) const
+{
+    if (keys != other.keys) return false;
+
+    for (std::size_t i = 0; i < containers.size(); ++i)
+    {
+        const Container& a = containers[i];
+        const Container& b = other.containers[i];
+        if (a.cardinality != b.cardinality) return false;
+        if (a.type == ContainerType::Array && b.type == ContainerType::Array)
+        {
+            if (a.array != b.array) return false;
+        }
+        else if (toBitmap(a) != toBitmap(b))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Set intersection
+ * @param other The RoaringBitmap used as the rhs
+ * @return A new RoaringBitmap with the values present in both *this and other
+ */
+RoaringBitmap RoaringBitmap::operator&(const RoaringBitmap& other) const
+{
+    RoaringBitmap result;
+    std::size_t i = 0, j = 0;
+    while (i < keys.size() && j < other.keys.size())
+    {
+        if (keys[i] < other.keys[j]) ++i;
+        else if (other.keys[j] < keys[i]) ++j;
+        else
+        {
+            Container c = intersect(containers[i], other.containers[j]);
+            if (c.cardinality > 0)
+            {
+                result.keys.push_back(keys[i]);
+                result.containers.push_back(std::move(c));
+            }
+            ++i;
+            ++j;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Set union
+ * @param other The RoaringBitmap used as the rhs
+ * @return A new RoaringBitmap with the values present in either *this or other
+ */
+RoaringBitmap RoaringBitmap::operator|(const RoaringBitmap& other) const
+{
+    RoaringBitmap result;
+    std::size_t i = 0, j = 0;
+    while (i < keys.size() || j < other.keys.size())
+    {
+        if (j == other.keys.size() || (i < keys.size() && keys[i] < other.keys[j]))
+        {
+            result.keys.push_back(keys[i]);
+            result.containers.push_back(containers[i++]);
+        }
+        else if (i == keys.size() || other.keys[j] < keys[i])
+        {
+            result.keys.push_back(other.keys[j]);
+            result.containers.push_back(other.containers[j++]);
+        }
+        else
+        {
+            result.keys.push_back(keys[i]);
+            result.containers.push_back(unite(containers[i++], other.containers[j++]));
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Set difference
+ * @param other The RoaringBitmap used as the rhs
+ * @return A new RoaringBitmap with the values present in *this but not in other
+ */
+RoaringBitmap RoaringBitmap::operator-(const RoaringBitmap& other) const
+{
+    RoaringBitmap result;
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        while (j < other.keys.size() && other.keys[j] < keys[i]) ++j;
+
+        Container c = (j < other.keys.size() && other.keys[j] == keys[i])
+                ? subtract(containers[i], other.containers[j])
+                : containers[i];
+        if (c.cardinality > 0)
+        {
+            result.keys.push_back(keys[i]);
+            result.containers.push_back(std::move(c));
+        }
+    }
+
+    return result;
+}
+
+RoaringBitmap& RoaringBitmap::operator&=(const RoaringBitmap& other)
+{
+    *this = *this & other;
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator|=(const RoaringBitmap& other)
+{
+    *this = *this | other;
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator-=(const RoaringBitmap& other)
+{
+    *this = *this - other;
+    return *this;
+}
+
+/**
+ * Inserts a value
+ * @param value The value to insert
+ * @return True if the value was not already present
+ */
+bool RoaringBitmap::add(std::uint32_t value)
+{
+    const std::size_t index = findOrInsert(static_cast<std::uint16_t>(value >> 16));
+    return add(containers[index], static_cast<std::uint16_t>(value & 0xFFFF));
+}
+
+/**
+ * Inserts every value in [first, last). Whole chunks are stored as single runs.
+ * @param first The first value to insert
+ * @param last One past the last value to insert (at most 2^32)
+ */
+void RoaringBitmap::addRange(std::uint64_t first, std::uint64_t last)
+{
+    last = std::min<std::uint64_t>(last, std::uint64_t{1} << 32);
+    while (first < last)
+    {
+        const auto key = static_cast<std::uint16_t>(first >> 16);
+        const std::uint64_t chunkEnd = std::min<std::uint64_t>(last, (static_cast<std::uint64_t>(key) + 1) << 16);
+
+        Container run;
+        run.type = ContainerType::Run;
+        run.cardinality = static_cast<std::uint32_t>(chunkEnd - first);
+        run.runs.push_back(Run{static_cast<std::uint16_t>(first & 0xFFFF),
+                               static_cast<std::uint16_t>(chunkEnd - first - 1)});
+
+        const std::size_t index = findOrInsert(key);
+        Container& c = containers[index];
+        c = c.cardinality == 0 ? std::move(run) : unite(c, run);
+        first = chunkEnd;
+    }
+}
+
+/**
+ * Removes a value
+ * @param value The value to remove
+ * @return True if the value was present
+ */
+bool RoaringBitmap::remove(std::uint32_t value)
+{
+    auto index = find(static_cast<std::uint16_t>(value >> 16));
+    if (!index) return false;
+
+    const bool removed = remove(containers[*index], static_cast<std::uint16_t>(value & 0xFFFF));
+    if (containers[*index].cardinality == 0)
+    {
+        keys.erase(keys.begin() + static_cast<std::ptrdiff_t>(*index));
+        containers.erase(containers.begin() + static_cast<std::ptrdiff_t>(*index));
+    }
+
+    return removed;
+}
+
+/**
+ * Removes every value
+ */
+void RoaringBitmap::clear() noexcept
+{
+    keys.clear();
+    containers.clear();
+}
+
+/**
+ * Converts each container to a run container where that is smaller. Call after bulk loading
+ * clustered data such as consecutive order IDs.
+ */
+void RoaringBitmap::runOptimize()
+{
+    for (Container& c : containers) runOptimize(c);
+}
+
+/**
+ * Membership test
+ * @param value The value to look for
+ * @return True if the value is present
+ */
+bool RoaringBitmap::contains(std::uint32_t value) const noexcept
+{
+    auto index = find(static_cast<std::uint16_t>(value >> 16));
+    return index && contains(containers[*index], static_cast<std::uint16_t>(value & 0xFFFF));
+}
+
+/**
+ * Number of values in this RoaringBitmap. Each container caches its own cardinality.
+ * @return The cardinality
+ */
+std::uint64_t RoaringBitmap::cardinality() const noexcept
+{
+    std::uint64_t total = 0;
+    for (const Container& c : containers) total += c.cardinality;
+    return total;
+}
+
+/**
+ * Number of values that are less than or equal to value
+ * @param value The value to rank
+ * @return The rank of value
+ */
+std::uint64_t RoaringBitmap::rank(std::uint32_t value) const noexcept
+{
+    const auto key = static_cast<std::uint16_t>(value >> 16);
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < keys.size() && keys[i] <= key; ++i)
+    {
+        total += keys[i] < key ? containers[i].cardinality : rank(containers[i], static_cast<std::uint16_t>(value & 0xFFFF));
+    }
+
+    return total;
+}
+
+/**
+ * The value at a zero based position in ascending order, i.e. the inverse of rank()
+ * @param index The position of the value
+ * @return The value, or an empty optional if index >= cardinality()
+ */
+std::optional<std::uint32_t> RoaringBitmap::select(std::uint64_t index) const noexcept
+{
+    for (std::size_t i = 0; i < containers.size(); ++i)
+    {
+        if (index < containers[i].cardinality)
+        {
+            const std::uint16_t low = select(containers[i], static_cast<std::uint32_t>(index));
+            return (static_cast<std::uint32_t>(keys[i]) << 16) | low;
+        }
+        index -= containers[i].cardinality;
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * Copies every value out in ascending order
+ * @return A sorted std::vector of the values
+ */
+std::vector<std::uint32_t> RoaringBitmap::toVector() const
+{
+    std::vector<std::uint32_t> values;
+    values.reserve(cardinality());
+    for (std::size_t i = 0; i < containers.size(); ++i)
+    {
+        const std::uint32_t high = static_cast<std::uint32_t>(keys[i]) << 16;
+        const Container& c = containers[i];
+        switch (c.type)
+        {
+            case ContainerType::Array:
+                for (std::uint16_t v : c.array) values.push_back(high | v);
+                break;
+            case ContainerType::Bitmap:
+                for (std::size_t w = 0; w < BITMAP_WORDS; ++w)
+                {
+                    for (std::uint64_t word = c.bitmap[w]; word != 0; word &= word - 1)
+                    {
+                        values.push_back(high | static_cast<std::uint32_t>(w * 64 + std::countr_zero(word)));
+                    }
+                }
+                break;
+            case ContainerType::Run:
+                for (const Run& r : c.runs)
+                {
+                    for (std::uint32_t v = r.start; v <= static_cast<std::uint32_t>(r.start + r.length); ++v)
+                    {
+                        values.push_back(high | v);
+                    }
+                }
+                break;
+        }
+    }
+
+    return values;
+}
+
+/**
+ * Number of bytes this RoaringBitmap occupies in memory, counting the allocated capacity of the key and
+ * container vectors rather than only their size
+ * @return The in-memory footprint
+ */
+std::size_t RoaringBitmap::memoryInBytes() const noexcept
+{
+    std::size_t bytes = sizeof(*this);
+    bytes += keys.capacity() * sizeof(std::uint16_t);
+    bytes += containers.capacity() * sizeof(Container);
+    for (const Container& c : containers)
+    {
+        bytes += c.array.capacity() * sizeof(std::uint16_t);
+        bytes += c.bitmap.capacity() * sizeof(std::uint64_t);
+        bytes += c.runs.capacity() * sizeof(Run);
+    }
+
+    return bytes;
+}
+
+/**
+ * Number of bytes serialize() will produce
+ * @return The serialized size
+ */
+std::size_t RoaringBitmap::serializedSizeInBytes() const noexcept
+{
+    const bool hasRun = std::any_of(containers.begin(), containers.end(),
+                                    [](const Container& c) { return c.type == ContainerType::Run; });
+    const std::size_t size = containers.size();
+
+    std::size_t bytes = hasRun ? 4 + (size + 7) / 8 : 8;
+    bytes += 4 * size;                                              // Key and cardinality - 1 per container
+    if (!hasRun || size >= NO_OFFSET_THRESHOLD) bytes += 4 * size;  // Offset header
+    for (const Container& c : containers) bytes += serializedSize(c);
+    return bytes;
+}
+
+/**
+ * Serializes this RoaringBitmap in the portable Roaring format. The output is little endian and can be
+ * read by any conforming Roaring implementation.
+ * @return The serialized bytes
+ */
+std::vector<std::byte> RoaringBitmap::serialize() const
+{
+    const bool hasRun = std::any_of(containers.begin(), containers.end(),
+                                    [](const Container& c) { return c.type == ContainerType::Run; });
+    const auto size = static_cast<std::uint32_t>(containers.size());
+
+    std::vector<std::byte> out;
+    out.reserve(serializedSizeInBytes());
+
+    // Cookie, followed by a bitset flagging the run containers
+    if (hasRun)
+    {
+        write32(out, SERIAL_COOKIE | ((size - 1) << 16));
+        for (std::size_t i = 0; i < size; i += 8)
+        {
+            std::uint8_t flags = 0;
+            for (std::size_t b = 0; b < 8 && i + b < size; ++b)
+            {
+                if (containers[i + b].type == ContainerType::Run) flags |= static_cast<std::uint8_t>(1U << b);
+            }
+            out.push_back(static_cast<std::byte>(flags));
+        }
+    }
+    else
+    {
+        write32(out, SERIAL_COOKIE_NO_RUN);
+        write32(out, size);
+    }
+
+    // Descriptive header
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        write16(out, keys[i]);
+        write16(out, static_cast<std::uint16_t>(containers[i].cardinality - 1));
+    }
+
+    // Offset header
+    if (!hasRun || size >= NO_OFFSET_THRESHOLD)
+    {
+        auto offset = static_cast<std::uint32_t>(out.size() + 4 * size);
+        for (const Container& c : containers)
+        {
+            write32(out, offset);
+            offset += static_cast<std::uint32_t>(serializedSize(c));
+        }
+    }
+
+    // Container payloads
+    for (const Container& c : containers)
+    {
+        switch (c.type)
+        {
+            case ContainerType::Array:
+                for (std::uint16_t v : c.array) write16(out, v);
+                break;
+            case ContainerType::Bitmap:
+                for (std::uint64_t w : c.bitmap) write64(out, w);
+                break;
+            case ContainerType::Run:
+                write16(out, static_cast<std::uint16_t>(c.runs.size()));
+                for (const Run& r : c.runs)
+                {
+                    write16(out, r.start);
+                    write16(out, r.length);
+                }
+                break;
+        }
+    }
+
+    return out;
+}
+
+/**
+ * Reads a RoaringBitmap written in the portable Roaring format
+ * @param bytes The serialized bytes
+ * @return The deserialized RoaringBitmap
+ * @throws std::invalid_argument if the cookie is not recognised
+ * @throws std::out_of_range if the input is truncated
+ */
+RoaringBitmap RoaringBitmap::deserialize(std::span<const std::byte> bytes)
+{
+    Reader reader{bytes};
+    const auto cookie = static_cast<std::uint32_t>(reader.read(4));
+
+    bool hasRun = false;
+    std::uint32_t size = 0;
+    std::vector<bool> isRun;
+    if ((cookie & 0xFFFF) == SERIAL_COOKIE)
+    {
+        hasRun = true;
+        size = (cookie >> 16) + 1;
+        isRun.resize(size);
+        for (std::uint32_t i = 0; i < size; i += 8)
+        {
+            const auto flags = static_cast<std::uint8_t>(reader.read(1));
+            for (std::uint32_t b = 0; b < 8 && i + b < size; ++b) isRun[i + b] = (flags >> b) & 1U;
+        }
+    }
+    else if (cookie == SERIAL_COOKIE_NO_RUN)
+    {
+        size = static_cast<std::uint32_t>(reader.read(4));
+        isRun.resize(size, false);
+    }
+    else
+    {
+        throw std::invalid_argument("Unrecognised RoaringBitmap cookie: " + std::to_string(cookie));
+    }
+
+    RoaringBitmap result;
+    result.keys.resize(size);
+    result.containers.resize(size);
+    for (std::uint32_t i = 0; i < size; ++i)
+    {
+        result.keys[i] = static_cast<std::uint16_t>(reader.read(2));
+        result.containers[i].cardinality = static_cast<std::uint32_t>(reader.read(2)) + 1;
+    }
+
+    // Offsets are only needed for random access; the payloads follow in order
+    if (!hasRun || size >= NO_OFFSET_THRESHOLD) reader.skip(4 * std::size_t{size});
+
+    for (std::uint32_t i = 0; i < size; ++i)
+    {
+        Container& c = result.containers[i];
+        if (isRun[i])
+        {
+            c.type = ContainerType::Run;
+            const auto runCount = static_cast<std::size_t>(reader.read(2));
+            c.runs.resize(runCount);
+            for (Run& r : c.runs)
+            {
+                r.start = static_cast<std::uint16_t>(reader.read(2));
+                r.length = static_cast<std::uint16_t>(reader.read(2));
+            }
+        }
+        else if (c.cardinality > ARRAY_MAX)
+        {
+            c.type = ContainerType::Bitmap;
+            c.bitmap.resize(BITMAP_WORDS);
+            for (std::uint64_t& w : c.bitmap) w = reader.read(8);
+        }
+        else
+        {
+            c.array.resize(c.cardinality);
+            for (std::uint16_t& v : c.array) v = static_cast<std::uint16_t>(reader.read(2));
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,123 @@
+//
+// A RoaringBitmap is a compressed set of 32-bit unsigned integers. The value space is split into
+// 64K chunks keyed by the high 16 bits of each value, and each non-empty chunk stores its low 16 bits in
+// whichever container is smallest for its contents:
+//      Array  - a sorted std::vector<uint16_t>, used for sparse chunks (at most 4096 values)
+//      Bitmap - 1024 64-bit words (8KB), used for dense chunks
+//      Run    - sorted [start, start + length] intervals, used for clustered chunks after runOptimize()
+//
+// Unlike boost::dynamic_bitset and std::vector<bool>, memory is proportional to the number of values
+// rather than to the largest value. Set algebra dispatches per pair of containers: bitmaps are combined a
+// SIMD register at a time and arrays are intersected by comparing one value against 8 lanes at a time.
+//
+// serialize() and deserialize() implement the portable Roaring format
+// (https://github.com/RoaringBitmap/RoaringFormatSpec), which is little endian regardless of the host.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_ROARINGBITMAP_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_ROARINGBITMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <vector>
+
+class RoaringBitmap
+{
+public:
+    enum class ContainerType : std::uint8_t { Array, Bitmap, Run };
+
+    static constexpr std::size_t ARRAY_MAX = 4096;         // Largest array container before switching to a bitmap
+    static constexpr std::size_t BITMAP_WORDS = 1024;      // 65536 bits / 64
+
+private:
+    // An interval of consecutive values [start, start + length]
+    struct Run
+    {
+        std::uint16_t start;
+        std::uint16_t length;
+    };
+
+    // The low 16 bits of every value that shares one high 16 bit key
+    struct Container
+    {
+        ContainerType type = ContainerType::Array;
+        std::uint32_t cardinality = 0;
+        std::vector<std::uint16_t> array;
+        std::vector<std::uint64_t> bitmap;
+        std::vector<Run> runs;
+    };
+
+    std::vector<std::uint16_t> keys;        // Sorted high 16 bits of each chunk
+    std::vector<Container> containers;      // containers[i] holds the chunk keyed by keys[i]
+
+    // Container helpers
+    static bool contains(const Container& c, std::uint16_t low) noexcept;
+    static bool add(Container& c, std::uint16_t low);
+    static bool remove(Container& c, std::uint16_t low);
+    static std::uint32_t rank(const Container& c, std::uint16_t low) noexcept;
+    static std::uint16_t select(const Container& c, std::uint32_t index) noexcept;
+    static std::vector<std::uint64_t> toBitmap(const Container& c);
+    static void toArrayOrBitmap(Container& c);
+    static Container fromBitmap(std::vector<std::uint64_t>&& words);
+    static Container fromArray(std::vector<std::uint16_t>&& values);
+    static void runOptimize(Container& c);
+    static std::size_t serializedSize(const Container& c) noexcept;
+
+    // Pairwise container algebra
+    static Container intersect(const Container& a, const Container& b);
+    static Container unite(const Container& a, const Container& b);
+    static Container subtract(const Container& a, const Container& b);
+
+    std::optional<std::size_t> find(std::uint16_t key) const noexcept;
+    std::size_t findOrInsert(std::uint16_t key);
+
+public:
+    RoaringBitmap() = default;
+    RoaringBitmap(std::initializer_list<std::uint32_t> values);
+    RoaringBitmap(const RoaringBitmap& source) = default;
+    RoaringBitmap(RoaringBitmap&& source) noexcept = default;
+    ~RoaringBitmap() = default;
+
+    // Operator overloads
+    RoaringBitmap& operator=(const RoaringBitmap& source) = default;
+    RoaringBitmap& operator=(RoaringBitmap&& source) noexcept = default;
+    bool operator==(const RoaringBitmap& other) const;
+    RoaringBitmap operator&(const RoaringBitmap& other) const;
+    RoaringBitmap operator|(const RoaringBitmap& other) const;
+    RoaringBitmap operator-(const RoaringBitmap& other) const;
+    RoaringBitmap& operator&=(const RoaringBitmap& other);
+    RoaringBitmap& operator|=(const RoaringBitmap& other);
+    RoaringBitmap& operator-=(const RoaringBitmap& other);
+
+    // Mutators
+    bool add(std::uint32_t value);
+    void addRange(std::uint64_t first, std::uint64_t last);
+    bool remove(std::uint32_t value);
+    void clear() noexcept;
+    void runOptimize();
+
+    // Queries
+    bool contains(std::uint32_t value) const noexcept;
+    bool empty() const noexcept { return keys.empty(); }
+    std::uint64_t cardinality() const noexcept;
+    std::uint64_t rank(std::uint32_t value) const noexcept;
+    std::optional<std::uint32_t> select(std::uint64_t index) const noexcept;
+    std::vector<std::uint32_t> toVector() const;
+    std::size_t containerCount() const noexcept { return containers.size(); }
+    ContainerType containerType(std::size_t index) const { return containers.at(index).type; }
+
+    // Memory held by this object, including the capacity of every container
+    std::size_t memoryInBytes() const noexcept;
+
+    // Portable serialization
+    std::size_t serializedSizeInBytes() const noexcept;
+    std::vector<std::byte> serialize() const;
+    static RoaringBitmap deserialize(std::span<const std::byte> bytes);
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_ROARINGBITMAP_HPP
@@ -0,0 +1,282 @@
+//
+// Tests for the compressed RoaringBitmap, followed by a benchmark that compares its memory footprint
+// and set algebra against boost::dynamic_bitset and std::vector<bool> across a range of densities.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "RoaringBitmap.hpp"
+#include "StopWatch.hpp"
+
+// Draws count distinct values below universe, sorted
+std::vector<std::uint32_t> sample(std::size_t count, std::uint32_t universe, std::mt19937_64& engine)
+{
+    std::uniform_int_distribution<std::uint32_t> dist{0, universe - 1};
+    std::set<std::uint32_t> values;
+    while (values.size() < count) values.insert(dist(engine));
+    return {values.begin(), values.end()};
+}
+
+RoaringBitmap toRoaring(const std::vector<std::uint32_t>& values)
+{
+    RoaringBitmap bitmap;
+    for (std::uint32_t v : values) bitmap.add(v);
+    return bitmap;
+}
+
+// Add, contains and remove across array and bitmap containers
+void test_AddContainsRemove()
+{
+    RoaringBitmap b{1, 5, 65536, 4000000000u};
+    assert(4 == b.cardinality());
+    assert(b.contains(5));
+    assert(b.contains(65536));
+    assert(b.contains(4000000000u));
+    assert(!b.contains(6));
+    assert(3 == b.containerCount());
+
+    assert(!b.add(5));
+    assert(b.remove(5));
+    assert(!b.remove(5));
+    assert(!b.contains(5));
+
+    // Growing past 4096 values converts the chunk into a bitmap, and shrinking converts it back
+    RoaringBitmap dense;
+    for (std::uint32_t v = 0; v < 5000; ++v) dense.add(2 * v);
+    assert(RoaringBitmap::ContainerType::Bitmap == dense.containerType(0));
+    for (std::uint32_t v = 0; v < 1000; ++v) dense.remove(2 * v);
+    assert(RoaringBitmap::ContainerType::Array == dense.containerType(0));
+    assert(4000 == dense.cardinality());
+}
+
+// Ranges are stored as runs and survive mixed algebra
+void test_RangesAndRuns()
+{
+    RoaringBitmap b;
+    b.addRange(10, 200000);
+    assert(199990 == b.cardinality());
+    assert(RoaringBitmap::ContainerType::Run == b.containerType(0));
+    assert(b.contains(10) && b.contains(199999) && !b.contains(200000) && !b.contains(9));
+
+    RoaringBitmap odd;
+    for (std::uint32_t v = 1; v < 300000; v += 2) odd.add(v);
+
+    RoaringBitmap both = b & odd;
+    assert(99995 == both.cardinality());
+    assert((b - odd).cardinality() + both.cardinality() == b.cardinality());
+    assert((b | odd).cardinality() == b.cardinality() + odd.cardinality() - both.cardinality());
+
+    // Consecutive order IDs compress to a handful of runs
+    RoaringBitmap ids;
+    for (std::uint32_t v = 1000; v < 50000; ++v) ids.add(v);
+    ids.runOptimize();
+    assert(RoaringBitmap::ContainerType::Run == ids.containerType(0));
+    assert(ids.serializedSizeInBytes() < 64);
+}
+
+// Set algebra against std::set_* on random data of several densities
+void test_SetAlgebra()
+{
+    std::mt19937_64 engine{42};
+    for (std::size_t count : {100, 5000, 60000, 200000})
+    {
+        auto a = sample(count, 1 << 20, engine);
+        auto b = sample(count, 1 << 20, engine);
+        RoaringBitmap ra = toRoaring(a);
+        RoaringBitmap rb = toRoaring(b);
+
+        std::vector<std::uint32_t> expected;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        assert(expected == (ra & rb).toVector());
+
+        expected.clear();
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        assert(expected == (ra | rb).toVector());
+
+        expected.clear();
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        assert(expected == (ra - rb).toVector());
+
+        // Results must not depend on the container representation
+        RoaringBitmap oa = ra;
+        oa.runOptimize();
+        assert(oa == ra);
+        assert((oa & rb) == (ra & rb));
+    }
+}
+
+// rank(select(i)) == i + 1 and select(rank(x) - 1) == x
+void test_RankSelect()
+{
+    std::mt19937_64 engine{7};
+    auto values = sample(50000, 1 << 22, engine);
+    RoaringBitmap b = toRoaring(values);
+
+    for (std::size_t i = 0; i < values.size(); i += 97)
+    {
+        assert(values[i] == b.select(i).value());
+        assert(i + 1 == b.rank(values[i]));
+    }
+
+    assert(!b.select(values.size()).has_value());
+    assert(values.size() == b.rank(0xFFFFFFFFu));
+}
+
+// Round trip through the portable format, with and without run containers
+void test_Serialization()
+{
+    std::mt19937_64 engine{11};
+    RoaringBitmap b = toRoaring(sample(30000, 1 << 20, engine));
+    b.addRange(5000000, 5100000);
+
+    auto bytes = b.serialize();
+    assert(bytes.size() == b.serializedSizeInBytes());
+    assert(b == RoaringBitmap::deserialize(bytes));
+
+    b.runOptimize();
+    bytes = b.serialize();
+    assert(bytes.size() == b.serializedSizeInBytes());
+    assert(b == RoaringBitmap::deserialize(bytes));
+
+    bool thrown = false;
+    try { RoaringBitmap::deserialize(std::span<const std::byte>{bytes.data(), 10}); }
+    catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+}
+
+// Reads the little endian 16 bit value at offset in bytes
+std::uint16_t read16(const std::vector<std::byte>& bytes, std::size_t offset)
+{
+    return static_cast<std::uint16_t>(std::to_integer<unsigned>(bytes[offset])
+                                      | std::to_integer<unsigned>(bytes[offset + 1]) << 8);
+}
+
+// Reads the little endian 32 bit value at offset in bytes
+std::uint32_t read32(const std::vector<std::byte>& bytes, std::size_t offset)
+{
+    return read16(bytes, offset) | static_cast<std::uint32_t>(read16(bytes, offset + 2)) << 16;
+}
+
+// Checks the exact bytes of an array, a bitmap and a run container against the RoaringFormatSpec layout
+void test_SerializationLayout()
+{
+    RoaringBitmap b{1, 5};                                              // Key 0: array {1, 5}
+    for (std::uint32_t v = 0; v < 5000; ++v) b.add(0x10000 + 2 * v);    // Key 1: bitmap of 5000 even values
+    for (std::uint32_t v = 0; v < 100; ++v) b.add(0x20000 + v);         // Key 2: array until runOptimize()
+    assert(RoaringBitmap::ContainerType::Array == b.containerType(0));
+    assert(RoaringBitmap::ContainerType::Bitmap == b.containerType(1));
+    assert(RoaringBitmap::ContainerType::Array == b.containerType(2));
+
+    // Without runs: cookie 12346, container count, key/cardinality - 1 pairs, then one offset per container
+    auto bytes = b.serialize();
+    assert(8 + 12 + 12 + 4 + 8192 + 200 == bytes.size());
+    assert(12346 == read32(bytes, 0));
+    assert(3 == read32(bytes, 4));
+    const std::uint16_t header[] = {0, 1, 1, 4999, 2, 99};
+    for (std::size_t i = 0; i < 6; ++i) assert(header[i] == read16(bytes, 8 + 2 * i));
+    assert(32 == read32(bytes, 20));
+    assert(36 == read32(bytes, 24));
+    assert(36 + 8192 == read32(bytes, 28));
+    assert(1 == read16(bytes, 32) && 5 == read16(bytes, 34));
+    for (std::size_t i = 0; i < 8; ++i) assert(std::byte{0x55} == bytes[36 + i]);
+    assert(0 == read16(bytes, 8228) && 99 == read16(bytes, 8228 + 198));
+
+    // With runs: cookie 12347 | (count - 1) << 16 and a run flag bitset. Fewer than 4 containers, so no offsets
+    b.runOptimize();
+    assert(RoaringBitmap::ContainerType::Bitmap == b.containerType(1));
+    assert(RoaringBitmap::ContainerType::Run == b.containerType(2));
+    bytes = b.serialize();
+    assert(4 + 1 + 12 + 4 + 8192 + 6 == bytes.size());
+    assert((12347 | 2 << 16) == read32(bytes, 0));
+    assert(std::byte{0b100} == bytes[4]);
+    for (std::size_t i = 0; i < 6; ++i) assert(header[i] == read16(bytes, 5 + 2 * i));
+    assert(1 == read16(bytes, 17) && 5 == read16(bytes, 19));
+    for (std::size_t i = 0; i < 8; ++i) assert(std::byte{0x55} == bytes[21 + i]);
+    assert(1 == read16(bytes, 8213));                                   // Number of runs
+    assert(0 == read16(bytes, 8215) && 99 == read16(bytes, 8217));      // Start and length - 1
+    assert(b == RoaringBitmap::deserialize(bytes));
+}
+
+// Runs f once and returns its running time in milliseconds
+template<typename F>
+double timeMs(F&& f)
+{
+    StopWatch stopWatch;
+    stopWatch.Start();
+    f();
+    stopWatch.Stop();
+    return 1e3 * stopWatch.ElapsedTime();
+}
+
+// Compares memory and intersection/union/difference time of the three set representations
+void benchmark_Densities()
+{
+    constexpr std::uint32_t UNIVERSE = 1 << 24;
+    std::mt19937_64 engine{2026};
+
+    std::cout << "\n*** RoaringBitmap vs boost::dynamic_bitset vs std::vector<bool> (universe 2^24) ***\n";
+    for (double density : {0.0001, 0.001, 0.01, 0.1, 0.5})
+    {
+        const auto count = static_cast<std::size_t>(density * UNIVERSE);
+        std::vector<std::uint32_t> a, b;
+        std::bernoulli_distribution coin{density};
+        for (std::uint32_t v = 0; v < UNIVERSE; ++v)
+        {
+            if (coin(engine)) a.push_back(v);
+            if (coin(engine)) b.push_back(v);
+        }
+
+        RoaringBitmap ra = toRoaring(a), rb = toRoaring(b);
+        boost::dynamic_bitset<> da(UNIVERSE), db(UNIVERSE);
+        std::vector<bool> va(UNIVERSE), vb(UNIVERSE);
+        for (std::uint32_t v : a) da.set(v), va[v] = true;
+        for (std::uint32_t v : b) db.set(v), vb[v] = true;
+
+        std::uint64_t sink = 0;
+        double roaringAnd = timeMs([&] { sink += (ra & rb).cardinality(); });
+        double roaringOr = timeMs([&] { sink += (ra | rb).cardinality(); });
+        double roaringSub = timeMs([&] { sink += (ra - rb).cardinality(); });
+        double dynamicAnd = timeMs([&] { sink += (da & db).count(); });
+        double dynamicOr = timeMs([&] { sink += (da | db).count(); });
+        double dynamicSub = timeMs([&] { sink += (da - db).count(); });
+        double vectorAnd = timeMs([&]
+        {
+            std::vector<bool> r(UNIVERSE);
+            for (std::size_t i = 0; i < UNIVERSE; ++i) r[i] = va[i] && vb[i];
+            sink += std::count(r.begin(), r.end(), true);
+        });
+
+        std::cout << "density " << density << " (~" << count << " values)\n"
+                  << "    memory  roaring " << ra.memoryInBytes() << "B (serialized " << ra.serializedSizeInBytes()
+                  << "B), dynamic_bitset " << UNIVERSE / 8 << "B, vector<bool> " << UNIVERSE / 8 << "B\n"
+                  << "    and/or/andnot roaring " << roaringAnd << "/" << roaringOr << "/" << roaringSub << "ms"
+                  << ", dynamic_bitset " << dynamicAnd << "/" << dynamicOr << "/" << dynamicSub << "ms"
+                  << ", vector<bool> and " << vectorAnd << "ms"
+                  << " (checksum " << sink << ")\n";
+    }
+}
+
+int main()
+{
+    test_AddContainsRemove();
+    test_RangesAndRuns();
+    test_SetAlgebra();
+    test_RankSelect();
+    test_Serialization();
+    test_SerializationLayout();
+
+    benchmark_Densities();
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
@@ -15,6 +15,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <queue>
 #include <thread>
@@ -28,9 +29,22 @@ using namespace std::chrono_literals;
 /**
  * Default ctor
  * @tparam T The data type for elements in this std::queue
+ * @tparam Allocator The allocator of the std::deque under the std::queue
  */
-template<typename T>
-ConcurrentQueue<T>::ConcurrentQueue() : queue{}, interrupt(false)
+template<typename T, typename Allocator>
+ConcurrentQueue<T, Allocator>::ConcurrentQueue() : queue{}, interrupt(false)
+{
+
+}
+
+/**
+ * Overloaded ctor
+ * @tparam T The data type for elements in this std::queue
+ * @tparam Allocator The allocator of the std::deque under the std::queue
+ * @param allocator Where the queue's buffers are allocated, such as a NodeAllocator for the consumers' node
+ */
+template<typename T, typename Allocator>
+ConcurrentQueue<T, Allocator>::ConcurrentQueue(const Allocator& allocator) : queue(allocator), interrupt(false)
 {
 
 }
@@ -40,8 +54,8 @@ ConcurrentQueue<T>::ConcurrentQueue() : queue{}, interrupt(false)
  * @tparam T The data type for elements in this std::queue
  * @param data The element to be inserted
  */
-template<typename T>
-void ConcurrentQueue<T>::enqueue(const T& data)
+template<typename T, typename Allocator>
+void ConcurrentQueue<T, Allocator>::enqueue(const T& data)
 {
     // Thread safe mechanisms
     std::lock_guard<std::mutex> lock(mutex);
@@ -55,8 +69,8 @@ void ConcurrentQueue<T>::enqueue(const T& data)
  * @tparam T The data type for elements in this std::queue
  * @return The element at the front of the queue
  */
-template<typename T>
-std::optional<T> ConcurrentQueue<T>::dequeue()
+template<typename T, typename Allocator>
+std::optional<T> ConcurrentQueue<T, Allocator>::dequeue()
 {
     // Thread safe mechanisms
     // Unique lock is used with cv.wait per https://en.cppreference.com/w/cpp/thread/condition_variable/wait
@@ -95,8 +109,8 @@ std::optional<T> ConcurrentQueue<T>::dequeue()
  * @tparam T The type of data in this ConcurrentQueue
  * @param value A boolean flag that can be used to terminate the producer and consumer threads
  */
-template<typename T>
-void ConcurrentQueue<T>::setInterrupt(bool value)
+template<typename T, typename Allocator>
+void ConcurrentQueue<T, Allocator>::setInterrupt(bool value)
 {
     std::lock_guard<std::mutex> lock(mutex);
     interrupt.store(value);
@@ -108,8 +122,8 @@ void ConcurrentQueue<T>::setInterrupt(bool value)
  * @return True if the Producers and Consumers should be interrupted. Otherwise false and the
  * Producers and Consumers continue working.
  */
-template<typename T>
-std::atomic<bool> ConcurrentQueue<T>::isInterrupted()
+template<typename T, typename Allocator>
+std::atomic<bool> ConcurrentQueue<T, Allocator>::isInterrupted()
 {
     return interrupt.load();
 }
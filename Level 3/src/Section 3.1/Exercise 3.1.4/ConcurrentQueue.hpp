@@ -15,29 +15,33 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <iostream>
 #include <optional>
 #include <queue>
+#include <string>
 #include <thread>
 
-template<typename T>
+template<typename T, typename Allocator = std::allocator<T>>
 class ConcurrentQueue
 {
 private:
-    std::queue<T> queue;
+    std::queue<T, std::deque<T, Allocator>> queue;
     std::mutex mutex;
     std::condition_variable cv;
     std::atomic<bool> interrupt;
 
 public:
     ConcurrentQueue();
-    ConcurrentQueue(const ConcurrentQueue<T>& source) = delete;
-    ConcurrentQueue(ConcurrentQueue<T>&& source) noexcept = delete;
+    explicit ConcurrentQueue(const Allocator& allocator);
+    ConcurrentQueue(const ConcurrentQueue<T, Allocator>& source) = delete;
+    ConcurrentQueue(ConcurrentQueue<T, Allocator>&& source) noexcept = delete;
     ~ConcurrentQueue() = default;
 
     // Operator overloads
-    ConcurrentQueue& operator=(const ConcurrentQueue<T>& source) = delete;
-    ConcurrentQueue& operator=(ConcurrentQueue<T>&& source) noexcept = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue<T, Allocator>& source) = delete;
+    ConcurrentQueue& operator=(ConcurrentQueue<T, Allocator>&& source) noexcept = delete;
 
     // Core functionality
     void enqueue(const T& data);
@@ -53,4 +57,8 @@ public:
 #include "ConcurrentQueue.cpp"
 #endif
 
+// The queue shared by the Producers and Consumers, its buffers allocated on the Consumers' NUMA node
+#include "NodeAllocator.hpp"
+using MessageQueue = ConcurrentQueue<std::string, NodeAllocator<std::string>>;
+
 #endif //ADVANCED_CPP_AND_MODERN_DESIGN_CONCURRENTQUEUE_HPP
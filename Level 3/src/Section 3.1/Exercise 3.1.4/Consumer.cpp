@@ -21,7 +21,7 @@
  * @param threadId A unique Consumer identifier
  * @param queue A ConcurrentQueue to consume data from
  */
-Consumer::Consumer(int threadId, std::shared_ptr<ConcurrentQueue<std::string>> queue) : threadId{threadId}, queue{std::move(queue)} {}
+Consumer::Consumer(int threadId, std::shared_ptr<MessageQueue> queue) : threadId{threadId}, queue{std::move(queue)} {}
 
 /**
  * A thread function that consumes data from the ConcurrentQueue.
@@ -20,11 +20,11 @@ class Consumer
 {
 private:
     int threadId;
-    std::shared_ptr<ConcurrentQueue<std::string>> queue;
+    std::shared_ptr<MessageQueue> queue;
 
 public:
     Consumer() = delete;
-    explicit Consumer(int threadId, std::shared_ptr<ConcurrentQueue<std::string>> queue);
+    explicit Consumer(int threadId, std::shared_ptr<MessageQueue> queue);
     Consumer(const Consumer& source) = delete;
     Consumer(Consumer&& source) noexcept = default;
     ~Consumer() = default;
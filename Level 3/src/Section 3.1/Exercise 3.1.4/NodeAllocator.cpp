@@ -0,0 +1,160 @@
+//
+// Memory regions bound to a NUMA node, handed out in size classes
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "NodeAllocator.hpp"
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Overloaded ctor
+ * @param node The NUMA node to place memory on, -1 to leave it to the kernel
+ * @param regionBytes The size of each region mapped for blocks of a page or less
+ * @throws std::invalid_argument if the node is out of range
+ */
+NodeArena::NodeArena(int node, std::size_t regionBytes)
+    : numaNode{node}, regionBytes{std::max(regionBytes, PAGE)}, bound{node >= 0}, mutex{}, regions{}, freeLists{}, cursor{nullptr}, end{nullptr}
+{
+    if (node < -1 || node >= 64) throw std::invalid_argument("NUMA node " + std::to_string(node) + " is out of range");
+}
+
+/**
+ * Unmaps every region; the containers using the arena must have been destroyed first
+ */
+NodeArena::~NodeArena()
+{
+    for (const auto& [address, bytes] : regions)
+    {
+#if defined(__linux__)
+        munmap(address, bytes);
+#else
+        ::operator delete(address, bytes, std::align_val_t{PAGE});
+#endif
+    }
+}
+
+/**
+ * @return The bytes mapped for blocks of a page or less
+ */
+std::size_t NodeArena::mapped() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t total = 0;
+    for (const auto& region : regions) total += region.second;
+    return total;
+}
+
+/**
+ * Maps whole pages and binds them to the node
+ * @param bytes A multiple of the page size
+ * @return The first page
+ * @throws std::bad_alloc if the memory cannot be mapped
+ */
+void* NodeArena::map(std::size_t bytes)
+{
+#if defined(__linux__)
+    void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (address == MAP_FAILED) throw std::bad_alloc();
+    if (numaNode >= 0)
+    {
+        // Preferred rather than bound, so that a full node spills to another instead of failing
+        const unsigned long mask = 1UL << numaNode;
+        if (syscall(SYS_mbind, address, bytes, MPOL_PREFERRED, &mask, sizeof(mask) * 8, 0) != 0) bound.store(false, std::memory_order_relaxed);
+    }
+    return address;
+#else
+    bound.store(false, std::memory_order_relaxed);
+    return ::operator new(bytes, std::align_val_t{PAGE});
+#endif
+}
+
+/**
+ * @param bytes The size of the block
+ * @param alignment Its alignment, at most a page
+ * @return A block on the arena's node, aligned to its power-of-two size class
+ * @throws std::bad_alloc if the memory cannot be mapped or the alignment is over a page
+ */
+void* NodeArena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (alignment > PAGE) throw std::bad_alloc();
+    const std::size_t size = std::bit_ceil(std::max({bytes, alignment, MIN_BLOCK}));
+    if (size > PAGE)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return map((bytes + PAGE - 1) & ~(PAGE - 1));
+    }
+
+    const auto index = static_cast<std::size_t>(std::countr_zero(size) - std::countr_zero(MIN_BLOCK));
+    std::lock_guard<std::mutex> lock(mutex);
+    if (FreeBlock* block = freeLists[index])
+    {
+        freeLists[index] = block->next;
+        return block;
+    }
+
+    // Carve every block at the alignment of its size class, so that a block freed by a caller that asked for
+    // less alignment still satisfies the next caller of the class, which may ask for up to the size itself
+    char* start = cursor ? reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(cursor) + size - 1) & ~(size - 1)) : nullptr;
+    if (!start || start + size > end)
+    {
+        // The rest of the current region is left unused
+        start = static_cast<char*>(map(regionBytes));
+        regions.emplace_back(start, regionBytes);
+        end = start + regionBytes;
+    }
+    cursor = start + size;
+    return start;
+}
+
+/**
+ * @param pointer A block from allocate()
+ * @param bytes The size it was allocated with
+ * @param alignment The alignment it was allocated with
+ */
+void NodeArena::deallocate(void* pointer, std::size_t bytes, std::size_t alignment) noexcept
+{
+    if (!pointer) return;
+    const std::size_t size = std::bit_ceil(std::max({bytes, alignment, MIN_BLOCK}));
+    if (size > PAGE)
+    {
+#if defined(__linux__)
+        munmap(pointer, (bytes + PAGE - 1) & ~(PAGE - 1));
+#else
+        ::operator delete(pointer, (bytes + PAGE - 1) & ~(PAGE - 1), std::align_val_t{PAGE});
+#endif
+        return;
+    }
+
+    const auto index = static_cast<std::size_t>(std::countr_zero(size) - std::countr_zero(MIN_BLOCK));
+    std::lock_guard<std::mutex> lock(mutex);
+    auto* block = static_cast<FreeBlock*>(pointer);
+    block->next = freeLists[index];
+    freeLists[index] = block;
+}
+
+/**
+ * @param address Memory that has been touched
+ * @return The NUMA node its page is on, none if that cannot be found out
+ */
+std::optional<unsigned> NodeArena::nodeOf(const void* address) noexcept
+{
+#if defined(__linux__)
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, const_cast<void*>(address), MPOL_F_NODE | MPOL_F_ADDR) == 0 && node >= 0)
+        return static_cast<unsigned>(node);
+#endif
+    return std::nullopt;
+}
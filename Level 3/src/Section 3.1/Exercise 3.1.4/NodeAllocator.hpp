@@ -0,0 +1,118 @@
+//
+// Memory on a chosen NUMA node. A NodeArena maps regions of memory and asks the kernel, through mbind, to
+// place their pages on its node whichever thread touches them first; without that, the pages of a queue's
+// buffers land on the node of the producer that happens to fill them, and every consumer on another node
+// reads them across the interconnect. The arena hands the regions out in power-of-two size classes with a
+// free list each, since the containers of a queue allocate and free the same few sizes over and over; each
+// block is aligned to its class, so any block on a list suits any request of that class. Blocks larger than a
+// page are mapped and bound one by one.
+//
+// NodeAllocator is the standard allocator over an arena, so that a std::deque or std::vector may keep its
+// buffers on the node of the threads that read them. One without an arena is the global operator new.
+// Where mbind is unavailable the arena still works, and its pages follow the kernel's first-touch policy.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_NODEALLOCATOR_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_NODEALLOCATOR_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <utility>
+#include <vector>
+
+class NodeArena
+{
+private:
+    static constexpr std::size_t MIN_BLOCK = 16;
+    static constexpr std::size_t PAGE = 4096;
+    static constexpr std::size_t CLASSES = 9;           // 16 bytes to a page
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    int numaNode;                   // -1 for no binding
+    std::size_t regionBytes;
+    std::atomic<bool> bound;        // Whether every mbind so far has succeeded
+    mutable std::mutex mutex;
+    std::vector<std::pair<void*, std::size_t>> regions;
+    std::array<FreeBlock*, CLASSES> freeLists;
+    char* cursor;
+    char* end;
+
+    void* map(std::size_t bytes);
+
+public:
+    NodeArena() = delete;
+    explicit NodeArena(int node, std::size_t regionBytes = std::size_t{1} << 20);
+    NodeArena(const NodeArena& source) = delete;
+    NodeArena(NodeArena&& source) = delete;
+    ~NodeArena();
+
+    // Operator overloads
+    NodeArena& operator=(const NodeArena& source) = delete;
+    NodeArena& operator=(NodeArena&& source) = delete;
+
+    // Accessors
+    int node() const noexcept { return numaNode; }
+    bool isBound() const noexcept { return bound.load(std::memory_order_relaxed); }
+    std::size_t mapped() const;
+
+    // Core functionality
+    void* allocate(std::size_t bytes, std::size_t alignment);
+    void deallocate(void* pointer, std::size_t bytes, std::size_t alignment) noexcept;
+    static std::optional<unsigned> nodeOf(const void* address) noexcept;
+};
+
+template<typename T>
+class NodeAllocator
+{
+private:
+    template<typename U> friend class NodeAllocator;
+
+    std::shared_ptr<NodeArena> arena;
+
+public:
+    using value_type = T;
+
+    NodeAllocator() noexcept = default;
+    explicit NodeAllocator(std::shared_ptr<NodeArena> arena) noexcept : arena{std::move(arena)} {}
+    template<typename U>
+    NodeAllocator(const NodeAllocator<U>& source) noexcept : arena{source.arena} {}
+    NodeAllocator(const NodeAllocator& source) noexcept = default;
+    NodeAllocator(NodeAllocator&& source) noexcept = default;
+    ~NodeAllocator() = default;
+
+    // Operator overloads
+    NodeAllocator& operator=(const NodeAllocator& source) noexcept = default;
+    NodeAllocator& operator=(NodeAllocator&& source) noexcept = default;
+    template<typename U>
+    bool operator==(const NodeAllocator<U>& other) const noexcept { return arena == other.arena; }
+
+    // Accessors
+    const std::shared_ptr<NodeArena>& source() const noexcept { return arena; }
+
+    // Core functionality
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T)) throw std::bad_array_new_length();
+        if (!arena) return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t n) noexcept
+    {
+        if (!arena) ::operator delete(pointer, n * sizeof(T), std::align_val_t{alignof(T)});
+        else arena->deallocate(pointer, n * sizeof(T), alignof(T));
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_NODEALLOCATOR_HPP
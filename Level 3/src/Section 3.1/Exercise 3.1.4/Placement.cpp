@@ -0,0 +1,199 @@
+//
+// Placement policies, thread pinning and the placement report
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+#include "Placement.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * Overloaded ctor
+ * @param topology The machine, or the part of it the threads may use
+ * @param policy How to order its CPUs
+ * @param cpuList The CPUs for PlacementPolicy::CoreList, ignored otherwise
+ * @throws std::invalid_argument if a core list is empty or names a CPU the machine does not have online
+ */
+Placement::Placement(Topology topology, PlacementPolicy policy, const std::vector<unsigned>& cpuList)
+    : topology{std::move(topology)}, policy{policy}, order{}, mutex{}, placed{}
+{
+    std::vector<LogicalCpu> cpus = this->topology.cpus();
+    switch (policy)
+    {
+        case PlacementPolicy::Unpinned:
+            break;
+        case PlacementPolicy::Compact:
+            std::sort(cpus.begin(), cpus.end(), [](const LogicalCpu& lhs, const LogicalCpu& rhs)
+            {
+                return std::tie(lhs.node, lhs.package, lhs.core, lhs.thread, lhs.id) < std::tie(rhs.node, rhs.package, rhs.core, rhs.thread, rhs.id);
+            });
+            for (const LogicalCpu& cpu : cpus) order.push_back(cpu.id);
+            break;
+        case PlacementPolicy::Scatter:
+        {
+            // First siblings of every core before second ones, taking a CPU from each node in turn
+            std::map<unsigned, std::vector<LogicalCpu>> byNode;
+            for (const LogicalCpu& cpu : cpus) byNode[cpu.node].push_back(cpu);
+            std::size_t longest = 0;
+            for (auto& [node, members] : byNode)
+            {
+                std::sort(members.begin(), members.end(), [](const LogicalCpu& lhs, const LogicalCpu& rhs)
+                {
+                    return std::tie(lhs.thread, lhs.package, lhs.core, lhs.id) < std::tie(rhs.thread, rhs.package, rhs.core, rhs.id);
+                });
+                longest = std::max(longest, members.size());
+            }
+            for (std::size_t i = 0; i < longest; ++i)
+            {
+                for (const auto& [node, members] : byNode)
+                {
+                    if (i < members.size()) order.push_back(members[i].id);
+                }
+            }
+            break;
+        }
+        case PlacementPolicy::CoreList:
+            if (cpuList.empty()) throw std::invalid_argument("A core list placement needs at least one CPU");
+            for (unsigned id : cpuList) order.push_back(this->topology.cpu(id).id);
+            break;
+    }
+}
+
+/**
+ * @param index A thread's index
+ * @return The CPU it is placed on, none if unpinned
+ */
+std::optional<unsigned> Placement::cpuFor(std::size_t index) const noexcept
+{
+    if (order.empty()) return std::nullopt;
+    return order[index % order.size()];
+}
+
+/**
+ * @param index A thread's index
+ * @return The NUMA node of its CPU, none if unpinned
+ */
+std::optional<unsigned> Placement::nodeFor(std::size_t index) const
+{
+    const std::optional<unsigned> cpu = cpuFor(index);
+    if (!cpu) return std::nullopt;
+    return topology.cpu(*cpu).node;
+}
+
+/**
+ * @return The threads spawned so far, by index
+ */
+std::vector<PlacedThread> Placement::placements() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return placed;
+}
+
+/**
+ * @param thread A thread that has just pinned itself
+ */
+void Placement::record(PlacedThread thread)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto position = std::upper_bound(placed.begin(), placed.end(), thread.index,
+                                           [](std::size_t index, const PlacedThread& other) { return index < other.index; });
+    placed.insert(position, std::move(thread));
+}
+
+/**
+ * @param name compact, scatter or unpinned
+ * @return The policy
+ * @throws std::invalid_argument for any other name
+ */
+PlacementPolicy Placement::parsePolicy(const std::string& name)
+{
+    if (name == "compact") return PlacementPolicy::Compact;
+    if (name == "scatter") return PlacementPolicy::Scatter;
+    if (name == "unpinned") return PlacementPolicy::Unpinned;
+    throw std::invalid_argument("Unknown placement policy: " + name + " (expected compact, scatter or unpinned)");
+}
+
+/**
+ * @return The CPUs this process may run on in ascending order; empty if that cannot be found out
+ */
+std::vector<unsigned> Placement::allowedCpus()
+{
+    std::vector<unsigned> allowed;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &set)) allowed.push_back(cpu);
+        }
+    }
+#endif
+    return allowed;
+}
+
+/**
+ * @param cpu The CPU the calling thread should run on from now on
+ * @return Whether the kernel accepted it; never on systems without thread affinity
+ */
+bool Placement::pinCurrentThread(unsigned cpu) noexcept
+{
+#if defined(__linux__)
+    if (cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @return The CPU the calling thread is running on, -1 if unknown
+ */
+int Placement::currentCpu() noexcept
+{
+#if defined(__linux__)
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @return The machine, the policy and each thread spawned with where it was placed and where it runs
+ */
+std::string Placement::report() const
+{
+    static constexpr const char* NAMES[] = {"unpinned", "compact", "scatter", "core list"};
+    std::ostringstream out;
+    out << topology.describe() << "\nPlacement: " << NAMES[static_cast<int>(policy)] << '\n';
+    for (const PlacedThread& thread : placements())
+    {
+        out << "  " << thread.name << ": ";
+        if (!thread.cpu)
+        {
+            out << "unpinned";
+        }
+        else
+        {
+            const LogicalCpu& cpu = topology.cpu(*thread.cpu);
+            out << "cpu " << cpu.id << " (package " << cpu.package << ", core " << cpu.core << ", SMT thread "
+                << cpu.thread << ", node " << cpu.node << ")" << (thread.pinned ? "" : " - pinning failed");
+        }
+        out << ", running on cpu " << thread.running << '\n';
+    }
+    return out.str();
+}
@@ -0,0 +1,104 @@
+//
+// Places threads on CPUs by policy and reports where each one landed. Compact fills the SMT siblings of a
+// core, then the cores of a node, before moving on, so that threads which share data share caches. Scatter
+// gives each thread a core of its own and spreads them across the NUMA nodes in turn, so that threads which
+// do not share data do not compete for a core, cache or memory controller. A core list pins the threads to
+// the CPUs given, in order. Thread i of any policy takes the i-th CPU of its sequence, wrapping around.
+//
+// spawn() starts a thread that pins itself before running its function, so that its stack and whatever it
+// allocates first are placed on its own node, and returns only once the thread is pinned; report() lists
+// every thread spawned with the CPU it asked for and the one it runs on.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_PLACEMENT_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_PLACEMENT_HPP
+
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Topology.hpp"
+
+enum class PlacementPolicy { Unpinned, Compact, Scatter, CoreList };
+
+struct PlacedThread
+{
+    std::size_t index;
+    std::string name;
+    std::optional<unsigned> cpu;    // The CPU it was placed on, none if unpinned
+    bool pinned;                    // Whether the kernel accepted the affinity
+    int running;                    // The CPU it ran on once pinned, -1 if unknown
+};
+
+class Placement
+{
+private:
+    Topology topology;
+    PlacementPolicy policy;
+    std::vector<unsigned> order;            // The CPUs in the order threads take them
+    mutable std::mutex mutex;
+    std::vector<PlacedThread> placed;
+
+    void record(PlacedThread thread);
+
+public:
+    Placement() = delete;
+    Placement(Topology topology, PlacementPolicy policy, const std::vector<unsigned>& cpuList = {});
+    Placement(const Placement& source) = delete;
+    Placement(Placement&& source) = delete;
+    ~Placement() = default;
+
+    // Operator overloads
+    Placement& operator=(const Placement& source) = delete;
+    Placement& operator=(Placement&& source) = delete;
+
+    // Accessors
+    const Topology& machine() const noexcept { return topology; }
+    PlacementPolicy strategy() const noexcept { return policy; }
+    const std::vector<unsigned>& sequence() const noexcept { return order; }
+    std::optional<unsigned> cpuFor(std::size_t index) const noexcept;
+    std::optional<unsigned> nodeFor(std::size_t index) const;
+    std::vector<PlacedThread> placements() const;
+
+    // Core functionality
+    static PlacementPolicy parsePolicy(const std::string& name);
+    static std::vector<unsigned> allowedCpus();
+    static bool pinCurrentThread(unsigned cpu) noexcept;
+    static int currentCpu() noexcept;
+    std::string report() const;
+
+    /**
+     * Starts a thread on the CPU for its index
+     * @tparam Function A callable taking no arguments, such as a Producer or Consumer
+     * @param index The thread's index in the sequence of CPUs
+     * @param name A name for the report
+     * @param function What the thread runs once pinned
+     * @return The thread, already pinned
+     */
+    template<typename Function>
+    std::thread spawn(std::size_t index, std::string name, Function&& function)
+    {
+        std::promise<void> started;
+        std::future<void> ready = started.get_future();
+        std::thread thread([this, index, name = std::move(name), function = std::forward<Function>(function),
+                            started = std::move(started)]() mutable
+        {
+            const std::optional<unsigned> cpu = cpuFor(index);
+            const bool pinned = cpu.has_value() && pinCurrentThread(*cpu);
+            record(PlacedThread{index, std::move(name), cpu, pinned, currentCpu()});
+            started.set_value();
+            function();
+        });
+        ready.wait();
+        return thread;
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_PLACEMENT_HPP
@@ -20,7 +20,7 @@
  * @param threadId A unique Producer identifier
  * @param queue A ConcurrentQueue to publish data into
  */
-Producer::Producer(int threadId, std::shared_ptr<ConcurrentQueue<std::string>> queue) : threadId{threadId}, queue{std::move(queue)} {}
+Producer::Producer(int threadId, std::shared_ptr<MessageQueue> queue) : threadId{threadId}, queue{std::move(queue)} {}
 
 /**
  * A thread function that publishes data into the queue.
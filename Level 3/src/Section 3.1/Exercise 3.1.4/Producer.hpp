@@ -20,11 +20,11 @@ class Producer
 {
 private:
     int threadId;
-    std::shared_ptr<ConcurrentQueue<std::string>> queue;
+    std::shared_ptr<MessageQueue> queue;
 
 public:
     Producer() = delete;
-    explicit Producer(int threadId, std::shared_ptr<ConcurrentQueue<std::string>> queue);
+    explicit Producer(int threadId, std::shared_ptr<MessageQueue> queue);
     Producer(const Producer& source) = delete;
     Producer(Producer&& source) noexcept = default;
     ~Producer() = default;
@@ -2,38 +2,329 @@
 // A simple test program to illustrate the ConcurrentQueue with multiple threads producing
 // and consuming data
 //
+// The Producers and Consumers are placed on CPUs by a policy given on the command line - compact, scatter,
+// unpinned or a CPU list such as 0-3,8 - and the queue's buffers on the NUMA node of the first Consumer.
+// Tests of the topology discovery use a made-up sysfs tree of two packages on two nodes, each with two cores
+// of two SMT threads.
+//
 // Created by Michael Lewis on 6/29/23.
 //
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cctype>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
 #include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include "ConcurrentQueue.hpp"
 #include "Consumer.hpp"
+#include "NodeAllocator.hpp"
+#include "Placement.hpp"
 #include "Producer.hpp"
+#include "StopWatch.hpp"
+#include "Topology.hpp"
 
-int main()
+// Writes a sysfs tree for 8 CPUs: package p, core c, SMT thread t is CPU 4t + 2p + c, and package p is node p
+std::filesystem::path fakeSysfs()
 {
+    namespace fs = std::filesystem;
+    const fs::path root = fs::temp_directory_path() / ("topology_test_" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())));
+    fs::remove_all(root);
+    auto write = [](const fs::path& path, const std::string& text)
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream(path) << text << '\n';
+    };
+
+    write(root / "cpu" / "online", "0-7");
+    write(root / "node" / "node0" / "cpulist", "0-1,4-5");
+    write(root / "node" / "node1" / "cpulist", "2-3,6-7");
+    write(root / "node" / "online", "0-1");
+    for (unsigned id = 0; id < 8; ++id)
+    {
+        const unsigned core = id % 2, package = (id / 2) % 2, first = 2 * package + core;
+        const fs::path cpu = root / "cpu" / ("cpu" + std::to_string(id));
+        write(cpu / "topology" / "core_id", std::to_string(core));
+        write(cpu / "topology" / "physical_package_id", std::to_string(package));
+        write(cpu / "topology" / "thread_siblings_list", std::to_string(first) + "," + std::to_string(first + 4));
+        write(cpu / "cache" / "index0" / "level", "1");
+        write(cpu / "cache" / "index0" / "type", "Data");
+        write(cpu / "cache" / "index0" / "size", "32K");
+        write(cpu / "cache" / "index0" / "shared_cpu_list", std::to_string(first) + "," + std::to_string(first + 4));
+        write(cpu / "cache" / "index1" / "level", "3");
+        write(cpu / "cache" / "index1" / "type", "Unified");
+        write(cpu / "cache" / "index1" / "size", "8M");
+        write(cpu / "cache" / "index1" / "shared_cpu_list", package == 0 ? "0-1,4-5" : "2-3,6-7");
+    }
+    return root;
+}
+
+void test_ParseCpuList()
+{
+    assert((Topology::parseCpuList("0-3,8,10-11") == std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11}));
+    assert((Topology::parseCpuList("5, 1-2\n") == std::vector<unsigned>{1, 2, 5}));
+    assert(Topology::parseCpuList("").empty());
+    for (const std::string bad : {"3-1", "a", "1-", "1,x"})
+    {
+        bool threw = false;
+        try { Topology::parseCpuList(bad); }
+        catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+    }
+}
+
+void test_Discover()
+{
+    const std::filesystem::path root = fakeSysfs();
+    const Topology machine = Topology::discover(root.string());
+    assert(machine.cpus().size() == 8);
+    assert(machine.cores() == 4);
+    assert(machine.packages() == 2);
+    assert((machine.nodes() == std::vector<unsigned>{0, 1}));
+    assert(machine.cpu(5).core == 1 && machine.cpu(5).package == 0 && machine.cpu(5).node == 0 && machine.cpu(5).thread == 1);
+    assert(machine.cpu(2).core == 0 && machine.cpu(2).package == 1 && machine.cpu(2).node == 1 && machine.cpu(2).thread == 0);
+
+    // Each L1 once per core, each L3 once per package
+    assert(machine.caches().size() == 6);
+    assert(machine.caches().front().level == 1 && machine.caches().front().bytes == 32 * 1024);
+    assert(machine.caches().back().level == 3 && machine.caches().back().bytes == 8 * 1024 * 1024);
+    assert(machine.caches().back().cpus.size() == 4);
+    assert(machine.describe().find("8 logical CPU(s), 4 core(s), 2 package(s), 2 NUMA node(s)") == 0);
+
+    bool threw = false;
+    try { machine.cpu(8); }
+    catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    const Topology half = machine.restrictedTo({0, 1, 4, 5});
+    assert(half.cpus().size() == 4 && half.nodes().size() == 1 && half.caches().size() == 3);
+    assert(machine.restrictedTo({42}).cpus().size() == 8);
+
+    // Without a tree the machine is flat
+    const Topology missing = Topology::discover((root / "missing").string());
+    assert(missing.cpus().size() == std::max(1u, std::thread::hardware_concurrency()));
+    assert(missing.nodes().size() == 1);
+    std::filesystem::remove_all(root);
+}
+
+void test_Policies()
+{
+    const std::filesystem::path root = fakeSysfs();
+    const Topology machine = Topology::discover(root.string());
+    std::filesystem::remove_all(root);
+
+    // Compact: both threads of a core, then the next core, then the next node
+    const Placement compact{machine, PlacementPolicy::Compact};
+    assert((compact.sequence() == std::vector<unsigned>{0, 4, 1, 5, 2, 6, 3, 7}));
+
+    // Scatter: a core each, alternating nodes, before any second SMT thread
+    const Placement scatter{machine, PlacementPolicy::Scatter};
+    assert((scatter.sequence() == std::vector<unsigned>{0, 2, 1, 3, 4, 6, 5, 7}));
+    assert(scatter.cpuFor(9) == 2u && scatter.nodeFor(9) == 1u);
+
+    const Placement list{machine, PlacementPolicy::CoreList, {3, 1}};
+    assert(list.cpuFor(0) == 3u && list.cpuFor(1) == 1u && list.cpuFor(2) == 3u);
+    assert(list.nodeFor(0) == 1u && list.nodeFor(1) == 0u);
+
+    const Placement unpinned{machine, PlacementPolicy::Unpinned};
+    assert(!unpinned.cpuFor(0) && !unpinned.nodeFor(0));
+
+    for (const std::vector<unsigned>& bad : {std::vector<unsigned>{}, std::vector<unsigned>{1, 8}})
+    {
+        bool threw = false;
+        try { Placement{machine, PlacementPolicy::CoreList, bad}; }
+        catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+    }
+
+    assert(Placement::parsePolicy("compact") == PlacementPolicy::Compact);
+    assert(Placement::parsePolicy("scatter") == PlacementPolicy::Scatter);
+    assert(Placement::parsePolicy("unpinned") == PlacementPolicy::Unpinned);
+    bool threw = false;
+    try { Placement::parsePolicy("random"); }
+    catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+}
+
+void test_Spawn()
+{
+    const Topology machine = Topology::discover().restrictedTo(Placement::allowedCpus());
+    Placement placement{machine, PlacementPolicy::Scatter};
+    std::vector<std::thread> threads;
+    std::array<int, 3> ran{-1, -1, -1};
+    for (std::size_t i = 0; i < ran.size(); ++i)
+    {
+        threads.push_back(placement.spawn(i, "worker " + std::to_string(i), [&ran, i] { ran[i] = Placement::currentCpu(); }));
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    // Each thread was pinned before it ran, and the report lists all of them by index
+    const std::vector<PlacedThread> placed = placement.placements();
+    assert(placed.size() == ran.size());
+    for (std::size_t i = 0; i < placed.size(); ++i)
+    {
+        assert(placed[i].index == i && placed[i].name == "worker " + std::to_string(i));
+        assert(placed[i].cpu == placement.cpuFor(i));
+        if (placed[i].pinned && ran[i] >= 0) assert(static_cast<unsigned>(ran[i]) == *placed[i].cpu);
+    }
+    assert(placement.report().find("worker 2: cpu") != std::string::npos);
+}
+
+void test_NodeArena()
+{
+    const auto arena = std::make_shared<NodeArena>(0, 64 * 1024);
+    assert(arena->node() == 0 && arena->mapped() == 0);
+
+    // Blocks are aligned, reused once freed, and taken from the node the arena is bound to
+    void* small = arena->allocate(24, 8);
+    assert(reinterpret_cast<std::uintptr_t>(small) % 16 == 0);
+    arena->deallocate(small, 24, 8);
+    assert(arena->allocate(32, 8) == small);
+    void* aligned = arena->allocate(100, 128);
+    assert(reinterpret_cast<std::uintptr_t>(aligned) % 128 == 0);
+
+    // A block of a class freed by a caller that asked for little alignment is reused for one that asks for all
+    void* spacer = arena->allocate(16, 16);
+    void* loose = arena->allocate(64, 8);
+    arena->deallocate(loose, 64, 8);
+    void* strict = arena->allocate(64, 64);
+    assert(strict == loose && reinterpret_cast<std::uintptr_t>(strict) % 64 == 0);
+    arena->deallocate(strict, 64, 64);
+    arena->deallocate(spacer, 16, 16);
+    void* large = arena->allocate(100'000, 64);
+    static_cast<char*>(large)[99'999] = 1;
+    arena->deallocate(large, 100'000, 64);
+    assert(arena->mapped() == 64 * 1024);
+    static_cast<char*>(small)[0] = 1;
+    if (arena->isBound() && NodeArena::nodeOf(small)) assert(*NodeArena::nodeOf(small) == 0);
+
+    bool threw = false;
+    try { NodeArena{64}; }
+    catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    // A std::deque over the arena behaves as over the heap
+    NodeAllocator<std::string> onNode{arena};
+    assert(onNode == NodeAllocator<int>{arena} && !(onNode == NodeAllocator<std::string>{}));
+    std::deque<std::string, NodeAllocator<std::string>> strings(onNode);
+    std::deque<std::string> reference;
+    for (int i = 0; i < 100'000; ++i)
+    {
+        strings.push_back("message " + std::to_string(i));
+        reference.push_back("message " + std::to_string(i));
+        if (i % 3 == 0)
+        {
+            strings.pop_front();
+            reference.pop_front();
+        }
+    }
+    assert(std::equal(strings.begin(), strings.end(), reference.begin(), reference.end()));
+
+    // As does the queue of the exercise
+    MessageQueue queue{NodeAllocator<std::string>{arena}};
+    queue.enqueue("first");
+    queue.enqueue("second");
+    assert(queue.dequeue() == "first" && queue.dequeue() == "second");
+    MessageQueue onHeap;
+    onHeap.enqueue("third");
+    assert(onHeap.dequeue() == "third");
+}
+
+// Enqueue and dequeue through the queue's std::deque with its buffers on the heap and in a node arena
+void benchmark_Allocators()
+{
+    constexpr int N = 1'000'000;
+    auto run = [](auto& queue)
+    {
+        StopWatch stopWatch;
+        std::size_t total = 0;
+        stopWatch.StartStopWatch();
+        for (int i = 0; i < N; ++i)
+        {
+            queue.enqueue("x");
+            if (i % 4 != 0) total += queue.dequeue()->size();
+        }
+        while (auto message = queue.dequeue()) total += message->size();
+        stopWatch.StopStopWatch();
+
+        // Every one character message comes back out exactly once
+        assert(N == total);
+        return stopWatch.GetTime();
+    };
+
+    // Interrupted queues return at once when empty rather than waiting for a message
+    ConcurrentQueue<std::string> heap;
+    MessageQueue arena{NodeAllocator<std::string>{std::make_shared<NodeArena>(0)}};
+    heap.setInterrupt(true);
+    arena.setInterrupt(true);
+    const double heapSeconds = run(heap);
+    const double arenaSeconds = run(arena);
+    std::cout << "ns per enqueue/dequeue: std::allocator " << heapSeconds * 1e9 / N << ", NodeAllocator " << arenaSeconds * 1e9 / N << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    test_ParseCpuList();
+    test_Discover();
+    test_Policies();
+    test_Spawn();
+    test_NodeArena();
+    benchmark_Allocators();
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    // compact, scatter, unpinned or a list of CPUs
+    const std::string policy = argc > 1 ? argv[1] : "compact";
+    const Topology machine = Topology::discover().restrictedTo(Placement::allowedCpus());
+    const bool isList = !policy.empty() && std::isdigit(static_cast<unsigned char>(policy.front()));
+    Placement placement{machine, isList ? PlacementPolicy::CoreList : Placement::parsePolicy(policy),
+                        isList ? Topology::parseCpuList(policy) : std::vector<unsigned>{}};
+
     constexpr int NUM_THREADS = 100;
     std::array<std::thread, NUM_THREADS> producerThreads;
     std::array<std::thread, NUM_THREADS> consumerThreads;
-    std::shared_ptr<ConcurrentQueue<std::string>> queue(new ConcurrentQueue<std::string>{});
 
-    // Create producers - Note, threadId are purposely set to an integer value instead of std::this_thread::id
-    // to make it easier to identify which thread is producing
+    // The Consumers take the first CPUs of the placement and the queue's buffers go on the first one's node
+    const std::optional<unsigned> node = placement.nodeFor(0);
+    auto arena = std::make_shared<NodeArena>(node ? static_cast<int>(*node) : -1);
+    std::shared_ptr<MessageQueue> queue(new MessageQueue{NodeAllocator<std::string>{arena}});
+
+    // Create consumers - Note, threadId are purposely set to an integer value instead of std::this_thread::id
+    // to make it easier to identify which thread is consuming
     for (int i = 0; i < NUM_THREADS; ++i)
     {
-        producerThreads[i] = std::thread(Producer{i, queue});
+        consumerThreads[i] = placement.spawn(i, "Consumer " + std::to_string(i), Consumer{i, queue});
     }
 
-    // Create consumers - Note, threadId are purposely set to an integer value instead of std::this_thread::id
-    // to make it easier to identify which thread is consuming
+    // Create producers - Note, threadId are purposely set to an integer value instead of std::this_thread::id
+    // to make it easier to identify which thread is producing. They hold off until the placement is reported
+    std::promise<void> start;
+    std::shared_future<void> started = start.get_future().share();
     for (int i = 0; i < NUM_THREADS; ++i)
     {
-        consumerThreads[i] = std::thread(Consumer{i, queue});
+        producerThreads[i] = placement.spawn(NUM_THREADS + i, "Producer " + std::to_string(i),
+                                             [started, producer = Producer{i, queue}]() mutable
+                                             {
+                                                 started.wait();
+                                                 producer();
+                                             });
     }
 
+    std::cout << placement.report();
+    std::cout << "Queue buffers on node " << (node ? std::to_string(*node) : std::string("of first touch"))
+              << (arena->isBound() ? "" : " (mbind unavailable, first touch)") << std::endl;
+    start.set_value();
+
     // Wait for signal before joining thread
     std::cout << "***** ENTER ANY CHARACTER TO END *****" << std::endl;
     getchar();
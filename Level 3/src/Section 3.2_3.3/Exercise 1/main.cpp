@@ -72,5 +72,15 @@ int main()
     assert(false == atomic_is_lock_free(&x2));
     assert(false == atomic_is_lock_free(&x3));
 
+    // Part G - The free functions above are deprecated in C++20 in favour of std::atomic<std::shared_ptr>,
+    // which performs the same operations. Every load still increments and decrements the reference count
+    // shared by all readers; the RcuCell of Exercise 2 publishes versions without it.
+    std::atomic<PointerType> shared{x};
+    PointerType previous = shared.exchange(PointerType{new X});
+    assert(7 == previous->val);
+    assert(0 == shared.load()->val);
+    shared.store(x2);
+    assert(7 == shared.load()->val);
+
     return 0;
 }
\ No newline at end of file
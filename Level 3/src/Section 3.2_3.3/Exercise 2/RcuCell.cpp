@@ -0,0 +1,83 @@
+//
+// Snapshots, publication and copy-update of an RcuCell
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_RCUCELL_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_RCUCELL_CPP
+
+#include <stdexcept>
+#include <utility>
+
+#include "RcuCell.hpp"
+
+/**
+ * Overloaded ctor: publishes the first version
+ * @param initial The first version
+ * @throws std::invalid_argument if initial is empty
+ */
+template<typename T, typename Reclamation>
+RcuCell<T, Reclamation>::RcuCell(std::unique_ptr<T> initial) : current{initial.get()}
+{
+    if (!initial) throw std::invalid_argument("An RcuCell needs a first version to publish");
+    initial.release();
+}
+
+/**
+ * Retires the current version, which snapshots taken before may still be reading
+ */
+template<typename T, typename Reclamation>
+RcuCell<T, Reclamation>::~RcuCell()
+{
+    Reclamation::retire(current.load(std::memory_order_relaxed));
+}
+
+/**
+ * Wait-free with EpochReclamation, lock-free with HazardPointerReclamation
+ * @return A snapshot of the current version
+ */
+template<typename T, typename Reclamation>
+typename RcuCell<T, Reclamation>::Snapshot RcuCell<T, Reclamation>::read() const
+{
+    return Snapshot(current);
+}
+
+/**
+ * Replaces the current version; snapshots of it stay valid, new ones see the next version
+ * @param next The next version
+ * @throws std::invalid_argument if next is empty
+ */
+template<typename T, typename Reclamation>
+void RcuCell<T, Reclamation>::publish(std::unique_ptr<T> next)
+{
+    if (!next) throw std::invalid_argument("An RcuCell cannot publish an empty version");
+    Reclamation::retire(current.exchange(next.release()));
+}
+
+/**
+ * Publishes an updated copy of the current version. If another writer publishes first, the update is applied
+ * again to a copy of that version, so modify may run more than once and must only change its argument.
+ * @param modify Called with a copy of the current version to update
+ */
+template<typename T, typename Reclamation>
+template<typename Modify>
+void RcuCell<T, Reclamation>::update(Modify&& modify)
+{
+    while (true)
+    {
+        // The snapshot keeps the expected version from being deleted and reused before the exchange
+        Snapshot snapshot = read();
+        auto next = std::make_unique<T>(*snapshot);
+        modify(*next);
+        T* expected = const_cast<T*>(snapshot.get());
+        if (current.compare_exchange_strong(expected, next.get()))
+        {
+            next.release();
+            Reclamation::retire(expected);
+            return;
+        }
+    }
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_RCUCELL_CPP
@@ -0,0 +1,76 @@
+//
+// Read-copy-update publication of a shared object, for configuration and reference data that is read far
+// more often than it changes. Readers take a Snapshot of the current version, which stays valid for as long
+// as they hold it however many versions are published meanwhile. Writers never change a published version:
+// they publish a new one, built from scratch or as an updated copy of the current one, and the version they
+// replace is retired and deleted once no snapshot can still refer to it.
+//
+// A std::shared_ptr gives the same guarantee, but every reader increments and decrements the same reference
+// count, so reads from many cores contend on one cache line. With EpochReclamation a snapshot only writes the
+// reader's own record, and with HazardPointerReclamation it writes one of the reader's hazard pointers.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_RCUCELL_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_RCUCELL_HPP
+
+#include <atomic>
+#include <memory>
+
+#include "Reclamation.hpp"
+
+template<typename T, typename Reclamation = EpochReclamation>
+class RcuCell
+{
+private:
+    std::atomic<T*> current;
+
+public:
+    // A version of the object, kept alive while the snapshot exists; it belongs to the thread that took it
+    class Snapshot
+    {
+    private:
+        typename Reclamation::Guard guard;
+        T* object;
+
+    public:
+        explicit Snapshot(const std::atomic<T*>& source) : guard{}, object{guard.protect(source)} {}
+        Snapshot(const Snapshot& source) = delete;
+        Snapshot(Snapshot&& source) = delete;
+        ~Snapshot() = default;
+
+        // Operator overloads
+        Snapshot& operator=(const Snapshot& source) = delete;
+        Snapshot& operator=(Snapshot&& source) = delete;
+        const T& operator*() const noexcept { return *object; }
+        const T* operator->() const noexcept { return object; }
+
+        // Accessors
+        const T* get() const noexcept { return object; }
+    };
+
+    RcuCell() = delete;
+    explicit RcuCell(std::unique_ptr<T> initial);
+    RcuCell(const RcuCell& source) = delete;
+    RcuCell(RcuCell&& source) = delete;
+    ~RcuCell();
+
+    // Operator overloads
+    RcuCell& operator=(const RcuCell& source) = delete;
+    RcuCell& operator=(RcuCell&& source) = delete;
+
+    // Core functionality
+    Snapshot read() const;
+    void publish(std::unique_ptr<T> next);
+
+    template<typename Modify>
+    void update(Modify&& modify);
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_RCUCELL_CPP
+#include "RcuCell.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_RCUCELL_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_RCUCELL_HPP
@@ -0,0 +1,272 @@
+//
+// Reader records, epochs and hazard pointer scans of the reclamation schemes
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "Reclamation.hpp"
+
+namespace
+{
+    // Retiring beyond this many objects triggers a reclamation pass, and then so does doubling what is left
+    constexpr std::size_t RECLAIM_BATCH = 64;
+
+    std::atomic<ReaderRecord*> records{nullptr};
+
+    // The retired objects of one scheme; those left at exit are deleted then, when no thread reads any more
+    struct RetireList
+    {
+        std::mutex mutex;
+        std::vector<Retired> objects;
+        std::size_t nextPass = RECLAIM_BATCH;
+        std::uint64_t sequence = 0;
+
+        ~RetireList()
+        {
+            for (const Retired& retired : objects) retired.destroy(retired.object);
+        }
+
+        // Takes the objects the predicate allows out of the list, with the mutex held
+        template<typename Safe>
+        std::vector<Retired> release(Safe safe)
+        {
+            const auto kept = std::stable_partition(objects.begin(), objects.end(), [&](const Retired& retired) { return !safe(retired); });
+            std::vector<Retired> ready(kept, objects.end());
+            objects.erase(kept, objects.end());
+            nextPass = std::max(RECLAIM_BATCH, 2 * objects.size());
+            return ready;
+        }
+    };
+
+    RetireList& epochRetired()
+    {
+        static RetireList list;
+        return list;
+    }
+
+    RetireList& hazardRetired()
+    {
+        static RetireList list;
+        return list;
+    }
+
+    std::size_t destroy(const std::vector<Retired>& ready)
+    {
+        for (const Retired& retired : ready) retired.destroy(retired.object);
+        return ready.size();
+    }
+
+    // Claims a free record, or creates one, for the calling thread until it exits
+    struct RecordClaim
+    {
+        ReaderRecord* record;
+
+        RecordClaim() : record{nullptr}
+        {
+            for (ReaderRecord* candidate = records.load(std::memory_order_acquire); candidate != nullptr; candidate = candidate->next)
+            {
+                bool expected = false;
+                if (!candidate->claimed.load(std::memory_order_relaxed) &&
+                    candidate->claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    record = candidate;
+                    return;
+                }
+            }
+
+            record = new ReaderRecord;
+            record->claimed.store(true, std::memory_order_relaxed);
+            record->next = records.load(std::memory_order_relaxed);
+            while (!records.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        ~RecordClaim()
+        {
+            record->epoch.store(0, std::memory_order_relaxed);
+            for (auto& hazard : record->hazards) hazard.store(nullptr, std::memory_order_relaxed);
+            record->depth = 0;
+            record->hazardsInUse = 0;
+            record->claimed.store(false, std::memory_order_release);
+        }
+    };
+}
+
+ReaderRecord& ReaderRecord::local()
+{
+    thread_local RecordClaim claim;
+    return *claim.record;
+}
+
+ReaderRecord* ReaderRecord::first() noexcept
+{
+    return records.load(std::memory_order_acquire);
+}
+
+// ********** EpochReclamation **********
+
+std::atomic<std::uint64_t>& EpochReclamation::epoch() noexcept
+{
+    static std::atomic<std::uint64_t> current{1};
+    return current;
+}
+
+EpochReclamation::Guard::Guard() : record{ReaderRecord::local()}
+{
+    if (record.depth++ == 0)
+    {
+        // A stale epoch is harmless: it only holds back the next advance until this read ends
+        record.epoch.store(epoch().load(std::memory_order_relaxed), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+EpochReclamation::Guard::~Guard()
+{
+    if (--record.depth == 0) record.epoch.store(0, std::memory_order_release);
+}
+
+/**
+ * Advances the epoch if every reading thread has pinned the current one
+ * @return Whether the epoch is past the one it was at on entry
+ */
+bool EpochReclamation::tryAdvance() noexcept
+{
+    std::uint64_t current = epoch().load();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (ReaderRecord* record = ReaderRecord::first(); record != nullptr; record = record->next)
+    {
+        const std::uint64_t pinned = record->epoch.load(std::memory_order_acquire);
+        if (pinned != 0 && pinned != current) return false;
+    }
+    epoch().compare_exchange_strong(current, current + 1);
+    return true;
+}
+
+void EpochReclamation::retire(void* object, void (*destroy)(void*))
+{
+    RetireList& list = epochRetired();
+    {
+        std::lock_guard<std::mutex> lock(list.mutex);
+        list.objects.push_back(Retired{object, destroy, epoch().load()});
+        if (list.objects.size() < list.nextPass) return;
+    }
+    reclaim();
+}
+
+std::size_t EpochReclamation::reclaim()
+{
+    RetireList& list = epochRetired();
+    std::vector<Retired> ready;
+    {
+        std::lock_guard<std::mutex> lock(list.mutex);
+        tryAdvance();
+        const std::uint64_t current = epoch().load();
+        ready = list.release([current](const Retired& retired) { return retired.tag + 2 <= current; });
+    }
+    return destroy(ready);
+}
+
+void EpochReclamation::synchronize()
+{
+    if (ReaderRecord::local().depth > 0) throw std::logic_error("A thread cannot wait for the readers while it reads");
+
+    // Two advances make every object retired so far safe: readers that could still see it have all finished
+    const std::uint64_t target = epoch().load() + 2;
+    while (epoch().load() < target)
+    {
+        if (!tryAdvance()) std::this_thread::yield();
+    }
+    reclaim();
+}
+
+std::size_t EpochReclamation::pending()
+{
+    RetireList& list = epochRetired();
+    std::lock_guard<std::mutex> lock(list.mutex);
+    return list.objects.size();
+}
+
+// ********** HazardPointerReclamation **********
+
+HazardPointerReclamation::Guard::Guard() : record{ReaderRecord::local()}, index{0}
+{
+    if (record.hazardsInUse == ReaderRecord::HAZARDS)
+        throw std::length_error("A thread can hold at most " + std::to_string(ReaderRecord::HAZARDS) + " hazard pointers");
+    index = record.hazardsInUse++;
+}
+
+HazardPointerReclamation::Guard::~Guard()
+{
+    record.hazards[index].store(nullptr, std::memory_order_release);
+    --record.hazardsInUse;
+}
+
+void HazardPointerReclamation::retire(void* object, void (*destroy)(void*))
+{
+    RetireList& list = hazardRetired();
+    {
+        std::lock_guard<std::mutex> lock(list.mutex);
+        list.objects.push_back(Retired{object, destroy, ++list.sequence});
+        if (list.objects.size() < list.nextPass) return;
+    }
+    reclaim();
+}
+
+std::size_t HazardPointerReclamation::reclaim()
+{
+    RetireList& list = hazardRetired();
+    std::vector<Retired> ready;
+    {
+        std::lock_guard<std::mutex> lock(list.mutex);
+        if (list.objects.empty()) return 0;
+
+        std::vector<const void*> protectedObjects;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (ReaderRecord* record = ReaderRecord::first(); record != nullptr; record = record->next)
+        {
+            for (const auto& hazard : record->hazards)
+            {
+                if (const void* object = hazard.load(std::memory_order_acquire)) protectedObjects.push_back(object);
+            }
+        }
+        std::sort(protectedObjects.begin(), protectedObjects.end());
+        ready = list.release([&protectedObjects](const Retired& retired)
+        {
+            return !std::binary_search(protectedObjects.begin(), protectedObjects.end(), retired.object);
+        });
+    }
+    return destroy(ready);
+}
+
+void HazardPointerReclamation::synchronize()
+{
+    if (ReaderRecord::local().hazardsInUse > 0) throw std::logic_error("A thread cannot wait for the readers while it reads");
+
+    RetireList& list = hazardRetired();
+    std::uint64_t last;
+    {
+        std::lock_guard<std::mutex> lock(list.mutex);
+        last = list.sequence;
+    }
+    while (true)
+    {
+        reclaim();
+        {
+            std::lock_guard<std::mutex> lock(list.mutex);
+            if (std::none_of(list.objects.begin(), list.objects.end(), [last](const Retired& retired) { return retired.tag <= last; })) return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+std::size_t HazardPointerReclamation::pending()
+{
+    RetireList& list = hazardRetired();
+    std::lock_guard<std::mutex> lock(list.mutex);
+    return list.objects.size();
+}
@@ -0,0 +1,186 @@
+//
+// Deferred reclamation of objects that readers may still be using after a writer has unlinked them: the
+// writer retires the object instead of deleting it, and it is deleted once no reader can reach it.
+//
+// EpochReclamation: a reader pins the current global epoch in its own thread's record for the length of a
+// read, with one store and a fence and nothing shared written, so reads are wait-free. Retired objects are
+// tagged with the epoch they were retired in; the epoch advances once every pinned reader has seen it, and
+// an object is deleted two epochs after its retirement. A reader that stalls holds back reclamation of
+// everything retired meanwhile.
+//
+// HazardPointerReclamation: a reader publishes the pointer it is about to use in one of its record's hazard
+// pointers and checks it is still current, which is lock-free rather than wait-free. A retired object is
+// deleted once no hazard pointer holds it, so a stalled reader only holds back the objects it protects.
+//
+// Each thread gets a record on its first read, and gives it back when it exits for another thread to reuse.
+// Records are never freed, so the epoch and hazard pointer scans walk them without locks.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_RECLAMATION_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_RECLAMATION_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// A reader thread's record, on a cache line of its own so that readers never share one
+struct alignas(64) ReaderRecord
+{
+    static constexpr std::size_t HAZARDS = 4;
+
+    std::atomic<bool> claimed{false};
+    std::atomic<std::uint64_t> epoch{0};                         // The pinned epoch, 0 when not reading
+    std::array<std::atomic<const void*>, HAZARDS> hazards{};
+    ReaderRecord* next{nullptr};                                  // Set once, before the record is published
+    std::size_t depth{0};                                         // Nested epoch guards, owner thread only
+    std::size_t hazardsInUse{0};                                  // Owner thread only
+
+    /**
+     * @return The calling thread's record, claimed on its first call
+     */
+    static ReaderRecord& local();
+
+    /**
+     * @return The first record; every record ever created follows it
+     */
+    static ReaderRecord* first() noexcept;
+};
+
+// An object waiting to be deleted, with the epoch or sequence number it was retired at
+struct Retired
+{
+    void* object;
+    void (*destroy)(void*);
+    std::uint64_t tag;
+};
+
+class EpochReclamation
+{
+private:
+    static std::atomic<std::uint64_t>& epoch() noexcept;
+    static void retire(void* object, void (*destroy)(void*));
+    static bool tryAdvance() noexcept;
+
+public:
+    // Pins the calling thread to the current epoch; guards nest
+    class Guard
+    {
+    private:
+        ReaderRecord& record;
+
+    public:
+        Guard();
+        Guard(const Guard& source) = delete;
+        Guard(Guard&& source) = delete;
+        ~Guard();
+
+        // Operator overloads
+        Guard& operator=(const Guard& source) = delete;
+        Guard& operator=(Guard&& source) = delete;
+
+        // Core functionality
+        template<typename T>
+        T* protect(const std::atomic<T*>& source) const noexcept { return source.load(std::memory_order_acquire); }
+    };
+
+    /**
+     * Deletes the object once no reader can still be using it
+     * @param object An object no longer reachable by new readers, or nullptr
+     */
+    template<typename T>
+    static void retire(T* object)
+    {
+        if (object != nullptr) retire(object, [](void* erased) { delete static_cast<T*>(erased); });
+    }
+
+    /**
+     * Advances the epoch if every reader has seen it, and deletes the objects that are then safe, without waiting
+     * @return The number of objects deleted
+     */
+    static std::size_t reclaim();
+
+    /**
+     * Waits for every reader active at the call to finish, and deletes all objects retired before it
+     * @throws std::logic_error if the calling thread is itself reading, which would wait forever
+     */
+    static void synchronize();
+
+    /**
+     * @return The number of retired objects not yet deleted
+     */
+    static std::size_t pending();
+};
+
+class HazardPointerReclamation
+{
+private:
+    static void retire(void* object, void (*destroy)(void*));
+
+public:
+    // Holds one of the calling thread's hazard pointers; at most ReaderRecord::HAZARDS at a time
+    class Guard
+    {
+    private:
+        ReaderRecord& record;
+        std::size_t index;
+
+    public:
+        Guard();
+        Guard(const Guard& source) = delete;
+        Guard(Guard&& source) = delete;
+        ~Guard();
+
+        // Operator overloads
+        Guard& operator=(const Guard& source) = delete;
+        Guard& operator=(Guard&& source) = delete;
+
+        // Core functionality
+        template<typename T>
+        T* protect(const std::atomic<T*>& source) noexcept
+        {
+            T* object = source.load(std::memory_order_relaxed);
+            while (true)
+            {
+                record.hazards[index].store(object, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                T* current = source.load(std::memory_order_acquire);
+                if (current == object) return object;
+                object = current;
+            }
+        }
+    };
+
+    /**
+     * Deletes the object once no hazard pointer holds it
+     * @param object An object no longer reachable by new readers, or nullptr
+     */
+    template<typename T>
+    static void retire(T* object)
+    {
+        if (object != nullptr) retire(object, [](void* erased) { delete static_cast<T*>(erased); });
+    }
+
+    /**
+     * Deletes the retired objects that no hazard pointer holds, without waiting
+     * @return The number of objects deleted
+     */
+    static std::size_t reclaim();
+
+    /**
+     * Waits until every object retired before the call has been deleted
+     * @throws std::logic_error if the calling thread itself holds a hazard pointer, which could wait forever
+     */
+    static void synchronize();
+
+    /**
+     * @return The number of retired objects not yet deleted
+     */
+    static std::size_t pending();
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_RECLAMATION_HPP
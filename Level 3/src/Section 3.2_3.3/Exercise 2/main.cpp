@@ -1,13 +1,28 @@
 //
 // Created by Michael Lewis on 7/1/23.
 //
+// Parts D and E publish the same updates race-free through an RcuCell: each thread publishes a new version of
+// X instead of writing into the shared one, and readers take snapshots that stay valid while they hold them.
+// The tests check that no update is lost, that snapshots outlive newer versions, and that every retired
+// version is deleted, under both reclamation schemes. The benchmark reports reads per second as reader
+// threads are added, against std::atomic<std::shared_ptr> and a mutex, while a writer publishes.
+//
 
 #include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
 #include <iostream>
 #include <functional>
+#include <mutex>
 #include <random>
+#include <stdexcept>
 #include <thread>
 #include <memory>
+#include <vector>
+
+#include "RcuCell.hpp"
+#include "StopWatch.hpp"
 
 // Example struct provide by lecture material
 struct X
@@ -44,6 +59,274 @@ void Modify(PointerType& p, double newVal)
     p->operator()();
 }
 
+// Part D - The same modification, published as a new version of X rather than written into the shared one
+void Publish(RcuCell<X>& cell, double newVal)
+{
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> delay(1, 100);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay(gen)));
+    cell.update([newVal](X& x) { x.val = newVal; });
+    cell.read()->operator()();
+}
+
+// A version that counts its live instances and checks it is read while alive
+struct Version
+{
+    static std::atomic<int> live;
+
+    std::uint64_t number;
+    std::uint64_t check;        // Always ~number, unless the version has been deleted
+
+    explicit Version(std::uint64_t number) : number{number}, check{~number} { ++live; }
+    Version(const Version& source) : number{source.number}, check{source.check} { ++live; }
+    ~Version()
+    {
+        check = 0;
+        --live;
+    }
+
+    bool valid() const noexcept { return check == ~number; }
+};
+
+std::atomic<int> Version::live{0};
+
+// A snapshot keeps its version while newer ones are published, and the old versions are deleted afterwards
+template<typename Reclamation>
+void test_Snapshots()
+{
+    {
+        RcuCell<Version, Reclamation> cell(std::make_unique<Version>(1));
+        {
+            auto first = cell.read();
+            cell.publish(std::make_unique<Version>(2));
+            cell.publish(std::make_unique<Version>(3));
+            Reclamation::reclaim();
+            assert(1 == first->number && first->valid());
+            assert(3 == cell.read()->number);
+            assert(Version::live >= 2);
+        }
+        Reclamation::synchronize();
+        assert(1 == Version::live);
+        assert(0 == Reclamation::pending());
+
+        bool thrown = false;
+        try { cell.publish(nullptr); }
+        catch (const std::invalid_argument&) { thrown = true; }
+        assert(thrown);
+    }
+    Reclamation::synchronize();
+    assert(0 == Version::live);
+
+    bool thrown = false;
+    try { RcuCell<Version, Reclamation> empty(nullptr); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// Concurrent copy-updates lose nothing, and readers only ever see whole, live versions
+template<typename Reclamation>
+void test_ConcurrentUpdates()
+{
+    constexpr int WRITERS = 8;
+    constexpr int UPDATES = 2000;
+    constexpr int READERS = 4;
+    {
+        RcuCell<Version, Reclamation> cell(std::make_unique<Version>(0));
+        std::atomic<bool> done{false};
+
+        std::vector<std::thread> readers;
+        for (int r = 0; r < READERS; ++r)
+        {
+            readers.emplace_back([&]
+            {
+                std::uint64_t last = 0;
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    auto snapshot = cell.read();
+                    assert(snapshot->valid());
+                    assert(snapshot->number >= last);
+                    last = snapshot->number;
+                }
+            });
+        }
+
+        std::vector<std::thread> writers;
+        for (int w = 0; w < WRITERS; ++w)
+        {
+            writers.emplace_back([&]
+            {
+                for (int i = 0; i < UPDATES; ++i)
+                {
+                    cell.update([](Version& version)
+                    {
+                        ++version.number;
+                        version.check = ~version.number;
+                    });
+                }
+            });
+        }
+        for (std::thread& writer : writers) writer.join();
+        done = true;
+        for (std::thread& reader : readers) reader.join();
+
+        assert(WRITERS * UPDATES == cell.read()->number);
+    }
+    Reclamation::synchronize();
+    assert(0 == Version::live);
+}
+
+// Epoch guards nest; hazard pointers are limited per thread; a reader cannot wait for readers
+void test_Guards()
+{
+    RcuCell<Version> cell(std::make_unique<Version>(1));
+    {
+        auto outer = cell.read();
+        auto inner = cell.read();
+        assert(outer.get() == inner.get());
+
+        bool thrown = false;
+        try { EpochReclamation::synchronize(); }
+        catch (const std::logic_error&) { thrown = true; }
+        assert(thrown);
+    }
+    EpochReclamation::synchronize();
+
+    RcuCell<Version, HazardPointerReclamation> hazards(std::make_unique<Version>(1));
+    {
+        auto a = hazards.read();
+        auto b = hazards.read();
+        auto c = hazards.read();
+        auto d = hazards.read();
+        bool thrown = false;
+        try { auto e = hazards.read(); }
+        catch (const std::length_error&) { thrown = true; }
+        assert(thrown);
+
+        thrown = false;
+        try { HazardPointerReclamation::synchronize(); }
+        catch (const std::logic_error&) { thrown = true; }
+        assert(thrown);
+    }
+
+    // A stalled reader on another thread holds back only what it protects
+    std::atomic<bool> reading{false}, release{false};
+    std::thread stalled([&]
+    {
+        auto snapshot = hazards.read();
+        reading = true;
+        while (!release) std::this_thread::yield();
+        assert(1 == snapshot->number && snapshot->valid());
+    });
+    while (!reading) std::this_thread::yield();
+    for (std::uint64_t i = 2; i < 100; ++i) hazards.publish(std::make_unique<Version>(i));
+    HazardPointerReclamation::reclaim();
+    assert(1 == HazardPointerReclamation::pending());
+    release = true;
+    stalled.join();
+    HazardPointerReclamation::synchronize();
+    assert(0 == HazardPointerReclamation::pending());
+}
+
+// Millions of reads per second by the given number of reader threads, while one writer publishes a version
+// every 100 µs
+template<typename Read, typename Write>
+double readThroughput(int threads, Read&& read, Write&& write)
+{
+    constexpr int READS = 2'000'000;
+    std::atomic<bool> done{false};
+    double last = 0;
+    std::thread writer([&]
+    {
+        for (double value = 0; !done.load(std::memory_order_relaxed); ++value)
+        {
+            write(value);
+            last = value;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+
+    // Versions are published in increasing order, so no reader may ever see the value go backwards
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<int> regressions{0};
+    StopWatch stopWatch;
+    stopWatch.StartStopWatch();
+    {
+        std::vector<std::thread> readers;
+        for (int t = 0; t < threads; ++t)
+        {
+            readers.emplace_back([&]
+            {
+                double sum = 0, previous = 0;
+                for (int i = 0; i < READS; ++i)
+                {
+                    const double value = read();
+                    if (value < previous) ++regressions;
+                    previous = value;
+                    sum += value;
+                }
+                total += static_cast<std::uint64_t>(sum);
+            });
+        }
+        for (std::thread& reader : readers) reader.join();
+    }
+    stopWatch.StopStopWatch();
+    const double elapsed = stopWatch.GetTime();
+    done = true;
+    writer.join();
+    assert(0 == regressions);
+    assert(total <= static_cast<std::uint64_t>(threads) * READS * static_cast<std::uint64_t>(last));
+    return threads * static_cast<double>(READS) / elapsed / 1e6;
+}
+
+void benchmark_Reads(int threads)
+{
+    RcuCell<X> epoch(std::make_unique<X>());
+    const double rcu = readThroughput(threads, [&] { return epoch.read()->val; }, [&](double value)
+    {
+        auto next = std::make_unique<X>();
+        next->val = value;
+        epoch.publish(std::move(next));
+    });
+
+    RcuCell<X, HazardPointerReclamation> hazard(std::make_unique<X>());
+    const double hp = readThroughput(threads, [&] { return hazard.read()->val; }, [&](double value)
+    {
+        auto next = std::make_unique<X>();
+        next->val = value;
+        hazard.publish(std::move(next));
+    });
+
+    std::atomic<PointerType> atomic{std::make_shared<X>()};
+    const double shared = readThroughput(threads, [&] { return atomic.load()->val; }, [&](double value)
+    {
+        auto next = std::make_shared<X>();
+        next->val = value;
+        atomic.store(std::move(next));
+    });
+
+    std::mutex mutex;
+    PointerType guarded = std::make_shared<X>();
+    const double locked = readThroughput(threads, [&]
+    {
+        PointerType snapshot;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            snapshot = guarded;
+        }
+        return snapshot->val;
+    }, [&](double value)
+    {
+        auto next = std::make_shared<X>();
+        next->val = value;
+        std::lock_guard<std::mutex> lock(mutex);
+        guarded = std::move(next);
+    });
+
+    std::cout << threads << "\t\t" << rcu << "\t\t" << hp << "\t\t" << shared << "\t\t" << locked << std::endl;
+}
+
 int main()
 {
     // Part B - Create an array of 100 threads, that modifies the value of x->val
@@ -68,5 +351,29 @@ int main()
     // i are not printed to the console, which also indicates a race condition where multiple threads were
     // operating on X concurrently.
 
+    // Part E - Publish through an RcuCell instead. Each thread publishes a copy of the current X with its
+    // value, and prints the version it then reads: another thread may have published since, but no version
+    // is ever written while it is read, and each is deleted once the last thread reading it is done.
+    RcuCell<X> cell(std::make_unique<X>());
+    for (std::size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i] = std::thread(Publish, std::ref(cell), static_cast<double>(i));
+    }
+    for (auto& thread : threads)
+    {
+        if (thread.joinable()) thread.join();
+    }
+
+    test_Snapshots<EpochReclamation>();
+    test_Snapshots<HazardPointerReclamation>();
+    test_ConcurrentUpdates<EpochReclamation>();
+    test_ConcurrentUpdates<HazardPointerReclamation>();
+    test_Guards();
+
+    std::cout << "Readers\t\tEpoch RCU\tHazard RCU\tatomic<shared_ptr>\tMutex (M reads/s)" << std::endl;
+    for (int readers : {1, 2, 4, 8}) benchmark_Reads(readers);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
     return 0;
 }
@@ -0,0 +1,68 @@
+//
+// Futex system calls and the adaptive spin
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <climits>
+#include <thread>
+
+#include "Futex.hpp"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t) && std::atomic<std::uint32_t>::is_always_lock_free,
+              "The kernel reads a futex word as a plain 32-bit integer");
+
+/**
+ * Parks the calling thread until woken, unless the word no longer holds the expected value; it may also
+ * return spuriously, so callers check their condition again
+ * @param word The futex word
+ * @param expected The value that means the condition waited for does not hold yet
+ */
+void Futex::wait(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    word.wait(expected, std::memory_order_acquire);
+#endif
+}
+
+/**
+ * @param word The futex word, changed by the caller before waking
+ */
+void Futex::wakeOne(std::atomic<std::uint32_t>& word) noexcept
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    word.notify_one();
+#endif
+}
+
+/**
+ * @param word The futex word, changed by the caller before waking
+ */
+void Futex::wakeAll(std::atomic<std::uint32_t>& word) noexcept
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    word.notify_all();
+#endif
+}
+
+/**
+ * Overloaded ctor
+ * @param ceiling The most pauses to spin before parking; 0, or a machine with one CPU, never spins
+ */
+AdaptiveSpin::AdaptiveSpin(std::uint32_t ceiling)
+    : ceiling{std::thread::hardware_concurrency() > 1 ? ceiling : 0}, limit{this->ceiling}
+{
+
+}
@@ -0,0 +1,92 @@
+//
+// The two building blocks of the signalling primitives. Futex parks a thread in the kernel until a 32-bit
+// word changes, with the futex system call on Linux and std::atomic::wait elsewhere; unlike a condition
+// variable it needs no mutex, and a signal with no waiter costs no system call at all. AdaptiveSpin spins
+// briefly before a thread parks, since a handoff that arrives within a few microseconds is far cheaper to
+// catch spinning than to be woken from the kernel for.
+//
+// The spin adapts: each time spinning catches the signal the limit moves towards twice the spins it took,
+// and each time it fails the limit halves, so a waiter stops burning a core on signals that come too late.
+// On a machine with a single CPU spinning only delays the thread that would signal, so it is turned off.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_FUTEX_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_FUTEX_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+class Futex
+{
+public:
+    static void wait(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept;
+    static void wakeOne(std::atomic<std::uint32_t>& word) noexcept;
+    static void wakeAll(std::atomic<std::uint32_t>& word) noexcept;
+};
+
+class AdaptiveSpin
+{
+private:
+    static constexpr std::uint32_t MINIMUM = 16;    // So a waiter that stopped spinning can start again
+
+    std::uint32_t ceiling;
+    std::atomic<std::uint32_t> limit;      // Shared by the waiters, which only need it roughly right
+
+    static void pause() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+    }
+
+public:
+    explicit AdaptiveSpin(std::uint32_t ceiling = 0);
+    AdaptiveSpin(const AdaptiveSpin& source) = delete;
+    AdaptiveSpin(AdaptiveSpin&& source) = delete;
+    ~AdaptiveSpin() = default;
+
+    // Operator overloads
+    AdaptiveSpin& operator=(const AdaptiveSpin& source) = delete;
+    AdaptiveSpin& operator=(AdaptiveSpin&& source) = delete;
+
+    // Accessors
+    std::uint32_t maximum() const noexcept { return ceiling; }
+    std::uint32_t current() const noexcept { return limit.load(std::memory_order_relaxed); }
+
+    // Core functionality
+    /**
+     * Spins until ready() holds or the current limit is reached
+     * @tparam Ready A predicate, checked between pauses
+     * @param ready Whether the signal has come
+     * @return Whether it came while spinning
+     */
+    template<typename Ready>
+    bool spin(Ready&& ready) noexcept
+    {
+        const std::uint32_t spins = limit.load(std::memory_order_relaxed);
+        for (std::uint32_t i = 0; i < spins; ++i)
+        {
+            if (ready())
+            {
+                // An eighth of the way towards twice what it took
+                const std::int64_t target = std::max<std::int64_t>(MINIMUM, 2 * static_cast<std::int64_t>(i));
+                const std::int64_t moved = spins + (target - static_cast<std::int64_t>(spins)) / 8;
+                limit.store(static_cast<std::uint32_t>(std::min<std::int64_t>(ceiling, moved)), std::memory_order_relaxed);
+                return true;
+            }
+            pause();
+        }
+        if (ready()) return true;
+        if (spins > 0) limit.store(std::max(std::min(ceiling, MINIMUM), spins / 2), std::memory_order_relaxed);
+        return false;
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_FUTEX_HPP
@@ -0,0 +1,173 @@
+//
+// Event, semaphore and sequence barrier on futex words
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "Signals.hpp"
+
+/**
+ * Overloaded ctor
+ * @param initiallySet Whether waiters pass straight through until the first reset()
+ * @param spinCeiling The most pauses a waiter spins before parking
+ */
+FutexEvent::FutexEvent(bool initiallySet, std::uint32_t spinCeiling)
+    : state{initiallySet ? SET : CLEAR}, spinner{spinCeiling}
+{
+
+}
+
+/**
+ * Sets the event, waking every waiter; the system call is made only if one has parked
+ */
+void FutexEvent::set() noexcept
+{
+    if (state.exchange(SET, std::memory_order_acq_rel) == CLEAR_WITH_WAITERS) Futex::wakeAll(state);
+}
+
+/**
+ * Clears the event if it is set; waiters already released are unaffected
+ */
+void FutexEvent::reset() noexcept
+{
+    std::uint32_t expected = SET;
+    state.compare_exchange_strong(expected, CLEAR, std::memory_order_relaxed);
+}
+
+/**
+ * Returns once the event is set; everything done before set() is visible afterwards
+ */
+void FutexEvent::wait() noexcept
+{
+    if (isSet() || spinner.spin([this] { return isSet(); })) return;
+
+    std::uint32_t current = state.load(std::memory_order_acquire);
+    while (current != SET)
+    {
+        // Mark that a waiter is about to park, so that set() knows to wake it
+        if (current == CLEAR && !state.compare_exchange_weak(current, CLEAR_WITH_WAITERS, std::memory_order_acquire))
+            continue;
+        Futex::wait(state, CLEAR_WITH_WAITERS);
+        current = state.load(std::memory_order_acquire);
+    }
+}
+
+/**
+ * Overloaded ctor
+ * @param initial The permits available at first
+ * @param spinCeiling The most pauses a waiter spins before parking
+ */
+FutexSemaphore::FutexSemaphore(std::uint32_t initial, std::uint32_t spinCeiling)
+    : permits{initial}, waiters{0}, spinner{spinCeiling}
+{
+
+}
+
+/**
+ * @return Whether a permit was taken, without waiting for one
+ */
+bool FutexSemaphore::tryAcquire() noexcept
+{
+    std::uint32_t current = permits.load(std::memory_order_relaxed);
+    while (current > 0)
+    {
+        if (permits.compare_exchange_weak(current, current - 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Takes a permit, waiting for one to be released if there is none
+ */
+void FutexSemaphore::acquire() noexcept
+{
+    if (tryAcquire() || spinner.spin([this] { return tryAcquire(); })) return;
+
+    while (true)
+    {
+        // Registering before the kernel checks the count pairs with release() adding before it checks for
+        // waiters: whichever comes second sees the other, so a permit is never released past a parked waiter
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        Futex::wait(permits, 0);
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        if (tryAcquire()) return;
+    }
+}
+
+/**
+ * Releases permits, waking as many waiters if any have parked
+ * @param count The number of permits
+ * @throws std::overflow_error if the count of permits would overflow
+ */
+void FutexSemaphore::release(std::uint32_t count)
+{
+    if (count == 0) return;
+    std::uint32_t current = permits.load(std::memory_order_relaxed);
+    do
+    {
+        if (current > std::numeric_limits<std::uint32_t>::max() - count)
+            throw std::overflow_error("Releasing " + std::to_string(count) + " permits to " + std::to_string(current) + " overflows the semaphore");
+    }
+    while (!permits.compare_exchange_weak(current, current + count, std::memory_order_seq_cst, std::memory_order_relaxed));
+
+    if (waiters.load(std::memory_order_seq_cst) == 0) return;
+    if (count == 1) Futex::wakeOne(permits);
+    else Futex::wakeAll(permits);
+}
+
+/**
+ * Overloaded ctor
+ * @param spinCeiling The most pauses a waiter spins before parking
+ */
+SequenceBarrier::SequenceBarrier(std::uint32_t spinCeiling) : cursor{0}, generation{0}, waiters{0}, spinner{spinCeiling}
+{
+
+}
+
+/**
+ * Publishes a sequence; only one thread may publish
+ * @param sequence The sequence reached, greater than the last one published
+ * @throws std::invalid_argument if it is not
+ */
+void SequenceBarrier::publish(std::uint64_t sequence)
+{
+    const std::uint64_t last = cursor.load(std::memory_order_relaxed);
+    if (sequence <= last)
+        throw std::invalid_argument("Sequence " + std::to_string(sequence) + " does not follow " + std::to_string(last));
+
+    cursor.store(sequence, std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_seq_cst) == 0) return;
+    generation.fetch_add(1, std::memory_order_release);
+    Futex::wakeAll(generation);
+}
+
+/**
+ * Waits until a sequence has been published; everything the producer did before publishing it is visible
+ * @param sequence The sequence needed
+ * @return The latest sequence published, at least the one needed
+ */
+std::uint64_t SequenceBarrier::waitFor(std::uint64_t sequence) noexcept
+{
+    std::uint64_t available = cursor.load(std::memory_order_acquire);
+    if (available >= sequence) return available;
+    if (spinner.spin([&] { return (available = cursor.load(std::memory_order_acquire)) >= sequence; })) return available;
+
+    while (true)
+    {
+        // The generation is read before the cursor, so a publish after the check changes it and the wait
+        // returns at once
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        const std::uint32_t seen = generation.load(std::memory_order_acquire);
+        available = cursor.load(std::memory_order_seq_cst);
+        if (available < sequence) Futex::wait(generation, seen);
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+
+        available = cursor.load(std::memory_order_acquire);
+        if (available >= sequence) return available;
+    }
+}
@@ -0,0 +1,103 @@
+//
+// Signalling primitives built on Futex: an event, a counting semaphore and a sequence barrier. Each keeps
+// its state in one 32-bit word that waiters park on, so setting or releasing with nobody waiting is a single
+// atomic instruction, where a condition variable always takes its mutex.
+//
+// FutexEvent is a manual-reset event: set() releases every waiter and later ones pass straight through until
+// reset(). FutexSemaphore hands out permits, one per acquire(). SequenceBarrier fans one producer out to many
+// consumers: the producer publishes an increasing sequence number, each consumer waits for the one it needs
+// and gets back the latest published, so it may take a whole batch in one wake-up.
+//
+// Each takes a spin ceiling for its AdaptiveSpin; with the default of 0 a waiter parks at once.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SIGNALS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SIGNALS_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include "Futex.hpp"
+
+class FutexEvent
+{
+private:
+    enum State : std::uint32_t { CLEAR = 0, SET = 1, CLEAR_WITH_WAITERS = 2 };
+
+    alignas(64) std::atomic<std::uint32_t> state;
+    AdaptiveSpin spinner;
+
+public:
+    explicit FutexEvent(bool initiallySet = false, std::uint32_t spinCeiling = 0);
+    FutexEvent(const FutexEvent& source) = delete;
+    FutexEvent(FutexEvent&& source) = delete;
+    ~FutexEvent() = default;
+
+    // Operator overloads
+    FutexEvent& operator=(const FutexEvent& source) = delete;
+    FutexEvent& operator=(FutexEvent&& source) = delete;
+
+    // Accessors
+    bool isSet() const noexcept { return state.load(std::memory_order_acquire) == SET; }
+
+    // Core functionality
+    void set() noexcept;
+    void reset() noexcept;
+    void wait() noexcept;
+};
+
+class FutexSemaphore
+{
+private:
+    alignas(64) std::atomic<std::uint32_t> permits;
+    std::atomic<std::uint32_t> waiters;
+    AdaptiveSpin spinner;
+
+public:
+    explicit FutexSemaphore(std::uint32_t initial = 0, std::uint32_t spinCeiling = 0);
+    FutexSemaphore(const FutexSemaphore& source) = delete;
+    FutexSemaphore(FutexSemaphore&& source) = delete;
+    ~FutexSemaphore() = default;
+
+    // Operator overloads
+    FutexSemaphore& operator=(const FutexSemaphore& source) = delete;
+    FutexSemaphore& operator=(FutexSemaphore&& source) = delete;
+
+    // Accessors
+    std::uint32_t available() const noexcept { return permits.load(std::memory_order_relaxed); }
+
+    // Core functionality
+    bool tryAcquire() noexcept;
+    void acquire() noexcept;
+    void release(std::uint32_t count = 1);
+};
+
+class SequenceBarrier
+{
+private:
+    alignas(64) std::atomic<std::uint64_t> cursor;      // The latest published sequence, 0 before the first
+    std::atomic<std::uint32_t> generation;              // The futex word, bumped by a publish that has waiters
+    std::atomic<std::uint32_t> waiters;
+    AdaptiveSpin spinner;
+
+public:
+    explicit SequenceBarrier(std::uint32_t spinCeiling = 0);
+    SequenceBarrier(const SequenceBarrier& source) = delete;
+    SequenceBarrier(SequenceBarrier&& source) = delete;
+    ~SequenceBarrier() = default;
+
+    // Operator overloads
+    SequenceBarrier& operator=(const SequenceBarrier& source) = delete;
+    SequenceBarrier& operator=(SequenceBarrier&& source) = delete;
+
+    // Accessors
+    std::uint64_t published() const noexcept { return cursor.load(std::memory_order_acquire); }
+
+    // Core functionality
+    void publish(std::uint64_t sequence);
+    std::uint64_t waitFor(std::uint64_t sequence) noexcept;
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SIGNALS_HPP
@@ -2,11 +2,24 @@
 // Created by Michael Lewis on 7/1/23.
 //
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 #include <condition_variable>
 
+#include "Futex.hpp"
+#include "Signals.hpp"
+#include "StopWatch.hpp"
+
 // Part A - Set up data needed to implement a simple Master Worker pattern
 // Types and data needed
 std::string data;// Shared data between master and worker
@@ -112,6 +125,273 @@ void MasterThread_AtomicFlag()
     if (workerThread.joinable()) workerThread.join();
 }
 
+// Part E - Futex-based signalling primitives
+void test_FutexEvent()
+{
+    FutexEvent event;
+    assert(!event.isSet());
+    event.set();
+    assert(event.isSet());
+    event.wait();                       // Passes straight through while set
+    event.reset();
+    assert(!event.isSet());
+    event.reset();                      // Resetting a clear event changes nothing
+    assert(!event.isSet());
+
+    // One set() releases every waiter, and what was written before it is visible to each
+    std::string payload;
+    std::atomic<int> released{0};
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 4; ++i)
+    {
+        waiters.emplace_back([&]
+        {
+            event.wait();
+            assert(payload == "ready");
+            ++released;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(released.load() == 0);
+    payload = "ready";
+    event.set();
+    for (std::thread& waiter : waiters) waiter.join();
+    assert(released.load() == 4);
+
+    FutexEvent initially{true};
+    assert(initially.isSet());
+}
+
+void test_FutexSemaphore()
+{
+    FutexSemaphore semaphore{2};
+    assert(semaphore.available() == 2);
+    assert(semaphore.tryAcquire());
+    semaphore.acquire();
+    assert(!semaphore.tryAcquire());
+    semaphore.release(3);
+    assert(semaphore.available() == 3);
+    semaphore.release(0);
+    assert(semaphore.available() == 3);
+
+    bool threw = false;
+    try { semaphore.release(0xFFFFFFFFu); }
+    catch (const std::overflow_error&) { threw = true; }
+    assert(threw && semaphore.available() == 3);
+
+    // Producers release one permit per item and consumers take exactly as many, whether or not they park
+    for (std::uint32_t spin : {0u, 2000u})
+    {
+        FutexSemaphore items{0, spin};
+        constexpr int PER_PRODUCER = 20'000;
+        std::atomic<int> consumed{0};
+        std::vector<std::thread> threads;
+        for (int c = 0; c < 3; ++c)
+        {
+            const int share = 2 * PER_PRODUCER / 3 + (c < 2 * PER_PRODUCER % 3 ? 1 : 0);
+            threads.emplace_back([&, share]
+            {
+                for (int i = 0; i < share; ++i)
+                {
+                    items.acquire();
+                    ++consumed;
+                }
+            });
+        }
+        for (int p = 0; p < 2; ++p)
+        {
+            threads.emplace_back([&]
+            {
+                for (int i = 0; i < PER_PRODUCER; ++i) items.release();
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        assert(consumed.load() == 2 * PER_PRODUCER);
+        assert(items.available() == 0);
+    }
+}
+
+void test_SequenceBarrier()
+{
+    SequenceBarrier barrier;
+    assert(barrier.published() == 0);
+    assert(barrier.waitFor(0) == 0);
+
+    bool threw = false;
+    barrier.publish(5);
+    try { barrier.publish(5); }
+    catch (const std::invalid_argument&) { threw = true; }
+    assert(threw && barrier.published() == 5);
+    assert(barrier.waitFor(3) == 5);
+
+    // One producer fills a ring and publishes; every consumer reads every slot in order, often several per
+    // wake-up, and the ring is large enough that the producer never overwrites a slot still to be read
+    for (std::uint32_t spin : {0u, 2000u})
+    {
+        constexpr std::uint64_t ITEMS = 50'000;
+        SequenceBarrier published{spin};
+        std::vector<std::uint64_t> ring(ITEMS + 1);
+        std::vector<std::uint64_t> sums(3, 0);
+        std::vector<std::thread> consumers;
+        for (std::size_t c = 0; c < sums.size(); ++c)
+        {
+            consumers.emplace_back([&, c]
+            {
+                std::uint64_t next = 1;
+                while (next <= ITEMS)
+                {
+                    const std::uint64_t available = published.waitFor(next);
+                    assert(available >= next);
+                    for (; next <= available; ++next)
+                    {
+                        assert(ring[next] == next * 3);
+                        sums[c] += ring[next];
+                    }
+                }
+            });
+        }
+        for (std::uint64_t sequence = 1; sequence <= ITEMS; ++sequence)
+        {
+            ring[sequence] = sequence * 3;
+            published.publish(sequence);
+        }
+        for (std::thread& consumer : consumers) consumer.join();
+        for (std::uint64_t sum : sums) assert(sum == 3 * ITEMS * (ITEMS + 1) / 2);
+    }
+}
+
+void test_AdaptiveSpin()
+{
+    AdaptiveSpin never{0};
+    assert(never.maximum() == 0 && never.current() == 0);
+    assert(never.spin([] { return true; }));
+    assert(!never.spin([] { return false; }));
+
+    AdaptiveSpin spinner{1000};
+    if (std::thread::hardware_concurrency() <= 1)
+    {
+        assert(spinner.maximum() == 0);
+        return;
+    }
+
+    // Failures halve the limit, successes pull it back towards twice what they took
+    assert(spinner.current() == 1000);
+    assert(!spinner.spin([] { return false; }));
+    assert(spinner.current() == 500);
+    for (int i = 0; i < 10; ++i) spinner.spin([] { return false; });
+    assert(spinner.current() == 16);
+    int calls = 0;
+    for (int i = 0; i < 100; ++i) assert(spinner.spin([&calls] { return ++calls % 10 == 0; }));
+    assert(spinner.current() >= 16 && spinner.current() <= 1000);
+}
+
+// Part F - Ping-pong latency: a master signals a worker, which signals straight back, and each round trip is
+// timed; two handoffs, each of which may park and wake a thread
+struct Latency
+{
+    double p50;
+    double p99;
+    double p999;
+};
+
+template<typename Ping, typename Pong, typename AwaitPing, typename AwaitPong>
+Latency pingPong(int rounds, Ping&& ping, Pong&& pong, AwaitPing&& awaitPing, AwaitPong&& awaitPong)
+{
+    // The worker sums the rounds it answers, so a lost or duplicated handoff fails the check below
+    std::int64_t answered = 0;
+    std::thread worker([&]
+    {
+        for (int i = 0; i < rounds; ++i)
+        {
+            awaitPing(i);
+            answered += i;
+            pong(i);
+        }
+    });
+
+    StopWatch stopWatch;
+    std::vector<double> times(static_cast<std::size_t>(rounds));
+    for (int i = 0; i < rounds; ++i)
+    {
+        stopWatch.StartStopWatch();
+        ping(i);
+        awaitPong(i);
+        stopWatch.StopStopWatch();
+        times[static_cast<std::size_t>(i)] = 1e6 * stopWatch.GetTime();
+    }
+    worker.join();
+    assert(answered == static_cast<std::int64_t>(rounds) * (rounds - 1) / 2);
+
+    std::sort(times.begin(), times.end());
+    auto at = [&times](double q) { return times[static_cast<std::size_t>(q * static_cast<double>(times.size() - 1))]; };
+    return Latency{at(0.5), at(0.99), at(0.999)};
+}
+
+void report(const std::string& name, const Latency& latency)
+{
+    std::cout << "  " << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << latency.p50 << std::setw(10) << latency.p99 << std::setw(10) << latency.p999 << "\n";
+}
+
+void benchmark_PingPong()
+{
+    constexpr int ROUNDS = 20'000;
+    constexpr std::uint32_t SPIN = 4000;
+    std::cout << "Ping-pong round trips over " << ROUNDS << " rounds on " << std::thread::hardware_concurrency()
+              << " CPU(s), in microseconds:\n";
+    std::cout << "  " << std::left << std::setw(30) << "primitive" << std::right << std::setw(10) << "p50"
+              << std::setw(10) << "p99" << std::setw(10) << "p99.9" << "\n";
+
+    {
+        // Parts A - C: a flag under the mutex, announced through the condition variable
+        std::mutex lock;
+        std::condition_variable changed;
+        int turn = -1;
+        report("mutex + condition_variable", pingPong(ROUNDS,
+            [&](int i) { { std::lock_guard<std::mutex> guard{lock}; turn = 2 * i; } changed.notify_all(); },
+            [&](int i) { { std::lock_guard<std::mutex> guard{lock}; turn = 2 * i + 1; } changed.notify_all(); },
+            [&](int i) { std::unique_lock<std::mutex> guard{lock}; changed.wait(guard, [&] { return turn == 2 * i; }); },
+            [&](int i) { std::unique_lock<std::mutex> guard{lock}; changed.wait(guard, [&] { return turn == 2 * i + 1; }); }));
+    }
+    {
+        // Part D without the mutex: C++20 lets a thread wait on the atomic_flag itself
+        std::atomic_flag toWorker, toMaster;
+        auto await = [](std::atomic_flag& flag) { flag.wait(false, std::memory_order_acquire); flag.clear(std::memory_order_relaxed); };
+        auto signal = [](std::atomic_flag& flag) { flag.test_and_set(std::memory_order_release); flag.notify_one(); };
+        report("atomic_flag wait/notify", pingPong(ROUNDS,
+            [&](int) { signal(toWorker); }, [&](int) { signal(toMaster); },
+            [&](int) { await(toWorker); }, [&](int) { await(toMaster); }));
+    }
+    for (std::uint32_t spin : {0u, SPIN})
+    {
+        const std::string suffix = spin == 0 ? "" : " + adaptive spin";
+        {
+            FutexEvent toWorker{false, spin}, toMaster{false, spin};
+            report("FutexEvent" + suffix, pingPong(ROUNDS,
+                [&](int) { toWorker.set(); }, [&](int) { toMaster.set(); },
+                [&](int) { toWorker.wait(); toWorker.reset(); }, [&](int) { toMaster.wait(); toMaster.reset(); }));
+        }
+        {
+            FutexSemaphore toWorker{0, spin}, toMaster{0, spin};
+            report("FutexSemaphore" + suffix, pingPong(ROUNDS,
+                [&](int) { toWorker.release(); }, [&](int) { toMaster.release(); },
+                [&](int) { toWorker.acquire(); }, [&](int) { toMaster.acquire(); }));
+        }
+        {
+            SequenceBarrier toWorker{spin}, toMaster{spin};
+            auto next = [](int i) { return static_cast<std::uint64_t>(i) + 1; };
+            std::uint64_t workerSeen = 0, masterSeen = 0;
+            report("SequenceBarrier" + suffix, pingPong(ROUNDS,
+                [&](int i) { toWorker.publish(next(i)); }, [&](int i) { toMaster.publish(next(i)); },
+                [&](int i) { workerSeen += toWorker.waitFor(next(i)); }, [&](int i) { masterSeen += toMaster.waitFor(next(i)); }));
+
+            // Strict ping-pong never publishes ahead, so each wait sees exactly the sequence it asked for
+            const std::uint64_t expected = static_cast<std::uint64_t>(ROUNDS) * (ROUNDS + 1) / 2;
+            assert(workerSeen == expected && masterSeen == expected);
+        }
+    }
+}
+
 int main()
 {
     // Test Parts A - C
@@ -122,5 +402,16 @@ int main()
     MasterThread_AtomicFlag();
     std::cout << data << std::endl;
 
+    // Test Part E
+    test_FutexEvent();
+    test_FutexSemaphore();
+    test_SequenceBarrier();
+    test_AdaptiveSpin();
+
+    // Part F
+    benchmark_PingPong();
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,185 @@
+//
+// Events and replications of the barber shop simulation
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "BarberShop.hpp"
+
+/**
+ * Overloaded ctor
+ * @param config The shop, its distributions and how long to simulate it
+ * @throws std::invalid_argument if there is no barber, or the warm-up or duration are out of range
+ */
+BarberShop::BarberShop(ShopConfig config)
+    : config{std::move(config)}, calendar{}, engine{}, room(16), head{0}, waiting{0}, busy{0}, lastChange{0.0}, statistics{}
+{
+    if (this->config.barbers == 0) throw std::invalid_argument("A barber shop needs at least one barber");
+    if (!(this->config.warmup >= 0) || !std::isfinite(this->config.warmup))
+        throw std::invalid_argument("The warm-up must be non-negative and finite, not " + std::to_string(this->config.warmup));
+    if (!(this->config.duration > 0) || !std::isfinite(this->config.duration))
+        throw std::invalid_argument("The duration must be positive and finite, not " + std::to_string(this->config.duration));
+    calendar.reserve(this->config.barbers + 2);
+}
+
+/**
+ * Adds the barbers' busy time and the customers' waiting time since the last change of either
+ */
+void BarberShop::account() noexcept
+{
+    const double elapsed = calendar.now() - lastChange;
+    statistics.busyTime += static_cast<double>(busy) * elapsed;
+    statistics.queueTime += static_cast<double>(waiting) * elapsed;
+    lastChange = calendar.now();
+}
+
+/**
+ * A customer arrives: to a free barber, else to a free chair, else away again
+ */
+void BarberShop::arrive()
+{
+    account();
+    ++statistics.arrivals;
+    calendar.schedule(config.arrivals(engine), Event::Arrival);
+
+    if (busy < config.barbers)
+    {
+        ++busy;
+        startHaircut(calendar.now());
+    }
+    else if (waiting < config.chairs)
+    {
+        if (waiting == room.size())
+        {
+            // Unroll the ring into one twice its size
+            std::vector<double> larger(2 * room.size());
+            for (std::size_t i = 0; i < waiting; ++i) larger[i] = room[(head + i) & (room.size() - 1)];
+            room = std::move(larger);
+            head = 0;
+        }
+        room[(head + waiting) & (room.size() - 1)] = calendar.now();
+        ++waiting;
+        statistics.longestQueue = std::max(statistics.longestQueue, waiting);
+    }
+    else
+    {
+        ++statistics.dropped;
+    }
+}
+
+/**
+ * A haircut ends: the barber takes the customer who has waited longest, or goes to sleep
+ */
+void BarberShop::depart()
+{
+    account();
+    if (waiting > 0)
+    {
+        const double arrival = room[head];
+        head = (head + 1) & (room.size() - 1);
+        --waiting;
+        startHaircut(arrival);
+    }
+    else
+    {
+        --busy;
+    }
+}
+
+/**
+ * @param arrival The arrival time of the customer whose haircut starts now
+ */
+void BarberShop::startHaircut(double arrival)
+{
+    const double wait = calendar.now() - arrival;
+    ++statistics.served;
+    statistics.totalWait += wait;
+    statistics.waits.add(wait);
+    calendar.schedule(config.service(engine), Event::Departure);
+}
+
+/**
+ * Simulates the shop from empty through the warm-up and the measured duration
+ * @return The statistics of the measured duration
+ */
+ShopStatistics BarberShop::run()
+{
+    calendar.clear();
+    engine.seed(config.seed);
+    head = 0;
+    waiting = 0;
+    busy = 0;
+    lastChange = 0.0;
+    statistics = ShopStatistics{};
+    statistics.barbers = config.barbers;
+
+    calendar.schedule(config.arrivals(engine), Event::Arrival);
+    if (config.warmup > 0) calendar.scheduleAt(config.warmup, Event::EndOfWarmup);
+    calendar.run(config.warmup + config.duration, [this](Event event)
+    {
+        switch (event)
+        {
+            case Event::Arrival:
+                arrive();
+                break;
+            case Event::Departure:
+                depart();
+                break;
+            case Event::EndOfWarmup:
+                // Start measuring from the state the warm-up left
+                statistics = ShopStatistics{};
+                statistics.barbers = config.barbers;
+                statistics.longestQueue = waiting;
+                lastChange = calendar.now();
+                break;
+        }
+    });
+    account();
+    statistics.duration = config.duration;
+    return statistics;
+}
+
+/**
+ * Runs independent replications of the shop in parallel
+ * @param config The shop; replication i uses a seed derived from config.seed and i
+ * @param replications The number of replications
+ * @param threads The number of threads to run them on, at least one
+ * @return The statistics of each replication, in order
+ * @throws std::invalid_argument if the configuration is invalid
+ */
+std::vector<ShopStatistics> BarberShop::replicate(const ShopConfig& config, std::size_t replications, unsigned threads)
+{
+    const BarberShop prototype{config};
+    std::vector<ShopStatistics> results(replications);
+    std::atomic<std::size_t> next{0};
+
+    auto work = [&]
+    {
+        BarberShop shop = prototype;
+        for (std::size_t i = next++; i < replications; i = next++)
+        {
+            // SplitMix64 of the seed and the index, so neighbouring replications draw unrelated streams
+            std::uint64_t seed = config.seed + 0x9E3779B97F4A7C15ULL * (i + 1);
+            seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+            shop.config.seed = seed ^ (seed >> 31);
+            results[i] = shop.run();
+        }
+    };
+
+    const std::size_t workers = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(replications, 1));
+    std::vector<std::thread> pool;
+    for (std::size_t t = 1; t < workers; ++t) pool.emplace_back(work);
+    work();
+    for (std::thread& thread : pool) thread.join();
+    return results;
+}
@@ -0,0 +1,80 @@
+//
+// A discrete-event simulation of the sleeping-barber shop: customers arrive at times drawn from one
+// distribution, take a free barber or else a free chair in the waiting room, or leave if every chair is
+// taken; a haircut takes a time drawn from another. The customers and barbers are not threads but state
+// in the model: the waiting room is a ring of arrival times and the barbers a count of those busy, and
+// only arrivals and the end of haircuts are events, so a customer costs two events and a few nanoseconds
+// of wall-clock time rather than a thread and 10 seconds of it.
+//
+// run() simulates the shop for a warm-up period, whose statistics are discarded, and then for the measured
+// duration. replicate() runs independent replications on as many threads as asked; replication i draws
+// from its own seed derived from the configured one and i, so the results do not depend on the threads.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_BARBERSHOP_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_BARBERSHOP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Distribution.hpp"
+#include "EventCalendar.hpp"
+#include "ShopStatistics.hpp"
+
+struct ShopConfig
+{
+    std::size_t barbers = 1;
+    std::size_t chairs = 10;                                            // Waiting room places
+    Distribution arrivals = Distribution::exponential(1.0);             // Times between customers
+    Distribution service = Distribution::exponential(0.8);              // Haircut times
+    double warmup = 0.0;
+    double duration = 100'000.0;
+    std::uint64_t seed = 1;
+};
+
+class BarberShop
+{
+private:
+    enum class Event : std::uint8_t { Arrival, Departure, EndOfWarmup };
+
+    ShopConfig config;
+    EventCalendar<Event> calendar;
+    std::mt19937_64 engine;
+    std::vector<double> room;           // Arrival times of the waiting customers, a ring of power of two size
+    std::size_t head;
+    std::size_t waiting;
+    std::size_t busy;
+    double lastChange;
+    ShopStatistics statistics;
+
+    void account() noexcept;
+    void arrive();
+    void depart();
+    void startHaircut(double arrival);
+
+public:
+    BarberShop() = delete;
+    explicit BarberShop(ShopConfig config);
+    BarberShop(const BarberShop& source) = default;
+    BarberShop(BarberShop&& source) noexcept = default;
+    ~BarberShop() = default;
+
+    // Operator overloads
+    BarberShop& operator=(const BarberShop& source) = default;
+    BarberShop& operator=(BarberShop&& source) noexcept = default;
+
+    // Accessors
+    const ShopConfig& configuration() const noexcept { return config; }
+
+    // Core functionality
+    ShopStatistics run();
+    static std::vector<ShopStatistics> replicate(const ShopConfig& config, std::size_t replications,
+                                                 unsigned threads = std::thread::hardware_concurrency());
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_BARBERSHOP_HPP
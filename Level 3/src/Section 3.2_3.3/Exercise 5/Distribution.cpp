@@ -0,0 +1,142 @@
+//
+// Construction and moments of the simulation's time distributions
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "Distribution.hpp"
+
+namespace
+{
+    // Erlang samples multiply one uniform per stage, which must not underflow
+    constexpr unsigned MAX_STAGES = 64;
+
+    void requirePositive(double value, const char* what)
+    {
+        if (!(value > 0) || !std::isfinite(value))
+            throw std::invalid_argument(std::string(what) + " must be positive and finite, not " + std::to_string(value));
+    }
+}
+
+Distribution::Distribution(Kind kind, double average, double first, double second)
+    : kind{kind}, average{average}, first{first}, second{second}
+{
+
+}
+
+/**
+ * @param mean The mean time
+ * @return Times without memory, as between customers arriving at random
+ * @throws std::invalid_argument if the mean is not positive
+ */
+Distribution Distribution::exponential(double mean)
+{
+    requirePositive(mean, "The mean of an exponential distribution");
+    return Distribution{Kind::Exponential, mean, 0.0, 0.0};
+}
+
+/**
+ * @param value The time
+ * @return Always the same time
+ * @throws std::invalid_argument if the time is negative
+ */
+Distribution Distribution::deterministic(double value)
+{
+    if (!(value >= 0) || !std::isfinite(value))
+        throw std::invalid_argument("A deterministic time must be non-negative and finite, not " + std::to_string(value));
+    return Distribution{Kind::Deterministic, value, 0.0, 0.0};
+}
+
+/**
+ * @param low The shortest time
+ * @param high The longest time
+ * @return Times spread evenly between them
+ * @throws std::invalid_argument unless 0 <= low <= high
+ */
+Distribution Distribution::uniform(double low, double high)
+{
+    if (!(low >= 0 && low <= high) || !std::isfinite(high))
+        throw std::invalid_argument("A uniform distribution needs 0 <= low <= high, not " + std::to_string(low) + " and " + std::to_string(high));
+    return Distribution{Kind::Uniform, (low + high) / 2, low, high - low};
+}
+
+/**
+ * @param stages The number of exponential stages, from 1 to 64
+ * @param mean The mean of the whole time
+ * @return Times of that many stages in a row, less variable than exponential times as stages are added
+ * @throws std::invalid_argument if the stages or the mean are out of range
+ */
+Distribution Distribution::erlang(unsigned stages, double mean)
+{
+    if (stages < 1 || stages > MAX_STAGES)
+        throw std::invalid_argument("An Erlang distribution needs 1 to 64 stages, not " + std::to_string(stages));
+    requirePositive(mean, "The mean of an Erlang distribution");
+    return Distribution{Kind::Erlang, mean, mean / stages, static_cast<double>(stages)};
+}
+
+/**
+ * @param mean The mean time
+ * @param coefficientOfVariation The standard deviation over the mean
+ * @return Times whose logarithm is normal, with a long right tail as the coefficient grows
+ * @throws std::invalid_argument if the mean or the coefficient is not positive
+ */
+Distribution Distribution::lognormal(double mean, double coefficientOfVariation)
+{
+    requirePositive(mean, "The mean of a lognormal distribution");
+    requirePositive(coefficientOfVariation, "The coefficient of variation of a lognormal distribution");
+    const double sigma2 = std::log1p(coefficientOfVariation * coefficientOfVariation);
+    return Distribution{Kind::LogNormal, mean, std::log(mean) - sigma2 / 2, std::sqrt(sigma2)};
+}
+
+/**
+ * @return The variance of the times, which sets the queueing delay with the mean
+ */
+double Distribution::variance() const noexcept
+{
+    switch (kind)
+    {
+        case Kind::Exponential:
+            return average * average;
+        case Kind::Deterministic:
+            return 0.0;
+        case Kind::Uniform:
+            return second * second / 12;
+        case Kind::Erlang:
+            return average * average / second;
+        case Kind::LogNormal:
+            return average * average * std::expm1(second * second);
+    }
+    return 0.0;
+}
+
+/**
+ * @return The kind and parameters, such as "Exp(20)"
+ */
+std::string Distribution::describe() const
+{
+    std::ostringstream description;
+    switch (kind)
+    {
+        case Kind::Exponential:
+            description << "Exp(" << average << ")";
+            break;
+        case Kind::Deterministic:
+            description << "D(" << average << ")";
+            break;
+        case Kind::Uniform:
+            description << "U(" << first << ", " << first + second << ")";
+            break;
+        case Kind::Erlang:
+            description << "Erlang-" << static_cast<unsigned>(second) << "(" << average << ")";
+            break;
+        case Kind::LogNormal:
+            description << "LogN(" << average << ", cv " << std::sqrt(std::expm1(second * second)) << ")";
+            break;
+    }
+    return description.str();
+}
@@ -0,0 +1,90 @@
+//
+// A distribution of inter-arrival or service times for the simulation, chosen at run time: exponential for
+// arrivals at random, deterministic for a fixed pace, uniform, Erlang for a service of several exponential
+// stages, and lognormal for the long right tail of real service times. Each is set by its mean, so that a
+// study can keep the load fixed while it varies the shape.
+//
+// Samples are drawn by inversion or by the Box-Muller transform from the 53 top bits of a 64-bit engine,
+// with a switch on the kind rather than a virtual call, as each customer draws two of them.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_DISTRIBUTION_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_DISTRIBUTION_HPP
+
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <string>
+
+class Distribution
+{
+public:
+    enum class Kind { Exponential, Deterministic, Uniform, Erlang, LogNormal };
+
+private:
+    Kind kind;
+    double average;
+    double first;       // Uniform: the lower bound; Erlang: the mean of a stage; LogNormal: mu
+    double second;      // Uniform: the width; Erlang: the number of stages; LogNormal: sigma
+
+    Distribution(Kind kind, double average, double first, double second);
+
+    // A uniform sample in (0, 1]
+    static double unit(std::mt19937_64& engine) noexcept
+    {
+        return static_cast<double>((engine() >> 11) + 1) * 0x1.0p-53;
+    }
+
+public:
+    Distribution() = delete;
+    Distribution(const Distribution& source) = default;
+    Distribution(Distribution&& source) noexcept = default;
+    ~Distribution() = default;
+
+    static Distribution exponential(double mean);
+    static Distribution deterministic(double value);
+    static Distribution uniform(double low, double high);
+    static Distribution erlang(unsigned stages, double mean);
+    static Distribution lognormal(double mean, double coefficientOfVariation);
+
+    // Operator overloads
+    Distribution& operator=(const Distribution& source) = default;
+    Distribution& operator=(Distribution&& source) noexcept = default;
+
+    // Accessors
+    Kind type() const noexcept { return kind; }
+    double mean() const noexcept { return average; }
+    double variance() const noexcept;
+    std::string describe() const;
+
+    // Core functionality
+    double operator()(std::mt19937_64& engine) const noexcept
+    {
+        switch (kind)
+        {
+            case Kind::Exponential:
+                return -average * std::log(unit(engine));
+            case Kind::Deterministic:
+                return average;
+            case Kind::Uniform:
+                return first + second * (1.0 - unit(engine));
+            case Kind::Erlang:
+            {
+                // The sum of the stages' exponentials is minus the log of the product of their uniforms
+                double product = 1.0;
+                for (unsigned stage = 0; stage < static_cast<unsigned>(second); ++stage) product *= unit(engine);
+                return -first * std::log(product);
+            }
+            case Kind::LogNormal:
+            {
+                const double normal = std::sqrt(-2.0 * std::log(unit(engine))) * std::cos(2.0 * std::numbers::pi * unit(engine));
+                return std::exp(first + second * normal);
+            }
+        }
+        return average;
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_DISTRIBUTION_HPP
@@ -0,0 +1,153 @@
+//
+// Scheduling and time-ordered handling of the events of a discrete-event simulation
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_EVENTCALENDAR_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_EVENTCALENDAR_CPP
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "EventCalendar.hpp"
+
+/**
+ * Default ctor: an empty calendar with the clock at 0
+ * @tparam Event The events the model handles
+ */
+template<typename Event>
+EventCalendar<Event>::EventCalendar() : heap{}, clock{0.0}, scheduled{0}
+{
+
+}
+
+template<typename Event>
+void EventCalendar<Event>::siftUp(std::size_t position) noexcept
+{
+    Entry entry = std::move(heap[position]);
+    while (position > 0)
+    {
+        const std::size_t parent = (position - 1) / 4;
+        if (!entry.before(heap[parent])) break;
+        heap[position] = std::move(heap[parent]);
+        position = parent;
+    }
+    heap[position] = std::move(entry);
+}
+
+template<typename Event>
+void EventCalendar<Event>::siftDown(std::size_t position) noexcept
+{
+    Entry entry = std::move(heap[position]);
+    const std::size_t size = heap.size();
+    while (true)
+    {
+        const std::size_t first = 4 * position + 1;
+        if (first >= size) break;
+        std::size_t earliest = first;
+        const std::size_t last = first + 4 < size ? first + 4 : size;
+        for (std::size_t child = first + 1; child < last; ++child)
+        {
+            if (heap[child].before(heap[earliest])) earliest = child;
+        }
+        if (!heap[earliest].before(entry)) break;
+        heap[position] = std::move(heap[earliest]);
+        position = earliest;
+    }
+    heap[position] = std::move(entry);
+}
+
+template<typename Event>
+typename EventCalendar<Event>::Entry EventCalendar<Event>::pop() noexcept
+{
+    Entry earliest = std::move(heap.front());
+    if (heap.size() > 1)
+    {
+        heap.front() = std::move(heap.back());
+        heap.pop_back();
+        siftDown(0);
+    }
+    else
+    {
+        heap.pop_back();
+    }
+    return earliest;
+}
+
+/**
+ * @tparam Event The events the model handles
+ * @param delay The simulated time from now until the event; at 0 it follows the events already due now
+ * @param event The event
+ * @throws std::invalid_argument if the delay is negative or not a number
+ */
+template<typename Event>
+void EventCalendar<Event>::schedule(double delay, const Event& event)
+{
+    if (!(delay >= 0)) throw std::invalid_argument("An event cannot be scheduled " + std::to_string(delay) + " from now");
+    scheduleAt(clock + delay, event);
+}
+
+/**
+ * @tparam Event The events the model handles
+ * @param time The simulated time of the event
+ * @param event The event
+ * @throws std::invalid_argument if the time is before now or not a number
+ */
+template<typename Event>
+void EventCalendar<Event>::scheduleAt(double time, const Event& event)
+{
+    if (!(time >= clock))
+        throw std::invalid_argument("An event cannot be scheduled at " + std::to_string(time) + ", before the current time " + std::to_string(clock));
+    heap.push_back(Entry{time, scheduled++, event});
+    siftUp(heap.size() - 1);
+}
+
+/**
+ * Handles the events due up to the given time in time order, then moves the clock to that time if it is finite
+ * @tparam Event The events the model handles
+ * @tparam Handler Called as handler(event) with the clock at the event's time; it may schedule more events
+ * @param until The simulated time to run to; events due later stay in the calendar
+ * @return The number of events handled
+ */
+template<typename Event>
+template<typename Handler>
+std::uint64_t EventCalendar<Event>::run(double until, Handler&& handler)
+{
+    std::uint64_t handled = 0;
+    while (!heap.empty() && heap.front().time <= until)
+    {
+        Entry entry = pop();
+        clock = entry.time;
+        handler(entry.event);
+        ++handled;
+    }
+    if (until > clock && std::isfinite(until)) clock = until;
+    return handled;
+}
+
+/**
+ * @tparam Event The events the model handles
+ * @param events The number of pending events to make room for
+ */
+template<typename Event>
+void EventCalendar<Event>::reserve(std::size_t events)
+{
+    heap.reserve(events);
+}
+
+/**
+ * Drops the pending events and sets the clock back to 0, keeping the storage
+ * @tparam Event The events the model handles
+ */
+template<typename Event>
+void EventCalendar<Event>::clear() noexcept
+{
+    heap.clear();
+    clock = 0.0;
+    scheduled = 0;
+}
+
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_EVENTCALENDAR_CPP
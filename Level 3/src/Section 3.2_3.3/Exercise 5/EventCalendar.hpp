@@ -0,0 +1,77 @@
+//
+// The kernel of a discrete-event simulation: a virtual clock and the calendar of events scheduled on it.
+// run() takes the events in time order, jumps the clock to each one and hands it to the model, which may
+// schedule more. No time passes between events, so a simulation runs as fast as its events can be handled,
+// however long the simulated day, and gives the same results every time for the same random numbers.
+//
+// Events due at the same time are handled in the order they were scheduled. The calendar is a 4-ary min-heap
+// of entries in one vector, whose storage is kept and reused as events come and go, so scheduling allocates
+// nothing once the calendar has reached its largest size.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_EVENTCALENDAR_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_EVENTCALENDAR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+template<typename Event>
+class EventCalendar
+{
+private:
+    struct Entry
+    {
+        double time;
+        std::uint64_t sequence;
+        Event event;
+
+        bool before(const Entry& other) const noexcept
+        {
+            return time < other.time || (time == other.time && sequence < other.sequence);
+        }
+    };
+
+    std::vector<Entry> heap;
+    double clock;
+    std::uint64_t scheduled;
+
+    void siftUp(std::size_t position) noexcept;
+    void siftDown(std::size_t position) noexcept;
+    Entry pop() noexcept;
+
+public:
+    EventCalendar();
+    EventCalendar(const EventCalendar<Event>& source) = default;
+    EventCalendar(EventCalendar<Event>&& source) noexcept = default;
+    ~EventCalendar() = default;
+
+    // Operator overloads
+    EventCalendar& operator=(const EventCalendar<Event>& source) = default;
+    EventCalendar& operator=(EventCalendar<Event>&& source) noexcept = default;
+
+    // Accessors
+    double now() const noexcept { return clock; }
+    std::size_t size() const noexcept { return heap.size(); }
+    bool empty() const noexcept { return heap.empty(); }
+    std::uint64_t scheduledCount() const noexcept { return scheduled; }
+
+    // Core functionality
+    void schedule(double delay, const Event& event);
+    void scheduleAt(double time, const Event& event);
+
+    template<typename Handler>
+    std::uint64_t run(double until, Handler&& handler);
+
+    void reserve(std::size_t events);
+    void clear() noexcept;
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_EVENTCALENDAR_CPP
+#include "EventCalendar.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_EVENTCALENDAR_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_EVENTCALENDAR_HPP
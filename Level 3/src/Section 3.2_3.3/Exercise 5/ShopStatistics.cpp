@@ -0,0 +1,166 @@
+//
+// Wait histogram, derived measures and confidence intervals of the barber shop simulation
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "ShopStatistics.hpp"
+
+WaitHistogram::WaitHistogram() : zeros{0}, count{0}, buckets((MAX_EXPONENT - MIN_EXPONENT + 1) * SUB_BUCKETS, 0)
+{
+
+}
+
+/**
+ * @param wait A customer's wait; 0 if the customer was served at once
+ */
+void WaitHistogram::add(double wait) noexcept
+{
+    ++count;
+    if (!(wait > 0))
+    {
+        ++zeros;
+        return;
+    }
+
+    // wait = mantissa * 2^exponent with the mantissa in [0.5, 1), split into SUB_BUCKETS linear buckets
+    int exponent;
+    const double mantissa = std::frexp(wait, &exponent);
+    if (exponent < MIN_EXPONENT) ++buckets.front();
+    else if (exponent > MAX_EXPONENT) ++buckets.back();
+    else ++buckets[(exponent - MIN_EXPONENT) * SUB_BUCKETS + static_cast<int>((mantissa - 0.5) * 2 * SUB_BUCKETS)];
+}
+
+/**
+ * @param q The quantile wanted, in [0, 1]
+ * @return The wait that a share q of the customers did not exceed, to within 1%; 0 if there are none
+ * @throws std::invalid_argument if q is out of range
+ */
+double WaitHistogram::quantile(double q) const
+{
+    if (!(q >= 0 && q <= 1)) throw std::invalid_argument("A quantile must be in [0, 1], not " + std::to_string(q));
+    if (count == 0) return 0.0;
+
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count))));
+    std::uint64_t seen = zeros;
+    if (seen >= rank) return 0.0;
+    for (std::size_t index = 0; index < buckets.size(); ++index)
+    {
+        seen += buckets[index];
+        if (seen >= rank)
+        {
+            // The middle of the bucket
+            const int exponent = static_cast<int>(index / SUB_BUCKETS) + MIN_EXPONENT;
+            const auto sub = static_cast<double>(index % SUB_BUCKETS);
+            return std::ldexp(0.5 + (sub + 0.5) / (2 * SUB_BUCKETS), exponent);
+        }
+    }
+    return std::ldexp(1.0, MAX_EXPONENT);
+}
+
+/**
+ * @param other The waits of another run
+ */
+void WaitHistogram::merge(const WaitHistogram& other) noexcept
+{
+    zeros += other.zeros;
+    count += other.count;
+    for (std::size_t index = 0; index < buckets.size(); ++index) buckets[index] += other.buckets[index];
+}
+
+/**
+ * @return The share of the barbers' time spent cutting hair
+ */
+double ShopStatistics::utilization() const noexcept
+{
+    return duration > 0 ? busyTime / (static_cast<double>(barbers) * duration) : 0.0;
+}
+
+/**
+ * @return The share of arriving customers turned away
+ */
+double ShopStatistics::dropRate() const noexcept
+{
+    return arrivals > 0 ? static_cast<double>(dropped) / static_cast<double>(arrivals) : 0.0;
+}
+
+/**
+ * @return Haircuts started per unit of simulated time
+ */
+double ShopStatistics::throughput() const noexcept
+{
+    return duration > 0 ? static_cast<double>(served) / duration : 0.0;
+}
+
+/**
+ * @return The mean wait of the customers served
+ */
+double ShopStatistics::meanWait() const noexcept
+{
+    return served > 0 ? totalWait / static_cast<double>(served) : 0.0;
+}
+
+/**
+ * @return The time-average number of customers waiting
+ */
+double ShopStatistics::meanQueue() const noexcept
+{
+    return duration > 0 ? queueTime / duration : 0.0;
+}
+
+/**
+ * Adds the statistics of another run of the same shop, as if it had followed this one
+ * @param other The statistics of a shop with as many barbers
+ * @throws std::invalid_argument if the numbers of barbers differ
+ */
+void ShopStatistics::merge(const ShopStatistics& other)
+{
+    if (other.barbers != barbers) throw std::invalid_argument("Only statistics of shops with as many barbers can be merged");
+    duration += other.duration;
+    arrivals += other.arrivals;
+    served += other.served;
+    dropped += other.dropped;
+    busyTime += other.busyTime;
+    queueTime += other.queueTime;
+    totalWait += other.totalWait;
+    longestQueue = std::max(longestQueue, other.longestQueue);
+    waits.merge(other.waits);
+}
+
+/**
+ * @param replications The statistics of independent runs
+ * @param measure The measure to estimate, such as &ShopStatistics::meanWait
+ * @return Its mean over the runs, with the half-width of a Student t 95% confidence interval; 0 for one run
+ * @throws std::invalid_argument if there are no runs
+ */
+Estimate estimate(std::span<const ShopStatistics> replications, double (ShopStatistics::*measure)() const)
+{
+    if (replications.empty()) throw std::invalid_argument("An estimate needs at least one replication");
+
+    // The 97.5% quantiles of Student's t for 1 to 30 degrees of freedom, then the normal one
+    static constexpr std::array<double, 30> T_QUANTILES = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+        2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+        2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+    const auto n = static_cast<double>(replications.size());
+    double mean = 0.0;
+    for (const ShopStatistics& replication : replications) mean += (replication.*measure)();
+    mean /= n;
+    if (replications.size() == 1) return Estimate{mean, 0.0};
+
+    double squares = 0.0;
+    for (const ShopStatistics& replication : replications)
+    {
+        const double deviation = (replication.*measure)() - mean;
+        squares += deviation * deviation;
+    }
+    const std::size_t degrees = replications.size() - 1;
+    const double t = degrees <= T_QUANTILES.size() ? T_QUANTILES[degrees - 1] : 1.960;
+    return Estimate{mean, t * std::sqrt(squares / (n - 1) / n)};
+}
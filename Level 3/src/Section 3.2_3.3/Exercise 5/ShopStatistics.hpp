@@ -0,0 +1,87 @@
+//
+// The queueing statistics of a simulated barber shop: how busy the barbers were, how long customers waited
+// and how many were turned away because every chair was taken. Waits are kept in a log-linear histogram of
+// 64 buckets per power of two, so any quantile of the wait distribution is within 1% however many millions
+// of customers were simulated, in 36 KB.
+//
+// Statistics of independent replications merge into those of the whole experiment, and estimate() gives
+// the mean of a measure over replications with its 95% confidence interval, which is what a queue-sizing
+// study compares across shop configurations.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SHOPSTATISTICS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SHOPSTATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class WaitHistogram
+{
+private:
+    static constexpr int SUB_BUCKETS = 64;
+    static constexpr int MIN_EXPONENT = -30;        // Waits below 2^-31 share the first bucket
+    static constexpr int MAX_EXPONENT = 40;         // Waits above 2^40 share the last bucket
+
+    std::uint64_t zeros;
+    std::uint64_t count;
+    std::vector<std::uint64_t> buckets;
+
+public:
+    WaitHistogram();
+    WaitHistogram(const WaitHistogram& source) = default;
+    WaitHistogram(WaitHistogram&& source) noexcept = default;
+    ~WaitHistogram() = default;
+
+    // Operator overloads
+    WaitHistogram& operator=(const WaitHistogram& source) = default;
+    WaitHistogram& operator=(WaitHistogram&& source) noexcept = default;
+
+    // Accessors
+    std::uint64_t size() const noexcept { return count; }
+    std::uint64_t zeroCount() const noexcept { return zeros; }
+    double quantile(double q) const;
+
+    // Core functionality
+    void add(double wait) noexcept;
+    void merge(const WaitHistogram& other) noexcept;
+};
+
+struct ShopStatistics
+{
+    std::size_t barbers = 1;
+    double duration = 0.0;              // Simulated time measured, after the warm-up
+    std::uint64_t arrivals = 0;
+    std::uint64_t served = 0;           // Customers whose haircut started
+    std::uint64_t dropped = 0;          // Customers who found every barber busy and every chair taken
+    double busyTime = 0.0;              // Barber time spent cutting hair
+    double queueTime = 0.0;             // Time integral of the number of customers waiting
+    double totalWait = 0.0;
+    std::size_t longestQueue = 0;
+    WaitHistogram waits;
+
+    // Accessors
+    double utilization() const noexcept;
+    double dropRate() const noexcept;
+    double throughput() const noexcept;
+    double meanWait() const noexcept;
+    double meanQueue() const noexcept;
+    double waitQuantile(double q) const { return waits.quantile(q); }
+
+    // Core functionality
+    void merge(const ShopStatistics& other);
+};
+
+// A mean over replications, and the half-width of its 95% confidence interval
+struct Estimate
+{
+    double mean;
+    double halfWidth;
+};
+
+Estimate estimate(std::span<const ShopStatistics> replications, double (ShopStatistics::*measure)() const);
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SHOPSTATISTICS_HPP
@@ -2,18 +2,312 @@
 // A simple test program to illustrate the Barbershop Problem where there are N customers
 // that potentially enter the Barbershop with only one Barber to provide haircuts.
 //
+// The BarberShop simulation answers the same problem's capacity questions in simulated time. The tests
+// check the event calendar and the distributions, and the simulated queues against the closed forms of
+// queueing theory: M/M/1/K blocking and waits, M/M/c waits by Erlang C, M/D/1 waits by Pollaczek-Khinchine.
+// The benchmarks report simulated customers per second for one run and for parallel replications, and a
+// waiting-room sizing study. The threaded shop of the original exercise runs last.
+//
 // Created by Michael Lewis on 7/1/23.
 //
 
 #include <array>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 #include "Barber.hpp"
+#include "BarberShop.hpp"
 #include "ConcurrentQueue.hpp"
 #include "Customer.hpp"
+#include "StopWatch.hpp"
 
-int main()
+bool near(double actual, double expected, double tolerance)
+{
+    return std::abs(actual - expected) <= tolerance * std::abs(expected);
+}
+
+// Events are handled in time order, ties in the order scheduled, and handlers can schedule more
+void test_Calendar()
+{
+    EventCalendar<int> calendar;
+    calendar.schedule(3.0, 1);
+    calendar.schedule(1.0, 2);
+    calendar.schedule(3.0, 3);
+    calendar.schedule(2.0, 4);
+
+    std::vector<std::pair<double, int>> handled;
+    assert(2 == calendar.run(2.5, [&](int event) { handled.emplace_back(calendar.now(), event); }));
+    assert(2.5 == calendar.now() && 2 == calendar.size());
+    assert(calendar.run(std::numeric_limits<double>::infinity(), [&](int event)
+    {
+        handled.emplace_back(calendar.now(), event);
+        if (event == 3) calendar.schedule(0.0, 5);
+    }) == 3);
+    const std::vector<std::pair<double, int>> expected = {{1.0, 2}, {2.0, 4}, {3.0, 1}, {3.0, 3}, {3.0, 5}};
+    assert(expected == handled);
+    assert(3.0 == calendar.now() && calendar.empty());
+
+    bool thrown = false;
+    try { calendar.schedule(-1.0, 0); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { calendar.scheduleAt(2.0, 0); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    calendar.clear();
+    assert(0.0 == calendar.now() && 0 == calendar.scheduledCount());
+}
+
+// Each distribution has the mean and variance it claims
+void test_Distributions()
+{
+    const std::vector<Distribution> distributions = {Distribution::exponential(2.0), Distribution::deterministic(1.5),
+        Distribution::uniform(1.0, 3.0), Distribution::erlang(4, 2.0), Distribution::lognormal(2.0, 1.5)};
+    std::mt19937_64 engine{1};
+    for (const Distribution& distribution : distributions)
+    {
+        constexpr int SAMPLES = 400'000;
+        double sum = 0, squares = 0;
+        for (int i = 0; i < SAMPLES; ++i)
+        {
+            const double sample = distribution(engine);
+            assert(sample >= 0 && std::isfinite(sample));
+            sum += sample;
+            squares += sample * sample;
+        }
+        const double mean = sum / SAMPLES;
+        const double variance = squares / SAMPLES - mean * mean;
+        assert(near(mean, distribution.mean(), 0.01));
+        assert(std::abs(variance - distribution.variance()) <= 0.05 * distribution.variance() + 1e-9);
+    }
+    assert("Erlang-4(2)" == Distribution::erlang(4, 2.0).describe());
+
+    bool thrown = false;
+    try { Distribution::exponential(0.0); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { Distribution::uniform(3.0, 1.0); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// Quantiles are within 1% of the exact ones, and histograms merge
+void test_Histogram()
+{
+    WaitHistogram histogram, other;
+    for (int i = 1; i <= 10'000; ++i) (i % 2 ? histogram : other).add(i * 0.01);
+    for (int i = 0; i < 5'000; ++i) other.add(0.0);
+    histogram.merge(other);
+
+    assert(15'000 == histogram.size() && 5'000 == histogram.zeroCount());
+    assert(0.0 == histogram.quantile(0.3));
+    assert(near(histogram.quantile(0.5), 25.0, 0.01));
+    assert(near(histogram.quantile(0.99), 98.5, 0.01));
+    assert(near(histogram.quantile(1.0), 100.0, 0.01));
+
+    bool thrown = false;
+    try { histogram.quantile(1.5); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// One barber and ten chairs, M/M/1/11: blocking, utilization, queue and wait against the closed forms
+void test_MM1K()
+{
+    ShopConfig config;
+    config.chairs = 10;
+    config.arrivals = Distribution::exponential(1.0);
+    config.service = Distribution::exponential(0.8);
+    config.warmup = 1'000;
+    config.duration = 1'000'000;
+    const ShopStatistics statistics = BarberShop{config}.run();
+
+    // P(n customers in the shop) is proportional to rho^n for n up to K = chairs + 1
+    const double rho = 0.8;
+    const int capacity = 11;
+    double normalizer = 0, inQueue = 0;
+    for (int n = 0; n <= capacity; ++n) normalizer += std::pow(rho, n);
+    for (int n = 2; n <= capacity; ++n) inQueue += (n - 1) * std::pow(rho, n) / normalizer;
+    const double blocking = std::pow(rho, capacity) / normalizer;
+    const double effectiveRate = 1.0 * (1 - blocking);
+
+    assert(near(statistics.dropRate(), blocking, 0.05));
+    assert(near(statistics.utilization(), rho * (1 - blocking), 0.01));
+    assert(near(statistics.meanQueue(), inQueue, 0.03));
+    assert(near(statistics.meanWait(), inQueue / effectiveRate, 0.03));
+    assert(near(statistics.throughput(), effectiveRate, 0.01));
+    assert(statistics.longestQueue == 10);
+    // Every arrival is served or dropped, but for those waiting at the start and end of the measurement
+    const auto unbalanced = static_cast<std::int64_t>(statistics.arrivals - statistics.served - statistics.dropped);
+    assert(std::abs(unbalanced) <= 10);
+}
+
+// Three barbers and unlimited chairs, M/M/3: the mean wait by Erlang C
+void test_MMc()
+{
+    ShopConfig config;
+    config.barbers = 3;
+    config.chairs = std::numeric_limits<std::size_t>::max();
+    config.service = Distribution::exponential(2.4);
+    config.warmup = 1'000;
+    config.duration = 2'000'000;
+    const ShopStatistics statistics = BarberShop{config}.run();
+
+    const double load = 2.4;                    // Arrival rate times mean service
+    const int c = 3;
+    double sum = 0, term = 1;
+    for (int k = 0; k < c; ++k)
+    {
+        sum += term;
+        term *= load / (k + 1);
+    }
+    const double tail = term * c / (c - load);  // a^c / c! * c / (c - a)
+    const double waitProbability = tail / (sum + tail);
+    const double meanWait = waitProbability * 2.4 / (c - load);
+
+    assert(0 == statistics.dropped);
+    assert(near(statistics.utilization(), load / c, 0.01));
+    assert(near(statistics.meanWait(), meanWait, 0.05));
+    assert(near(1.0 - static_cast<double>(statistics.waits.zeroCount()) / static_cast<double>(statistics.served), waitProbability, 0.03));
+}
+
+// Deterministic haircuts, M/D/1: the mean wait by Pollaczek-Khinchine, half that of M/M/1
+void test_MD1()
+{
+    ShopConfig config;
+    config.chairs = std::numeric_limits<std::size_t>::max();
+    config.service = Distribution::deterministic(0.8);
+    config.duration = 2'000'000;
+    const double mdWait = BarberShop{config}.run().meanWait();
+    assert(near(mdWait, 0.8 * 0.8 / (2 * (1 - 0.8)), 0.05));
+
+    config.service = Distribution::exponential(0.8);
+    const double mmWait = BarberShop{config}.run().meanWait();
+    assert(near(mmWait, 0.8 * 0.8 / (1 - 0.8), 0.05));
+}
+
+// A shop that keeps pace never queues
+void test_Deterministic()
+{
+    ShopConfig config;
+    config.arrivals = Distribution::deterministic(1.0);
+    config.service = Distribution::deterministic(0.5);
+    config.duration = 1'000;
+    const ShopStatistics statistics = BarberShop{config}.run();
+
+    assert(1'000 == statistics.arrivals && 1'000 == statistics.served && 0 == statistics.dropped);
+    assert(0.0 == statistics.meanWait() && 0.0 == statistics.waitQuantile(0.99));
+    assert(near(statistics.utilization(), 0.5, 2e-3));
+    assert(0 == statistics.longestQueue);
+
+    bool thrown = false;
+    config.barbers = 0;
+    try { BarberShop{config}; }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// Replications are the same on any number of threads, differ from each other, and bracket the truth
+void test_Replications()
+{
+    ShopConfig config;
+    config.chairs = std::numeric_limits<std::size_t>::max();
+    config.warmup = 1'000;
+    config.duration = 50'000;
+    const auto parallel = BarberShop::replicate(config, 20, 4);
+    const auto serial = BarberShop::replicate(config, 20, 1);
+
+    assert(20 == parallel.size());
+    for (std::size_t i = 0; i < parallel.size(); ++i)
+    {
+        assert(parallel[i].arrivals == serial[i].arrivals);
+        assert(parallel[i].totalWait == serial[i].totalWait);
+        assert(i == 0 || parallel[i].arrivals != parallel[i - 1].arrivals);
+    }
+
+    // M/M/1 at rho = 0.8 waits 3.2 on average; the interval covers it but for a 5% chance, widened here
+    const Estimate wait = estimate(parallel, &ShopStatistics::meanWait);
+    assert(std::abs(wait.mean - 3.2) <= 2 * wait.halfWidth);
+    assert(wait.halfWidth > 0 && wait.halfWidth < 0.5);
+
+    ShopStatistics merged = parallel.front();
+    for (std::size_t i = 1; i < parallel.size(); ++i) merged.merge(parallel[i]);
+    assert(near(merged.duration, 20 * 50'000, 1e-12));
+    assert(near(merged.meanWait(), 3.2, 0.05));
+}
+
+// Millions of simulated customers per second of wall-clock time, in one run
+void benchmark_Customers(const char* name, ShopConfig config)
+{
+    config.duration = 10'000'000 * config.arrivals.mean();
+    ShopStatistics statistics;
+    StopWatch stopWatch;
+    stopWatch.StartStopWatch();
+    statistics = BarberShop{config}.run();
+    stopWatch.StopStopWatch();
+    const double elapsed = stopWatch.GetTime();
+
+    // Arrivals are Poisson with mean 10'000'000 over the run; every one is served, dropped or still waiting
+    assert(near(static_cast<double>(statistics.arrivals), 10'000'000, 0.01));
+    assert(statistics.served + statistics.dropped <= statistics.arrivals);
+    std::cout << std::left << std::setw(32) << name << std::setw(16) << statistics.arrivals / elapsed / 1e6
+              << statistics.meanWait() << std::endl;
+}
+
+// Millions of simulated customers per second over 16 replications, on the given number of threads
+void benchmark_Replications(unsigned threads)
+{
+    ShopConfig config;
+    config.duration = 1'000'000;
+    std::vector<ShopStatistics> replications;
+    StopWatch stopWatch;
+    stopWatch.StartStopWatch();
+    replications = BarberShop::replicate(config, 16, threads);
+    stopWatch.StopStopWatch();
+    const double elapsed = stopWatch.GetTime();
+    std::uint64_t customers = 0;
+    for (const ShopStatistics& replication : replications)
+    {
+        assert(replication.served + replication.dropped <= replication.arrivals);
+        customers += replication.arrivals;
+    }
+    assert(near(static_cast<double>(customers), 16 * config.duration / config.arrivals.mean(), 0.01));
+    std::cout << threads << "\t\t" << customers / elapsed / 1e6 << std::endl;
+}
+
+// How many chairs does a shop at 90% load need? Drops and the 95th percentile wait, over 10 replications
+void study_Chairs()
+{
+    ShopConfig config;
+    config.service = Distribution::lognormal(0.9, 0.5);
+    config.warmup = 1'000;
+    config.duration = 200'000;
+    std::cout << "Chairs\tDropped\t\t\t95% wait" << std::endl;
+    for (std::size_t chairs : {0, 1, 2, 4, 6, 8, 12, 16})
+    {
+        config.chairs = chairs;
+        const auto replications = BarberShop::replicate(config, 10);
+        const Estimate drops = estimate(replications, &ShopStatistics::dropRate);
+        double p95 = 0;
+        for (const ShopStatistics& replication : replications) p95 += replication.waitQuantile(0.95) / 10;
+        std::cout << chairs << "\t" << std::fixed << std::setprecision(4) << drops.mean << " ± " << drops.halfWidth
+                  << "\t" << p95 << std::defaultfloat << std::setprecision(6) << std::endl;
+    }
+}
+
+// The threaded shop of the original exercise: 100 Customer threads and a Barber thread in real time
+void threaded_shop()
 {
     constexpr int CUSTOMER_THREADS = 100;
 
@@ -43,6 +337,36 @@ int main()
     }
 
     if (barberThread.joinable()) barberThread.join();
+}
+
+int main()
+{
+    test_Calendar();
+    test_Distributions();
+    test_Histogram();
+    test_MM1K();
+    test_MMc();
+    test_MD1();
+    test_Deterministic();
+    test_Replications();
+
+    std::cout << "Shop\t\t\t\tM customers/s\tMean wait" << std::endl;
+    ShopConfig single;
+    benchmark_Customers("M/M/1, 10 chairs", single);
+    ShopConfig three;
+    three.barbers = 3;
+    three.chairs = std::numeric_limits<std::size_t>::max();
+    three.service = Distribution::lognormal(2.7, 1.0);
+    benchmark_Customers("LogN service, 3 barbers", three);
+
+    std::cout << "Threads\t\tM customers/s (16 replications)" << std::endl;
+    for (unsigned threads : {1u, 2u, 4u}) benchmark_Replications(threads);
+
+    study_Chairs();
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    threaded_shop();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,53 @@
+//
+// Ownership and values of the asynchronous generator
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCGENERATOR_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCGENERATOR_CPP
+
+#include "AsyncGenerator.hpp"
+
+/**
+ * Destroys the generator's frame, wherever it is suspended
+ * @tparam T The type of the values yielded
+ */
+template<typename T>
+AsyncGenerator<T>::~AsyncGenerator()
+{
+    if (handle) handle.destroy();
+}
+
+/**
+ * @tparam T The type of the values yielded
+ * @param source The generator to take over; it is left empty
+ * @return This generator
+ */
+template<typename T>
+AsyncGenerator<T>& AsyncGenerator<T>::operator=(AsyncGenerator&& source) noexcept
+{
+    if (this != &source)
+    {
+        if (handle) handle.destroy();
+        handle = std::exchange(source.handle, {});
+    }
+    return *this;
+}
+
+/**
+ * @tparam T The type of the values yielded
+ * @return A copy of the value yielded, or none if the generator has finished
+ * @throws Whatever the generator threw
+ */
+template<typename T>
+std::optional<T> AsyncGenerator<T>::NextAwaiter::await_resume() const
+{
+    if (!handle) return std::nullopt;
+    promise_type& promise = handle.promise();
+    if (promise.error) std::rethrow_exception(std::exchange(promise.error, nullptr));
+    if (handle.done() || !promise.current) return std::nullopt;
+    return std::optional<T>{*promise.current};
+}
+
+#endif
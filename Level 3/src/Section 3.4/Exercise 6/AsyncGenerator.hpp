@@ -0,0 +1,103 @@
+//
+// An asynchronous generator: a coroutine that may both co_await, say to move onto a pool or wait on a queue,
+// and co_yield values to a consumer, which pulls them one at a time with co_await generator.next(). Like a
+// Task it starts only when first pulled, and control passes between producer and consumer by symmetric
+// transfer, so the pair runs as a pipeline with no thread blocked and no shared state between them: the
+// consumer copies each value straight out of the producer's frame while the producer waits at its co_yield.
+//
+// next() returns an empty std::optional once the generator has finished, and rethrows what it threw. The
+// generator must not be pulled again before a next() has completed.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCGENERATOR_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCGENERATOR_HPP
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+template<typename T>
+class [[nodiscard]] AsyncGenerator
+{
+public:
+    class promise_type
+    {
+    private:
+        friend class AsyncGenerator;
+
+        std::add_pointer_t<const T> current = nullptr;      // The value at the co_yield the producer is suspended at
+        std::coroutine_handle<> consumer;
+        std::exception_ptr error;
+
+        // Hand control back to the consumer, whether with a value or at the end
+        struct YieldAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_resume() const noexcept {}
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> producer) const noexcept
+            {
+                return producer.promise().consumer;
+            }
+        };
+
+    public:
+        AsyncGenerator get_return_object() noexcept { return AsyncGenerator{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        YieldAwaiter final_suspend() noexcept { current = nullptr; return {}; }
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+        void return_void() const noexcept {}
+
+        YieldAwaiter yield_value(const T& value) noexcept
+        {
+            current = std::addressof(value);
+            return {};
+        }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    struct NextAwaiter
+    {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept { return !handle || handle.done(); }
+        std::optional<T> await_resume() const;
+
+        // Run the producer to its next co_yield or its end
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept
+        {
+            handle.promise().consumer = awaiting;
+            return handle;
+        }
+    };
+
+public:
+    AsyncGenerator() noexcept : handle{} {}
+    explicit AsyncGenerator(std::coroutine_handle<promise_type> handle) noexcept : handle{handle} {}
+    AsyncGenerator(const AsyncGenerator& source) = delete;
+    AsyncGenerator(AsyncGenerator&& source) noexcept : handle{std::exchange(source.handle, {})} {}
+    ~AsyncGenerator();
+
+    // Operator overloads
+    AsyncGenerator& operator=(const AsyncGenerator& source) = delete;
+    AsyncGenerator& operator=(AsyncGenerator&& source) noexcept;
+
+    // Accessors
+    bool isDone() const noexcept { return !handle || handle.done(); }
+
+    // Core functionality
+    NextAwaiter next() noexcept { return NextAwaiter{handle}; }
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCGENERATOR_CPP
+#include "AsyncGenerator.cpp"
+#endif
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCGENERATOR_HPP
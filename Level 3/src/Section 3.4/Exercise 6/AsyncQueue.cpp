@@ -0,0 +1,171 @@
+//
+// Handing items to suspended consumers
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCQUEUE_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCQUEUE_CPP
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "AsyncQueue.hpp"
+
+/**
+ * Default ctor: consumers are resumed on the thread that enqueues for them
+ * @tparam T The type of the items
+ * @tparam Queue The wrapped queue
+ */
+template<typename T, typename Queue>
+AsyncQueue<T, Queue>::AsyncQueue() noexcept
+    : mutex{}, wrapped{}, count{0}, waiting{}, pool{nullptr}, closed{false}
+{
+
+}
+
+/**
+ * Overloaded ctor
+ * @tparam T The type of the items
+ * @tparam Queue The wrapped queue
+ * @param pool The pool to resume consumers on
+ */
+template<typename T, typename Queue>
+AsyncQueue<T, Queue>::AsyncQueue(ThreadPool& pool) noexcept
+    : mutex{}, wrapped{}, count{0}, waiting{}, pool{&pool}, closed{false}
+{
+
+}
+
+/**
+ * @tparam T The type of the items
+ * @tparam Queue The wrapped queue
+ * @param consumer A consumer whose item, or the end of the queue, is in its awaiter
+ */
+template<typename T, typename Queue>
+void AsyncQueue<T, Queue>::resume(std::coroutine_handle<> consumer)
+{
+    if (pool) pool->enqueue(consumer);
+    else consumer.resume();
+}
+
+/**
+ * @tparam T The type of the items
+ * @tparam Queue The wrapped queue
+ * @param awaiting The consumer
+ * @return Whether it must wait: not if an item was there to take or the queue is closed
+ */
+template<typename T, typename Queue>
+bool AsyncQueue<T, Queue>::DequeueAwaiter::await_suspend(std::coroutine_handle<> awaiting)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.count > 0)
+    {
+        --queue.count;
+        item = queue.wrapped.dequeue();
+        return false;
+    }
+    if (queue.closed) return false;
+    consumer = awaiting;
+    queue.waiting.push_back(this);
+    return true;
+}
+
+/**
+ * @tparam T The type of the items
+ * @tparam Queue The wrapped queue
+ * @return The number of items not yet taken
+ */
+template<typename T, typename Queue>
+std::size_t AsyncQueue<T, Queue>::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+}
+
+/**
+ * @tparam T The type of the items
+ * @tparam Queue The wrapped queue
+ * @return The number of consumers suspended on the queue
+ */
+template<typename T, typename Queue>
+std::size_t AsyncQueue<T, Queue>::waiters() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return waiting.size();
+}
+
+/**
+ * @tparam T The type of the items
+ * @tparam Queue The wrapped queue
+ * @return Whether close() has been called
+ */
+template<typename T, typename Queue>
+bool AsyncQueue<T, Queue>::isClosed() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return closed;
+}
+
+/**
+ * Hands the item to the longest-waiting consumer, or queues it if none is waiting
+ * @tparam T The type of the items
+ * @tparam Queue The wrapped queue
+ * @param data The item
+ * @throws std::logic_error if the queue is closed
+ */
+template<typename T, typename Queue>
+void AsyncQueue<T, Queue>::enqueue(T data)
+{
+    DequeueAwaiter* consumer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closed) throw std::logic_error("Enqueueing to a closed AsyncQueue");
+        if (waiting.empty())
+        {
+            wrapped.enqueue(data);
+            ++count;
+            return;
+        }
+        consumer = waiting.front();
+        waiting.pop_front();
+        consumer->item.emplace(std::move(data));
+    }
+    // Outside the lock: the consumer may run here and enqueue or dequeue in turn
+    resume(consumer->consumer);
+}
+
+/**
+ * @tparam T The type of the items
+ * @tparam Queue The wrapped queue
+ * @return The next item if there is one, without waiting
+ */
+template<typename T, typename Queue>
+std::optional<T> AsyncQueue<T, Queue>::tryDequeue()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0) return std::nullopt;
+    --count;
+    return wrapped.dequeue();
+}
+
+/**
+ * Closes the queue and resumes every waiting consumer with no item
+ * @tparam T The type of the items
+ * @tparam Queue The wrapped queue
+ */
+template<typename T, typename Queue>
+void AsyncQueue<T, Queue>::close()
+{
+    std::vector<std::coroutine_handle<>> consumers;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        for (DequeueAwaiter* awaiter : waiting) consumers.push_back(awaiter->consumer);
+        waiting.clear();
+    }
+    for (std::coroutine_handle<> consumer : consumers) resume(consumer);
+}
+
+#endif
@@ -0,0 +1,88 @@
+//
+// An awaitable wrapper of the project's ConcurrentQueue (or ConcurrentPriorityQueue): enqueue() as before, but
+// co_await dequeue() suspends the consuming coroutine instead of blocking its thread on the wrapped queue's
+// condition variable. An enqueue hands the item straight to the longest-waiting consumer, if there is one, and
+// resumes it on the pool given at construction, or else inline on the enqueuing thread; otherwise the item goes
+// into the wrapped queue. Ten thousand consumers waiting on an empty queue are ten thousand suspended frames and
+// no threads.
+//
+// The wrapped queue is only dequeued from while it is known to hold an item, so its dequeue() never blocks. Its
+// enqueue() takes a const reference, so T must be copyable.
+//
+// close() plays the part of ConcurrentQueue's interrupt: waiting consumers, and any that dequeue from the
+// closed queue once it is empty, get an empty std::optional. Items enqueued before close() are still handed
+// out; enqueue() after it throws.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCQUEUE_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCQUEUE_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include "ConcurrentQueue.hpp"
+#include "ThreadPool.hpp"
+
+template<typename T, typename Queue = ConcurrentQueue<T>>
+class AsyncQueue
+{
+private:
+    class DequeueAwaiter
+    {
+    private:
+        friend class AsyncQueue;
+
+        AsyncQueue& queue;
+        std::coroutine_handle<> consumer;
+        std::optional<T> item;
+
+    public:
+        explicit DequeueAwaiter(AsyncQueue& queue) noexcept : queue{queue}, consumer{}, item{} {}
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> awaiting);
+        std::optional<T> await_resume() noexcept { return std::move(item); }
+    };
+
+    mutable std::mutex mutex;
+    Queue wrapped;
+    std::size_t count;
+    std::deque<DequeueAwaiter*> waiting;
+    ThreadPool* pool;
+    bool closed;
+
+    void resume(std::coroutine_handle<> consumer);
+
+public:
+    AsyncQueue() noexcept;
+    explicit AsyncQueue(ThreadPool& pool) noexcept;
+    AsyncQueue(const AsyncQueue<T, Queue>& source) = delete;
+    AsyncQueue(AsyncQueue<T, Queue>&& source) = delete;
+    ~AsyncQueue() = default;
+
+    // Operator overloads
+    AsyncQueue& operator=(const AsyncQueue<T, Queue>& source) = delete;
+    AsyncQueue& operator=(AsyncQueue<T, Queue>&& source) = delete;
+
+    // Accessors
+    std::size_t size() const;
+    std::size_t waiters() const;
+    bool isClosed() const;
+
+    // Core functionality
+    void enqueue(T data);
+    DequeueAwaiter dequeue() noexcept { return DequeueAwaiter{*this}; }
+    std::optional<T> tryDequeue();
+    void close();
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCQUEUE_CPP
+#include "AsyncQueue.cpp"
+#endif
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_ASYNCQUEUE_HPP
@@ -0,0 +1,160 @@
+//
+// Results of tasks and the blocking syncWait
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TASK_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_TASK_CPP
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+
+#include "Task.hpp"
+
+/**
+ * @tparam T The result type
+ * @return The task owning this promise's coroutine
+ */
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+/**
+ * @tparam T The result type
+ * @return The value the coroutine returned, moved out
+ * @throws Whatever the coroutine threw, or std::logic_error if the result was already taken
+ */
+template<typename T>
+T TaskPromise<T>::takeResult()
+{
+    if (result.index() == 2) std::rethrow_exception(std::get<2>(result));
+    if (result.index() == 0) throw std::logic_error("The task's result was already taken");
+    T value = std::move(std::get<1>(result));
+    result.template emplace<0>();
+    return value;
+}
+
+/**
+ * @return The task owning this promise's coroutine
+ */
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+/**
+ * @throws Whatever the coroutine threw
+ */
+inline void TaskPromise<void>::takeResult()
+{
+    if (error) std::rethrow_exception(std::exchange(error, nullptr));
+}
+
+/**
+ * Destroys the coroutine frame, whether or not the task ran
+ * @tparam T The result type
+ */
+template<typename T>
+Task<T>::~Task()
+{
+    if (handle) handle.destroy();
+}
+
+/**
+ * @tparam T The result type
+ * @param source The task to take over; it is left empty
+ * @return This task
+ */
+template<typename T>
+Task<T>& Task<T>::operator=(Task&& source) noexcept
+{
+    if (this != &source)
+    {
+        if (handle) handle.destroy();
+        handle = std::exchange(source.handle, {});
+    }
+    return *this;
+}
+
+/**
+ * @tparam T The result type
+ * @return The task's result once it has finished
+ * @throws Whatever the task threw, or std::logic_error if the task is empty
+ */
+template<typename T>
+T Task<T>::Awaiter::await_resume() const
+{
+    if (!handle) throw std::logic_error("Awaiting an empty task");
+    return handle.promise().takeResult();
+}
+
+/**
+ * The rendezvous between syncWait and the coroutine that awaits the task
+ * @tparam T The result type
+ */
+template<typename T>
+struct SyncWaitState
+{
+    std::mutex mutex;
+    std::condition_variable done;
+    bool finished = false;
+    std::optional<std::conditional_t<std::is_void_v<T>, std::monostate, T>> value;
+    std::exception_ptr error;
+};
+
+/**
+ * Awaits the task and signals syncWait; the state outlives it, since syncWait waits for the signal
+ * @tparam T The result type
+ */
+template<typename T>
+DetachedTask syncWaitBody(Task<T>& task, SyncWaitState<T>& state)
+{
+    try
+    {
+        if constexpr (std::is_void_v<T>)
+        {
+            co_await task;
+            state.value.emplace();
+        }
+        else
+        {
+            state.value.emplace(co_await task);
+        }
+    }
+    catch (...)
+    {
+        state.error = std::current_exception();
+    }
+
+    // Notify under the lock, so that syncWait cannot return and destroy the state in between
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.finished = true;
+    state.done.notify_one();
+}
+
+/**
+ * Runs a task from code that is not a coroutine and blocks until it finishes
+ * @tparam T The result type
+ * @param task The task
+ * @return Its result
+ * @throws Whatever the task threw
+ */
+template<typename T>
+T syncWait(Task<T> task)
+{
+    SyncWaitState<T> state;
+    syncWaitBody(task, state);
+    {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.done.wait(lock, [&state] { return state.finished; });
+    }
+    if (state.error) std::rethrow_exception(state.error);
+    if constexpr (!std::is_void_v<T>) return std::move(*state.value);
+}
+
+#endif
@@ -0,0 +1,145 @@
+//
+// A lazy coroutine task. A Task<T> does nothing until it is awaited; the awaiting coroutine is then suspended,
+// the task runs, and when it finishes it resumes its awaiter directly by symmetric transfer: its final
+// suspension returns the awaiter's handle, so a chain of a million tasks awaiting one another runs in
+// constant stack depth and with no thread blocked on anything. The result or exception lives in the task's
+// own frame, so there is no shared state to allocate as there is for a std::future.
+//
+// syncWait() is the one place a thread blocks: it runs a task from ordinary code, such as main(), and waits
+// for it. DetachedTask is the fire-and-forget coroutine underneath syncWait, whenAll and whenAny; it starts
+// at once and frees itself when it ends, and an exception escaping it terminates, as for a std::thread.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TASK_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_TASK_HPP
+
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+
+template<typename T>
+class Task;
+
+class TaskPromiseBase
+{
+private:
+    std::coroutine_handle<> continuation;
+
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+        void await_resume() const noexcept {}
+
+        // Resume whoever awaited the task, on this thread and without growing the stack
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finished) const noexcept
+        {
+            const std::coroutine_handle<> next = finished.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+    };
+
+public:
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void setContinuation(std::coroutine_handle<> next) noexcept { continuation = next; }
+};
+
+template<typename T>
+class TaskPromise : public TaskPromiseBase
+{
+private:
+    std::variant<std::monostate, T, std::exception_ptr> result;
+
+public:
+    Task<T> get_return_object() noexcept;
+    void unhandled_exception() noexcept { result.template emplace<2>(std::current_exception()); }
+
+    template<typename U> requires std::convertible_to<U&&, T>
+    void return_value(U&& value) { result.template emplace<1>(std::forward<U>(value)); }
+
+    T takeResult();
+};
+
+template<>
+class TaskPromise<void> : public TaskPromiseBase
+{
+private:
+    std::exception_ptr error;
+
+public:
+    Task<void> get_return_object() noexcept;
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+    void return_void() const noexcept {}
+
+    void takeResult();
+};
+
+template<typename T = void>
+class [[nodiscard]] Task
+{
+public:
+    using promise_type = TaskPromise<T>;
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    struct Awaiter
+    {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept { return !handle || handle.done(); }
+        T await_resume() const;
+
+        // Start the task, which resumes the awaiter when it finishes
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept
+        {
+            handle.promise().setContinuation(awaiting);
+            return handle;
+        }
+    };
+
+public:
+    Task() noexcept : handle{} {}
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle{handle} {}
+    Task(const Task& source) = delete;
+    Task(Task&& source) noexcept : handle{std::exchange(source.handle, {})} {}
+    ~Task();
+
+    // Operator overloads
+    Task& operator=(const Task& source) = delete;
+    Task& operator=(Task&& source) noexcept;
+    Awaiter operator co_await() const noexcept { return Awaiter{handle}; }
+
+    // Accessors
+    bool isValid() const noexcept { return static_cast<bool>(handle); }
+    bool isReady() const noexcept { return !handle || handle.done(); }
+};
+
+class DetachedTask
+{
+public:
+    struct promise_type
+    {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+template<typename T>
+T syncWait(Task<T> task);
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TASK_CPP
+#include "Task.cpp"
+#endif
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_TASK_HPP
@@ -0,0 +1,96 @@
+//
+// Worker threads resuming queued coroutines
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <stdexcept>
+#include <utility>
+
+#include "ThreadPool.hpp"
+
+/**
+ * Overloaded ctor
+ * @param threads The number of workers
+ * @throws std::invalid_argument if there are none
+ */
+ThreadPool::ThreadPool(unsigned threads) : mutex{}, available{}, ready{}, stopping{false}, workers{}
+{
+    if (threads == 0) throw std::invalid_argument("A thread pool needs at least one thread");
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) workers.emplace_back([this] { work(); });
+}
+
+/**
+ * Finishes the queued coroutines, and any they queue in turn, then joins the workers
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+/**
+ * Resumes coroutines until the pool stops and nothing is left to resume
+ */
+void ThreadPool::work()
+{
+    while (true)
+    {
+        std::coroutine_handle<> next;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this] { return stopping || !ready.empty(); });
+            if (ready.empty()) return;
+            next = ready.front();
+            ready.pop_front();
+        }
+        next.resume();
+    }
+}
+
+/**
+ * @return The coroutines waiting for a worker
+ */
+std::size_t ThreadPool::queued() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return ready.size();
+}
+
+/**
+ * @param handle A suspended coroutine for a worker to resume
+ */
+void ThreadPool::enqueue(std::coroutine_handle<> handle)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.push_back(handle);
+    }
+    available.notify_one();
+}
+
+namespace
+{
+    /**
+     * Runs the task on the pool; the frame owns the task and frees both when it ends
+     */
+    DetachedTask runDetached(ThreadPool& pool, Task<void> task)
+    {
+        co_await pool.schedule();
+        co_await task;
+    }
+}
+
+/**
+ * Runs a task on the pool with nobody awaiting it; an exception escaping it terminates
+ * @param task The task
+ */
+void ThreadPool::spawn(Task<void> task)
+{
+    runDetached(*this, std::move(task));
+}
@@ -0,0 +1,80 @@
+//
+// A pool of worker threads that resume coroutines. A coroutine moves itself onto the pool with
+// co_await scheduleOn(pool): it is suspended, its handle queued, and a worker resumes it. A suspended
+// coroutine holds no thread, so thousands of them may wait on a queue or on each other while the pool's few
+// workers run whichever are ready.
+//
+// spawn() runs a Task<void> on the pool without anyone awaiting it. The destructor lets the workers finish
+// every coroutine queued before it returns; coroutines still suspended elsewhere at that point must not be
+// scheduled on the pool afterwards.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_THREADPOOL_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_THREADPOOL_HPP
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Task.hpp"
+
+class ThreadPool
+{
+private:
+    mutable std::mutex mutex;
+    std::condition_variable available;
+    std::deque<std::coroutine_handle<>> ready;
+    bool stopping;
+    std::vector<std::thread> workers;
+
+    void work();
+
+public:
+    class ScheduleAwaiter
+    {
+    private:
+        ThreadPool& pool;
+
+    public:
+        explicit ScheduleAwaiter(ThreadPool& pool) noexcept : pool{pool} {}
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const { pool.enqueue(handle); }
+        void await_resume() const noexcept {}
+    };
+
+    ThreadPool() = delete;
+    explicit ThreadPool(unsigned threads);
+    ThreadPool(const ThreadPool& source) = delete;
+    ThreadPool(ThreadPool&& source) = delete;
+    ~ThreadPool();
+
+    // Operator overloads
+    ThreadPool& operator=(const ThreadPool& source) = delete;
+    ThreadPool& operator=(ThreadPool&& source) = delete;
+
+    // Accessors
+    std::size_t size() const noexcept { return workers.size(); }
+    std::size_t queued() const;
+
+    // Core functionality
+    ScheduleAwaiter schedule() noexcept { return ScheduleAwaiter{*this}; }
+    void enqueue(std::coroutine_handle<> handle);
+    void spawn(Task<void> task);
+};
+
+/**
+ * @param pool The pool to continue on
+ * @return An awaitable that resumes the awaiting coroutine on one of the pool's workers
+ */
+inline ThreadPool::ScheduleAwaiter scheduleOn(ThreadPool& pool) noexcept
+{
+    return pool.schedule();
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_THREADPOOL_HPP
@@ -0,0 +1,220 @@
+//
+// whenAll and whenAny
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_WHENALL_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_WHENALL_CPP
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+
+#include "WhenAll.hpp"
+
+/**
+ * What the tasks of a whenAll share with its awaiter. The count starts one above the number of tasks, and
+ * the awaiter takes the extra one once it has started them all, so that whichever of it and the last task
+ * comes second resumes the awaiter, and never while it is still starting tasks.
+ * @tparam T The result type of the tasks
+ */
+template<typename T>
+struct WhenAllState
+{
+    std::atomic<std::size_t> remaining;
+    std::coroutine_handle<> awaiter;
+    std::conditional_t<std::is_void_v<T>, std::monostate, std::vector<std::optional<T>>> results;
+    std::once_flag failed;
+    std::exception_ptr error;
+
+    /**
+     * @return Whether the caller was the last and should resume the awaiter
+     */
+    bool arrive() noexcept { return remaining.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+};
+
+/**
+ * Runs one task of a whenAll and resumes the awaiter if it is the last to finish
+ */
+template<typename T>
+DetachedTask whenAllChild(Task<T>& task, WhenAllState<T>& state, std::size_t index)
+{
+    try
+    {
+        if constexpr (std::is_void_v<T>) co_await task;
+        else state.results[index].emplace(co_await task);
+    }
+    catch (...)
+    {
+        std::call_once(state.failed, [&state] { state.error = std::current_exception(); });
+    }
+    if (state.arrive()) state.awaiter.resume();
+}
+
+/**
+ * Starts every task and suspends the awaiter until all have finished
+ */
+template<typename T>
+struct WhenAllAwaiter
+{
+    std::vector<Task<T>>& tasks;
+    WhenAllState<T>& state;
+
+    bool await_ready() const noexcept { return tasks.empty(); }
+    void await_resume() const noexcept {}
+
+    bool await_suspend(std::coroutine_handle<> awaiting)
+    {
+        state.awaiter = awaiting;
+        for (std::size_t i = 0; i < tasks.size(); ++i) whenAllChild(tasks[i], state, i);
+        // Suspend unless every task has already finished
+        return !state.arrive();
+    }
+};
+
+/**
+ * @tparam T The result type of the tasks
+ * @param tasks The tasks to run
+ * @return A task whose result is theirs, in order; none for tasks of void
+ * @throws The first exception a task threw, once all have finished
+ */
+template<typename T>
+Task<WhenAllResult<T>> whenAll(std::vector<Task<T>> tasks)
+{
+    WhenAllState<T> state{};
+    state.remaining.store(tasks.size() + 1, std::memory_order_relaxed);
+    if constexpr (!std::is_void_v<T>) state.results.resize(tasks.size());
+
+    co_await WhenAllAwaiter<T>{tasks, state};
+    if (state.error) std::rethrow_exception(state.error);
+
+    if constexpr (!std::is_void_v<T>)
+    {
+        std::vector<T> values;
+        values.reserve(tasks.size());
+        for (std::optional<T>& result : state.results) values.push_back(std::move(*result));
+        co_return values;
+    }
+}
+
+/**
+ * Stores a task's result in a slot, so that tasks of different types can be awaited as tasks of void
+ */
+template<typename T>
+Task<void> storeResult(Task<T> task, std::optional<T>& slot)
+{
+    slot.emplace(co_await task);
+}
+
+/**
+ * @tparam Ts The result types of the tasks
+ * @param tasks The tasks to run
+ * @return A task whose result is a tuple of theirs
+ * @throws The first exception a task threw, once all have finished
+ */
+template<typename... Ts> requires (sizeof...(Ts) > 0 && (!std::is_void_v<Ts> && ...))
+Task<std::tuple<Ts...>> whenAll(Task<Ts>... tasks)
+{
+    std::tuple<std::optional<Ts>...> slots;
+    std::vector<Task<void>> stores;
+    stores.reserve(sizeof...(Ts));
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        (stores.push_back(storeResult(std::move(tasks), std::get<I>(slots))), ...);
+    }(std::index_sequence_for<Ts...>{});
+
+    co_await whenAll(std::move(stores));
+    co_return std::apply([](std::optional<Ts>&... values) { return std::tuple<Ts...>{std::move(*values)...}; }, slots);
+}
+
+/**
+ * What the tasks of a whenAny share with its awaiter and with each other; it owns the tasks, which may
+ * still be running after the awaiter has gone
+ * @tparam T The result type of the tasks
+ */
+template<typename T>
+struct WhenAnyState
+{
+    std::vector<Task<T>> tasks;
+    std::atomic<bool> decided{false};
+    std::atomic<int> gate{2};                   // The winner and the awaiter's start loop; the second resumes
+    std::coroutine_handle<> awaiter;
+    std::size_t winner = 0;
+    std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>> value;
+    std::exception_ptr error;
+
+    bool arrive() noexcept { return gate.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+};
+
+/**
+ * Runs one task of a whenAny; the first to finish records its result and resumes the awaiter
+ */
+template<typename T>
+DetachedTask whenAnyChild(std::shared_ptr<WhenAnyState<T>> state, std::size_t index)
+{
+    std::exception_ptr error;
+    std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>> value;
+    try
+    {
+        if constexpr (std::is_void_v<T>) co_await state->tasks[index];
+        else value.emplace(co_await state->tasks[index]);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    if (state->decided.exchange(true, std::memory_order_acq_rel)) co_return;
+    state->winner = index;
+    state->value = std::move(value);
+    state->error = error;
+    if (state->arrive()) state->awaiter.resume();
+}
+
+// Refers to the awaiting frame's pointer rather than copying it: g++ 12 can destroy the temporary awaiter
+// twice when await_suspend returns false, which would drop a reference the frame still relies on
+template<typename T>
+struct WhenAnyAwaiter
+{
+    const std::shared_ptr<WhenAnyState<T>>& state;
+
+    bool await_ready() const noexcept { return false; }
+    void await_resume() const noexcept {}
+
+    bool await_suspend(std::coroutine_handle<> awaiting)
+    {
+        state->awaiter = awaiting;
+        // Once a task has won there is no point starting the rest
+        for (std::size_t i = 0; i < state->tasks.size() && !state->decided.load(std::memory_order_acquire); ++i)
+            whenAnyChild(state, i);
+        return !state->arrive();
+    }
+};
+
+/**
+ * @tparam T The result type of the tasks
+ * @param tasks The tasks to race, at least one
+ * @return A task whose result is the index and result of the first task to finish
+ * @throws std::invalid_argument if there are no tasks, or the exception of the first task if it threw
+ */
+template<typename T>
+Task<WhenAnyResult<T>> whenAny(std::vector<Task<T>> tasks)
+{
+    if (tasks.empty()) throw std::invalid_argument("whenAny needs at least one task");
+    auto state = std::make_shared<WhenAnyState<T>>();
+    state->tasks = std::move(tasks);
+
+    co_await WhenAnyAwaiter<T>{state};
+    if (state->error) std::rethrow_exception(state->error);
+
+    if constexpr (std::is_void_v<T>) co_return WhenAnyResult<void>{state->winner};
+    else co_return WhenAnyResult<T>{state->winner, std::move(*state->value)};
+}
+
+#endif
@@ -0,0 +1,55 @@
+//
+// Combinators over tasks. whenAll starts every task and resumes its awaiter when the last one finishes, with
+// their results in order; the tasks run concurrently if they move themselves onto a pool, and one after the
+// other on the awaiting thread if they do not. The first exception among them is rethrown once all have
+// finished. whenAny resumes its awaiter as soon as the first task finishes, with its index and result. There
+// is no cancellation: the other tasks run on to completion and their results are dropped, so whenAny keeps
+// them alive in state shared with the coroutines running them rather than in the awaiter's frame.
+//
+// The awaiter is resumed on the thread that finished the last task, or the first for whenAny. Neither
+// combinator blocks a thread or allocates a future per task.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_WHENALL_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_WHENALL_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Task.hpp"
+
+template<typename T>
+using WhenAllResult = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+
+template<typename T>
+struct WhenAnyResult
+{
+    std::size_t index;
+    T value;
+};
+
+template<>
+struct WhenAnyResult<void>
+{
+    std::size_t index;
+};
+
+template<typename T>
+Task<WhenAllResult<T>> whenAll(std::vector<Task<T>> tasks);
+
+template<typename... Ts> requires (sizeof...(Ts) > 0 && (!std::is_void_v<Ts> && ...))
+Task<std::tuple<Ts...>> whenAll(Task<Ts>... tasks);
+
+template<typename T>
+Task<WhenAnyResult<T>> whenAny(std::vector<Task<T>> tasks);
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_WHENALL_CPP
+#include "WhenAll.cpp"
+#endif
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_WHENALL_HPP
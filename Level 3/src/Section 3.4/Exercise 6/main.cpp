@@ -3,15 +3,43 @@
 // depends on the output from the computation performed by the prior node. Note that this
 // simple illustration is specialized for a numeric type.
 //
+// Part E runs the same graph as coroutines: each node is a Task that moves itself onto a ThreadPool, the two
+// independent nodes are awaited together with whenAll, and no thread blocks on a future in between. Tests
+// cover Task, the pool, whenAll, whenAny, AsyncGenerator and AsyncQueue, including ten thousand consumers
+// suspended on one queue with two threads between them; the benchmark compares the cost per task of
+// std::async, a queue of std::packaged_task and coroutines on a pool.
+//
 // Created by Michael Lewis on 7/4/23.
 //
 
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <execution>
 #include <future>
 #include <chrono>
 #include <iostream>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <tuple>
+#include <vector>
+
+#include "AsyncGenerator.hpp"
+#include "AsyncQueue.hpp"
+#include "ConcurrentPriorityQueue.hpp"
+#include "InplaceFunction.hpp"
+#include "Task.hpp"
+#include "ThreadPool.hpp"
+#include "WhenAll.hpp"
 
 // 12 user-defined literals that represent hours, minutes, seconds, milliseconds, milliseconds, and nanoseconds
 // Will be used to set minimum duration to block for when attempting to acquire a lock
@@ -501,6 +529,440 @@ void test_Matrix()
     std::cout << "Total time (b + c + d + e)=" << (StopWatch::TotalTime(bTime, cTime, dTime, eTime)) << std::endl;
 }
 
+// *** Part E - the task graph as coroutines on a thread pool ***
+
+// A node of the graph: moves onto the pool, then computes
+Task<double> onPool(ThreadPool& pool, double (*node)(double, StopWatch&), double arg, StopWatch& watch)
+{
+    co_await scheduleOn(pool);
+    co_return node(arg, watch);
+}
+
+Task<double> taskGraph(ThreadPool& pool, double a, std::array<StopWatch, 4>& watches)
+{
+    // b and c are independent; d needs c, and e needs b and d
+    auto [b, c] = co_await whenAll(onPool(pool, F1, a, watches[0]), onPool(pool, F2, a, watches[1]));
+    const double d = co_await onPool(pool, F3, c, watches[2]);
+    co_await scheduleOn(pool);
+    co_return F4(b, d, watches[3]);
+}
+
+// Implement a parallel version of a task graph using coroutines where each node in the task graph depends
+// on the output from the computation performed by the prior node.
+void test_PartE()
+{
+    ThreadPool pool{4};
+    std::array<StopWatch, 4> watches{};
+    const double total = syncWait(taskGraph(pool, 9.0, watches));
+
+    StopWatch serial{};
+    assert(total == F4(F1(9.0, serial), F3(F2(9.0, serial), serial), serial));
+
+    auto bTime = watches[0].ElapsedTime();
+    auto cTime = watches[1].ElapsedTime();
+    auto dTime = watches[2].ElapsedTime();
+    auto eTime = watches[3].ElapsedTime();
+
+    std::cout << "\nCoroutine Task Graph Result = " << total << std::endl;
+    std::cout << "Running time b=" << bTime << std::endl;
+    std::cout << "Running time c=" << cTime << std::endl;
+    std::cout << "Running time d=" << dTime << std::endl;
+    std::cout << "Running time e=" << eTime << std::endl;
+    std::cout << "Total time (b + c + d + e)=" << (StopWatch::TotalTime(bTime, cTime, dTime, eTime)) << std::endl;
+}
+
+Task<int> square(int x)
+{
+    co_return x * x;
+}
+
+Task<int> sumOfSquares(int n)
+{
+    int total = 0;
+    for (int i = 1; i <= n; ++i) total += co_await square(i);
+    co_return total;
+}
+
+// Each level awaits the next; without symmetric transfer the resumptions would nest a stack frame per level.
+// The sanitizers stop the compiler turning the transfer into a tail call, so they get a shallower chain.
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+constexpr int DEPTH = 1'000;
+#else
+constexpr int DEPTH = 200'000;
+#endif
+
+Task<int> depth(int n)
+{
+    if (n == 0) co_return 0;
+    co_return 1 + co_await depth(n - 1);
+}
+
+Task<void> fail()
+{
+    throw std::runtime_error("failed");
+    co_return;
+}
+
+void test_Task()
+{
+    assert(syncWait(square(7)) == 49);
+    assert(syncWait(sumOfSquares(10)) == 385);
+    assert(syncWait(depth(DEPTH)) == DEPTH);
+
+    // Nothing runs until the task is awaited
+    bool ran = false;
+    auto lazy = [&ran]() -> Task<void> { ran = true; co_return; };
+    Task<void> pending = lazy();
+    assert(!ran && pending.isValid() && !pending.isReady());
+    syncWait(std::move(pending));
+    assert(ran && !pending.isValid());
+
+    bool threw = false;
+    try { syncWait(fail()); }
+    catch (const std::runtime_error& e) { threw = std::string(e.what()) == "failed"; }
+    assert(threw);
+
+    threw = false;
+    try { syncWait(Task<int>{}); }
+    catch (const std::logic_error&) { threw = true; }
+    assert(threw);
+
+    // Move-only results
+    auto boxed = []() -> Task<std::unique_ptr<int>> { co_return std::make_unique<int>(42); };
+    assert(*syncWait(boxed()) == 42);
+}
+
+Task<std::thread::id> threadOf(ThreadPool& pool)
+{
+    co_await scheduleOn(pool);
+    co_return std::this_thread::get_id();
+}
+
+void test_ThreadPool()
+{
+    bool threw = false;
+    try { ThreadPool none{0}; }
+    catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    std::atomic<int> done{0};
+    {
+        ThreadPool pool{3};
+        assert(pool.size() == 3);
+        assert(syncWait(threadOf(pool)) != std::this_thread::get_id());
+
+        // The destructor finishes everything spawned before it
+        for (int i = 0; i < 1000; ++i)
+        {
+            pool.spawn([](std::atomic<int>& counter) -> Task<void> { ++counter; co_return; }(done));
+        }
+    }
+    assert(done.load() == 1000);
+}
+
+Task<int> slowSquare(ThreadPool& pool, int x, std::chrono::milliseconds delay)
+{
+    co_await scheduleOn(pool);
+    std::this_thread::sleep_for(delay);
+    co_return x * x;
+}
+
+void test_WhenAll()
+{
+    ThreadPool pool{4};
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 100; ++i) tasks.push_back(slowSquare(pool, i, std::chrono::milliseconds(0)));
+    const std::vector<int> squares = syncWait(whenAll(std::move(tasks)));
+    assert(squares.size() == 100);
+    for (int i = 0; i < 100; ++i) assert(squares[i] == i * i);
+    assert(syncWait(whenAll(std::vector<Task<int>>{})).empty());
+
+    // Different types at once
+    auto text = [](ThreadPool& on) -> Task<std::string> { co_await scheduleOn(on); co_return "text"; };
+    const auto [number, word] = syncWait(whenAll(slowSquare(pool, 3, std::chrono::milliseconds(1)), text(pool)));
+    assert(number == 9 && word == "text");
+
+    // Tasks of void, inline without a pool
+    std::atomic<int> count{0};
+    std::vector<Task<void>> voids;
+    for (int i = 0; i < 10; ++i) voids.push_back([](std::atomic<int>& counter) -> Task<void> { ++counter; co_return; }(count));
+    syncWait(whenAll(std::move(voids)));
+    assert(count.load() == 10);
+
+    // The first exception is rethrown, after every task has finished
+    std::atomic<int> finished{0};
+    auto maybeFail = [](ThreadPool& on, int i, std::atomic<int>& counter) -> Task<int>
+    {
+        co_await scheduleOn(on);
+        ++counter;
+        if (i == 3) throw std::runtime_error("task 3");
+        co_return i;
+    };
+    std::vector<Task<int>> failing;
+    for (int i = 0; i < 8; ++i) failing.push_back(maybeFail(pool, i, finished));
+    bool threw = false;
+    try { syncWait(whenAll(std::move(failing))); }
+    catch (const std::runtime_error& e) { threw = std::string(e.what()) == "task 3"; }
+    assert(threw && finished.load() == 8);
+}
+
+void test_WhenAny()
+{
+    ThreadPool pool{4};
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 4; ++i) tasks.push_back(slowSquare(pool, i, std::chrono::milliseconds(i == 2 ? 0 : 200)));
+    const auto start = std::chrono::steady_clock::now();
+    const WhenAnyResult<int> first = syncWait(whenAny(std::move(tasks)));
+    assert(first.index == 2 && first.value == 4);
+    assert(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(150));
+
+    // Inline tasks finish in order, so the first one wins and the rest are never started
+    std::atomic<int> started{0};
+    std::vector<Task<void>> inline_;
+    for (int i = 0; i < 5; ++i) inline_.push_back([](std::atomic<int>& counter) -> Task<void> { ++counter; co_return; }(started));
+    assert(syncWait(whenAny(std::move(inline_))).index == 0);
+    assert(started.load() == 1);
+
+    bool threw = false;
+    try { syncWait(whenAny(std::vector<Task<int>>{})); }
+    catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    threw = false;
+    std::vector<Task<void>> failing;
+    failing.push_back(fail());
+    try { syncWait(whenAny(std::move(failing))); }
+    catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+AsyncGenerator<long> fibonacci(int count)
+{
+    long previous = 0, current = 1;
+    for (int i = 0; i < count; ++i)
+    {
+        co_yield previous;
+        previous = std::exchange(current, previous + current);
+    }
+}
+
+// Moves onto the pool between values, and throws after a few
+AsyncGenerator<std::string> words(ThreadPool& pool, bool failAfterThree)
+{
+    for (int i = 0; i < 5; ++i)
+    {
+        co_await scheduleOn(pool);
+        if (failAfterThree && i == 3) throw std::runtime_error("no more words");
+        co_yield "word " + std::to_string(i);
+    }
+}
+
+Task<std::vector<long>> collect(AsyncGenerator<long> generator)
+{
+    std::vector<long> values;
+    while (auto value = co_await generator.next()) values.push_back(*value);
+    assert(generator.isDone());
+    assert(!(co_await generator.next()));
+    co_return values;
+}
+
+Task<std::vector<std::string>> collectWords(AsyncGenerator<std::string> generator)
+{
+    std::vector<std::string> values;
+    try
+    {
+        while (auto value = co_await generator.next()) values.push_back(*value);
+    }
+    catch (const std::runtime_error&)
+    {
+        values.push_back("error");
+    }
+    co_return values;
+}
+
+void test_AsyncGenerator()
+{
+    assert((syncWait(collect(fibonacci(10))) == std::vector<long>{0, 1, 1, 2, 3, 5, 8, 13, 21, 34}));
+    assert(syncWait(collect(fibonacci(0))).empty());
+
+    ThreadPool pool{2};
+    assert(syncWait(collectWords(words(pool, false))).size() == 5);
+    assert((syncWait(collectWords(words(pool, true))) == std::vector<std::string>{"word 0", "word 1", "word 2", "error"}));
+
+    // A generator abandoned part way is destroyed where it is suspended
+    auto firstOnly = [](AsyncGenerator<long> generator) -> Task<long> { co_return *(co_await generator.next()); };
+    assert(syncWait(firstOnly(fibonacci(1'000))) == 0);
+}
+
+Task<long> consumeOne(AsyncQueue<int>& queue)
+{
+    const std::optional<int> item = co_await queue.dequeue();
+    co_return item ? *item : -1;
+}
+
+Task<long> consumeAll(AsyncQueue<int>& queue, int consumers)
+{
+    std::vector<Task<long>> tasks;
+    for (int i = 0; i < consumers; ++i) tasks.push_back(consumeOne(queue));
+    const std::vector<long> items = co_await whenAll(std::move(tasks));
+    co_return std::accumulate(items.begin(), items.end(), 0L);
+}
+
+void test_AsyncQueue()
+{
+    // Items queued before anyone waits are taken at once
+    AsyncQueue<int> queue;
+    queue.enqueue(5);
+    assert(queue.size() == 1);
+    assert(syncWait(consumeOne(queue)) == 5);
+    assert(!queue.tryDequeue());
+    queue.enqueue(6);
+    assert(queue.tryDequeue() == 6);
+
+    // Wrapping the ConcurrentPriorityQueue hands out the largest item first
+    AsyncQueue<int, ConcurrentPriorityQueue<int>> prioritized;
+    for (int item : {3, 9, 1}) prioritized.enqueue(item);
+    assert(prioritized.tryDequeue() == 9 && prioritized.tryDequeue() == 3 && prioritized.tryDequeue() == 1);
+
+    // Ten thousand consumers suspended at once, served by a pool of two threads
+    constexpr int CONSUMERS = 10'000;
+    ThreadPool pool{2};
+    AsyncQueue<int> shared{pool};
+    std::thread producer([&shared]
+    {
+        while (shared.waiters() < CONSUMERS) std::this_thread::yield();
+        for (int i = 1; i <= CONSUMERS; ++i) shared.enqueue(i);
+    });
+    assert(syncWait(consumeAll(shared, CONSUMERS)) == static_cast<long>(CONSUMERS) * (CONSUMERS + 1) / 2);
+    producer.join();
+    assert(shared.waiters() == 0 && shared.size() == 0);
+
+    // Closing wakes the waiting consumers with nothing; items enqueued before the close are still handed out
+    AsyncQueue<int> closing;
+    std::thread closer([&closing]
+    {
+        while (closing.waiters() < 3) std::this_thread::yield();
+        closing.close();
+    });
+    assert(syncWait(consumeAll(closing, 3)) == -3);
+    closer.join();
+    assert(closing.isClosed());
+
+    AsyncQueue<int> drained;
+    drained.enqueue(7);
+    drained.close();
+    assert(syncWait(consumeOne(drained)) == 7);
+    assert(syncWait(consumeOne(drained)) == -1);
+    bool threw = false;
+    try { drained.enqueue(8); }
+    catch (const std::logic_error&) { threw = true; }
+    assert(threw);
+}
+
+// Cost per task of fanning out n small computations and gathering their results
+Task<std::uint64_t> fanOut(ThreadPool& pool, int n)
+{
+    std::vector<Task<int>> tasks;
+    tasks.reserve(static_cast<std::size_t>(n));
+    for (int i = 0; i < n; ++i) tasks.push_back(slowSquare(pool, i, std::chrono::milliseconds(0)));
+    const std::vector<int> squares = co_await whenAll(std::move(tasks));
+    co_return std::accumulate(squares.begin(), squares.end(), std::uint64_t{0});
+}
+
+// Exercise 4's queue of packaged tasks, drained by a fixed set of threads, returning the sum of the squares of
+// 0 to n - 1. The queue holds Jobs, each moved from the packaged task of one square
+template<typename Job>
+std::uint64_t drainQueue(int n, unsigned threads)
+{
+    std::uint64_t total = 0;
+    std::mutex mutex;
+    std::condition_variable available;
+    std::deque<Job> queue;
+    bool done = false;
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&]
+        {
+            while (true)
+            {
+                Job task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    available.wait(lock, [&] { return done || !queue.empty(); });
+                    if (queue.empty()) return;
+                    task = std::move(queue.front());
+                    queue.pop_front();
+                }
+                task();
+            }
+        });
+    }
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < n; ++i)
+    {
+        std::packaged_task<int()> task([i] { return i * i; });
+        futures.push_back(task.get_future());
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(std::move(task));
+        }
+        available.notify_one();
+    }
+    for (std::future<int>& future : futures) total += static_cast<std::uint64_t>(future.get());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    available.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    return total;
+}
+
+void benchmark_FanOut(int n)
+{
+    const unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+    auto compute = [](int i) { return i * i; };
+    const auto expected = static_cast<std::uint64_t>(n - 1) * n * (2 * n - 1) / 6;
+    StopWatch watch;
+
+    std::uint64_t total = 0;
+    watch.Start();
+    {
+        std::vector<std::future<int>> futures;
+        for (int i = 0; i < n; ++i) futures.push_back(std::async(std::launch::async, compute, i));
+        for (std::future<int>& future : futures) total += static_cast<std::uint64_t>(future.get());
+    }
+    watch.Stop();
+    assert(total == expected);
+    const auto async = watch.ElapsedTime();
+
+    // The queue holding the packaged tasks themselves, as in Exercise 4
+    watch.Start();
+    total = drainQueue<std::packaged_task<int()>>(n, threads);
+    watch.Stop();
+    assert(total == expected);
+    const auto packaged = watch.ElapsedTime();
+
+    // The same queue holding UniqueFunctions, which take any move-only job, not just a packaged_task<int()>
+    watch.Start();
+    total = drainQueue<UniqueFunction<void ()>>(n, threads);
+    watch.Stop();
+    assert(total == expected);
+    const auto unique = watch.ElapsedTime();
+
+    ThreadPool pool{threads};
+    watch.Start();
+    total = syncWait(fanOut(pool, n));
+    watch.Stop();
+    assert(total == expected);
+    const auto coroutines = watch.ElapsedTime();
+
+    // Elapsed times are in microseconds
+    std::cout << n << "\t\t" << async.count() * 1e3 / n << "\t\t" << packaged.count() * 1e3 / n << "\t\t"
+              << unique.count() * 1e3 / n << "\t\t" << coroutines.count() * 1e3 / n << std::endl;
+}
+
 int main()
 {
     test_PartA();
@@ -509,5 +971,19 @@ int main()
     test_PartD();
     test_Vec();
     test_Matrix();
+    test_PartE();
+
+    test_Task();
+    test_ThreadPool();
+    test_WhenAll();
+    test_WhenAny();
+    test_AsyncGenerator();
+    test_AsyncQueue();
+
+    std::cout << "\nns per task fanned out and gathered" << std::endl;
+    std::cout << "n\t\tstd::async\tpackaged_task\tUniqueFunction\tcoroutines" << std::endl;
+    for (int n : {1'000, 10'000}) benchmark_FanOut(n);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
     return 0;
 }
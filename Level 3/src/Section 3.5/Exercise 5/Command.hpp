@@ -3,18 +3,27 @@
 // are inserted into a priority queue. When finished, a consumer can execute each command
 // at some point in the future.
 //
+// algo is an InplaceFunction, so the copies of a Command that the priority queue and the TimingWheel make
+// carry the lambda without allocating.
+//
+// A Command may carry a delay that stands in for a slow algorithm. Rather than sleeping through it on a
+// Consumer thread, a Consumer with a TimingWheel schedules the ready() copy on the wheel, whose executor puts
+// it back on the queue once the delay is up, so one Consumer can have any number of delayed Commands pending.
+//
 // Created by Michael Lewis on 7/4/23.
 //
 
 #ifndef ADVANCED_CPP_AND_MODERN_DESIGN_COMMAND_HPP
 #define ADVANCED_CPP_AND_MODERN_DESIGN_COMMAND_HPP
 
+#include <chrono>
 #include <iostream>
 #include <functional>
-#include <thread>
 #include <utility>
 
-using FunctionType = std::function<double (double)>;
+#include "InplaceFunction.hpp"
+
+using FunctionType = InplaceFunction<double (double)>;
 using namespace std::chrono_literals;
 
 class Command
@@ -22,14 +31,13 @@ class Command
 private:
     long ID{}; // priority of command
     FunctionType algo;
+    std::chrono::milliseconds wait{}; // simulated running time of the algorithm
 public:
     Command() = default;
-    Command(FunctionType  algorithm, long priority)
-            : algo(std::move(algorithm)), ID(priority){}
+    Command(FunctionType  algorithm, long priority, std::chrono::milliseconds delay = 0ms)
+            : ID(priority), algo(std::move(algorithm)), wait(delay){}
 
     void Execute(double x) {
-        // Introduce delay to simulate a heavy algorithm
-        std::this_thread::sleep_for(5000ms); // Use STL to replace boost
         std::cout << algo(x) << '\n';
     }
 
@@ -37,6 +45,19 @@ public:
     {
         return ID;
     }
+
+    std::chrono::milliseconds delay() const
+    {
+        return wait;
+    }
+
+    // The same Command, to execute as soon as it is dequeued again
+    Command ready() const
+    {
+        Command command = *this;
+        command.wait = 0ms;
+        return command;
+    }
 };
 
 
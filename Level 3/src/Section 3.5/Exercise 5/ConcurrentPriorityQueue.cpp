@@ -37,6 +37,23 @@ ConcurrentPriorityQueue<T, Container, Compare>::ConcurrentPriorityQueue() : prio
 
 }
 
+/**
+ * Overloaded Ctor
+ * @tparam T The data type to be stored in this Concurrent Priority Queue
+ * @tparam Container The type of the underlying container to use to store the elements.
+ * The container must satisfy the requirements of SequenceContainer, and its iterators must
+ * satisfy the requirements of LegacyRandomAccessIterator. The standard containers std::vector
+ * (including std::vector<bool>) and std::deque satisfy these requirements.
+ * @tparam Compare Default comparator that evaluates lhs < rhs
+ * @param container The initial elements, and the allocator the queue grows with, such as a NodeAllocator
+ */
+template<typename T, typename Container, typename Compare>
+ConcurrentPriorityQueue<T, Container, Compare>::ConcurrentPriorityQueue(const Container& container)
+    : priorityQueue(Compare(), container)
+{
+
+}
+
 /**
  * Copy constructor. The underlying container is copy-constructed with source.priorityQueue.
  * @tparam T The data type to be stored in this Concurrent Priority Queue.
@@ -33,6 +33,7 @@ public:
 
 public:
     ConcurrentPriorityQueue();
+    explicit ConcurrentPriorityQueue(const Container& container);
     explicit ConcurrentPriorityQueue(const ConcurrentPriorityQueue<T>& source);
     explicit ConcurrentPriorityQueue(ConcurrentPriorityQueue<T>&& source) noexcept;
     ~ConcurrentPriorityQueue() = default;
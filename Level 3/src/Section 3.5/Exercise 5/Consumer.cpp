@@ -17,6 +17,7 @@
 #include "Consumer.hpp"
 #include "ConcurrentPriorityQueue.hpp"
 #include "Command.hpp"
+#include "TimingWheel.hpp"
 
 /**
  * Overload Ctor.
@@ -27,10 +28,12 @@
  * (including std::vector<bool>) and std::deque satisfy these requirements.
  * @tparam Compare Default comparator that evaluates lhs < rhs.
  * @param queue A ConcurrentPriorityQueue.
+ * @param wheel The TimingWheel that delays Commands, whose executor enqueues onto queue. May be null.
  */
 template<typename T, typename Container, typename Compare>
-Consumer<T, Container, Compare>::Consumer(const std::shared_ptr<ConcurrentPriorityQueue<T, Container, Compare>>& queue)
-        : queue{queue}
+Consumer<T, Container, Compare>::Consumer(const std::shared_ptr<ConcurrentPriorityQueue<T, Container, Compare>>& queue,
+                                          const std::shared_ptr<TimingWheel<T>>& wheel)
+        : queue{queue}, wheel{wheel}
 {
 
 }
@@ -51,7 +54,10 @@ void Consumer<T, Container, Compare>::Consumer::operator()()
             Command command = optionalCommand.value();
             long priority = command.priority();
             if (priority == INTMAX_MAX) break;
-            command.Execute(priority);
+
+            // A delayed Command comes back through the wheel's executor, so the thread is free in the meantime
+            if (wheel && command.delay() > 0ms) wheel->schedule(command.ready(), command.delay());
+            else command.Execute(priority);
         }
         std::this_thread::yield(); // Make sure we can be interrupted
     }
@@ -6,6 +6,9 @@
 // @Note - This Consumer is specialized for a Command object. It is not CopyConstructible,
 // CopyAssignable, or MoveAssignable. It is, however, MoveConstructible to comply with the std::thread protocol.
 //
+// A Consumer given a TimingWheel hands each delayed Command to the wheel instead of blocking on it, and executes
+// the Command when the wheel's executor puts it back on the queue. Without a wheel, delays are ignored.
+//
 // Created by Michael Lewis on 7/6/23.
 //
 
@@ -15,6 +18,7 @@
 #include <memory>
 
 #include "ConcurrentPriorityQueue.hpp"
+#include "TimingWheel.hpp"
 
 template<typename T,
         typename Container = std::vector<T>,
@@ -23,10 +27,12 @@ class Consumer
 {
 private:
     std::shared_ptr<ConcurrentPriorityQueue<T, Container, Compare>> queue;
+    std::shared_ptr<TimingWheel<T>> wheel;
 
 public:
     Consumer() = delete;
-    explicit Consumer(const std::shared_ptr<ConcurrentPriorityQueue<T, Container, Compare>>& queue);
+    explicit Consumer(const std::shared_ptr<ConcurrentPriorityQueue<T, Container, Compare>>& queue,
+                      const std::shared_ptr<TimingWheel<T>>& wheel = nullptr);
     Consumer(const Consumer& source) = delete;
     Consumer(Consumer&& source) noexcept = default;
     ~Consumer() = default;
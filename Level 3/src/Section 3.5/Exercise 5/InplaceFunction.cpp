@@ -0,0 +1,167 @@
+//
+// Construction, assignment and invocation of the in-place function wrappers
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_INPLACEFUNCTION_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_INPLACEFUNCTION_CPP
+
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "InplaceFunction.hpp"
+
+/**
+ * Calls the callable of type F held in a wrapper's storage
+ * @tparam F The callable's type
+ * @param target The wrapper's storage
+ * @param args The arguments of the call
+ * @return The callable's result, converted to R
+ */
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+template<typename F>
+R BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>::invokeTarget(void* target, Args&&... args)
+{
+    if constexpr (std::is_void_v<R>) std::invoke(*static_cast<F*>(target), std::forward<Args>(args)...);
+    else return std::invoke(*static_cast<F*>(target), std::forward<Args>(args)...);
+}
+
+/**
+ * Constructs a callable in the storage of an empty wrapper
+ * @tparam F The callable, decayed to the type that is stored
+ * @param callable The callable; a null function pointer leaves the wrapper empty, as it does std::function
+ */
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+template<typename F>
+void BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>::emplace(F&& callable)
+{
+    using Target = std::decay_t<F>;
+    static_assert(sizeof(Target) <= Capacity, "The callable is larger than the wrapper's capacity");
+    static_assert(Alignment % alignof(Target) == 0, "The callable needs a stricter alignment than the wrapper's");
+    static_assert(std::is_nothrow_move_constructible_v<Target>, "The callable must be nothrow move constructible");
+    static_assert(!Copyable || std::is_copy_constructible_v<Target>,
+                  "InplaceFunction needs a copyable callable; use UniqueFunction for a move-only one");
+
+    if constexpr (std::is_pointer_v<Target> || std::is_member_pointer_v<Target>)
+    {
+        if (callable == nullptr) return;
+    }
+    ::new (static_cast<void*>(storage)) Target(std::forward<F>(callable));
+    operations = &OPERATIONS<Target>;
+}
+
+/**
+ * Overloaded ctor
+ * @param callable Anything callable with Args whose result converts to R
+ * @throws Whatever copying or moving the callable into the wrapper throws
+ */
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+template<typename F>
+requires (!std::same_as<std::remove_cvref_t<F>, BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>>)
+         && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>
+BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>::BasicInplaceFunction(F&& callable)
+    : operations{&EMPTY}
+{
+    emplace(std::forward<F>(callable));
+}
+
+/**
+ * Copy ctor
+ * @param source The wrapper to copy; its callable is copied in place
+ * @throws Whatever copying the callable throws
+ */
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>::BasicInplaceFunction(const BasicInplaceFunction& source)
+requires (Copyable)
+    : operations{&EMPTY}
+{
+    if (!source) return;
+    source.operations->copy(storage, source.storage);
+    operations = source.operations;
+}
+
+/**
+ * Move ctor
+ * @param source The wrapper to move from, which is left empty
+ */
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>::BasicInplaceFunction(BasicInplaceFunction&& source) noexcept
+    : operations{std::exchange(source.operations, &EMPTY)}
+{
+    operations->relocate(storage, source.storage);
+}
+
+/**
+ * Copy assignment operator
+ * @param source The wrapper to copy
+ * @return This wrapper, unchanged if copying the callable throws
+ */
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>&
+BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>::operator=(const BasicInplaceFunction& source)
+requires (Copyable)
+{
+    if (this != &source) *this = BasicInplaceFunction(source);
+    return *this;
+}
+
+/**
+ * Move assignment operator
+ * @param source The wrapper to move from, which is left empty
+ * @return This wrapper
+ */
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>&
+BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>::operator=(BasicInplaceFunction&& source) noexcept
+{
+    if (this == &source) return *this;
+    operations->destroy(storage);
+    operations = std::exchange(source.operations, &EMPTY);
+    operations->relocate(storage, source.storage);
+    return *this;
+}
+
+/**
+ * Empties the wrapper
+ * @return This wrapper
+ */
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>&
+BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>::operator=(std::nullptr_t) noexcept
+{
+    operations->destroy(storage);
+    operations = &EMPTY;
+    return *this;
+}
+
+/**
+ * @param callable Anything callable with Args whose result converts to R
+ * @return This wrapper, unchanged if constructing the callable throws
+ */
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+template<typename F>
+requires (!std::same_as<std::remove_cvref_t<F>, BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>>)
+         && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>
+BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>&
+BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>::operator=(F&& callable)
+{
+    return *this = BasicInplaceFunction(std::forward<F>(callable));
+}
+
+/**
+ * Exchanges the callables of two wrappers
+ * @param other The other wrapper
+ */
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+void BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>::swap(BasicInplaceFunction& other) noexcept
+{
+    if (this == &other) return;
+    BasicInplaceFunction held(std::move(other));
+    other = std::move(*this);
+    *this = std::move(held);
+}
+
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_INPLACEFUNCTION_CPP
@@ -0,0 +1,480 @@
+//
+// Placement, cascading and expiry of the hierarchical timing wheel, and its timer thread
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TIMINGWHEEL_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_TIMINGWHEEL_CPP
+
+#include <algorithm>
+#include <bit>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "TimingWheel.hpp"
+
+/**
+ * Overloaded ctor: an empty wheel whose tick 0 starts at origin
+ * @tparam T The type of the values scheduled
+ * @param executor Called with each expired value
+ * @param resolution The length of a tick
+ * @param origin The start of tick 0
+ * @throws std::invalid_argument if the resolution is not positive
+ */
+template<typename T>
+TimingWheel<T>::TimingWheel(Executor executor, Clock::duration resolution, Clock::time_point origin)
+    : nodes{}, freeNodes{}, heads{}, occupied{}, current{0}, count{0}, resolution{resolution}, origin{origin},
+      executor{std::move(executor)}, mutex{}, wakeUp{}, timerThread{}, running{false}, wakeTick{NEVER}
+{
+    if (resolution <= Clock::duration::zero())
+        throw std::invalid_argument("The resolution of a timing wheel must be positive, not " + std::to_string(resolution.count()));
+    heads.fill(NONE);
+}
+
+/**
+ * Dtor: stops the timer thread if it runs. Timers still pending are dropped without being executed.
+ * @tparam T The type of the values scheduled
+ */
+template<typename T>
+TimingWheel<T>::~TimingWheel()
+{
+    stop();
+}
+
+/**
+ * @tparam T The type of the values scheduled
+ * @param time A point in time
+ * @return The first tick that starts no earlier than time
+ */
+template<typename T>
+std::uint64_t TimingWheel<T>::ticksUntil(Clock::time_point time) const noexcept
+{
+    if (time <= origin) return 0;
+    return ticksOf(time - origin);
+}
+
+/**
+ * @tparam T The type of the values scheduled
+ * @param duration A non-negative duration
+ * @return The duration in ticks, rounded up
+ */
+template<typename T>
+std::uint64_t TimingWheel<T>::ticksOf(Clock::duration duration) const noexcept
+{
+    const auto ticks = duration / resolution;
+    return static_cast<std::uint64_t>(ticks) + (duration % resolution != Clock::duration::zero() ? 1 : 0);
+}
+
+/**
+ * The slot of a deadline: the finest level whose span covers the distance to the deadline, at the deadline's
+ * digit in that level. Deadlines further than SPAN are placed at SPAN, and placed again when they move down.
+ * @tparam T The type of the values scheduled
+ * @param deadline A tick no earlier than current
+ * @return level * SLOTS + slot
+ */
+template<typename T>
+std::uint32_t TimingWheel<T>::slotOf(std::uint64_t deadline) const noexcept
+{
+    std::uint64_t distance = deadline - current;
+    if (distance > SPAN)
+    {
+        distance = SPAN;
+        deadline = current + SPAN;
+    }
+    const std::size_t level = (std::bit_width(distance | 1) - 1) / SLOT_BITS;
+    return static_cast<std::uint32_t>(level * SLOTS + ((deadline >> (level * SLOT_BITS)) & MASK));
+}
+
+/**
+ * @tparam T The type of the values scheduled
+ * @param level A level of the wheel
+ * @param from A slot of that level
+ * @return The number of slots from that slot, itself included, to the next non-empty slot of the level,
+ * wrapping around; SLOTS if the level is empty
+ */
+template<typename T>
+std::size_t TimingWheel<T>::distanceToOccupied(std::size_t level, std::size_t from) const noexcept
+{
+    constexpr std::size_t WORDS = SLOTS / 64;
+    const std::uint64_t* bits = occupied.data() + level * WORDS;
+    const std::size_t first = from / 64;
+    for (std::size_t step = 0; step <= WORDS; ++step)
+    {
+        const std::size_t word = (first + step) % WORDS;
+        std::uint64_t mask = bits[word];
+        if (step == 0) mask &= ~std::uint64_t{0} << (from % 64);
+        else if (step == WORDS) mask &= (std::uint64_t{1} << (from % 64)) - 1;
+        if (mask != 0) return (word * 64 + std::countr_zero(mask) - from) & MASK;
+    }
+    return SLOTS;
+}
+
+/**
+ * The next tick at which the wheel has work: a non-empty slot of level 0 falling due, or a non-empty slot of
+ * a coarser level whose timers move down. Ticks in between can be skipped.
+ * @tparam T The type of the values scheduled
+ * @return The tick, no earlier than current, or NEVER if the wheel is empty
+ */
+template<typename T>
+std::uint64_t TimingWheel<T>::nextEventTick() const noexcept
+{
+    if (count == 0) return NEVER;
+    std::uint64_t next = NEVER;
+    const std::size_t distance = distanceToOccupied(0, current & MASK);
+    if (distance < SLOTS) next = current + distance;
+    for (std::size_t level = 1; level < LEVELS; ++level)
+    {
+        // A coarser slot moves down when current reaches its start; current's own slot is due only if current
+        // is that start, and otherwise holds timers of the next turn of the level
+        const std::size_t shift = level * SLOT_BITS;
+        const std::uint64_t turn = current >> shift;
+        const bool atStart = (current & ((std::uint64_t{1} << shift) - 1)) == 0;
+        const std::size_t from = atStart ? (turn & MASK) : ((turn + 1) & MASK);
+        const std::size_t ahead = distanceToOccupied(level, from);
+        if (ahead == SLOTS) continue;
+        next = std::min(next, (turn + ahead + (atStart ? 0 : 1)) << shift);
+    }
+    return next;
+}
+
+/**
+ * Puts a node at the front of the list of the slot of its deadline
+ * @tparam T The type of the values scheduled
+ * @param index The node, on no list
+ */
+template<typename T>
+void TimingWheel<T>::link(std::uint32_t index) noexcept
+{
+    Node& node = nodes[index];
+    const std::uint32_t slot = slotOf(node.deadline);
+    node.slot = slot;
+    node.previous = NONE;
+    node.next = heads[slot];
+    if (node.next != NONE) nodes[node.next].previous = index;
+    heads[slot] = index;
+    occupied[slot / 64] |= std::uint64_t{1} << (slot % 64);
+}
+
+/**
+ * Takes a node off the list of its slot
+ * @tparam T The type of the values scheduled
+ * @param index The node, on a list
+ */
+template<typename T>
+void TimingWheel<T>::unlink(std::uint32_t index) noexcept
+{
+    Node& node = nodes[index];
+    if (node.previous == NONE) heads[node.slot] = node.next;
+    else nodes[node.previous].next = node.next;
+    if (node.next != NONE) nodes[node.next].previous = node.previous;
+    if (heads[node.slot] == NONE) occupied[node.slot / 64] &= ~(std::uint64_t{1} << (node.slot % 64));
+}
+
+/**
+ * Empties a slot
+ * @tparam T The type of the values scheduled
+ * @param slot level * SLOTS + slot
+ * @return The first node of the list the slot held, or NONE
+ */
+template<typename T>
+std::uint32_t TimingWheel<T>::detach(std::uint32_t slot) noexcept
+{
+    const std::uint32_t first = heads[slot];
+    heads[slot] = NONE;
+    occupied[slot / 64] &= ~(std::uint64_t{1} << (slot % 64));
+    return first;
+}
+
+/**
+ * Frees a node that is on no list
+ * @tparam T The type of the values scheduled
+ * @param index The node
+ */
+template<typename T>
+void TimingWheel<T>::release(std::uint32_t index)
+{
+    Node& node = nodes[index];
+    node.value.reset();
+    node.slot = NONE;
+    ++node.generation;
+    freeNodes.push_back(index);
+    --count;
+}
+
+/**
+ * Processes tick current: moves down the coarser slots that start at it, then expires its slot of level 0.
+ * A periodic timer is placed again one period later.
+ * @tparam T The type of the values scheduled
+ * @param ready Receives the expired values
+ */
+template<typename T>
+void TimingWheel<T>::processTick(std::vector<T>& ready)
+{
+    for (std::size_t level = 1; level < LEVELS; ++level)
+    {
+        const std::size_t shift = level * SLOT_BITS;
+        if ((current & ((std::uint64_t{1} << shift) - 1)) != 0) break;
+        std::uint32_t index = detach(static_cast<std::uint32_t>(level * SLOTS + ((current >> shift) & MASK)));
+        while (index != NONE)
+        {
+            const std::uint32_t next = nodes[index].next;
+            link(index);
+            index = next;
+        }
+    }
+
+    std::uint32_t index = detach(static_cast<std::uint32_t>(current & MASK));
+    while (index != NONE)
+    {
+        Node& node = nodes[index];
+        const std::uint32_t next = node.next;
+        if (node.deadline > current) link(index);
+        else if (node.period == 0)
+        {
+            ready.push_back(std::move(*node.value));
+            release(index);
+        }
+        else
+        {
+            if constexpr (std::is_copy_constructible_v<T>) ready.push_back(*node.value);
+            node.deadline += node.period;
+            link(index);
+        }
+        index = next;
+    }
+}
+
+/**
+ * The timer thread: sleeps until the next event, a schedule() that comes earlier, or stop()
+ * @tparam T The type of the values scheduled
+ */
+template<typename T>
+void TimingWheel<T>::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running)
+    {
+        wakeTick = nextEventTick();
+        if (wakeTick == NEVER) wakeUp.wait(lock);
+        else wakeUp.wait_until(lock, origin + resolution * static_cast<Clock::rep>(wakeTick));
+        if (!running) break;
+
+        lock.unlock();
+        try
+        {
+            advance(Clock::now());
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+        }
+        lock.lock();
+    }
+    wakeTick = NEVER;
+}
+
+/**
+ * @tparam T The type of the values scheduled
+ * @return The number of timers pending, periodic timers included
+ */
+template<typename T>
+std::size_t TimingWheel<T>::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+}
+
+/**
+ * @tparam T The type of the values scheduled
+ * @param handle A handle returned by schedule()
+ * @return Whether its timer is pending: not cancelled, and not expired unless it is periodic
+ */
+template<typename T>
+bool TimingWheel<T>::contains(Handle handle) const
+{
+    const auto index = static_cast<std::uint32_t>(handle);
+    const auto generation = static_cast<std::uint32_t>(handle >> 32);
+    std::lock_guard<std::mutex> lock(mutex);
+    return index < nodes.size() && nodes[index].slot != NONE && nodes[index].generation == generation;
+}
+
+/**
+ * The time at which an event loop should next call advance(). It may come before the next expiry, when
+ * timers move down a level, and advance() then simply expires nothing.
+ * @tparam T The type of the values scheduled
+ * @return The start of the next tick with work, or nothing if no timer is pending
+ */
+template<typename T>
+std::optional<typename TimingWheel<T>::Clock::time_point> TimingWheel<T>::nextEvent() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::uint64_t tick = nextEventTick();
+    if (tick == NEVER) return std::nullopt;
+    return origin + resolution * static_cast<Clock::rep>(tick);
+}
+
+/**
+ * Schedules a value to be executed after a delay from now, and then every period if there is one
+ * @tparam T The type of the values scheduled
+ * @param value The value handed to the executor
+ * @param delay The delay; zero or negative means at the first tick not processed yet
+ * @param period The time between expiries of a periodic timer, zero for a one-shot timer
+ * @return The handle of the timer
+ * @throws std::invalid_argument if the period is negative, or positive for a value that cannot be copied
+ */
+template<typename T>
+typename TimingWheel<T>::Handle TimingWheel<T>::schedule(T value, Clock::duration delay, Clock::duration period)
+{
+    return scheduleAt(std::move(value), Clock::now() + delay, period);
+}
+
+/**
+ * Schedules a value to be executed at a point in time, and then every period if there is one. The value is
+ * executed by the first advance() at or after the start of the first tick that starts no earlier than deadline.
+ * @tparam T The type of the values scheduled
+ * @param value The value handed to the executor
+ * @param deadline The point in time; one in the past means at the first tick not processed yet
+ * @param period The time between expiries of a periodic timer, zero for a one-shot timer
+ * @return The handle of the timer
+ * @throws std::invalid_argument if the period is negative, or positive for a value that cannot be copied
+ * @throws std::length_error if every handle is in use
+ */
+template<typename T>
+typename TimingWheel<T>::Handle TimingWheel<T>::scheduleAt(T value, Clock::time_point deadline, Clock::duration period)
+{
+    if (period < Clock::duration::zero())
+        throw std::invalid_argument("The period of a timer cannot be negative: " + std::to_string(period.count()));
+    if (!std::is_copy_constructible_v<T> && period > Clock::duration::zero())
+        throw std::invalid_argument("A periodic timer must be able to copy its value");
+
+    bool earlier;
+    Handle handle;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::uint32_t index;
+        if (!freeNodes.empty())
+        {
+            index = freeNodes.back();
+            freeNodes.pop_back();
+        }
+        else
+        {
+            if (nodes.size() >= NONE) throw std::length_error("Every handle of the timing wheel is in use");
+            index = static_cast<std::uint32_t>(nodes.size());
+            nodes.push_back(Node{std::nullopt, 0, 0, NONE, NONE, NONE, 0});
+        }
+
+        Node& node = nodes[index];
+        node.value.emplace(std::move(value));
+        node.deadline = std::max(current, ticksUntil(deadline));
+        node.period = ticksOf(period);
+        link(index);
+        ++count;
+
+        earlier = running && node.deadline < wakeTick;
+        handle = (static_cast<Handle>(node.generation) << 32) | index;
+    }
+    if (earlier) wakeUp.notify_one();
+    return handle;
+}
+
+/**
+ * Cancels a timer in O(1). A periodic timer can cancel itself from the executor.
+ * @tparam T The type of the values scheduled
+ * @param handle A handle returned by schedule()
+ * @return Whether the timer was pending; false if it expired, was cancelled already, or is from another wheel
+ */
+template<typename T>
+bool TimingWheel<T>::cancel(Handle handle)
+{
+    const auto index = static_cast<std::uint32_t>(handle);
+    const auto generation = static_cast<std::uint32_t>(handle >> 32);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index >= nodes.size() || nodes[index].slot == NONE || nodes[index].generation != generation) return false;
+    unlink(index);
+    release(index);
+    return true;
+}
+
+/**
+ * Processes every tick that started by now, skipping those without work, then hands the expired values to
+ * the executor in order of deadline. A periodic timer that missed several periods expires once for each.
+ * @tparam T The type of the values scheduled
+ * @param now The current time
+ * @return The number of values executed
+ * @throws Whatever the executor throws; the values after the one that threw are dropped
+ */
+template<typename T>
+std::size_t TimingWheel<T>::advance(Clock::time_point now)
+{
+    std::vector<T> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (now < origin) return 0;
+        const auto target = static_cast<std::uint64_t>((now - origin) / resolution);
+        while (current <= target)
+        {
+            const std::uint64_t next = nextEventTick();
+            if (next > target)
+            {
+                current = target + 1;
+                break;
+            }
+            current = next;
+            processTick(ready);
+            ++current;
+        }
+    }
+
+    for (T& value : ready) executor(std::move(value));
+    return ready.size();
+}
+
+/**
+ * @tparam T The type of the values scheduled
+ * @param capacity The number of timers to make room for
+ */
+template<typename T>
+void TimingWheel<T>::reserve(std::size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    nodes.reserve(capacity);
+    freeNodes.reserve(capacity);
+}
+
+/**
+ * Starts the timer thread, which calls advance() whenever a tick with work starts. The executor then runs on
+ * that thread, so it should be short, such as putting the value on a queue.
+ * @tparam T The type of the values scheduled
+ * @throws std::logic_error if the timer thread runs already
+ */
+template<typename T>
+void TimingWheel<T>::start()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running) throw std::logic_error("The timer thread of the timing wheel runs already");
+    running = true;
+    timerThread = std::thread(&TimingWheel::run, this);
+}
+
+/**
+ * Stops and joins the timer thread, if it runs. Must not be called from the executor.
+ * @tparam T The type of the values scheduled
+ */
+template<typename T>
+void TimingWheel<T>::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    wakeUp.notify_one();
+    if (timerThread.joinable()) timerThread.join();
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_TIMINGWHEEL_CPP
@@ -0,0 +1,130 @@
+//
+// A hierarchical timing wheel for delayed and periodic work. Putting a Command in the ConcurrentPriorityQueue
+// runs it as soon as a Consumer is free, so the only way to run it later is to sleep on some thread; with
+// hundreds of thousands of order expiries and heartbeats that is a thread, or a heap operation, per timeout.
+//
+// Time is cut into ticks of a fixed resolution. The wheel has LEVELS levels of SLOTS slots each: a slot of
+// level 0 holds the timers of one tick, a slot of level 1 those of SLOTS ticks, and so on, so four levels of
+// 256 slots reach 2^32 ticks, 49 days at 1 ms. A timer goes into the finest level whose span covers its
+// deadline, and when time reaches the start of a coarser slot its timers move down a level. Each slot is an
+// intrusive doubly linked list, so schedule() and cancel() are O(1), a timer moves down at most LEVELS - 1
+// times, and the timers of a tick expire together. A bitmap of the non-empty slots lets advance() jump over
+// idle ticks and tells a timer thread how long it can sleep. Timers are never early and at most one tick late.
+//
+// Timers live in a vector with free entries reused. A Handle is the timer's index together with a generation
+// that changes when the entry is freed, so the handle of a timer that expired or was cancelled matches nothing.
+//
+// Expired values are handed to the executor, a one-shot's by move and a periodic timer's by copy, after the
+// wheel's lock is released: the executor may schedule and cancel, and it is typically a queue's enqueue so
+// that Consumers do the work. Drive the wheel either from an event loop, by calling advance() at nextEvent(),
+// or by start(), which runs one timer thread that sleeps until the next event. Not both.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TIMINGWHEEL_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_TIMINGWHEEL_HPP
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+template<typename T>
+class TimingWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Handle = std::uint64_t;
+    using Executor = std::function<void (T)>;
+
+    static constexpr std::size_t LEVELS = 4;
+    static constexpr std::size_t SLOT_BITS = 8;
+    static constexpr std::size_t SLOTS = std::size_t{1} << SLOT_BITS;
+    static constexpr std::uint64_t SPAN = (std::uint64_t{1} << (LEVELS * SLOT_BITS)) - 1; // Furthest deadline, in ticks, placed directly
+
+private:
+    static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint64_t NEVER = std::numeric_limits<std::uint64_t>::max();
+    static constexpr std::uint64_t MASK = SLOTS - 1;
+
+    struct Node
+    {
+        std::optional<T> value;
+        std::uint64_t deadline;         // Tick at which the timer expires
+        std::uint64_t period;           // Ticks between expiries, 0 for a one-shot timer
+        std::uint32_t next;
+        std::uint32_t previous;
+        std::uint32_t slot;             // level * SLOTS + slot of the list holding the node, NONE if it is free
+        std::uint32_t generation;       // Changes when the node is freed
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> freeNodes;
+    std::array<std::uint32_t, LEVELS * SLOTS> heads;
+    std::array<std::uint64_t, LEVELS * SLOTS / 64> occupied;   // One bit per non-empty slot
+    std::uint64_t current;              // The next tick to process
+    std::size_t count;
+    Clock::duration resolution;
+    Clock::time_point origin;           // The start of tick 0
+    Executor executor;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::thread timerThread;
+    bool running;
+    std::uint64_t wakeTick;             // The tick the timer thread sleeps until
+
+    std::uint64_t ticksUntil(Clock::time_point time) const noexcept;
+    std::uint64_t ticksOf(Clock::duration duration) const noexcept;
+    std::uint32_t slotOf(std::uint64_t deadline) const noexcept;
+    std::size_t distanceToOccupied(std::size_t level, std::size_t from) const noexcept;
+    std::uint64_t nextEventTick() const noexcept;
+    void link(std::uint32_t index) noexcept;
+    void unlink(std::uint32_t index) noexcept;
+    std::uint32_t detach(std::uint32_t slot) noexcept;
+    void release(std::uint32_t index);
+    void processTick(std::vector<T>& ready);
+    void run();
+
+public:
+    explicit TimingWheel(Executor executor, Clock::duration resolution = std::chrono::milliseconds{1},
+                         Clock::time_point origin = Clock::now());
+    TimingWheel(const TimingWheel& source) = delete;
+    TimingWheel(TimingWheel&& source) noexcept = delete;
+    ~TimingWheel();
+
+    // Operator overloads
+    TimingWheel& operator=(const TimingWheel& source) = delete;
+    TimingWheel& operator=(TimingWheel&& source) noexcept = delete;
+
+    // Accessors
+    std::size_t size() const;
+    bool empty() const { return size() == 0; }
+    bool contains(Handle handle) const;
+    Clock::duration tick() const noexcept { return resolution; }
+    std::optional<Clock::time_point> nextEvent() const;
+
+    // Core functionality
+    Handle schedule(T value, Clock::duration delay, Clock::duration period = Clock::duration::zero());
+    Handle scheduleAt(T value, Clock::time_point deadline, Clock::duration period = Clock::duration::zero());
+    bool cancel(Handle handle);
+    std::size_t advance(Clock::time_point now = Clock::now());
+    void reserve(std::size_t capacity);
+    void start();
+    void stop();
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TIMINGWHEEL_CPP
+#include "TimingWheel.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_TIMINGWHEEL_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_TIMINGWHEEL_HPP
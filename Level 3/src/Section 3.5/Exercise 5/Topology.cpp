@@ -0,0 +1,263 @@
+//
+// Discovery of the processor topology from sysfs
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#include "Topology.hpp"
+
+namespace
+{
+    /**
+     * @param path A sysfs attribute
+     * @return Its first line, or an empty string if it cannot be read
+     */
+    std::string readLine(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        std::string line;
+        if (file) std::getline(file, line);
+        return line;
+    }
+
+    /**
+     * @param path A sysfs attribute holding an unsigned number
+     * @param fallback The value if it cannot be read
+     * @return The number
+     */
+    unsigned readNumber(const std::filesystem::path& path, unsigned fallback)
+    {
+        const std::string line = readLine(path);
+        try
+        {
+            return line.empty() ? fallback : static_cast<unsigned>(std::stoul(line));
+        }
+        catch (const std::exception&)
+        {
+            return fallback;
+        }
+    }
+
+    /**
+     * @param text A cache size such as 48K, 2048K or 300M
+     * @return The size in bytes, 0 if it cannot be parsed
+     */
+    std::size_t parseSize(const std::string& text)
+    {
+        std::size_t end = 0;
+        std::size_t bytes;
+        try
+        {
+            bytes = std::stoul(text, &end);
+        }
+        catch (const std::exception&)
+        {
+            return 0;
+        }
+        if (end < text.size())
+        {
+            switch (text[end])
+            {
+                case 'K': bytes <<= 10; break;
+                case 'M': bytes <<= 20; break;
+                case 'G': bytes <<= 30; break;
+                default: break;
+            }
+        }
+        return bytes;
+    }
+}
+
+/**
+ * Overloaded ctor
+ * @param logical The logical CPUs, in any order
+ * @param shared The caches, in any order
+ */
+Topology::Topology(std::vector<LogicalCpu> logical, std::vector<Cache> shared)
+    : logical{std::move(logical)}, shared{std::move(shared)}, numaNodes{}
+{
+    std::sort(this->logical.begin(), this->logical.end(), [](const LogicalCpu& lhs, const LogicalCpu& rhs) { return lhs.id < rhs.id; });
+    std::sort(this->shared.begin(), this->shared.end(), [](const Cache& lhs, const Cache& rhs)
+    {
+        return std::tie(lhs.level, lhs.type, lhs.cpus) < std::tie(rhs.level, rhs.type, rhs.cpus);
+    });
+    std::set<unsigned> nodes;
+    for (const LogicalCpu& cpu : this->logical) nodes.insert(cpu.node);
+    numaNodes.assign(nodes.begin(), nodes.end());
+}
+
+/**
+ * @param id A logical CPU
+ * @return Where it sits
+ * @throws std::invalid_argument if the machine has no such CPU online
+ */
+const LogicalCpu& Topology::cpu(unsigned id) const
+{
+    const auto found = std::lower_bound(logical.begin(), logical.end(), id, [](const LogicalCpu& cpu, unsigned value) { return cpu.id < value; });
+    if (found == logical.end() || found->id != id) throw std::invalid_argument("There is no online CPU " + std::to_string(id));
+    return *found;
+}
+
+/**
+ * @return The number of physical cores
+ */
+std::size_t Topology::cores() const
+{
+    std::set<std::pair<unsigned, unsigned>> distinct;
+    for (const LogicalCpu& cpu : logical) distinct.emplace(cpu.package, cpu.core);
+    return distinct.size();
+}
+
+/**
+ * @return The number of packages, or sockets
+ */
+std::size_t Topology::packages() const
+{
+    std::set<unsigned> distinct;
+    for (const LogicalCpu& cpu : logical) distinct.insert(cpu.package);
+    return distinct.size();
+}
+
+/**
+ * Reads the topology of the online CPUs
+ * @param root The directory holding cpu/ and node/, normally /sys/devices/system
+ * @return The topology, or a flat one if root/cpu/online cannot be read
+ */
+Topology Topology::discover(const std::string& root)
+{
+    namespace fs = std::filesystem;
+    const fs::path base{root};
+    const std::vector<unsigned> online = parseCpuList(readLine(base / "cpu" / "online"));
+    if (online.empty()) return flat(std::max(1u, std::thread::hardware_concurrency()));
+
+    // The node of each CPU; a kernel without NUMA support has no node directory and one node
+    std::map<unsigned, unsigned> nodeOf;
+    std::error_code error;
+    for (const fs::directory_entry& entry : fs::directory_iterator(base / "node", error))
+    {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 || !std::all_of(name.begin() + 4, name.end(), ::isdigit)) continue;
+        const auto node = static_cast<unsigned>(std::stoul(name.substr(4)));
+        for (unsigned id : parseCpuList(readLine(entry.path() / "cpulist"))) nodeOf[id] = node;
+    }
+
+    std::vector<LogicalCpu> logical;
+    std::map<std::tuple<unsigned, std::string, std::vector<unsigned>>, std::size_t> seen;
+    std::vector<Cache> shared;
+    for (unsigned id : online)
+    {
+        const fs::path cpu = base / "cpu" / ("cpu" + std::to_string(id));
+        const std::vector<unsigned> siblings = parseCpuList(readLine(cpu / "topology" / "thread_siblings_list"));
+        const auto rank = std::find(siblings.begin(), siblings.end(), id);
+        logical.push_back(LogicalCpu{id, readNumber(cpu / "topology" / "core_id", id),
+                                     readNumber(cpu / "topology" / "physical_package_id", 0),
+                                     nodeOf.count(id) ? nodeOf[id] : 0,
+                                     rank == siblings.end() ? 0 : static_cast<unsigned>(rank - siblings.begin())});
+
+        for (unsigned index = 0; fs::exists(cpu / "cache" / ("index" + std::to_string(index))); ++index)
+        {
+            const fs::path cache = cpu / "cache" / ("index" + std::to_string(index));
+            Cache entry{readNumber(cache / "level", 0), readLine(cache / "type"), parseSize(readLine(cache / "size")),
+                        parseCpuList(readLine(cache / "shared_cpu_list"))};
+            if (entry.cpus.empty()) entry.cpus.push_back(id);
+            auto key = std::make_tuple(entry.level, entry.type, entry.cpus);
+            if (seen.emplace(std::move(key), shared.size()).second) shared.push_back(std::move(entry));
+        }
+    }
+    return Topology{std::move(logical), std::move(shared)};
+}
+
+/**
+ * @param cpus The number of logical CPUs
+ * @return A machine of that many single-threaded cores in one package on node 0, without caches
+ * @throws std::invalid_argument if there are none
+ */
+Topology Topology::flat(unsigned cpus)
+{
+    if (cpus == 0) throw std::invalid_argument("A machine needs at least one CPU");
+    std::vector<LogicalCpu> logical;
+    for (unsigned id = 0; id < cpus; ++id) logical.push_back(LogicalCpu{id, id, 0, 0, 0});
+    return Topology{std::move(logical), {}};
+}
+
+/**
+ * @param list A kernel CPU list such as 0-3,8,10-11
+ * @return The CPUs it names, in ascending order
+ * @throws std::invalid_argument if it is malformed
+ */
+std::vector<unsigned> Topology::parseCpuList(const std::string& list)
+{
+    std::set<unsigned> cpus;
+    std::stringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ','))
+    {
+        range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+        if (range.empty()) continue;
+        const std::size_t dash = range.find('-');
+        try
+        {
+            const auto first = static_cast<unsigned>(std::stoul(range.substr(0, dash)));
+            const auto last = dash == std::string::npos ? first : static_cast<unsigned>(std::stoul(range.substr(dash + 1)));
+            if (last < first) throw std::invalid_argument(range);
+            for (unsigned cpu = first; cpu <= last; ++cpu) cpus.insert(cpu);
+        }
+        catch (const std::exception&)
+        {
+            throw std::invalid_argument("Malformed CPU list: " + list);
+        }
+    }
+    return {cpus.begin(), cpus.end()};
+}
+
+/**
+ * @param allowed The CPUs to keep, such as Placement::allowedCpus()
+ * @return The machine with only those of its CPUs and the caches they use; the whole machine if it has none
+ * of them, or if allowed is empty
+ */
+Topology Topology::restrictedTo(const std::vector<unsigned>& allowed) const
+{
+    auto keep = [&allowed](unsigned id) { return std::find(allowed.begin(), allowed.end(), id) != allowed.end(); };
+    std::vector<LogicalCpu> kept;
+    for (const LogicalCpu& cpu : logical)
+    {
+        if (keep(cpu.id)) kept.push_back(cpu);
+    }
+    if (kept.empty()) return *this;
+
+    std::vector<Cache> used;
+    for (const Cache& cache : shared)
+    {
+        if (std::any_of(cache.cpus.begin(), cache.cpus.end(), keep)) used.push_back(cache);
+    }
+    return Topology{std::move(kept), std::move(used)};
+}
+
+/**
+ * @return A summary of the machine: CPUs, cores, packages, nodes and the caches of CPU 0
+ */
+std::string Topology::describe() const
+{
+    std::ostringstream out;
+    out << logical.size() << " logical CPU(s), " << cores() << " core(s), " << packages() << " package(s), "
+        << numaNodes.size() << " NUMA node(s)";
+    for (const Cache& cache : shared)
+    {
+        if (std::find(cache.cpus.begin(), cache.cpus.end(), logical.front().id) == cache.cpus.end()) continue;
+        out << "\n  L" << cache.level << ' ' << cache.type << ' ' << (cache.bytes >> 10) << " KiB shared by "
+            << cache.cpus.size() << " CPU(s)";
+    }
+    return out.str();
+}
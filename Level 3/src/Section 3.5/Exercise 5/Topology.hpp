@@ -0,0 +1,72 @@
+//
+// The machine's processor topology as Linux describes it under /sys/devices/system: each online logical CPU
+// with its core, package and NUMA node, its rank among the SMT siblings of its core, and every cache with the
+// CPUs sharing it. Placement uses it to decide which CPU each thread runs on.
+//
+// discover() reads the tree from a root that tests may point at a copy; where there is no such tree it falls
+// back to a flat machine of std::thread::hardware_concurrency() CPUs, each its own core on node 0.
+// restrictedTo() keeps only the CPUs a process may run on, such as those of its affinity mask.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TOPOLOGY_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_TOPOLOGY_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct LogicalCpu
+{
+    unsigned id;
+    unsigned core;          // core_id, unique only within its package
+    unsigned package;
+    unsigned node;
+    unsigned thread;        // Its rank among the SMT siblings of its core, 0 for the first
+};
+
+struct Cache
+{
+    unsigned level;
+    std::string type;               // Data, Instruction or Unified
+    std::size_t bytes;
+    std::vector<unsigned> cpus;     // The logical CPUs sharing it
+};
+
+class Topology
+{
+private:
+    std::vector<LogicalCpu> logical;        // Ordered by id
+    std::vector<Cache> shared;              // Each cache once, ordered by level
+    std::vector<unsigned> numaNodes;
+
+    Topology(std::vector<LogicalCpu> logical, std::vector<Cache> shared);
+
+public:
+    Topology() = delete;
+    Topology(const Topology& source) = default;
+    Topology(Topology&& source) noexcept = default;
+    ~Topology() = default;
+
+    // Operator overloads
+    Topology& operator=(const Topology& source) = default;
+    Topology& operator=(Topology&& source) noexcept = default;
+
+    // Accessors
+    const std::vector<LogicalCpu>& cpus() const noexcept { return logical; }
+    const std::vector<Cache>& caches() const noexcept { return shared; }
+    const std::vector<unsigned>& nodes() const noexcept { return numaNodes; }
+    const LogicalCpu& cpu(unsigned id) const;
+    std::size_t cores() const;
+    std::size_t packages() const;
+
+    // Core functionality
+    static Topology discover(const std::string& root = "/sys/devices/system");
+    static Topology flat(unsigned cpus);
+    static std::vector<unsigned> parseCpuList(const std::string& list);
+    Topology restrictedTo(const std::vector<unsigned>& allowed) const;
+    std::string describe() const;
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_TOPOLOGY_HPP
@@ -3,61 +3,527 @@
 // Producers push Commands to a ConcurrentPriorityQueue and Consumers pop the Commands from
 // the queue for execution.
 //
+// Delayed and periodic Commands go through a TimingWheel instead of a thread that sleeps per Command. Tests
+// check one-shot, periodic and cancelled timers at exact ticks, random schedules and cancellations against a
+// std::multimap, and the timer thread. The benchmark reports nanoseconds per order expiry, half of them
+// cancelled, next to a std::priority_queue with lazy cancellation and a std::multimap. The demo then runs
+// the Consumers with one timer thread publishing a Command per second for each of the former Producers; the
+// Consumers are pinned by the placement policy given on the command line - compact, scatter, unpinned or a CPU
+// list - and the queue's heap is allocated on the NUMA node of the first Consumer.
+//
 // Created by Michael Lewis on 7/4/23.
 //
 
+#include <algorithm>
+#include <cctype>
+#include <array>
 #include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "Command.hpp"
 #include "Consumer.hpp"
 #include "ConcurrentPriorityQueue.hpp"
-#include "Producer.hpp"
+#include "NodeAllocator.hpp"
+#include "Placement.hpp"
+#include "StopWatch.hpp"
+#include "TimingWheel.hpp"
+#include "Topology.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+std::uint64_t sink = 0;
+
+// One-shot timers expire at the first tick that starts no earlier than their deadline, and not before
+void test_OneShot()
+{
+    const Clock::time_point start = Clock::now();
+    std::vector<int> fired;
+    TimingWheel<int> wheel([&fired](int value) { fired.push_back(value); }, 1ms, start);
+
+    wheel.scheduleAt(1, start + 5ms);
+    wheel.scheduleAt(2, start + 3ms);
+    wheel.scheduleAt(3, start + 3ms);
+    wheel.scheduleAt(4, start + 5500us);
+    wheel.scheduleAt(5, start + 300ms);
+    wheel.scheduleAt(6, start + 70s);
+    assert(wheel.size() == 6);
+
+    assert(wheel.advance(start + 2ms) == 0 && fired.empty());
+    assert(wheel.advance(start + 3ms) == 2);
+    std::sort(fired.begin(), fired.end());
+    assert((fired == std::vector<int>{2, 3}));
+    assert(wheel.advance(start + 5ms) == 1 && fired.back() == 1);
+    assert(wheel.advance(start + 5999us) == 0);
+    assert(wheel.advance(start + 6ms) == 1 && fired.back() == 4);
+    assert(wheel.advance(start + 299ms) == 0);
+    assert(wheel.advance(start + 300ms) == 1 && fired.back() == 5);
+    assert(wheel.nextEvent().has_value() && *wheel.nextEvent() <= start + 70s);
+    assert(wheel.advance(start + 69999ms) == 0);
+    assert(wheel.advance(start + 1h) == 1 && fired.back() == 6);
+    assert(wheel.empty() && !wheel.nextEvent().has_value());
+
+    // A deadline in the past expires at the first tick not processed yet
+    wheel.scheduleAt(7, start);
+    wheel.schedule(8, -1s);
+    assert(wheel.advance(start + 1h) == 0);
+    assert(wheel.advance(start + 1h + 1ms) == 2 && wheel.empty());
+}
+
+// Cancelled timers do not expire, and their handles match nothing once the entry is reused
+void test_Cancel()
+{
+    const Clock::time_point start = Clock::now();
+    std::vector<int> fired;
+    TimingWheel<int> wheel([&fired](int value) { fired.push_back(value); }, 1ms, start);
+
+    const auto first = wheel.scheduleAt(1, start + 10ms);
+    const auto second = wheel.scheduleAt(2, start + 10s);
+    assert(wheel.contains(first) && wheel.contains(second));
+    assert(wheel.cancel(first) && !wheel.contains(first) && !wheel.cancel(first));
+    assert(wheel.cancel(second) && wheel.empty());
+
+    const auto reused = wheel.scheduleAt(3, start + 10ms);
+    assert(static_cast<std::uint32_t>(reused) == static_cast<std::uint32_t>(second) && reused != second);
+    assert(!wheel.cancel(second) && wheel.contains(reused));
+    assert(wheel.advance(start + 1min) == 1 && fired == std::vector<int>{3});
+    assert(!wheel.contains(reused) && !wheel.cancel(reused));
+}
+
+// Periodic timers expire once per period, catch up on missed periods, and can cancel themselves from the
+// executor, which takes effect from the next advance
+void test_Periodic()
+{
+    const Clock::time_point start = Clock::now();
+    int beats = 0;
+    int expiries = 0;
+    TimingWheel<int>* self = nullptr;
+    TimingWheel<int>::Handle heartbeat = 0;
+    TimingWheel<int> wheel([&](int value)
+    {
+        if (value == 0 && ++beats == 25) self->cancel(heartbeat);
+        if (value == 1) ++expiries;
+    }, 1ms, start);
+    self = &wheel;
+
+    heartbeat = wheel.scheduleAt(0, start + 10ms, 10ms);
+    wheel.scheduleAt(1, start + 1s, 300ms);
+    for (int ms = 0; ms <= 100; ++ms) wheel.advance(start + std::chrono::milliseconds{ms});
+    assert(beats == 10 && expiries == 0 && wheel.contains(heartbeat));
+
+    // One advance over many periods expires each of them
+    assert(wheel.advance(start + 200ms) == 10 && beats == 20);
+    for (int ms = 201; ms <= 1000; ++ms) wheel.advance(start + std::chrono::milliseconds{ms});
+    assert(beats == 25 && !wheel.contains(heartbeat) && expiries == 1);
+    wheel.advance(start + 1900ms);
+    assert(beats == 25 && expiries == 4 && wheel.size() == 1);
+}
+
+// Random schedules over every level, including deadlines beyond the span of the wheel, random cancellations
+// and random advances from one tick to hours, checked against a std::multimap of deadlines
+void test_RandomTimers()
+{
+    using Wheel = TimingWheel<std::uint32_t>;
+    std::mt19937_64 engine{2026};
+    const Clock::time_point start = Clock::now();
+    const auto at = [start](std::uint64_t tick) { return start + std::chrono::microseconds{tick}; };
+
+    std::vector<std::uint32_t> fired;
+    Wheel wheel([&fired](std::uint32_t id) { fired.push_back(id); }, 1us, start);
+
+    std::multimap<std::uint64_t, std::uint32_t> reference;
+    std::vector<std::multimap<std::uint64_t, std::uint32_t>::iterator> entries;
+    std::vector<Wheel::Handle> handles;
+    std::vector<std::uint32_t> pending;
+    std::uint64_t now = 0;
+    wheel.advance(at(now));
+
+    const std::uint64_t bounds[] = {300, 70'000, std::uint64_t{1} << 26, std::uint64_t{1} << 34};
+    std::uniform_int_distribution<int> operations{0, 99};
+    for (int step = 0; step < 200'000; ++step)
+    {
+        const int operation = operations(engine);
+        if (operation < 60)
+        {
+            const std::uint64_t bound = bounds[operation < 30 ? 0 : operation < 50 ? 1 : operation < 59 ? 2 : 3];
+            const std::uint64_t delay = std::uniform_int_distribution<std::uint64_t>{0, bound}(engine);
+            const auto id = static_cast<std::uint32_t>(handles.size());
+            handles.push_back(wheel.scheduleAt(id, at(now + delay)));
+            entries.push_back(reference.emplace(std::max(now + 1, now + delay), id));
+            pending.push_back(id);
+        }
+        else if (operation < 80 && !pending.empty())
+        {
+            const std::size_t which = std::uniform_int_distribution<std::size_t>{0, pending.size() - 1}(engine);
+            const std::uint32_t id = pending[which];
+            pending[which] = pending.back();
+            pending.pop_back();
+            if (entries[id] == reference.end())
+            {
+                assert(!wheel.contains(handles[id]) && !wheel.cancel(handles[id]));
+                continue;
+            }
+            assert(wheel.contains(handles[id]) && wheel.cancel(handles[id]) && !wheel.cancel(handles[id]));
+            reference.erase(entries[id]);
+            entries[id] = reference.end();
+        }
+        else
+        {
+            const std::uint64_t bound = operation < 97 ? 300 : operation < 99 ? 1 << 20 : std::uint64_t{1} << 33;
+            const std::uint64_t target = now + std::uniform_int_distribution<std::uint64_t>{1, bound}(engine);
+            fired.clear();
+            wheel.advance(at(target));
+
+            // Everything due fired, in order of deadline, and nothing else
+            std::uint64_t previous = now + 1;
+            for (std::uint32_t id : fired)
+            {
+                assert(entries[id] != reference.end());
+                const std::uint64_t deadline = entries[id]->first;
+                assert(previous <= deadline && deadline <= target);
+                previous = deadline;
+                reference.erase(entries[id]);
+                entries[id] = reference.end();
+                assert(!wheel.contains(handles[id]));
+            }
+            assert(reference.empty() || reference.begin()->first > target);
+            now = target;
+        }
+        assert(wheel.size() == reference.size());
+    }
+
+    fired.clear();
+    wheel.advance(at(now + (std::uint64_t{1} << 36)));
+    assert(fired.size() == reference.size() && wheel.empty());
+}
+
+// The timer thread sleeps until the next deadline, wakes up for an earlier one, and never fires early
+void test_TimerThread()
+{
+    std::mutex mutex;
+    std::condition_variable done;
+    std::vector<std::pair<int, Clock::time_point>> fired;
+    std::atomic<int> beats{0};
+    TimingWheel<int> wheel([&](int value)
+    {
+        if (value < 0)
+        {
+            ++beats;
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        fired.emplace_back(value, Clock::now());
+        done.notify_one();
+    }, 1ms);
+
+    wheel.start();
+    const auto later = wheel.schedule(1000, 1h);
+    std::this_thread::sleep_for(10ms);
+
+    constexpr int TIMERS = 20;
+    std::vector<Clock::time_point> deadlines;
+    for (int i = 0; i < TIMERS; ++i)
+    {
+        deadlines.push_back(Clock::now() + std::chrono::milliseconds{2 * i});
+        wheel.schedule(i, std::chrono::milliseconds{2 * i});
+    }
+    const auto heartbeat = wheel.schedule(-1, 5ms, 5ms);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        assert(done.wait_for(lock, 10s, [&] { return fired.size() == TIMERS; }));
+    }
+    for (const auto& [value, time] : fired) assert(time >= deadlines[value]);
+
+    std::this_thread::sleep_for(20ms);
+    assert(wheel.cancel(heartbeat) && beats > 0);
+    assert(wheel.contains(later) && wheel.size() == 1);
+    wheel.stop();
+    wheel.start();
+    wheel.stop();
+    assert(wheel.cancel(later));
+}
+
+// The executor hands expired Commands to the ConcurrentPriorityQueue for the Consumers
+void test_Commands()
+{
+    auto comparator = [](const Command& lhs, const Command& rhs) -> bool { return lhs.priority() < rhs.priority(); };
+    using CPQ = ConcurrentPriorityQueue<Command, std::vector<Command>, decltype(comparator)>;
+    auto queue = std::make_shared<CPQ>();
+
+    const Clock::time_point start = Clock::now();
+    TimingWheel<Command> wheel([&queue](Command command) { queue->enqueue(command); }, 1ms, start);
+    const FunctionType identity = [](double value) -> double { return value; };
+    wheel.scheduleAt(Command(identity, 3), start + 2s);
+    wheel.scheduleAt(Command(identity, 1), start + 1s);
+    wheel.scheduleAt(Command(identity, 2), start + 1s);
+
+    assert(wheel.advance(start + 1s) == 2);
+    assert(queue->dequeue()->priority() == 2);
+    assert(queue->dequeue()->priority() == 1);
+    assert(wheel.advance(start + 2s) == 1);
+    assert(queue->dequeue()->priority() == 3);
+
+    // Commands copy with their algorithm
+    const double offset = 0.5;
+    Command command([offset](double value) -> double { return value + offset; }, 3);
+    Command copied = command;
+    assert(copied.priority() == 3);
 
-int main()
+    // A delay travels with the Command until it is taken off by ready()
+    Command delayed(identity, 4, 50ms);
+    assert(delayed.delay() == 50ms && delayed.ready().delay() == 0ms && delayed.ready().priority() == 4);
+}
+
+// A Consumer hands delayed Commands to the wheel rather than sleeping through them, so N of them on a single
+// Consumer thread take about one delay rather than N
+void test_DelayedCommands()
+{
+    constexpr int N = 8;
+    constexpr auto DELAY = 100ms;
+    auto comparator = [](const Command& lhs, const Command& rhs) -> bool { return lhs.priority() < rhs.priority(); };
+    using CPQ = ConcurrentPriorityQueue<Command, std::vector<Command>, decltype(comparator)>;
+    auto queue = std::make_shared<CPQ>();
+    auto wheel = std::make_shared<TimingWheel<Command>>([&queue](Command command) { queue->enqueue(command); });
+    wheel->start();
+
+    std::atomic<int> executed{0};
+    for (int i = 0; i < N; ++i)
+    {
+        queue->enqueue(Command([&executed](double value) -> double { ++executed; return value; }, 1, DELAY));
+    }
+
+    StopWatch stopWatch;
+    stopWatch.StartStopWatch();
+    std::thread consumer{Consumer{queue, wheel}};
+    while (executed.load() < N) std::this_thread::sleep_for(1ms);
+    stopWatch.StopStopWatch();
+
+    queue->enqueue(Command([](double value) -> double { return value; }, INTMAX_MAX));
+    consumer.join();
+    wheel->stop();
+    const double seconds = stopWatch.GetTime();
+    assert(seconds >= 0.1 && seconds < 3 * 0.1);
+}
+
+void test_Errors()
+{
+    const auto ignore = [](int) {};
+    bool thrown = false;
+    try { TimingWheel<int> wheel(ignore, Clock::duration::zero()); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    TimingWheel<int> wheel(ignore);
+    thrown = false;
+    try { wheel.schedule(0, 1s, -1s); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown && wheel.empty());
+
+    TimingWheel<std::unique_ptr<int>> owning([](std::unique_ptr<int> value) { sink += *value; });
+    owning.schedule(std::make_unique<int>(1), 0s);
+    thrown = false;
+    try { owning.schedule(std::make_unique<int>(2), 1s, 1s); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown && owning.size() == 1);
+
+    wheel.start();
+    thrown = false;
+    try { wheel.start(); }
+    catch (const std::logic_error&) { thrown = true; }
+    assert(thrown);
+    wheel.stop();
+}
+
+// n order expiries due within a minute at 1 ms ticks, every other one cancelled before it is due, time
+// advancing a tick at a time: ns per timer for the wheel, a priority queue skipping cancelled entries, and
+// a multimap erasing them
+void benchmark_Timeouts(std::size_t n)
+{
+    constexpr std::uint64_t TICKS = 60'000;
+    std::mt19937_64 engine{n};
+    std::uniform_int_distribution<std::uint64_t> delays{1, TICKS};
+    std::vector<std::uint64_t> deadlines(n);
+    for (std::uint64_t& deadline : deadlines) deadline = delays(engine);
+
+    // Schedule everything, then cancel every other timer at half its delay while advancing
+    std::vector<std::vector<std::uint32_t>> cancels(TICKS + 1);
+    for (std::uint32_t id = 1; id < n; id += 2) cancels[deadlines[id] / 2].push_back(id);
+
+    StopWatch stopWatch;
+    stopWatch.StartStopWatch();
+    {
+        const Clock::time_point start = Clock::now();
+        TimingWheel<std::uint32_t> wheel([](std::uint32_t id) { sink += id; }, 1ms, start);
+        wheel.reserve(n);
+        std::vector<TimingWheel<std::uint32_t>::Handle> handles(n);
+        for (std::uint32_t id = 0; id < n; ++id) handles[id] = wheel.scheduleAt(id, start + std::chrono::milliseconds{deadlines[id]});
+        for (std::uint64_t tick = 0; tick <= TICKS; ++tick)
+        {
+            for (std::uint32_t id : cancels[tick]) sink += wheel.cancel(handles[id]);
+            wheel.advance(start + std::chrono::milliseconds{tick});
+        }
+    }
+    stopWatch.StopStopWatch();
+    const double wheel = stopWatch.GetTime();
+
+    stopWatch.StartStopWatch();
+    {
+        using Entry = std::pair<std::uint64_t, std::uint32_t>;
+        std::vector<Entry> storage;
+        storage.reserve(n);
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> timers(std::greater<>{}, std::move(storage));
+        std::vector<bool> cancelled(n);
+        for (std::uint32_t id = 0; id < n; ++id) timers.emplace(deadlines[id], id);
+        for (std::uint64_t tick = 0; tick <= TICKS; ++tick)
+        {
+            for (std::uint32_t id : cancels[tick]) cancelled[id] = true;
+            while (!timers.empty() && timers.top().first <= tick)
+            {
+                if (!cancelled[timers.top().second]) sink += timers.top().second;
+                timers.pop();
+            }
+        }
+    }
+    stopWatch.StopStopWatch();
+    const double queue = stopWatch.GetTime();
+
+    stopWatch.StartStopWatch();
+    {
+        std::multimap<std::uint64_t, std::uint32_t> timers;
+        std::vector<std::multimap<std::uint64_t, std::uint32_t>::iterator> handles(n);
+        for (std::uint32_t id = 0; id < n; ++id) handles[id] = timers.emplace(deadlines[id], id);
+        for (std::uint64_t tick = 0; tick <= TICKS; ++tick)
+        {
+            for (std::uint32_t id : cancels[tick]) timers.erase(handles[id]);
+            while (!timers.empty() && timers.begin()->first <= tick)
+            {
+                sink += timers.begin()->second;
+                timers.erase(timers.begin());
+            }
+        }
+    }
+    stopWatch.StopStopWatch();
+    const double map = stopWatch.GetTime();
+
+    std::cout << n << "\t\t" << wheel * 1e9 / n << "\t\t" << queue * 1e9 / n << "\t\t" << map * 1e9 / n << std::endl;
+}
+
+// A priority queue whose heap lives in a node arena pops in the same order as one on the heap, and Consumers
+// spawned through a placement are pinned before they run
+void test_Placement()
+{
+    auto comparator = [](const Command& lhs, const Command& rhs) -> bool { return lhs.priority() < rhs.priority(); };
+    using Commands = std::vector<Command, NodeAllocator<Command>>;
+    ConcurrentPriorityQueue<Command, Commands, decltype(comparator)> queue{Commands(NodeAllocator<Command>{std::make_shared<NodeArena>(0)})};
+    for (long priority : {5L, 50L, 1L, 99L, 42L}) queue.enqueue(Command([](double value) -> double { return value; }, priority));
+    for (long priority : {99L, 50L, 42L, 5L, 1L}) assert(queue.dequeue()->priority() == priority);
+
+    Placement placement{Topology::discover().restrictedTo(Placement::allowedCpus()), PlacementPolicy::Compact};
+    std::atomic<int> ran{0};
+    std::thread first = placement.spawn(0, "Consumer 0", [&ran] { ++ran; });
+    std::thread second = placement.spawn(1, "Consumer 1", [&ran] { ++ran; });
+    first.join();
+    second.join();
+    assert(ran.load() == 2 && placement.placements().size() == 2);
+    assert(placement.placements()[1].cpu == placement.cpuFor(1));
+}
+
+// The Consumers of the original exercise, fed by one timer thread: each of the former Producer threads slept a
+// second between Commands, a periodic timer per Producer now publishes them
+void timed_producers(const std::string& policy)
 {
     constexpr int NUM_THREADS = 100;
-    std::array<std::thread, NUM_THREADS> producerThreads;
     std::array<std::thread, NUM_THREADS> consumerThreads;
 
+    // compact, scatter, unpinned or a list of CPUs
+    const bool isList = !policy.empty() && std::isdigit(static_cast<unsigned char>(policy.front()));
+    Placement placement{Topology::discover().restrictedTo(Placement::allowedCpus()),
+                        isList ? PlacementPolicy::CoreList : Placement::parsePolicy(policy),
+                        isList ? Topology::parseCpuList(policy) : std::vector<unsigned>{}};
+    const std::optional<unsigned> node = placement.nodeFor(0);
+
     // Create a comparator type to construct the ConcurrentPriorityQueue
     auto comparator = [](const Command& lhs, const Command& rhs) -> bool { return lhs.priority() < rhs.priority(); };
-    // Create an alias to improve readability
-    using CPQ = std::shared_ptr<ConcurrentPriorityQueue<Command, std::vector<Command>, decltype(comparator)>>;
+    // Create aliases to improve readability; the queue's heap is allocated on the first Consumer's node
+    using Commands = std::vector<Command, NodeAllocator<Command>>;
+    using CPQ = std::shared_ptr<ConcurrentPriorityQueue<Command, Commands, decltype(comparator)>>;
     // Create the ConcurrentPriorityQueue
-    CPQ queue(new ConcurrentPriorityQueue<Command, std::vector<Command>, decltype(comparator)>{});
+    auto arena = std::make_shared<NodeArena>(node ? static_cast<int>(*node) : -1);
+    CPQ queue(new ConcurrentPriorityQueue<Command, Commands, decltype(comparator)>{Commands(NodeAllocator<Command>{arena})});
 
-    // Create thread pool for Producers - Producers override the call operator so are Function Objects
-    // that will execute when the threads start
+    // The timing wheel publishes each expired Command to the queue from its single timer thread, both the periodic
+    // ones of the former Producers and those the Consumers hand back to it to simulate a 5 second algorithm
+    auto wheel = std::make_shared<TimingWheel<Command>>([&queue](Command command) { queue->enqueue(command); });
+    std::mt19937_64 generator(std::random_device{}());
+    std::uniform_int_distribution<> distribution(1, 100);
     for (int i = 0; i < NUM_THREADS; ++i)
     {
-        producerThreads[i] = std::thread(Producer{queue});
+        wheel->schedule(Command([](double value) -> double { return value; }, distribution(generator), 5000ms), 1s, 1s);
     }
+    wheel->start();
 
     // Create thread pool for Consumers - Consumers override the call operator so are Function Objects
     // that will execute when the threads start
     for (int i = 0; i < NUM_THREADS; ++i)
     {
-        consumerThreads[i] = std::thread(Consumer{queue});
+        consumerThreads[i] = placement.spawn(i, "Consumer " + std::to_string(i), Consumer{queue, wheel});
     }
+    std::cout << placement.report();
+    std::cout << "Queue heap on node " << (node ? std::to_string(*node) : std::string("of first touch"))
+              << (arena->isBound() ? "" : " (mbind unavailable, first touch)") << std::endl;
 
     // Wait for signal before joining thread
     std::cout << "***** ENTER ANY CHARACTER TO END *****" << std::endl;
     getchar();
-    ConcurrentPriorityQueue<Command, std::vector<Command>, decltype(comparator)>::killSwitch.store(true);
+    wheel->stop();
+
+    // One kill command per Consumer; they come first in the queue
+    for (int i = 0; i < NUM_THREADS; ++i)
+    {
+        queue->enqueue(Command([](double value) -> double { return value; }, INTMAX_MAX));
+    }
 
     // Block the main thread in the thread groups finish executing
     for (int i = 0; i < NUM_THREADS; ++i)
     {
-        if (producerThreads[i].joinable()) producerThreads[i].join();
         if (consumerThreads[i].joinable()) consumerThreads[i].join();
     }
 
     std::cout << "***** PROCESS WAS TERMINATED - GRACEFULLY ENDING *****" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    test_OneShot();
+    test_Cancel();
+    test_Periodic();
+    test_RandomTimers();
+    test_TimerThread();
+    test_Commands();
+    test_DelayedCommands();
+    test_Errors();
+    test_Placement();
+
+    std::cout << "ns per order expiry, every other one cancelled" << std::endl;
+    std::cout << "n\t\ttiming wheel\tpriority_queue\tmultimap" << std::endl;
+    for (std::size_t n : {std::size_t{1} << 12, std::size_t{1} << 16, std::size_t{1} << 20}) benchmark_Timeouts(n);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    timed_producers(argc > 1 ? argv[1] : "compact");
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,142 @@
+//
+// Exercise 5's Commands hold their algorithm in an InplaceFunction, a function wrapper that keeps its callable
+// inside itself rather than on the heap. The tests cover calls, copies, moves, empty wrappers and
+// UniqueFunction's move-only callables; the benchmark compares the cost of constructing, copying and calling
+// it against std::function for a capture that fits std::function's buffer and one that does not.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <array>
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "InplaceFunction.hpp"
+#include "StopWatch.hpp"
+
+// The algorithm a Command holds
+using FunctionType = InplaceFunction<double (double)>;
+
+// InplaceFunction and UniqueFunction behave as std::function does, with the callable stored inside them
+void test_InplaceFunction()
+{
+    FunctionType twice = [](double value) -> double { return 2 * value; };
+    assert(twice && twice(4.0) == 8.0);
+
+    // Copies own their own state
+    long calls = 0;
+    InplaceFunction<long ()> counter = [calls]() mutable { return ++calls; };
+    counter();
+    InplaceFunction<long ()> copy = counter;
+    assert(counter() == 2 && copy() == 2 && copy() == 3 && calls == 0);
+
+    // A moved-from wrapper is empty, and calling an empty one throws as std::function does
+    InplaceFunction<long ()> moved = std::move(counter);
+    assert(!counter && counter == nullptr && moved() == 3);
+    bool thrown = false;
+    try { counter(); }
+    catch (const std::bad_function_call&) { thrown = true; }
+    assert(thrown);
+
+    // Function pointers, and a null one leaves the wrapper empty
+    double (*negate)(double) = [](double value) { return -value; };
+    twice = negate;
+    assert(twice(1.5) == -1.5);
+    negate = nullptr;
+    twice = negate;
+    assert(!twice);
+
+    // Results convert to the signature's, and void discards them
+    InplaceFunction<void (std::vector<int>&)> append = [](std::vector<int>& values) { values.push_back(1); return values.size(); };
+    std::vector<int> values;
+    append(values);
+    assert(values.size() == 1);
+
+    // Move-only callables in a UniqueFunction, and swap
+    UniqueFunction<int ()> owner = [value = std::make_unique<int>(7)]() { return *value; };
+    UniqueFunction<int ()> other = [] { return 1; };
+    owner.swap(other);
+    assert(owner() == 1 && other() == 7);
+    other = nullptr;
+    assert(!other);
+
+    // Capacity is checked when the wrapper is built
+    struct Large { std::array<double, 8> data; double operator()(double value) const { return data[0] + value; } };
+    static_assert(!FunctionType::fits<Large>());
+    static_assert(InplaceFunction<double (double), sizeof(Large)>::fits<Large>());
+    InplaceFunction<double (double), sizeof(Large)> large = Large{{1.0}};
+    assert(large(1.0) == 2.0);
+    static_assert(!std::is_copy_constructible_v<UniqueFunction<void ()>>);
+    static_assert(std::is_nothrow_move_constructible_v<FunctionType>);
+}
+
+// ns per construction (with the destruction of the previous wrapper), copy and call of a wrapper around a
+// lambda capturing `Captures` doubles
+template<typename Wrapper, std::size_t Captures>
+std::array<double, 3> measureWrapper(std::size_t n)
+{
+    constexpr std::size_t WRAPPERS = 1024;
+    std::vector<Wrapper> wrappers(WRAPPERS);
+    auto make = [](std::size_t i)
+    {
+        std::array<double, Captures> state{};
+        state[0] = static_cast<double>(i);
+        return [state](double value) -> double { return state[0] + state[Captures - 1] + value; };
+    };
+
+    StopWatch stopWatch;
+    stopWatch.StartStopWatch();
+    for (std::size_t i = 0; i < n; ++i) wrappers[i % WRAPPERS] = make(i);
+    stopWatch.StopStopWatch();
+    const double construct = stopWatch.GetTime();
+
+    std::vector<Wrapper> copies(WRAPPERS);
+    stopWatch.StartStopWatch();
+    for (std::size_t i = 0; i < n; ++i) copies[i % WRAPPERS] = wrappers[(i * 7) % WRAPPERS];
+    stopWatch.StopStopWatch();
+    const double copy = stopWatch.GetTime();
+
+    double total = 0.0;
+    stopWatch.StartStopWatch();
+    for (std::size_t i = 0; i < n; ++i) total += copies[i % WRAPPERS](1.0);
+    stopWatch.StopStopWatch();
+    const double call = stopWatch.GetTime();
+
+    // Replay the same assignments on the indices the lambdas were made from, and call the lambdas directly
+    std::vector<std::size_t> made(WRAPPERS), copied(WRAPPERS);
+    for (std::size_t i = 0; i < n; ++i) made[i % WRAPPERS] = i;
+    for (std::size_t i = 0; i < n; ++i) copied[i % WRAPPERS] = made[(i * 7) % WRAPPERS];
+    double expected = 0.0;
+    for (std::size_t i = 0; i < n; ++i) expected += make(copied[i % WRAPPERS])(1.0);
+    assert(total == expected);
+
+    const auto scale = 1e9 / static_cast<double>(n);
+    return {construct * scale, copy * scale, call * scale};
+}
+
+template<std::size_t Captures>
+void benchmark_Callables(std::size_t n)
+{
+    const std::array<double, 3> function = measureWrapper<std::function<double (double)>, Captures>(n);
+    const std::array<double, 3> inplace = measureWrapper<InplaceFunction<double (double), 64>, Captures>(n);
+    std::cout << Captures * sizeof(double) << " bytes\t" << function[0] << "\t" << inplace[0] << "\t"
+              << function[1] << "\t" << inplace[1] << "\t" << function[2] << "\t" << inplace[2] << std::endl;
+}
+
+int main()
+{
+    test_InplaceFunction();
+
+    std::cout << "ns per operation, std::function against InplaceFunction<double (double), 64>" << std::endl;
+    std::cout << "capture\tconstruct: function, inplace\tcopy: function, inplace\tcall: function, inplace" << std::endl;
+    benchmark_Callables<1>(std::size_t{1} << 22);
+    benchmark_Callables<4>(std::size_t{1} << 22);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+    return 0;
+}
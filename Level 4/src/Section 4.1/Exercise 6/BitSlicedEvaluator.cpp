@@ -0,0 +1,358 @@
+//
+// A BitSlicedEvaluator compiles a Formula into three-address instructions over a small register file and
+// evaluates 64 * Lanes assignments at once.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_BITSLICEDEVALUATOR_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_BITSLICEDEVALUATOR_CPP
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "BitSlicedEvaluator.hpp"
+
+/**
+ * Overloaded ctor. Compiles the postfix program of the Formula into register instructions where each
+ * operand lives in the register that matches its postfix stack depth.
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @param formula The Formula to compile
+ * @param threads The number of worker threads; 0 uses std::thread::hardware_concurrency()
+ */
+template<std::size_t Lanes>
+BitSlicedEvaluator<Lanes>::BitSlicedEvaluator(const Formula& formula, unsigned threads)
+    : code{}, registers{0}, variables{formula.variableCount()},
+      threads{threads != 0 ? threads : std::max(1U, std::thread::hardware_concurrency())}
+{
+    if (variables > MAX_VARIABLES)
+    {
+        throw std::invalid_argument("A Formula with " + std::to_string(variables) + " variables has too many assignments to enumerate");
+    }
+
+    std::uint32_t depth = 0;
+    code.reserve(formula.postfix().size());
+    for (const Formula::Instruction& instruction : formula.postfix())
+    {
+        switch (instruction.op)
+        {
+            case Formula::OpCode::Variable:
+            case Formula::OpCode::Constant:
+                code.push_back(Instruction{instruction.op, depth, instruction.operand, 0});
+                ++depth;
+                break;
+            case Formula::OpCode::Not:
+                code.push_back(Instruction{instruction.op, depth - 1, depth - 1, 0});
+                break;
+            default:
+                code.push_back(Instruction{instruction.op, depth - 2, depth - 2, depth - 1});
+                --depth;
+                break;
+        }
+
+        registers = std::max(registers, depth);
+    }
+}
+
+/**
+ * Number of blocks of ASSIGNMENTS_PER_BLOCK assignments needed to cover all 2^n assignments
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @return The block count
+ */
+template<std::size_t Lanes>
+std::uint64_t BitSlicedEvaluator<Lanes>::blockCount() const noexcept
+{
+    const std::uint64_t assignments = std::uint64_t{1} << variables;
+    return (assignments + ASSIGNMENTS_PER_BLOCK - 1) / ASSIGNMENTS_PER_BLOCK;
+}
+
+/**
+ * The bits of a block that correspond to real assignments. Only the single block of a Formula with fewer
+ * than log2(ASSIGNMENTS_PER_BLOCK) variables is partial.
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @param block The block index
+ * @return A mask with one bit set per valid assignment
+ */
+template<std::size_t Lanes>
+typename BitSlicedEvaluator<Lanes>::Register BitSlicedEvaluator<Lanes>::validMask(std::uint64_t block) const noexcept
+{
+    Register mask;
+    const std::uint64_t assignments = std::uint64_t{1} << variables;
+    for (std::size_t w = 0; w < Lanes; ++w)
+    {
+        const std::uint64_t start = block * ASSIGNMENTS_PER_BLOCK + w * 64;
+        if (start >= assignments) mask[w] = 0;
+        else if (assignments - start >= 64) mask[w] = ~std::uint64_t{0};
+        else mask[w] = (std::uint64_t{1} << (assignments - start)) - 1;
+    }
+
+    return mask;
+}
+
+/**
+ * Runs the compiled program for one block of assignments. The result is left in register 0.
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @param block The block index
+ * @param file The register file, sized registerCount()
+ */
+template<std::size_t Lanes>
+void BitSlicedEvaluator<Lanes>::evaluate(std::uint64_t block, std::vector<Register>& file) const noexcept
+{
+    // Variable i takes bit i of the assignment number. The low 6 bits vary within a word, the next
+    // log2(Lanes) bits vary across the words of a register and the remaining bits come from the block index.
+    static constexpr std::uint64_t PATTERNS[6] = {0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+                                                  0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL};
+    constexpr std::uint32_t LANE_BITS = std::countr_zero(Lanes);
+
+    for (const Instruction& instruction : code)
+    {
+        Register& d = file[instruction.dst];
+        const Register& a = file[instruction.lhs];
+        const Register& b = file[instruction.rhs];
+        switch (instruction.op)
+        {
+            case Formula::OpCode::Variable:
+            {
+                const std::uint32_t i = instruction.lhs;
+                if (i < 6) d.fill(PATTERNS[i]);
+                else if (i < 6 + LANE_BITS) for (std::size_t w = 0; w < Lanes; ++w) d[w] = ((w >> (i - 6)) & 1U) ? ~std::uint64_t{0} : 0;
+                else d.fill(((block >> (i - 6 - LANE_BITS)) & 1U) ? ~std::uint64_t{0} : 0);
+                break;
+            }
+            case Formula::OpCode::Constant:
+                d.fill(instruction.lhs != 0 ? ~std::uint64_t{0} : 0);
+                break;
+            case Formula::OpCode::And:
+                for (std::size_t w = 0; w < Lanes; ++w) d[w] = a[w] & b[w];
+                break;
+            case Formula::OpCode::Or:
+                for (std::size_t w = 0; w < Lanes; ++w) d[w] = a[w] | b[w];
+                break;
+            case Formula::OpCode::Xor:
+                for (std::size_t w = 0; w < Lanes; ++w) d[w] = a[w] ^ b[w];
+                break;
+            case Formula::OpCode::Not:
+                for (std::size_t w = 0; w < Lanes; ++w) d[w] = ~a[w];
+                break;
+            case Formula::OpCode::Implies:
+                for (std::size_t w = 0; w < Lanes; ++w) d[w] = ~a[w] | b[w];
+                break;
+            case Formula::OpCode::Iff:
+                for (std::size_t w = 0; w < Lanes; ++w) d[w] = ~(a[w] ^ b[w]);
+                break;
+        }
+    }
+}
+
+/**
+ * Evaluates every block on a pool of threads. Blocks are handed out in chunks from a shared counter so
+ * that threads finishing early steal the remaining work.
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @tparam BlockFunction Callable as function(threadIndex, block, const Register& value)
+ * @param function Receives the (unmasked) value of the Formula for each block
+ * @param stop When set by any thread, the remaining blocks are skipped
+ */
+template<std::size_t Lanes>
+template<typename BlockFunction>
+void BitSlicedEvaluator<Lanes>::forEachBlock(BlockFunction&& function, const std::atomic<bool>* stop) const
+{
+    constexpr std::uint64_t CHUNK = 64;
+    const std::uint64_t blocks = blockCount();
+    const auto workers = static_cast<unsigned>(std::min<std::uint64_t>(threads, (blocks + CHUNK - 1) / CHUNK));
+    std::atomic<std::uint64_t> next{0};
+
+    auto worker = [&](unsigned id)
+    {
+        std::vector<Register> file(registers);
+        while (stop == nullptr || !stop->load(std::memory_order_relaxed))
+        {
+            const std::uint64_t begin = next.fetch_add(CHUNK, std::memory_order_relaxed);
+            if (begin >= blocks) break;
+
+            const std::uint64_t end = std::min(begin + CHUNK, blocks);
+            for (std::uint64_t block = begin; block < end; ++block)
+            {
+                evaluate(block, file);
+                function(id, block, file[0]);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned id = 1; id < workers; ++id) pool.emplace_back(worker, id);
+    worker(0);
+    for (std::thread& t : pool) t.join();
+}
+
+/**
+ * Evaluates a single block of assignments
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @param block The block index
+ * @return Bit k is the value of the Formula for assignment (block * ASSIGNMENTS_PER_BLOCK + k)
+ */
+template<std::size_t Lanes>
+typename BitSlicedEvaluator<Lanes>::Register BitSlicedEvaluator<Lanes>::evaluateBlock(std::uint64_t block) const
+{
+    if (block >= blockCount())
+    {
+        throw std::out_of_range("block must be between [0," + std::to_string(blockCount()) + ")");
+    }
+
+    std::vector<Register> file(registers);
+    evaluate(block, file);
+
+    Register mask = validMask(block);
+    for (std::size_t w = 0; w < Lanes; ++w) file[0][w] &= mask[w];
+    return file[0];
+}
+
+/**
+ * The complete truth table of the Formula
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @return 2^n bits packed into words, where bit k is the value for assignment k
+ */
+template<std::size_t Lanes>
+std::vector<std::uint64_t> BitSlicedEvaluator<Lanes>::truthTable() const
+{
+    if (variables > 36)
+    {
+        throw std::length_error("A truth table of " + std::to_string(variables) + " variables does not fit in memory");
+    }
+
+    const std::uint64_t words = std::max<std::uint64_t>(1, (std::uint64_t{1} << variables) / 64);
+    std::vector<std::uint64_t> table(words, 0);
+    forEachBlock([&](unsigned, std::uint64_t block, const Register& value)
+    {
+        const Register mask = validMask(block);
+        for (std::size_t w = 0; w < Lanes && block * Lanes + w < words; ++w) table[block * Lanes + w] = value[w] & mask[w];
+    });
+
+    return table;
+}
+
+/**
+ * Number of assignments that satisfy the Formula
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @return The model count
+ */
+template<std::size_t Lanes>
+std::uint64_t BitSlicedEvaluator<Lanes>::countModels() const
+{
+    // One padded counter per thread so the workers never share a cache line
+    struct alignas(64) Counter { std::uint64_t value = 0; };
+    std::vector<Counter> counts(threads);
+
+    forEachBlock([&](unsigned id, std::uint64_t block, const Register& value)
+    {
+        const Register mask = validMask(block);
+        for (std::size_t w = 0; w < Lanes; ++w) counts[id].value += std::popcount(value[w] & mask[w]);
+    });
+
+    std::uint64_t total = 0;
+    for (const Counter& c : counts) total += c.value;
+    return total;
+}
+
+/**
+ * Searches for an assignment that falsifies the Formula and stops every thread once one is found
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @return The assignment number (bit i is the value of variable i), or an empty optional for a tautology
+ */
+template<std::size_t Lanes>
+std::optional<std::uint64_t> BitSlicedEvaluator<Lanes>::counterexample() const
+{
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> found{std::numeric_limits<std::uint64_t>::max()};
+
+    forEachBlock([&](unsigned, std::uint64_t block, const Register& value)
+    {
+        const Register mask = validMask(block);
+        for (std::size_t w = 0; w < Lanes; ++w)
+        {
+            const std::uint64_t falsified = ~value[w] & mask[w];
+            if (falsified == 0) continue;
+
+            const std::uint64_t assignment = block * ASSIGNMENTS_PER_BLOCK + w * 64 + std::countr_zero(falsified);
+            std::uint64_t current = found.load();
+            while (assignment < current && !found.compare_exchange_weak(current, assignment)) {}
+            stop.store(true, std::memory_order_relaxed);
+            return;
+        }
+    }, &stop);
+
+    if (!stop.load()) return std::nullopt;
+    return found.load();
+}
+
+/**
+ * Searches for an assignment that satisfies the Formula and stops every thread once one is found
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @return The assignment number (bit i is the value of variable i), or an empty optional if unsatisfiable
+ */
+template<std::size_t Lanes>
+std::optional<std::uint64_t> BitSlicedEvaluator<Lanes>::model() const
+{
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> found{std::numeric_limits<std::uint64_t>::max()};
+
+    forEachBlock([&](unsigned, std::uint64_t block, const Register& value)
+    {
+        const Register mask = validMask(block);
+        for (std::size_t w = 0; w < Lanes; ++w)
+        {
+            const std::uint64_t satisfied = value[w] & mask[w];
+            if (satisfied == 0) continue;
+
+            const std::uint64_t assignment = block * ASSIGNMENTS_PER_BLOCK + w * 64 + std::countr_zero(satisfied);
+            std::uint64_t current = found.load();
+            while (assignment < current && !found.compare_exchange_weak(current, assignment)) {}
+            stop.store(true, std::memory_order_relaxed);
+            return;
+        }
+    }, &stop);
+
+    if (!stop.load()) return std::nullopt;
+    return found.load();
+}
+
+/**
+ * Checks if the Formula is true for every assignment
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @return True for a tautology
+ */
+template<std::size_t Lanes>
+bool BitSlicedEvaluator<Lanes>::isTautology() const
+{
+    return !counterexample().has_value();
+}
+
+/**
+ * Checks if the Formula is true for at least one assignment
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @return True if satisfiable
+ */
+template<std::size_t Lanes>
+bool BitSlicedEvaluator<Lanes>::isSatisfiable() const
+{
+    return model().has_value();
+}
+
+/**
+ * Checks if two Formulas agree on every assignment, i.e. if lhs <=> rhs is a tautology
+ * @tparam Lanes The number of 64-bit words evaluated per instruction
+ * @param lhs The first Formula
+ * @param rhs The second Formula
+ * @param threads The number of worker threads; 0 uses std::thread::hardware_concurrency()
+ * @return True if the Formulas are logically equivalent
+ */
+template<std::size_t Lanes>
+bool BitSlicedEvaluator<Lanes>::equivalent(const Formula& lhs, const Formula& rhs, unsigned threads)
+{
+    return BitSlicedEvaluator<Lanes>{lhs <=> rhs, threads}.isTautology();
+}
+
+#endif
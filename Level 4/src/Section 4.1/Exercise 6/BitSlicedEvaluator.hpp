@@ -0,0 +1,90 @@
+//
+// A BitSlicedEvaluator compiles a Formula into three-address instructions over a small register file and
+// evaluates 64 * Lanes assignments at once. Each register holds Lanes 64-bit words and bit k of a register
+// is the value of the sub-expression for assignment (block * 64 * Lanes + k), so a single AND of two
+// registers evaluates & for 256 assignments when Lanes == 4 (one AVX2 register, or two SSE2 registers).
+//
+// Registers are allocated by postfix stack depth, so the register file stays in L1 no matter how long
+// the Formula is. Full truth tables, model counts, tautology and equivalence checks split the blocks
+// across threads; the checks stop as soon as any thread finds a counterexample.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_BITSLICEDEVALUATOR_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_BITSLICEDEVALUATOR_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Formula.hpp"
+
+template<std::size_t Lanes = 4>
+class BitSlicedEvaluator
+{
+    static_assert(Lanes == 1 || Lanes == 2 || Lanes == 4 || Lanes == 8, "Lanes must be 1, 2, 4 or 8 words");
+
+public:
+    using Register = std::array<std::uint64_t, Lanes>;
+    static constexpr std::size_t ASSIGNMENTS_PER_BLOCK = 64 * Lanes;
+    static constexpr std::uint32_t MAX_VARIABLES = 48;
+
+private:
+    // dst = lhs op rhs; for Variable lhs is the variable index and for Constant it is 0 or 1
+    struct Instruction
+    {
+        Formula::OpCode op;
+        std::uint32_t dst;
+        std::uint32_t lhs;
+        std::uint32_t rhs;
+    };
+
+    std::vector<Instruction> code;
+    std::uint32_t registers;
+    std::uint32_t variables;
+    unsigned threads;
+
+    std::uint64_t blockCount() const noexcept;
+    Register validMask(std::uint64_t block) const noexcept;
+    void evaluate(std::uint64_t block, std::vector<Register>& file) const noexcept;
+
+    template<typename BlockFunction>
+    void forEachBlock(BlockFunction&& function, const std::atomic<bool>* stop = nullptr) const;
+
+public:
+    explicit BitSlicedEvaluator(const Formula& formula, unsigned threads = 0);
+    BitSlicedEvaluator(const BitSlicedEvaluator& source) = default;
+    BitSlicedEvaluator(BitSlicedEvaluator&& source) noexcept = default;
+    ~BitSlicedEvaluator() = default;
+
+    // Operator overloads
+    BitSlicedEvaluator& operator=(const BitSlicedEvaluator& source) = default;
+    BitSlicedEvaluator& operator=(BitSlicedEvaluator&& source) noexcept = default;
+
+    // Accessors
+    std::uint32_t variableCount() const noexcept { return variables; }
+    std::uint32_t registerCount() const noexcept { return registers; }
+    std::size_t instructionCount() const noexcept { return code.size(); }
+
+    // Core functionality
+    Register evaluateBlock(std::uint64_t block) const;
+    std::vector<std::uint64_t> truthTable() const;
+    std::uint64_t countModels() const;
+    std::optional<std::uint64_t> counterexample() const;
+    std::optional<std::uint64_t> model() const;
+    bool isTautology() const;
+    bool isSatisfiable() const;
+
+    static bool equivalent(const Formula& lhs, const Formula& rhs, unsigned threads = 0);
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_BITSLICEDEVALUATOR_CPP
+#include "BitSlicedEvaluator.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_BITSLICEDEVALUATOR_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_BITSLICEDEVALUATOR_HPP
@@ -0,0 +1,188 @@
+//
+// A Formula is a Proposition expression that has been recorded rather than evaluated. Each operator
+// appends to a flat postfix instruction list.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "Formula.hpp"
+
+/**
+ * Overloaded conversion ctor. Records a Proposition as a constant operand.
+ * @param constant The Proposition whose value becomes a constant in this Formula
+ */
+Formula::Formula(const Proposition& constant) : program{{OpCode::Constant, constant() ? 1U : 0U}}
+{
+
+}
+
+/**
+ * Creates a Formula consisting of a single variable. Variable i takes the value of bit i of the
+ * assignment number, so variable 0 alternates fastest when a truth table is enumerated.
+ * @param index The zero based index of the variable
+ * @return A new Formula
+ */
+Formula Formula::variable(std::uint32_t index)
+{
+    Formula f{Proposition{false}};
+    f.program.front() = Instruction{OpCode::Variable, index};
+    f.variables = index + 1;
+    return f;
+}
+
+/**
+ * Concatenates two postfix programs and appends a binary operator
+ * @param lhs The lhs operand
+ * @param rhs The rhs operand
+ * @param op The binary operator
+ * @return A new Formula
+ */
+Formula Formula::combine(const Formula& lhs, const Formula& rhs, OpCode op)
+{
+    Formula f{lhs};
+    f.program.reserve(lhs.program.size() + rhs.program.size() + 1);
+    f.program.insert(f.program.end(), rhs.program.begin(), rhs.program.end());
+    f.program.push_back(Instruction{op, 0});
+    f.variables = std::max(lhs.variables, rhs.variables);
+    return f;
+}
+
+/**
+ * Binary AND of two Formulas
+ * @param other The Formula used as the rhs
+ * @return A new Formula
+ */
+Formula Formula::operator&(const Formula& other) const
+{
+    return combine(*this, other, OpCode::And);
+}
+
+/**
+ * Binary OR of two Formulas
+ * @param other The Formula used as the rhs
+ * @return A new Formula
+ */
+Formula Formula::operator|(const Formula& other) const
+{
+    return combine(*this, other, OpCode::Or);
+}
+
+/**
+ * Binary XOR of two Formulas
+ * @param other The Formula used as the rhs
+ * @return A new Formula
+ */
+Formula Formula::operator^(const Formula& other) const
+{
+    return combine(*this, other, OpCode::Xor);
+}
+
+/**
+ * Unary negation of this Formula
+ * @return A new Formula
+ */
+Formula Formula::operator!() const
+{
+    Formula f{*this};
+    f.program.push_back(Instruction{OpCode::Not, 0});
+    return f;
+}
+
+/**
+ * Evaluates this Formula for a single assignment using the Proposition operators. This is the reference
+ * semantics that the bit-sliced evaluator must reproduce.
+ * @param assignment The value of each variable; must hold at least variableCount() Propositions
+ * @return The value of the Formula
+ */
+Proposition Formula::operator()(const std::vector<Proposition>& assignment) const
+{
+    if (assignment.size() < variables)
+    {
+        throw std::invalid_argument("Assignment has " + std::to_string(assignment.size()) + " values but the Formula uses " +
+                                    std::to_string(variables) + " variables");
+    }
+
+    std::vector<Proposition> stack;
+    stack.reserve(program.size());
+    for (const Instruction& instruction : program)
+    {
+        if (instruction.op == OpCode::Variable) { stack.push_back(assignment[instruction.operand]); continue; }
+        if (instruction.op == OpCode::Constant) { stack.emplace_back(instruction.operand != 0); continue; }
+        if (instruction.op == OpCode::Not) { stack.back() = !stack.back(); continue; }
+
+        Proposition rhs = stack.back();
+        stack.pop_back();
+        Proposition& lhs = stack.back();
+        switch (instruction.op)
+        {
+            case OpCode::And: lhs = lhs & rhs; break;
+            case OpCode::Or: lhs = lhs | rhs; break;
+            case OpCode::Xor: lhs = lhs ^ rhs; break;
+            case OpCode::Implies: lhs = lhs % rhs; break;
+            case OpCode::Iff: lhs = lhs <=> rhs; break;
+            default: break;
+        }
+    }
+
+    return stack.back();
+}
+
+// ********** Friend function definitions **********
+
+/**
+ * Conditional of two Formulas (e.g. "lhs implies rhs")
+ * @param lhs The Formula used as the lhs
+ * @param rhs The Formula used as the rhs
+ * @return A new Formula
+ */
+Formula operator%(const Formula& lhs, const Formula& rhs)
+{
+    return Formula::combine(lhs, rhs, Formula::OpCode::Implies);
+}
+
+/**
+ * Bi-Conditional of two Formulas (e.g. "lhs iff rhs")
+ * @param lhs The Formula used as the lhs
+ * @param rhs The Formula used as the rhs
+ * @return A new Formula
+ */
+Formula operator<=>(const Formula& lhs, const Formula& rhs)
+{
+    return Formula::combine(lhs, rhs, Formula::OpCode::Iff);
+}
+
+/**
+ * Inserts the Formula in fully parenthesised infix form, with variables written as x0, x1, ...
+ * @param out The output stream
+ * @param formula The Formula to insert
+ * @return The output stream
+ */
+std::ostream& operator<<(std::ostream& out, const Formula& formula)
+{
+    std::vector<std::string> stack;
+    for (const Formula::Instruction& instruction : formula.program)
+    {
+        switch (instruction.op)
+        {
+            case Formula::OpCode::Variable: stack.push_back("x" + std::to_string(instruction.operand)); continue;
+            case Formula::OpCode::Constant: stack.emplace_back(instruction.operand ? "1" : "0"); continue;
+            case Formula::OpCode::Not: stack.back() = "!" + stack.back(); continue;
+            default: break;
+        }
+
+        std::string rhs = std::move(stack.back());
+        stack.pop_back();
+        const char* symbol = instruction.op == Formula::OpCode::And ? " & "
+                           : instruction.op == Formula::OpCode::Or ? " | "
+                           : instruction.op == Formula::OpCode::Xor ? " ^ "
+                           : instruction.op == Formula::OpCode::Implies ? " -> " : " <-> ";
+        stack.back() = "(" + stack.back() + symbol + rhs + ")";
+    }
+
+    out << stack.back();
+    return out;
+}
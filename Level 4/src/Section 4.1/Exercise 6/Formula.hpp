@@ -0,0 +1,65 @@
+//
+// A Formula is a Proposition expression that has been recorded rather than evaluated. Variables are
+// combined with the same operators as Proposition (&, |, ^, !, % and <=>) and each combination appends to
+// a flat postfix instruction list, so an expression such as [A -> (B -> C)] <-> [(A & B) -> C] is written
+// exactly as it is with Propositions but can be evaluated for every assignment of its variables.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_FORMULA_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_FORMULA_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "Proposition.hpp"
+
+class Formula
+{
+public:
+    enum class OpCode : std::uint8_t { Variable, Constant, And, Or, Xor, Not, Implies, Iff };
+
+    // One postfix instruction. operand is the variable index for Variable and 0/1 for Constant.
+    struct Instruction
+    {
+        OpCode op;
+        std::uint32_t operand;
+    };
+
+private:
+    std::vector<Instruction> program;
+    std::uint32_t variables = 0;
+
+    static Formula combine(const Formula& lhs, const Formula& rhs, OpCode op);
+
+public:
+    Formula() = delete;
+    Formula(const Proposition& constant);  // Conversion ctor so Propositions can appear as constants
+    Formula(const Formula& source) = default;
+    Formula(Formula&& source) noexcept = default;
+    ~Formula() = default;
+
+    static Formula variable(std::uint32_t index);
+
+    // Operator overloads
+    Formula& operator=(const Formula& source) = default;
+    Formula& operator=(Formula&& source) noexcept = default;
+    Formula operator&(const Formula& other) const;
+    Formula operator|(const Formula& other) const;
+    Formula operator^(const Formula& other) const;
+    Formula operator!() const;
+    Proposition operator()(const std::vector<Proposition>& assignment) const;
+
+    // Accessors
+    const std::vector<Instruction>& postfix() const noexcept { return program; }
+    std::uint32_t variableCount() const noexcept { return variables; }
+
+    // Friends
+    friend Formula operator%(const Formula& lhs, const Formula& rhs);
+    friend Formula operator<=>(const Formula& lhs, const Formula& rhs);
+    friend std::ostream& operator<<(std::ostream& out, const Formula& formula);
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_FORMULA_HPP
@@ -0,0 +1,169 @@
+//
+// Tests for the Formula builder and the BitSlicedEvaluator. Every bit-sliced result is checked against
+// the scalar Proposition semantics, and a rule-set style benchmark compares the two approaches.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <cassert>
+#include <iostream>
+#include <random>
+
+#include "BitSlicedEvaluator.hpp"
+#include "Formula.hpp"
+#include "Proposition.hpp"
+#include "StopWatch.hpp"
+
+// Unpacks assignment number k into one Proposition per variable
+std::vector<Proposition> assignment(std::uint64_t k, std::uint32_t variables)
+{
+    std::vector<Proposition> values;
+    for (std::uint32_t i = 0; i < variables; ++i) values.emplace_back(((k >> i) & 1U) != 0);
+    return values;
+}
+
+// Builds a random Formula over the given number of variables
+Formula randomFormula(std::uint32_t variables, int depth, std::mt19937& engine)
+{
+    std::uniform_int_distribution<std::uint32_t> pickVariable{0, variables - 1};
+    std::uniform_int_distribution<int> pickOp{0, 5};
+    if (depth == 0) return Formula::variable(pickVariable(engine));
+
+    Formula lhs = randomFormula(variables, depth - 1, engine);
+    Formula rhs = randomFormula(variables, depth - 1, engine);
+    switch (pickOp(engine))
+    {
+        case 0: return lhs & rhs;
+        case 1: return lhs | rhs;
+        case 2: return lhs ^ rhs;
+        case 3: return lhs % rhs;
+        case 4: return lhs <=> rhs;
+        default: return !lhs;
+    }
+}
+
+// [x0 -> x1] & [x1 -> x2] & ... & [x(n-2) -> x(n-1)]  ->  [x0 -> x(n-1)]
+Formula implicationChain(std::uint32_t variables)
+{
+    Formula rules = Formula::variable(0) % Formula::variable(1);
+    for (std::uint32_t i = 1; i + 1 < variables; ++i) rules = rules & (Formula::variable(i) % Formula::variable(i + 1));
+    return rules % (Formula::variable(0) % Formula::variable(variables - 1));
+}
+
+// Formulas evaluate exactly like the Propositions they were built from
+void test_ScalarEvaluation()
+{
+    Formula a = Formula::variable(0);
+    Formula b = Formula::variable(1);
+    Formula f = (a & !b) | (Formula{Proposition{true}} ^ a);
+    assert(2 == f.variableCount());
+
+    for (std::uint64_t k = 0; k < 4; ++k)
+    {
+        auto v = assignment(k, 2);
+        assert(f(v) == ((v[0] & !v[1]) | (Proposition{true} ^ v[0])));
+    }
+}
+
+// The truth table of each variable is the expected alternating pattern, for 1 and 4 lanes
+void test_TruthTable()
+{
+    std::mt19937 engine{42};
+    for (std::uint32_t variables : {1U, 3U, 7U, 9U, 12U})
+    {
+        Formula f = randomFormula(variables, 5, engine);
+        std::uint32_t n = f.variableCount();
+        auto table64 = BitSlicedEvaluator<1>{f}.truthTable();
+        auto table256 = BitSlicedEvaluator<4>{f}.truthTable();
+        assert(table64 == table256);
+
+        for (std::uint64_t k = 0; k < (std::uint64_t{1} << n); ++k)
+        {
+            const bool expected = f(assignment(k, n))();
+            assert(expected == (((table256[k / 64] >> (k % 64)) & 1U) != 0));
+        }
+    }
+}
+
+// Model counts agree with brute force evaluation
+void test_CountModels()
+{
+    std::mt19937 engine{7};
+    for (int trial = 0; trial < 20; ++trial)
+    {
+        Formula f = randomFormula(10, 6, engine);
+        std::uint32_t n = f.variableCount();
+        std::uint64_t expected = 0;
+        for (std::uint64_t k = 0; k < (std::uint64_t{1} << n); ++k) expected += f(assignment(k, n))() ? 1 : 0;
+        assert(expected == (BitSlicedEvaluator<4>{f, 2}.countModels()));
+    }
+}
+
+// [A -> (B -> C)] <-> [(A & B) -> C] is a tautology, DeMorgan's laws are equivalences
+void test_TautologyAndEquivalence()
+{
+    Formula a = Formula::variable(0);
+    Formula b = Formula::variable(1);
+    Formula c = Formula::variable(2);
+
+    assert(BitSlicedEvaluator<>{(a % (b % c)) <=> ((a & b) % c)}.isTautology());
+    assert(BitSlicedEvaluator<>::equivalent(!(a | b), (!a) & (!b)));
+    assert(BitSlicedEvaluator<>::equivalent(!(a & b), (!a) | (!b)));
+    assert(BitSlicedEvaluator<>::equivalent(a & (b | c), (a & b) | (a & c)));
+    assert(!BitSlicedEvaluator<>::equivalent(a % b, b % a));
+
+    // A -> B is falsified only by A = 1, B = 0, i.e. assignment 1
+    BitSlicedEvaluator<> implication{a % b};
+    assert(1 == implication.counterexample().value());
+    assert(implication.isSatisfiable());
+    assert(!BitSlicedEvaluator<>{a & !a}.isSatisfiable());
+
+    // The long implication chain is valid, breaking one link makes it fail early
+    assert(BitSlicedEvaluator<>{implicationChain(20)}.isTautology());
+    Formula broken = implicationChain(20) & Formula::variable(0) & !Formula::variable(19);
+    assert(!BitSlicedEvaluator<>{broken}.isTautology());
+}
+
+// Validates the implication chain rule set one assignment at a time and bit-sliced
+void benchmark_RuleSet(std::uint32_t variables, std::uint32_t scalarVariables)
+{
+    Formula rules = implicationChain(variables);
+
+    StopWatch stopWatch;
+    stopWatch.Start();
+    bool bitSliced = BitSlicedEvaluator<>{rules}.isTautology();
+    stopWatch.Stop();
+    double bitSlicedMs = 1e3 * stopWatch.ElapsedTime();
+
+    // The scalar check covers only 2^scalarVariables assignments; extrapolate to the full table
+    Formula smaller = implicationChain(scalarVariables);
+    stopWatch.Start();
+    bool scalar = true;
+    for (std::uint64_t k = 0; k < (std::uint64_t{1} << scalarVariables) && scalar; ++k)
+    {
+        scalar = smaller(assignment(k, scalarVariables))();
+    }
+    stopWatch.Stop();
+    double scalarMs = 1e3 * stopWatch.ElapsedTime();
+    double extrapolated = scalarMs * static_cast<double>(std::uint64_t{1} << (variables - scalarVariables)) *
+                          static_cast<double>(variables) / static_cast<double>(scalarVariables);
+
+    std::cout << variables << " variable rule set: bit-sliced " << bitSlicedMs << "ms (tautology=" << bitSliced
+              << "), scalar Proposition ~" << extrapolated / 1000.0 << "s extrapolated from 2^" << scalarVariables
+              << " assignments (tautology=" << scalar << ")" << std::endl;
+}
+
+int main()
+{
+    test_ScalarEvaluation();
+    test_TruthTable();
+    test_CountModels();
+    test_TautologyAndEquivalence();
+
+    benchmark_RuleSet(24, 16);
+    benchmark_RuleSet(28, 16);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
@@ -20,7 +20,8 @@ using UnaryPredicate = std::function<int (int)>;
 // searches for the first and last index that are less than or equal to and greater than the target value
 Result find_sequential_greater(const Vector& v, value_type x)
 {
-    for (std::size_t j = 0; j < v.size(); ++j)
+    // Stop one short of the end: v[j+1] must exist
+    for (std::size_t j = 0; j + 1 < v.size(); ++j)
     {
         if (v[j] <= x && v[j+1] > x)
         {
@@ -111,6 +112,11 @@ void test_find_sequential_greater()
     assert(3 == first);
     assert(4 == second);
     assert(found);
+
+    // No element follows the last one, so a target at or above it is not found
+    target = 5;
+    result = find_sequential_greater(v1, target);
+    assert(!std::get<1>(result));
 }
 
 // Test functionality for finding a target value as specified by a given predicate
@@ -0,0 +1,229 @@
+//
+// Ranges of subsets, combinations and permutations: construction, slices, and ranking
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <stdexcept>
+#include <string>
+
+#include "Combinatorics.hpp"
+
+/**
+ * Overloaded ctor: all subsets of {0, ..., n - 1}
+ * @param n The number of elements
+ * @throws std::invalid_argument if n is above 63
+ */
+Subsets::Subsets(unsigned int n) : n{n}, first{0}, last{0}
+{
+    if (n > MAX_ELEMENTS) throw std::invalid_argument("Subsets of at most 63 elements, not " + std::to_string(n));
+    last = std::uint64_t{1} << n;
+}
+
+/**
+ * @param begin The first position of the slice
+ * @param end One past the last position of the slice
+ * @return The subsets at positions [begin, end) of this range
+ * @throws std::out_of_range if the slice is not within the range
+ */
+Subsets Subsets::slice(std::uint64_t begin, std::uint64_t end) const
+{
+    if (begin > end || end > size())
+    {
+        throw std::out_of_range("Slice [" + std::to_string(begin) + ", " + std::to_string(end) + ") of " + std::to_string(size()) + " subsets");
+    }
+    Subsets result = *this;
+    result.first = first + begin;
+    result.last = first + end;
+    return result;
+}
+
+/**
+ * @param mask A subset
+ * @return Its rank in Gray code order, the inverse of unrank()
+ */
+std::uint64_t Subsets::rank(std::uint64_t mask) noexcept
+{
+    for (int shift = 1; shift < 64; shift *= 2) mask ^= mask >> shift;
+    return mask;
+}
+
+/**
+ * Overloaded ctor: all subsets of k elements of {0, ..., n - 1}
+ * @param n The number of elements
+ * @param k The number chosen
+ * @throws std::invalid_argument if n is above 64 or k above n
+ */
+Combinations::Combinations(unsigned int n, unsigned int k) : n{n}, k{k}, first{0}, last{0}
+{
+    if (n > MAX_ELEMENTS || k > n)
+    {
+        throw std::invalid_argument("Combinations of " + std::to_string(k) + " of " + std::to_string(n) + " elements");
+    }
+    last = binomial(n, k);
+}
+
+/**
+ * @return Pascal's triangle up to row 64, whose largest entry C(64, 32) fits in 64 bits
+ */
+const std::array<std::array<std::uint64_t, Combinations::MAX_ELEMENTS + 1>, Combinations::MAX_ELEMENTS + 1>& Combinations::binomials()
+{
+    static const auto table = []
+    {
+        std::array<std::array<std::uint64_t, MAX_ELEMENTS + 1>, MAX_ELEMENTS + 1> rows{};
+        for (std::size_t n = 0; n <= MAX_ELEMENTS; ++n)
+        {
+            rows[n][0] = 1;
+            for (std::size_t k = 1; k <= n; ++k) rows[n][k] = rows[n - 1][k - 1] + rows[n - 1][k];
+        }
+        return rows;
+    }();
+    return table;
+}
+
+/**
+ * @param begin The first position of the slice
+ * @param end One past the last position of the slice
+ * @return The combinations at positions [begin, end) of this range
+ * @throws std::out_of_range if the slice is not within the range
+ */
+Combinations Combinations::slice(std::uint64_t begin, std::uint64_t end) const
+{
+    if (begin > end || end > size())
+    {
+        throw std::out_of_range("Slice [" + std::to_string(begin) + ", " + std::to_string(end) + ") of " + std::to_string(size()) + " combinations");
+    }
+    Combinations result = *this;
+    result.first = first + begin;
+    result.last = first + end;
+    return result;
+}
+
+/**
+ * @param n The number of elements, at most 64
+ * @param k The number chosen
+ * @return C(n, k), 0 if k > n
+ */
+std::uint64_t Combinations::binomial(unsigned int n, unsigned int k) noexcept
+{
+    return k > n ? 0 : binomials()[n][k];
+}
+
+/**
+ * The combinatorial number system: elements c1 < c2 < ... < ck have rank C(c1, 1) + C(c2, 2) + ... + C(ck, k)
+ * @param mask A combination
+ * @return Its rank in colexicographic order among the combinations of as many elements
+ */
+std::uint64_t Combinations::rank(std::uint64_t mask) noexcept
+{
+    std::uint64_t result = 0;
+    for (unsigned int i = 1; mask != 0; ++i, mask &= mask - 1)
+    {
+        result += binomials()[static_cast<std::size_t>(std::countr_zero(mask))][i];
+    }
+    return result;
+}
+
+/**
+ * Takes the largest element c with C(c, k) <= rank, then the largest below it with C(c', k - 1) <= the rest,
+ * and so on: one pass down the 64 positions
+ * @param k The number chosen
+ * @param rank A rank below C(64, k)
+ * @return The combination of k elements with that rank in colexicographic order
+ */
+std::uint64_t Combinations::unrank(unsigned int k, std::uint64_t rank) noexcept
+{
+    std::uint64_t mask = 0;
+    std::size_t c = MAX_ELEMENTS;
+    for (unsigned int i = k; i > 0; --i)
+    {
+        do --c; while (binomials()[c][i] > rank);
+        rank -= binomials()[c][i];
+        mask |= std::uint64_t{1} << c;
+    }
+    return mask;
+}
+
+/**
+ * Overloaded ctor: all permutations of {0, ..., n - 1}
+ * @param n The number of elements
+ * @throws std::invalid_argument if n is above 20
+ */
+Permutations::Permutations(unsigned int n) : n{n}, first{0}, last{0}
+{
+    if (n > MAX_ELEMENTS) throw std::invalid_argument("Permutations of at most 20 elements, not " + std::to_string(n));
+    last = factorial(n);
+}
+
+/**
+ * @param begin The first position of the slice
+ * @param end One past the last position of the slice
+ * @return The permutations at positions [begin, end) of this range
+ * @throws std::out_of_range if the slice is not within the range
+ */
+Permutations Permutations::slice(std::uint64_t begin, std::uint64_t end) const
+{
+    if (begin > end || end > size())
+    {
+        throw std::out_of_range("Slice [" + std::to_string(begin) + ", " + std::to_string(end) + ") of " + std::to_string(size()) + " permutations");
+    }
+    Permutations result = *this;
+    result.first = first + begin;
+    result.last = first + end;
+    return result;
+}
+
+/**
+ * @param n At most 20
+ * @return n!
+ */
+std::uint64_t Permutations::factorial(unsigned int n) noexcept
+{
+    std::uint64_t result = 1;
+    for (unsigned int i = 2; i <= n; ++i) result *= i;
+    return result;
+}
+
+/**
+ * The Lehmer code: the number of smaller elements after each entry, read as digits in the factorial base
+ * @param permutation A permutation of {0, ..., n - 1}, n at most 20
+ * @return Its rank in lexicographic order
+ */
+std::uint64_t Permutations::rank(std::span<const std::uint8_t> permutation) noexcept
+{
+    std::uint64_t result = 0;
+    std::uint32_t unused = (std::uint32_t{1} << permutation.size()) - 1;
+    for (std::size_t i = 0; i < permutation.size(); ++i)
+    {
+        const std::uint32_t bit = std::uint32_t{1} << permutation[i];
+        result = result * (permutation.size() - i) + static_cast<std::uint64_t>(std::popcount(unused & (bit - 1)));
+        unused &= ~bit;
+    }
+    return result;
+}
+
+/**
+ * @param n The number of elements, at most 20
+ * @param rank A rank below n!
+ * @return The permutation with that rank in lexicographic order, in the first n entries
+ */
+Permutations::Permutation Permutations::unrank(unsigned int n, std::uint64_t rank) noexcept
+{
+    Permutation result{};
+    std::uint32_t unused = (std::uint32_t{1} << n) - 1;
+    std::uint64_t weight = factorial(n);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        weight /= n - i;
+        auto digit = static_cast<unsigned int>(rank / weight);
+        rank %= weight;
+
+        // The digit-th element still unused
+        std::uint32_t candidates = unused;
+        for (; digit > 0; --digit) candidates &= candidates - 1;
+        const int element = std::countr_zero(candidates);
+        result[i] = static_cast<std::uint8_t>(element);
+        unused &= ~(std::uint32_t{1} << element);
+    }
+    return result;
+}
@@ -0,0 +1,262 @@
+//
+// Lazy ranges over the subsets, k-combinations and permutations of n elements. Part C builds the power set
+// as a std::set of std::sets, copying and re-inserting every subset for every element: a node allocation
+// per element of every subset, and O(2^n n log) comparisons. Here a subset is a 64-bit mask, element i
+// being in it when bit i is set, and the ranges generate the masks (or permutations) one step at a time
+// without allocating:
+//
+// - Subsets: the 2^n subsets in Gray code order, rank r being r ^ (r >> 1). Consecutive subsets differ in
+//   one element, changed(), so work over all subsets such as a basket's total weight can be updated in O(1)
+//   per subset instead of recomputed in O(n).
+// - Combinations: the C(n, k) subsets of k elements in colexicographic order, i.e. increasing masks; the
+//   next mask is Gosper's hack, a few integer operations.
+// - Permutations: the n! orderings of 0, ..., n - 1 in lexicographic order; std::next_permutation takes
+//   O(1) swaps on average.
+//
+// Each range has rank() and unrank() between positions and elements (the Gray code, the combinatorial
+// number system and the Lehmer code), so slice() can start anywhere in O(n). forEachPart() cuts a range
+// into contiguous slices of ranks, one per thread, and hands each slice to a thread.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_COMBINATORICS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_COMBINATORICS_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <thread>
+#include <vector>
+
+class Subsets
+{
+public:
+    static constexpr unsigned int MAX_ELEMENTS = 63;        // 2^n subsets must be countable
+
+    // Forward iterator over the masks of a rank interval
+    class Iterator
+    {
+    private:
+        std::uint64_t rank;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::uint64_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::uint64_t*;
+        using reference = std::uint64_t;
+
+        Iterator() noexcept : rank{0} {}
+        explicit Iterator(std::uint64_t rank) noexcept : rank{rank} {}
+
+        std::uint64_t operator*() const noexcept { return rank ^ rank >> 1; }
+        Iterator& operator++() noexcept { ++rank; return *this; }
+        Iterator operator++(int) noexcept { Iterator copy = *this; ++rank; return copy; }
+        bool operator==(const Iterator& other) const noexcept { return rank == other.rank; }
+
+        std::uint64_t index() const noexcept { return rank; }
+        // The element added or removed by the last ++: the lowest set bit of the rank
+        unsigned int changed() const noexcept { return static_cast<unsigned int>(std::countr_zero(rank)); }
+    };
+
+private:
+    unsigned int n;
+    std::uint64_t first;        // Ranks of the slice
+    std::uint64_t last;
+
+public:
+    explicit Subsets(unsigned int n);
+    Subsets(const Subsets& source) = default;
+    Subsets(Subsets&& source) noexcept = default;
+    ~Subsets() = default;
+
+    // Operator overloads
+    Subsets& operator=(const Subsets& source) = default;
+    Subsets& operator=(Subsets&& source) noexcept = default;
+    std::uint64_t operator[](std::uint64_t index) const noexcept { return unrank(first + index); }
+
+    // Accessors
+    unsigned int elements() const noexcept { return n; }
+    std::uint64_t size() const noexcept { return last - first; }
+    Iterator begin() const noexcept { return Iterator{first}; }
+    Iterator end() const noexcept { return Iterator{last}; }
+
+    // Core functionality
+    Subsets slice(std::uint64_t begin, std::uint64_t end) const;
+    static std::uint64_t rank(std::uint64_t mask) noexcept;
+    static std::uint64_t unrank(std::uint64_t rank) noexcept { return rank ^ rank >> 1; }
+};
+
+class Combinations
+{
+public:
+    static constexpr unsigned int MAX_ELEMENTS = 64;
+
+    // Forward iterator over the masks of a rank interval
+    class Iterator
+    {
+    private:
+        std::uint64_t rank;
+        std::uint64_t mask;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::uint64_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::uint64_t*;
+        using reference = std::uint64_t;
+
+        Iterator() noexcept : rank{0}, mask{0} {}
+        Iterator(std::uint64_t rank, std::uint64_t mask) noexcept : rank{rank}, mask{mask} {}
+
+        std::uint64_t operator*() const noexcept { return mask; }
+        Iterator& operator++() noexcept { ++rank; mask = next(mask); return *this; }
+        Iterator operator++(int) noexcept { Iterator copy = *this; ++*this; return copy; }
+        bool operator==(const Iterator& other) const noexcept { return rank == other.rank; }
+
+        std::uint64_t index() const noexcept { return rank; }
+    };
+
+private:
+    unsigned int n;
+    unsigned int k;
+    std::uint64_t first;
+    std::uint64_t last;
+
+    static const std::array<std::array<std::uint64_t, MAX_ELEMENTS + 1>, MAX_ELEMENTS + 1>& binomials();
+
+public:
+    Combinations(unsigned int n, unsigned int k);
+    Combinations(const Combinations& source) = default;
+    Combinations(Combinations&& source) noexcept = default;
+    ~Combinations() = default;
+
+    // Operator overloads
+    Combinations& operator=(const Combinations& source) = default;
+    Combinations& operator=(Combinations&& source) noexcept = default;
+    std::uint64_t operator[](std::uint64_t index) const noexcept { return unrank(k, first + index); }
+
+    // Accessors
+    unsigned int elements() const noexcept { return n; }
+    unsigned int chosen() const noexcept { return k; }
+    std::uint64_t size() const noexcept { return last - first; }
+    Iterator begin() const noexcept { return Iterator{first, unrank(k, first)}; }
+    Iterator end() const noexcept { return Iterator{last, 0}; }
+
+    // Core functionality
+    Combinations slice(std::uint64_t begin, std::uint64_t end) const;
+    static std::uint64_t binomial(unsigned int n, unsigned int k) noexcept;
+    static std::uint64_t rank(std::uint64_t mask) noexcept;
+    static std::uint64_t unrank(unsigned int k, std::uint64_t rank) noexcept;
+
+    // The next larger mask with as many bits set (Gosper's hack); the shift is split so that it stays below 64
+    static std::uint64_t next(std::uint64_t mask) noexcept
+    {
+        const std::uint64_t ones = mask | (mask - 1);
+        return (ones + 1) | (((~ones & (ones + 1)) - 1) >> (std::countr_zero(mask) & 63) >> 1);
+    }
+};
+
+class Permutations
+{
+public:
+    static constexpr unsigned int MAX_ELEMENTS = 20;        // 20! < 2^64
+    using Permutation = std::array<std::uint8_t, MAX_ELEMENTS>;
+
+    // Forward iterator over the permutations of a rank interval; each one is a view of the first n entries
+    class Iterator
+    {
+    private:
+        std::uint64_t rank;
+        unsigned int n;
+        Permutation permutation;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::span<const std::uint8_t>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::span<const std::uint8_t>;
+
+        Iterator() noexcept : rank{0}, n{0}, permutation{} {}
+        Iterator(std::uint64_t rank, unsigned int n, const Permutation& permutation) noexcept
+            : rank{rank}, n{n}, permutation{permutation}
+        {
+        }
+
+        std::span<const std::uint8_t> operator*() const noexcept { return {permutation.data(), n}; }
+        Iterator& operator++() noexcept
+        {
+            ++rank;
+            std::next_permutation(permutation.begin(), permutation.begin() + n);
+            return *this;
+        }
+        Iterator operator++(int) noexcept { Iterator copy = *this; ++*this; return copy; }
+        bool operator==(const Iterator& other) const noexcept { return rank == other.rank; }
+
+        std::uint64_t index() const noexcept { return rank; }
+    };
+
+private:
+    unsigned int n;
+    std::uint64_t first;
+    std::uint64_t last;
+
+public:
+    explicit Permutations(unsigned int n);
+    Permutations(const Permutations& source) = default;
+    Permutations(Permutations&& source) noexcept = default;
+    ~Permutations() = default;
+
+    // Operator overloads
+    Permutations& operator=(const Permutations& source) = default;
+    Permutations& operator=(Permutations&& source) noexcept = default;
+    Permutation operator[](std::uint64_t index) const noexcept { return unrank(n, first + index); }
+
+    // Accessors
+    unsigned int elements() const noexcept { return n; }
+    std::uint64_t size() const noexcept { return last - first; }
+    Iterator begin() const noexcept { return first == last ? end() : Iterator{first, n, unrank(n, first)}; }
+    Iterator end() const noexcept { return Iterator{last, n, Permutation{}}; }
+
+    // Core functionality
+    Permutations slice(std::uint64_t begin, std::uint64_t end) const;
+    static std::uint64_t factorial(unsigned int n) noexcept;
+    static std::uint64_t rank(std::span<const std::uint8_t> permutation) noexcept;
+    static Permutation unrank(unsigned int n, std::uint64_t rank) noexcept;
+};
+
+/**
+ * Cuts a range into one slice of consecutive ranks per thread, as equal as possible, and calls work(slice, t)
+ * for slice t on thread t, the calling thread taking slice 0. Each thread can keep its own accumulator
+ * indexed by t and iterate its slice, so the threads share nothing while they enumerate.
+ * @tparam Range Subsets, Combinations or Permutations
+ * @tparam Work Callable as work(const Range&, unsigned int)
+ * @param range The range
+ * @param work The work over one slice
+ * @param threads The number of slices and threads; 0 (hardware_concurrency() unknown) means one
+ */
+template<typename Range, typename Work>
+void forEachPart(const Range& range, Work&& work, unsigned int threads = std::thread::hardware_concurrency())
+{
+    threads = std::max(1u, threads);
+    const std::uint64_t share = range.size() / threads;
+    const std::uint64_t extra = range.size() % threads;
+    auto part = [&](unsigned int t)
+    {
+        const std::uint64_t begin = share * t + std::min<std::uint64_t>(t, extra);
+        work(range.slice(begin, begin + share + (t < extra ? 1 : 0)), t);
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < threads; ++t) workers.emplace_back(part, t);
+    part(0);
+    for (std::thread& worker : workers) worker.join();
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_COMBINATORICS_HPP
@@ -4,14 +4,29 @@
 // Note - Algorithms that modify the values are classified as Modifying algorithms. Mutating algorithms
 // are a special case of Modifying.
 //
+// Part C's power set is checked against the bitmask ranges of Combinatorics.hpp, which are tested for order,
+// rank and unrank against brute force and std::next_permutation, and for slices shared out over threads.
+// The benchmark picks baskets of instruments under a budget from every subset, once with Part C's sets of
+// sets and once with the Gray code ranges, and reports nanoseconds per subset.
+//
 // Created by Michael Lewis on 7/17/23.
 //
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
 #include <iostream>
+#include <numeric>
 #include <set>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
+#include "Combinatorics.hpp"
+#include "StopWatch.hpp"
+
 // Define container aliases
 using Set = std::set<int>;
 using PowerSet = std::set<Set>;
@@ -51,9 +66,8 @@ void test_rotate()
 
 // Part C - Write a function to compute the power set of S = {1,-1,7,8,9,10}
 // (that is, the set of all subsets of S containing elements). 2^6=64 subsets
-void test_power_set()
+PowerSet power_set(const Set& S)
 {
-    Set S{1,-1,7,8,9,10};
     PowerSet powerSet;
 
     for (auto element : S)
@@ -68,6 +82,13 @@ void test_power_set()
         powerSet.insert(Set{element});
     }
     powerSet.insert(Set{}); // Add the null set.
+    return powerSet;
+}
+
+void test_power_set()
+{
+    Set S{1,-1,7,8,9,10};
+    PowerSet powerSet = power_set(S);
 
     // Log the power set
     std::cout << "\nPower set: \n";
@@ -97,11 +118,280 @@ void test_move_set_to_front()
     }
 }
 
+// The same power set from the masks of Subsets: element i of the vector is in the subset when bit i is set
+void test_power_set_bitmask()
+{
+    const Vector V{1,-1,7,8,9,10};
+    PowerSet powerSet;
+    for (std::uint64_t mask : Subsets(static_cast<unsigned int>(V.size())))
+    {
+        Set subset;
+        for (std::size_t i = 0; i < V.size(); ++i)
+        {
+            if (mask >> i & 1) subset.insert(V[i]);
+        }
+        powerSet.insert(subset);
+    }
+    assert(powerSet.size() == 64);
+    assert(powerSet == power_set(Set(V.cbegin(), V.cend())));
+}
+
+// Gray code order: every subset once, one element changed per step, rank and unrank inverse
+void test_Subsets()
+{
+    for (unsigned int n = 0; n <= 12; ++n)
+    {
+        const Subsets subsets(n);
+        assert(subsets.size() == std::uint64_t{1} << n && subsets.elements() == n);
+        std::vector<bool> seen(subsets.size(), false);
+        std::uint64_t previous = 0;
+        for (auto it = subsets.begin(); it != subsets.end(); ++it)
+        {
+            const std::uint64_t mask = *it;
+            assert(mask < subsets.size() && !seen[mask]);
+            seen[mask] = true;
+            assert(Subsets::rank(mask) == it.index() && subsets[it.index()] == mask);
+            if (it.index() > 0) assert((mask ^ previous) == std::uint64_t{1} << it.changed());
+            previous = mask;
+        }
+    }
+
+    const Subsets large(63);
+    assert(large.size() == std::uint64_t{1} << 63);
+    for (std::uint64_t rank : {std::uint64_t{0}, std::uint64_t{12345678901234}, large.size() - 1})
+    {
+        assert(Subsets::rank(Subsets::unrank(rank)) == rank);
+    }
+
+    // A slice continues the order from any rank
+    const Subsets slice = large.slice(1000, 1010);
+    std::uint64_t rank = 1000;
+    for (std::uint64_t mask : slice) assert(mask == Subsets::unrank(rank++));
+    assert(rank == 1010 && slice.slice(2, 2).size() == 0);
+}
+
+// Colexicographic order: the masks with k bits set in increasing order, ranked by the combinatorial number system
+void test_Combinations()
+{
+    for (unsigned int n = 0; n <= 12; ++n)
+    {
+        for (unsigned int k = 0; k <= n; ++k)
+        {
+            std::vector<std::uint64_t> expected;
+            for (std::uint64_t mask = 0; mask < std::uint64_t{1} << n; ++mask)
+            {
+                if (std::popcount(mask) == static_cast<int>(k)) expected.push_back(mask);
+            }
+
+            const Combinations combinations(n, k);
+            assert(combinations.size() == expected.size() && Combinations::binomial(n, k) == expected.size());
+            std::size_t i = 0;
+            for (auto it = combinations.begin(); it != combinations.end(); ++it, ++i)
+            {
+                assert(*it == expected[i] && it.index() == i);
+                assert(Combinations::rank(*it) == i && Combinations::unrank(k, i) == *it);
+            }
+            assert(i == expected.size());
+        }
+    }
+
+    assert(Combinations::binomial(64, 32) == 1832624140942590534u && Combinations::binomial(3, 4) == 0);
+
+    // All 64 elements: the last step must not overflow
+    std::uint64_t count = 0;
+    for (std::uint64_t mask : Combinations(64, 1)) assert(mask == std::uint64_t{1} << count++);
+    assert(count == 64);
+    const Combinations full(64, 64);
+    assert(full.size() == 1 && *full.begin() == ~std::uint64_t{0});
+    const Combinations half(64, 32);
+    const std::uint64_t last = half[half.size() - 1];
+    assert(last == 0xFFFFFFFF00000000 && Combinations::rank(last) == half.size() - 1);
+
+    std::uint64_t rank = 500000;
+    for (std::uint64_t mask : half.slice(rank, rank + 100)) assert(Combinations::rank(mask) == rank++);
+}
+
+// Lexicographic order, the same as std::next_permutation, ranked by the Lehmer code
+void test_Permutations()
+{
+    for (unsigned int n = 0; n <= 7; ++n)
+    {
+        std::vector<std::uint8_t> expected(n);
+        std::iota(expected.begin(), expected.end(), std::uint8_t{0});
+        const Permutations permutations(n);
+        assert(permutations.size() == Permutations::factorial(n));
+        std::uint64_t i = 0;
+        for (auto it = permutations.begin(); it != permutations.end(); ++it, ++i)
+        {
+            const std::span<const std::uint8_t> permutation = *it;
+            assert(std::equal(permutation.begin(), permutation.end(), expected.begin(), expected.end()));
+            assert(Permutations::rank(permutation) == i);
+            const Permutations::Permutation unranked = permutations[i];
+            assert(std::equal(expected.begin(), expected.end(), unranked.begin()));
+            std::next_permutation(expected.begin(), expected.end());
+        }
+        assert(i == permutations.size());
+    }
+
+    const Permutations large(20);
+    const Permutations::Permutation last = large[large.size() - 1];
+    for (unsigned int i = 0; i < 20; ++i) assert(last[i] == 19 - i);
+    assert(Permutations::rank(std::span<const std::uint8_t>(last.data(), 20)) == large.size() - 1);
+
+    const Permutations slice = large.slice(large.size() - 3, large.size());
+    std::uint64_t rank = large.size() - 3;
+    for (std::span<const std::uint8_t> permutation : slice) assert(Permutations::rank(permutation) == rank++);
+    assert(large.slice(5, 5).begin() == large.slice(5, 5).end());
+}
+
+// The slices of forEachPart cover the range once, whatever the number of threads
+void test_forEachPart()
+{
+    for (unsigned int threads : {1u, 2u, 3u, 7u})
+    {
+        std::vector<std::uint64_t> bits(threads, 0), counts(threads, 0);
+        forEachPart(Subsets(16), [&](const Subsets& part, unsigned int t)
+        {
+            for (std::uint64_t mask : part) bits[t] += static_cast<std::uint64_t>(std::popcount(mask));
+            counts[t] = part.size();
+        }, threads);
+        assert(std::accumulate(bits.begin(), bits.end(), std::uint64_t{0}) == 16 * (std::uint64_t{1} << 15));
+        assert(std::accumulate(counts.begin(), counts.end(), std::uint64_t{0}) == std::uint64_t{1} << 16);
+
+        std::atomic<std::uint64_t> ranks{0};
+        forEachPart(Combinations(20, 6), [&](const Combinations& part, unsigned int)
+        {
+            std::uint64_t sum = 0;
+            for (auto it = part.begin(); it != part.end(); ++it) sum += Combinations::rank(*it) - it.index() + 1;
+            ranks += sum;
+        }, threads);
+        assert(ranks == Combinations::binomial(20, 6));
+
+        std::atomic<std::uint64_t> permutations{0};
+        forEachPart(Permutations(5), [&](const Permutations& part, unsigned int) { permutations += part.size(); }, threads);
+        assert(permutations == 120);
+    }
+}
+
+void test_Errors()
+{
+    bool thrown = false;
+    try { Subsets(64); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { Combinations(5, 6); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { Permutations(21); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { Subsets(4).slice(3, 17); }
+    catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+}
+
+// The number of baskets of n instruments whose cost is within a budget: Part C's power set, then every mask
+// summed from scratch, then the Gray code order updating the cost by one instrument per step, on one thread
+// and on all of them
+void benchmark_Baskets(unsigned int n)
+{
+    std::vector<std::int64_t> costs(n);
+    for (unsigned int i = 0; i < n; ++i) costs[i] = 1 + static_cast<std::int64_t>((i * 7919) % 101);
+    const std::int64_t budget = std::accumulate(costs.begin(), costs.end(), std::int64_t{0}) / 3;
+    const Subsets subsets(n);
+    const double scale = 1e9 / static_cast<double>(subsets.size());
+
+    StopWatch stopWatch;
+    std::uint64_t viaSets = 0;
+    double setTime = 0;
+    if (n <= 18)
+    {
+        Set S;
+        for (unsigned int i = 0; i < n; ++i) S.insert(static_cast<int>(i));
+        stopWatch.Start();
+        for (const Set& basket : power_set(S))
+        {
+            std::int64_t cost = 0;
+            for (int i : basket) cost += costs[static_cast<std::size_t>(i)];
+            viaSets += cost <= budget;
+        }
+        stopWatch.Stop();
+        setTime = stopWatch.ElapsedTime();
+    }
+
+    std::uint64_t viaMasks = 0;
+    stopWatch.Start();
+    for (std::uint64_t mask : subsets)
+    {
+        std::int64_t cost = 0;
+        for (std::uint64_t m = mask; m != 0; m &= m - 1) cost += costs[static_cast<std::size_t>(std::countr_zero(m))];
+        viaMasks += cost <= budget;
+    }
+    stopWatch.Stop();
+    const double maskTime = stopWatch.ElapsedTime();
+
+    // One cost per subset, updated by the element that changed
+    auto countGray = [&](const Subsets& part)
+    {
+        auto it = part.begin();
+        if (it == part.end()) return std::uint64_t{0};
+        std::int64_t cost = 0;
+        for (std::uint64_t m = *it; m != 0; m &= m - 1) cost += costs[static_cast<std::size_t>(std::countr_zero(m))];
+        std::uint64_t count = cost <= budget;
+        for (++it; it != part.end(); ++it)
+        {
+            const unsigned int changed = it.changed();
+            cost += (*it >> changed & 1) ? costs[changed] : -costs[changed];
+            count += cost <= budget;
+        }
+        return count;
+    };
+
+    std::uint64_t viaGray = 0;
+    stopWatch.Start();
+    viaGray = countGray(subsets);
+    stopWatch.Stop();
+    const double grayTime = stopWatch.ElapsedTime();
+
+    const unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::uint64_t> counts(threads, 0);
+    stopWatch.Start();
+    forEachPart(subsets, [&](const Subsets& part, unsigned int t) { counts[t] = countGray(part); }, threads);
+    stopWatch.Stop();
+    const double parallelTime = stopWatch.ElapsedTime();
+    const std::uint64_t viaParts = std::accumulate(counts.begin(), counts.end(), std::uint64_t{0});
+
+    assert(viaMasks == viaGray && viaGray == viaParts && (n > 18 || viaSets == viaMasks));
+    std::cout << n << "\t" << viaGray << "\t\t";
+    if (n <= 18) std::cout << scale * setTime;
+    else std::cout << "-";
+    std::cout << "\t\t" << scale * maskTime << "\t\t" << scale * grayTime << "\t\t" << scale * parallelTime << " (" << threads << ")" << std::endl;
+}
+
 int main()
 {
     test_reverse_copy();
     test_rotate();
     test_power_set();
     test_move_set_to_front();
+
+    test_power_set_bitmask();
+    test_Subsets();
+    test_Combinations();
+    test_Permutations();
+    test_forEachPart();
+    test_Errors();
+
+    std::cout << "\nns per subset, counting baskets within budget" << std::endl;
+    std::cout << "n\tbaskets\t\tsets\t\tmasks\t\tGray\t\tGray, threads" << std::endl;
+    for (unsigned int n : {16u, 18u, 24u, 30u}) benchmark_Baskets(n);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
     return 0;
 }
\ No newline at end of file
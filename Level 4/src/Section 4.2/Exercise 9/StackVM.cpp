@@ -0,0 +1,523 @@
+//
+// A StackVM compiles Forth-style words into direct-threaded code and evaluates it one row at a time or in
+// blocks of rows. GCC and Clang dispatch through label addresses (computed goto); other compilers fall back
+// to a switch over the same instruction bodies.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_STACKVM_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_STACKVM_CPP
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "StackVM.hpp"
+
+/**
+ * Compiles a program given as whitespace separated words, e.g. "x0 x1 * 2.5 +"
+ * @tparam T Floating point type the program computes with
+ * @param source The program text
+ */
+template<typename T>
+StackVM<T>::StackVM(const std::string& source)
+{
+    std::istringstream stream{source};
+    std::vector<std::string> words;
+    for (std::string word; stream >> word;) words.push_back(word);
+
+    compile(words);
+    link();
+}
+
+/**
+ * Compiles a program given as a word list
+ * @tparam T Floating point type the program computes with
+ * @param words The words of the program, in order
+ */
+template<typename T>
+StackVM<T>::StackVM(const std::vector<std::string>& words)
+{
+    compile(words);
+    link();
+}
+
+/**
+ * Translates each word into an instruction and verifies the stack depth at every step, so the compiled code
+ * can run without any underflow or overflow checks.
+ * @tparam T Floating point type the program computes with
+ * @param words The words of the program, in order
+ */
+template<typename T>
+void StackVM<T>::compile(const std::vector<std::string>& words)
+{
+    if (words.empty()) throw std::invalid_argument("A program needs at least one word");
+
+    std::uint32_t current = 0;
+    for (std::size_t position = 0; position < words.size(); ++position)
+    {
+        const std::string& word = words[position];
+        Op op = Op::Halt;
+        std::uint32_t input = 0;
+        T literal{};
+
+        // Plain words (drop is accepted as the Forth name for discard)
+        for (std::size_t i = static_cast<std::size_t>(Op::Dup); i < static_cast<std::size_t>(Op::AddLiteral); ++i)
+        {
+            if (word == NAMES[i]) op = static_cast<Op>(i);
+        }
+        if (word == "drop") op = Op::Discard;
+
+        // Inputs x0, x1, ... and numeric literals
+        if (op == Op::Halt && word.size() > 1 && word[0] == 'x' &&
+            std::all_of(word.begin() + 1, word.end(), [](unsigned char c) { return std::isdigit(c) != 0; }))
+        {
+            op = Op::Input;
+            input = static_cast<std::uint32_t>(std::stoul(word.substr(1)));
+        }
+        else if (op == Op::Halt)
+        {
+            char* end = nullptr;
+            if constexpr (std::is_same_v<T, float>) literal = std::strtof(word.c_str(), &end);
+            else if constexpr (std::is_same_v<T, double>) literal = std::strtod(word.c_str(), &end);
+            else literal = std::strtold(word.c_str(), &end);
+            if (end != word.c_str() + word.size())
+            {
+                throw std::invalid_argument("Unknown word '" + word + "' at position " + std::to_string(position));
+            }
+            op = Op::Literal;
+        }
+
+        // Stack effect of the word
+        std::uint32_t pops = 0;
+        std::uint32_t pushes = 1;
+        switch (op)
+        {
+            case Op::Literal: case Op::Input: break;
+            case Op::Dup: pops = 1; pushes = 2; break;
+            case Op::Discard: pops = 1; pushes = 0; break;
+            case Op::Swap: pops = 2; pushes = 2; break;
+            case Op::Over: pops = 2; pushes = 3; break;
+            case Op::Rot: pops = 3; pushes = 3; break;
+            case Op::Negate: case Op::Abs: case Op::Sqrt: case Op::Exp: case Op::Log: pops = 1; break;
+            default: pops = 2; break;
+        }
+
+        if (current < pops)
+        {
+            throw std::invalid_argument("Word '" + word + "' at position " + std::to_string(position) + " needs " +
+                                        std::to_string(pops) + " values but the stack holds " + std::to_string(current));
+        }
+        current = current - pops + pushes;
+        if (current > CAPACITY)
+        {
+            throw std::invalid_argument("Word '" + word + "' at position " + std::to_string(position) +
+                                        " overflows the stack capacity of " + std::to_string(CAPACITY));
+        }
+
+        depth = std::max(depth, current);
+        if (op == Op::Input) inputs = std::max(inputs, input + 1);
+        emit(op, input, literal);
+    }
+
+    if (current != 1)
+    {
+        throw std::invalid_argument("A program must leave exactly one value on the stack but leaves " +
+                                    std::to_string(current));
+    }
+
+    emit(Op::Halt, 0, T{});
+}
+
+/**
+ * Appends an instruction. A binary arithmetic word directly after a literal or an input replaces that
+ * instruction with its fused form, which combines the operand with the top of the stack in place.
+ * @tparam T Floating point type the program computes with
+ * @param op The instruction
+ * @param input Column index for Input
+ * @param literal Value for Literal
+ */
+template<typename T>
+void StackVM<T>::emit(Op op, std::uint32_t input, T literal)
+{
+    const bool arithmetic = op == Op::Add || op == Op::Sub || op == Op::Mul || op == Op::Div;
+    if (arithmetic && !code.empty() && (code.back().op == Op::Literal || code.back().op == Op::Input))
+    {
+        const auto offset = static_cast<std::size_t>(op) - static_cast<std::size_t>(Op::Add);
+        const Op base = code.back().op == Op::Literal ? Op::AddLiteral : Op::AddInput;
+        code.back().op = static_cast<Op>(static_cast<std::size_t>(base) + offset);
+        return;
+    }
+
+    code.push_back(Cell{{nullptr, nullptr}, op, input, literal});
+}
+
+/**
+ * Stores the address of the implementation of each instruction in its cell (direct threading)
+ * @tparam T Floating point type the program computes with
+ */
+template<typename T>
+void StackVM<T>::link()
+{
+#if defined(__GNUC__)
+    std::array<const void*, OP_COUNT> plain{};
+    std::array<const void*, OP_COUNT> traced{};
+    execute<false>(nullptr, nullptr, nullptr, nullptr, plain.data());
+    execute<true>(nullptr, nullptr, nullptr, nullptr, traced.data());
+
+    for (Cell& cell : code)
+    {
+        cell.handler = {plain[static_cast<std::size_t>(cell.op)], traced[static_cast<std::size_t>(cell.op)]};
+    }
+#endif
+}
+
+/**
+ * Runs compiled code for a single row. The top of the stack is held in tos and sp points one past the
+ * element below it. When table is not null the addresses of the instruction bodies are copied into it
+ * instead, which is how link() threads the code.
+ * @tparam T Floating point type the program computes with
+ * @tparam Traced Whether each executed instruction is counted
+ * @param ip The first instruction
+ * @param row The input values
+ * @param stack Storage for CAPACITY values
+ * @param counts Per instruction counters, used when Traced
+ * @param table Receives OP_COUNT instruction addresses when not null
+ * @return The value left on the stack
+ */
+template<typename T>
+template<bool Traced>
+T StackVM<T>::execute(const Cell* ip, const T* row, T* stack, [[maybe_unused]] std::uint64_t* counts,
+                      [[maybe_unused]] const void** table)
+{
+#if defined(__GNUC__)
+    static const void* const handlers[OP_COUNT] =
+    {
+        &&op_Literal, &&op_Input, &&op_Dup, &&op_Discard, &&op_Swap, &&op_Over, &&op_Rot, &&op_Min, &&op_Max,
+        &&op_Add, &&op_Sub, &&op_Mul, &&op_Div, &&op_Negate, &&op_Abs, &&op_Sqrt, &&op_Exp, &&op_Log,
+        &&op_AddLiteral, &&op_SubLiteral, &&op_MulLiteral, &&op_DivLiteral,
+        &&op_AddInput, &&op_SubInput, &&op_MulInput, &&op_DivInput,
+        &&op_Halt
+    };
+    if (table != nullptr)
+    {
+        std::copy(std::begin(handlers), std::end(handlers), table);
+        return T{};
+    }
+
+#define STACKVM_OP(name) op_##name:
+#define STACKVM_NEXT()                                                              \
+    do                                                                              \
+    {                                                                               \
+        ++ip;                                                                       \
+        if constexpr (Traced) ++counts[static_cast<std::size_t>(ip->op)];           \
+        goto *ip->handler[Traced];                                                  \
+    } while (false)
+#else
+#define STACKVM_OP(name) case Op::name:
+#define STACKVM_NEXT() do { ++ip; goto dispatch; } while (false)
+#endif
+
+    T tos{};
+    T* sp = stack;
+
+#if defined(__GNUC__)
+    if constexpr (Traced) ++counts[static_cast<std::size_t>(ip->op)];
+    goto *ip->handler[Traced];
+#else
+dispatch:
+    if constexpr (Traced) ++counts[static_cast<std::size_t>(ip->op)];
+    switch (ip->op)
+#endif
+    {
+        STACKVM_OP(Literal) *sp++ = tos; tos = ip->literal; STACKVM_NEXT();
+        STACKVM_OP(Input) *sp++ = tos; tos = row[ip->input]; STACKVM_NEXT();
+        STACKVM_OP(Dup) *sp++ = tos; STACKVM_NEXT();
+        STACKVM_OP(Discard) tos = *--sp; STACKVM_NEXT();
+        STACKVM_OP(Swap) std::swap(tos, sp[-1]); STACKVM_NEXT();
+        STACKVM_OP(Over) *sp++ = tos; tos = sp[-2]; STACKVM_NEXT();
+        STACKVM_OP(Rot)
+        {
+            T third = sp[-2];
+            sp[-2] = sp[-1];
+            sp[-1] = tos;
+            tos = third;
+            STACKVM_NEXT();
+        }
+        STACKVM_OP(Min) tos = std::min(sp[-1], tos); --sp; STACKVM_NEXT();
+        STACKVM_OP(Max) tos = std::max(sp[-1], tos); --sp; STACKVM_NEXT();
+        STACKVM_OP(Add) tos = *--sp + tos; STACKVM_NEXT();
+        STACKVM_OP(Sub) tos = *--sp - tos; STACKVM_NEXT();
+        STACKVM_OP(Mul) tos = *--sp * tos; STACKVM_NEXT();
+        STACKVM_OP(Div) tos = *--sp / tos; STACKVM_NEXT();
+        STACKVM_OP(Negate) tos = -tos; STACKVM_NEXT();
+        STACKVM_OP(Abs) tos = std::abs(tos); STACKVM_NEXT();
+        STACKVM_OP(Sqrt) tos = std::sqrt(tos); STACKVM_NEXT();
+        STACKVM_OP(Exp) tos = std::exp(tos); STACKVM_NEXT();
+        STACKVM_OP(Log) tos = std::log(tos); STACKVM_NEXT();
+        STACKVM_OP(AddLiteral) tos = tos + ip->literal; STACKVM_NEXT();
+        STACKVM_OP(SubLiteral) tos = tos - ip->literal; STACKVM_NEXT();
+        STACKVM_OP(MulLiteral) tos = tos * ip->literal; STACKVM_NEXT();
+        STACKVM_OP(DivLiteral) tos = tos / ip->literal; STACKVM_NEXT();
+        STACKVM_OP(AddInput) tos = tos + row[ip->input]; STACKVM_NEXT();
+        STACKVM_OP(SubInput) tos = tos - row[ip->input]; STACKVM_NEXT();
+        STACKVM_OP(MulInput) tos = tos * row[ip->input]; STACKVM_NEXT();
+        STACKVM_OP(DivInput) tos = tos / row[ip->input]; STACKVM_NEXT();
+        STACKVM_OP(Halt) return tos;
+    }
+
+#undef STACKVM_OP
+#undef STACKVM_NEXT
+
+    return tos;
+}
+
+/**
+ * Applies function to every element of a block and the matching element of another block. The trip count is
+ * the constant BLOCK_SIZE and the blocks never overlap, so the loop vectorizes without runtime checks.
+ * @tparam T Floating point type the program computes with
+ * @tparam Function Binary callable
+ * @param lhs Receives function(lhs[i], rhs[i])
+ * @param rhs The second operand
+ * @param function The operation
+ */
+template<typename T>
+template<typename Function>
+void StackVM<T>::blockwise(T* __restrict lhs, const T* __restrict rhs, Function function) noexcept
+{
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) lhs[i] = function(lhs[i], rhs[i]);
+}
+
+/**
+ * Applies function to every element of a block and a scalar operand
+ * @tparam T Floating point type the program computes with
+ * @tparam Function Binary callable
+ * @param lhs Receives function(lhs[i], rhs)
+ * @param rhs The second operand
+ * @param function The operation
+ */
+template<typename T>
+template<typename Function>
+void StackVM<T>::blockwise(T* __restrict lhs, T rhs, Function function) noexcept
+{
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) lhs[i] = function(lhs[i], rhs);
+}
+
+/**
+ * Applies function to every element of a block
+ * @tparam T Floating point type the program computes with
+ * @tparam Function Unary callable
+ * @param values Receives function(values[i])
+ * @param function The operation
+ */
+template<typename T>
+template<typename Function>
+void StackVM<T>::blockwise(T* __restrict values, Function function) noexcept
+{
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) values[i] = function(values[i]);
+}
+
+/**
+ * Runs compiled code over every row. Whole blocks of BLOCK_SIZE rows are evaluated together: stack slot k
+ * holds the k-th stack value of every row in the block, so each instruction is one loop over contiguous
+ * values. The rows after the last whole block are evaluated one at a time by the threaded code.
+ * @tparam T Floating point type the program computes with
+ * @tparam Traced Whether each executed instruction is counted (once per row)
+ * @param columns columns[i] holds input xi of every row
+ * @param out Receives one result per row; its size is the number of rows
+ * @param counts Per instruction counters, used when Traced
+ */
+template<typename T>
+template<bool Traced>
+void StackVM<T>::executeBatch(const std::vector<std::vector<T>>& columns, std::vector<T>& out,
+                              [[maybe_unused]] std::uint64_t* counts) const
+{
+    std::vector<T> buffer(static_cast<std::size_t>(depth) * BLOCK_SIZE);
+    auto slot = [&buffer](std::size_t k) { return buffer.data() + k * BLOCK_SIZE; };
+
+    const std::size_t whole = out.size() - out.size() % BLOCK_SIZE;
+    for (std::size_t first = 0; first < whole; first += BLOCK_SIZE)
+    {
+        std::size_t level = 0;
+        for (const Cell& cell : code)
+        {
+            if constexpr (Traced) counts[static_cast<std::size_t>(cell.op)] += BLOCK_SIZE;
+
+            T* top = level > 0 ? slot(level - 1) : nullptr;
+            T* next = level > 1 ? slot(level - 2) : nullptr;
+            const bool reads = cell.op == Op::Input || (cell.op >= Op::AddInput && cell.op <= Op::DivInput);
+            const T* column = reads ? columns[cell.input].data() + first : nullptr;
+            const T literal = cell.literal;
+
+            switch (cell.op)
+            {
+                case Op::Literal: std::fill_n(slot(level++), BLOCK_SIZE, literal); break;
+                case Op::Input: std::copy_n(column, BLOCK_SIZE, slot(level++)); break;
+                case Op::Dup: std::copy_n(top, BLOCK_SIZE, slot(level++)); break;
+                case Op::Discard: --level; break;
+                case Op::Swap: std::swap_ranges(top, top + BLOCK_SIZE, next); break;
+                case Op::Over: std::copy_n(next, BLOCK_SIZE, slot(level++)); break;
+                case Op::Rot:
+                {
+                    // (a b c -- b c a) as two swaps: (a b c) -> (b a c) -> (b c a)
+                    T* third = slot(level - 3);
+                    std::swap_ranges(third, third + BLOCK_SIZE, next);
+                    std::swap_ranges(next, next + BLOCK_SIZE, top);
+                    break;
+                }
+                case Op::Min: blockwise(next, top, [](T a, T b) { return std::min(a, b); }); --level; break;
+                case Op::Max: blockwise(next, top, [](T a, T b) { return std::max(a, b); }); --level; break;
+                case Op::Add: blockwise(next, top, [](T a, T b) { return a + b; }); --level; break;
+                case Op::Sub: blockwise(next, top, [](T a, T b) { return a - b; }); --level; break;
+                case Op::Mul: blockwise(next, top, [](T a, T b) { return a * b; }); --level; break;
+                case Op::Div: blockwise(next, top, [](T a, T b) { return a / b; }); --level; break;
+                case Op::Negate: blockwise(top, [](T a) { return -a; }); break;
+                case Op::Abs: blockwise(top, [](T a) { return std::abs(a); }); break;
+                case Op::Sqrt: blockwise(top, [](T a) { return std::sqrt(a); }); break;
+                case Op::Exp: blockwise(top, [](T a) { return std::exp(a); }); break;
+                case Op::Log: blockwise(top, [](T a) { return std::log(a); }); break;
+                case Op::AddLiteral: blockwise(top, literal, [](T a, T b) { return a + b; }); break;
+                case Op::SubLiteral: blockwise(top, literal, [](T a, T b) { return a - b; }); break;
+                case Op::MulLiteral: blockwise(top, literal, [](T a, T b) { return a * b; }); break;
+                case Op::DivLiteral: blockwise(top, literal, [](T a, T b) { return a / b; }); break;
+                case Op::AddInput: blockwise(top, column, [](T a, T b) { return a + b; }); break;
+                case Op::SubInput: blockwise(top, column, [](T a, T b) { return a - b; }); break;
+                case Op::MulInput: blockwise(top, column, [](T a, T b) { return a * b; }); break;
+                case Op::DivInput: blockwise(top, column, [](T a, T b) { return a / b; }); break;
+                case Op::Halt: std::copy_n(top, BLOCK_SIZE, out.data() + first); break;
+            }
+        }
+    }
+
+    std::vector<T> row(inputs);
+    std::array<T, CAPACITY> stack;
+    for (std::size_t r = whole; r < out.size(); ++r)
+    {
+        for (std::size_t i = 0; i < inputs; ++i) row[i] = columns[i][r];
+        out[r] = execute<Traced>(code.data(), row.data(), stack.data(), counts, nullptr);
+    }
+}
+
+/**
+ * Throws if there are too few input columns or the columns differ in length
+ * @tparam T Floating point type the program computes with
+ * @param columns columns[i] holds input xi of every row
+ */
+template<typename T>
+void StackVM<T>::checkColumns(const std::vector<std::vector<T>>& columns) const
+{
+    if (columns.size() < inputs)
+    {
+        throw std::invalid_argument("Program reads " + std::to_string(inputs) + " inputs but only " +
+                                    std::to_string(columns.size()) + " columns were given");
+    }
+    for (std::size_t i = 1; i < columns.size(); ++i)
+    {
+        if (columns[i].size() != columns[0].size())
+        {
+            throw std::invalid_argument("Column " + std::to_string(i) + " has " + std::to_string(columns[i].size()) +
+                                        " rows but column 0 has " + std::to_string(columns[0].size()));
+        }
+    }
+}
+
+/**
+ * Evaluates the program for one row
+ * @tparam T Floating point type the program computes with
+ * @param row The inputs x0, x1, ...; must hold at least inputCount() values
+ * @return The value the program leaves on the stack
+ */
+template<typename T>
+T StackVM<T>::evaluate(std::span<const T> row) const
+{
+    if (row.size() < inputs)
+    {
+        throw std::invalid_argument("Program reads " + std::to_string(inputs) + " inputs but the row has " +
+                                    std::to_string(row.size()));
+    }
+
+    std::array<T, CAPACITY> stack;
+    return execute<false>(code.data(), row.data(), stack.data(), nullptr, nullptr);
+}
+
+/**
+ * Evaluates the program for every row
+ * @tparam T Floating point type the program computes with
+ * @param columns columns[i] holds input xi of every row
+ * @return One result per row
+ */
+template<typename T>
+std::vector<T> StackVM<T>::evaluateBatch(const std::vector<std::vector<T>>& columns) const
+{
+    checkColumns(columns);
+    std::vector<T> out(columns.empty() ? 0 : columns[0].size());
+    executeBatch<false>(columns, out, nullptr);
+    return out;
+}
+
+/**
+ * Evaluates the program for one row and adds the instructions it executed to the trace counts
+ * @tparam T Floating point type the program computes with
+ * @param row The inputs x0, x1, ...; must hold at least inputCount() values
+ * @return The value the program leaves on the stack
+ */
+template<typename T>
+T StackVM<T>::trace(std::span<const T> row)
+{
+    if (row.size() < inputs)
+    {
+        throw std::invalid_argument("Program reads " + std::to_string(inputs) + " inputs but the row has " +
+                                    std::to_string(row.size()));
+    }
+
+    std::array<T, CAPACITY> stack;
+    return execute<true>(code.data(), row.data(), stack.data(), counts.data(), nullptr);
+}
+
+/**
+ * Evaluates the program for every row and adds the instructions executed to the trace counts
+ * @tparam T Floating point type the program computes with
+ * @param columns columns[i] holds input xi of every row
+ * @return One result per row
+ */
+template<typename T>
+std::vector<T> StackVM<T>::traceBatch(const std::vector<std::vector<T>>& columns)
+{
+    checkColumns(columns);
+    std::vector<T> out(columns.empty() ? 0 : columns[0].size());
+    executeBatch<true>(columns, out, counts.data());
+    return out;
+}
+
+/**
+ * Writes the compiled instructions followed by the trace count of every instruction that has executed
+ * @tparam T Floating point type the program computes with
+ * @param out The output stream
+ * @return The output stream
+ */
+template<typename T>
+std::ostream& StackVM<T>::disassemble(std::ostream& out) const
+{
+    for (std::size_t i = 0; i < code.size(); ++i)
+    {
+        const Cell& cell = code[i];
+        out << i << ": " << name(cell.op);
+        if (cell.op == Op::Literal || (cell.op >= Op::AddLiteral && cell.op <= Op::DivLiteral)) out << " " << cell.literal;
+        if (cell.op == Op::Input || (cell.op >= Op::AddInput && cell.op <= Op::DivInput)) out << " x" << cell.input;
+        out << "\n";
+    }
+
+    for (std::size_t i = 0; i < OP_COUNT; ++i)
+    {
+        if (counts[i] != 0) out << NAMES[i] << ": " << counts[i] << "\n";
+    }
+
+    return out;
+}
+
+#endif
@@ -0,0 +1,135 @@
+//
+// A StackVM compiles a list of Forth-style words (over, rot, swap, discard, min, max, dup, arithmetic, math
+// functions, numeric literals and the inputs x0, x1, ...) into direct-threaded code. Each compiled cell holds
+// the address of the code that implements it, so moving to the next word is a single indirect jump instead of
+// a word lookup and a call. The stack is a contiguous fixed-capacity array whose depth is verified when the
+// program is compiled, and the top of the stack is kept in a local variable so most words never touch memory.
+// A literal or input followed by + - * / is fused into a single instruction.
+//
+// Batch mode evaluates one program over many rows. Rows are taken BLOCK_SIZE at a time, each instruction is
+// dispatched once per block and runs as a tight loop over the block, so the arithmetic words vectorize and
+// the dispatch cost is shared by every row in the block.
+//
+// Tracing runs the same code while counting how many times each instruction executes.
+//
+// over, swap and discard behave as they do on the Stack adapter of Exercise 8, but rot, min and max take
+// their Forth meanings, since a formula has to leave exactly one value: rot moves the third value to the
+// top (a b c -- b c a), and min and max replace the top two values with the lesser or greater of them.
+// The adapter's rot instead pushes a copy of the third value, growing the stack, and its min and max move
+// the extreme of the whole stack to the top.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_STACKVM_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_STACKVM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+template<typename T = double>
+class StackVM
+{
+    static_assert(std::is_floating_point_v<T>, "StackVM evaluates floating point formulas");
+
+public:
+    // The plain words come first, followed by the fused forms the compiler produces
+    enum class Op : std::uint8_t
+    {
+        Literal, Input, Dup, Discard, Swap, Over, Rot, Min, Max,
+        Add, Sub, Mul, Div, Negate, Abs, Sqrt, Exp, Log,
+        AddLiteral, SubLiteral, MulLiteral, DivLiteral,
+        AddInput, SubInput, MulInput, DivInput,
+        Halt
+    };
+
+    static constexpr std::size_t OP_COUNT = static_cast<std::size_t>(Op::Halt) + 1;
+    static constexpr std::size_t CAPACITY = 64;
+    static constexpr std::size_t BLOCK_SIZE = 256;
+
+private:
+    static constexpr std::array<const char*, OP_COUNT> NAMES
+    {
+        "literal", "input", "dup", "discard", "swap", "over", "rot", "min", "max",
+        "+", "-", "*", "/", "negate", "abs", "sqrt", "exp", "log",
+        "literal+", "literal-", "literal*", "literal/",
+        "input+", "input-", "input*", "input/",
+        "halt"
+    };
+
+    // One compiled word. handler[0] is used by the plain code and handler[1] by the traced code.
+    struct Cell
+    {
+        std::array<const void*, 2> handler;
+        Op op;
+        std::uint32_t input;
+        T literal;
+    };
+
+    std::vector<Cell> code;
+    std::uint32_t inputs = 0;
+    std::uint32_t depth = 0;
+    std::array<std::uint64_t, OP_COUNT> counts{};
+
+    void compile(const std::vector<std::string>& words);
+    void emit(Op op, std::uint32_t input, T literal);
+    void link();
+    void checkColumns(const std::vector<std::vector<T>>& columns) const;
+
+    template<bool Traced>
+    static T execute(const Cell* ip, const T* row, T* stack, std::uint64_t* counts, const void** table);
+
+    template<typename Function>
+    static void blockwise(T* __restrict lhs, const T* __restrict rhs, Function function) noexcept;
+
+    template<typename Function>
+    static void blockwise(T* __restrict lhs, T rhs, Function function) noexcept;
+
+    template<typename Function>
+    static void blockwise(T* __restrict values, Function function) noexcept;
+
+    template<bool Traced>
+    void executeBatch(const std::vector<std::vector<T>>& columns, std::vector<T>& out, std::uint64_t* counts) const;
+
+public:
+    StackVM() = delete;
+    explicit StackVM(const std::string& source);
+    explicit StackVM(const std::vector<std::string>& words);
+    StackVM(const StackVM& source) = default;
+    StackVM(StackVM&& source) noexcept = default;
+    ~StackVM() = default;
+
+    // Operator overloads
+    StackVM& operator=(const StackVM& source) = default;
+    StackVM& operator=(StackVM&& source) noexcept = default;
+
+    // Accessors
+    std::uint32_t inputCount() const noexcept { return inputs; }
+    std::uint32_t maxDepth() const noexcept { return depth; }
+    std::size_t instructionCount() const noexcept { return code.size(); }
+    std::uint64_t opCount(Op op) const noexcept { return counts[static_cast<std::size_t>(op)]; }
+    static const char* name(Op op) noexcept { return NAMES[static_cast<std::size_t>(op)]; }
+
+    // Mutators
+    void resetTrace() noexcept { counts.fill(0); }
+
+    // Core functionality
+    T evaluate(std::span<const T> row) const;
+    std::vector<T> evaluateBatch(const std::vector<std::vector<T>>& columns) const;
+    T trace(std::span<const T> row);
+    std::vector<T> traceBatch(const std::vector<std::vector<T>>& columns);
+    std::ostream& disassemble(std::ostream& out) const;
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_STACKVM_CPP
+#include "StackVM.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_STACKVM_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_STACKVM_HPP
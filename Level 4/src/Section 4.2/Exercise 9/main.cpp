@@ -0,0 +1,325 @@
+//
+// Tests for the threaded-code StackVM. Every compiled result is checked against a word-by-word interpreter
+// that keeps its values on the Stack adapter from Exercise 8, and a pricing formula benchmark compares the
+// interpreter, the threaded code, batch mode and the same formula written directly in C++.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Stack.hpp"
+#include "StackVM.hpp"
+#include "StopWatch.hpp"
+
+// Splits a program into words
+std::vector<std::string> words(const std::string& source)
+{
+    std::istringstream stream{source};
+    std::vector<std::string> result;
+    for (std::string word; stream >> word;) result.push_back(word);
+    return result;
+}
+
+// Pops the top of a Stack
+double pop(Stack<double>& stack)
+{
+    double value = stack.top();
+    stack.discard();
+    return value;
+}
+
+// Reference semantics: looks up and executes one word at a time on a Stack. over, swap and discard are the
+// adapter's own; rot, min and max are spelt out with pops and pushes because the VM gives them their Forth
+// meanings rather than the adapter's
+double interpret(const std::vector<std::string>& program, const std::vector<double>& row)
+{
+    Stack<double> stack;
+    for (const std::string& word : program)
+    {
+        if (word == "dup") { double top = stack.top(); stack.push(top); }
+        else if (word == "discard" || word == "drop") stack.discard();
+        else if (word == "swap") stack.swap();
+        else if (word == "over") stack.over();
+        else if (word == "rot")
+        {
+            double c = pop(stack), b = pop(stack), a = pop(stack);
+            stack.push(b);
+            stack.push(c);
+            stack.push(a);
+        }
+        else if (word == "min") { double b = pop(stack), a = pop(stack); stack.push(std::min(a, b)); }
+        else if (word == "max") { double b = pop(stack), a = pop(stack); stack.push(std::max(a, b)); }
+        else if (word == "+") { double b = pop(stack), a = pop(stack); stack.push(a + b); }
+        else if (word == "-") { double b = pop(stack), a = pop(stack); stack.push(a - b); }
+        else if (word == "*") { double b = pop(stack), a = pop(stack); stack.push(a * b); }
+        else if (word == "/") { double b = pop(stack), a = pop(stack); stack.push(a / b); }
+        else if (word == "negate") stack.push(-pop(stack));
+        else if (word == "abs") stack.push(std::abs(pop(stack)));
+        else if (word == "sqrt") stack.push(std::sqrt(pop(stack)));
+        else if (word == "exp") stack.push(std::exp(pop(stack)));
+        else if (word == "log") stack.push(std::log(pop(stack)));
+        else if (word[0] == 'x') stack.push(row[std::stoul(word.substr(1))]);
+        else stack.push(std::stod(word));
+    }
+    return stack.top();
+}
+
+// Bitwise agreement, treating every NaN as equal
+bool same(double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+// Builds a random valid program over the given number of inputs
+std::vector<std::string> randomProgram(std::uint32_t inputs, std::size_t length, std::mt19937& engine)
+{
+    const std::vector<std::string> unary{"negate", "abs", "sqrt", "exp", "log"};
+    const std::vector<std::string> binary{"+", "-", "*", "/", "min", "max"};
+    const std::vector<std::string> shuffles{"dup", "discard", "swap", "over", "rot"};
+    std::uniform_int_distribution<std::uint32_t> pickInput{0, inputs - 1};
+    std::uniform_real_distribution<double> pickLiteral{-4.0, 4.0};
+    std::uniform_int_distribution<int> pickKind{0, 4};
+
+    std::vector<std::string> program;
+    std::size_t depth = 0;
+    while (program.size() < length || depth != 1)
+    {
+        int kind = pickKind(engine);
+        if (program.size() >= length) kind = depth > 1 ? 2 : 1;
+
+        if (kind == 0 && depth < 8) { program.push_back("x" + std::to_string(pickInput(engine))); ++depth; }
+        else if (kind == 1 && depth < 8) { program.push_back(std::to_string(pickLiteral(engine))); ++depth; }
+        else if (kind == 2 && depth >= 2) { program.push_back(binary[engine() % binary.size()]); --depth; }
+        else if (kind == 3 && depth >= 1) program.push_back(unary[engine() % unary.size()]);
+        else if (kind == 4 && depth >= 3)
+        {
+            const std::string& word = shuffles[engine() % shuffles.size()];
+            program.push_back(word);
+            if (word == "dup" || word == "over") ++depth;
+            if (word == "discard") --depth;
+        }
+    }
+    return program;
+}
+
+// Random input columns
+std::vector<std::vector<double>> randomColumns(std::uint32_t inputs, std::size_t rows, std::mt19937& engine)
+{
+    std::uniform_real_distribution<double> value{-10.0, 10.0};
+    std::vector<std::vector<double>> columns(inputs, std::vector<double>(rows));
+    for (auto& column : columns) for (double& x : column) x = value(engine);
+    return columns;
+}
+
+// Each shuffle word leaves the stack in the documented order
+void test_Words()
+{
+    const std::vector<double> none;
+    assert(1.0 == StackVM<>{"1 2 swap -"}.evaluate(none));
+    assert(15.0 == StackVM<>{"3 4 over * +"}.evaluate(none));
+    assert(132.0 == StackVM<>{"1 2 3 rot 100 * swap 10 * + +"}.evaluate(none));
+    assert(7.0 == StackVM<>{"7 8 9 drop discard"}.evaluate(none));
+    assert(4.0 == StackVM<>{"2 dup *"}.evaluate(none));
+    assert(3.0 == StackVM<>{"3 9 min"}.evaluate(none));
+    assert(9.0 == StackVM<>{"3 9 max"}.evaluate(none));
+    assert(2.0 == StackVM<>{"16 sqrt sqrt"}.evaluate(none));
+    assert(5.0 == StackVM<>{"-5 abs"}.evaluate(none));
+
+    const std::vector<double> row{6.0, 2.0};
+    assert(3.0 == StackVM<>{"x0 x1 /"}.evaluate(row));
+    assert(8.0 == StackVM<>{"x0 x1 +"}.evaluate(row));
+}
+
+// Malformed programs are rejected when they are compiled
+void test_CompileErrors()
+{
+    for (const char* source : {"", "1 +", "1 2", "x0 foo", "1 2 rot", "1 x"})
+    {
+        bool thrown = false;
+        try { StackVM<>{source}; }
+        catch (const std::invalid_argument& e) { thrown = true; }
+        assert(thrown);
+    }
+
+    std::string deep;
+    for (std::size_t i = 0; i <= StackVM<>::CAPACITY; ++i) deep += "1 ";
+    bool thrown = false;
+    try { StackVM<>{deep}; }
+    catch (const std::invalid_argument& e) { thrown = true; }
+    assert(thrown);
+
+    bool shortRow = false;
+    try { StackVM<>{"x3"}.evaluate(std::vector<double>{1.0}); }
+    catch (const std::invalid_argument& e) { shortRow = true; }
+    assert(shortRow);
+}
+
+// Literals and inputs followed by arithmetic compile to fused instructions that the trace reports
+void test_FusionAndTrace()
+{
+    StackVM<> vm{"x0 2 * x1 + 3 -"};
+    assert(5 == vm.instructionCount());  // input, literal*, input+, literal-, halt
+    assert(2 == vm.inputCount());
+    assert(2 == vm.maxDepth());
+
+    const std::vector<double> row{5.0, 1.0};
+    assert(8.0 == vm.trace(row));
+    assert(8.0 == vm.trace(row));
+    assert(2 == vm.opCount(StackVM<>::Op::Input));
+    assert(2 == vm.opCount(StackVM<>::Op::MulLiteral));
+    assert(2 == vm.opCount(StackVM<>::Op::AddInput));
+    assert(2 == vm.opCount(StackVM<>::Op::SubLiteral));
+    assert(2 == vm.opCount(StackVM<>::Op::Halt));
+    assert(0 == vm.opCount(StackVM<>::Op::Mul));
+
+    vm.resetTrace();
+    std::vector<std::vector<double>> columns{{1.0, 2.0, 3.0}, {0.0, 0.0, 1.0}};
+    std::vector<double> out = vm.traceBatch(columns);
+    assert((out == std::vector<double>{-1.0, 1.0, 4.0}));
+    assert(3 == vm.opCount(StackVM<>::Op::AddInput));
+
+    vm.disassemble(std::cout);
+}
+
+// Threaded, traced and batch results agree with the Stack interpreter on random programs
+void test_RandomPrograms()
+{
+    std::mt19937 engine{2026};
+    for (int trial = 0; trial < 200; ++trial)
+    {
+        std::vector<std::string> program = randomProgram(4, 24, engine);
+        StackVM<> vm{program};
+        auto columns = randomColumns(4, 700, engine);  // Not a multiple of BLOCK_SIZE
+        std::vector<double> batch = vm.evaluateBatch(columns);
+
+        for (std::size_t r = 0; r < batch.size(); ++r)
+        {
+            std::vector<double> row{columns[0][r], columns[1][r], columns[2][r], columns[3][r]};
+            double expected = interpret(program, row);
+            assert(same(expected, vm.evaluate(row)));
+            assert(same(expected, vm.trace(row)));
+            assert(same(expected, batch[r]));
+        }
+    }
+}
+
+// Times the undiscounted call payoff formula through each evaluation strategy
+void benchmark_Pricing()
+{
+    // x0 = spot, x1 = strike, x2 = rate, x3 = dividend yield, x4 = expiry
+    const std::string payoff = "x0 x2 x3 - x4 * exp * x1 - 0 max x2 negate x4 * exp *";
+    auto native = [](const double* v)
+    {
+        return std::max(v[0] * std::exp((v[2] - v[3]) * v[4]) - v[1], 0.0) * std::exp(-v[2] * v[4]);
+    };
+
+    const std::size_t rows = 1 << 20;
+    std::mt19937 engine{1};
+    std::uniform_real_distribution<double> spot{50.0, 150.0}, rate{0.0, 0.05}, expiry{0.1, 2.0};
+    std::vector<std::vector<double>> columns(5, std::vector<double>(rows));
+    std::vector<double> flat(rows * 5);
+    for (std::size_t r = 0; r < rows; ++r)
+    {
+        double values[5] = {spot(engine), 100.0, rate(engine), rate(engine) / 2.0, expiry(engine)};
+        for (std::size_t c = 0; c < 5; ++c) columns[c][r] = flat[r * 5 + c] = values[c];
+    }
+
+    auto time = [](auto&& function)
+    {
+        StopWatch stopWatch;
+        stopWatch.Start();
+        double sum = function();
+        stopWatch.Stop();
+        return std::make_pair(sum, 1e3 * stopWatch.ElapsedTime());
+    };
+
+    StackVM<> vm{payoff};
+    const std::vector<std::string> program = words(payoff);
+    const std::size_t interpretedRows = rows / 16;
+
+    auto [nativeSum, nativeMs] = time([&] { double s = 0; for (std::size_t r = 0; r < rows; ++r) s += native(&flat[r * 5]); return s; });
+    auto [threadedSum, threadedMs] = time([&]
+    {
+        double s = 0;
+        for (std::size_t r = 0; r < rows; ++r) s += vm.evaluate(std::span<const double>{&flat[r * 5], 5});
+        return s;
+    });
+    auto [batchSum, batchMs] = time([&] { double s = 0; for (double v : vm.evaluateBatch(columns)) s += v; return s; });
+    auto [interpretedSum, interpretedMs] = time([&]
+    {
+        double s = 0;
+        for (std::size_t r = 0; r < interpretedRows; ++r)
+        {
+            s += interpret(program, std::vector<double>(flat.begin() + r * 5, flat.begin() + r * 5 + 5));
+        }
+        return s;
+    });
+
+    assert(std::abs(threadedSum - nativeSum) <= 1e-9 * std::abs(nativeSum));
+    assert(std::abs(batchSum - nativeSum) <= 1e-9 * std::abs(nativeSum));
+    (void) interpretedSum;
+
+    auto perRow = [](double ms, std::size_t n) { return ms * 1e6 / static_cast<double>(n); };
+    std::cout << "Pricing formula over " << rows << " rows (ns/row): native " << perRow(nativeMs, rows)
+              << ", threaded " << perRow(threadedMs, rows) << ", batch " << perRow(batchMs, rows)
+              << ", Stack interpreter " << perRow(interpretedMs, interpretedRows) << std::endl;
+}
+
+// Times an arithmetic-only polynomial, where dispatch overhead dominates
+void benchmark_Polynomial()
+{
+    const std::string horner = "0.5 x0 * 0.25 + x0 * -1.5 + x0 * 2 + x0 * 0.75 + x0 * 3 +";
+    const std::size_t rows = 1 << 22;
+    std::mt19937 engine{2};
+    auto columns = randomColumns(1, rows, engine);
+    StackVM<> vm{horner};
+
+    StopWatch stopWatch;
+    stopWatch.Start();
+    double nativeSum = 0;
+    for (double x : columns[0]) nativeSum += ((((0.5 * x + 0.25) * x - 1.5) * x + 2) * x + 0.75) * x + 3;
+    stopWatch.Stop();
+    double nativeMs = 1e3 * stopWatch.ElapsedTime();
+
+    stopWatch.Start();
+    double threadedSum = 0;
+    for (double x : columns[0]) threadedSum += vm.evaluate(std::span<const double>{&x, 1});
+    stopWatch.Stop();
+    double threadedMs = 1e3 * stopWatch.ElapsedTime();
+
+    stopWatch.Start();
+    double batchSum = 0;
+    for (double v : vm.evaluateBatch(columns)) batchSum += v;
+    stopWatch.Stop();
+    double batchMs = 1e3 * stopWatch.ElapsedTime();
+
+    assert(std::abs(threadedSum - nativeSum) <= 1e-9 * std::abs(nativeSum));
+    assert(std::abs(batchSum - nativeSum) <= 1e-9 * std::abs(nativeSum));
+
+    auto perRow = [rows](double ms) { return ms * 1e6 / static_cast<double>(rows); };
+    std::cout << "Degree 5 polynomial over " << rows << " rows (ns/row): native " << perRow(nativeMs)
+              << ", threaded " << perRow(threadedMs) << ", batch " << perRow(batchMs) << std::endl;
+}
+
+int main()
+{
+    test_Words();
+    test_CompileErrors();
+    test_FusionAndTrace();
+    test_RandomPrograms();
+
+    benchmark_Pricing();
+    benchmark_Polynomial();
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+//
+// Four xoshiro256++ generators run side by side, for drawing random bits in bulk. std::mt19937_64 returns one
+// 64-bit value per call from a 2.5 KB state that it regenerates in bursts; xoshiro256++ has 32 bytes of
+// state, passes the standard statistical batteries, and takes a handful of adds, shifts and xors per value.
+// The four lanes keep their states in the lanes of 256-bit registers, so fill() produces four values per
+// step with AVX2 (chosen at run time when the CPU supports it) and the portable loop otherwise; both give the
+// same numbers.
+//
+// The lanes are one stream jumped 2^128 values apart, so they never overlap. fill() writes the lanes'
+// outputs interleaved; operator() hands out the same values one at a time from a small buffer, so the class
+// is also a UniformRandomBitGenerator for the std:: distributions.
+//
+// unitInterval() and openUnitInterval() turn 64 random bits into a double in [0, 1) or (0, 1] by putting 52
+// of them in the mantissa of a number in [1, 2), which vectorises where an integer to double conversion does
+// not.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_X86
+#include <immintrin.h>
+#endif
+
+class Xoshiro256x4
+{
+public:
+    using result_type = std::uint64_t;
+    static constexpr std::size_t LANES = 4;
+    static constexpr std::uint64_t DEFAULT_SEED = 0x9E3779B97F4A7C15;
+
+private:
+    static constexpr std::size_t BUFFER = 64;           // Values handed out by operator() per refill
+
+    std::array<std::uint64_t, 4 * LANES> state;     // Word w of lane l at w * LANES + l
+    std::array<std::uint64_t, BUFFER> buffer;
+    std::size_t position;                           // Next value of the buffer
+
+    static std::atomic<bool>& simdSwitch();
+
+    static constexpr std::uint64_t rotl(std::uint64_t x, int k) noexcept { return x << k | x >> (64 - k); }
+    static std::uint64_t step(std::array<std::uint64_t, 4>& lane) noexcept;
+    static void jump(std::array<std::uint64_t, 4>& lane) noexcept;
+
+    void generate(std::uint64_t* out, std::size_t steps) noexcept;
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_X86
+    void generateAvx2(std::uint64_t* out, std::size_t steps) noexcept;
+#endif
+
+public:
+    explicit Xoshiro256x4(std::uint64_t seed = DEFAULT_SEED);
+    Xoshiro256x4(const Xoshiro256x4& source) = default;
+    ~Xoshiro256x4() = default;
+
+    // Operator overloads
+    Xoshiro256x4& operator=(const Xoshiro256x4& source) = default;
+    bool operator==(const Xoshiro256x4& other) const = default;
+    result_type operator()() noexcept
+    {
+        if (position == BUFFER)
+        {
+            fill(buffer);
+            position = 0;
+        }
+        return buffer[position++];
+    }
+
+    // Accessors
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    static bool simdSupported();
+    static bool simdEnabled();
+    static void enableSimd(bool enable);
+
+    // Core functionality
+    void seed(std::uint64_t seed) noexcept;
+    void fill(std::span<std::uint64_t> out) noexcept;
+};
+
+/**
+ * @param bits Random bits
+ * @return A double in [0, 1) made of the top 52 bits
+ */
+inline double unitInterval(std::uint64_t bits) noexcept
+{
+    return std::bit_cast<double>(bits >> 12 | 0x3FF0000000000000) - 1.0;
+}
+
+/**
+ * @param bits Random bits
+ * @return A double in (0, 1] made of the top 52 bits, safe to take the logarithm of
+ */
+inline double openUnitInterval(std::uint64_t bits) noexcept
+{
+    return 2.0 - std::bit_cast<double>(bits >> 12 | 0x3FF0000000000000);
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_HPP
@@ -2,14 +2,33 @@
 // Explore random number generator techniques introduced in C++11.
 // Note - The standard library improved on Boost Random syntax as the classes are now function objects.
 //
+// The batch samplers of BatchDistributions.hpp are tested against their std:: counterparts: the same
+// distribution by two-sample Kolmogorov-Smirnov and chi-squared tests and by the moments, with
+// Xoshiro256x4, std::mt19937_64 and the 32-bit std::mt19937. Benchmarks report nanoseconds per variate.
+//
 // Created by Michael Lewis on 7/17/23.
 //
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
 #include <iostream>
-#include <chrono>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <random>
 
+#include "BatchDistributions.hpp"
+#include "StopWatch.hpp"
+#include "Xoshiro256x4.hpp"
+#include "Ziggurat.hpp"
+
+double sink = 0;
+
 // Part A - Copy and adapt this code by using the engine std::linear_congruential_engine
 void test_linear_congruential_engine_uniform_distribution()
 {
@@ -668,8 +687,303 @@ void test_mt19937_64_generic_engine_cauchy_distribution()
     std::cout << "\n*** End mt19937_64 Generic Engine - Cauchy Distribution ***" << std::endl;
 }
 
+
+// Lane 0 is the reference xoshiro256++ seeded with SplitMix64; operator() hands out the values of fill()
+void test_Xoshiro256x4()
+{
+    static_assert(std::uniform_random_bit_generator<Xoshiro256x4>);
+
+    // The reference generator, one step at a time
+    std::uint64_t seed = 42;
+    std::uint64_t s[4];
+    for (std::uint64_t& word : s)
+    {
+        std::uint64_t z = (seed += 0x9E3779B97F4A7C15);
+        z = (z ^ z >> 30) * 0xBF58476D1CE4E5B9;
+        z = (z ^ z >> 27) * 0x94D049BB133111EB;
+        word = z ^ z >> 31;
+    }
+    auto rotl = [](std::uint64_t x, int k) { return x << k | x >> (64 - k); };
+
+    for (bool simd : {false, true})
+    {
+        Xoshiro256x4::enableSimd(simd);
+        Xoshiro256x4 engine(42);
+        std::vector<std::uint64_t> values(4 * 1000 + 3);
+        engine.fill(values);
+
+        std::uint64_t r[4] = {s[0], s[1], s[2], s[3]};
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            assert(values[4 * i] == rotl(r[0] + r[3], 23) + r[0]);
+            const std::uint64_t t = r[1] << 17;
+            r[2] ^= r[0]; r[3] ^= r[1]; r[1] ^= r[2]; r[0] ^= r[3]; r[2] ^= t; r[3] = rotl(r[3], 45);
+        }
+        assert(values[1] != values[0] && values[2] != values[1] && values[3] != values[2]);
+    }
+
+    // The AVX2 and portable steps agree, and operator() follows fill()
+    Xoshiro256x4 first(7), second(7), third(7);
+    std::vector<std::uint64_t> a(256), b(256);
+    Xoshiro256x4::enableSimd(true);
+    first.fill(a);
+    Xoshiro256x4::enableSimd(false);
+    second.fill(b);
+    Xoshiro256x4::enableSimd(true);
+    assert(a == b && first == second);
+    for (std::uint64_t value : a) assert(third() == value);
+
+    // A UniformRandomBitGenerator for the std:: distributions
+    std::uniform_real_distribution<double> uniform;
+    double sum = 0;
+    for (int i = 0; i < 10'000; ++i) sum += uniform(first);
+    assert(std::abs(sum / 10'000 - 0.5) < 0.02);
+}
+
+// The AVX2 first attempt gives the portable one's variates and rejections, 2.8% and 2.2% of them
+void test_Ziggurat()
+{
+    Xoshiro256x4 engine(1);
+    std::vector<std::uint64_t> bits(4099);
+    engine.fill(bits);
+    for (const Ziggurat* table : {&Ziggurat::normal(), &Ziggurat::exponential()})
+    {
+        std::vector<double> fast(bits.size()), portable(bits.size());
+        std::vector<std::uint32_t> fastRejected(bits.size()), portableRejected(bits.size());
+        Ziggurat::enableSimd(true);
+        const std::size_t fastCount = table->fastPass(bits, fast, fastRejected.data());
+        Ziggurat::enableSimd(false);
+        const std::size_t portableCount = table->fastPass(bits, portable, portableRejected.data());
+        Ziggurat::enableSimd(true);
+
+        assert(fastCount == portableCount && fastCount > bits.size() / 100 && fastCount < bits.size() / 25);
+        fastRejected.resize(fastCount);
+        portableRejected.resize(portableCount);
+        assert(fastRejected == portableRejected);
+        for (std::size_t j = 0; j < bits.size(); ++j) assert(fast[j] == portable[j]);
+    }
+    assert(Ziggurat::normal().layers() == 128 && Ziggurat::exponential().layers() == 256);
+}
+
+// The two-sample Kolmogorov-Smirnov statistic sqrt(n / 2) D, above 1.95 with probability 0.001
+double kolmogorovSmirnov(std::vector<double> x, std::vector<double> y)
+{
+    std::sort(x.begin(), x.end());
+    std::sort(y.begin(), y.end());
+    double distance = 0;
+    std::size_t i = 0, j = 0;
+    while (i < x.size() && j < y.size())
+    {
+        const double t = std::min(x[i], y[j]);
+        while (i < x.size() && x[i] == t) ++i;
+        while (j < y.size() && y[j] == t) ++j;
+        distance = std::max(distance, std::abs(static_cast<double>(i) / static_cast<double>(x.size()) -
+                                               static_cast<double>(j) / static_cast<double>(y.size())));
+    }
+    return std::sqrt(static_cast<double>(x.size()) / 2) * distance;
+}
+
+// The two-sample chi-squared statistic of two equal samples of integers, standardised: values with fewer
+// than 20 occurrences between them are pooled. Above 5 with a probability of well under 0.001.
+double chiSquared(const std::vector<double>& x, const std::vector<double>& y)
+{
+    std::map<double, std::pair<double, double>> counts;
+    for (double value : x) ++counts[value].first;
+    for (double value : y) ++counts[value].second;
+
+    double statistic = 0, pooledX = 0, pooledY = 0;
+    int bins = 0;
+    for (const auto& [value, count] : counts)
+    {
+        if (count.first + count.second < 20)
+        {
+            pooledX += count.first;
+            pooledY += count.second;
+            continue;
+        }
+        statistic += (count.first - count.second) * (count.first - count.second) / (count.first + count.second);
+        ++bins;
+    }
+    if (pooledX + pooledY > 0)
+    {
+        statistic += (pooledX - pooledY) * (pooledX - pooledY) / (pooledX + pooledY);
+        ++bins;
+    }
+    const double freedom = bins - 1;
+    return (statistic - freedom) / std::sqrt(2 * freedom);
+}
+
+// n variates of a batch sampler and of the std:: distribution, from two engines of the same kind
+template<typename Batch, typename Std, typename Eng>
+std::pair<std::vector<double>, std::vector<double>> samples(const Batch& batch, Std standard, std::size_t n, std::uint64_t seed)
+{
+    Eng batchEngine(seed), stdEngine(seed + 1);
+    std::vector<typename Batch::result_type> drawn(n);
+    batch.fill(batchEngine, drawn);
+    std::vector<double> x(drawn.begin(), drawn.end()), y(n);
+    for (double& value : y) value = static_cast<double>(standard(stdEngine));
+    return {x, y};
+}
+
+template<typename Eng>
+void test_Equivalence(std::uint64_t seed)
+{
+    constexpr std::size_t N = 200'000;
+    auto continuous = [](const auto& drawn, const std::string& name)
+    {
+        const double statistic = kolmogorovSmirnov(drawn.first, drawn.second);
+        if (statistic > 1.95) std::cout << name << ": KS statistic " << statistic << std::endl;
+        assert(statistic < 1.95);
+    };
+    auto discrete = [](const auto& drawn, const std::string& name)
+    {
+        const double statistic = chiSquared(drawn.first, drawn.second);
+        if (statistic > 5) std::cout << name << ": chi-squared statistic " << statistic << std::endl;
+        assert(statistic < 5);
+    };
+
+    continuous(samples<UniformSampler<>, std::uniform_real_distribution<double>, Eng>(UniformSampler<>(-2, 3), std::uniform_real_distribution<double>(-2, 3), N, seed), "uniform");
+    continuous(samples<NormalSampler<>, std::normal_distribution<double>, Eng>(NormalSampler<>(1, 2), std::normal_distribution<double>(1, 2), N, seed), "normal");
+    continuous(samples<ExponentialSampler<>, std::exponential_distribution<double>, Eng>(ExponentialSampler<>(0.5), std::exponential_distribution<double>(0.5), N, seed), "exponential");
+    for (double alpha : {0.3, 1.0, 2.5, 40.0})
+    {
+        continuous(samples<GammaSampler<>, std::gamma_distribution<double>, Eng>(GammaSampler<>(alpha, 1.5), std::gamma_distribution<double>(alpha, 1.5), N, seed), "gamma");
+    }
+    for (double k : {1.0, 3.0, 9.0})
+    {
+        continuous(samples<ChiSquaredSampler<>, std::chi_squared_distribution<double>, Eng>(ChiSquaredSampler<>(k), std::chi_squared_distribution<double>(k), N, seed), "chi-squared");
+    }
+    for (double mean : {0.3, 7.0, 100.0, 256.0, 300.0, 5000.0})
+    {
+        discrete(samples<PoissonSampler<>, std::poisson_distribution<int>, Eng>(PoissonSampler<>(mean), std::poisson_distribution<int>(mean), N, seed), "poisson " + std::to_string(mean));
+    }
+    for (double p : {0.5, 0.05, 0.9})
+    {
+        discrete(samples<GeometricSampler<>, std::geometric_distribution<int>, Eng>(GeometricSampler<>(p), std::geometric_distribution<int>(p), N, seed), "geometric");
+    }
+}
+
+// Moments against theory, single draws against fill(), float variates and the tails of the normal
+void test_BatchSamplers()
+{
+    Xoshiro256x4 engine(11);
+    std::vector<double> x(1'000'000);
+
+    auto moments = [&x](double& mean, double& variance)
+    {
+        mean = 0;
+        for (double value : x) mean += value;
+        mean /= static_cast<double>(x.size());
+        variance = 0;
+        for (double value : x) variance += (value - mean) * (value - mean);
+        variance /= static_cast<double>(x.size() - 1);
+    };
+    double mean, variance;
+
+    NormalSampler<>(0, 1).fill(engine, x);
+    moments(mean, variance);
+    assert(std::abs(mean) < 0.005 && std::abs(variance - 1) < 0.005);
+    // About 580 variates beyond 3.44 (the start of the tail) in a million
+    const auto tail = std::count_if(x.begin(), x.end(), [](double value) { return std::abs(value) > 3.442619855899; });
+    assert(tail > 450 && tail < 710);
+    assert(*std::max_element(x.begin(), x.end()) > 4);
+
+    GammaSampler<>(0.5, 2).fill(engine, x);
+    moments(mean, variance);
+    assert(std::abs(mean - 1) < 0.01 && std::abs(variance - 2) < 0.03);
+    assert(*std::min_element(x.begin(), x.end()) > 0);
+
+    PoissonSampler<double>(1000).fill(engine, x);
+    moments(mean, variance);
+    assert(std::abs(mean - 1000) < 0.2 && std::abs(variance / 1000 - 1) < 0.01);
+
+    UniformSampler<>(5, 6).fill(engine, x);
+    assert(*std::min_element(x.begin(), x.end()) >= 5 && *std::max_element(x.begin(), x.end()) < 6);
+
+    // Single variates and other types
+    std::mt19937 small(3);
+    const NormalSampler<float> normal(10, 0.5f);
+    std::vector<float> floats(1001);
+    normal.fill(small, floats);
+    float sum = 0;
+    for (float value : floats) sum += value;
+    assert(std::abs(sum / 1001 - 10) < 0.1);
+    assert(std::abs(normal(small) - 10) < 5);
+    assert(GeometricSampler<>(0.999)(engine) >= 0);
+    assert(PoissonSampler<>(3)(engine) >= 0 && PoissonSampler<>(3000)(engine) > 2000);
+    assert(ChiSquaredSampler<>(2)(engine) > 0 && ExponentialSampler<>(4)(engine) > 0);
+    assert(UniformSampler<>(1, 2)(small) >= 1);
+
+    // An empty span draws nothing
+    Xoshiro256x4 untouched(11), copy(11);
+    NormalSampler<>().fill(untouched, std::span<double>());
+    assert(untouched == copy);
+
+    // Invalid parameters, as the std:: distributions define them
+    int thrown = 0;
+    try { UniformSampler<>(1, 1); } catch (const std::invalid_argument&) { ++thrown; }
+    try { NormalSampler<>(0, 0); } catch (const std::invalid_argument&) { ++thrown; }
+    try { ExponentialSampler<>(-1); } catch (const std::invalid_argument&) { ++thrown; }
+    try { GammaSampler<>(0, 1); } catch (const std::invalid_argument&) { ++thrown; }
+    try { ChiSquaredSampler<>(-3); } catch (const std::invalid_argument&) { ++thrown; }
+    try { PoissonSampler<>(0); } catch (const std::invalid_argument&) { ++thrown; }
+    try { GeometricSampler<>(1); } catch (const std::invalid_argument&) { ++thrown; }
+    assert(thrown == 7);
+}
+
+// Nanoseconds per variate: the std:: distribution over std::mt19937_64 one variate at a time, and the batch
+// sampler over std::mt19937_64 and over Xoshiro256x4 without and with AVX2
+template<typename Batch, typename Std>
+void benchmark_Sampler(const std::string& name, const Batch& batch, Std standard)
+{
+    constexpr std::size_t N = 1 << 22;
+    std::vector<typename Batch::result_type> out(N);
+    std::mt19937_64 twister(5);
+
+    StopWatch stopWatch;
+    stopWatch.Start();
+    {
+        double sum = 0;
+        for (std::size_t i = 0; i < N; ++i) sum += static_cast<double>(standard(twister));
+        sink += sum;
+    }
+    stopWatch.Stop();
+    const double stdTime = stopWatch.ElapsedTime();
+    stopWatch.Start();
+    batch.fill(twister, out);
+    sink += static_cast<double>(out.back());
+    stopWatch.Stop();
+    const double twisterTime = stopWatch.ElapsedTime();
+
+    double xoshiroTime[2];
+    for (bool simd : {false, true})
+    {
+        Xoshiro256x4::enableSimd(simd);
+        Ziggurat::enableSimd(simd);
+        Xoshiro256x4 engine(5);
+        stopWatch.Start();
+        batch.fill(engine, out);
+        sink += static_cast<double>(out.back());
+        stopWatch.Stop();
+        xoshiroTime[simd] = stopWatch.ElapsedTime();
+    }
+    Xoshiro256x4::enableSimd(true);
+    Ziggurat::enableSimd(true);
+
+    const double scale = 1e9 / N;
+    std::cout << name << "\t" << scale * stdTime << "\t\t" << scale * twisterTime << "\t\t" << scale * xoshiroTime[0]
+              << "\t\t" << scale * xoshiroTime[1] << std::endl;
+}
+
 int main()
 {
+    test_Xoshiro256x4();
+    test_Ziggurat();
+    test_Equivalence<Xoshiro256x4>(21);
+    test_Equivalence<std::mt19937_64>(22);
+    test_Equivalence<std::mt19937>(23);
+    test_BatchSamplers();
+
     test_linear_congruential_engine_uniform_distribution();
     test_mt19937_engine_uniform_distribution();
     test_mt19937_64_engine_uniform_distribution();
@@ -702,5 +1016,18 @@ int main()
     test_linear_congruential_generic_engine_cauchy_distribution();
     test_mt19937_generic_engine_cauchy_distribution();
     test_mt19937_64_generic_engine_cauchy_distribution();
+
+    std::cout << "\nns per variate\tstd::\t\tbatch mt19937_64\txoshiro\t\txoshiro SIMD" << std::endl;
+    benchmark_Sampler("uniform\t", UniformSampler<>(), std::uniform_real_distribution<double>());
+    benchmark_Sampler("normal\t", NormalSampler<>(), std::normal_distribution<double>());
+    benchmark_Sampler("exponential", ExponentialSampler<>(), std::exponential_distribution<double>());
+    benchmark_Sampler("gamma 2.5", GammaSampler<>(2.5), std::gamma_distribution<double>(2.5));
+    benchmark_Sampler("chi-sq 3", ChiSquaredSampler<>(3), std::chi_squared_distribution<double>(3));
+    benchmark_Sampler("poisson 7", PoissonSampler<>(7), std::poisson_distribution<int>(7));
+    benchmark_Sampler("poisson 1000", PoissonSampler<>(1000), std::poisson_distribution<int>(1000));
+    benchmark_Sampler("geometric", GeometricSampler<>(0.5), std::geometric_distribution<int>(0.5));
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+//
+// Binnings for Histogram: bins of equal width, and bins of equal width in log(x)
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "Bins.hpp"
+
+/**
+ * Overloaded ctor
+ * @param lower The lower edge of the first bin
+ * @param upper The upper edge of the last bin
+ * @param bins The number of bins
+ * @throws std::invalid_argument if the range is empty or there are no bins
+ */
+LinearBins::LinearBins(double lower, double upper, std::size_t bins)
+    : lower{lower}, upper{upper}, inverseWidth{static_cast<double>(bins) / (upper - lower)}, bins{bins}
+{
+    if (!(lower < upper) || bins == 0 || !std::isfinite(inverseWidth))
+    {
+        throw std::invalid_argument("Cannot split [" + std::to_string(lower) + ", " + std::to_string(upper) + ") into " +
+                                    std::to_string(bins) + " bins");
+    }
+}
+
+/**
+ * @param bin A bin, or size() for the upper edge of the last one
+ * @return The lower edge of the bin
+ */
+double LinearBins::lowerEdge(std::size_t bin) const noexcept
+{
+    return bin == bins ? upper : lower + static_cast<double>(bin) / inverseWidth;
+}
+
+/**
+ * Overloaded ctor
+ * @param lower The lower edge of the first bin; must be positive
+ * @param upper The upper edge of the last bin
+ * @param bins The number of bins
+ * @throws std::invalid_argument if lower is not positive, the range is empty or there are no bins
+ */
+LogBins::LogBins(double lower, double upper, std::size_t bins)
+    : lower{lower}, upper{upper}, logLower{std::log(lower)},
+      inverseWidth{static_cast<double>(bins) / (std::log(upper) - std::log(lower))}, bins{bins}
+{
+    if (!(lower > 0) || !(lower < upper) || bins == 0 || !std::isfinite(inverseWidth))
+    {
+        throw std::invalid_argument("Cannot split [" + std::to_string(lower) + ", " + std::to_string(upper) + ") into " +
+                                    std::to_string(bins) + " logarithmic bins");
+    }
+}
+
+/**
+ * @param bin A bin, or size() for the upper edge of the last one
+ * @return The lower edge of the bin
+ */
+double LogBins::lowerEdge(std::size_t bin) const noexcept
+{
+    return bin == bins ? upper : std::exp(logLower + static_cast<double>(bin) / inverseWidth);
+}
@@ -0,0 +1,81 @@
+//
+// Binnings for Histogram: LinearBins splits [lower, upper) into bins of equal width, LogBins into bins of
+// equal width in log(x), i.e. of equal relative width, for values spread over several orders of magnitude.
+// A quantile read from LogBins is off by at most half a bin's relative width whatever the scale of the data,
+// which makes it a simple mergeable quantile sketch.
+//
+// slot() maps a value to 0 below the range, bin + 1 inside it and size() + 1 at or above it, with a
+// multiply and two clamps instead of branches or a search; NaN goes to slot 0.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_BINS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_BINS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+class LinearBins
+{
+private:
+    double lower;
+    double upper;
+    double inverseWidth;
+    std::size_t bins;
+
+public:
+    LinearBins(double lower, double upper, std::size_t bins);
+    LinearBins(const LinearBins& source) = default;
+    ~LinearBins() = default;
+
+    // Operator overloads
+    LinearBins& operator=(const LinearBins& source) = default;
+    bool operator==(const LinearBins& other) const = default;
+
+    // Accessors
+    std::size_t size() const noexcept { return bins; }
+    double lowerEdge(std::size_t bin) const noexcept;
+    double upperEdge(std::size_t bin) const noexcept { return lowerEdge(bin + 1); }
+
+    // Core functionality
+    std::size_t slot(double x) const noexcept
+    {
+        const double position = std::min(static_cast<double>(bins), std::max(-1.0, (x - lower) * inverseWidth));
+        return static_cast<std::size_t>(position + 1.0);
+    }
+};
+
+class LogBins
+{
+private:
+    double lower;
+    double upper;
+    double logLower;
+    double inverseWidth;
+    std::size_t bins;
+
+public:
+    LogBins(double lower, double upper, std::size_t bins);
+    LogBins(const LogBins& source) = default;
+    ~LogBins() = default;
+
+    // Operator overloads
+    LogBins& operator=(const LogBins& source) = default;
+    bool operator==(const LogBins& other) const = default;
+
+    // Accessors
+    std::size_t size() const noexcept { return bins; }
+    double lowerEdge(std::size_t bin) const noexcept;
+    double upperEdge(std::size_t bin) const noexcept { return lowerEdge(bin + 1); }
+
+    // Core functionality
+    std::size_t slot(double x) const noexcept
+    {
+        const double position = std::min(static_cast<double>(bins), std::max(-1.0, (std::log(x) - logLower) * inverseWidth));
+        return static_cast<std::size_t>(position + 1.0);
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_BINS_HPP
@@ -0,0 +1,65 @@
+//
+// A histogram over a fixed binning (LinearBins or LogBins) that counts in a flat array: one slot() and one
+// increment per sample, against two std::map lookups and sometimes an allocation in the original
+// GenerateRandomNumbers. Samples below and above the range are counted too, so nothing is lost.
+//
+// The counts are kept in LANES interleaved copies and add(std::span) spreads consecutive samples over them,
+// so a run of samples in the same bin (the first bin of a geometric distribution gets half of them) does not
+// make every increment wait for the one before. Histograms with the same binning add up with +=, which is
+// how per-thread histograms are merged. quantile() interpolates within the bin that holds the quantile.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_HISTOGRAM_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_HISTOGRAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+template<typename Bins>
+class Histogram
+{
+private:
+    static constexpr std::size_t LANES = 4;
+
+    Bins bins;
+    std::vector<std::uint64_t> counts;      // LANES counts per slot: underflow, the bins, overflow
+
+    std::uint64_t slotCount(std::size_t slot) const noexcept;
+
+public:
+    explicit Histogram(const Bins& bins);
+    Histogram(const Histogram& source) = default;
+    Histogram(Histogram&& source) noexcept = default;
+    ~Histogram() = default;
+
+    // Operator overloads
+    Histogram& operator=(const Histogram& source) = default;
+    Histogram& operator=(Histogram&& source) noexcept = default;
+    Histogram& operator+=(const Histogram& other);
+
+    // Accessors
+    const Bins& binning() const noexcept { return bins; }
+    std::size_t size() const noexcept { return bins.size(); }
+    std::uint64_t count(std::size_t bin) const;
+    std::uint64_t underflow() const noexcept { return slotCount(0); }
+    std::uint64_t overflow() const noexcept { return slotCount(bins.size() + 1); }
+    std::uint64_t total() const noexcept;
+
+    // Core functionality
+    void add(double x) noexcept { ++counts[bins.slot(x) * LANES]; }
+    void add(std::span<const double> xs) noexcept;
+    double quantile(double q) const;
+    void print(std::ostream& ostream, std::size_t width = 60) const;
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_HISTOGRAM_CPP
+#include "Histogram.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_HISTOGRAM_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_HISTOGRAM_HPP
@@ -0,0 +1,51 @@
+//
+// Streaming mean, variance, skewness and kurtosis in one pass, without keeping the samples. The accumulator
+// keeps the count, the mean and the sums of the 2nd, 3rd and 4th powers of the deviations from the mean,
+// updated with Welford's recurrence (extended to higher moments by Pébay and Terriberry) so no large sums
+// cancel. Two accumulators merge exactly with Pébay's formulas, which is how per-thread results combine.
+//
+// add(std::span) updates with a whole block at once: the deviations are taken from the block's own mean in
+// a loop without divisions, and the block is then merged in, which is much cheaper per sample than Welford's
+// update and just as stable.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_MOMENTS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_MOMENTS_HPP
+
+#include <cstdint>
+#include <span>
+
+class Moments
+{
+private:
+    std::uint64_t n;
+    double average;
+    double m2;      // Sum of (x - mean)^2
+    double m3;      // Sum of (x - mean)^3
+    double m4;      // Sum of (x - mean)^4
+
+public:
+    Moments();
+    Moments(const Moments& source) = default;
+    ~Moments() = default;
+
+    // Operator overloads
+    Moments& operator=(const Moments& source) = default;
+    Moments& operator+=(const Moments& other);
+
+    // Accessors
+    std::uint64_t count() const noexcept { return n; }
+    double mean() const noexcept;
+    double variance() const noexcept;
+    double standardDeviation() const noexcept;
+    double skewness() const noexcept;
+    double kurtosis() const noexcept;
+
+    // Core functionality
+    void add(double x) noexcept;
+    void add(std::span<const double> xs) noexcept;
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_MOMENTS_HPP
@@ -1,35 +1,46 @@
 //
 // Additional illustration of a generic function that works with any distribution and random number engine.
-// The variates of the distribution will be stored in a map.
+// The variates of the distribution are counted in a fixed-bin histogram and summarised by their moments,
+// sampled on several threads.
 //
 // Created by Michael Lewis on 7/18/23.
 //
 
+#include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <map>
 #include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "BatchDistributions.hpp"
+#include "Bins.hpp"
+#include "Moments.hpp"
+#include "Histogram.hpp"
+#include "SampleStatistics.hpp"
+#include "StopWatch.hpp"
+#include "Xoshiro256x4.hpp"
+
+double sink = 0;
 
 // Part A - Generic function that works with any distribution and random number engine
-template<typename Dist, typename Eng>
-void GenerateRandomNumbers(Dist d, Eng eng, int nTrials, const std::string& s)
+template<typename Dist, typename Eng, typename Bins>
+SampleStatistics<Bins> GenerateRandomNumbers(Dist d, Eng eng, std::uint64_t nTrials, const Bins& bins, const std::string& s)
 {
-    // Key = bucket/value; Value = number of occurrences
-    std::map<long long, int> counter;
-    for (int i = 0; i < nTrials; ++i)
-    {
-        // Start the engine
-        auto randomNum = d(eng);
-        if (counter.contains(randomNum)) counter.at(randomNum)++;
-        else (counter.emplace(std::make_pair(randomNum, 1)));
-    }
+    SampleStatistics<Bins> statistics = SampleStatistics<Bins>::sample(d, eng, nTrials, bins);
+    const Moments& moments = statistics.moments();
 
     std::cout << "\n\n" << s << ": " << std::endl;
-    for (auto entry : counter)
-    {
-        std::cout << std::fixed << std::setprecision(1) << std::setw(2)
-                  << entry.first << " : " << std::string(entry.second / 100, '*') << '\n';
-    }
+    statistics.histogram().print(std::cout);
+    std::cout << std::setprecision(4) << "mean " << moments.mean() << ", variance " << moments.variance()
+              << ", skewness " << moments.skewness() << ", excess kurtosis " << moments.kurtosis()
+              << ", median " << statistics.histogram().quantile(0.5)
+              << ", 99th percentile " << statistics.histogram().quantile(0.99) << std::endl;
+    return statistics;
 }
 
 // Part B - Test the code by choosing the geometric distribution.
@@ -45,9 +56,14 @@ void test_geometric_distribution()
     std::geometric_distribution<int> dist;
 
     // Trials
-    int numTrials = 1'000'000;
+    std::uint64_t numTrials = 1'000'000;
 
-    GenerateRandomNumbers<std::geometric_distribution<int>, std::mt19937_64>(dist, engine, numTrials, "geometric distribution");
+    auto statistics = GenerateRandomNumbers(dist, engine, numTrials, LinearBins(0, 20, 20), "geometric distribution");
+
+    // p = 0.5: mean (1 - p) / p = 1, variance (1 - p) / p^2 = 2
+    assert(statistics.moments().count() == numTrials);
+    assert(std::abs(statistics.moments().mean() - 1.0) < 0.01);
+    assert(std::abs(statistics.moments().variance() - 2.0) < 0.05);
 }
 
 // Part B - Test the code by choosing the uniform distribution.
@@ -65,9 +81,15 @@ void test_uniform_distribution()
     std::uniform_int_distribution<int> dist(A, B);
 
     // Trials
-    int numTrials = 1'000'000;
+    std::uint64_t numTrials = 1'000'000;
+
+    auto statistics = GenerateRandomNumbers(dist, engine, numTrials, LinearBins(0, 16, 16), "uniform distribution");
 
-    GenerateRandomNumbers<std::uniform_int_distribution<int>, std::mt19937_64>(dist, engine, numTrials, "uniform distribution");
+    // 16 equally likely values: mean 7.5, variance (16^2 - 1) / 12, no skew
+    assert(std::abs(statistics.moments().mean() - 7.5) < 0.02);
+    assert(std::abs(statistics.moments().variance() - 255.0 / 12.0) < 0.1);
+    assert(std::abs(statistics.moments().skewness()) < 0.01);
+    assert(statistics.histogram().underflow() == 0 && statistics.histogram().overflow() == 0);
 }
 
 // Part B - Test the code by choosing the poisson distribution.
@@ -83,9 +105,15 @@ void test_poisson_distribution()
     std::poisson_distribution<int> dist(7);
 
     // Trials
-    int numTrials = 1'000'000;
+    std::uint64_t numTrials = 1'000'000;
 
-    GenerateRandomNumbers<std::poisson_distribution<int>, std::mt19937_64>(dist, engine, numTrials, "poisson distribution");
+    auto statistics = GenerateRandomNumbers(dist, engine, numTrials, LinearBins(0, 25, 25), "poisson distribution");
+
+    // lambda = 7: mean and variance 7, skewness 1 / sqrt(7), excess kurtosis 1 / 7
+    assert(std::abs(statistics.moments().mean() - 7.0) < 0.02);
+    assert(std::abs(statistics.moments().variance() - 7.0) < 0.1);
+    assert(std::abs(statistics.moments().skewness() - 1.0 / std::sqrt(7.0)) < 0.02);
+    assert(std::abs(statistics.moments().kurtosis() - 1.0 / 7.0) < 0.05);
 }
 
 // Part C - Examine the generated output in each case; does it look like the probability of these distributions?
@@ -96,10 +124,239 @@ void test_poisson_distribution()
 // Uniform: https://en.cppreference.com/w/cpp/numeric/random/uniform_int_distribution
 // Poisson: https://en.cppreference.com/w/cpp/numeric/random/poisson_distribution
 
+// Moments one at a time, in blocks and merged agree with a direct two-pass computation
+void test_Moments()
+{
+    std::mt19937_64 engine(1);
+    std::lognormal_distribution<double> dist(0.0, 0.5);
+    std::vector<double> xs(10'001);
+    for (double& x : xs) x = 1e6 + dist(engine);        // A large offset exposes cancellation
+
+    double mean = 0;
+    for (double x : xs) mean += x;
+    mean /= static_cast<double>(xs.size());
+    double m2 = 0, m3 = 0, m4 = 0;
+    for (double x : xs)
+    {
+        const double d = x - mean;
+        m2 += d * d;
+        m3 += d * d * d;
+        m4 += d * d * d * d;
+    }
+    const double n = static_cast<double>(xs.size());
+    const double variance = m2 / (n - 1);
+    const double skewness = std::sqrt(n) * m3 / std::pow(m2, 1.5);
+    const double kurtosis = n * m4 / (m2 * m2) - 3;
+
+    Moments single, block, merged, part;
+    for (double x : xs) single.add(x);
+    block.add(xs);
+    for (std::size_t i = 0; i < xs.size(); ++i)
+    {
+        part.add(xs[i]);
+        if (i % 997 == 996) { merged += part; part = Moments(); }
+    }
+    merged += part;
+
+    for (const Moments* m : {&single, &block, &merged})
+    {
+        assert(m->count() == xs.size());
+        assert(std::abs(m->mean() - mean) < 1e-9);
+        assert(std::abs(m->variance() / variance - 1) < 1e-9);
+        assert(std::abs(m->skewness() - skewness) < 1e-6);
+        assert(std::abs(m->kurtosis() - kurtosis) < 1e-6);
+    }
+
+    // Undefined moments are NaN; merging an empty accumulator changes nothing
+    Moments empty, one;
+    one.add(3.0);
+    assert(std::isnan(empty.mean()) && std::isnan(one.variance()) && one.mean() == 3.0);
+    one += empty;
+    empty += one;
+    assert(one.count() == 1 && empty.count() == 1 && empty.mean() == 3.0);
+}
+
+// Slots, edges, merging and quantiles of both binnings
+void test_Histogram()
+{
+    const LinearBins bins(0, 10, 5);
+    assert(bins.slot(-0.5) == 0 && bins.slot(0) == 1 && bins.slot(1.99) == 1 && bins.slot(2) == 2);
+    assert(bins.slot(9.99) == 5 && bins.slot(10) == 6 && bins.slot(1e300) == 6 && bins.slot(-1e300) == 0);
+    assert(bins.slot(std::nan("")) == 0);
+    assert(bins.lowerEdge(1) == 2 && bins.upperEdge(4) == 10 && bins.lowerEdge(5) == 10);
+
+    Histogram<LinearBins> first(bins), second(bins);
+    const std::vector<double> xs{-1, 0, 1, 3, 3, 5, 7, 9, 11, 12};
+    first.add(xs);
+    for (double x : xs) second.add(x);
+    assert(first.total() == xs.size() && first.underflow() == 1 && first.overflow() == 2);
+    for (std::size_t bin = 0; bin < bins.size(); ++bin) assert(first.count(bin) == second.count(bin));
+    assert(first.count(0) == 2 && first.count(1) == 2 && first.count(2) == 1);
+
+    first += second;
+    assert(first.total() == 2 * xs.size() && first.count(0) == 4);
+
+    bool thrown = false;
+    try { first += Histogram<LinearBins>(LinearBins(0, 10, 4)); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { first.count(5); }
+    catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { Histogram<LinearBins>(bins).quantile(0.5); }
+    catch (const std::domain_error&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { LinearBins(1, 1, 3); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { LogBins(0, 1, 3); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    // Quantiles of a uniform sample are within a bin width of the truth
+    std::mt19937_64 engine(2);
+    std::uniform_real_distribution<double> uniform(0, 10);
+    Histogram<LinearBins> fine(LinearBins(0, 10, 100));
+    for (int i = 0; i < 100'000; ++i) fine.add(uniform(engine));
+    for (double q : {0.0, 0.1, 0.5, 0.9, 1.0}) assert(std::abs(fine.quantile(q) - 10 * q) < 0.1);
+
+    // Log bins hold their relative error over six orders of magnitude
+    const LogBins logBins(1e-3, 1e3, 600);
+    assert(logBins.slot(0) == 0 && logBins.slot(-1) == 0 && logBins.slot(1e-3) == 1 && logBins.slot(1e3) == 601);
+    assert(std::abs(logBins.lowerEdge(300) - 1) < 1e-12);
+    std::lognormal_distribution<double> lognormal(0.0, 2.0);
+    std::vector<double> ys(200'000);
+    for (double& y : ys) y = lognormal(engine);
+    Histogram<LogBins> sketch(logBins);
+    sketch.add(ys);
+    std::sort(ys.begin(), ys.end());
+    for (double q : {0.01, 0.25, 0.5, 0.75, 0.99})
+    {
+        const double exact = ys[static_cast<std::size_t>(q * static_cast<double>(ys.size()))];
+        assert(std::abs(sketch.quantile(q) / exact - 1) < 0.025);
+    }
+}
+
+// Parallel sampling counts every variate exactly once and gives the same result for the same seed
+void test_SampleStatistics()
+{
+    std::mt19937_64 engine(3);
+    std::geometric_distribution<int> dist;
+    const LinearBins bins(0, 20, 20);
+    std::mt19937_64 copy = engine;
+    auto parallel = SampleStatistics<LinearBins>::sample(dist, engine, 100'003, bins, 4);
+    auto again = SampleStatistics<LinearBins>::sample(dist, copy, 100'003, bins, 4);
+    assert(parallel.moments().count() == 100'003 && parallel.histogram().total() == 100'003);
+    assert(parallel.moments().mean() == again.moments().mean());
+    for (std::size_t bin = 0; bin < bins.size(); ++bin) assert(parallel.histogram().count(bin) == again.histogram().count(bin));
+
+    auto none = SampleStatistics<LinearBins>::sample(dist, engine, 0, bins, 3);
+    assert(none.moments().count() == 0 && none.histogram().total() == 0);
+
+    // A batch sampler fills the buffers in one call: same distribution, mean 1 and variance 2
+    Xoshiro256x4 batchEngine(3);
+    auto batch = SampleStatistics<LinearBins>::sample(GeometricSampler<double>(0.5), batchEngine, 1'000'003, bins, 3);
+    assert(batch.moments().count() == 1'000'003 && batch.histogram().total() == 1'000'003);
+    assert(std::abs(batch.moments().mean() - 1.0) < 0.01 && std::abs(batch.moments().variance() - 2.0) < 0.05);
+    assert(batch.histogram().count(0) > 495'000 && batch.histogram().count(0) < 505'000);
+}
+
+// Nanoseconds per variate of the uniform distribution, which is cheap enough to show the cost of counting:
+// drawing only, drawing and counting in the std::map of the original GenerateRandomNumbers, and
+// SampleStatistics on one thread and on every core
+void benchmark_GenerateRandomNumbers(std::uint64_t samples)
+{
+    std::mt19937_64 engine(4);
+    std::uniform_int_distribution<int> dist(0, 15);
+    const LinearBins bins(0, 16, 16);
+
+    StopWatch stopWatch;
+    stopWatch.Start();
+    {
+        long long sum = 0;
+        for (std::uint64_t i = 0; i < samples; ++i) sum += dist(engine);
+        sink += static_cast<double>(sum);
+    }
+    stopWatch.Stop();
+    double drawOnly = stopWatch.ElapsedTime();
+
+    stopWatch.Start();
+    {
+        std::map<long long, int> counter;
+        for (std::uint64_t i = 0; i < samples; ++i)
+        {
+            auto randomNum = dist(engine);
+            if (counter.contains(randomNum)) counter.at(randomNum)++;
+            else (counter.emplace(std::make_pair(randomNum, 1)));
+        }
+        sink += counter.begin()->second;
+    }
+    stopWatch.Stop();
+    double map = stopWatch.ElapsedTime();
+
+    stopWatch.Start();
+    sink += SampleStatistics<LinearBins>::sample(dist, engine, samples, bins, 1).moments().mean();
+    stopWatch.Stop();
+    double single = stopWatch.ElapsedTime();
+
+    const unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+    stopWatch.Start();
+    sink += SampleStatistics<LinearBins>::sample(dist, engine, samples, bins, threads).moments().mean();
+    stopWatch.Stop();
+    double parallel = stopWatch.ElapsedTime();
+
+    const double scale = 1e9 / static_cast<double>(samples);
+    std::cout << "\nns per uniform variate, " << samples << " variates\n"
+              << "draw only\tstd::map\tstatistics\tstatistics on " << threads << " threads\n"
+              << std::setprecision(2) << scale * drawOnly << "\t\t" << scale * map << "\t\t" << scale * single << "\t\t"
+              << scale * parallel << std::endl;
+}
+
+// Nanoseconds per Poisson variate counted by SampleStatistics on one thread: std::poisson_distribution over
+// std::mt19937_64 one variate at a time, and PoissonSampler filling the buffer from Xoshiro256x4
+void benchmark_BatchSampling(std::uint64_t samples)
+{
+    const LinearBins bins(0, 25, 25);
+    std::mt19937_64 engine(6);
+    Xoshiro256x4 batchEngine(6);
+
+    StopWatch stopWatch;
+    stopWatch.Start();
+    sink += SampleStatistics<LinearBins>::sample(std::poisson_distribution<int>(7), engine, samples, bins, 1).moments().mean();
+    stopWatch.Stop();
+    double standard = stopWatch.ElapsedTime();
+    stopWatch.Start();
+    sink += SampleStatistics<LinearBins>::sample(PoissonSampler<double>(7), batchEngine, samples, bins, 1).moments().mean();
+    stopWatch.Stop();
+    double batch = stopWatch.ElapsedTime();
+
+    const double scale = 1e9 / static_cast<double>(samples);
+    std::cout << "\nns per poisson variate with statistics, " << samples << " variates\n"
+              << "std::\t\tbatch\n" << scale * standard << "\t\t" << scale * batch << std::endl;
+}
+
 int main()
 {
+    test_Moments();
+    test_Histogram();
+    test_SampleStatistics();
+
     test_geometric_distribution();
     test_uniform_distribution();
     test_poisson_distribution();
+
+    benchmark_GenerateRandomNumbers(20'000'000);
+    benchmark_BatchSampling(10'000'000);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
     return 0;
 }
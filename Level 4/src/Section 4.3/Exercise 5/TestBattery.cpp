@@ -0,0 +1,165 @@
+//
+// The stream of 64-bit words of an engine, and the parallel pass of the tests over it
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TESTBATTERY_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_TESTBATTERY_CPP
+
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+
+#include "TestBattery.hpp"
+
+/**
+ * Overloaded ctor
+ * @tparam Eng Any uniform random bit generator, or an engine of floating-point variates on [min, max)
+ * @param eng The engine, copied; the battery reads the copy's sequence from its current state
+ * @param threads The number of threads counting; 0 (hardware_concurrency() unknown) means one
+ */
+template<typename Eng>
+TestBattery<Eng>::TestBattery(const Eng& eng, unsigned int threads) : engine{eng}, threads{std::max(1u, threads)}
+{
+
+}
+
+/**
+ * @tparam Eng Any uniform random bit generator, or an engine of floating-point variates on [min, max)
+ * @return The next 64 bits of the engine's output, the earliest call in the most significant bits
+ */
+template<typename Eng>
+std::uint64_t TestBattery<Eng>::nextWord()
+{
+    using result_type = typename Eng::result_type;
+    if constexpr (std::is_floating_point_v<result_type>)
+    {
+        auto draw = [this]
+        {
+            const double u = static_cast<double>(engine() - Eng::min()) / static_cast<double>(Eng::max() - Eng::min());
+            return std::min<std::uint64_t>(static_cast<std::uint64_t>(u * 4294967296.0), 0xFFFFFFFF);
+        };
+        const std::uint64_t high = draw();
+        return high << 32 | draw();
+    }
+    else
+    {
+        // Not a constant expression: Boost's engines do not declare min() and max() constexpr
+        const auto range = static_cast<std::uint64_t>(Eng::max() - Eng::min());
+        if (range == std::numeric_limits<std::uint64_t>::max()) return static_cast<std::uint64_t>(engine() - Eng::min());
+
+        const int bits = static_cast<int>(std::bit_width(range)) - (std::has_single_bit(range + 1) ? 0 : 1);
+        std::uint64_t word = 0;
+        for (int filled = 0; filled < 64; filled += bits)
+        {
+            std::uint64_t x;
+            do x = static_cast<std::uint64_t>(engine() - Eng::min()); while (x >> bits != 0);
+            word = word << bits | x;
+        }
+        return word;
+    }
+}
+
+/**
+ * Fills words with the engine's stream, advancing the engine
+ * @tparam Eng Any uniform random bit generator, or an engine of floating-point variates on [min, max)
+ * @param words The words to fill
+ */
+template<typename Eng>
+void TestBattery<Eng>::generate(std::span<std::uint64_t> words)
+{
+    for (std::uint64_t& word : words) word = nextWord();
+}
+
+/**
+ * Runs every test over the next bytes of the engine's output, rounded down to whole words. The engine is
+ * advanced, so a second run tests the continuation of the stream.
+ * @tparam Eng Any uniform random bit generator, or an engine of floating-point variates on [min, max)
+ * @param bytes The length of the stream
+ * @return The statistic and p-value of every test
+ */
+template<typename Eng>
+std::vector<TestResult> TestBattery<Eng>::run(std::uint64_t bytes)
+{
+    std::uint64_t remaining = bytes / sizeof(std::uint64_t);
+    if (threads == 1)
+    {
+        RandomnessTests tests;
+        std::vector<std::uint64_t> block(BLOCK);
+        while (remaining > 0)
+        {
+            block.resize(static_cast<std::size_t>(std::min<std::uint64_t>(remaining, BLOCK)));
+            generate(block);
+            tests.add(block);
+            remaining -= block.size();
+        }
+        return tests.results();
+    }
+
+    // Two blocks per worker: one being counted, one waiting while the next is generated
+    std::mutex mutex;
+    std::condition_variable filled, emptied;
+    std::vector<std::vector<std::uint64_t>> pool(2 * threads, std::vector<std::uint64_t>(BLOCK));
+    std::deque<std::vector<std::uint64_t>> queue;
+    bool done = false;
+
+    std::vector<RandomnessTests> partials(threads);
+    auto work = [&](unsigned int t)
+    {
+        while (true)
+        {
+            std::vector<std::uint64_t> block;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                filled.wait(lock, [&] { return !queue.empty() || done; });
+                if (queue.empty()) return;
+                block = std::move(queue.front());
+                queue.pop_front();
+            }
+            partials[t].add(block);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pool.push_back(std::move(block));
+            }
+            emptied.notify_one();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads; ++t) workers.emplace_back(work, t);
+
+    while (remaining > 0)
+    {
+        std::vector<std::uint64_t> block;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            emptied.wait(lock, [&] { return !pool.empty(); });
+            block = std::move(pool.back());
+            pool.pop_back();
+        }
+        block.resize(static_cast<std::size_t>(std::min<std::uint64_t>(remaining, BLOCK)));
+        generate(block);
+        remaining -= block.size();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(std::move(block));
+        }
+        filled.notify_one();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    filled.notify_all();
+    for (std::thread& worker : workers) worker.join();
+
+    for (unsigned int t = 1; t < threads; ++t) partials[0] += partials[t];
+    return partials[0].results();
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_TESTBATTERY_CPP
@@ -1,13 +1,32 @@
 //
 // Illustrate the functionality of independent_bits_engine to automatically generate bitsets
 //
+// Parts B and C count the bits of a few thousand values; the battery of RandomnessTests.hpp asks the same
+// question, and eight harder ones, of hundreds of megabytes of any engine's output and answers with
+// p-values. Tests check the p-value functions, the conversion of engine output to 64-bit words, that the
+// results do not depend on the number of threads, that good engines pass and that RANDU and the low bits
+// of a 64-bit LCG fail. The benchmark reports megabytes tested per second.
+//
 // Created by Michael Lewis on 7/18/23.
 //
 
 #include <bitset>
-#include <chrono>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <random>
+#include <thread>
+#include <vector>
+
+#include "StopWatch.hpp"
+#include "TestBattery.hpp"
+
+// RANDU, x <- 65539 x mod 2^31, whose triples lie on 15 planes
+using Randu = std::linear_congruential_engine<std::uint32_t, 65539, 0, 2147483648u>;
+
+// Knuth's MMIX LCG, all 64 bits of the state: bit k has period 2^(k + 1)
+using Lcg64 = std::linear_congruential_engine<std::uint64_t, 6364136223846793005u, 1442695040888963407u, 0>;
 
 // Helper function to print the results of the independent bit engine
 void print(const std::string& id, auto engine, int count)
@@ -138,6 +157,147 @@ void test_engine_to_bitset_width_64(double trials)
               << std::boolalpha << " : Is in tolerance: " << isInTolerance << std::endl;
 }
 
+// An engine of doubles on [0, 1), like boost::lagged_fibonacci44497, with 53 bits of mt19937_64
+struct Unit
+{
+    using result_type = double;
+    std::mt19937_64* engine;
+    static constexpr double min() { return 0; }
+    static constexpr double max() { return 1; }
+    double operator()() { return std::ldexp(static_cast<double>((*engine)() >> 11), -53); }
+};
+
+// The p-value functions against tabulated quantiles
+void test_PValues()
+{
+    assert(RandomnessTests::normalPValue(0) == 1);
+    assert(std::abs(RandomnessTests::normalPValue(1.959964) - 0.05) < 1e-6);
+    assert(std::abs(RandomnessTests::normalPValue(-2.575829) - 0.01) < 1e-6);
+
+    assert(std::abs(RandomnessTests::chiSquaredPValue(3.841459, 1) - 0.05) < 1e-6);
+    assert(std::abs(RandomnessTests::chiSquaredPValue(18.307038, 10) - 0.05) < 1e-6);
+    assert(std::abs(RandomnessTests::chiSquaredPValue(2.558212, 10) - 0.99) < 1e-6);
+    assert(std::abs(RandomnessTests::chiSquaredPValue(4244.0, 4095) - 0.0513) < 1e-3);
+    assert(RandomnessTests::chiSquaredPValue(0, 4) == 1);
+    assert(RandomnessTests::chiSquaredPValue(1000, 4) < 1e-200);
+
+    assert(std::abs(RandomnessTests::kolmogorovPValue(1.358099) - 0.05) < 1e-5);
+    assert(std::abs(RandomnessTests::kolmogorovPValue(0.827574) - 0.5) < 1e-5);
+    assert(std::abs(RandomnessTests::kolmogorovPValue(0.999999) - RandomnessTests::kolmogorovPValue(1.000001)) < 1e-5);
+    assert(RandomnessTests::kolmogorovPValue(0) == 1);
+}
+
+// Engines of 32 bits, 4 bits, 31 bits less two values and doubles become the same kind of 64-bit words
+void test_WordStream()
+{
+    std::vector<std::uint64_t> words(3);
+
+    std::mt19937 mt{5};
+    TestBattery mtBattery(mt);
+    mtBattery.generate(words);
+    for (std::uint64_t word : words)
+    {
+        const std::uint64_t high = mt();
+        assert(word == (high << 32 | mt()));
+    }
+
+    std::independent_bits_engine<std::mt19937_64, 4, unsigned int> nibbles{5};
+    TestBattery nibbleBattery(nibbles);
+    nibbleBattery.generate(words);
+    for (std::uint64_t word : words)
+    {
+        std::uint64_t expected = 0;
+        for (int i = 0; i < 16; ++i) expected = expected << 4 | nibbles();
+        assert(word == expected);
+    }
+
+    // minstd_rand returns 1 to 2^31 - 2: 30 bits per value, values above 2^30 are skipped
+    std::minstd_rand minstd{5};
+    TestBattery minstdBattery(minstd);
+    minstdBattery.generate(words);
+    for (std::uint64_t word : words)
+    {
+        std::uint64_t expected = 0;
+        for (int filled = 0; filled < 64; filled += 30)
+        {
+            std::uint64_t x;
+            do x = minstd() - 1; while (x >= std::uint64_t{1} << 30);
+            expected = expected << 30 | x;
+        }
+        assert(word == expected);
+    }
+
+    std::mt19937_64 canonical{5};
+    TestBattery unitBattery(Unit{&canonical});
+    std::mt19937_64 reference{5};
+    unitBattery.generate(words);
+    for (std::uint64_t word : words)
+    {
+        const std::uint64_t high = reference() >> 32;
+        assert(word == (high << 32 | reference() >> 32));
+    }
+}
+
+// The counts are the same however the blocks are shared out, so are the statistics
+void test_Threads()
+{
+    const std::uint64_t bytes = 5 * TestBattery<std::mt19937_64>::BLOCK * 8 + 4000;
+    const std::vector<TestResult> one = TestBattery(std::mt19937_64{7}, 1).run(bytes);
+    const std::vector<TestResult> three = TestBattery(std::mt19937_64{7}, 3).run(bytes);
+    assert(one.size() == 9 && three.size() == one.size());
+    for (std::size_t i = 0; i < one.size(); ++i)
+    {
+        assert(one[i].name == three[i].name && one[i].samples == three[i].samples);
+        assert(one[i].statistic == three[i].statistic && one[i].pValue == three[i].pValue);
+    }
+    assert(one[0].samples == 64 * (bytes / 8));
+}
+
+// A good engine passes every test, bad ones fail some
+void test_Battery()
+{
+    for (const TestResult& result : TestBattery(std::mt19937_64{11}).run(std::uint64_t{32} << 20))
+    {
+        assert(result.pValue > 1e-4 && result.pValue < 1 - 1e-4);
+    }
+
+    auto fails = [](const std::vector<TestResult>& results, const std::string& name)
+    {
+        for (const TestResult& result : results)
+        {
+            if (result.name == name) return result.pValue < 1e-10;
+        }
+        return false;
+    };
+    const std::vector<TestResult> randu = TestBattery(Randu{1}).run(std::uint64_t{4} << 20);
+    assert(fails(randu, "serial") && fails(randu, "birthday spacings, high bits"));
+    const std::vector<TestResult> lcg = TestBattery(Lcg64{1}).run(std::uint64_t{32} << 20);
+    assert(fails(lcg, "birthday spacings, low bits") && !fails(lcg, "birthday spacings, high bits"));
+}
+
+// Runs and prints the battery over megabytes of an engine's output
+template<typename Eng>
+void report(const std::string& id, const Eng& engine, std::uint64_t megabytes)
+{
+    std::cout << id << ", " << megabytes << " MB" << std::endl;
+    RandomnessTests::print(std::cout, TestBattery(engine).run(megabytes << 20));
+}
+
+// Megabytes tested per second on one thread and on all of them
+void benchmark_Battery(std::uint64_t megabytes)
+{
+    for (unsigned int threads : {1u, std::max(1u, std::thread::hardware_concurrency())})
+    {
+        TestBattery battery(std::mt19937_64{13}, threads);
+        StopWatch stopWatch;
+        stopWatch.Start();
+        battery.run(megabytes << 20);
+        stopWatch.Stop();
+        const double seconds = stopWatch.ElapsedTime();
+        std::cout << "mt19937_64, " << threads << " threads: " << static_cast<double>(megabytes) / seconds << " MB/s" << std::endl;
+    }
+}
+
 int main()
 {
     test_independent_bits_engine();
@@ -149,5 +309,20 @@ int main()
     // Note for Part C - Depending on the tolerance I've specified, the number of trials can either decrease or
     // or would need to increase. For example, if I increase my tolerance, the number of trials can decrease. If I
     // reduce the tolerance then the number of trials must increase.
+
+    // The battery of tests, on the engines above and on two known to be bad
+    test_PValues();
+    test_WordStream();
+    test_Threads();
+    test_Battery();
+
+    report("independent_bits_engine<mt19937_64, 4>", std::independent_bits_engine<std::mt19937_64, 4, unsigned int>{1}, 64);
+    report("mt19937_64", std::mt19937_64{1}, 256);
+    report("minstd_rand", std::minstd_rand{1}, 256);
+    report("RANDU", Randu{1}, 16);
+    report("64-bit LCG", Lcg64{1}, 256);
+    benchmark_Battery(256);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
     return 0;
 }
@@ -0,0 +1,338 @@
+//
+// Empirical tests of randomness: counting over blocks of words, merging, statistics and p-values
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <numbers>
+
+#include "RandomnessTests.hpp"
+
+/**
+ * Default ctor: no words yet
+ */
+RandomnessTests::RandomnessTests()
+    : words{0}, ones{0}, neighbours{0}, changes{0}, pairs(64 * 64, 0), gaps{}, hands{}, highCollisions{},
+      lowCollisions{}, bytes{}, uniforms(KS_CELLS, 0)
+{
+
+}
+
+/**
+ * Adds the counts of another accumulator, e.g. one filled by another thread
+ * @param other The other accumulator
+ * @return This accumulator
+ */
+RandomnessTests& RandomnessTests::operator+=(const RandomnessTests& other)
+{
+    words += other.words;
+    ones += other.ones;
+    neighbours += other.neighbours;
+    changes += other.changes;
+    for (std::size_t i = 0; i < pairs.size(); ++i) pairs[i] += other.pairs[i];
+    for (std::size_t i = 0; i < gaps.size(); ++i) gaps[i] += other.gaps[i];
+    for (std::size_t i = 0; i < hands.size(); ++i) hands[i] += other.hands[i];
+    for (std::size_t i = 0; i < highCollisions.size(); ++i) highCollisions[i] += other.highCollisions[i];
+    for (std::size_t i = 0; i < lowCollisions.size(); ++i) lowCollisions[i] += other.lowCollisions[i];
+    for (std::size_t i = 0; i < bytes.size(); ++i) bytes[i] += other.bytes[i];
+    for (std::size_t i = 0; i < uniforms.size(); ++i) uniforms[i] += other.uniforms[i];
+    return *this;
+}
+
+/**
+ * Sorts 24-bit values with three passes of a radix sort, which unlike a comparison sort does not branch on
+ * the random values; the birthday test sorts four times per 512 words and would otherwise dominate add()
+ * @param days Values below 2^24
+ */
+void RandomnessTests::sortDays(std::array<std::uint32_t, BIRTHDAYS>& days)
+{
+    std::array<std::array<std::uint32_t, 257>, 3> offsets{};
+    for (std::uint32_t day : days)
+    {
+        ++offsets[0][(day & 0xFF) + 1];
+        ++offsets[1][(day >> 8 & 0xFF) + 1];
+        ++offsets[2][(day >> 16) + 1];
+    }
+    for (auto& offset : offsets)
+    {
+        for (std::size_t digit = 1; digit < offset.size(); ++digit) offset[digit] += offset[digit - 1];
+    }
+
+    std::array<std::uint32_t, BIRTHDAYS> scratch;
+    for (std::uint32_t day : days) scratch[offsets[0][day & 0xFF]++] = day;
+    for (std::uint32_t day : scratch) days[offsets[1][day >> 8 & 0xFF]++] = day;
+    for (std::uint32_t day : days) scratch[offsets[2][day >> 16]++] = day;
+    days = scratch;
+}
+
+/**
+ * Marsaglia's birthday spacings statistic
+ * @param birthdays The birthdays of one sample, below 2^24; sorted on return
+ * @return The number of spacings between sorted birthdays equal to a smaller spacing
+ */
+std::size_t RandomnessTests::repeatedSpacings(std::array<std::uint32_t, BIRTHDAYS>& birthdays)
+{
+    sortDays(birthdays);
+    std::array<std::uint32_t, BIRTHDAYS> spacings;
+    spacings[0] = birthdays[0];
+    for (std::size_t j = 1; j < BIRTHDAYS; ++j) spacings[j] = birthdays[j] - birthdays[j - 1];
+    sortDays(spacings);
+
+    std::size_t repeated = 0;
+    for (std::size_t j = 1; j < BIRTHDAYS; ++j) repeated += spacings[j] == spacings[j - 1];
+    return repeated;
+}
+
+/**
+ * Counts a block of words for every test
+ * @param block Consecutive words of the stream
+ */
+void RandomnessTests::add(std::span<const std::uint64_t> block)
+{
+    if (block.empty()) return;
+    const std::size_t n = block.size();
+    words += n;
+    neighbours += 64 * n - 1;
+
+    std::uint64_t previous = block[0] >> 63;        // No change before the first bit
+    std::size_t gap = 0;
+    bool marked = false;                            // Gaps are counted from the first marked word on
+    for (std::uint64_t word : block)
+    {
+        ones += static_cast<std::uint64_t>(std::popcount(word));
+        changes += static_cast<std::uint64_t>(std::popcount((word ^ word >> 1) & 0x7FFFFFFFFFFFFFFF)) + ((previous ^ word >> 63) & 1);
+        previous = word;
+
+        if (word >> 60 == 0)
+        {
+            if (marked) ++gaps[std::min(gap, GAPS)];
+            marked = true;
+            gap = 0;
+        }
+        else ++gap;
+
+        for (int shift = 0; shift < 64; shift += 8) ++bytes[word >> shift & 0xFF];
+        ++uniforms[word >> 44];
+    }
+
+    for (std::size_t i = 0; i + 2 <= n; i += 2) ++pairs[(block[i] >> 58) * 64 + (block[i + 1] >> 58)];
+
+    for (std::size_t i = 0; i + 5 <= n; i += 5)
+    {
+        unsigned int seen = 0;
+        for (std::size_t j = i; j < i + 5; ++j) seen |= 1u << (block[j] >> 60);
+        ++hands[static_cast<std::size_t>(std::popcount(seen)) - 1];
+    }
+
+    std::array<std::uint32_t, BIRTHDAYS> birthdays;
+    for (std::size_t i = 0; i + BIRTHDAYS <= n; i += BIRTHDAYS)
+    {
+        for (std::size_t j = 0; j < BIRTHDAYS; ++j) birthdays[j] = static_cast<std::uint32_t>(block[i + j] >> 40);
+        ++highCollisions[std::min(repeatedSpacings(birthdays), highCollisions.size() - 1)];
+        for (std::size_t j = 0; j < BIRTHDAYS; ++j) birthdays[j] = static_cast<std::uint32_t>(block[i + j] & 0xFFFFFF);
+        ++lowCollisions[std::min(repeatedSpacings(birthdays), lowCollisions.size() - 1)];
+    }
+}
+
+/**
+ * Pearson's chi-squared test; neighbouring cells are merged until every cell expects at least 5 counts
+ * @param name The name of the test
+ * @param observed The counts per cell
+ * @param probabilities The probability of each cell, summing to 1
+ * @return The statistic and its p-value, NaN if there are fewer than two cells after merging
+ */
+TestResult RandomnessTests::chiSquared(const std::string& name, const std::vector<double>& observed, const std::vector<double>& probabilities)
+{
+    double total = 0;
+    for (double count : observed) total += count;
+
+    std::vector<double> mergedObserved, mergedExpected;
+    double o = 0, e = 0;
+    for (std::size_t i = 0; i < observed.size(); ++i)
+    {
+        o += observed[i];
+        e += probabilities[i] * total;
+        if (e >= 5)
+        {
+            mergedObserved.push_back(o);
+            mergedExpected.push_back(e);
+            o = e = 0;
+        }
+    }
+    if (!mergedObserved.empty())
+    {
+        mergedObserved.back() += o;
+        mergedExpected.back() += e;
+    }
+
+    double statistic = 0;
+    for (std::size_t i = 0; i < mergedObserved.size(); ++i)
+    {
+        statistic += (mergedObserved[i] - mergedExpected[i]) * (mergedObserved[i] - mergedExpected[i]) / mergedExpected[i];
+    }
+    const double pValue = mergedObserved.size() < 2 ? std::numeric_limits<double>::quiet_NaN()
+                                                    : chiSquaredPValue(statistic, static_cast<double>(mergedObserved.size() - 1));
+    return {name, statistic, pValue, static_cast<std::uint64_t>(total)};
+}
+
+/**
+ * @return The statistic and p-value of every test, in the order of the list in the header
+ */
+std::vector<TestResult> RandomnessTests::results() const
+{
+    std::vector<TestResult> results;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    auto asDouble = [](const auto& counts) { return std::vector<double>(counts.begin(), counts.end()); };
+
+    const double bits = 64.0 * static_cast<double>(words);
+    const double frequency = words == 0 ? nan : (2.0 * static_cast<double>(ones) - bits) / std::sqrt(bits);
+    results.push_back({"frequency", frequency, normalPValue(frequency), 64 * words});
+
+    const double pairsOfBits = static_cast<double>(neighbours);
+    const double runs = words == 0 ? nan : (2.0 * static_cast<double>(changes) - pairsOfBits) / std::sqrt(pairsOfBits);
+    results.push_back({"runs", runs, normalPValue(runs), neighbours});
+
+    results.push_back(chiSquared("serial", asDouble(pairs), std::vector<double>(pairs.size(), 1.0 / static_cast<double>(pairs.size()))));
+
+    std::vector<double> gapProbabilities(GAPS + 1);
+    for (std::size_t k = 0; k < GAPS; ++k) gapProbabilities[k] = std::pow(15.0 / 16.0, static_cast<double>(k)) / 16.0;
+    gapProbabilities[GAPS] = std::pow(15.0 / 16.0, static_cast<double>(GAPS));
+    results.push_back(chiSquared("gap", asDouble(gaps), gapProbabilities));
+
+    // 16 * 15 * ... * (16 - r + 1) ways to choose the r distinct values, S(5, r) ways to deal them out
+    const double stirling[] = {1, 15, 25, 10, 1};
+    std::vector<double> handProbabilities(5);
+    double falling = 1;
+    for (std::size_t r = 1; r <= 5; ++r)
+    {
+        falling *= static_cast<double>(17 - r);
+        handProbabilities[r - 1] = falling * stirling[r - 1] / std::pow(16.0, 5);
+    }
+    results.push_back(chiSquared("poker", asDouble(hands), handProbabilities));
+
+    // lambda = m^3 / (4n) = 512^3 / 2^26 = 2
+    std::vector<double> poisson(highCollisions.size());
+    double probability = std::exp(-2.0), cumulative = 0;
+    for (std::size_t k = 0; k + 1 < poisson.size(); ++k)
+    {
+        poisson[k] = probability;
+        cumulative += probability;
+        probability *= 2.0 / static_cast<double>(k + 1);
+    }
+    poisson.back() = 1 - cumulative;
+    results.push_back(chiSquared("birthday spacings, high bits", asDouble(highCollisions), poisson));
+    results.push_back(chiSquared("birthday spacings, low bits", asDouble(lowCollisions), poisson));
+
+    results.push_back(chiSquared("chi-squared of bytes", asDouble(bytes), std::vector<double>(bytes.size(), 1.0 / 256)));
+
+    double distance = 0;
+    std::uint64_t below = 0;
+    for (std::size_t k = 0; k < uniforms.size(); ++k)
+    {
+        below += uniforms[k];
+        const double empirical = static_cast<double>(below) / static_cast<double>(words);
+        distance = std::max(distance, std::abs(empirical - static_cast<double>(k + 1) / static_cast<double>(uniforms.size())));
+    }
+    const double kolmogorov = words == 0 ? nan : std::sqrt(static_cast<double>(words)) * distance;
+    results.push_back({"Kolmogorov-Smirnov", kolmogorov, kolmogorovPValue(kolmogorov), words});
+
+    return results;
+}
+
+/**
+ * @param z A standard normal statistic
+ * @return The two-sided p-value P(|Z| >= |z|)
+ */
+double RandomnessTests::normalPValue(double z)
+{
+    return std::erfc(std::abs(z) / std::numbers::sqrt2);
+}
+
+/**
+ * The upper tail of the chi-squared distribution, the regularised incomplete gamma function Q(k / 2, x / 2):
+ * its series below the mean and its continued fraction above (Numerical Recipes, 6.2)
+ * @param statistic The statistic x
+ * @param freedom The degrees of freedom k
+ * @return P(X >= x)
+ */
+double RandomnessTests::chiSquaredPValue(double statistic, double freedom)
+{
+    if (std::isnan(statistic)) return statistic;
+    const double a = freedom / 2;
+    const double y = statistic / 2;
+    if (y <= 0) return 1;
+
+    const double logPrefactor = -y + a * std::log(y) - std::lgamma(a);
+    if (y < a + 1)
+    {
+        double term = 1 / a, sum = term;
+        for (int n = 1; n < 100'000 && term > sum * 1e-16; ++n)
+        {
+            term *= y / (a + n);
+            sum += term;
+        }
+        return std::max(0.0, 1 - sum * std::exp(logPrefactor));
+    }
+
+    constexpr double TINY = 1e-300;
+    double b = y + 1 - a, c = 1 / TINY, d = 1 / b, h = d;
+    for (int i = 1; i < 100'000; ++i)
+    {
+        const double an = -i * (i - a);
+        b += 2;
+        d = an * d + b;
+        if (std::abs(d) < TINY) d = TINY;
+        c = b + an / c;
+        if (std::abs(c) < TINY) c = TINY;
+        d = 1 / d;
+        const double delta = d * c;
+        h *= delta;
+        if (std::abs(delta - 1) < 1e-16) break;
+    }
+    return std::exp(logPrefactor) * h;
+}
+
+/**
+ * The upper tail of Kolmogorov's distribution, the limit of sqrt(n) D: one series for small values and
+ * another for large ones, both converging in a few terms
+ * @param statistic sqrt(n) D
+ * @return P(K >= statistic)
+ */
+double RandomnessTests::kolmogorovPValue(double statistic)
+{
+    if (std::isnan(statistic)) return statistic;
+    if (statistic <= 0) return 1;
+    if (statistic < 1)
+    {
+        const double factor = -std::numbers::pi * std::numbers::pi / (8 * statistic * statistic);
+        double sum = 0;
+        for (int j = 1; j <= 7; ++j) sum += std::exp(factor * (2 * j - 1) * (2 * j - 1));
+        return 1 - std::sqrt(2 * std::numbers::pi) / statistic * sum;
+    }
+    double sum = 0;
+    for (int j = 1; j <= 100; ++j) sum += (j % 2 ? 2 : -2) * std::exp(-2.0 * j * j * statistic * statistic);
+    return std::clamp(sum, 0.0, 1.0);
+}
+
+/**
+ * Prints one line per test; p-values outside [0.001, 0.999] are suspect and those outside
+ * [1e-10, 1 - 1e-10] fail, as in TestU01
+ * @param ostream The stream
+ * @param results The results of the tests
+ */
+void RandomnessTests::print(std::ostream& ostream, const std::vector<TestResult>& results)
+{
+    for (const TestResult& result : results)
+    {
+        const double p = result.pValue;
+        const char* verdict = !(p >= 1e-10 && p <= 1 - 1e-10) ? "FAIL" : (p < 1e-3 || p > 1 - 1e-3) ? "suspect" : "pass";
+        ostream << std::left << std::setw(32) << result.name << std::right << std::setw(14) << result.samples
+                << std::setw(14) << std::setprecision(5) << result.statistic << std::setw(14) << std::setprecision(4)
+                << p << "  " << verdict << '\n';
+    }
+}
@@ -0,0 +1,90 @@
+//
+// Empirical tests of randomness over a stream of 64-bit words, in the spirit of Knuth (TAOCP vol. 2, 3.3.2),
+// Marsaglia's Diehard and NIST SP 800-22:
+//
+// - frequency: the number of one bits, against n / 2
+// - runs: the number of runs of equal bits, i.e. of changes between neighbouring bits, against (n - 1) / 2
+// - serial: the pairs formed by the top 6 bits of two successive words, 4096 cells
+// - gap: the gaps between words whose top 4 bits are 0, geometric with p = 1/16
+// - poker: the number of distinct values among the top 4 bits of 5 successive words
+// - birthday spacings: 512 birthdays in a year of 2^24 days from the top and from the bottom 24 bits of the
+//   words; the number of repeated spacings is Poisson with mean 2
+// - chi-squared: all 8 bytes of every word, 256 cells
+// - Kolmogorov-Smirnov: the top 20 bits as uniforms on [0, 1), the largest distance between their
+//   distribution function and the uniform one over 2^20 points
+//
+// add() takes the words a block at a time and only counts, so accumulators filled from different parts of
+// the stream on different threads merge with += into the result of one pass. Tests that look at neighbouring
+// words do not look across the edges of blocks. results() turns the counts into statistics and p-values:
+// the probability of a statistic at least as extreme under the hypothesis of independent uniform bits.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_RANDOMNESSTESTS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_RANDOMNESSTESTS_HPP
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+struct TestResult
+{
+    std::string name;
+    double statistic;       // z, chi-squared or sqrt(n) D
+    double pValue;
+    std::uint64_t samples;
+};
+
+class RandomnessTests
+{
+public:
+    static constexpr std::size_t GAPS = 64;                 // Gaps of 0 to 63 words, and longer
+    static constexpr std::size_t BIRTHDAYS = 512;
+    static constexpr std::size_t KS_CELLS = 1 << 20;
+
+private:
+    std::uint64_t words;
+    std::uint64_t ones;
+    std::uint64_t neighbours;                               // Pairs of neighbouring bits
+    std::uint64_t changes;
+    std::vector<std::uint64_t> pairs;                       // Serial test, 64 x 64 cells
+    std::array<std::uint64_t, GAPS + 1> gaps;
+    std::array<std::uint64_t, 5> hands;                     // Poker hands with 1 to 5 distinct values
+    std::array<std::uint64_t, 16> highCollisions;           // Birthday samples with 0 to 14 repeated spacings, and more
+    std::array<std::uint64_t, 16> lowCollisions;
+    std::array<std::uint64_t, 256> bytes;
+    std::vector<std::uint64_t> uniforms;                    // Kolmogorov-Smirnov cells
+
+    static void sortDays(std::array<std::uint32_t, BIRTHDAYS>& days);
+    static std::size_t repeatedSpacings(std::array<std::uint32_t, BIRTHDAYS>& birthdays);
+    static TestResult chiSquared(const std::string& name, const std::vector<double>& observed, const std::vector<double>& probabilities);
+
+public:
+    RandomnessTests();
+    RandomnessTests(const RandomnessTests& source) = default;
+    RandomnessTests(RandomnessTests&& source) noexcept = default;
+    ~RandomnessTests() = default;
+
+    // Operator overloads
+    RandomnessTests& operator=(const RandomnessTests& source) = default;
+    RandomnessTests& operator=(RandomnessTests&& source) noexcept = default;
+    RandomnessTests& operator+=(const RandomnessTests& other);
+
+    // Accessors
+    std::uint64_t count() const noexcept { return words; }
+
+    // Core functionality
+    void add(std::span<const std::uint64_t> block);
+    std::vector<TestResult> results() const;
+
+    static double normalPValue(double z);
+    static double chiSquaredPValue(double statistic, double freedom);
+    static double kolmogorovPValue(double statistic);
+    static void print(std::ostream& ostream, const std::vector<TestResult>& results);
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_RANDOMNESSTESTS_HPP
@@ -0,0 +1,63 @@
+//
+// Runs the tests of RandomnessTests.hpp over the output of any uniform random bit generator: the engines of
+// <random> and Boost.Random, or one of our own. The output is read as one stream of 64-bit words, whatever
+// the engine returns: an integral engine whose range is 2^k values contributes k bits per call, other
+// ranges the largest power of two below them (by rejection), and a floating-point engine on [min, max)
+// such as lagged_fibonacci44497 the top 32 bits of (x - min) / (max - min).
+//
+// The calling thread generates the stream, one block of words after the other, and hands the blocks to
+// worker threads through a bounded queue; each worker counts the blocks it takes into its own
+// RandomnessTests, and the counts are merged at the end. Blocks are the same whatever the number of
+// threads, so the results are too. Generation cannot be split, since the stream must be the engine's
+// actual sequence, but the counting, which costs more than most engines, is shared by the workers.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TESTBATTERY_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_TESTBATTERY_HPP
+
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "RandomnessTests.hpp"
+
+template<typename Eng>
+class TestBattery
+{
+public:
+    static constexpr std::size_t BLOCK = 1 << 17;       // Words per block, 1 MiB
+
+private:
+    Eng engine;
+    unsigned int threads;
+
+    std::uint64_t nextWord();
+
+public:
+    explicit TestBattery(const Eng& eng, unsigned int threads = std::thread::hardware_concurrency());
+    TestBattery(const TestBattery& source) = default;
+    TestBattery(TestBattery&& source) noexcept = default;
+    ~TestBattery() = default;
+
+    // Operator overloads
+    TestBattery& operator=(const TestBattery& source) = default;
+    TestBattery& operator=(TestBattery&& source) noexcept = default;
+
+    // Accessors
+    const Eng& generator() const noexcept { return engine; }
+    unsigned int workers() const noexcept { return threads; }
+
+    // Core functionality
+    void generate(std::span<std::uint64_t> words);
+    std::vector<TestResult> run(std::uint64_t bytes);
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TESTBATTERY_CPP
+#include "TestBattery.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_TESTBATTERY_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_TESTBATTERY_HPP
@@ -1,10 +1,16 @@
 //
 // Illustrate basic functionality of Boost random to see how it differs from C++11 random
+//
+// The test battery of Exercise 5 runs just as well over the Boost engines: lagged_fibonacci44497, whose
+// doubles are read 32 bits at a time, mt19937 and taus88.
 // Created by Michael Lewis on 7/18/23.
 //
 
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <list>
+#include <string>
 
 #include <chrono>
 #include <iostream>
@@ -12,6 +18,8 @@
 #include <boost/random.hpp>
 #include <boost/random/generate_canonical.hpp>
 
+#include "TestBattery.hpp"
+
 // Part A - Create a variate of the triangle distribution with lagged Fibonacci as random number engine.
 void test_triangle_distribution()
 {
@@ -46,9 +54,26 @@ void test_generate_canonical()
     std::cout << boost::random::generate_canonical<double, 64, boost::lagged_fibonacci44497>(engine) << std::endl;
 }
 
+// The Boost engines pass the battery; lagged_fibonacci44497's doubles have 48 random bits, of which the
+// battery reads the top 32
+template<typename Eng>
+void test_battery(const std::string& id, const Eng& engine, std::uint64_t megabytes)
+{
+    std::cout << id << ", " << megabytes << " MB" << std::endl;
+    const std::vector<TestResult> results = TestBattery(engine).run(megabytes << 20);
+    RandomnessTests::print(std::cout, results);
+    for (const TestResult& result : results) assert(result.pValue > 1e-4 && result.pValue < 1 - 1e-4);
+}
+
 int main()
 {
     test_triangle_distribution();
     test_generate_canonical();
+
+    test_battery("lagged_fibonacci44497", boost::lagged_fibonacci44497{1}, 128);
+    test_battery("mt19937", boost::mt19937{1}, 128);
+    test_battery("taus88", boost::taus88{1}, 128);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
     return 0;
 }
\ No newline at end of file
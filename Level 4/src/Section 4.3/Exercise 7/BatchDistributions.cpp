@@ -0,0 +1,490 @@
+//
+// Batch samplers for the uniform, normal, exponential, gamma, chi-squared, Poisson and geometric distributions
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_BATCHDISTRIBUTIONS_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_BATCHDISTRIBUTIONS_CPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "BatchDistributions.hpp"
+
+/**
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @return 64 random bits: one value, or two for a 32-bit engine
+ */
+template<typename Eng>
+std::uint64_t nextBits(Eng& eng)
+{
+    constexpr std::uint64_t range = static_cast<std::uint64_t>(Eng::max() - Eng::min());
+    if constexpr (range == std::numeric_limits<std::uint64_t>::max())
+    {
+        return static_cast<std::uint64_t>(eng() - Eng::min());
+    }
+    else
+    {
+        static_assert(range == std::numeric_limits<std::uint32_t>::max(), "The engine must return 32 or 64 random bits per value");
+        const auto high = static_cast<std::uint64_t>(eng() - Eng::min());
+        return high << 32 | static_cast<std::uint64_t>(eng() - Eng::min());
+    }
+}
+
+/**
+ * Fills a block with random bits, in bulk where the engine has a fill() of its own
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @param bits The block
+ */
+template<typename Eng>
+void fillBits(Eng& eng, std::span<std::uint64_t> bits)
+{
+    if constexpr (requires { eng.fill(bits); }) eng.fill(bits);
+    else for (std::uint64_t& value : bits) value = nextBits(eng);
+}
+
+/**
+ * Overloaded ctor: the uniform distribution on [a, b)
+ * @tparam T The floating point type of the variates
+ * @param a The lower bound
+ * @param b The upper bound
+ * @throws std::invalid_argument unless a < b, both finite
+ */
+template<typename T>
+UniformSampler<T>::UniformSampler(T a, T b) : lower{a}, upper{b}
+{
+    if (!(a < b) || !std::isfinite(b - a))
+    {
+        throw std::invalid_argument("Uniform distribution on [" + std::to_string(a) + ", " + std::to_string(b) + ")");
+    }
+}
+
+/**
+ * @tparam T The floating point type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @return One variate
+ */
+template<typename T>
+template<typename Eng>
+T UniformSampler<T>::operator()(Eng& eng) const
+{
+    T x;
+    fill(eng, std::span<T>(&x, 1));
+    return x;
+}
+
+/**
+ * @tparam T The floating point type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @param out Receives the variates
+ */
+template<typename T>
+template<typename Eng>
+void UniformSampler<T>::fill(Eng& eng, std::span<T> out) const
+{
+    std::array<std::uint64_t, BLOCK> bits;
+    const double width = static_cast<double>(upper) - static_cast<double>(lower);
+    const T largest = std::nextafter(upper, lower);     // Rounding can reach b, for float in particular
+    for (std::size_t first = 0; first < out.size(); first += BLOCK)
+    {
+        const std::size_t n = std::min(BLOCK, out.size() - first);
+        fillBits(eng, std::span<std::uint64_t>(bits.data(), n));
+        for (std::size_t j = 0; j < n; ++j) out[first + j] = std::min(static_cast<T>(lower + width * unitInterval(bits[j])), largest);
+    }
+}
+
+/**
+ * Overloaded ctor
+ * @tparam T The floating point type of the variates
+ * @param mean The mean
+ * @param stddev The standard deviation
+ * @throws std::invalid_argument unless the standard deviation is positive and finite
+ */
+template<typename T>
+NormalSampler<T>::NormalSampler(T mean, T stddev) : mu{mean}, sigma{stddev}
+{
+    if (!(stddev > 0) || !std::isfinite(stddev) || !std::isfinite(mean))
+    {
+        throw std::invalid_argument("Normal distribution with mean " + std::to_string(mean) + " and standard deviation " +
+                                    std::to_string(stddev));
+    }
+}
+
+/**
+ * @tparam T The floating point type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @return One variate
+ */
+template<typename T>
+template<typename Eng>
+T NormalSampler<T>::operator()(Eng& eng) const
+{
+    return mu + sigma * static_cast<T>(Ziggurat::normal().draw(nextBits(eng), [&eng] { return nextBits(eng); }));
+}
+
+/**
+ * Draws a block of standard normals with the Ziggurat's first attempt, finishes the rejected ones one by one,
+ * then scales the block
+ * @tparam T The floating point type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @param out Receives the variates
+ */
+template<typename T>
+template<typename Eng>
+void NormalSampler<T>::fill(Eng& eng, std::span<T> out) const
+{
+    const Ziggurat& table = Ziggurat::normal();
+    std::array<std::uint64_t, BLOCK> bits;
+    std::array<double, BLOCK> values;
+    std::array<std::uint32_t, BLOCK> rejected;
+    for (std::size_t first = 0; first < out.size(); first += BLOCK)
+    {
+        const std::size_t n = std::min(BLOCK, out.size() - first);
+        fillBits(eng, std::span<std::uint64_t>(bits.data(), n));
+        const std::size_t failures = table.fastPass(std::span<const std::uint64_t>(bits.data(), n), values, rejected.data());
+        for (std::size_t r = 0; r < failures; ++r)
+        {
+            values[rejected[r]] = table.draw(bits[rejected[r]], [&eng] { return nextBits(eng); });
+        }
+        for (std::size_t j = 0; j < n; ++j) out[first + j] = static_cast<T>(mu + sigma * values[j]);
+    }
+}
+
+/**
+ * Overloaded ctor
+ * @tparam T The floating point type of the variates
+ * @param lambda The rate, 1 / mean
+ * @throws std::invalid_argument unless the rate is positive and finite
+ */
+template<typename T>
+ExponentialSampler<T>::ExponentialSampler(T lambda) : rate{lambda}
+{
+    if (!(lambda > 0) || !std::isfinite(lambda))
+    {
+        throw std::invalid_argument("Exponential distribution with rate " + std::to_string(lambda));
+    }
+}
+
+/**
+ * @tparam T The floating point type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @return One variate
+ */
+template<typename T>
+template<typename Eng>
+T ExponentialSampler<T>::operator()(Eng& eng) const
+{
+    return static_cast<T>(Ziggurat::exponential().draw(nextBits(eng), [&eng] { return nextBits(eng); }) / rate);
+}
+
+/**
+ * As NormalSampler::fill() with the exponential Ziggurat
+ * @tparam T The floating point type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @param out Receives the variates
+ */
+template<typename T>
+template<typename Eng>
+void ExponentialSampler<T>::fill(Eng& eng, std::span<T> out) const
+{
+    const Ziggurat& table = Ziggurat::exponential();
+    const double inverseRate = 1.0 / static_cast<double>(rate);
+    std::array<std::uint64_t, BLOCK> bits;
+    std::array<double, BLOCK> values;
+    std::array<std::uint32_t, BLOCK> rejected;
+    for (std::size_t first = 0; first < out.size(); first += BLOCK)
+    {
+        const std::size_t n = std::min(BLOCK, out.size() - first);
+        fillBits(eng, std::span<std::uint64_t>(bits.data(), n));
+        const std::size_t failures = table.fastPass(std::span<const std::uint64_t>(bits.data(), n), values, rejected.data());
+        for (std::size_t r = 0; r < failures; ++r)
+        {
+            values[rejected[r]] = table.draw(bits[rejected[r]], [&eng] { return nextBits(eng); });
+        }
+        for (std::size_t j = 0; j < n; ++j) out[first + j] = static_cast<T>(values[j] * inverseRate);
+    }
+}
+
+/**
+ * Overloaded ctor: the gamma distribution with density x^(alpha - 1) exp(-x / beta), up to a constant
+ * @tparam T The floating point type of the variates
+ * @param alpha The shape
+ * @param beta The scale
+ * @throws std::invalid_argument unless both are positive and finite
+ */
+template<typename T>
+GammaSampler<T>::GammaSampler(T alpha, T beta) : shape{alpha}, scale{beta}, d{0}, c{0}
+{
+    if (!(alpha > 0) || !(beta > 0) || !std::isfinite(alpha) || !std::isfinite(beta))
+    {
+        throw std::invalid_argument("Gamma distribution with shape " + std::to_string(alpha) + " and scale " + std::to_string(beta));
+    }
+    // A shape below 1 is sampled as gamma(alpha + 1) * U^(1 / alpha)
+    d = (alpha < 1 ? alpha + 1.0 : static_cast<double>(alpha)) - 1.0 / 3.0;
+    c = 1.0 / std::sqrt(9.0 * d);
+}
+
+/**
+ * @tparam T The floating point type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @return One variate
+ */
+template<typename T>
+template<typename Eng>
+T GammaSampler<T>::operator()(Eng& eng) const
+{
+    T x;
+    fill(eng, std::span<T>(&x, 1));
+    return x;
+}
+
+/**
+ * Marsaglia and Tsang's method: d (1 + c z)^3 for a standard normal z, accepted by a cheap squeeze nearly
+ * always and by the exact test with two logarithms otherwise. The normals and uniforms come in blocks a
+ * little larger than the number of variates still missing, as about 2% to 5% are rejected.
+ * @tparam T The floating point type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @param out Receives the variates
+ */
+template<typename T>
+template<typename Eng>
+void GammaSampler<T>::fill(Eng& eng, std::span<T> out) const
+{
+    const NormalSampler<double> standard;
+    std::array<double, BLOCK> normals;
+    std::array<std::uint64_t, BLOCK> bits;
+    std::size_t produced = 0;
+    while (produced < out.size())
+    {
+        const std::size_t missing = out.size() - produced;
+        const std::size_t n = std::min(BLOCK, missing + missing / 8 + 4);
+        standard.fill(eng, std::span<double>(normals.data(), n));
+        fillBits(eng, std::span<std::uint64_t>(bits.data(), n));
+        for (std::size_t j = 0; j < n && produced < out.size(); ++j)
+        {
+            const double z = normals[j];
+            double v = 1.0 + c * z;
+            if (v <= 0) continue;
+            v = v * v * v;
+            const double u = openUnitInterval(bits[j]);
+            const double z2 = z * z;
+            if (u < 1.0 - 0.0331 * z2 * z2 || std::log(u) < 0.5 * z2 + d * (1.0 - v + std::log(v)))
+            {
+                out[produced++] = static_cast<T>(d * v * static_cast<double>(scale));
+            }
+        }
+    }
+
+    if (shape < 1)
+    {
+        const double inverseShape = 1.0 / static_cast<double>(shape);
+        for (std::size_t first = 0; first < out.size(); first += BLOCK)
+        {
+            const std::size_t n = std::min(BLOCK, out.size() - first);
+            fillBits(eng, std::span<std::uint64_t>(bits.data(), n));
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                out[first + j] = static_cast<T>(out[first + j] * std::pow(openUnitInterval(bits[j]), inverseShape));
+            }
+        }
+    }
+}
+
+/**
+ * Overloaded ctor
+ * @tparam T The floating point type of the variates
+ * @param n The degrees of freedom
+ * @throws std::invalid_argument unless they are positive and finite
+ */
+template<typename T>
+ChiSquaredSampler<T>::ChiSquaredSampler(T n) : degrees{n}, gamma{n / 2, 2}
+{
+
+}
+
+/**
+ * Overloaded ctor: builds the distribution function and its guide table for a mean up to TABLE_LIMIT, the
+ * constants of the transformed rejection above
+ * @tparam T The type of the variates
+ * @param mean The mean
+ * @throws std::invalid_argument unless the mean is positive and finite
+ */
+template<typename T>
+PoissonSampler<T>::PoissonSampler(double mean)
+    : average{mean}, cdf{}, guide{}, logMean{std::log(mean)}, a{0}, b{0}, logInverseAlpha{0}, vr{0}
+{
+    if (!(mean > 0) || !std::isfinite(mean))
+    {
+        throw std::invalid_argument("Poisson distribution with mean " + std::to_string(mean));
+    }
+
+    if (mean <= TABLE_LIMIT)
+    {
+        // Up to where the remaining probabilities no longer change the sum; the last entry is set to 1 so
+        // that every search ends
+        double probability = std::exp(-mean);
+        double sum = probability;
+        cdf.push_back(sum);
+        for (double k = 1; k <= mean || probability > 1e-17 * sum; ++k)
+        {
+            probability *= mean / k;
+            sum += probability;
+            cdf.push_back(sum);
+        }
+        cdf.back() = 1.0;
+
+        guide.resize(cdf.size());
+        std::uint32_t k = 0;
+        for (std::size_t j = 0; j < guide.size(); ++j)
+        {
+            while (cdf[k] <= static_cast<double>(j) / static_cast<double>(guide.size())) ++k;
+            guide[j] = k;
+        }
+    }
+    else
+    {
+        b = 0.931 + 2.53 * std::sqrt(mean);
+        a = -0.059 + 0.02483 * b;
+        logInverseAlpha = std::log(1.1239 + 1.1328 / (b - 3.4));
+        vr = 0.9277 - 3.6224 / (b - 2);
+    }
+}
+
+/**
+ * Hörmann's PTRS algorithm for a large mean: a transformed uniform, accepted at once inside a box that holds
+ * most of the probability, and by comparing with the exact probability otherwise
+ * @tparam T The type of the variates
+ * @tparam Next A callable returning 64 random bits
+ * @param next The source of random bits
+ * @return One variate
+ */
+template<typename T>
+template<typename Next>
+double PoissonSampler<T>::transformedRejection(Next&& next) const
+{
+    for (;;)
+    {
+        const double u = unitInterval(next()) - 0.5;
+        const double v = openUnitInterval(next());
+        const double us = 0.5 - std::abs(u);
+        const double k = std::floor((2 * a / us + b) * u + average + 0.43);
+        if (us >= 0.07 && v <= vr) return k;
+        if (k < 0 || (us < 0.013 && v > us)) continue;
+        if (std::log(v) + logInverseAlpha - std::log(a / (us * us) + b) <= -average + k * logMean - std::lgamma(k + 1)) return k;
+    }
+}
+
+/**
+ * @tparam T The type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @return One variate
+ */
+template<typename T>
+template<typename Eng>
+T PoissonSampler<T>::operator()(Eng& eng) const
+{
+    T x;
+    fill(eng, std::span<T>(&x, 1));
+    return x;
+}
+
+/**
+ * Inverts the distribution function for a block of uniforms: the guide table points at most one or two
+ * entries before the variate, whatever the mean
+ * @tparam T The type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @param out Receives the variates
+ */
+template<typename T>
+template<typename Eng>
+void PoissonSampler<T>::fill(Eng& eng, std::span<T> out) const
+{
+    if (cdf.empty())
+    {
+        for (T& x : out) x = static_cast<T>(transformedRejection([&eng] { return nextBits(eng); }));
+        return;
+    }
+
+    const double buckets = static_cast<double>(guide.size());
+    std::array<std::uint64_t, BLOCK> bits;
+    for (std::size_t first = 0; first < out.size(); first += BLOCK)
+    {
+        const std::size_t n = std::min(BLOCK, out.size() - first);
+        fillBits(eng, std::span<std::uint64_t>(bits.data(), n));
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            const double u = unitInterval(bits[j]);
+            std::size_t k = guide[std::min(guide.size() - 1, static_cast<std::size_t>(u * buckets))];
+            while (cdf[k] <= u) ++k;
+            out[first + j] = static_cast<T>(k);
+        }
+    }
+}
+
+/**
+ * Overloaded ctor: the number of failures before the first success
+ * @tparam T The type of the variates
+ * @param p The probability of success
+ * @throws std::invalid_argument unless 0 < p < 1
+ */
+template<typename T>
+GeometricSampler<T>::GeometricSampler(double p) : probability{p}, scale{-1.0 / std::log1p(-p)}
+{
+    if (!(p > 0 && p < 1))
+    {
+        throw std::invalid_argument("Geometric distribution with probability " + std::to_string(p));
+    }
+}
+
+/**
+ * @tparam T The type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @return One variate
+ */
+template<typename T>
+template<typename Eng>
+T GeometricSampler<T>::operator()(Eng& eng) const
+{
+    return static_cast<T>(std::floor(ExponentialSampler<double>()(eng) * scale));
+}
+
+/**
+ * floor(E / -log(1 - p)) for a standard exponential E, as P(E >= -k log(1 - p)) = (1 - p)^k
+ * @tparam T The type of the variates
+ * @tparam Eng An engine returning 32 or 64 random bits per value
+ * @param eng The engine
+ * @param out Receives the variates
+ */
+template<typename T>
+template<typename Eng>
+void GeometricSampler<T>::fill(Eng& eng, std::span<T> out) const
+{
+    const ExponentialSampler<double> standard;
+    std::array<double, BLOCK> values;
+    for (std::size_t first = 0; first < out.size(); first += BLOCK)
+    {
+        const std::size_t n = std::min(BLOCK, out.size() - first);
+        standard.fill(eng, std::span<double>(values.data(), n));
+        for (std::size_t j = 0; j < n; ++j) out[first + j] = static_cast<T>(std::floor(values[j] * scale));
+    }
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_BATCHDISTRIBUTIONS_CPP
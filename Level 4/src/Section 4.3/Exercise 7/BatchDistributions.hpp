@@ -0,0 +1,276 @@
+//
+// Batch samplers for the distributions of <random> that the exercises draw from: uniform, normal,
+// exponential, gamma, chi-squared, Poisson and geometric. Where a std:: distribution returns one variate per
+// call, each sampler's fill() draws a whole span at once: it takes a block of random bits from the engine
+// (Xoshiro256x4 produces them four at a time), turns the block into variates in tight loops over arrays, and
+// leaves the rare cases that need more random numbers to a scalar loop.
+//
+// - uniform: 52 bits of each value in the mantissa of a double
+// - normal and exponential: the Ziggurat method, its first attempt over the whole block (see Ziggurat.hpp)
+// - gamma: Marsaglia and Tsang's method from a block of normals, chi-squared being gamma(n / 2, 2)
+// - Poisson: inversion of a table of the distribution function with a guide table (Chen and Asau) up to a
+//   mean of 256, Hörmann's transformed rejection (PTRS) above
+// - geometric: the floor of a scaled exponential variate, instead of a logarithm per variate
+//
+// The samplers follow the parameters of their std:: counterparts and work with any engine that returns 32 or
+// 64 random bits per value, std::mt19937_64 included. They draw different variates than the std:: versions
+// from the same engine, but from the same distributions.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_BATCHDISTRIBUTIONS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_BATCHDISTRIBUTIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "Xoshiro256x4.hpp"
+#include "Ziggurat.hpp"
+
+template<typename Eng>
+std::uint64_t nextBits(Eng& eng);
+
+template<typename Eng>
+void fillBits(Eng& eng, std::span<std::uint64_t> bits);
+
+template<typename T = double>
+class UniformSampler
+{
+    static_assert(std::is_floating_point_v<T>, "UniformSampler draws floating point variates");
+
+private:
+    static constexpr std::size_t BLOCK = 256;
+
+    T lower;
+    T upper;
+
+public:
+    using result_type = T;
+
+    explicit UniformSampler(T a = 0, T b = 1);
+    UniformSampler(const UniformSampler& source) = default;
+    ~UniformSampler() = default;
+
+    // Operator overloads
+    UniformSampler& operator=(const UniformSampler& source) = default;
+    template<typename Eng>
+    T operator()(Eng& eng) const;
+
+    // Accessors
+    T a() const noexcept { return lower; }
+    T b() const noexcept { return upper; }
+
+    // Core functionality
+    template<typename Eng>
+    void fill(Eng& eng, std::span<T> out) const;
+};
+
+template<typename T = double>
+class NormalSampler
+{
+    static_assert(std::is_floating_point_v<T>, "NormalSampler draws floating point variates");
+
+private:
+    static constexpr std::size_t BLOCK = 256;
+
+    T mu;
+    T sigma;
+
+public:
+    using result_type = T;
+
+    explicit NormalSampler(T mean = 0, T stddev = 1);
+    NormalSampler(const NormalSampler& source) = default;
+    ~NormalSampler() = default;
+
+    // Operator overloads
+    NormalSampler& operator=(const NormalSampler& source) = default;
+    template<typename Eng>
+    T operator()(Eng& eng) const;
+
+    // Accessors
+    T mean() const noexcept { return mu; }
+    T stddev() const noexcept { return sigma; }
+
+    // Core functionality
+    template<typename Eng>
+    void fill(Eng& eng, std::span<T> out) const;
+};
+
+template<typename T = double>
+class ExponentialSampler
+{
+    static_assert(std::is_floating_point_v<T>, "ExponentialSampler draws floating point variates");
+
+private:
+    static constexpr std::size_t BLOCK = 256;
+
+    T rate;
+
+public:
+    using result_type = T;
+
+    explicit ExponentialSampler(T lambda = 1);
+    ExponentialSampler(const ExponentialSampler& source) = default;
+    ~ExponentialSampler() = default;
+
+    // Operator overloads
+    ExponentialSampler& operator=(const ExponentialSampler& source) = default;
+    template<typename Eng>
+    T operator()(Eng& eng) const;
+
+    // Accessors
+    T lambda() const noexcept { return rate; }
+
+    // Core functionality
+    template<typename Eng>
+    void fill(Eng& eng, std::span<T> out) const;
+};
+
+template<typename T = double>
+class GammaSampler
+{
+    static_assert(std::is_floating_point_v<T>, "GammaSampler draws floating point variates");
+
+private:
+    static constexpr std::size_t BLOCK = 256;
+
+    T shape;
+    T scale;
+    double d;           // Marsaglia and Tsang's constants, for a shape of at least 1
+    double c;
+
+public:
+    using result_type = T;
+
+    explicit GammaSampler(T alpha = 1, T beta = 1);
+    GammaSampler(const GammaSampler& source) = default;
+    ~GammaSampler() = default;
+
+    // Operator overloads
+    GammaSampler& operator=(const GammaSampler& source) = default;
+    template<typename Eng>
+    T operator()(Eng& eng) const;
+
+    // Accessors
+    T alpha() const noexcept { return shape; }
+    T beta() const noexcept { return scale; }
+
+    // Core functionality
+    template<typename Eng>
+    void fill(Eng& eng, std::span<T> out) const;
+};
+
+template<typename T = double>
+class ChiSquaredSampler
+{
+    static_assert(std::is_floating_point_v<T>, "ChiSquaredSampler draws floating point variates");
+
+private:
+    T degrees;
+    GammaSampler<T> gamma;
+
+public:
+    using result_type = T;
+
+    explicit ChiSquaredSampler(T n = 1);
+    ChiSquaredSampler(const ChiSquaredSampler& source) = default;
+    ~ChiSquaredSampler() = default;
+
+    // Operator overloads
+    ChiSquaredSampler& operator=(const ChiSquaredSampler& source) = default;
+    template<typename Eng>
+    T operator()(Eng& eng) const { return gamma(eng); }
+
+    // Accessors
+    T n() const noexcept { return degrees; }
+
+    // Core functionality
+    template<typename Eng>
+    void fill(Eng& eng, std::span<T> out) const { gamma.fill(eng, out); }
+};
+
+template<typename T = int>
+class PoissonSampler
+{
+    static_assert(std::is_arithmetic_v<T>, "PoissonSampler draws integers, stored in any arithmetic type");
+
+public:
+    static constexpr double TABLE_LIMIT = 256;      // Largest mean sampled from a table
+
+private:
+    static constexpr std::size_t BLOCK = 256;
+
+    double average;
+    std::vector<double> cdf;                // P(X <= k), the last entry 1
+    std::vector<std::uint32_t> guide;       // guide[j]: the first k with cdf[k] > j / guide.size()
+    double logMean;                         // PTRS constants, for means above TABLE_LIMIT
+    double a;
+    double b;
+    double logInverseAlpha;
+    double vr;
+
+    template<typename Next>
+    double transformedRejection(Next&& next) const;
+
+public:
+    using result_type = T;
+
+    explicit PoissonSampler(double mean = 1);
+    PoissonSampler(const PoissonSampler& source) = default;
+    ~PoissonSampler() = default;
+
+    // Operator overloads
+    PoissonSampler& operator=(const PoissonSampler& source) = default;
+    template<typename Eng>
+    T operator()(Eng& eng) const;
+
+    // Accessors
+    double mean() const noexcept { return average; }
+
+    // Core functionality
+    template<typename Eng>
+    void fill(Eng& eng, std::span<T> out) const;
+};
+
+template<typename T = int>
+class GeometricSampler
+{
+    static_assert(std::is_arithmetic_v<T>, "GeometricSampler draws integers, stored in any arithmetic type");
+
+private:
+    static constexpr std::size_t BLOCK = 256;
+
+    double probability;
+    double scale;           // -1 / log(1 - p)
+
+public:
+    using result_type = T;
+
+    explicit GeometricSampler(double p = 0.5);
+    GeometricSampler(const GeometricSampler& source) = default;
+    ~GeometricSampler() = default;
+
+    // Operator overloads
+    GeometricSampler& operator=(const GeometricSampler& source) = default;
+    template<typename Eng>
+    T operator()(Eng& eng) const;
+
+    // Accessors
+    double p() const noexcept { return probability; }
+
+    // Core functionality
+    template<typename Eng>
+    void fill(Eng& eng, std::span<T> out) const;
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_BATCHDISTRIBUTIONS_CPP
+#include "BatchDistributions.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_BATCHDISTRIBUTIONS_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_BATCHDISTRIBUTIONS_HPP
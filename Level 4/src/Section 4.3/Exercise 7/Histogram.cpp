@@ -0,0 +1,158 @@
+//
+// A flat-array histogram over a fixed binning, with merging, quantiles and printing
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_HISTOGRAM_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_HISTOGRAM_CPP
+
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+
+#include "Histogram.hpp"
+
+/**
+ * Overloaded ctor: an empty histogram
+ * @tparam Bins LinearBins or LogBins
+ * @param bins The binning
+ */
+template<typename Bins>
+Histogram<Bins>::Histogram(const Bins& bins) : bins{bins}, counts((bins.size() + 2) * LANES, 0)
+{
+
+}
+
+/**
+ * Adds the counts of another histogram, e.g. one filled by another thread
+ * @tparam Bins LinearBins or LogBins
+ * @param other A histogram with the same binning
+ * @return This histogram
+ * @throws std::invalid_argument if the binnings differ
+ */
+template<typename Bins>
+Histogram<Bins>& Histogram<Bins>::operator+=(const Histogram& other)
+{
+    if (!(bins == other.bins)) throw std::invalid_argument("Cannot merge histograms with different bins");
+    for (std::size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+    return *this;
+}
+
+/**
+ * @tparam Bins LinearBins or LogBins
+ * @param slot 0 for the underflow, bin + 1 for a bin, size() + 1 for the overflow
+ * @return The number of samples in the slot
+ */
+template<typename Bins>
+std::uint64_t Histogram<Bins>::slotCount(std::size_t slot) const noexcept
+{
+    std::uint64_t sum = 0;
+    for (std::size_t lane = 0; lane < LANES; ++lane) sum += counts[slot * LANES + lane];
+    return sum;
+}
+
+/**
+ * @tparam Bins LinearBins or LogBins
+ * @param bin The bin
+ * @return The number of samples in the bin
+ * @throws std::out_of_range if the bin does not exist
+ */
+template<typename Bins>
+std::uint64_t Histogram<Bins>::count(std::size_t bin) const
+{
+    if (bin >= bins.size())
+    {
+        throw std::out_of_range("Bin " + std::to_string(bin) + " of a histogram with " + std::to_string(bins.size()) + " bins");
+    }
+    return slotCount(bin + 1);
+}
+
+/**
+ * @tparam Bins LinearBins or LogBins
+ * @return The number of samples, including those outside the bins
+ */
+template<typename Bins>
+std::uint64_t Histogram<Bins>::total() const noexcept
+{
+    std::uint64_t sum = 0;
+    for (std::uint64_t count : counts) sum += count;
+    return sum;
+}
+
+/**
+ * Counts a block of samples, spreading consecutive ones over the lanes
+ * @tparam Bins LinearBins or LogBins
+ * @param xs The samples
+ */
+template<typename Bins>
+void Histogram<Bins>::add(std::span<const double> xs) noexcept
+{
+    std::uint64_t* lanes = counts.data();
+    std::size_t i = 0;
+    for (; i + LANES <= xs.size(); i += LANES)
+    {
+        ++lanes[bins.slot(xs[i]) * LANES];
+        ++lanes[bins.slot(xs[i + 1]) * LANES + 1];
+        ++lanes[bins.slot(xs[i + 2]) * LANES + 2];
+        ++lanes[bins.slot(xs[i + 3]) * LANES + 3];
+    }
+    for (; i < xs.size(); ++i) ++lanes[bins.slot(xs[i]) * LANES];
+}
+
+/**
+ * Estimates a quantile by interpolating linearly within the bin that holds it. The error is at most the
+ * width of that bin; quantiles that fall below or above the bins are reported as the first or last edge.
+ * @tparam Bins LinearBins or LogBins
+ * @param q The probability, in [0, 1]
+ * @return The estimate of the q-quantile
+ * @throws std::domain_error if q is outside [0, 1] or the histogram is empty
+ */
+template<typename Bins>
+double Histogram<Bins>::quantile(double q) const
+{
+    const std::uint64_t samples = total();
+    if (!(q >= 0 && q <= 1) || samples == 0)
+    {
+        throw std::domain_error("Cannot take the " + std::to_string(q) + " quantile of " + std::to_string(samples) + " samples");
+    }
+
+    const double rank = q * static_cast<double>(samples);
+    double below = static_cast<double>(underflow());
+    if (rank <= below) return bins.lowerEdge(0);
+    for (std::size_t bin = 0; bin < bins.size(); ++bin)
+    {
+        const double inBin = static_cast<double>(slotCount(bin + 1));
+        if (rank <= below + inBin)
+        {
+            const double fraction = inBin == 0 ? 0 : (rank - below) / inBin;
+            return bins.lowerEdge(bin) + fraction * (bins.upperEdge(bin) - bins.lowerEdge(bin));
+        }
+        below += inBin;
+    }
+    return bins.lowerEdge(bins.size());
+}
+
+/**
+ * Prints one line per bin, its lower edge and a bar of stars; the fullest bin gets width stars
+ * @tparam Bins LinearBins or LogBins
+ * @param ostream The stream
+ * @param width The length of the longest bar
+ */
+template<typename Bins>
+void Histogram<Bins>::print(std::ostream& ostream, std::size_t width) const
+{
+    std::uint64_t largest = 1;
+    for (std::size_t bin = 0; bin < bins.size(); ++bin) largest = std::max(largest, slotCount(bin + 1));
+
+    if (underflow() > 0) ostream << "below " << bins.lowerEdge(0) << " : " << underflow() << '\n';
+    for (std::size_t bin = 0; bin < bins.size(); ++bin)
+    {
+        ostream << std::fixed << std::setprecision(1) << std::setw(4) << bins.lowerEdge(bin) << " : "
+                << std::string(slotCount(bin + 1) * width / largest, '*') << '\n';
+    }
+    if (overflow() > 0) ostream << "from " << bins.lowerEdge(bins.size()) << " : " << overflow() << '\n';
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_HISTOGRAM_CPP
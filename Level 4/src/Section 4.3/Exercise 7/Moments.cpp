@@ -0,0 +1,134 @@
+//
+// Streaming moments with Welford's update, block updates and Pébay's merge
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <cmath>
+#include <limits>
+
+#include "Moments.hpp"
+
+/**
+ * Default ctor: no samples
+ */
+Moments::Moments() : n{0}, average{0}, m2{0}, m3{0}, m4{0}
+{
+
+}
+
+/**
+ * Merges the samples of another accumulator into this one (Pébay, 2008)
+ * @param other The other accumulator
+ * @return This accumulator
+ */
+Moments& Moments::operator+=(const Moments& other)
+{
+    if (other.n == 0) return *this;
+    if (n == 0) return *this = other;
+
+    const double na = static_cast<double>(n);
+    const double nb = static_cast<double>(other.n);
+    const double total = na + nb;
+    const double delta = other.average - average;
+    const double delta2 = delta * delta;
+
+    const double merged4 = m4 + other.m4 + delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) / (total * total * total) +
+                           6 * delta2 * (na * na * other.m2 + nb * nb * m2) / (total * total) +
+                           4 * delta * (na * other.m3 - nb * m3) / total;
+    const double merged3 = m3 + other.m3 + delta2 * delta * na * nb * (na - nb) / (total * total) +
+                           3 * delta * (na * other.m2 - nb * m2) / total;
+    m2 += other.m2 + delta2 * na * nb / total;
+    m3 = merged3;
+    m4 = merged4;
+    average += delta * nb / total;
+    n += other.n;
+    return *this;
+}
+
+/**
+ * @return The mean of the samples, NaN if there are none
+ */
+double Moments::mean() const noexcept
+{
+    return n == 0 ? std::numeric_limits<double>::quiet_NaN() : average;
+}
+
+/**
+ * @return The sample variance (divided by n - 1), NaN if there are fewer than two samples
+ */
+double Moments::variance() const noexcept
+{
+    return n < 2 ? std::numeric_limits<double>::quiet_NaN() : m2 / static_cast<double>(n - 1);
+}
+
+/**
+ * @return The sample standard deviation, NaN if there are fewer than two samples
+ */
+double Moments::standardDeviation() const noexcept
+{
+    return std::sqrt(variance());
+}
+
+/**
+ * @return The skewness m3 / m2^(3/2) of the samples, NaN if they do not vary
+ */
+double Moments::skewness() const noexcept
+{
+    if (n == 0 || m2 == 0) return std::numeric_limits<double>::quiet_NaN();
+    return std::sqrt(static_cast<double>(n)) * m3 / std::pow(m2, 1.5);
+}
+
+/**
+ * @return The excess kurtosis m4 / m2^2 - 3 of the samples (0 for a normal distribution), NaN if they do not vary
+ */
+double Moments::kurtosis() const noexcept
+{
+    if (n == 0 || m2 == 0) return std::numeric_limits<double>::quiet_NaN();
+    return static_cast<double>(n) * m4 / (m2 * m2) - 3;
+}
+
+/**
+ * Adds one sample with Welford's update
+ * @param x The sample
+ */
+void Moments::add(double x) noexcept
+{
+    const double previous = static_cast<double>(n);
+    const double count = previous + 1;
+    const double delta = x - average;
+    const double deltaN = delta / count;
+    const double deltaN2 = deltaN * deltaN;
+    const double term = delta * deltaN * previous;
+
+    average += deltaN;
+    m4 += term * deltaN2 * (count * count - 3 * count + 3) + 6 * deltaN2 * m2 - 4 * deltaN * m3;
+    m3 += term * deltaN * (count - 2) - 3 * deltaN * m2;
+    m2 += term;
+    ++n;
+}
+
+/**
+ * Adds a block of samples: their moments about their own mean, then a merge
+ * @param xs The samples
+ */
+void Moments::add(std::span<const double> xs) noexcept
+{
+    if (xs.empty()) return;
+
+    double sum = 0;
+    for (double x : xs) sum += x;
+
+    Moments block;
+    block.n = xs.size();
+    block.average = sum / static_cast<double>(xs.size());
+    for (double x : xs)
+    {
+        const double d = x - block.average;
+        const double d2 = d * d;
+        block.m2 += d2;
+        block.m3 += d2 * d;
+        block.m4 += d2 * d2;
+    }
+    *this += block;
+}
@@ -0,0 +1,119 @@
+//
+// Histogram and moments of a stream of variates, and parallel sampling of a distribution
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SAMPLESTATISTICS_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SAMPLESTATISTICS_CPP
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "SampleStatistics.hpp"
+
+/**
+ * Overloaded ctor: no samples yet
+ * @tparam Bins LinearBins or LogBins
+ * @param bins The binning of the histogram
+ */
+template<typename Bins>
+SampleStatistics<Bins>::SampleStatistics(const Bins& bins) : frequencies{bins}, summary{}
+{
+
+}
+
+/**
+ * Adds the samples of another accumulator
+ * @tparam Bins LinearBins or LogBins
+ * @param other An accumulator with the same binning
+ * @return This accumulator
+ * @throws std::invalid_argument if the binnings differ
+ */
+template<typename Bins>
+SampleStatistics<Bins>& SampleStatistics<Bins>::operator+=(const SampleStatistics& other)
+{
+    frequencies += other.frequencies;
+    summary += other.summary;
+    return *this;
+}
+
+/**
+ * @tparam Bins LinearBins or LogBins
+ * @param x A sample
+ */
+template<typename Bins>
+void SampleStatistics<Bins>::add(double x) noexcept
+{
+    frequencies.add(x);
+    summary.add(x);
+}
+
+/**
+ * @tparam Bins LinearBins or LogBins
+ * @param xs A block of samples
+ */
+template<typename Bins>
+void SampleStatistics<Bins>::add(std::span<const double> xs) noexcept
+{
+    frequencies.add(xs);
+    summary.add(xs);
+}
+
+/**
+ * Draws samples variates of a distribution on several threads and accumulates them. The engines of the
+ * threads are seeded from eng, so the result depends only on eng's state and the number of threads.
+ * @tparam Dist Any distribution of <random>, or a batch sampler of double variates, which fills the buffer in one call
+ * @tparam Eng Any engine of <random>
+ * @param d The distribution
+ * @param eng The engine that seeds the threads' engines
+ * @param samples The number of variates
+ * @param bins The binning of the histogram
+ * @param threads The number of threads; 0 (hardware_concurrency() unknown) means one
+ * @return The accumulated statistics
+ */
+template<typename Bins>
+template<typename Dist, typename Eng>
+SampleStatistics<Bins> SampleStatistics<Bins>::sample(Dist d, Eng& eng, std::uint64_t samples, const Bins& bins,
+                                                      unsigned int threads)
+{
+    threads = std::max(1u, threads);
+    std::vector<SampleStatistics> partials(threads, SampleStatistics(bins));
+    std::vector<Eng> engines;
+    engines.reserve(threads);
+    for (unsigned int t = 0; t < threads; ++t) engines.emplace_back(eng());
+
+    auto work = [&](unsigned int t)
+    {
+        Dist local = d;
+        Eng& engine = engines[t];
+        SampleStatistics& partial = partials[t];
+        std::uint64_t remaining = samples / threads + (t < samples % threads ? 1 : 0);
+        std::array<double, BUFFER> buffer;
+        while (remaining > 0)
+        {
+            const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(remaining, BUFFER));
+            if constexpr (requires { local.fill(engine, std::span<double>(buffer.data(), n)); })
+            {
+                local.fill(engine, std::span<double>(buffer.data(), n));
+            }
+            else
+            {
+                for (std::size_t i = 0; i < n; ++i) buffer[i] = static_cast<double>(local(engine));
+            }
+            partial.add(std::span<const double>(buffer.data(), n));
+            remaining -= n;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < threads; ++t) workers.emplace_back(work, t);
+    work(0);
+    for (std::thread& worker : workers) worker.join();
+
+    for (unsigned int t = 1; t < threads; ++t) partials[0] += partials[t];
+    return partials[0];
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SAMPLESTATISTICS_CPP
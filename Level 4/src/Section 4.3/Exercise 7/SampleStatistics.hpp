@@ -0,0 +1,60 @@
+//
+// The statistics of a stream of random variates: a Histogram over a fixed binning and the streaming Moments,
+// filled together and merged together. sample() draws any number of variates of a distribution on several
+// threads: each thread gets its own engine, seeded from the engine passed in, fills a small buffer of
+// variates and counts it into its own accumulator, and the accumulators are merged when the threads finish.
+// A batch sampler of BatchDistributions.hpp fills the buffer with one call instead of one call per variate.
+// No thread writes to shared memory while sampling, so the counting keeps up with the engines.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SAMPLESTATISTICS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SAMPLESTATISTICS_HPP
+
+#include <cstdint>
+#include <span>
+#include <thread>
+
+#include "Histogram.hpp"
+#include "Moments.hpp"
+
+template<typename Bins>
+class SampleStatistics
+{
+private:
+    static constexpr std::size_t BUFFER = 1024;       // Variates drawn before they are counted
+
+    Histogram<Bins> frequencies;
+    Moments summary;
+
+public:
+    explicit SampleStatistics(const Bins& bins);
+    SampleStatistics(const SampleStatistics& source) = default;
+    SampleStatistics(SampleStatistics&& source) noexcept = default;
+    ~SampleStatistics() = default;
+
+    // Operator overloads
+    SampleStatistics& operator=(const SampleStatistics& source) = default;
+    SampleStatistics& operator=(SampleStatistics&& source) noexcept = default;
+    SampleStatistics& operator+=(const SampleStatistics& other);
+
+    // Accessors
+    const Histogram<Bins>& histogram() const noexcept { return frequencies; }
+    const Moments& moments() const noexcept { return summary; }
+
+    // Core functionality
+    void add(double x) noexcept;
+    void add(std::span<const double> xs) noexcept;
+
+    template<typename Dist, typename Eng>
+    static SampleStatistics sample(Dist d, Eng& eng, std::uint64_t samples, const Bins& bins,
+                                   unsigned int threads = std::thread::hardware_concurrency());
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SAMPLESTATISTICS_CPP
+#include "SampleStatistics.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_SAMPLESTATISTICS_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SAMPLESTATISTICS_HPP
@@ -0,0 +1,201 @@
+//
+// Four interleaved xoshiro256++ generators with an AVX2 step
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include "Xoshiro256x4.hpp"
+
+/**
+ * @return The switch between the AVX2 and the portable step, on by default where AVX2 is supported
+ */
+std::atomic<bool>& Xoshiro256x4::simdSwitch()
+{
+    static std::atomic<bool> enabled{simdSupported()};
+    return enabled;
+}
+
+/**
+ * @return True if the CPU supports AVX2
+ */
+bool Xoshiro256x4::simdSupported()
+{
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_X86
+    static const bool supported = []
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @return True if fill() uses the AVX2 step
+ */
+bool Xoshiro256x4::simdEnabled()
+{
+    return simdSwitch().load(std::memory_order_relaxed);
+}
+
+/**
+ * Switches the AVX2 step on or off, e.g. to compare it with the portable loop. It cannot be switched on
+ * where it is not supported.
+ * @param enable True to use AVX2 where supported
+ */
+void Xoshiro256x4::enableSimd(bool enable)
+{
+    simdSwitch().store(enable && simdSupported(), std::memory_order_relaxed);
+}
+
+/**
+ * One step of one xoshiro256++ generator
+ * @param lane The generator's state
+ * @return The next value
+ */
+std::uint64_t Xoshiro256x4::step(std::array<std::uint64_t, 4>& lane) noexcept
+{
+    const std::uint64_t result = rotl(lane[0] + lane[3], 23) + lane[0];
+    const std::uint64_t t = lane[1] << 17;
+    lane[2] ^= lane[0];
+    lane[3] ^= lane[1];
+    lane[1] ^= lane[2];
+    lane[0] ^= lane[3];
+    lane[2] ^= t;
+    lane[3] = rotl(lane[3], 45);
+    return result;
+}
+
+/**
+ * Advances one generator by 2^128 steps, with the jump polynomial published with xoshiro256
+ * @param lane The generator's state
+ */
+void Xoshiro256x4::jump(std::array<std::uint64_t, 4>& lane) noexcept
+{
+    constexpr std::uint64_t JUMP[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+    std::array<std::uint64_t, 4> jumped{};
+    for (std::uint64_t word : JUMP)
+    {
+        for (int bit = 0; bit < 64; ++bit)
+        {
+            if (word & std::uint64_t{1} << bit)
+            {
+                for (std::size_t i = 0; i < 4; ++i) jumped[i] ^= lane[i];
+            }
+            step(lane);
+        }
+    }
+    lane = jumped;
+}
+
+/**
+ * Overloaded ctor
+ * @param seed Any value; equal seeds give equal streams
+ */
+Xoshiro256x4::Xoshiro256x4(std::uint64_t seed) : state{}, buffer{}, position{BUFFER}
+{
+    this->seed(seed);
+}
+
+/**
+ * Restarts the streams: the first lane's state is expanded from seed with SplitMix64, as the authors of
+ * xoshiro recommend, and every other lane is the one before it jumped 2^128 steps ahead
+ * @param seed Any value
+ */
+void Xoshiro256x4::seed(std::uint64_t seed) noexcept
+{
+    std::array<std::uint64_t, 4> lane{};
+    for (std::uint64_t& word : lane)
+    {
+        std::uint64_t z = (seed += 0x9E3779B97F4A7C15);
+        z = (z ^ z >> 30) * 0xBF58476D1CE4E5B9;
+        z = (z ^ z >> 27) * 0x94D049BB133111EB;
+        word = z ^ z >> 31;
+    }
+    for (std::size_t l = 0; l < LANES; ++l)
+    {
+        if (l > 0) jump(lane);
+        for (std::size_t w = 0; w < 4; ++w) state[w * LANES + l] = lane[w];
+    }
+    position = BUFFER;
+}
+
+/**
+ * Fills out with random bits: whole steps of the four lanes, and the rest from operator()
+ * @param out The values to fill
+ */
+void Xoshiro256x4::fill(std::span<std::uint64_t> out) noexcept
+{
+    const std::size_t steps = out.size() / LANES;
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_X86
+    if (simdEnabled()) generateAvx2(out.data(), steps);
+    else generate(out.data(), steps);
+#else
+    generate(out.data(), steps);
+#endif
+    for (std::size_t i = steps * LANES; i < out.size(); ++i) out[i] = (*this)();
+}
+
+/**
+ * The portable step of the four lanes
+ * @param out Receives LANES * steps values, lane by lane within a step
+ * @param steps The number of steps
+ */
+void Xoshiro256x4::generate(std::uint64_t* out, std::size_t steps) noexcept
+{
+    std::uint64_t* s0 = state.data();
+    std::uint64_t* s1 = s0 + LANES;
+    std::uint64_t* s2 = s1 + LANES;
+    std::uint64_t* s3 = s2 + LANES;
+    for (std::size_t n = 0; n < steps; ++n, out += LANES)
+    {
+        for (std::size_t l = 0; l < LANES; ++l)
+        {
+            out[l] = rotl(s0[l] + s3[l], 23) + s0[l];
+            const std::uint64_t t = s1[l] << 17;
+            s2[l] ^= s0[l];
+            s3[l] ^= s1[l];
+            s1[l] ^= s2[l];
+            s0[l] ^= s3[l];
+            s2[l] ^= t;
+            s3[l] = rotl(s3[l], 45);
+        }
+    }
+}
+
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_X86
+/**
+ * The AVX2 step: each state word of the four lanes is one register
+ * @param out Receives LANES * steps values, lane by lane within a step
+ * @param steps The number of steps
+ */
+__attribute__((target("avx2")))
+void Xoshiro256x4::generateAvx2(std::uint64_t* out, std::size_t steps) noexcept
+{
+    auto* words = reinterpret_cast<__m256i*>(state.data());
+    __m256i s0 = _mm256_loadu_si256(words);
+    __m256i s1 = _mm256_loadu_si256(words + 1);
+    __m256i s2 = _mm256_loadu_si256(words + 2);
+    __m256i s3 = _mm256_loadu_si256(words + 3);
+    for (std::size_t n = 0; n < steps; ++n, out += LANES)
+    {
+        const __m256i sum = _mm256_add_epi64(s0, s3);
+        const __m256i result = _mm256_add_epi64(_mm256_or_si256(_mm256_slli_epi64(sum, 23), _mm256_srli_epi64(sum, 41)), s0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), result);
+
+        const __m256i t = _mm256_slli_epi64(s1, 17);
+        s2 = _mm256_xor_si256(s2, s0);
+        s3 = _mm256_xor_si256(s3, s1);
+        s1 = _mm256_xor_si256(s1, s2);
+        s0 = _mm256_xor_si256(s0, s3);
+        s2 = _mm256_xor_si256(s2, t);
+        s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+    }
+    _mm256_storeu_si256(words, s0);
+    _mm256_storeu_si256(words + 1, s1);
+    _mm256_storeu_si256(words + 2, s2);
+    _mm256_storeu_si256(words + 3, s3);
+}
+#endif
@@ -0,0 +1,164 @@
+//
+// Ziggurat tables for the normal and exponential distributions, and the first attempt for a block of bits
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include "Ziggurat.hpp"
+
+/**
+ * Builds the layers from the top edge of the base layer down: every layer has area v
+ * @param symmetric True for the normal density exp(-t^2 / 2), false for the exponential density exp(-t)
+ * @param layers The number of layers, a power of two
+ * @param r The start of the tail, where the base layer's rectangle ends
+ * @param v The area of every layer, the base layer's being its rectangle and the tail
+ */
+Ziggurat::Ziggurat(bool symmetric, std::size_t layers, double r, double v)
+    : symmetric{symmetric}, r{r}, mask{layers - 1}, x(layers + 1), ratio(layers), heights(layers + 1)
+{
+    x[0] = v / density(r);
+    x[1] = r;
+    x[layers] = 0;
+    for (std::size_t i = 2; i < layers; ++i)
+    {
+        const double height = v / x[i - 1] + density(x[i - 1]);
+        x[i] = symmetric ? std::sqrt(-2.0 * std::log(height)) : -std::log(height);
+    }
+    for (std::size_t i = 0; i < layers; ++i) ratio[i] = x[i + 1] / x[i];
+    for (std::size_t i = 0; i <= layers; ++i) heights[i] = density(x[i]);
+}
+
+/**
+ * @return The tables of the standard normal distribution
+ */
+const Ziggurat& Ziggurat::normal()
+{
+    static const Ziggurat table(true, 128, 3.442619855899, 9.91256303526217e-3);
+    return table;
+}
+
+/**
+ * @return The tables of the standard exponential distribution
+ */
+const Ziggurat& Ziggurat::exponential()
+{
+    static const Ziggurat table(false, 256, 7.69711747013104972, 3.9496598225815571993e-3);
+    return table;
+}
+
+/**
+ * @return The switch between the AVX2 and the portable first attempt, on by default where AVX2 is supported
+ */
+std::atomic<bool>& Ziggurat::simdSwitch()
+{
+    static std::atomic<bool> enabled{simdSupported()};
+    return enabled;
+}
+
+/**
+ * @return True if the CPU supports AVX2
+ */
+bool Ziggurat::simdSupported()
+{
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_X86
+    static const bool supported = []
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @return True if fastPass() uses AVX2
+ */
+bool Ziggurat::simdEnabled()
+{
+    return simdSwitch().load(std::memory_order_relaxed);
+}
+
+/**
+ * Switches the AVX2 first attempt on or off, e.g. to compare it with the portable loop. It cannot be
+ * switched on where it is not supported.
+ * @param enable True to use AVX2 where supported
+ */
+void Ziggurat::enableSimd(bool enable)
+{
+    simdSwitch().store(enable && simdSupported(), std::memory_order_relaxed);
+}
+
+/**
+ * The first attempt of the Ziggurat method for a block of random bits
+ * @param bits Random bits, one value per variate
+ * @param out Receives the variates; those at rejected positions are to be replaced with draw()
+ * @param rejected Receives the positions not decided, room for bits.size() of them
+ * @return The number of positions rejected
+ */
+std::size_t Ziggurat::fastPass(std::span<const std::uint64_t> bits, std::span<double> out, std::uint32_t* rejected) const noexcept
+{
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_X86
+    if (simdEnabled()) return fastPassAvx2(bits.data(), out.data(), rejected, bits.size());
+#endif
+    std::size_t count = 0;
+    for (std::size_t j = 0; j < bits.size(); ++j)
+    {
+        const std::size_t i = bits[j] & mask;
+        const double u = symmetric ? 2.0 * unitInterval(bits[j]) - 1.0 : unitInterval(bits[j]);
+        out[j] = u * x[i];
+        if (!(std::abs(u) < ratio[i])) rejected[count++] = static_cast<std::uint32_t>(j);
+    }
+    return count;
+}
+
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_X86
+/**
+ * fastPass() four variates at a time: the layer's edge and ratio are gathered, the point is built in the
+ * mantissa, and the lanes that fail the compare become a bit mask
+ * @param bits Random bits, one value per variate
+ * @param out Receives the variates
+ * @param rejected Receives the positions not decided
+ * @param n The number of variates
+ * @return The number of positions rejected
+ */
+__attribute__((target("avx2")))
+std::size_t Ziggurat::fastPassAvx2(const std::uint64_t* bits, double* out, std::uint32_t* rejected, std::size_t n) const noexcept
+{
+    const __m256i layerMask = _mm256_set1_epi64x(static_cast<long long>(mask));
+    const __m256i one = _mm256_set1_epi64x(0x3FF0000000000000);
+    const __m256d scale = _mm256_set1_pd(symmetric ? 2.0 : 1.0);
+    const __m256d shift = _mm256_set1_pd(symmetric ? 3.0 : 1.0);
+    const __m256d absolute = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFF));
+
+    std::size_t count = 0;
+    std::size_t j = 0;
+    for (; j + 4 <= n; j += 4)
+    {
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + j));
+        const __m256i layer = _mm256_and_si256(b, layerMask);
+        // [1, 2) from the top 52 bits, then [0, 1) or [-1, 1)
+        const __m256d m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(b, 12), one));
+        const __m256d u = _mm256_sub_pd(_mm256_mul_pd(scale, m), shift);
+        const __m256d edge = _mm256_i64gather_pd(x.data(), layer, 8);
+        const __m256d limit = _mm256_i64gather_pd(ratio.data(), layer, 8);
+        _mm256_storeu_pd(out + j, _mm256_mul_pd(u, edge));
+
+        int failed = ~_mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(u, absolute), limit, _CMP_LT_OQ)) & 0xF;
+        while (failed)
+        {
+            rejected[count++] = static_cast<std::uint32_t>(j + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(failed))));
+            failed &= failed - 1;
+        }
+    }
+    for (; j < n; ++j)
+    {
+        const std::size_t i = bits[j] & mask;
+        const double u = symmetric ? 2.0 * unitInterval(bits[j]) - 1.0 : unitInterval(bits[j]);
+        out[j] = u * x[i];
+        if (!(std::abs(u) < ratio[i])) rejected[count++] = static_cast<std::uint32_t>(j);
+    }
+    return count;
+}
+#endif
@@ -0,0 +1,100 @@
+//
+// The tables of the Ziggurat method (Marsaglia and Tsang; in the form of Doornik's ZIGNOR) for the standard
+// normal distribution (128 layers) and the standard exponential distribution (256 layers). The area under
+// the density is covered by layers of equal area: a random layer and a random point along it give a variate
+// directly whenever the point falls inside the next layer up, which happens 97.2% (normal) and 97.8%
+// (exponential) of the time with one multiply and one compare and no logarithms.
+//
+// fastPass() makes that first attempt for a block of random bits: the layer from the low bits, the point
+// from the top 52, four at a time with AVX2 gathers where supported. It returns the positions it could not
+// decide; the distributions finish those with the wedge and tail tests, which need more random numbers.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_ZIGGURAT_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_ZIGGURAT_HPP
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Xoshiro256x4.hpp"
+
+class Ziggurat
+{
+private:
+    bool symmetric;                 // The normal: the point runs over (-1, 1) of the layer
+    double r;                       // Start of the tail
+    std::uint64_t mask;             // Layers - 1
+    std::vector<double> x;          // Right edge of each layer, 0 past the top
+    std::vector<double> ratio;      // x[i + 1] / x[i]: points below it are inside the next layer
+    std::vector<double> heights;    // density(x[i])
+
+    Ziggurat(bool symmetric, std::size_t layers, double r, double v);
+
+    static std::atomic<bool>& simdSwitch();
+
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_XOSHIRO256X4_X86
+    std::size_t fastPassAvx2(const std::uint64_t* bits, double* out, std::uint32_t* rejected, std::size_t n) const noexcept;
+#endif
+
+public:
+    Ziggurat(const Ziggurat& source) = default;
+    ~Ziggurat() = default;
+
+    // Operator overloads
+    Ziggurat& operator=(const Ziggurat& source) = default;
+
+    // Accessors
+    static const Ziggurat& normal();
+    static const Ziggurat& exponential();
+    std::size_t layers() const noexcept { return x.size() - 1; }
+    double tail() const noexcept { return r; }
+    static bool simdSupported();
+    static bool simdEnabled();
+    static void enableSimd(bool enable);
+
+    // Core functionality
+    double density(double t) const noexcept { return symmetric ? std::exp(-0.5 * t * t) : std::exp(-t); }
+    std::size_t fastPass(std::span<const std::uint64_t> bits, std::span<double> out, std::uint32_t* rejected) const noexcept;
+
+    /**
+     * Draws one variate, starting from random bits that fastPass() may have rejected
+     * @tparam Next A callable returning 64 random bits
+     * @param bits Random bits: the layer and the point of the first attempt
+     * @param next The source of random bits for the further attempts
+     * @return A standard normal or standard exponential variate
+     */
+    template<typename Next>
+    double draw(std::uint64_t bits, Next&& next) const
+    {
+        for (;; bits = next())
+        {
+            const std::size_t i = bits & mask;
+            const double u = symmetric ? 2.0 * unitInterval(bits) - 1.0 : unitInterval(bits);
+            const double t = u * x[i];
+            if (std::abs(u) < ratio[i]) return t;
+            if (i == 0)
+            {
+                // Beyond r: Marsaglia's tail algorithm for the normal, r plus an exponential for the exponential
+                if (!symmetric) return r - std::log(openUnitInterval(next()));
+                double tailX, tailY;
+                do
+                {
+                    tailX = std::log(openUnitInterval(next())) / r;
+                    tailY = std::log(openUnitInterval(next()));
+                } while (-2.0 * tailY < tailX * tailX);
+                return u < 0 ? tailX - r : r - tailX;
+            }
+            // The wedge between layer i and the density
+            const double height = heights[i + 1] + unitInterval(next()) * (heights[i] - heights[i + 1]);
+            if (height < density(t)) return t;
+        }
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_ZIGGURAT_HPP
@@ -2,31 +2,46 @@
 // Created by Michael Lewis on 7/18/23.
 //
 
+#include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
-#include <map>
 #include <random>
+#include <string>
+
+#include "BatchDistributions.hpp"
+#include "Bins.hpp"
+#include "SampleStatistics.hpp"
+#include "Xoshiro256x4.hpp"
 
 // Generic function that works with any distribution and random number engine
-template<typename Dist, typename Eng>
-void GenerateRandomNumbers(Dist d, Eng eng, int nTrials, int degreesOfFreedom, const std::string& s)
+template<typename Dist, typename Eng, typename Bins>
+SampleStatistics<Bins> GenerateRandomNumbers(Dist d, Eng eng, std::uint64_t nTrials, int degreesOfFreedom,
+                                             const Bins& bins, const std::string& s)
 {
-    // Key = bucket/value; Value = number of occurrences
-    std::map<long long, int> counter;
-    for (int i = 0; i < nTrials; ++i)
-    {
-        // Start the engine
-        auto randomNum = d(eng);
-        if (counter.contains(randomNum)) counter.at(randomNum)++;
-        else (counter.emplace(std::make_pair(randomNum, 1)));
-    }
+    SampleStatistics<Bins> statistics = SampleStatistics<Bins>::sample(d, eng, nTrials, bins);
+    const Moments& moments = statistics.moments();
 
     std::cout << "\n\n" << s << " - DOF= " << degreesOfFreedom << std::endl;
-    for (auto entry : counter)
-    {
-        std::cout << std::fixed << std::setprecision(1) << std::setw(2)
-                  << entry.first << " : " << std::string(entry.second / 100, '*') << std::endl;
-    }
+    statistics.histogram().print(std::cout);
+    std::cout << std::setprecision(4) << "mean " << moments.mean() << ", variance " << moments.variance()
+              << ", skewness " << moments.skewness() << ", excess kurtosis " << moments.kurtosis()
+              << ", median " << statistics.histogram().quantile(0.5) << std::endl;
+    return statistics;
+}
+
+// The sample moments against those of the distribution with k degrees of freedom: mean k, variance 2k,
+// skewness sqrt(8 / k), excess kurtosis 12 / k
+void check_chi_squared_moments(const Moments& moments, std::uint64_t samples, int degreesOfFreedom)
+{
+    const double k = degreesOfFreedom;
+    assert(moments.count() == samples);
+    assert(std::abs(moments.mean() / k - 1) < 0.01);
+    assert(std::abs(moments.variance() / (2 * k) - 1) < 0.02);
+    // The higher sample moments of the heavy right tail converge slowly, hence the looser tolerances
+    assert(std::abs(moments.skewness() / std::sqrt(8 / k) - 1) < 0.03);
+    assert(std::abs(moments.kurtosis() / (12 / k) - 1) < 0.15);
 }
 
 // Part A - Test the code by choosing the poisson distribution.
@@ -42,14 +57,27 @@ void test_poisson_chi_squared_distribution(int degreesOfFreedom)
     std::chi_squared_distribution<double> dist(degreesOfFreedom);
 
     // Trials
-    const int norm = 1'00'00;
+    const std::uint64_t norm = 1'000'000;
+
+    auto statistics = GenerateRandomNumbers(dist, engine, norm, degreesOfFreedom, LinearBins(0, 20, 20), "chi-squared distribution");
+    check_chi_squared_moments(statistics.moments(), norm, degreesOfFreedom);
+}
+
+// The same variates drawn in batches: the gamma method of ChiSquaredSampler over the four-lane engine
+void test_batch_chi_squared_distribution(int degreesOfFreedom)
+{
+    std::random_device rd;
+    Xoshiro256x4 engine(static_cast<std::uint64_t>(rd()) << 32 | rd());
+    ChiSquaredSampler<double> dist(degreesOfFreedom);
+    const std::uint64_t norm = 1'000'000;
 
-    GenerateRandomNumbers<std::chi_squared_distribution<double>,
-            std::mt19937_64>(dist, engine, norm, degreesOfFreedom, "chi-squared distribution");
+    auto statistics = GenerateRandomNumbers(dist, engine, norm, degreesOfFreedom, LinearBins(0, 20, 20), "batch chi-squared distribution");
+    check_chi_squared_moments(statistics.moments(), norm, degreesOfFreedom);
 }
 
 // Part B - per the documentation provided at https://en.cppreference.com/w/cpp/numeric/random/chi_squared_distribution
-// the results of these tests match the expected results.
+// the results of these tests match the expected results. The sample moments are also checked against the
+// moments of the distribution above.
 
 // Part C Notes
 // Per https://quantnet.com/threads/7-clarification-of-requirement.33844/post-322127
@@ -66,6 +94,9 @@ int main()
     test_poisson_chi_squared_distribution(4);
     test_poisson_chi_squared_distribution(6);
     test_poisson_chi_squared_distribution(9);
+    test_batch_chi_squared_distribution(1);
+    test_batch_chi_squared_distribution(3);
+    test_batch_chi_squared_distribution(9);
 
     return 0;
 }
\ No newline at end of file
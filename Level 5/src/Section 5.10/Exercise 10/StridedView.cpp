@@ -0,0 +1,390 @@
+//
+// A non-owning strided view of a vector or matrix, and the makeView() factories for the exercise containers
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_STRIDEDVIEW_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_STRIDEDVIEW_CPP
+
+#include <stdexcept>
+#include <string>
+
+#include "StridedView.hpp"
+
+/**
+ * Checks that count elements from start, step apart, lie in [0, extent)
+ * @tparam T The element type
+ * @tparam Rank 1 for a vector, 2 for a matrix
+ * @param start Index of the first element
+ * @param step Distance between elements; may be zero or negative
+ * @param count Number of elements
+ * @param extent Extent of the dimension
+ * @throws std::out_of_range if an element lies outside the dimension
+ */
+template<typename T, std::size_t Rank>
+void StridedView<T, Rank>::checkSlice(std::size_t start, std::ptrdiff_t step, std::size_t count, std::size_t extent)
+{
+    if (count == 0) return;
+    const std::ptrdiff_t last = static_cast<std::ptrdiff_t>(start) + static_cast<std::ptrdiff_t>(count - 1) * step;
+    if (start >= extent || last < 0 || last >= static_cast<std::ptrdiff_t>(extent))
+    {
+        throw std::out_of_range("Slice from " + std::to_string(start) + " by " + std::to_string(step) + " over " +
+                                std::to_string(count) + " elements leaves an extent of " + std::to_string(extent));
+    }
+}
+
+/**
+ * Default ctor: an empty view
+ * @tparam T The element type, const for a read-only view
+ * @tparam Rank 1 for a vector, 2 for a matrix
+ */
+template<typename T, std::size_t Rank>
+StridedView<T, Rank>::StridedView() : first{nullptr}, extents{}, strides{}
+{
+}
+
+/**
+ * Overloaded ctor
+ * @tparam T The element type, const for a read-only view
+ * @tparam Rank 1 for a vector, 2 for a matrix
+ * @param data The element at index 0 in every dimension
+ * @param extent The number of elements along every dimension
+ * @param stride The distance in elements between neighbours along every dimension
+ */
+template<typename T, std::size_t Rank>
+StridedView<T, Rank>::StridedView(T* data, const std::array<std::size_t, Rank>& extent,
+                                  const std::array<std::ptrdiff_t, Rank>& stride)
+    : first{data}, extents{extent}, strides{stride}
+{
+}
+
+/**
+ * Converting ctor: the read-only view of a writable view
+ * @tparam T The const element type
+ * @tparam Rank 1 for a vector, 2 for a matrix
+ * @tparam U The non-const element type
+ * @param other The writable view
+ */
+template<typename T, std::size_t Rank>
+template<typename U> requires std::is_same_v<const U, T>
+StridedView<T, Rank>::StridedView(const StridedView<U, Rank>& other) : first{other.data()}
+{
+    for (std::size_t dimension = 0; dimension < Rank; ++dimension)
+    {
+        extents[dimension] = other.extent(dimension);
+        strides[dimension] = other.stride(dimension);
+    }
+}
+
+/**
+ * @tparam T The element type
+ * @tparam Rank 1 for a vector, 2 for a matrix
+ * @return The number of elements in the view
+ */
+template<typename T, std::size_t Rank>
+std::size_t StridedView<T, Rank>::size() const noexcept
+{
+    std::size_t count = 1;
+    for (std::size_t extent : extents) count *= extent;
+    return count;
+}
+
+/**
+ * @tparam T The element type
+ * @tparam Rank 1 for a vector, 2 for a matrix
+ * @return True if the elements fill one block of memory in row-major order, e.g. a whole matrix or a row
+ */
+template<typename T, std::size_t Rank>
+bool StridedView<T, Rank>::isContiguous() const noexcept
+{
+    if constexpr (Rank == 1) return strides[0] == 1 || extents[0] <= 1;
+    else
+    {
+        return (strides[1] == 1 || extents[1] <= 1) &&
+               (strides[0] == static_cast<std::ptrdiff_t>(extents[1]) || extents[0] <= 1);
+    }
+}
+
+/**
+ * The elements [start, stop) of a vector, as uBLAS vector_range
+ * @tparam T The element type
+ * @tparam Rank 1
+ * @param start The first element
+ * @param stop One past the last element
+ * @return The sub-vector
+ * @throws std::out_of_range if the range is not inside the vector
+ */
+template<typename T, std::size_t Rank>
+StridedView<T, Rank> StridedView<T, Rank>::range(std::size_t start, std::size_t stop) const requires (Rank == 1)
+{
+    if (start > stop || stop > extents[0])
+    {
+        throw std::out_of_range("Range [" + std::to_string(start) + ", " + std::to_string(stop) +
+                                ") is not inside a vector of " + std::to_string(extents[0]) + " elements");
+    }
+    return StridedView(first + static_cast<std::ptrdiff_t>(start) * strides[0], {stop - start}, strides);
+}
+
+/**
+ * Every step-th element of a vector, as uBLAS vector_slice
+ * @tparam T The element type
+ * @tparam Rank 1
+ * @param start The first element
+ * @param step The distance between selected elements; negative steps run backwards
+ * @param count The number of elements
+ * @return The slice
+ * @throws std::out_of_range if the slice is not inside the vector
+ */
+template<typename T, std::size_t Rank>
+StridedView<T, Rank> StridedView<T, Rank>::slice(std::size_t start, std::ptrdiff_t step, std::size_t count) const
+    requires (Rank == 1)
+{
+    checkSlice(start, step, count, extents[0]);
+    return StridedView(first + static_cast<std::ptrdiff_t>(start) * strides[0], {count}, {step * strides[0]});
+}
+
+/**
+ * One row of a matrix, as uBLAS matrix_row
+ * @tparam T The element type
+ * @tparam Rank 2
+ * @param index The row
+ * @return The row as a vector
+ * @throws std::out_of_range if the row does not exist
+ */
+template<typename T, std::size_t Rank>
+StridedView<T, 1> StridedView<T, Rank>::row(std::size_t index) const requires (Rank == 2)
+{
+    if (index >= extents[0])
+    {
+        throw std::out_of_range("Row " + std::to_string(index) + " of a matrix with " + std::to_string(extents[0]) + " rows");
+    }
+    return StridedView<T, 1>(first + static_cast<std::ptrdiff_t>(index) * strides[0], {extents[1]}, {strides[1]});
+}
+
+/**
+ * One column of a matrix, as uBLAS matrix_column
+ * @tparam T The element type
+ * @tparam Rank 2
+ * @param index The column
+ * @return The column as a vector
+ * @throws std::out_of_range if the column does not exist
+ */
+template<typename T, std::size_t Rank>
+StridedView<T, 1> StridedView<T, Rank>::column(std::size_t index) const requires (Rank == 2)
+{
+    if (index >= extents[1])
+    {
+        throw std::out_of_range("Column " + std::to_string(index) + " of a matrix with " + std::to_string(extents[1]) + " columns");
+    }
+    return StridedView<T, 1>(first + static_cast<std::ptrdiff_t>(index) * strides[1], {extents[0]}, {strides[0]});
+}
+
+/**
+ * A rectangular block of a matrix, as uBLAS matrix_range
+ * @tparam T The element type
+ * @tparam Rank 2
+ * @param row The first row of the block
+ * @param column The first column of the block
+ * @param rows The number of rows
+ * @param columns The number of columns
+ * @return The block
+ * @throws std::out_of_range if the block is not inside the matrix
+ */
+template<typename T, std::size_t Rank>
+StridedView<T, Rank> StridedView<T, Rank>::block(std::size_t row, std::size_t column, std::size_t rows,
+                                                 std::size_t columns) const requires (Rank == 2)
+{
+    if (row + rows > extents[0] || column + columns > extents[1])
+    {
+        throw std::out_of_range("Block of " + std::to_string(rows) + " x " + std::to_string(columns) + " at (" +
+                                std::to_string(row) + ", " + std::to_string(column) + ") is not inside a " +
+                                std::to_string(extents[0]) + " x " + std::to_string(extents[1]) + " matrix");
+    }
+    return StridedView(first + static_cast<std::ptrdiff_t>(row) * strides[0] + static_cast<std::ptrdiff_t>(column) * strides[1],
+                       {rows, columns}, strides);
+}
+
+/**
+ * Every rowStep-th row and columnStep-th column of a matrix, as uBLAS matrix_slice
+ * @tparam T The element type
+ * @tparam Rank 2
+ * @param rowStart The first row
+ * @param rowStep The distance between selected rows; negative steps run backwards
+ * @param rows The number of rows
+ * @param columnStart The first column
+ * @param columnStep The distance between selected columns; negative steps run backwards
+ * @param columns The number of columns
+ * @return The slice
+ * @throws std::out_of_range if the slice is not inside the matrix
+ */
+template<typename T, std::size_t Rank>
+StridedView<T, Rank> StridedView<T, Rank>::slice(std::size_t rowStart, std::ptrdiff_t rowStep, std::size_t rows,
+                                                 std::size_t columnStart, std::ptrdiff_t columnStep,
+                                                 std::size_t columns) const requires (Rank == 2)
+{
+    checkSlice(rowStart, rowStep, rows, extents[0]);
+    checkSlice(columnStart, columnStep, columns, extents[1]);
+    return StridedView(first + static_cast<std::ptrdiff_t>(rowStart) * strides[0] +
+                       static_cast<std::ptrdiff_t>(columnStart) * strides[1],
+                       {rows, columns}, {rowStep * strides[0], columnStep * strides[1]});
+}
+
+/**
+ * @tparam T The element type
+ * @tparam Rank 2
+ * @return The transpose, viewing the same elements
+ */
+template<typename T, std::size_t Rank>
+StridedView<T, Rank> StridedView<T, Rank>::transposed() const noexcept requires (Rank == 2)
+{
+    return StridedView(first, {extents[1], extents[0]}, {strides[1], strides[0]});
+}
+
+/**
+ * @tparam T The element type
+ * @param vector The vector
+ * @return A view of every element
+ */
+template<typename T>
+StridedView<T, 1> makeView(std::vector<T>& vector)
+{
+    return StridedView<T, 1>(vector.data(), {vector.size()}, {1});
+}
+
+/**
+ * @tparam T The element type
+ * @param vector The vector
+ * @return A read-only view of every element
+ */
+template<typename T>
+StridedView<const T, 1> makeView(const std::vector<T>& vector)
+{
+    return StridedView<const T, 1>(vector.data(), {vector.size()}, {1});
+}
+
+/**
+ * @tparam T The element type
+ * @param vector The elements of a matrix, row by row
+ * @param rows The number of rows
+ * @param columns The number of columns
+ * @return A view of the matrix
+ * @throws std::invalid_argument if the vector does not hold rows * columns elements
+ */
+template<typename T>
+StridedView<T, 2> makeView(std::vector<T>& vector, std::size_t rows, std::size_t columns)
+{
+    if (vector.size() != rows * columns)
+    {
+        throw std::invalid_argument("A " + std::to_string(rows) + " x " + std::to_string(columns) +
+                                    " matrix cannot view " + std::to_string(vector.size()) + " elements");
+    }
+    return StridedView<T, 2>(vector.data(), {rows, columns}, {static_cast<std::ptrdiff_t>(columns), 1});
+}
+
+/**
+ * @tparam T The element type
+ * @param vector The elements of a matrix, row by row
+ * @param rows The number of rows
+ * @param columns The number of columns
+ * @return A read-only view of the matrix
+ * @throws std::invalid_argument if the vector does not hold rows * columns elements
+ */
+template<typename T>
+StridedView<const T, 2> makeView(const std::vector<T>& vector, std::size_t rows, std::size_t columns)
+{
+    if (vector.size() != rows * columns)
+    {
+        throw std::invalid_argument("A " + std::to_string(rows) + " x " + std::to_string(columns) +
+                                    " matrix cannot view " + std::to_string(vector.size()) + " elements");
+    }
+    return StridedView<const T, 2>(vector.data(), {rows, columns}, {static_cast<std::ptrdiff_t>(columns), 1});
+}
+
+/**
+ * @tparam T The element type
+ * @tparam Storage The uBLAS storage; must be contiguous (the default unbounded_array is)
+ * @param vector The vector
+ * @return A view of every element
+ */
+template<typename T, typename Storage>
+StridedView<T, 1> makeView(boost::numeric::ublas::vector<T, Storage>& vector)
+{
+    return StridedView<T, 1>(vector.data().begin(), {vector.size()}, {1});
+}
+
+/**
+ * @tparam T The element type
+ * @tparam Storage The uBLAS storage; must be contiguous (the default unbounded_array is)
+ * @param vector The vector
+ * @return A read-only view of every element
+ */
+template<typename T, typename Storage>
+StridedView<const T, 1> makeView(const boost::numeric::ublas::vector<T, Storage>& vector)
+{
+    return StridedView<const T, 1>(vector.data().begin(), {vector.size()}, {1});
+}
+
+/**
+ * @tparam T The element type
+ * @tparam Layout row_major or column_major
+ * @tparam Storage The uBLAS storage; must be contiguous (the default unbounded_array is)
+ * @param matrix The matrix
+ * @return A view of the matrix, with the strides of its layout
+ */
+template<typename T, typename Layout, typename Storage>
+StridedView<T, 2> makeView(boost::numeric::ublas::matrix<T, Layout, Storage>& matrix)
+{
+    const auto rows = static_cast<std::ptrdiff_t>(matrix.size1());
+    const auto columns = static_cast<std::ptrdiff_t>(matrix.size2());
+    const bool rowMajor = std::is_same_v<typename Layout::orientation_category, boost::numeric::ublas::row_major_tag>;
+    return StridedView<T, 2>(matrix.data().begin(), {matrix.size1(), matrix.size2()},
+                             {rowMajor ? columns : 1, rowMajor ? 1 : rows});
+}
+
+/**
+ * @tparam T The element type
+ * @tparam Layout row_major or column_major
+ * @tparam Storage The uBLAS storage; must be contiguous (the default unbounded_array is)
+ * @param matrix The matrix
+ * @return A read-only view of the matrix, with the strides of its layout
+ */
+template<typename T, typename Layout, typename Storage>
+StridedView<const T, 2> makeView(const boost::numeric::ublas::matrix<T, Layout, Storage>& matrix)
+{
+    const auto rows = static_cast<std::ptrdiff_t>(matrix.size1());
+    const auto columns = static_cast<std::ptrdiff_t>(matrix.size2());
+    const bool rowMajor = std::is_same_v<typename Layout::orientation_category, boost::numeric::ublas::row_major_tag>;
+    return StridedView<const T, 2>(matrix.data().begin(), {matrix.size1(), matrix.size2()},
+                                   {rowMajor ? columns : 1, rowMajor ? 1 : rows});
+}
+
+/**
+ * @tparam T The element type
+ * @tparam NR The number of rows
+ * @tparam NC The number of columns
+ * @param matrix The matrix; its rows are std::arrays stored back to back
+ * @return A row-major view of the matrix
+ */
+template<typename T, size_t NR, size_t NC>
+StridedView<T, 2> makeView(Matrix<T, NR, NC>& matrix)
+{
+    static_assert(sizeof(std::array<T, NC>) == NC * sizeof(T), "Matrix rows must not be padded");
+    return StridedView<T, 2>(&matrix(0, 0), {NR, NC}, {static_cast<std::ptrdiff_t>(NC), 1});
+}
+
+/**
+ * @tparam T The element type
+ * @tparam NR The number of rows
+ * @tparam NC The number of columns
+ * @param matrix The matrix; its rows are std::arrays stored back to back
+ * @return A read-only row-major view of the matrix
+ */
+template<typename T, size_t NR, size_t NC>
+StridedView<const T, 2> makeView(const Matrix<T, NR, NC>& matrix)
+{
+    static_assert(sizeof(std::array<T, NC>) == NC * sizeof(T), "Matrix rows must not be padded");
+    return StridedView<const T, 2>(&matrix(0, 0), {NR, NC}, {static_cast<std::ptrdiff_t>(NC), 1});
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_STRIDEDVIEW_CPP
@@ -0,0 +1,114 @@
+//
+// A non-owning view of a vector (Rank 1) or matrix (Rank 2) stored in any contiguous buffer, in the spirit
+// of C++23 std::mdspan with a strided layout: a pointer, the extent of each dimension and the distance in
+// elements between neighbours along it. The MatrixProxy of Exercise 6 prints uBLAS matrix_row,
+// matrix_column, matrix_range and matrix_slice proxies; here the same selections are views of their own:
+//
+//  - row(i) and column(j) are Rank 1 views; block() is the counterpart of matrix_range, slice() of
+//    matrix_slice (strides may be negative), transposed() swaps the dimensions.
+//  - Each one is O(1) and copies nothing, so a sub-block of a large matrix is worked on where it lives, and a
+//    view of a view is again a view.
+//
+// makeView() creates views of a std::vector (as a vector, or as a row-major matrix), of uBLAS vectors and
+// row-major or column-major matrices, and of the Matrix of Level 4, whose std::array rows lie back to back.
+// A StridedView<T, Rank> converts to the read-only StridedView<const T, Rank>. Element access does not check
+// its indices; the functions that make views do.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_STRIDEDVIEW_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_STRIDEDVIEW_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "Matrix.hpp"
+
+template<typename T, std::size_t Rank>
+class StridedView
+{
+    static_assert(Rank == 1 || Rank == 2, "StridedView views vectors and matrices");
+
+private:
+    T* first;
+    std::array<std::size_t, Rank> extents;
+    std::array<std::ptrdiff_t, Rank> strides;
+
+    static void checkSlice(std::size_t start, std::ptrdiff_t step, std::size_t count, std::size_t extent);
+
+public:
+    using element_type = T;
+    using value_type = std::remove_const_t<T>;
+    static constexpr std::size_t RANK = Rank;
+
+    StridedView();
+    StridedView(T* data, const std::array<std::size_t, Rank>& extent, const std::array<std::ptrdiff_t, Rank>& stride);
+    template<typename U> requires std::is_same_v<const U, T>
+    StridedView(const StridedView<U, Rank>& other);
+    StridedView(const StridedView& other) = default;
+    ~StridedView() = default;
+
+    // Operator Overloads
+    StridedView& operator=(const StridedView& other) = default;
+    template<typename... Indices> requires (sizeof...(Indices) == Rank)
+    T& operator()(Indices... indices) const noexcept
+    {
+        std::ptrdiff_t offset = 0;
+        std::size_t dimension = 0;
+        ((offset += static_cast<std::ptrdiff_t>(indices) * strides[dimension++]), ...);
+        return first[offset];
+    }
+
+    // Accessors
+    T* data() const noexcept { return first; }
+    std::size_t extent(std::size_t dimension) const noexcept { return extents[dimension]; }
+    std::ptrdiff_t stride(std::size_t dimension) const noexcept { return strides[dimension]; }
+    std::size_t size() const noexcept;
+    bool empty() const noexcept { return size() == 0; }
+    bool isContiguous() const noexcept;
+
+    // Core Functionality
+    StridedView range(std::size_t start, std::size_t stop) const requires (Rank == 1);
+    StridedView slice(std::size_t start, std::ptrdiff_t step, std::size_t count) const requires (Rank == 1);
+    StridedView<T, 1> row(std::size_t index) const requires (Rank == 2);
+    StridedView<T, 1> column(std::size_t index) const requires (Rank == 2);
+    StridedView block(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns) const requires (Rank == 2);
+    StridedView slice(std::size_t rowStart, std::ptrdiff_t rowStep, std::size_t rows,
+                      std::size_t columnStart, std::ptrdiff_t columnStep, std::size_t columns) const requires (Rank == 2);
+    StridedView transposed() const noexcept requires (Rank == 2);
+};
+
+// Views of the containers used in the exercises
+template<typename T>
+StridedView<T, 1> makeView(std::vector<T>& vector);
+template<typename T>
+StridedView<const T, 1> makeView(const std::vector<T>& vector);
+template<typename T>
+StridedView<T, 2> makeView(std::vector<T>& vector, std::size_t rows, std::size_t columns);
+template<typename T>
+StridedView<const T, 2> makeView(const std::vector<T>& vector, std::size_t rows, std::size_t columns);
+template<typename T, typename Storage>
+StridedView<T, 1> makeView(boost::numeric::ublas::vector<T, Storage>& vector);
+template<typename T, typename Storage>
+StridedView<const T, 1> makeView(const boost::numeric::ublas::vector<T, Storage>& vector);
+template<typename T, typename Layout, typename Storage>
+StridedView<T, 2> makeView(boost::numeric::ublas::matrix<T, Layout, Storage>& matrix);
+template<typename T, typename Layout, typename Storage>
+StridedView<const T, 2> makeView(const boost::numeric::ublas::matrix<T, Layout, Storage>& matrix);
+template<typename T, size_t NR, size_t NC>
+StridedView<T, 2> makeView(Matrix<T, NR, NC>& matrix);
+template<typename T, size_t NR, size_t NC>
+StridedView<const T, 2> makeView(const Matrix<T, NR, NC>& matrix);
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_STRIDEDVIEW_CPP
+#include "StridedView.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_STRIDEDVIEW_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_STRIDEDVIEW_HPP
@@ -0,0 +1,641 @@
+//
+// Element-wise and reduction loops over StridedViews, with AVX2 contiguous and gather paths for double
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_CPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "ViewKernels.hpp"
+
+/**
+ * The run-time switch between the SIMD and the portable loops, on by default where the CPU supports it
+ * @tparam T The element type
+ * @return The switch
+ */
+template<typename T>
+std::atomic<bool>& ViewKernels<T>::simdSwitch()
+{
+    static std::atomic<bool> enabled{simdSupported()};
+    return enabled;
+}
+
+/**
+ * @tparam T The element type
+ * @return True if T has SIMD loops and the CPU supports AVX2 and FMA
+ */
+template<typename T>
+bool ViewKernels<T>::simdSupported()
+{
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_X86
+    if constexpr (HAS_SIMD)
+    {
+        static const bool supported = []
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        }();
+        return supported;
+    }
+#endif
+    return false;
+}
+
+/**
+ * @tparam T The element type
+ * @return True if sum, dot, maxAbs and axpy use the SIMD loops
+ */
+template<typename T>
+bool ViewKernels<T>::simdEnabled()
+{
+    return simdSwitch().load(std::memory_order_relaxed);
+}
+
+/**
+ * Switches the SIMD loops on or off, e.g. to compare them with the portable loops. They cannot be switched
+ * on where they are not supported.
+ * @tparam T The element type
+ * @param enable True to use the SIMD loops
+ */
+template<typename T>
+void ViewKernels<T>::enableSimd(bool enable)
+{
+    simdSwitch().store(enable && simdSupported(), std::memory_order_relaxed);
+}
+
+/**
+ * @tparam T The element type
+ * @param value A value
+ * @return |value|
+ */
+template<typename T>
+T ViewKernels<T>::magnitude(T value) noexcept
+{
+    if constexpr (std::is_signed_v<T>) return value < T{} ? -value : value;
+    else return value;
+}
+
+/**
+ * Splits views with the same extents into lines along the dimension in which the lead view has the smaller
+ * stride, and calls function(count, lead line, line of every other view) for each
+ * @tparam T The element type
+ * @tparam Function Callable with a count and one Line per view
+ * @tparam Lead The view that decides the direction of the lines
+ * @tparam Views The other views
+ * @param function The loop over one line
+ * @param lead The lead view
+ * @param views The other views
+ * @throws std::invalid_argument if the extents differ
+ */
+template<typename T>
+template<typename Function, typename Lead, typename... Views>
+void ViewKernels<T>::forEachLine(Function&& function, const Lead& lead, const Views&... views)
+{
+    constexpr std::size_t rank = Lead::RANK;
+    static_assert(((Views::RANK == rank) && ...), "Views must have the same rank");
+    for (std::size_t dimension = 0; dimension < rank; ++dimension)
+    {
+        if (((views.extent(dimension) != lead.extent(dimension)) || ...))
+        {
+            throw std::invalid_argument("Views differ in extent " + std::to_string(dimension) +
+                                        " from the first, which has " + std::to_string(lead.extent(dimension)));
+        }
+    }
+
+    if constexpr (rank == 1)
+    {
+        function(lead.extent(0), Line<typename Lead::element_type>{lead.data(), lead.stride(0)},
+                 Line<typename Views::element_type>{views.data(), views.stride(0)}...);
+    }
+    else
+    {
+        const auto magnitudeOf = [](std::ptrdiff_t stride) { return stride < 0 ? -stride : stride; };
+        const std::size_t inner = magnitudeOf(lead.stride(1)) <= magnitudeOf(lead.stride(0)) ? 1 : 0;
+        const std::size_t outer = 1 - inner;
+        for (std::size_t index = 0; index < lead.extent(outer); ++index)
+        {
+            const auto offset = static_cast<std::ptrdiff_t>(index);
+            function(lead.extent(inner),
+                     Line<typename Lead::element_type>{lead.data() + offset * lead.stride(outer), lead.stride(inner)},
+                     Line<typename Views::element_type>{views.data() + offset * views.stride(outer), views.stride(inner)}...);
+        }
+    }
+}
+
+/**
+ * @tparam T The element type
+ * @param count The number of elements
+ * @param x The line
+ * @return The sum of its elements
+ */
+template<typename T>
+T ViewKernels<T>::sumLine(std::size_t count, Line<const T> x)
+{
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_X86
+    if constexpr (HAS_SIMD)
+    {
+        if (simdEnabled()) return sumAvx2(count, x.data, x.stride);
+    }
+#endif
+
+    // Four accumulators so consecutive additions do not wait for each other
+    T sum0{}, sum1{}, sum2{}, sum3{};
+    std::size_t i = 0;
+    if (x.stride == 1)
+    {
+        for (; i + 4 <= count; i += 4)
+        {
+            sum0 += x.data[i];
+            sum1 += x.data[i + 1];
+            sum2 += x.data[i + 2];
+            sum3 += x.data[i + 3];
+        }
+        for (; i < count; ++i) sum0 += x.data[i];
+    }
+    else
+    {
+        const T* p = x.data;
+        for (; i + 4 <= count; i += 4, p += 4 * x.stride)
+        {
+            sum0 += p[0];
+            sum1 += p[x.stride];
+            sum2 += p[2 * x.stride];
+            sum3 += p[3 * x.stride];
+        }
+        for (; i < count; ++i, p += x.stride) sum0 += *p;
+    }
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+/**
+ * @tparam T The element type
+ * @param count The number of elements
+ * @param x The first line
+ * @param y The second line
+ * @return The sum of x[i] * y[i]
+ */
+template<typename T>
+T ViewKernels<T>::dotLine(std::size_t count, Line<const T> x, Line<const T> y)
+{
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_X86
+    if constexpr (HAS_SIMD)
+    {
+        if (simdEnabled()) return dotAvx2(count, x.data, x.stride, y.data, y.stride);
+    }
+#endif
+
+    T sum0{}, sum1{}, sum2{}, sum3{};
+    std::size_t i = 0;
+    if (x.stride == 1 && y.stride == 1)
+    {
+        for (; i + 4 <= count; i += 4)
+        {
+            sum0 += x.data[i] * y.data[i];
+            sum1 += x.data[i + 1] * y.data[i + 1];
+            sum2 += x.data[i + 2] * y.data[i + 2];
+            sum3 += x.data[i + 3] * y.data[i + 3];
+        }
+        for (; i < count; ++i) sum0 += x.data[i] * y.data[i];
+    }
+    else
+    {
+        const T* p = x.data;
+        const T* q = y.data;
+        for (; i + 4 <= count; i += 4, p += 4 * x.stride, q += 4 * y.stride)
+        {
+            sum0 += p[0] * q[0];
+            sum1 += p[x.stride] * q[y.stride];
+            sum2 += p[2 * x.stride] * q[2 * y.stride];
+            sum3 += p[3 * x.stride] * q[3 * y.stride];
+        }
+        for (; i < count; ++i, p += x.stride, q += y.stride) sum0 += *p * *q;
+    }
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+/**
+ * @tparam T The element type
+ * @param count The number of elements
+ * @param x The line
+ * @return The largest |x[i]|, or 0 if the line is empty
+ */
+template<typename T>
+T ViewKernels<T>::maxAbsLine(std::size_t count, Line<const T> x)
+{
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_X86
+    if constexpr (HAS_SIMD)
+    {
+        if (simdEnabled()) return maxAbsAvx2(count, x.data, x.stride);
+    }
+#endif
+
+    T largest{};
+    if (x.stride == 1)
+    {
+        for (std::size_t i = 0; i < count; ++i) largest = std::max(largest, magnitude(x.data[i]));
+    }
+    else
+    {
+        const T* p = x.data;
+        for (std::size_t i = 0; i < count; ++i, p += x.stride) largest = std::max(largest, magnitude(*p));
+    }
+    return largest;
+}
+
+/**
+ * y[i] += alpha * x[i]
+ * @tparam T The element type
+ * @param count The number of elements
+ * @param alpha The factor
+ * @param x The line read
+ * @param y The line updated
+ */
+template<typename T>
+void ViewKernels<T>::axpyLine(std::size_t count, const T& alpha, Line<const T> x, Line<T> y)
+{
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_X86
+    if constexpr (HAS_SIMD)
+    {
+        // AVX2 has gathers but no scatters, so only a contiguous y is written with vectors
+        if (y.stride == 1 && simdEnabled())
+        {
+            axpyAvx2(count, alpha, x.data, x.stride, y.data);
+            return;
+        }
+    }
+#endif
+
+    if (x.stride == 1 && y.stride == 1)
+    {
+        for (std::size_t i = 0; i < count; ++i) y.data[i] += alpha * x.data[i];
+    }
+    else
+    {
+        const T* p = x.data;
+        T* q = y.data;
+        for (std::size_t i = 0; i < count; ++i, p += x.stride, q += y.stride) *q += alpha * *p;
+    }
+}
+
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_X86
+/**
+ * The AVX2 sum of a line of doubles: plain loads when the stride is 1, gathers of four elements at offsets
+ * 0, s, 2s and 3s otherwise; eight elements per iteration into two accumulators
+ * @tparam T double
+ * @param count The number of elements
+ * @param x The first element
+ * @param stride The distance between elements
+ * @return The sum of the elements
+ */
+template<typename T>
+__attribute__((target("avx2,fma")))
+T ViewKernels<T>::sumAvx2(std::size_t count, const T* x, std::ptrdiff_t stride)
+{
+    // Masked gathers with every lane enabled: the unmasked intrinsic trips -Wmaybe-uninitialized in GCC
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    const __m256i offsets = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+    __m256d sum0 = zero;
+    __m256d sum1 = zero;
+    std::size_t i = 0;
+    if (stride == 1)
+    {
+        for (; i + 8 <= count; i += 8)
+        {
+            sum0 = _mm256_add_pd(sum0, _mm256_loadu_pd(x + i));
+            sum1 = _mm256_add_pd(sum1, _mm256_loadu_pd(x + i + 4));
+        }
+        if (i + 4 <= count)
+        {
+            sum0 = _mm256_add_pd(sum0, _mm256_loadu_pd(x + i));
+            i += 4;
+        }
+    }
+    else
+    {
+        for (; i + 8 <= count; i += 8)
+        {
+            const T* p = x + static_cast<std::ptrdiff_t>(i) * stride;
+            sum0 = _mm256_add_pd(sum0, _mm256_mask_i64gather_pd(zero, p, offsets, all, 8));
+            sum1 = _mm256_add_pd(sum1, _mm256_mask_i64gather_pd(zero, p + 4 * stride, offsets, all, 8));
+        }
+        if (i + 4 <= count)
+        {
+            const T* p = x + static_cast<std::ptrdiff_t>(i) * stride;
+            sum0 = _mm256_add_pd(sum0, _mm256_mask_i64gather_pd(zero, p, offsets, all, 8));
+            i += 4;
+        }
+    }
+
+    sum0 = _mm256_add_pd(sum0, sum1);
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum0), _mm256_extractf128_pd(sum0, 1));
+    double sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    for (; i < count; ++i) sum += x[static_cast<std::ptrdiff_t>(i) * stride];
+    return sum;
+}
+
+/**
+ * The AVX2 dot product of two lines of doubles; each operand is loaded or gathered according to its stride
+ * @tparam T double
+ * @param count The number of elements
+ * @param x The first element of the first line
+ * @param xStride The distance between elements of the first line
+ * @param y The first element of the second line
+ * @param yStride The distance between elements of the second line
+ * @return The sum of x[i] * y[i]
+ */
+template<typename T>
+__attribute__((target("avx2,fma")))
+T ViewKernels<T>::dotAvx2(std::size_t count, const T* x, std::ptrdiff_t xStride, const T* y, std::ptrdiff_t yStride)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    const __m256i xOffsets = _mm256_set_epi64x(3 * xStride, 2 * xStride, xStride, 0);
+    const __m256i yOffsets = _mm256_set_epi64x(3 * yStride, 2 * yStride, yStride, 0);
+    __m256d sum0 = zero;
+    __m256d sum1 = zero;
+    std::size_t i = 0;
+    if (xStride == 1 && yStride == 1)
+    {
+        for (; i + 8 <= count; i += 8)
+        {
+            sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+            sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), sum1);
+        }
+    }
+    else
+    {
+        for (; i + 8 <= count; i += 8)
+        {
+            const T* p = x + static_cast<std::ptrdiff_t>(i) * xStride;
+            const T* q = y + static_cast<std::ptrdiff_t>(i) * yStride;
+            const __m256d x0 = xStride == 1 ? _mm256_loadu_pd(p) : _mm256_mask_i64gather_pd(zero, p, xOffsets, all, 8);
+            const __m256d y0 = yStride == 1 ? _mm256_loadu_pd(q) : _mm256_mask_i64gather_pd(zero, q, yOffsets, all, 8);
+            p += 4 * xStride;
+            q += 4 * yStride;
+            const __m256d x1 = xStride == 1 ? _mm256_loadu_pd(p) : _mm256_mask_i64gather_pd(zero, p, xOffsets, all, 8);
+            const __m256d y1 = yStride == 1 ? _mm256_loadu_pd(q) : _mm256_mask_i64gather_pd(zero, q, yOffsets, all, 8);
+            sum0 = _mm256_fmadd_pd(x0, y0, sum0);
+            sum1 = _mm256_fmadd_pd(x1, y1, sum1);
+        }
+    }
+
+    sum0 = _mm256_add_pd(sum0, sum1);
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum0), _mm256_extractf128_pd(sum0, 1));
+    double sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    for (; i < count; ++i) sum += x[static_cast<std::ptrdiff_t>(i) * xStride] * y[static_cast<std::ptrdiff_t>(i) * yStride];
+    return sum;
+}
+
+/**
+ * The AVX2 largest magnitude in a line of doubles: the sign bit is cleared and lanes are compared four at
+ * a time
+ * @tparam T double
+ * @param count The number of elements
+ * @param x The first element
+ * @param stride The distance between elements
+ * @return The largest |x[i]|, or 0 if the line is empty
+ */
+template<typename T>
+__attribute__((target("avx2,fma")))
+T ViewKernels<T>::maxAbsAvx2(std::size_t count, const T* x, std::ptrdiff_t stride)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256i offsets = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+    __m256d largest = zero;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const T* p = x + static_cast<std::ptrdiff_t>(i) * stride;
+        const __m256d values = stride == 1 ? _mm256_loadu_pd(p) : _mm256_mask_i64gather_pd(zero, p, offsets, all, 8);
+        largest = _mm256_max_pd(largest, _mm256_andnot_pd(sign, values));
+    }
+
+    __m128d half = _mm_max_pd(_mm256_castpd256_pd128(largest), _mm256_extractf128_pd(largest, 1));
+    double result = _mm_cvtsd_f64(_mm_max_sd(half, _mm_unpackhi_pd(half, half)));
+    for (; i < count; ++i) result = std::max(result, magnitude(x[static_cast<std::ptrdiff_t>(i) * stride]));
+    return result;
+}
+
+/**
+ * The AVX2 y[i] += alpha * x[i] for a contiguous line y of doubles; x is loaded or gathered by its stride
+ * @tparam T double
+ * @param count The number of elements
+ * @param alpha The factor
+ * @param x The first element read
+ * @param stride The distance between elements read
+ * @param y The first element updated; elements are consecutive
+ */
+template<typename T>
+__attribute__((target("avx2,fma")))
+void ViewKernels<T>::axpyAvx2(std::size_t count, T alpha, const T* x, std::ptrdiff_t stride, T* y)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    const __m256d factor = _mm256_set1_pd(alpha);
+    const __m256i offsets = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+    std::size_t i = 0;
+    if (stride == 1)
+    {
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm256_storeu_pd(y + i, _mm256_fmadd_pd(factor, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+        }
+    }
+    else
+    {
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m256d values = _mm256_mask_i64gather_pd(zero, x + static_cast<std::ptrdiff_t>(i) * stride, offsets, all, 8);
+            _mm256_storeu_pd(y + i, _mm256_fmadd_pd(factor, values, _mm256_loadu_pd(y + i)));
+        }
+    }
+    for (; i < count; ++i) y[i] += alpha * x[static_cast<std::ptrdiff_t>(i) * stride];
+}
+#endif
+
+/**
+ * Sets every element of a view
+ * @tparam T The element type
+ * @tparam Rank 1 for a vector, 2 for a matrix
+ * @param y The view written
+ * @param value The value
+ */
+template<typename T>
+template<std::size_t Rank>
+void ViewKernels<T>::fill(StridedView<T, Rank> y, const T& value)
+{
+    forEachLine([&value](std::size_t count, Line<T> line)
+    {
+        if (line.stride == 1) std::fill(line.data, line.data + count, value);
+        else for (std::size_t i = 0; i < count; ++i, line.data += line.stride) *line.data = value;
+    }, y);
+}
+
+/**
+ * Multiplies every element of a view
+ * @tparam T The element type
+ * @tparam Rank 1 for a vector, 2 for a matrix
+ * @param y The view updated
+ * @param alpha The factor
+ */
+template<typename T>
+template<std::size_t Rank>
+void ViewKernels<T>::scale(StridedView<T, Rank> y, const T& alpha)
+{
+    forEachLine([&alpha](std::size_t count, Line<T> line)
+    {
+        if (line.stride == 1) for (std::size_t i = 0; i < count; ++i) line.data[i] *= alpha;
+        else for (std::size_t i = 0; i < count; ++i, line.data += line.stride) *line.data *= alpha;
+    }, y);
+}
+
+/**
+ * y += alpha * x
+ * @tparam T The element type
+ * @tparam X The view read
+ * @tparam Rank 1 for a vector, 2 for a matrix
+ * @param alpha The factor
+ * @param x The view read
+ * @param y The view updated
+ * @throws std::invalid_argument if the extents differ
+ */
+template<typename T>
+template<ViewOf<T> X, std::size_t Rank>
+void ViewKernels<T>::axpy(const T& alpha, const X& x, StridedView<T, Rank> y)
+{
+    forEachLine([&alpha](std::size_t count, Line<T> to, auto from)
+    {
+        axpyLine(count, alpha, Line<const T>{from.data, from.stride}, to);
+    }, y, x);
+}
+
+/**
+ * y[i] = function(x[i])
+ * @tparam T The element type
+ * @tparam X The view read
+ * @tparam Rank 1 for a vector, 2 for a matrix
+ * @tparam Function Callable with a T, returning a T
+ * @param x The view read
+ * @param y The view written; may be x itself
+ * @param function The operation
+ * @throws std::invalid_argument if the extents differ
+ */
+template<typename T>
+template<ViewOf<T> X, std::size_t Rank, typename Function>
+void ViewKernels<T>::transform(const X& x, StridedView<T, Rank> y, Function function)
+{
+    forEachLine([&function](std::size_t count, Line<T> to, auto from)
+    {
+        if (to.stride == 1 && from.stride == 1)
+        {
+            for (std::size_t i = 0; i < count; ++i) to.data[i] = function(from.data[i]);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; ++i, to.data += to.stride, from.data += from.stride)
+            {
+                *to.data = function(*from.data);
+            }
+        }
+    }, y, x);
+}
+
+/**
+ * y[i] = function(a[i], b[i])
+ * @tparam T The element type
+ * @tparam A The first view read
+ * @tparam B The second view read
+ * @tparam Rank 1 for a vector, 2 for a matrix
+ * @tparam Function Callable with two Ts, returning a T
+ * @param a The first view read
+ * @param b The second view read
+ * @param y The view written; may be a or b
+ * @param function The operation
+ * @throws std::invalid_argument if the extents differ
+ */
+template<typename T>
+template<ViewOf<T> A, ViewOf<T> B, std::size_t Rank, typename Function>
+void ViewKernels<T>::transform(const A& a, const B& b, StridedView<T, Rank> y, Function function)
+{
+    forEachLine([&function](std::size_t count, Line<T> to, auto left, auto right)
+    {
+        if (to.stride == 1 && left.stride == 1 && right.stride == 1)
+        {
+            for (std::size_t i = 0; i < count; ++i) to.data[i] = function(left.data[i], right.data[i]);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; ++i, to.data += to.stride, left.data += left.stride, right.data += right.stride)
+            {
+                *to.data = function(*left.data, *right.data);
+            }
+        }
+    }, y, a, b);
+}
+
+/**
+ * @tparam T The element type
+ * @tparam X The view
+ * @param x The view
+ * @return The sum of its elements
+ */
+template<typename T>
+template<ViewOf<T> X>
+T ViewKernels<T>::sum(const X& x)
+{
+    T result{};
+    forEachLine([&result](std::size_t count, auto line)
+    {
+        result += sumLine(count, Line<const T>{line.data, line.stride});
+    }, x);
+    return result;
+}
+
+/**
+ * @tparam T The element type
+ * @tparam X The first view
+ * @tparam Y The second view
+ * @param x The first view
+ * @param y The second view
+ * @return The sum of x[i] * y[i]
+ * @throws std::invalid_argument if the extents differ
+ */
+template<typename T>
+template<ViewOf<T> X, ViewOf<T> Y>
+T ViewKernels<T>::dot(const X& x, const Y& y)
+{
+    T result{};
+    forEachLine([&result](std::size_t count, auto left, auto right)
+    {
+        result += dotLine(count, Line<const T>{left.data, left.stride}, Line<const T>{right.data, right.stride});
+    }, x, y);
+    return result;
+}
+
+/**
+ * @tparam T The element type
+ * @tparam X The view
+ * @param x The view
+ * @return The largest |x[i]|, or 0 if the view is empty
+ */
+template<typename T>
+template<ViewOf<T> X>
+T ViewKernels<T>::maxAbs(const X& x)
+{
+    T result{};
+    forEachLine([&result](std::size_t count, auto line)
+    {
+        result = std::max(result, maxAbsLine(count, Line<const T>{line.data, line.stride}));
+    }, x);
+    return result;
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_CPP
@@ -0,0 +1,101 @@
+//
+// Element-wise and reduction loops over StridedViews: fill, scale, axpy (y += alpha * x) and transform write
+// a view, sum, dot and maxAbs reduce one or two views to a number. Operands must have the same extents but
+// may have any strides, so a row, a column, a block or a slice of a matrix can be combined with a vector
+// without copying anything.
+//
+// A matrix view is walked as a sequence of lines along the dimension with the smaller stride (the rows of a
+// row-major matrix, the columns of a column-major one); the first operand, or the view written, decides.
+// Each line is then either contiguous (stride 1), where the loops run over consecutive elements, or strided,
+// where they gather every stride-th element. For double, sum, dot, maxAbs and axpy have AVX2/FMA versions of
+// both paths (plain vector loads when the stride is 1, hardware gathers otherwise), chosen at run time when
+// the CPU supports them so the exercise does not have to be built with -mavx2.
+//
+// The operations are static functions because ViewKernels has no state.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include "StridedView.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_X86
+#include <immintrin.h>
+#endif
+
+// A view whose elements are T or const T
+template<typename View, typename T>
+concept ViewOf = std::is_same_v<typename View::value_type, T>;
+
+template<typename T>
+class ViewKernels
+{
+    static_assert(std::is_arithmetic_v<T>, "ViewKernels works on arithmetic types");
+
+private:
+    // One dimension of a view: count elements from data, stride apart
+    template<typename U>
+    struct Line
+    {
+        U* data;
+        std::ptrdiff_t stride;
+    };
+
+    static std::atomic<bool>& simdSwitch();
+    static T magnitude(T value) noexcept;
+
+    template<typename Function, typename Lead, typename... Views>
+    static void forEachLine(Function&& function, const Lead& lead, const Views&... views);
+
+    static T sumLine(std::size_t count, Line<const T> x);
+    static T dotLine(std::size_t count, Line<const T> x, Line<const T> y);
+    static T maxAbsLine(std::size_t count, Line<const T> x);
+    static void axpyLine(std::size_t count, const T& alpha, Line<const T> x, Line<T> y);
+
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_X86
+    static T sumAvx2(std::size_t count, const T* x, std::ptrdiff_t stride);
+    static T dotAvx2(std::size_t count, const T* x, std::ptrdiff_t xStride, const T* y, std::ptrdiff_t yStride);
+    static T maxAbsAvx2(std::size_t count, const T* x, std::ptrdiff_t stride);
+    static void axpyAvx2(std::size_t count, T alpha, const T* x, std::ptrdiff_t stride, T* y);
+#endif
+
+public:
+    // Accessors
+    static constexpr bool HAS_SIMD = std::is_same_v<T, double>;
+    static bool simdSupported();
+    static bool simdEnabled();
+    static void enableSimd(bool enable);
+
+    // Core Functionality
+    template<std::size_t Rank>
+    static void fill(StridedView<T, Rank> y, const T& value);
+    template<std::size_t Rank>
+    static void scale(StridedView<T, Rank> y, const T& alpha);
+    template<ViewOf<T> X, std::size_t Rank>
+    static void axpy(const T& alpha, const X& x, StridedView<T, Rank> y);
+    template<ViewOf<T> X, std::size_t Rank, typename Function>
+    static void transform(const X& x, StridedView<T, Rank> y, Function function);
+    template<ViewOf<T> A, ViewOf<T> B, std::size_t Rank, typename Function>
+    static void transform(const A& a, const B& b, StridedView<T, Rank> y, Function function);
+
+    template<ViewOf<T> X>
+    static T sum(const X& x);
+    template<ViewOf<T> X, ViewOf<T> Y>
+    static T dot(const X& x, const Y& y);
+    template<ViewOf<T> X>
+    static T maxAbs(const X& x);
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_CPP
+#include "ViewKernels.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_VIEWKERNELS_HPP
@@ -0,0 +1,356 @@
+//
+// Tests StridedView against the uBLAS proxies of Exercise 6 (matrix_row, matrix_column, matrix_range and
+// matrix_slice over the same 10 x 10 matrix) and over a std::vector and the Matrix of Level 4, checks that
+// the ViewKernels loops agree with plain loops on contiguous and strided views with and without SIMD, and
+// benchmarks reducing a block of a large matrix through a view against copying it out first.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+
+#include "Matrix.hpp"
+#include "StopWatch.hpp"
+#include "StridedView.hpp"
+#include "ViewKernels.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+double sink = 0;
+
+template<typename Layout>
+ublas::matrix<double, Layout> exerciseMatrix()
+{
+    ublas::matrix<double, Layout> m(10, 10);
+    for (unsigned i = 0; i < m.size1(); ++i)
+    {
+        for (unsigned j = 0; j < m.size2(); ++j) m(i, j) = 10 * i + j;
+    }
+    return m;
+}
+
+template<typename Proxy, typename T>
+bool sameVector(const Proxy& proxy, const StridedView<T, 1>& view)
+{
+    if (proxy.size() != view.extent(0)) return false;
+    for (std::size_t i = 0; i < proxy.size(); ++i)
+    {
+        if (proxy(i) != view(i)) return false;
+    }
+    return true;
+}
+
+template<typename Proxy, typename T>
+bool sameMatrix(const Proxy& proxy, const StridedView<T, 2>& view)
+{
+    if (proxy.size1() != view.extent(0) || proxy.size2() != view.extent(1)) return false;
+    for (std::size_t i = 0; i < proxy.size1(); ++i)
+    {
+        for (std::size_t j = 0; j < proxy.size2(); ++j)
+        {
+            if (proxy(i, j) != view(i, j)) return false;
+        }
+    }
+    return true;
+}
+
+// Every selection of Exercise 6 as a view, over both uBLAS layouts
+template<typename Layout>
+void test_UblasProxies()
+{
+    ublas::matrix<double, Layout> m = exerciseMatrix<Layout>();
+    StridedView<double, 2> view = makeView(m);
+    assert(view.extent(0) == 10 && view.extent(1) == 10 && view.isContiguous() == (std::is_same_v<Layout, ublas::row_major>));
+
+    for (std::size_t i = 0; i < m.size1(); ++i)
+    {
+        assert(sameVector(ublas::matrix_row<ublas::matrix<double, Layout>>(m, i), view.row(i)));
+        assert(sameVector(ublas::matrix_column<ublas::matrix<double, Layout>>(m, i), view.column(i)));
+    }
+    assert(sameMatrix(ublas::matrix_range<ublas::matrix<double, Layout>>(m, ublas::range(1, 3), ublas::range(1, 3)),
+                      view.block(1, 1, 2, 2)));
+    assert(sameMatrix(ublas::matrix_range<ublas::matrix<double, Layout>>(m, ublas::range(2, 9), ublas::range(0, 4)),
+                      view.block(2, 0, 7, 4)));
+    assert(sameMatrix(ublas::matrix_slice<ublas::matrix<double, Layout>>(m, ublas::slice(2, 3, 3), ublas::slice(2, 3, 3)),
+                      view.slice(2, 3, 3, 2, 3, 3)));
+    assert(sameMatrix(ublas::matrix_slice<ublas::matrix<double, Layout>>(m, ublas::slice(9, -2, 5), ublas::slice(1, 4, 3)),
+                      view.slice(9, -2, 5, 1, 4, 3)));
+    assert(sameMatrix(ublas::trans(m), view.transposed()));
+
+    // A view of a view is the same as one view of the composed selection
+    assert(sameMatrix(ublas::matrix_range<ublas::matrix<double, Layout>>(m, ublas::range(3, 5), ublas::range(4, 7)),
+                      view.block(2, 2, 6, 6).block(1, 2, 2, 3)));
+    assert(view.slice(0, 2, 5, 0, 2, 5).slice(4, -1, 5, 0, 1, 5)(0, 1) == m(8, 2));
+
+    // Writes through a view land in the matrix
+    ViewKernels<double>::fill(view.block(8, 8, 2, 2), -1.0);
+    assert(m(8, 8) == -1.0 && m(9, 9) == -1.0 && m(7, 8) == 78.0 && m(8, 7) == 87.0);
+
+    // uBLAS vectors and their ranges
+    ublas::vector<double> v(10);
+    for (std::size_t i = 0; i < v.size(); ++i) v(i) = static_cast<double>(i);
+    StridedView<const double, 1> vector = makeView(std::as_const(v));
+    assert(sameVector(ublas::vector_range<ublas::vector<double>>(v, ublas::range(2, 7)), vector.range(2, 7)));
+    assert(sameVector(ublas::vector_slice<ublas::vector<double>>(v, ublas::slice(9, -3, 4)), vector.slice(9, -3, 4)));
+}
+
+// Views over a std::vector and the Matrix of Level 4 share the memory of their owner
+void test_OtherContainers()
+{
+    std::vector<int> values(12);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i);
+
+    StridedView<int, 1> vector = makeView(values);
+    assert(vector.size() == 12 && vector.isContiguous() && vector.data() == values.data());
+    StridedView<int, 2> matrix = makeView(values, 3, 4);
+    assert(matrix(2, 1) == 9 && matrix.column(3)(1) == 7 && matrix.transposed()(3, 1) == 7);
+    matrix.column(0)(2) = 100;
+    assert(values[8] == 100 && vector(8) == 100);
+
+    // Read-only views of non-const views and of const containers
+    StridedView<const int, 2> readOnly = matrix;
+    assert(readOnly(2, 0) == 100 && readOnly.stride(0) == 4);
+    const std::vector<int>& constant = values;
+    StridedView<const int, 1> evens = makeView(constant).slice(0, 2, 6);
+    assert(evens.extent(0) == 6 && evens(5) == 10 && !evens.isContiguous());
+
+    Matrix<double, 3, 4> fixed(0.0);
+    StridedView<double, 2> fixedView = makeView(fixed);
+    assert(fixedView.isContiguous() && fixedView.stride(0) == 4);
+    fixedView.row(1)(2) = 5.0;
+    fixedView(2, 3) = 7.0;
+    assert(fixed(1, 2) == 5.0 && fixed(2, 3) == 7.0);
+    const Matrix<double, 3, 4>& constFixed = fixed;
+    assert(ViewKernels<double>::sum(makeView(constFixed)) == 12.0);
+
+    // An empty view
+    StridedView<double, 2> empty;
+    assert(empty.empty() && ViewKernels<double>::sum(empty) == 0.0);
+}
+
+void test_Errors()
+{
+    std::vector<double> values(20);
+    StridedView<double, 2> matrix = makeView(values, 4, 5);
+
+    auto throwsOutOfRange = [](auto make)
+    {
+        try { make(); }
+        catch (const std::out_of_range&) { return true; }
+        return false;
+    };
+    assert(throwsOutOfRange([&] { matrix.row(4); }));
+    assert(throwsOutOfRange([&] { matrix.column(5); }));
+    assert(throwsOutOfRange([&] { matrix.block(2, 2, 3, 1); }));
+    assert(throwsOutOfRange([&] { matrix.slice(0, 2, 3, 0, 1, 5); }));
+    assert(throwsOutOfRange([&] { matrix.slice(1, -1, 3, 0, 1, 5); }));
+    assert(throwsOutOfRange([&] { makeView(values).range(5, 21); }));
+    assert(!throwsOutOfRange([&] { matrix.slice(3, -1, 4, 4, -2, 3); matrix.block(4, 5, 0, 0); }));
+
+    bool thrown = false;
+    try { makeView(values, 3, 5); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { ViewKernels<double>::axpy(1.0, matrix, matrix.transposed()); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// The kernels against plain loops, on every combination of contiguous and strided operands
+template<typename Layout>
+void test_Kernels()
+{
+    std::mt19937_64 engine{36};
+    std::uniform_real_distribution<double> distribution{-1.0, 1.0};
+    ublas::matrix<double, Layout> a(67, 53);
+    ublas::matrix<double, Layout> b(53, 67);
+    for (std::size_t i = 0; i < a.size1(); ++i)
+    {
+        for (std::size_t j = 0; j < a.size2(); ++j)
+        {
+            a(i, j) = distribution(engine);
+            b(j, i) = distribution(engine);
+        }
+    }
+    a(40, 17) = -3.0;
+
+    for (bool simd : {false, true})
+    {
+        ViewKernels<double>::enableSimd(simd);
+        StridedView<const double, 2> x = makeView(std::as_const(a));
+        StridedView<const double, 2> xt = makeView(std::as_const(b)).transposed();
+
+        // Whole matrices, a block, a slice, a row and a column
+        for (auto [left, right] : {std::pair{x, xt}, std::pair{x.block(3, 5, 61, 41), xt.block(3, 5, 61, 41)},
+                                   std::pair{x.slice(66, -3, 22, 1, 2, 26), xt.slice(0, 3, 22, 52, -2, 26)}})
+        {
+            double sum = 0, dot = 0, largest = 0;
+            for (std::size_t i = 0; i < left.extent(0); ++i)
+            {
+                for (std::size_t j = 0; j < left.extent(1); ++j)
+                {
+                    sum += left(i, j);
+                    dot += left(i, j) * right(i, j);
+                    largest = std::max(largest, std::abs(left(i, j)));
+                }
+            }
+            assert(std::abs(ViewKernels<double>::sum(left) - sum) < 1e-12);
+            assert(std::abs(ViewKernels<double>::dot(left, right) - dot) < 1e-12);
+            assert(ViewKernels<double>::maxAbs(left) == largest);
+        }
+        assert(ViewKernels<double>::maxAbs(x) == 3.0);
+        for (std::size_t k : {0, 17, 52})
+        {
+            double dot = 0;
+            for (std::size_t i = 0; i < a.size1(); ++i) dot += a(i, k) * b(k, i);
+            assert(std::abs(ViewKernels<double>::dot(x.column(k), xt.column(k)) - dot) < 1e-12);
+        }
+
+        // axpy and transform into contiguous and strided destinations
+        ublas::matrix<double, Layout> y = a;
+        StridedView<double, 2> target = makeView(y);
+        ViewKernels<double>::axpy(2.0, xt, target);
+        ViewKernels<double>::axpy(-1.0, x.column(7), target.column(9));
+        ViewKernels<double>::scale(target.row(2), 0.5);
+        for (std::size_t i = 0; i < a.size1(); ++i)
+        {
+            for (std::size_t j = 0; j < a.size2(); ++j)
+            {
+                double expected = a(i, j) + 2.0 * b(j, i);
+                if (j == 9) expected -= a(i, 7);
+                if (i == 2) expected *= 0.5;
+                assert(std::abs(y(i, j) - expected) < 1e-14);
+            }
+        }
+
+        ViewKernels<double>::transform(x, xt, target, [](double l, double r) { return l * r; });
+        ViewKernels<double>::transform(target.block(0, 0, 10, 10), target.block(0, 0, 10, 10), [](double v) { return -v; });
+        for (std::size_t i = 0; i < a.size1(); ++i)
+        {
+            for (std::size_t j = 0; j < a.size2(); ++j)
+            {
+                assert(y(i, j) == (i < 10 && j < 10 ? -1.0 : 1.0) * a(i, j) * b(j, i));
+            }
+        }
+    }
+    ViewKernels<double>::enableSimd(true);
+
+    // A type without SIMD loops
+    std::vector<int> values(30);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<int>(i) - 15;
+    StridedView<int, 2> ints = makeView(values, 5, 6);
+    assert(ViewKernels<int>::sum(ints) == -15 && ViewKernels<int>::maxAbs(ints) == 15);
+    assert(ViewKernels<int>::sum(ints.column(5)) == -10 + -4 + 2 + 8 + 14);
+    assert(ViewKernels<int>::dot(ints.row(0), ints.row(0)) == 225 + 196 + 169 + 144 + 121 + 100);
+}
+
+// Summing a block of a large matrix: copying it into a matrix of its own first, element by element through
+// a uBLAS matrix_range, and through a view
+void benchmark_Block(std::size_t n, std::size_t block)
+{
+    ublas::matrix<double> m(n, n);
+    std::fill(m.data().begin(), m.data().end(), 1.0);
+    const std::size_t first = n / 4;
+    constexpr int REPEATS = 10;
+
+    StopWatch stopWatch;
+    stopWatch.Start();
+    for (int r = 0; r < REPEATS; ++r)
+    {
+        ublas::matrix<double> copy = ublas::project(m, ublas::range(first, first + block), ublas::range(first, first + block));
+        sink += ViewKernels<double>::sum(makeView(std::as_const(copy)));
+    }
+    stopWatch.Stop();
+    double copyTime = stopWatch.ElapsedTime();
+    stopWatch.Start();
+    for (int r = 0; r < REPEATS; ++r)
+    {
+        ublas::matrix_range<const ublas::matrix<double>> range(m, ublas::range(first, first + block), ublas::range(first, first + block));
+        double sum = 0;
+        for (std::size_t i = 0; i < block; ++i)
+        {
+            for (std::size_t j = 0; j < block; ++j) sum += range(i, j);
+        }
+        sink += sum;
+    }
+    stopWatch.Stop();
+    double rangeTime = stopWatch.ElapsedTime();
+    stopWatch.Start();
+    for (int r = 0; r < REPEATS; ++r)
+    {
+        sink += ViewKernels<double>::sum(makeView(std::as_const(m)).block(first, first, block, block));
+    }
+    stopWatch.Stop();
+    double viewTime = stopWatch.ElapsedTime();
+
+    const double bytes = static_cast<double>(block * block * sizeof(double)) * REPEATS;
+    std::cout << n << "\t" << block << "\t" << 1e-9 * bytes / copyTime << "\t\t" << 1e-9 * bytes / rangeTime << "\t\t"
+              << 1e-9 * bytes / viewTime << std::endl;
+}
+
+// GB/s of dot products over contiguous and strided views, with and without SIMD
+void benchmark_Dot(std::size_t count, std::ptrdiff_t stride)
+{
+    std::vector<double> x(count * static_cast<std::size_t>(stride), 1.0);
+    std::vector<double> y(count, 0.5);
+    StridedView<const double, 1> left = makeView(std::as_const(x)).slice(0, stride, count);
+    StridedView<const double, 1> right = makeView(std::as_const(y));
+    constexpr int REPEATS = 20;
+
+    double times[2];
+    for (bool simd : {false, true})
+    {
+        ViewKernels<double>::enableSimd(simd);
+        StopWatch stopWatch;
+        stopWatch.Start();
+        for (int r = 0; r < REPEATS; ++r) sink += ViewKernels<double>::dot(left, right);
+        stopWatch.Stop();
+        times[simd] = stopWatch.ElapsedTime();
+    }
+    ViewKernels<double>::enableSimd(true);
+
+    const double bytes = 2.0 * static_cast<double>(count * sizeof(double)) * REPEATS;
+    std::cout << count << "\t" << stride << "\t" << 1e-9 * bytes / times[0] << "\t\t" << 1e-9 * bytes / times[1] << std::endl;
+}
+
+int main()
+{
+    test_UblasProxies<ublas::row_major>();
+    test_UblasProxies<ublas::column_major>();
+    test_OtherContainers();
+    test_Errors();
+    test_Kernels<ublas::row_major>();
+    test_Kernels<ublas::column_major>();
+
+    std::cout << "Sum of a block, GB/s of the block (SIMD " << (ViewKernels<double>::simdEnabled() ? "on" : "off") << ")" << std::endl;
+    std::cout << "n\tblock\tcopy\t\tmatrix_range\tview" << std::endl;
+    benchmark_Block(4096, 512);
+    benchmark_Block(4096, 2048);
+
+    std::cout << "Dot product, GB/s of the elements used" << std::endl;
+    std::cout << "count\tstride\tportable\tSIMD" << std::endl;
+    for (std::ptrdiff_t stride : {1, 2, 8})
+    {
+        benchmark_Dot(4096, stride);
+        benchmark_Dot(1 << 22, stride);
+    }
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,516 @@
+//
+// A static B+ tree search index over a sorted vector, with AVX2 node search and batched, prefetched lookups
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SEARCHINDEX_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SEARCHINDEX_CPP
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "SearchIndex.hpp"
+
+/**
+ * The run-time switch between the SIMD and the portable node search, on by default where the CPU supports it
+ * @tparam T The key type
+ * @return The switch
+ */
+template<typename T>
+std::atomic<bool>& SearchIndex<T>::simdSwitch()
+{
+    static std::atomic<bool> enabled{simdSupported()};
+    return enabled;
+}
+
+/**
+ * @tparam T The key type
+ * @return True if T has a SIMD node search and the CPU supports AVX2
+ */
+template<typename T>
+bool SearchIndex<T>::simdSupported()
+{
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SEARCHINDEX_X86
+    if constexpr (HAS_SIMD)
+    {
+        static const bool supported = []
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+        }();
+        return supported;
+    }
+#endif
+    return false;
+}
+
+/**
+ * @tparam T The key type
+ * @return True if searches compare nodes with SIMD instructions
+ */
+template<typename T>
+bool SearchIndex<T>::simdEnabled()
+{
+    return simdSwitch().load(std::memory_order_relaxed);
+}
+
+/**
+ * Switches the SIMD node search on or off, e.g. to compare it with the portable loop. It cannot be switched
+ * on where it is not supported.
+ * @tparam T The key type
+ * @param enable True to use the SIMD node search
+ */
+template<typename T>
+void SearchIndex<T>::enableSimd(bool enable)
+{
+    simdSwitch().store(enable && simdSupported(), std::memory_order_relaxed);
+}
+
+/**
+ * Default ctor: an empty index
+ * @tparam T The key type
+ */
+template<typename T>
+SearchIndex<T>::SearchIndex() : count{0}
+{
+}
+
+/**
+ * Overloaded ctor
+ * @tparam T The key type
+ * @param sorted The keys in ascending order; duplicates are allowed
+ * @throws std::invalid_argument if the keys are not sorted
+ */
+template<typename T>
+SearchIndex<T>::SearchIndex(std::span<const T> sorted) : count{0}
+{
+    build(sorted);
+}
+
+/**
+ * Overloaded ctor
+ * @tparam T The key type
+ * @param sorted The keys in ascending order; duplicates are allowed
+ * @throws std::invalid_argument if the keys are not sorted
+ */
+template<typename T>
+SearchIndex<T>::SearchIndex(const std::vector<T>& sorted) : count{0}
+{
+    build(std::span<const T>(sorted.data(), sorted.size()));
+}
+
+/**
+ * Overloaded ctor
+ * @tparam T The key type
+ * @tparam Storage The uBLAS storage; must be contiguous (the default unbounded_array is)
+ * @param sorted The keys in ascending order; duplicates are allowed
+ * @throws std::invalid_argument if the keys are not sorted
+ */
+template<typename T>
+template<typename Storage>
+SearchIndex<T>::SearchIndex(const boost::numeric::ublas::vector<T, Storage>& sorted) : count{0}
+{
+    build(std::span<const T>(sorted.data().begin(), sorted.size()));
+}
+
+/**
+ * Lays out the tree. Layer 0 holds the keys, padded to whole nodes with the largest T. Every layer above has
+ * one node per B + 1 nodes below it, and key j of a node is the first key under its child j + 1, so the
+ * number of keys in a node that are below the target is the child to descend into. Separators of children
+ * that do not exist are the largest T as well.
+ * @tparam T The key type
+ * @param sorted The keys in ascending order
+ * @throws std::invalid_argument if the keys are not sorted
+ */
+template<typename T>
+void SearchIndex<T>::build(std::span<const T> sorted)
+{
+    auto unsorted = std::is_sorted_until(sorted.begin(), sorted.end());
+    if (unsorted != sorted.end())
+    {
+        throw std::invalid_argument("Keys must be sorted, but key " + std::to_string(unsorted - sorted.begin()) +
+                                    " is less than the one before it");
+    }
+
+    count = sorted.size();
+    nodes.clear();
+    offsets.clear();
+    if (count == 0) return;
+
+    // Layer sizes: ceil(keys / B) nodes, and the layer above has B keys for every B + 1 of those nodes
+    std::size_t total = 0;
+    for (std::size_t keys = count;; keys = ((keys + B - 1) / B + B) / (B + 1) * B)
+    {
+        offsets.push_back(total);
+        total += (keys + B - 1) / B;
+        if (keys <= B) break;
+    }
+
+    constexpr T PADDING = std::numeric_limits<T>::max();
+    nodes.resize(total);
+    const std::size_t leaves = offsets.size() > 1 ? offsets[1] : total;
+    for (std::size_t i = 0; i < leaves * B; ++i)
+    {
+        nodes[i / B].keys[i % B] = i < count ? sorted[i] : PADDING;
+    }
+    for (std::size_t h = 1; h < offsets.size(); ++h)
+    {
+        const std::size_t end = h + 1 < offsets.size() ? offsets[h + 1] : total;
+        for (std::size_t i = 0; i < (end - offsets[h]) * B; ++i)
+        {
+            // The leftmost node of layer 0 under child j + 1 of node i / B
+            std::size_t child = i / B * (B + 1) + i % B + 1;
+            for (std::size_t l = 1; l < h; ++l) child *= B + 1;
+            nodes[offsets[h] + i / B].keys[i % B] = child * B < count ? sorted[child * B] : PADDING;
+        }
+    }
+}
+
+/**
+ * True if the search would end past the last key, which also keeps the descent away from padding and from
+ * children that do not exist
+ * @tparam T The key type
+ * @tparam Strict True to search for the first key >= x, false for the first key > x
+ * @param x The target
+ * @return True if no key answers the search
+ */
+template<typename T>
+template<bool Strict>
+bool SearchIndex<T>::beyond(T x) const noexcept
+{
+    if constexpr (Strict) return key(count - 1) < x;
+    else return key(count - 1) <= x;
+}
+
+/**
+ * Counts, without branches, the keys of a node below x (Strict) or at or below x
+ * @tparam T The key type
+ * @tparam Strict True to count keys < x, false to count keys <= x
+ * @param node The node
+ * @param x The target
+ * @return The count, 0 to B
+ */
+template<typename T>
+template<bool Strict>
+std::size_t SearchIndex<T>::rank(const Node& node, T x) noexcept
+{
+    std::size_t below = 0;
+    for (std::size_t i = 0; i < B; ++i)
+    {
+        if constexpr (Strict) below += node.keys[i] < x;
+        else below += node.keys[i] <= x;
+    }
+    return below;
+}
+
+/**
+ * Descends from the root to layer 0, one node per layer
+ * @tparam T The key type
+ * @tparam Strict True for the first key >= x, false for the first key > x
+ * @param x The target; beyond() must be false
+ * @return The index of the key found
+ */
+template<typename T>
+template<bool Strict>
+std::size_t SearchIndex<T>::descend(T x) const noexcept
+{
+    std::size_t k = 0;
+    for (std::size_t h = offsets.size() - 1; h > 0; --h) k = k * (B + 1) + rank<Strict>(nodes[offsets[h] + k], x);
+    return k * B + rank<Strict>(nodes[k], x);
+}
+
+/**
+ * Descends from the root for up to BATCH targets together, layer by layer. The node each target needs next
+ * is prefetched as soon as it is known, so the others are searched while it arrives.
+ * @tparam T The key type
+ * @tparam Strict True for the first key >= x, false for the first key > x
+ * @param x The targets
+ * @param result Receives the index of the key found for each target, or size()
+ * @param targets The number of targets, at most BATCH
+ */
+template<typename T>
+template<bool Strict>
+void SearchIndex<T>::descend(const T* x, std::size_t* result, std::size_t targets) const noexcept
+{
+    // Targets past the last key descend towards key 0, which is harmless, and are answered with size()
+    T probes[BATCH];
+    std::size_t k[BATCH];
+    for (std::size_t q = 0; q < targets; ++q)
+    {
+        probes[q] = beyond<Strict>(x[q]) ? std::numeric_limits<T>::lowest() : x[q];
+        k[q] = 0;
+    }
+    for (std::size_t h = offsets.size() - 1; h > 0; --h)
+    {
+        for (std::size_t q = 0; q < targets; ++q)
+        {
+            k[q] = k[q] * (B + 1) + rank<Strict>(nodes[offsets[h] + k[q]], probes[q]);
+            __builtin_prefetch(&nodes[offsets[h - 1] + k[q]]);
+        }
+    }
+    for (std::size_t q = 0; q < targets; ++q)
+    {
+        result[q] = beyond<Strict>(x[q]) ? count : k[q] * B + rank<Strict>(nodes[k[q]], probes[q]);
+    }
+}
+
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SEARCHINDEX_X86
+/**
+ * The AVX2 node search: the node is one cache line, two 256-bit loads; the lanes below x become a bit
+ * mask, and its popcount is the rank
+ * @tparam T std::int32_t or double
+ * @tparam Strict True to count keys < x, false to count keys <= x
+ * @param node The node
+ * @param x The target
+ * @return The count, 0 to B
+ */
+template<typename T>
+template<bool Strict>
+__attribute__((target("avx2,popcnt")))
+std::size_t SearchIndex<T>::rankAvx2(const Node& node, T x) noexcept
+{
+    if constexpr (std::is_same_v<T, double>)
+    {
+        constexpr int PREDICATE = Strict ? _CMP_LT_OQ : _CMP_LE_OQ;
+        const __m256d target = _mm256_set1_pd(x);
+        const __m256d low = _mm256_load_pd(node.keys.data());
+        const __m256d high = _mm256_load_pd(node.keys.data() + 4);
+        const int mask = _mm256_movemask_pd(_mm256_cmp_pd(low, target, PREDICATE)) |
+                         _mm256_movemask_pd(_mm256_cmp_pd(high, target, PREDICATE)) << 4;
+        return static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(mask)));
+    }
+    else
+    {
+        // AVX2 compares integers for > only: keys < x is x > keys, and keys <= x is B minus keys > x
+        const __m256i target = _mm256_set1_epi32(x);
+        const __m256i low = _mm256_load_si256(reinterpret_cast<const __m256i*>(node.keys.data()));
+        const __m256i high = _mm256_load_si256(reinterpret_cast<const __m256i*>(node.keys.data() + 8));
+        const __m256i lowCompare = Strict ? _mm256_cmpgt_epi32(target, low) : _mm256_cmpgt_epi32(low, target);
+        const __m256i highCompare = Strict ? _mm256_cmpgt_epi32(target, high) : _mm256_cmpgt_epi32(high, target);
+        const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(lowCompare)) |
+                         _mm256_movemask_ps(_mm256_castsi256_ps(highCompare)) << 8;
+        const auto above = static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(mask)));
+        return Strict ? above : B - above;
+    }
+}
+
+/**
+ * descend() with the AVX2 node search
+ * @tparam T std::int32_t or double
+ * @tparam Strict True for the first key >= x, false for the first key > x
+ * @param x The target; beyond() must be false
+ * @return The index of the key found
+ */
+template<typename T>
+template<bool Strict>
+__attribute__((target("avx2,popcnt")))
+std::size_t SearchIndex<T>::descendAvx2(T x) const noexcept
+{
+    std::size_t k = 0;
+    for (std::size_t h = offsets.size() - 1; h > 0; --h) k = k * (B + 1) + rankAvx2<Strict>(nodes[offsets[h] + k], x);
+    return k * B + rankAvx2<Strict>(nodes[k], x);
+}
+
+/**
+ * The batched descend() with the AVX2 node search
+ * @tparam T std::int32_t or double
+ * @tparam Strict True for the first key >= x, false for the first key > x
+ * @param x The targets
+ * @param result Receives the index of the key found for each target, or size()
+ * @param targets The number of targets, at most BATCH
+ */
+template<typename T>
+template<bool Strict>
+__attribute__((target("avx2,popcnt")))
+void SearchIndex<T>::descendAvx2(const T* x, std::size_t* result, std::size_t targets) const noexcept
+{
+    T probes[BATCH];
+    std::size_t k[BATCH];
+    for (std::size_t q = 0; q < targets; ++q)
+    {
+        probes[q] = beyond<Strict>(x[q]) ? std::numeric_limits<T>::lowest() : x[q];
+        k[q] = 0;
+    }
+    for (std::size_t h = offsets.size() - 1; h > 0; --h)
+    {
+        for (std::size_t q = 0; q < targets; ++q)
+        {
+            k[q] = k[q] * (B + 1) + rankAvx2<Strict>(nodes[offsets[h] + k[q]], probes[q]);
+            __builtin_prefetch(&nodes[offsets[h - 1] + k[q]]);
+        }
+    }
+    for (std::size_t q = 0; q < targets; ++q)
+    {
+        result[q] = beyond<Strict>(x[q]) ? count : k[q] * B + rankAvx2<Strict>(nodes[k[q]], probes[q]);
+    }
+}
+#endif
+
+/**
+ * The batched searches, BATCH targets at a time
+ * @tparam T The key type
+ * @tparam Strict True for the first key >= x, false for the first key > x
+ * @param x The targets
+ * @param result Receives the index of the key found for each target, or size()
+ * @throws std::invalid_argument if x and result differ in size
+ */
+template<typename T>
+template<bool Strict>
+void SearchIndex<T>::search(std::span<const T> x, std::span<std::size_t> result) const
+{
+    if (x.size() != result.size())
+    {
+        throw std::invalid_argument("Expected " + std::to_string(x.size()) + " results, got " + std::to_string(result.size()));
+    }
+    if (count == 0)
+    {
+        std::fill(result.begin(), result.end(), 0);
+        return;
+    }
+
+    for (std::size_t first = 0; first < x.size(); first += BATCH)
+    {
+        const std::size_t targets = std::min(BATCH, x.size() - first);
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SEARCHINDEX_X86
+        if constexpr (HAS_SIMD)
+        {
+            if (simdEnabled())
+            {
+                descendAvx2<Strict>(x.data() + first, result.data() + first, targets);
+                continue;
+            }
+        }
+#endif
+        descend<Strict>(x.data() + first, result.data() + first, targets);
+    }
+}
+
+/**
+ * @tparam T The key type
+ * @param x The target
+ * @return The index of the first key >= x, or size() if there is none (std::lower_bound)
+ */
+template<typename T>
+std::size_t SearchIndex<T>::lowerBound(T x) const noexcept
+{
+    if (count == 0 || beyond<true>(x)) return count;
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SEARCHINDEX_X86
+    if constexpr (HAS_SIMD)
+    {
+        if (simdEnabled()) return descendAvx2<true>(x);
+    }
+#endif
+    return descend<true>(x);
+}
+
+/**
+ * @tparam T The key type
+ * @param x The target
+ * @return The index of the first key > x, or size() if there is none (std::upper_bound)
+ */
+template<typename T>
+std::size_t SearchIndex<T>::upperBound(T x) const noexcept
+{
+    if (count == 0 || beyond<false>(x)) return count;
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SEARCHINDEX_X86
+    if constexpr (HAS_SIMD)
+    {
+        if (simdEnabled()) return descendAvx2<false>(x);
+    }
+#endif
+    return descend<false>(x);
+}
+
+/**
+ * @tparam T The key type
+ * @param x The target
+ * @return The indices [lowerBound(x), upperBound(x)) of the keys equal to x (std::equal_range)
+ */
+template<typename T>
+std::pair<std::size_t, std::size_t> SearchIndex<T>::equalRange(T x) const noexcept
+{
+    return {lowerBound(x), upperBound(x)};
+}
+
+/**
+ * @tparam T The key type
+ * @param x The target
+ * @return True if a key equals x
+ */
+template<typename T>
+bool SearchIndex<T>::contains(T x) const noexcept
+{
+    const std::size_t index = lowerBound(x);
+    return index < count && key(index) == x;
+}
+
+/**
+ * The interval of a sorted vector of breakpoints that contains x
+ * @tparam T The key type
+ * @param x The target
+ * @return The j with key j <= x < key j + 1, or nothing if x is below the first or at or above the last key
+ */
+template<typename T>
+std::optional<std::size_t> SearchIndex<T>::interval(T x) const noexcept
+{
+    const std::size_t above = upperBound(x);
+    if (above == 0 || above == count) return std::nullopt;
+    return above - 1;
+}
+
+/**
+ * The bucket of x between sorted breakpoints: bucket 0 is below the first breakpoint, bucket j holds
+ * [key j - 1, key j) and bucket size() is at or above the last breakpoint
+ * @tparam T The key type
+ * @param x The target
+ * @return The number of keys <= x
+ */
+template<typename T>
+std::size_t SearchIndex<T>::bucket(T x) const noexcept
+{
+    return upperBound(x);
+}
+
+/**
+ * lowerBound() for many targets, searched together to overlap their cache misses
+ * @tparam T The key type
+ * @param x The targets, in any order
+ * @param result Receives lowerBound(x[i]) in result[i]
+ * @throws std::invalid_argument if x and result differ in size
+ */
+template<typename T>
+void SearchIndex<T>::lowerBound(std::span<const T> x, std::span<std::size_t> result) const
+{
+    search<true>(x, result);
+}
+
+/**
+ * upperBound() for many targets, searched together to overlap their cache misses
+ * @tparam T The key type
+ * @param x The targets, in any order
+ * @param result Receives upperBound(x[i]) in result[i]
+ * @throws std::invalid_argument if x and result differ in size
+ */
+template<typename T>
+void SearchIndex<T>::upperBound(std::span<const T> x, std::span<std::size_t> result) const
+{
+    search<false>(x, result);
+}
+
+/**
+ * bucket() for many targets, searched together to overlap their cache misses
+ * @tparam T The key type
+ * @param x The targets, in any order
+ * @param result Receives bucket(x[i]) in result[i]
+ * @throws std::invalid_argument if x and result differ in size
+ */
+template<typename T>
+void SearchIndex<T>::bucket(std::span<const T> x, std::span<std::size_t> result) const
+{
+    search<false>(x, result);
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SEARCHINDEX_CPP
@@ -0,0 +1,209 @@
+//
+// Tests SearchIndex against std::lower_bound, std::upper_bound and std::equal_range on std::vector and uBLAS
+// vectors of every size up to a few layers, with duplicates and extreme keys, with and without SIMD and one
+// target or many at a time; checks interval() against find_sequential_greater of Exercise 4 and bucket()
+// on a set of breakpoints. Benchmarks report nanoseconds per search next to std::lower_bound.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "SearchIndex.hpp"
+#include "StopWatch.hpp"
+
+std::size_t sink = 0;
+
+// n sorted keys with runs of duplicates, drawn from [0, 4n)
+template<typename T>
+std::vector<T> sortedKeys(std::size_t n, std::mt19937_64& engine)
+{
+    std::uniform_int_distribution<std::int64_t> distribution{0, 4 * static_cast<std::int64_t>(n)};
+    std::vector<T> keys(n);
+    for (T& key : keys) key = static_cast<T>(distribution(engine));
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+template<typename T>
+void checkAgainstStd(const SearchIndex<T>& index, const std::vector<T>& keys, const std::vector<T>& targets)
+{
+    std::vector<std::size_t> lower(targets.size());
+    std::vector<std::size_t> upper(targets.size());
+    index.lowerBound(targets, lower);
+    index.upperBound(targets, upper);
+    for (std::size_t i = 0; i < targets.size(); ++i)
+    {
+        const T x = targets[i];
+        const auto expectedLower = static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), x) - keys.begin());
+        const auto expectedUpper = static_cast<std::size_t>(std::upper_bound(keys.begin(), keys.end(), x) - keys.begin());
+        assert(index.lowerBound(x) == expectedLower && lower[i] == expectedLower);
+        assert(index.upperBound(x) == expectedUpper && upper[i] == expectedUpper);
+        assert(index.equalRange(x) == std::make_pair(expectedLower, expectedUpper));
+        assert(index.contains(x) == std::binary_search(keys.begin(), keys.end(), x));
+    }
+}
+
+// Every size up to three layers, around the node boundaries, on both code paths
+template<typename T>
+void test_SearchIndex()
+{
+    std::mt19937_64 engine{37};
+    constexpr std::size_t B = SearchIndex<T>::B;
+    std::vector<std::size_t> sizes;
+    for (std::size_t n = 0; n <= 3 * B; ++n) sizes.push_back(n);
+    for (std::size_t n : {B * (B + 1) - 1, B * (B + 1), B * (B + 1) + 1, 2 * B * (B + 1) + 3, B * (B + 1) * (B + 1) + 5, std::size_t{50000}})
+    {
+        sizes.push_back(n);
+    }
+
+    for (bool simd : {false, true})
+    {
+        SearchIndex<T>::enableSimd(simd);
+        for (std::size_t n : sizes)
+        {
+            const std::vector<T> keys = sortedKeys<T>(n, engine);
+            const SearchIndex<T> index(keys);
+            assert(index.size() == n);
+            for (std::size_t i = 0; i < n; ++i) assert(index[i] == keys[i]);
+
+            // Every key, the values between them, and targets below and above all keys
+            std::vector<T> targets{std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max(), T{-1}, static_cast<T>(4 * n + 1)};
+            for (std::size_t i = 0; i < std::min<std::size_t>(n, 2000); ++i)
+            {
+                targets.push_back(keys[i]);
+                targets.push_back(static_cast<T>(keys[i] + 1));
+            }
+            std::shuffle(targets.begin(), targets.end(), engine);
+            checkAgainstStd(index, keys, targets);
+        }
+    }
+    SearchIndex<T>::enableSimd(true);
+
+    // The extreme keys themselves, which are also the padding of the last node
+    std::vector<T> extremes{std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), T{0}, T{7},
+                            std::numeric_limits<T>::max(), std::numeric_limits<T>::max()};
+    for (std::size_t n = 0; n < B * (B + 1) + 3; ++n) extremes.insert(extremes.begin() + 3, T{5});
+    checkAgainstStd(SearchIndex<T>(extremes), extremes,
+                    {std::numeric_limits<T>::lowest(), T{-1}, T{0}, T{5}, T{6}, T{7}, T{8}, std::numeric_limits<T>::max()});
+}
+
+// interval() is find_sequential_greater of Exercise 4; bucket() classifies values between breakpoints
+void test_IntervalsAndBuckets()
+{
+    const std::vector<int> keys{1, 2, 3, 3, 5};
+    const SearchIndex<int> index(keys);
+    assert(index.interval(3) == std::size_t{3});
+    assert(index.interval(1) == std::size_t{0});
+    assert(index.interval(4) == std::size_t{3});
+    assert(!index.interval(0).has_value());
+    assert(!index.interval(5).has_value());
+    assert(!index.interval(19).has_value());
+    assert(index.equalRange(3) == std::make_pair(std::size_t{2}, std::size_t{4}));
+
+    // Breakpoints of a uBLAS vector, e.g. the edges of a histogram
+    boost::numeric::ublas::vector<double> edges(5);
+    for (std::size_t i = 0; i < edges.size(); ++i) edges(i) = 0.25 * static_cast<double>(i);
+    const SearchIndex<double> breakpoints(edges);
+    const std::vector<double> values{-0.1, 0.0, 0.1, 0.25, 0.3, 0.99, 1.0, 1.5};
+    std::vector<std::size_t> buckets(values.size());
+    breakpoints.bucket(values, buckets);
+    assert((buckets == std::vector<std::size_t>{0, 1, 1, 2, 2, 4, 5, 5}));
+    for (std::size_t i = 0; i < values.size(); ++i) assert(breakpoints.bucket(values[i]) == buckets[i]);
+    assert(breakpoints.interval(0.6) == std::size_t{2});
+
+    // A type without the SIMD node search
+    const SearchIndex<std::uint16_t> small(std::vector<std::uint16_t>{2, 4, 4, 8});
+    assert(small.lowerBound(4) == 1 && small.upperBound(4) == 3 && small.bucket(9) == 4 && small.height() == 1);
+}
+
+void test_Errors()
+{
+    bool thrown = false;
+    try { SearchIndex<int>(std::vector<int>{1, 3, 2}); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    const SearchIndex<int> index(std::vector<int>{1, 2});
+    std::vector<std::size_t> result(1);
+    thrown = false;
+    try { index.lowerBound(std::vector<int>{1, 2}, result); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    const SearchIndex<int> empty;
+    assert(empty.empty() && empty.lowerBound(3) == 0 && empty.upperBound(3) == 0 && !empty.interval(3).has_value());
+    std::vector<std::size_t> emptyResult(2, 9);
+    empty.upperBound(std::vector<int>{1, 2}, emptyResult);
+    assert(emptyResult[0] == 0 && emptyResult[1] == 0);
+}
+
+// Nanoseconds per lowerBound for random targets: std::lower_bound, the index one target at a time and in
+// batches, without and with SIMD
+template<typename T>
+void benchmark_Search(std::size_t n)
+{
+    std::mt19937_64 engine{38};
+    const std::vector<T> keys = sortedKeys<T>(n, engine);
+    const SearchIndex<T> index(keys);
+    std::uniform_int_distribution<std::int64_t> distribution{0, 4 * static_cast<std::int64_t>(n)};
+    std::vector<T> targets(1 << 20);
+    for (T& target : targets) target = static_cast<T>(distribution(engine));
+    std::vector<std::size_t> result(targets.size());
+
+    StopWatch stopWatch;
+    stopWatch.Start();
+    for (T x : targets) sink += static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), x) - keys.begin());
+    stopWatch.Stop();
+    double stdTime = stopWatch.ElapsedTime();
+
+    double times[2][2];
+    for (bool simd : {false, true})
+    {
+        SearchIndex<T>::enableSimd(simd);
+        stopWatch.Start();
+        for (T x : targets) sink += index.lowerBound(x);
+        stopWatch.Stop();
+        times[simd][0] = stopWatch.ElapsedTime();
+        stopWatch.Start();
+        index.lowerBound(targets, result);
+        sink += result.back();
+        stopWatch.Stop();
+        times[simd][1] = stopWatch.ElapsedTime();
+    }
+    SearchIndex<T>::enableSimd(true);
+
+    const double scale = 1e9 / static_cast<double>(targets.size());
+    std::cout << n << "\t\t" << index.height() << "\t" << scale * stdTime << "\t\t" << scale * times[0][0] << "\t\t"
+              << scale * times[0][1] << "\t\t" << scale * times[1][0] << "\t\t" << scale * times[1][1] << std::endl;
+}
+
+int main()
+{
+    test_SearchIndex<int>();
+    test_SearchIndex<double>();
+    test_SearchIndex<std::int64_t>();
+    test_IntervalsAndBuckets();
+    test_Errors();
+
+    std::cout << "ns per lowerBound, int keys" << std::endl;
+    std::cout << "keys\t\tlayers\tstd\t\tportable\tbatch\t\tSIMD\t\tSIMD batch" << std::endl;
+    for (std::size_t n : {std::size_t{1} << 10, std::size_t{1} << 16, std::size_t{1} << 20, std::size_t{1} << 24}) benchmark_Search<int>(n);
+
+    std::cout << "ns per lowerBound, double keys" << std::endl;
+    std::cout << "keys\t\tlayers\tstd\t\tportable\tbatch\t\tSIMD\t\tSIMD batch" << std::endl;
+    for (std::size_t n : {std::size_t{1} << 10, std::size_t{1} << 16, std::size_t{1} << 20, std::size_t{1} << 24}) benchmark_Search<double>(n);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
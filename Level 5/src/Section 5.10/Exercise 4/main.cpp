@@ -44,7 +44,8 @@ std::tuple<long, bool> find_if(const Vector::const_iterator& first, const Vector
 Result find_sequential_greater(const Vector& v, value_type x)
 {
     std::size_t index = 0;
-    UnaryPredicate p = [&](int element) -> bool {return element <= x && v[++index] > x; };
+    // index runs one ahead of the element tested, so it must be checked before v[index] is read
+    UnaryPredicate p = [&](int element) -> bool { ++index; return element <= x && index < v.size() && v[index] > x; };
 
     std::tuple<long, bool> result = find_if(v.cbegin(), v.cend(), p);
     index = std::get<0>(result);
@@ -148,6 +149,11 @@ void test_find_sequential_greater()
     assert(2 == first);
     assert(3 == second);
     assert(found);
+
+    // No element follows the last one, so a target at or above it is not found
+    target = 5;
+    result = find_sequential_greater(v1, target);
+    assert(!std::get<1>(result));
 }
 
 // Test functionality for finding the first and last index that are less than or equal to and greater than the target value
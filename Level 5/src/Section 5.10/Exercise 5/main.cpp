@@ -53,7 +53,8 @@ template<typename T, template<typename S, typename Alloc> class Container, typen
 Result find_sequential_greater(const Container<T, TAlloc>& container, T x)
 {
     std::size_t index = 0;
-    UnaryPredicate p = [&](int element) -> bool {return element <= x && container[++index] > x; };
+    // index runs one ahead of the element tested, so it must be checked before container[index] is read
+    UnaryPredicate p = [&](T element) -> bool { ++index; return element <= x && index < container.size() && container[index] > x; };
 
     std::tuple<long, bool> result = find_if(container, p);
     index = std::get<0>(result);
@@ -175,6 +176,11 @@ void test_find_sequential_greater()
     assert(3 == first);
     assert(4 == second);
     assert(found);
+
+    // No element follows the last one, so a target at or above it is not found
+    target = 5;
+    assert(!std::get<1>(find_sequential_greater(v1, target)));
+    assert(!std::get<1>(find_sequential_greater(v2, target)));
 }
 
 // Test functionality for finding the first and last index that are less than or equal to and greater
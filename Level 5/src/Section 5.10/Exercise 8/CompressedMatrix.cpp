@@ -0,0 +1,251 @@
+//
+// Compressed sparse row and column matrices with parallel SpMV and SpMM
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_COMPRESSEDMATRIX_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_COMPRESSEDMATRIX_CPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "CompressedMatrix.hpp"
+
+/**
+ * Overloaded ctor: a matrix of zeros
+ * @tparam T The value type
+ * @tparam C Compression::Row (CSR) or Compression::Column (CSC)
+ * @param rows Number of rows
+ * @param columns Number of columns
+ * @throws std::invalid_argument if a dimension exceeds MAX_DIMENSION
+ */
+template<typename T, Compression C>
+CompressedMatrix<T, C>::CompressedMatrix(std::size_t rows, std::size_t columns)
+    : CompressedMatrix(rows, columns, std::vector<std::size_t>((C == Compression::Row ? rows : columns) + 1, 0), {}, {})
+{
+}
+
+/**
+ * Overloaded ctor taking the three arrays of the compressed format, which are checked
+ * @tparam T The value type
+ * @tparam C Compression::Row (CSR) or Compression::Column (CSC)
+ * @param rows Number of rows
+ * @param columns Number of columns
+ * @param outerPointers One more than the number of rows (CSR) or columns (CSC), starting at 0, non-decreasing
+ * @param innerIndices Column (CSR) or row (CSC) of every non-zero, strictly ascending within a row (column)
+ * @param nonZeroValues Value of every non-zero
+ * @throws std::invalid_argument if the arrays do not describe a valid matrix
+ */
+template<typename T, Compression C>
+CompressedMatrix<T, C>::CompressedMatrix(std::size_t rows, std::size_t columns, std::vector<std::size_t> outerPointers,
+                                         std::vector<Index> innerIndices, std::vector<T> nonZeroValues)
+    : rowCount{rows}, columnCount{columns}, pointers{std::move(outerPointers)}, indices{std::move(innerIndices)},
+      values{std::move(nonZeroValues)}
+{
+    if (rows > MAX_DIMENSION || columns > MAX_DIMENSION)
+    {
+        throw std::invalid_argument("Dimensions " + std::to_string(rows) + " x " + std::to_string(columns) +
+                                    " exceed " + std::to_string(MAX_DIMENSION));
+    }
+    if (pointers.size() != outerSize() + 1 || pointers.front() != 0 || pointers.back() != indices.size() ||
+        indices.size() != values.size())
+    {
+        throw std::invalid_argument("Expected " + std::to_string(outerSize() + 1) + " pointers ending at " +
+                                    std::to_string(values.size()) + ", got " + std::to_string(pointers.size()));
+    }
+    for (std::size_t outer = 0; outer < outerSize(); ++outer)
+    {
+        if (pointers[outer] > pointers[outer + 1])
+        {
+            throw std::invalid_argument("Pointers decrease at " + std::to_string(outer));
+        }
+        for (std::size_t n = pointers[outer]; n < pointers[outer + 1]; ++n)
+        {
+            if (indices[n] >= innerSize() || (n > pointers[outer] && indices[n] <= indices[n - 1]))
+            {
+                throw std::invalid_argument("Index " + std::to_string(indices[n]) + " at " + std::to_string(n) +
+                                            " is out of range or not ascending");
+            }
+        }
+    }
+}
+
+/**
+ * Element access by binary search within the row (CSR) or column (CSC)
+ * @tparam T The value type
+ * @tparam C Compression::Row (CSR) or Compression::Column (CSC)
+ * @param row The row
+ * @param column The column
+ * @return The element, T{} if it is not stored
+ * @throws std::out_of_range if the position is outside the matrix
+ */
+template<typename T, Compression C>
+T CompressedMatrix<T, C>::operator()(std::size_t row, std::size_t column) const
+{
+    if (row >= rowCount || column >= columnCount)
+    {
+        throw std::out_of_range("Element (" + std::to_string(row) + ", " + std::to_string(column) +
+                                ") is outside a " + std::to_string(rowCount) + " x " + std::to_string(columnCount) + " matrix");
+    }
+
+    const std::size_t outer = C == Compression::Row ? row : column;
+    const auto inner = static_cast<Index>(C == Compression::Row ? column : row);
+    const auto first = indices.begin() + static_cast<std::ptrdiff_t>(pointers[outer]);
+    const auto last = indices.begin() + static_cast<std::ptrdiff_t>(pointers[outer + 1]);
+    const auto found = std::lower_bound(first, last, inner);
+    return found != last && *found == inner ? values[static_cast<std::size_t>(found - indices.begin())] : T{};
+}
+
+/**
+ * Sequential matrix-vector product
+ * @tparam T The value type
+ * @tparam C Compression::Row (CSR) or Compression::Column (CSC)
+ * @param x A vector of columns() elements
+ * @return A x
+ * @throws std::invalid_argument if x has the wrong size
+ */
+template<typename T, Compression C>
+std::vector<T> CompressedMatrix<T, C>::operator*(const std::vector<T>& x) const
+{
+    std::vector<T> y(rowCount);
+    multiply(x, y);
+    return y;
+}
+
+/**
+ * Matrix-vector product y = A x (SpMV). x and y must not overlap.
+ * @tparam T The value type
+ * @tparam C Compression::Row (CSR) or Compression::Column (CSC)
+ * @param x A vector of columns() elements
+ * @param y Receives rows() elements
+ * @param pool Runs the product in parallel if given
+ * @throws std::invalid_argument if x or y has the wrong size
+ */
+template<typename T, Compression C>
+void CompressedMatrix<T, C>::multiply(std::span<const T> x, std::span<T> y, ThreadPool* pool) const
+{
+    multiply(x, 1, y, pool);
+}
+
+/**
+ * Product with a dense block, Y = A X (SpMM), both blocks stored row by row. X and Y must not overlap.
+ * @tparam T The value type
+ * @tparam C Compression::Row (CSR) or Compression::Column (CSC)
+ * @param x A block of columns() rows of k elements
+ * @param k Number of columns of X and Y
+ * @param y Receives rows() rows of k elements
+ * @param pool Runs the product in parallel if given
+ * @throws std::invalid_argument if k is 0 or a block has the wrong size
+ */
+template<typename T, Compression C>
+void CompressedMatrix<T, C>::multiply(std::span<const T> x, std::size_t k, std::span<T> y, ThreadPool* pool) const
+{
+    if (k == 0 || x.size() != columnCount * k || y.size() != rowCount * k)
+    {
+        throw std::invalid_argument("Cannot multiply a " + std::to_string(rowCount) + " x " + std::to_string(columnCount) +
+                                    " matrix by " + std::to_string(x.size()) + " elements into " +
+                                    std::to_string(y.size()) + " with k = " + std::to_string(k));
+    }
+
+    // Threads only pay off once every part has a few thousand non-zeros to work through
+    constexpr std::size_t NON_ZEROS_PER_PART = 1 << 14;
+    const std::size_t parts = pool == nullptr ? 1 : std::clamp<std::size_t>(values.size() * k / NON_ZEROS_PER_PART, 1, pool->size());
+    const std::size_t* p = pointers.data();
+
+    if constexpr (C == Compression::Row)
+    {
+        auto rowsOf = [&](std::size_t part)
+        {
+            SparseKernels<T>::gather(p, indices.data(), values.data(), SparseKernels<T>::split(p, rowCount, part, parts),
+                                     SparseKernels<T>::split(p, rowCount, part + 1, parts), x.data(), k, y.data());
+        };
+        if (parts == 1) rowsOf(0);
+        else pool->parallelFor(parts, rowsOf);
+    }
+    else
+    {
+        if (parts == 1)
+        {
+            std::fill(y.begin(), y.end(), T{});
+            SparseKernels<T>::scatter(p, indices.data(), values.data(), 0, columnCount, x.data(), k, y.data());
+            return;
+        }
+
+        // Part 0 scatters into y, the others into buffers of their own that are added to y afterwards
+        std::vector<T> buffers((parts - 1) * y.size());
+        pool->parallelFor(parts, [&](std::size_t part)
+        {
+            T* target = part == 0 ? y.data() : buffers.data() + (part - 1) * y.size();
+            if (part == 0) std::fill(y.begin(), y.end(), T{});
+            SparseKernels<T>::scatter(p, indices.data(), values.data(), SparseKernels<T>::split(p, columnCount, part, parts),
+                                      SparseKernels<T>::split(p, columnCount, part + 1, parts), x.data(), k, target);
+        });
+        pool->parallelFor(parts, [&](std::size_t part)
+        {
+            const std::size_t first = y.size() * part / parts;
+            const std::size_t last = y.size() * (part + 1) / parts;
+            for (std::size_t buffer = 0; buffer + 1 < parts; ++buffer)
+            {
+                const T* source = buffers.data() + buffer * y.size();
+                for (std::size_t i = first; i < last; ++i) y[i] += source[i];
+            }
+        });
+    }
+}
+
+/**
+ * Converts between CSR and CSC with a counting sort over the inner indices, in O(non-zeros + dimensions)
+ * @tparam T The value type
+ * @tparam C Compression::Row (CSR) or Compression::Column (CSC)
+ * @return The same matrix in the other format
+ */
+template<typename T, Compression C>
+typename CompressedMatrix<T, C>::Transposed CompressedMatrix<T, C>::convert() const
+{
+    std::vector<std::size_t> transposedPointers(innerSize() + 1, 0);
+    for (Index inner : indices) ++transposedPointers[inner + 1];
+    for (std::size_t i = 0; i < innerSize(); ++i) transposedPointers[i + 1] += transposedPointers[i];
+
+    std::vector<Index> transposedIndices(indices.size());
+    std::vector<T> transposedValues(values.size());
+    std::vector<std::size_t> next(transposedPointers.begin(), transposedPointers.end() - 1);
+    for (std::size_t outer = 0; outer < outerSize(); ++outer)
+    {
+        for (std::size_t n = pointers[outer]; n < pointers[outer + 1]; ++n)
+        {
+            const std::size_t position = next[indices[n]]++;
+            transposedIndices[position] = static_cast<Index>(outer);
+            transposedValues[position] = values[n];
+        }
+    }
+
+    return Transposed{rowCount, columnCount, std::move(transposedPointers), std::move(transposedIndices),
+                      std::move(transposedValues)};
+}
+
+/**
+ * Copies the matrix into a uBLAS compressed_matrix of the same layout, appending the elements in storage order
+ * @tparam T The value type
+ * @tparam C Compression::Row (CSR) or Compression::Column (CSC)
+ * @return A row_major (CSR) or column_major (CSC) compressed_matrix
+ */
+template<typename T, Compression C>
+boost::numeric::ublas::compressed_matrix<T, typename CompressedMatrix<T, C>::UblasLayout>
+CompressedMatrix<T, C>::toUblas() const
+{
+    boost::numeric::ublas::compressed_matrix<T, UblasLayout> matrix(rowCount, columnCount, values.size());
+    for (std::size_t outer = 0; outer < outerSize(); ++outer)
+    {
+        for (std::size_t n = pointers[outer]; n < pointers[outer + 1]; ++n)
+        {
+            if constexpr (C == Compression::Row) matrix.push_back(outer, indices[n], values[n]);
+            else matrix.push_back(indices[n], outer, values[n]);
+        }
+    }
+    return matrix;
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_COMPRESSEDMATRIX_CPP
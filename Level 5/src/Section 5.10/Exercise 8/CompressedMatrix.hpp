@@ -0,0 +1,100 @@
+//
+// Compressed sparse row (CSR) and compressed sparse column (CSC) matrices for products with millions of
+// non-zeros, where the uBLAS sparse types of Exercise 3 are slow: mapped_matrix keeps its elements in a
+// std::map, and prod() walks compressed_matrix through generic sparse iterators.
+//
+// CompressedMatrix<T, Compression::Row> (alias CsrMatrix<T>) keeps, for every row, the range of its
+// non-zeros in three flat arrays: pointers (size_t, one per row plus one), column indices (32 bit, to save
+// bandwidth) and values. CscMatrix<T> is the same with the roles of rows and columns swapped. They are
+// usually built with a CooBuilder, converted into each other with convert(), and to and from uBLAS with
+// toUblas() and CooBuilder::fromUblas().
+//
+// multiply() computes y = A x for a vector (SpMV) or for a dense block of k columns stored row by row (SpMM).
+// Given a ThreadPool the outer indices are split into parts with equal numbers of non-zeros, one per thread.
+// CSR rows are independent; a CSC product scatters into y, so each thread but the first accumulates into a
+// buffer of its own and the buffers are added up afterwards. CSR is the format to use for repeated SpMV.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_COMPRESSEDMATRIX_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_COMPRESSEDMATRIX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+
+#include "SparseKernels.hpp"
+#include "ThreadPool.hpp"
+
+enum class Compression { Row, Column };
+
+template<typename T, Compression C>
+class CompressedMatrix
+{
+public:
+    using value_type = T;
+    using Index = std::uint32_t;
+    using Transposed = CompressedMatrix<T, C == Compression::Row ? Compression::Column : Compression::Row>;
+    using UblasLayout = std::conditional_t<C == Compression::Row, boost::numeric::ublas::row_major,
+                                           boost::numeric::ublas::column_major>;
+
+    // Largest number of rows or columns: the SIMD gather reads indices as signed 32-bit offsets
+    static constexpr std::size_t MAX_DIMENSION = 0x7FFFFFFF;
+
+private:
+    std::size_t rowCount;
+    std::size_t columnCount;
+    std::vector<std::size_t> pointers;      // Non-zeros of outer index i are [pointers[i], pointers[i + 1])
+    std::vector<Index> indices;             // Inner index of every non-zero, ascending within an outer index
+    std::vector<T> values;
+
+    std::size_t outerSize() const noexcept { return C == Compression::Row ? rowCount : columnCount; }
+    std::size_t innerSize() const noexcept { return C == Compression::Row ? columnCount : rowCount; }
+
+public:
+    CompressedMatrix(std::size_t rows, std::size_t columns);
+    CompressedMatrix(std::size_t rows, std::size_t columns, std::vector<std::size_t> outerPointers,
+                     std::vector<Index> innerIndices, std::vector<T> nonZeroValues);
+    CompressedMatrix(const CompressedMatrix& other) = default;
+    CompressedMatrix(CompressedMatrix&& other) noexcept = default;
+    ~CompressedMatrix() = default;
+
+    // Operator Overloads
+    CompressedMatrix& operator=(const CompressedMatrix& other) = default;
+    CompressedMatrix& operator=(CompressedMatrix&& other) noexcept = default;
+    T operator()(std::size_t row, std::size_t column) const;
+    std::vector<T> operator*(const std::vector<T>& x) const;
+    bool operator==(const CompressedMatrix& other) const = default;
+
+    // Accessors
+    std::size_t rows() const noexcept { return rowCount; }
+    std::size_t columns() const noexcept { return columnCount; }
+    std::size_t nonZeros() const noexcept { return values.size(); }
+    std::span<const std::size_t> outerPointers() const noexcept { return pointers; }
+    std::span<const Index> innerIndices() const noexcept { return indices; }
+    std::span<const T> nonZeroValues() const noexcept { return values; }
+
+    // Core Functionality
+    void multiply(std::span<const T> x, std::span<T> y, ThreadPool* pool = nullptr) const;
+    void multiply(std::span<const T> x, std::size_t k, std::span<T> y, ThreadPool* pool = nullptr) const;
+    Transposed convert() const;
+    boost::numeric::ublas::compressed_matrix<T, UblasLayout> toUblas() const;
+};
+
+template<typename T>
+using CsrMatrix = CompressedMatrix<T, Compression::Row>;
+
+template<typename T>
+using CscMatrix = CompressedMatrix<T, Compression::Column>;
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_COMPRESSEDMATRIX_CPP
+#include "CompressedMatrix.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_COMPRESSEDMATRIX_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_COMPRESSEDMATRIX_HPP
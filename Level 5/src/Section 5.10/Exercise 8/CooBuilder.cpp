@@ -0,0 +1,168 @@
+//
+// Builds CSR and CSC matrices from coordinate triples, adding up repeated positions
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_COOBUILDER_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_COOBUILDER_CPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "CooBuilder.hpp"
+
+/**
+ * Overloaded ctor
+ * @tparam T The value type
+ * @param rows Number of rows
+ * @param columns Number of columns
+ * @throws std::invalid_argument if a dimension exceeds CompressedMatrix's MAX_DIMENSION
+ */
+template<typename T>
+CooBuilder<T>::CooBuilder(std::size_t rows, std::size_t columns) : rowCount{rows}, columnCount{columns}
+{
+    if (rows > CsrMatrix<T>::MAX_DIMENSION || columns > CsrMatrix<T>::MAX_DIMENSION)
+    {
+        throw std::invalid_argument("Dimensions " + std::to_string(rows) + " x " + std::to_string(columns) +
+                                    " exceed " + std::to_string(CsrMatrix<T>::MAX_DIMENSION));
+    }
+}
+
+/**
+ * Reserves room for a number of triples
+ * @tparam T The value type
+ * @param count Number of triples
+ */
+template<typename T>
+void CooBuilder<T>::reserve(std::size_t count)
+{
+    entries.reserve(count);
+}
+
+/**
+ * Adds a triple; the values of triples at the same position are added up when the matrix is built
+ * @tparam T The value type
+ * @param row The row
+ * @param column The column
+ * @param value The value
+ * @throws std::out_of_range if the position is outside the matrix
+ */
+template<typename T>
+void CooBuilder<T>::add(std::size_t row, std::size_t column, const T& value)
+{
+    if (row >= rowCount || column >= columnCount)
+    {
+        throw std::out_of_range("Element (" + std::to_string(row) + ", " + std::to_string(column) +
+                                ") is outside a " + std::to_string(rowCount) + " x " + std::to_string(columnCount) + " matrix");
+    }
+    entries.push_back(Entry{static_cast<Index>(row), static_cast<Index>(column), value});
+}
+
+/**
+ * Removes every triple
+ * @tparam T The value type
+ */
+template<typename T>
+void CooBuilder<T>::clear() noexcept
+{
+    entries.clear();
+}
+
+/**
+ * Sorts the triples by outer then inner index and adds up repeats. The outer indices are counting sorted;
+ * triples are then sorted within each outer index, stably so that repeats are added in the order they came.
+ * @tparam T The value type
+ * @tparam C Compression::Row (CSR) or Compression::Column (CSC)
+ * @return The matrix
+ */
+template<typename T>
+template<Compression C>
+CompressedMatrix<T, C> CooBuilder<T>::build() const
+{
+    constexpr bool ROWS = C == Compression::Row;
+    const std::size_t outerSize = ROWS ? rowCount : columnCount;
+
+    std::vector<std::size_t> starts(outerSize + 1, 0);
+    for (const Entry& entry : entries) ++starts[(ROWS ? entry.row : entry.column) + 1];
+    for (std::size_t i = 0; i < outerSize; ++i) starts[i + 1] += starts[i];
+
+    std::vector<std::pair<Index, T>> sorted(entries.size());
+    std::vector<std::size_t> next(starts.begin(), starts.end() - 1);
+    for (const Entry& entry : entries)
+    {
+        sorted[next[ROWS ? entry.row : entry.column]++] = {ROWS ? entry.column : entry.row, entry.value};
+    }
+
+    std::vector<std::size_t> pointers(outerSize + 1, 0);
+    std::vector<Index> indices;
+    std::vector<T> values;
+    indices.reserve(sorted.size());
+    values.reserve(sorted.size());
+    for (std::size_t outer = 0; outer < outerSize; ++outer)
+    {
+        auto first = sorted.begin() + static_cast<std::ptrdiff_t>(starts[outer]);
+        auto last = sorted.begin() + static_cast<std::ptrdiff_t>(starts[outer + 1]);
+        std::stable_sort(first, last, [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        for (auto current = first; current != last; ++current)
+        {
+            if (current != first && current->first == indices.back()) values.back() += current->second;
+            else
+            {
+                indices.push_back(current->first);
+                values.push_back(current->second);
+            }
+        }
+        pointers[outer + 1] = values.size();
+    }
+
+    return CompressedMatrix<T, C>{rowCount, columnCount, std::move(pointers), std::move(indices), std::move(values)};
+}
+
+/**
+ * @tparam T The value type
+ * @return The triples as a compressed sparse row matrix
+ */
+template<typename T>
+CsrMatrix<T> CooBuilder<T>::buildCsr() const
+{
+    return build<Compression::Row>();
+}
+
+/**
+ * @tparam T The value type
+ * @return The triples as a compressed sparse column matrix
+ */
+template<typename T>
+CscMatrix<T> CooBuilder<T>::buildCsc() const
+{
+    return build<Compression::Column>();
+}
+
+/**
+ * Collects the stored elements of a uBLAS sparse matrix (mapped_matrix, compressed_matrix, coordinate_matrix)
+ * @tparam T The value type
+ * @tparam UblasMatrix The uBLAS matrix type
+ * @param matrix The matrix
+ * @return A builder holding one triple per stored element
+ */
+template<typename T>
+template<typename UblasMatrix>
+CooBuilder<T> CooBuilder<T>::fromUblas(const UblasMatrix& matrix)
+{
+    CooBuilder<T> builder{matrix.size1(), matrix.size2()};
+    builder.reserve(matrix.nnz());
+    for (auto row = matrix.begin1(); row != matrix.end1(); ++row)
+    {
+        for (auto element = row.begin(); element != row.end(); ++element)
+        {
+            builder.add(element.index1(), element.index2(), *element);
+        }
+    }
+    return builder;
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_COOBUILDER_CPP
@@ -0,0 +1,71 @@
+//
+// Collects the non-zeros of a sparse matrix as (row, column, value) triples, in any order and with
+// repeats, and builds a CsrMatrix or a CscMatrix from them. Building sorts the triples (a counting sort on
+// the rows or columns, then a sort within each of them) and adds up the values of repeated positions, as
+// when a finite element matrix is assembled. fromUblas() collects the non-zeros of a uBLAS sparse matrix
+// such as the mapped_matrix<std::complex<double>> of Exercise 3.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_COOBUILDER_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_COOBUILDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CompressedMatrix.hpp"
+
+template<typename T>
+class CooBuilder
+{
+private:
+    using Index = std::uint32_t;
+
+    struct Entry
+    {
+        Index row;
+        Index column;
+        T value;
+    };
+
+    std::size_t rowCount;
+    std::size_t columnCount;
+    std::vector<Entry> entries;
+
+    template<Compression C>
+    CompressedMatrix<T, C> build() const;
+
+public:
+    CooBuilder(std::size_t rows, std::size_t columns);
+    CooBuilder(const CooBuilder& other) = default;
+    CooBuilder(CooBuilder&& other) noexcept = default;
+    ~CooBuilder() = default;
+
+    // Operator Overloads
+    CooBuilder& operator=(const CooBuilder& other) = default;
+    CooBuilder& operator=(CooBuilder&& other) noexcept = default;
+
+    // Accessors
+    std::size_t rows() const noexcept { return rowCount; }
+    std::size_t columns() const noexcept { return columnCount; }
+    std::size_t size() const noexcept { return entries.size(); }
+
+    // Core Functionality
+    void reserve(std::size_t count);
+    void add(std::size_t row, std::size_t column, const T& value);
+    void clear() noexcept;
+    CsrMatrix<T> buildCsr() const;
+    CscMatrix<T> buildCsc() const;
+
+    template<typename UblasMatrix>
+    static CooBuilder fromUblas(const UblasMatrix& matrix);
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_COOBUILDER_CPP
+#include "CooBuilder.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_COOBUILDER_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_COOBUILDER_HPP
@@ -0,0 +1,258 @@
+//
+// The gather and scatter loops of CompressedMatrix, with an AVX2 gather for double and std::complex<double>
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_CPP
+
+#include <algorithm>
+
+#include "SparseKernels.hpp"
+
+/**
+ * The run-time switch between the SIMD and the portable gather, on by default where the CPU supports it
+ * @tparam T The value type
+ * @return The switch
+ */
+template<typename T>
+std::atomic<bool>& SparseKernels<T>::simdSwitch()
+{
+    static std::atomic<bool> enabled{simdSupported()};
+    return enabled;
+}
+
+/**
+ * @tparam T The value type
+ * @return True if T has a SIMD gather and the CPU supports AVX2 and FMA
+ */
+template<typename T>
+bool SparseKernels<T>::simdSupported()
+{
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_X86
+    if constexpr (HAS_SIMD)
+    {
+        static const bool supported = []
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        }();
+        return supported;
+    }
+#endif
+    return false;
+}
+
+/**
+ * @tparam T The value type
+ * @return True if gather() uses the SIMD loop for k == 1
+ */
+template<typename T>
+bool SparseKernels<T>::simdEnabled()
+{
+    return simdSwitch().load(std::memory_order_relaxed);
+}
+
+/**
+ * Switches the SIMD gather on or off, e.g. to compare it with the portable loop. It cannot be switched on
+ * where it is not supported.
+ * @tparam T The value type
+ * @param enable True to use the SIMD gather
+ */
+template<typename T>
+void SparseKernels<T>::enableSimd(bool enable)
+{
+    simdSwitch().store(enable && simdSupported(), std::memory_order_relaxed);
+}
+
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_X86
+/**
+ * The AVX2 gather for k == 1. Doubles are fetched with hardware gathers, eight non-zeros per iteration
+ * into two accumulators. A complex value fills half a register, so two non-zeros are multiplied per
+ * instruction (fmaddsub gives re = ar * xr - ai * xi and im = ar * xi + ai * xr).
+ * Inner indices must be below 2^31 because the gather instructions take signed 32-bit offsets.
+ * @tparam T double or std::complex<double>
+ * @param pointers Non-zero ranges of the outer indices
+ * @param indices Inner index of every non-zero
+ * @param values Value of every non-zero
+ * @param first First outer index
+ * @param last One past the last outer index
+ * @param x The dense operand
+ * @param y Receives y[outer] for outer in [first, last)
+ */
+template<typename T>
+__attribute__((target("avx2,fma")))
+void SparseKernels<T>::gatherAvx2(const std::size_t* pointers, const std::uint32_t* indices, const T* values,
+                                  std::size_t first, std::size_t last, const T* x, T* y)
+{
+    if constexpr (std::is_same_v<T, double>)
+    {
+        // Masked gathers with every lane enabled: the unmasked intrinsic trips -Wmaybe-uninitialized in GCC
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        for (std::size_t outer = first; outer < last; ++outer)
+        {
+            std::size_t k = pointers[outer];
+            const std::size_t end = pointers[outer + 1];
+            __m256d sum0 = zero;
+            __m256d sum1 = zero;
+            for (; k + 8 <= end; k += 8)
+            {
+                __m128i index0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + k));
+                __m128i index1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + k + 4));
+                __m256d x0 = _mm256_mask_i32gather_pd(zero, x, index0, all, 8);
+                __m256d x1 = _mm256_mask_i32gather_pd(zero, x, index1, all, 8);
+                sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(values + k), x0, sum0);
+                sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(values + k + 4), x1, sum1);
+            }
+            if (k + 4 <= end)
+            {
+                __m128i index0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + k));
+                __m256d x0 = _mm256_mask_i32gather_pd(zero, x, index0, all, 8);
+                sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(values + k), x0, sum0);
+                k += 4;
+            }
+
+            sum0 = _mm256_add_pd(sum0, sum1);
+            __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum0), _mm256_extractf128_pd(sum0, 1));
+            double sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+            for (; k < end; ++k) sum += values[k] * x[indices[k]];
+            y[outer] = sum;
+        }
+    }
+    else
+    {
+        const double* a = reinterpret_cast<const double*>(values);
+        const double* b = reinterpret_cast<const double*>(x);
+        for (std::size_t outer = first; outer < last; ++outer)
+        {
+            std::size_t k = pointers[outer];
+            const std::size_t end = pointers[outer + 1];
+            __m256d sum = _mm256_setzero_pd();
+            for (; k + 2 <= end; k += 2)
+            {
+                __m256d xv = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(b + 2 * indices[k])),
+                                                  _mm_loadu_pd(b + 2 * indices[k + 1]), 1);
+                __m256d av = _mm256_loadu_pd(a + 2 * k);
+                __m256d crossed = _mm256_mul_pd(_mm256_permute_pd(av, 0xF), _mm256_permute_pd(xv, 0x5));
+                sum = _mm256_add_pd(sum, _mm256_fmaddsub_pd(_mm256_movedup_pd(av), xv, crossed));
+            }
+
+            __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+            double re = _mm_cvtsd_f64(pair);
+            double im = _mm_cvtsd_f64(_mm_unpackhi_pd(pair, pair));
+            if (k < end)
+            {
+                const T product = values[k] * x[indices[k]];
+                re += product.real();
+                im += product.imag();
+            }
+            y[outer] = T{re, im};
+        }
+    }
+}
+#endif
+
+/**
+ * y[outer] = sum over the non-zeros of outer of value * x[inner], for outer in [first, last).
+ * The operands are dense with k columns stored row by row; y is overwritten.
+ * @tparam T The value type
+ * @param pointers Non-zero ranges of the outer indices
+ * @param indices Inner index of every non-zero
+ * @param values Value of every non-zero
+ * @param first First outer index
+ * @param last One past the last outer index
+ * @param x The dense operand, one row of k values per inner index
+ * @param k Number of columns of x and y
+ * @param y The result, one row of k values per outer index
+ */
+template<typename T>
+void SparseKernels<T>::gather(const std::size_t* pointers, const Index* indices, const T* values,
+                              std::size_t first, std::size_t last, const T* x, std::size_t k, T* y)
+{
+    if (k == 1)
+    {
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_X86
+        if constexpr (HAS_SIMD)
+        {
+            if (simdEnabled())
+            {
+                gatherAvx2(pointers, indices, values, first, last, x, y);
+                return;
+            }
+        }
+#endif
+        for (std::size_t outer = first; outer < last; ++outer)
+        {
+            T sum{};
+            for (std::size_t n = pointers[outer]; n < pointers[outer + 1]; ++n) sum += values[n] * x[indices[n]];
+            y[outer] = sum;
+        }
+        return;
+    }
+
+    for (std::size_t outer = first; outer < last; ++outer)
+    {
+        T* __restrict row = y + outer * k;
+        std::fill(row, row + k, T{});
+        for (std::size_t n = pointers[outer]; n < pointers[outer + 1]; ++n)
+        {
+            const T value = values[n];
+            const T* __restrict source = x + static_cast<std::size_t>(indices[n]) * k;
+            for (std::size_t c = 0; c < k; ++c) row[c] += value * source[c];
+        }
+    }
+}
+
+/**
+ * y[inner] += value * x[outer] over the non-zeros of every outer in [first, last).
+ * The operands are dense with k columns stored row by row; y is added to, not overwritten.
+ * @tparam T The value type
+ * @param pointers Non-zero ranges of the outer indices
+ * @param indices Inner index of every non-zero
+ * @param values Value of every non-zero
+ * @param first First outer index
+ * @param last One past the last outer index
+ * @param x The dense operand, one row of k values per outer index
+ * @param k Number of columns of x and y
+ * @param y The result, one row of k values per inner index
+ */
+template<typename T>
+void SparseKernels<T>::scatter(const std::size_t* pointers, const Index* indices, const T* values,
+                               std::size_t first, std::size_t last, const T* x, std::size_t k, T* y)
+{
+    for (std::size_t outer = first; outer < last; ++outer)
+    {
+        const T* __restrict source = x + outer * k;
+        for (std::size_t n = pointers[outer]; n < pointers[outer + 1]; ++n)
+        {
+            const T value = values[n];
+            T* __restrict target = y + static_cast<std::size_t>(indices[n]) * k;
+            for (std::size_t c = 0; c < k; ++c) target[c] += value * source[c];
+        }
+    }
+}
+
+/**
+ * Splits the outer indices into parts with about the same number of non-zeros each, so that rows of very
+ * different lengths still balance across threads
+ * @tparam T The value type
+ * @param pointers Non-zero ranges of the outer indices
+ * @param outer Number of outer indices
+ * @param part The part, in [0, parts]
+ * @param parts Number of parts
+ * @return The first outer index of the part (outer for part == parts)
+ */
+template<typename T>
+std::size_t SparseKernels<T>::split(const std::size_t* pointers, std::size_t outer, std::size_t part, std::size_t parts)
+{
+    if (part == 0) return 0;
+    if (part >= parts) return outer;
+
+    const std::size_t nonZeros = pointers[outer];
+    const std::size_t target = static_cast<std::size_t>(static_cast<long double>(nonZeros) * part / parts);
+    return static_cast<std::size_t>(std::lower_bound(pointers, pointers + outer, target) - pointers);
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_CPP
@@ -0,0 +1,67 @@
+//
+// The inner loops of CompressedMatrix. A compressed matrix stores, for every outer index (a row of a CSR
+// matrix, a column of a CSC matrix), the range pointers[outer] .. pointers[outer + 1] of its non-zeros,
+// each with its inner index and value. Two loops cover both layouts:
+//
+//  - gather:  y[outer] = sum of value * x[inner]   (CSR times a vector, CSC transposed times a vector)
+//  - scatter: y[inner] += value * x[outer]         (CSC times a vector)
+//
+// Both take a dense right-hand side with k columns stored row by row, so the same loop does SpMV (k == 1)
+// and SpMM. SpMV is limited by memory bandwidth: every non-zero streams its value and a 32-bit index, and
+// the gather of x is the only irregular access. For double and std::complex<double> the gather has an
+// AVX2/FMA version (hardware gathers for double, paired 128-bit loads for complex) which is chosen at run
+// time when the CPU supports it, so the exercise does not have to be built with -mavx2.
+//
+// The operations are static functions because SparseKernels has no state.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_HPP
+
+#include <atomic>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_X86
+#include <immintrin.h>
+#endif
+
+template<typename T>
+class SparseKernels
+{
+private:
+    static std::atomic<bool>& simdSwitch();
+
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_X86
+    static void gatherAvx2(const std::size_t* pointers, const std::uint32_t* indices, const T* values,
+                           std::size_t first, std::size_t last, const T* x, T* y);
+#endif
+
+public:
+    using Index = std::uint32_t;
+
+    // Accessors
+    static constexpr bool HAS_SIMD = std::is_same_v<T, double> || std::is_same_v<T, std::complex<double>>;
+    static bool simdSupported();
+    static bool simdEnabled();
+    static void enableSimd(bool enable);
+
+    // Core Functionality
+    static void gather(const std::size_t* pointers, const Index* indices, const T* values,
+                       std::size_t first, std::size_t last, const T* x, std::size_t k, T* y);
+    static void scatter(const std::size_t* pointers, const Index* indices, const T* values,
+                        std::size_t first, std::size_t last, const T* x, std::size_t k, T* y);
+    static std::size_t split(const std::size_t* pointers, std::size_t outer, std::size_t part, std::size_t parts);
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_CPP
+#include "SparseKernels.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SPARSEKERNELS_HPP
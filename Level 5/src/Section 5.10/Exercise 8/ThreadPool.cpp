@@ -0,0 +1,124 @@
+//
+// A fixed-size fork/join thread pool used by the parallel sparse kernels.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+
+#include "ThreadPool.hpp"
+
+/**
+ * Overloaded ctor. The calling thread takes part in every parallelFor(), so threads - 1 workers are started.
+ * @param threads Total number of threads that run tasks, including the caller
+ */
+ThreadPool::ThreadPool(std::size_t threads)
+{
+    threads = std::max<std::size_t>(threads, 1);
+    workers.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i) workers.emplace_back([this] { work(); });
+}
+
+/**
+ * Dtor. Stops and joins the workers.
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    started.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+/**
+ * Worker loop: waits for a new generation of tasks, helps to run it and reports back
+ */
+void ThreadPool::work()
+{
+    std::uint64_t seen = 0;
+    while (true)
+    {
+        Task job;
+        void* jobContext;
+        std::size_t jobCount;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            started.wait(lock, [this, seen] { return stopping || generation != seen; });
+            if (stopping) return;
+
+            seen = generation;
+            job = task;
+            jobContext = context;
+            jobCount = count;
+        }
+
+        drain(job, jobContext, jobCount);
+
+        std::lock_guard<std::mutex> lock{mutex};
+        if (--busy == 0) finished.notify_one();
+    }
+}
+
+/**
+ * Claims and runs task indices until none are left, remembering the first exception
+ * @param job The task
+ * @param jobContext The task's context
+ * @param jobCount Number of indices
+ */
+void ThreadPool::drain(Task job, void* jobContext, std::size_t jobCount)
+{
+    for (std::size_t index = next.fetch_add(1, std::memory_order_relaxed); index < jobCount;
+         index = next.fetch_add(1, std::memory_order_relaxed))
+    {
+        try
+        {
+            job(jobContext, index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            if (!error) error = std::current_exception();
+        }
+    }
+}
+
+/**
+ * Runs job(jobContext, i) for every i in [0, jobCount) on the workers and the calling thread
+ * @param job The task
+ * @param jobContext The task's context
+ * @param jobCount Number of indices
+ * @throws The first exception thrown by the task
+ */
+void ThreadPool::run(Task job, void* jobContext, std::size_t jobCount)
+{
+    std::lock_guard<std::mutex> submit{submitMutex};
+    if (workers.empty() || jobCount <= 1)
+    {
+        for (std::size_t index = 0; index < jobCount; ++index) job(jobContext, index);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        task = job;
+        context = jobContext;
+        count = jobCount;
+        busy = workers.size();
+        next.store(0, std::memory_order_relaxed);
+        ++generation;
+    }
+    started.notify_all();
+
+    drain(job, jobContext, jobCount);
+
+    std::unique_lock<std::mutex> lock{mutex};
+    finished.wait(lock, [this] { return busy == 0; });
+    if (error)
+    {
+        std::exception_ptr thrown = error;
+        error = nullptr;
+        std::rethrow_exception(thrown);
+    }
+}
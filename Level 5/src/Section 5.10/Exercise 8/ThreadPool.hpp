@@ -0,0 +1,78 @@
+//
+// A fixed-size fork/join thread pool used by the parallel sparse kernels (copied from Section 5.9 Exercise 8).
+// parallelFor(count, task) calls task(i) for every i in [0, count) across the workers and the calling
+// thread and returns once all calls are done. Indices are claimed one at a time from an atomic counter.
+//
+// The task is passed as a context pointer plus a plain function pointer rather than as a std::function, so
+// a parallel product does not allocate. One parallelFor() runs at a time; concurrent callers queue up.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_THREADPOOL_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool
+{
+private:
+    using Task = void (*)(void* context, std::size_t index);
+
+    std::vector<std::thread> workers;
+    std::mutex submitMutex;            // Serialises parallelFor() calls
+    std::mutex mutex;                  // Guards everything below except next
+    std::condition_variable started;
+    std::condition_variable finished;
+    std::uint64_t generation{0};
+    std::size_t busy{0};
+    bool stopping{false};
+    Task task{nullptr};
+    void* context{nullptr};
+    std::size_t count{0};
+    std::exception_ptr error;
+    std::atomic<std::size_t> next{0};
+
+    void work();
+    void drain(Task job, void* jobContext, std::size_t jobCount);
+    void run(Task job, void* jobContext, std::size_t jobCount);
+
+public:
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool(ThreadPool&& other) = delete;
+    ~ThreadPool();
+
+    // Operator Overloads
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+    ThreadPool& operator=(ThreadPool&& other) = delete;
+
+    // Accessors
+    std::size_t size() const noexcept { return workers.size() + 1; }
+
+    // Core Functionality
+    /**
+     * Calls function(i) for every i in [0, calls) in parallel and waits for all calls to finish
+     * @tparam Function Callable taking a std::size_t
+     * @param calls Number of calls
+     * @param function The function; it must be safe to call concurrently
+     * @throws The first exception thrown by any call, once all calls are done
+     */
+    template<typename Function>
+    void parallelFor(std::size_t calls, Function&& function)
+    {
+        using Callable = std::remove_reference_t<Function>;
+        run([](void* callable, std::size_t index) { (*static_cast<Callable*>(callable))(index); },
+            const_cast<void*>(static_cast<const void*>(&function)), calls);
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_THREADPOOL_HPP
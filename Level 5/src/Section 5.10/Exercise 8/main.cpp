@@ -0,0 +1,309 @@
+//
+// Tests the CSR/CSC sparse matrices against uBLAS: building from triples with repeats, converting from and
+// to the mapped_matrix<std::complex<double>> of Exercise 3 and compressed_matrix, and SpMV/SpMM for double
+// and std::complex<double> with and without threads and SIMD. The benchmark multiplies a matrix with
+// millions of non-zeros and reports the memory bandwidth and GFLOP/s each version reaches.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "CompressedMatrix.hpp"
+#include "CooBuilder.hpp"
+#include "SparseKernels.hpp"
+#include "StopWatch.hpp"
+#include "ThreadPool.hpp"
+
+double sink = 0;
+
+template<typename T>
+T randomValue(std::mt19937_64& engine)
+{
+    std::uniform_real_distribution<double> distribution{-1.0, 1.0};
+    if constexpr (std::is_same_v<T, double>) return distribution(engine);
+    else return T{distribution(engine), distribution(engine)};
+}
+
+// A random matrix: rows of very different lengths (some empty), columns within a band around the diagonal,
+// and about one triple in ten repeating an earlier position
+template<typename T>
+CooBuilder<T> randomMatrix(std::size_t rows, std::size_t columns, std::size_t averagePerRow, std::mt19937_64& engine)
+{
+    CooBuilder<T> builder{rows, columns};
+    builder.reserve(rows * averagePerRow);
+    const long band = static_cast<long>(std::min<std::size_t>(columns, 4096));
+    std::uniform_int_distribution<long> offset{-band / 2, band / 2};
+    for (std::size_t row = 0; row < rows; ++row)
+    {
+        const std::size_t length = row % 97 == 0 ? 0 : row % 101 == 0 ? 20 * averagePerRow : averagePerRow;
+        long previous = -1;
+        for (std::size_t n = 0; n < length; ++n)
+        {
+            long column = (static_cast<long>(row * columns / rows) + offset(engine) + static_cast<long>(columns)) % static_cast<long>(columns);
+            if (n % 10 == 9 && previous >= 0) column = previous;
+            builder.add(row, static_cast<std::size_t>(column), randomValue<T>(engine));
+            previous = column;
+        }
+    }
+    return builder;
+}
+
+template<typename T>
+bool close(const std::vector<T>& lhs, const std::vector<T>& rhs)
+{
+    double error = 0;
+    double scale = 1;
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        error = std::max(error, std::abs(lhs[i] - rhs[i]));
+        scale = std::max(scale, std::abs(rhs[i]));
+    }
+    return lhs.size() == rhs.size() && error <= 1e-12 * scale;
+}
+
+// Triples are sorted, repeats are added up, and both formats see the same matrix
+void test_CooBuilder()
+{
+    CooBuilder<double> builder{3, 4};
+    builder.add(2, 3, 1.0);
+    builder.add(0, 1, 2.0);
+    builder.add(2, 0, 3.0);
+    builder.add(0, 1, 4.0);
+    builder.add(1, 2, 5.0);
+    builder.add(2, 3, -1.0);
+    assert(6 == builder.size());
+
+    CsrMatrix<double> csr = builder.buildCsr();
+    CscMatrix<double> csc = builder.buildCsc();
+    assert(4 == csr.nonZeros() && 4 == csc.nonZeros());
+    assert((std::vector<std::size_t>{0, 1, 2, 4}) == std::vector<std::size_t>(csr.outerPointers().begin(), csr.outerPointers().end()));
+    assert((std::vector<std::uint32_t>{1, 2, 0, 3}) == std::vector<std::uint32_t>(csr.innerIndices().begin(), csr.innerIndices().end()));
+    assert((std::vector<std::size_t>{0, 1, 2, 3, 4}) == std::vector<std::size_t>(csc.outerPointers().begin(), csc.outerPointers().end()));
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = 0; j < 4; ++j) assert(csr(i, j) == csc(i, j));
+    }
+    assert(6 == csr(0, 1) && 5 == csr(1, 2) && 3 == csr(2, 0) && 0 == csr(2, 3) && 0 == csr(1, 1));
+
+    // Converting between the formats gives what the builder builds
+    assert(csc == csr.convert());
+    assert(csr == csc.convert());
+    assert(csr == csr.convert().convert());
+
+    bool thrown = false;
+    try { builder.add(3, 0, 1.0); }
+    catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { csr(0, 4); }
+    catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+
+    // Arrays that do not describe a matrix are rejected
+    thrown = false;
+    try { CsrMatrix<double> invalid{2, 2, {0, 2, 1}, {0, 1}, {1.0, 2.0}}; }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { CsrMatrix<double> invalid{2, 2, {0, 2, 2}, {1, 0}, {1.0, 2.0}}; }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    CsrMatrix<double> empty{5, 7};
+    assert(0 == empty.nonZeros() && 0 == empty(4, 6));
+    assert((std::vector<double>(5, 0.0)) == empty * std::vector<double>(7, 1.0));
+}
+
+// The complex mapped_matrix of Exercise 3 converts to CSR and CSC and back to compressed_matrix
+void test_Ublas()
+{
+    using namespace boost::numeric::ublas;
+
+    mapped_matrix<std::complex<double>> m1(3, 3, 3 * 3);
+    for (unsigned i = 0; i < m1.size1(); ++i)
+    {
+        for (unsigned j = 0; j < m1.size2(); ++j) m1(i, j) = std::complex<double>(3 * i + j, i);
+    }
+    m1.erase_element(0, 0);
+    m1.erase_element(2, 2);
+
+    CsrMatrix<std::complex<double>> csr = CooBuilder<std::complex<double>>::fromUblas(m1).buildCsr();
+    CscMatrix<std::complex<double>> csc = csr.convert();
+    assert(7 == csr.nonZeros());
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        for (unsigned j = 0; j < 3; ++j) assert(m1(i, j) == csr(i, j) && m1(i, j) == csc(i, j));
+    }
+
+    compressed_matrix<std::complex<double>, row_major> rows = csr.toUblas();
+    compressed_matrix<std::complex<double>, column_major> columns = csc.toUblas();
+    assert(7 == rows.nnz() && 7 == columns.nnz());
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        for (unsigned j = 0; j < 3; ++j) assert(m1(i, j) == rows(i, j) && m1(i, j) == columns(i, j));
+    }
+    assert(csr == CooBuilder<std::complex<double>>::fromUblas(rows).buildCsr());
+    assert(csc == CooBuilder<std::complex<double>>::fromUblas(columns).buildCsc());
+
+    // The products agree with uBLAS
+    vector<std::complex<double>> x(3);
+    for (unsigned i = 0; i < 3; ++i) x(i) = std::complex<double>(1.0 + i, -0.5 * i);
+    vector<std::complex<double>> expected = prod(m1, x);
+    std::vector<std::complex<double>> y = csr * std::vector<std::complex<double>>(x.begin(), x.end());
+    assert(close(y, std::vector<std::complex<double>>(expected.begin(), expected.end())));
+}
+
+// SpMV and SpMM in both formats, sequential and on a pool, with and without SIMD, agree with a reference
+template<typename T>
+void test_Multiply()
+{
+    std::mt19937_64 engine{42};
+    const std::size_t rows = 3001;
+    const std::size_t columns = 2003;
+    CooBuilder<T> builder = randomMatrix<T>(rows, columns, 40, engine);
+    CsrMatrix<T> csr = builder.buildCsr();
+    CscMatrix<T> csc = builder.buildCsc();
+    auto ublasMatrix = csr.toUblas();
+
+    ThreadPool pool{4};
+    for (std::size_t k : {1, 3})
+    {
+        std::vector<T> x(columns * k);
+        for (T& value : x) value = randomValue<T>(engine);
+
+        // Reference: the dense product of the uBLAS copy, column by column
+        std::vector<T> expected(rows * k);
+        for (std::size_t c = 0; c < k; ++c)
+        {
+            boost::numeric::ublas::vector<T> column(columns);
+            for (std::size_t j = 0; j < columns; ++j) column(j) = x[j * k + c];
+            boost::numeric::ublas::vector<T> product = boost::numeric::ublas::prod(ublasMatrix, column);
+            for (std::size_t i = 0; i < rows; ++i) expected[i * k + c] = product(i);
+        }
+
+        for (bool simd : {false, true})
+        {
+            SparseKernels<T>::enableSimd(simd);
+            for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool})
+            {
+                std::vector<T> y(rows * k, T{7});
+                csr.multiply(x, k, y, threads);
+                assert(close(y, expected));
+
+                std::fill(y.begin(), y.end(), T{7});
+                csc.multiply(x, k, y, threads);
+                assert(close(y, expected));
+            }
+        }
+        SparseKernels<T>::enableSimd(true);
+    }
+
+    bool thrown = false;
+    std::vector<T> y(rows);
+    try { csr.multiply(std::vector<T>(rows), y); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// Milliseconds, GB/s and GFLOP/s of y = A x (or Y = A X with k columns)
+template<typename Product>
+void report(const std::string& name, std::size_t nonZeros, std::size_t bytes, std::size_t flopsPerNonZero, Product&& product)
+{
+    product();
+    constexpr int REPEATS = 10;
+    StopWatch stopWatch;
+    stopWatch.Start();
+    for (int i = 0; i < REPEATS; ++i) product();
+    stopWatch.Stop();
+    double seconds = stopWatch.ElapsedTime() / REPEATS;
+    std::cout << name << "\t" << 1e3 * seconds << "\t\t" << 1e-9 * static_cast<double>(bytes) / seconds << "\t\t"
+              << 1e-9 * static_cast<double>(nonZeros * flopsPerNonZero) / seconds << std::endl;
+}
+
+// uBLAS is only timed on small matrices: its sparse products take time quadratic in the number of rows
+template<typename T>
+void benchmark_Multiply(const std::string& type, std::size_t rows, std::size_t averagePerRow, bool withUblas)
+{
+    std::mt19937_64 engine{7};
+    CooBuilder<T> builder = randomMatrix<T>(rows, rows, averagePerRow, engine);
+    CsrMatrix<T> csr = builder.buildCsr();
+    builder.clear();
+    CscMatrix<T> csc = csr.convert();
+    auto ublasMatrix = csr.toUblas();
+    ThreadPool pool;
+
+    // Every non-zero streams its value and index; x, y and the pointers are read or written once
+    const std::size_t nonZeros = csr.nonZeros();
+    const std::size_t bytes = nonZeros * (sizeof(T) + sizeof(std::uint32_t)) + (rows + 1) * sizeof(std::size_t) + 2 * rows * sizeof(T);
+    const std::size_t flops = std::is_same_v<T, double> ? 2 : 8;
+    std::cout << type << ": " << rows << " x " << rows << ", " << nonZeros << " non-zeros, " << pool.size() << " threads" << std::endl;
+    std::cout << "SpMV\t\t\tms\t\tGB/s\t\tGFLOP/s" << std::endl;
+
+    std::vector<T> x(rows);
+    for (T& value : x) value = randomValue<T>(engine);
+    std::vector<T> y(rows);
+    boost::numeric::ublas::vector<T> ublasX(rows);
+    std::copy(x.begin(), x.end(), ublasX.begin());
+    boost::numeric::ublas::vector<T> ublasY(rows);
+
+    if (withUblas)
+    {
+        report("uBLAS compressed\t", nonZeros, bytes, flops, [&]
+        {
+            boost::numeric::ublas::axpy_prod(ublasMatrix, ublasX, ublasY, true);
+            sink += std::abs(ublasY(0));
+        });
+    }
+
+    SparseKernels<T>::enableSimd(false);
+    report("CSR scalar\t\t", nonZeros, bytes, flops, [&] { csr.multiply(x, y); sink += std::abs(y[0]); });
+    SparseKernels<T>::enableSimd(true);
+    if (SparseKernels<T>::simdEnabled())
+    {
+        report("CSR AVX2\t\t", nonZeros, bytes, flops, [&] { csr.multiply(x, y); sink += std::abs(y[0]); });
+    }
+    report("CSR threads\t\t", nonZeros, bytes, flops, [&] { csr.multiply(x, y, &pool); sink += std::abs(y[0]); });
+    report("CSC\t\t\t", nonZeros, bytes, flops, [&] { csc.multiply(x, y); sink += std::abs(y[0]); });
+    report("CSC threads\t\t", nonZeros, bytes, flops, [&] { csc.multiply(x, y, &pool); sink += std::abs(y[0]); });
+
+    // SpMM reuses every non-zero k times, so it is less bound by bandwidth than SpMV
+    constexpr std::size_t K = 8;
+    std::vector<T> xBlock(rows * K, T{1});
+    std::vector<T> yBlock(rows * K);
+    const std::size_t blockBytes = nonZeros * (sizeof(T) + sizeof(std::uint32_t)) + 2 * K * rows * sizeof(T);
+    report("CSR SpMM k = 8\t\t", nonZeros * K, blockBytes, flops, [&] { csr.multiply(xBlock, K, yBlock, &pool); sink += std::abs(yBlock[0]); });
+}
+
+int main()
+{
+    test_CooBuilder();
+    test_Ublas();
+    test_Multiply<double>();
+    test_Multiply<std::complex<double>>();
+
+    benchmark_Multiply<double>("double", 1 << 12, 8, true);
+    benchmark_Multiply<double>("double", 1 << 20, 8, false);
+    benchmark_Multiply<std::complex<double>>("std::complex<double>", 1 << 12, 8, true);
+    benchmark_Multiply<std::complex<double>>("std::complex<double>", 1 << 19, 8, false);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
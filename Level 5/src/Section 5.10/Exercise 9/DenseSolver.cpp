@@ -0,0 +1,501 @@
+//
+// Cache-blocked LU and Cholesky factorizations and triangular solves with parallel tile updates
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_DENSESOLVER_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_DENSESOLVER_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "DenseSolver.hpp"
+
+/**
+ * Calls function(i) for every i in [0, count), on the pool if there is one
+ * @tparam T The element type
+ * @tparam Function Callable taking a std::size_t
+ * @param count Number of calls
+ * @param pool The thread pool, or nullptr
+ * @param function The function
+ */
+template<typename T>
+template<typename Function>
+void DenseSolver<T>::forEach(std::size_t count, ThreadPool* pool, Function&& function)
+{
+    if (pool != nullptr && count > 1) pool->parallelFor(count, function);
+    else for (std::size_t i = 0; i < count; ++i) function(i);
+}
+
+/**
+ * C -= A B for one tile, with the loop order whose innermost loop walks unit-stride memory: rows of C and B
+ * when C is row-major, columns of C and A when C is column-major. If B (or A) is in the other layout, a tile of
+ * it is first copied into a buffer in the right one, so C -= L21 L21^T is as fast as C -= L21 U12.
+ * @tparam T The element type
+ * @param c An m x n block
+ * @param a An m x k block
+ * @param b A k x n block
+ */
+template<typename T>
+void DenseSolver<T>::multiplySubtract(MatrixView<T> c, MatrixView<const T> a, MatrixView<const T> b)
+{
+    const std::size_t m = c.rows();
+    const std::size_t n = c.columns();
+    const std::size_t k = a.columns();
+    if (m == 0 || n == 0 || k == 0) return;
+
+    T packed[BLOCK * BLOCK];
+    if (c.columnStride() == 1)
+    {
+        if (b.columnStride() != 1 && k * n <= BLOCK * BLOCK)
+        {
+            for (std::size_t p = 0; p < k; ++p)
+            {
+                for (std::size_t j = 0; j < n; ++j) packed[p * n + j] = b(p, j);
+            }
+            b = MatrixView<const T>{packed, k, n, static_cast<std::ptrdiff_t>(n), 1};
+        }
+        if (b.columnStride() == 1)
+        {
+            for (std::size_t i = 0; i < m; ++i)
+            {
+                T* __restrict target = &c(i, 0);
+                for (std::size_t p = 0; p < k; ++p)
+                {
+                    const T factor = a(i, p);
+                    const T* __restrict source = &b(p, 0);
+                    for (std::size_t j = 0; j < n; ++j) target[j] -= factor * source[j];
+                }
+            }
+            return;
+        }
+    }
+    if (c.rowStride() == 1)
+    {
+        if (a.rowStride() != 1 && m * k <= BLOCK * BLOCK)
+        {
+            for (std::size_t p = 0; p < k; ++p)
+            {
+                for (std::size_t i = 0; i < m; ++i) packed[p * m + i] = a(i, p);
+            }
+            a = MatrixView<const T>{packed, m, k, 1, static_cast<std::ptrdiff_t>(m)};
+        }
+        if (a.rowStride() == 1)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                T* __restrict target = &c(0, j);
+                for (std::size_t p = 0; p < k; ++p)
+                {
+                    const T factor = b(p, j);
+                    const T* __restrict source = &a(0, p);
+                    for (std::size_t i = 0; i < m; ++i) target[i] -= source[i] * factor;
+                }
+            }
+            return;
+        }
+    }
+
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            T sum{};
+            for (std::size_t p = 0; p < k; ++p) sum += a(i, p) * b(p, j);
+            c(i, j) -= sum;
+        }
+    }
+}
+
+/**
+ * C -= A B, cut into BLOCK x BLOCK tiles of C that are updated in parallel
+ * @tparam T The element type
+ * @param c An m x n block
+ * @param a An m x k block
+ * @param b A k x n block
+ * @param lowerOnly Only update the tiles on and below the diagonal of a square C
+ * @param pool The thread pool, or nullptr
+ */
+template<typename T>
+void DenseSolver<T>::updateTiles(MatrixView<T> c, MatrixView<const T> a, MatrixView<const T> b, bool lowerOnly,
+                                 ThreadPool* pool)
+{
+    const std::size_t tileRows = (c.rows() + BLOCK - 1) / BLOCK;
+    const std::size_t tileColumns = (c.columns() + BLOCK - 1) / BLOCK;
+    auto tile = [&](std::size_t row, std::size_t column)
+    {
+        const std::size_t first = row * BLOCK;
+        const std::size_t rows = std::min(BLOCK, c.rows() - first);
+        const std::size_t start = column * BLOCK;
+        const std::size_t columns = std::min(BLOCK, c.columns() - start);
+        multiplySubtract(c.block(first, start, rows, columns), a.block(first, 0, rows, a.columns()),
+                         b.block(0, start, b.rows(), columns));
+    };
+
+    if (lowerOnly)
+    {
+        forEach(tileRows, pool, [&](std::size_t row)
+        {
+            for (std::size_t column = 0; column <= row && column < tileColumns; ++column) tile(row, column);
+        });
+    }
+    else
+    {
+        forEach(tileRows * tileColumns, pool, [&](std::size_t index) { tile(index / tileColumns, index % tileColumns); });
+    }
+}
+
+/**
+ * Forward substitution L X = B for one diagonal block, overwriting B with X. Row-major right-hand sides are
+ * updated a row at a time, column-major ones a column at a time.
+ * @tparam T The element type
+ * @param l A lower triangular block
+ * @param b The right-hand sides
+ * @param unitDiagonal Take the diagonal of L as ones
+ * @throws std::domain_error if a diagonal element is zero
+ */
+template<typename T>
+void DenseSolver<T>::solveLowerBlock(MatrixView<const T> l, MatrixView<T> b, bool unitDiagonal)
+{
+    const std::size_t n = l.rows();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!unitDiagonal && l(i, i) == T{}) throw std::domain_error("Triangular matrix is singular at row " + std::to_string(i));
+    }
+
+    if (b.rowStride() == 1 && b.columnStride() != 1)
+    {
+        for (std::size_t j = 0; j < b.columns(); ++j)
+        {
+            T* __restrict x = &b(0, j);
+            for (std::size_t p = 0; p < n; ++p)
+            {
+                if (!unitDiagonal) x[p] /= l(p, p);
+                const T value = x[p];
+                for (std::size_t i = p + 1; i < n; ++i) x[i] -= l(i, p) * value;
+            }
+        }
+        return;
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t p = 0; p < i; ++p)
+        {
+            const T factor = l(i, p);
+            for (std::size_t j = 0; j < b.columns(); ++j) b(i, j) -= factor * b(p, j);
+        }
+        if (!unitDiagonal)
+        {
+            const T diagonal = l(i, i);
+            for (std::size_t j = 0; j < b.columns(); ++j) b(i, j) /= diagonal;
+        }
+    }
+}
+
+/**
+ * Back substitution U X = B for one diagonal block, overwriting B with X. Row-major right-hand sides are
+ * updated a row at a time, column-major ones a column at a time.
+ * @tparam T The element type
+ * @param u An upper triangular block
+ * @param b The right-hand sides
+ * @param unitDiagonal Take the diagonal of U as ones
+ * @throws std::domain_error if a diagonal element is zero
+ */
+template<typename T>
+void DenseSolver<T>::solveUpperBlock(MatrixView<const T> u, MatrixView<T> b, bool unitDiagonal)
+{
+    const std::size_t n = u.rows();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!unitDiagonal && u(i, i) == T{}) throw std::domain_error("Triangular matrix is singular at row " + std::to_string(i));
+    }
+
+    if (b.rowStride() == 1 && b.columnStride() != 1)
+    {
+        for (std::size_t j = 0; j < b.columns(); ++j)
+        {
+            T* __restrict x = &b(0, j);
+            for (std::size_t p = n; p-- > 0;)
+            {
+                if (!unitDiagonal) x[p] /= u(p, p);
+                const T value = x[p];
+                for (std::size_t i = 0; i < p; ++i) x[i] -= u(i, p) * value;
+            }
+        }
+        return;
+    }
+
+    for (std::size_t i = n; i-- > 0;)
+    {
+        for (std::size_t p = i + 1; p < n; ++p)
+        {
+            const T factor = u(i, p);
+            for (std::size_t j = 0; j < b.columns(); ++j) b(i, j) -= factor * b(p, j);
+        }
+        if (!unitDiagonal)
+        {
+            const T diagonal = u(i, i);
+            for (std::size_t j = 0; j < b.columns(); ++j) b(i, j) /= diagonal;
+        }
+    }
+}
+
+/**
+ * Solves a diagonal block against all right-hand sides, BLOCK columns of them per task
+ * @tparam T The element type
+ * @param triangle The diagonal block
+ * @param b The right-hand sides
+ * @param lower True for forward, false for back substitution
+ * @param unitDiagonal Take the diagonal as ones
+ * @param pool The thread pool, or nullptr
+ */
+template<typename T>
+void DenseSolver<T>::solveColumns(MatrixView<const T> triangle, MatrixView<T> b, bool lower, bool unitDiagonal,
+                                  ThreadPool* pool)
+{
+    forEach((b.columns() + BLOCK - 1) / BLOCK, pool, [&](std::size_t part)
+    {
+        const std::size_t first = part * BLOCK;
+        MatrixView<T> columns = b.block(0, first, b.rows(), std::min(BLOCK, b.columns() - first));
+        if (lower) solveLowerBlock(triangle, columns, unitDiagonal);
+        else solveUpperBlock(triangle, columns, unitDiagonal);
+    });
+}
+
+/**
+ * LU factorization with partial pivoting, PA = LU, in place. Each panel of BLOCK columns is factored
+ * column by column (swapping whole rows), then U12 = L11^-1 A12 and the trailing update A22 -= L21 U12.
+ * @tparam T The element type
+ * @param a A square matrix; overwritten by L below the diagonal (unit diagonal implied) and U on and above it
+ * @param pool Runs the triangular solves and trailing updates in parallel if given
+ * @return The pivots: row k was swapped with row pivots[k] >= k, as in a uBLAS permutation_matrix
+ * @throws std::invalid_argument if a is not square
+ * @throws std::domain_error if a is singular
+ */
+template<typename T>
+std::vector<std::size_t> DenseSolver<T>::luFactorize(MatrixView<T> a, ThreadPool* pool)
+{
+    const std::size_t n = a.rows();
+    if (a.columns() != n)
+    {
+        throw std::invalid_argument("LU needs a square matrix, got " + std::to_string(n) + " x " + std::to_string(a.columns()));
+    }
+
+    std::vector<std::size_t> pivots(n);
+    for (std::size_t k0 = 0; k0 < n; k0 += BLOCK)
+    {
+        const std::size_t kb = std::min(BLOCK, n - k0);
+        const std::size_t panelEnd = k0 + kb;
+
+        for (std::size_t j = k0; j < panelEnd; ++j)
+        {
+            std::size_t pivot = j;
+            for (std::size_t i = j + 1; i < n; ++i)
+            {
+                if (std::abs(a(i, j)) > std::abs(a(pivot, j))) pivot = i;
+            }
+            if (a(pivot, j) == T{}) throw std::domain_error("Matrix is singular at column " + std::to_string(j));
+
+            pivots[j] = pivot;
+            if (pivot != j)
+            {
+                for (std::size_t column = 0; column < n; ++column) std::swap(a(j, column), a(pivot, column));
+            }
+
+            // Scale the column below the pivot, then update the rest of the panel along its unit stride
+            const T inverse = T{1} / a(j, j);
+            for (std::size_t i = j + 1; i < n; ++i) a(i, j) *= inverse;
+            if (a.rowStride() == 1)
+            {
+                for (std::size_t column = j + 1; column < panelEnd; ++column)
+                {
+                    const T factor = a(j, column);
+                    for (std::size_t i = j + 1; i < n; ++i) a(i, column) -= a(i, j) * factor;
+                }
+            }
+            else
+            {
+                for (std::size_t i = j + 1; i < n; ++i)
+                {
+                    const T factor = a(i, j);
+                    for (std::size_t column = j + 1; column < panelEnd; ++column) a(i, column) -= factor * a(j, column);
+                }
+            }
+        }
+
+        const std::size_t rest = n - panelEnd;
+        if (rest == 0) continue;
+
+        MatrixView<T> right = a.block(k0, panelEnd, kb, rest);
+        solveColumns(a.block(k0, k0, kb, kb), right, true, true, pool);
+        updateTiles(a.block(panelEnd, panelEnd, rest, rest), a.block(panelEnd, k0, rest, kb), right, false, pool);
+    }
+    return pivots;
+}
+
+/**
+ * Solves A X = B given the LU factorization of A, overwriting B with X
+ * @tparam T The element type
+ * @param lu The output of luFactorize()
+ * @param pivots The pivots returned by luFactorize()
+ * @param b The right-hand sides, one per column
+ * @param pool Runs the solves in parallel if given
+ * @throws std::invalid_argument if the sizes do not match
+ */
+template<typename T>
+void DenseSolver<T>::luSolve(MatrixView<const T> lu, const std::vector<std::size_t>& pivots, MatrixView<T> b,
+                             ThreadPool* pool)
+{
+    if (pivots.size() != lu.rows())
+    {
+        throw std::invalid_argument("Expected " + std::to_string(lu.rows()) + " pivots, got " + std::to_string(pivots.size()));
+    }
+    if (b.rows() != lu.rows())
+    {
+        throw std::invalid_argument("Right-hand sides have " + std::to_string(b.rows()) + " rows, expected " + std::to_string(lu.rows()));
+    }
+
+    for (std::size_t k = 0; k < pivots.size(); ++k)
+    {
+        if (pivots[k] == k) continue;
+        for (std::size_t column = 0; column < b.columns(); ++column) std::swap(b(k, column), b(pivots[k], column));
+    }
+    solveLower(lu, b, true, pool);
+    solveUpper(lu, b, false, pool);
+}
+
+/**
+ * Cholesky factorization A = L L^T, in place. Only the lower triangle of A is read. Each panel's diagonal
+ * block is factored, the block column below it is solved against it (L21 = A21 L11^-T), and the lower tiles
+ * of the trailing matrix are updated with A22 -= L21 L21^T.
+ * @tparam T The element type
+ * @param a A symmetric positive definite matrix; overwritten by L, with zeros above the diagonal
+ * @param pool Runs the solves and trailing updates in parallel if given
+ * @throws std::invalid_argument if a is not square
+ * @throws std::domain_error if a is not positive definite
+ */
+template<typename T>
+void DenseSolver<T>::choleskyFactorize(MatrixView<T> a, ThreadPool* pool)
+{
+    const std::size_t n = a.rows();
+    if (a.columns() != n)
+    {
+        throw std::invalid_argument("Cholesky needs a square matrix, got " + std::to_string(n) + " x " + std::to_string(a.columns()));
+    }
+
+    for (std::size_t k0 = 0; k0 < n; k0 += BLOCK)
+    {
+        const std::size_t kb = std::min(BLOCK, n - k0);
+        const std::size_t panelEnd = k0 + kb;
+
+        for (std::size_t j = k0; j < panelEnd; ++j)
+        {
+            if (!(a(j, j) > T{})) throw std::domain_error("Matrix is not positive definite at column " + std::to_string(j));
+
+            const T diagonal = a(j, j) = std::sqrt(a(j, j));
+            for (std::size_t i = j + 1; i < panelEnd; ++i) a(i, j) /= diagonal;
+            for (std::size_t column = j + 1; column < panelEnd; ++column)
+            {
+                for (std::size_t i = column; i < panelEnd; ++i) a(i, column) -= a(i, j) * a(column, j);
+            }
+        }
+
+        const std::size_t rest = n - panelEnd;
+        if (rest == 0) continue;
+
+        // X L11^T = A21 is L11 X^T = A21^T, a forward substitution on the transposed view
+        MatrixView<T> below = a.block(panelEnd, k0, rest, kb);
+        solveColumns(a.block(k0, k0, kb, kb), below.transposed(), true, false, pool);
+        updateTiles(a.block(panelEnd, panelEnd, rest, rest), below, below.transposed(), true, pool);
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = i + 1; j < n; ++j) a(i, j) = T{};
+    }
+}
+
+/**
+ * Solves A X = B given the Cholesky factor of A, overwriting B with X
+ * @tparam T The element type
+ * @param l The output of choleskyFactorize()
+ * @param b The right-hand sides, one per column
+ * @param pool Runs the solves in parallel if given
+ * @throws std::invalid_argument if the sizes do not match
+ */
+template<typename T>
+void DenseSolver<T>::choleskySolve(MatrixView<const T> l, MatrixView<T> b, ThreadPool* pool)
+{
+    solveLower(l, b, false, pool);
+    solveUpper(l.transposed(), b, false, pool);
+}
+
+/**
+ * Blocked forward substitution L X = B, overwriting B with X. Only the lower triangle of L is read.
+ * @tparam T The element type
+ * @param l A square lower triangular matrix
+ * @param b The right-hand sides, one per column
+ * @param unitDiagonal Take the diagonal of L as ones
+ * @param pool Runs the substitution in parallel if given
+ * @throws std::invalid_argument if the sizes do not match
+ * @throws std::domain_error if a diagonal element is zero
+ */
+template<typename T>
+void DenseSolver<T>::solveLower(MatrixView<const T> l, MatrixView<T> b, bool unitDiagonal, ThreadPool* pool)
+{
+    const std::size_t n = l.rows();
+    if (l.columns() != n || b.rows() != n)
+    {
+        throw std::invalid_argument("Cannot solve a " + std::to_string(n) + " x " + std::to_string(l.columns()) +
+                                    " system for " + std::to_string(b.rows()) + " rows");
+    }
+
+    for (std::size_t k0 = 0; k0 < n; k0 += BLOCK)
+    {
+        const std::size_t kb = std::min(BLOCK, n - k0);
+        MatrixView<T> solved = b.block(k0, 0, kb, b.columns());
+        solveColumns(l.block(k0, k0, kb, kb), solved, true, unitDiagonal, pool);
+
+        const std::size_t rest = n - k0 - kb;
+        if (rest > 0) updateTiles(b.block(k0 + kb, 0, rest, b.columns()), l.block(k0 + kb, k0, rest, kb), solved, false, pool);
+    }
+}
+
+/**
+ * Blocked back substitution U X = B, overwriting B with X. Only the upper triangle of U is read.
+ * @tparam T The element type
+ * @param u A square upper triangular matrix
+ * @param b The right-hand sides, one per column
+ * @param unitDiagonal Take the diagonal of U as ones
+ * @param pool Runs the substitution in parallel if given
+ * @throws std::invalid_argument if the sizes do not match
+ * @throws std::domain_error if a diagonal element is zero
+ */
+template<typename T>
+void DenseSolver<T>::solveUpper(MatrixView<const T> u, MatrixView<T> b, bool unitDiagonal, ThreadPool* pool)
+{
+    const std::size_t n = u.rows();
+    if (u.columns() != n || b.rows() != n)
+    {
+        throw std::invalid_argument("Cannot solve a " + std::to_string(n) + " x " + std::to_string(u.columns()) +
+                                    " system for " + std::to_string(b.rows()) + " rows");
+    }
+
+    for (std::size_t end = n; end > 0;)
+    {
+        const std::size_t k0 = (end - 1) / BLOCK * BLOCK;
+        const std::size_t kb = end - k0;
+        MatrixView<T> solved = b.block(k0, 0, kb, b.columns());
+        solveColumns(u.block(k0, k0, kb, kb), solved, false, unitDiagonal, pool);
+
+        if (k0 > 0) updateTiles(b.block(0, 0, k0, b.columns()), u.block(0, k0, k0, kb), solved, false, pool);
+        end = k0;
+    }
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_DENSESOLVER_CPP
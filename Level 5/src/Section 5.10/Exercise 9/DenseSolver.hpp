@@ -0,0 +1,66 @@
+//
+// Cache-blocked dense factorizations and triangular solves on MatrixViews, so they run in place on
+// row-major and column-major uBLAS matrices alike:
+//
+//  - luFactorize: PA = LU with partial pivoting, L unit lower and U upper stored over A. The pivots follow
+//    uBLAS's permutation_matrix after lu_factorize: row k was swapped with row pivots[k].
+//  - choleskyFactorize: A = L L^T for a symmetric positive definite A, L stored over the lower triangle.
+//  - solveLower / solveUpper: forward and back substitution for a block of right-hand sides.
+//  - luSolve / choleskySolve: both substitutions, overwriting the right-hand sides with the solution.
+//
+// The factorizations are right-looking and work on panels of BLOCK columns: the panel is factored, the
+// block row to its right is solved against it, and the trailing matrix is updated with a product of two
+// thin blocks. That update holds almost all the arithmetic; it is cut into BLOCK x BLOCK tiles that stay in
+// cache and, given a ThreadPool, are updated in parallel. Each tile uses the loop order whose inner loop runs
+// over unit-stride memory for the layouts involved.
+//
+// Tridiagonal systems have their own O(n) solver, TridiagonalSolver.
+// The operations are static functions because DenseSolver has no state.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_DENSESOLVER_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_DENSESOLVER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "MatrixView.hpp"
+#include "ThreadPool.hpp"
+
+template<typename T>
+class DenseSolver
+{
+private:
+    template<typename Function>
+    static void forEach(std::size_t count, ThreadPool* pool, Function&& function);
+
+    static void multiplySubtract(MatrixView<T> c, MatrixView<const T> a, MatrixView<const T> b);
+    static void updateTiles(MatrixView<T> c, MatrixView<const T> a, MatrixView<const T> b, bool lowerOnly,
+                            ThreadPool* pool);
+    static void solveLowerBlock(MatrixView<const T> l, MatrixView<T> b, bool unitDiagonal);
+    static void solveUpperBlock(MatrixView<const T> u, MatrixView<T> b, bool unitDiagonal);
+    static void solveColumns(MatrixView<const T> triangle, MatrixView<T> b, bool lower, bool unitDiagonal,
+                             ThreadPool* pool);
+
+public:
+    // Panel width and tile size; three tiles of doubles fit in a 256 KB L2 cache
+    static constexpr std::size_t BLOCK = 64;
+
+    // Core Functionality
+    static std::vector<std::size_t> luFactorize(MatrixView<T> a, ThreadPool* pool = nullptr);
+    static void luSolve(MatrixView<const T> lu, const std::vector<std::size_t>& pivots, MatrixView<T> b,
+                        ThreadPool* pool = nullptr);
+    static void choleskyFactorize(MatrixView<T> a, ThreadPool* pool = nullptr);
+    static void choleskySolve(MatrixView<const T> l, MatrixView<T> b, ThreadPool* pool = nullptr);
+    static void solveLower(MatrixView<const T> l, MatrixView<T> b, bool unitDiagonal = false, ThreadPool* pool = nullptr);
+    static void solveUpper(MatrixView<const T> u, MatrixView<T> b, bool unitDiagonal = false, ThreadPool* pool = nullptr);
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_DENSESOLVER_CPP
+#include "DenseSolver.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_DENSESOLVER_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_DENSESOLVER_HPP
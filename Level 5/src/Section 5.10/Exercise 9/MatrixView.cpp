@@ -0,0 +1,109 @@
+//
+// A non-owning strided view of a row-major or column-major dense matrix
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_MATRIXVIEW_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_MATRIXVIEW_CPP
+
+#include <stdexcept>
+#include <string>
+
+#include "MatrixView.hpp"
+
+/**
+ * Overloaded ctor
+ * @tparam T The element type, const for a read-only view
+ * @param data The element (0, 0)
+ * @param rows Number of rows
+ * @param columns Number of columns
+ * @param rowStride Distance in elements from (i, j) to (i + 1, j)
+ * @param columnStride Distance in elements from (i, j) to (i, j + 1)
+ */
+template<typename T>
+MatrixView<T>::MatrixView(T* data, std::size_t rows, std::size_t columns, std::ptrdiff_t rowStride,
+                          std::ptrdiff_t columnStride)
+    : first{data}, rowCount{rows}, columnCount{columns}, rowStep{rowStride}, columnStep{columnStride}
+{
+}
+
+/**
+ * Converting ctor: a read-only view of a mutable view
+ * @tparam T The element type, const
+ * @tparam U The element type of the other view
+ * @param other The mutable view
+ */
+template<typename T>
+template<typename U> requires std::is_same_v<const U, T>
+MatrixView<T>::MatrixView(const MatrixView<U>& other)
+    : MatrixView(other.data(), other.rows(), other.columns(), other.rowStride(), other.columnStride())
+{
+}
+
+/**
+ * Overloaded ctor: a view of a uBLAS matrix in either layout
+ * @tparam T The element type
+ * @tparam Layout row_major or column_major
+ * @tparam Storage The matrix's storage array
+ * @param matrix The matrix
+ */
+template<typename T>
+template<typename Layout, typename Storage>
+MatrixView<T>::MatrixView(boost::numeric::ublas::matrix<value_type, Layout, Storage>& matrix) requires (!std::is_const_v<T>)
+    : MatrixView(matrix.data().begin(), matrix.size1(), matrix.size2(),
+                 std::is_same_v<typename Layout::orientation_category, boost::numeric::ublas::row_major_tag> ? static_cast<std::ptrdiff_t>(matrix.size2()) : 1,
+                 std::is_same_v<typename Layout::orientation_category, boost::numeric::ublas::row_major_tag> ? 1 : static_cast<std::ptrdiff_t>(matrix.size1()))
+{
+}
+
+/**
+ * Overloaded ctor: a read-only view of a uBLAS matrix in either layout
+ * @tparam T The element type, const
+ * @tparam Layout row_major or column_major
+ * @tparam Storage The matrix's storage array
+ * @param matrix The matrix
+ */
+template<typename T>
+template<typename Layout, typename Storage>
+MatrixView<T>::MatrixView(const boost::numeric::ublas::matrix<value_type, Layout, Storage>& matrix) requires std::is_const_v<T>
+    : MatrixView(matrix.data().begin(), matrix.size1(), matrix.size2(),
+                 std::is_same_v<typename Layout::orientation_category, boost::numeric::ublas::row_major_tag> ? static_cast<std::ptrdiff_t>(matrix.size2()) : 1,
+                 std::is_same_v<typename Layout::orientation_category, boost::numeric::ublas::row_major_tag> ? 1 : static_cast<std::ptrdiff_t>(matrix.size1()))
+{
+}
+
+/**
+ * A view of a rectangular block of this view
+ * @tparam T The element type
+ * @param row The first row of the block
+ * @param column The first column of the block
+ * @param rows Number of rows of the block
+ * @param columns Number of columns of the block
+ * @return The block
+ * @throws std::out_of_range if the block does not fit in the view
+ */
+template<typename T>
+MatrixView<T> MatrixView<T>::block(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns) const
+{
+    if (row + rows > rowCount || column + columns > columnCount)
+    {
+        throw std::out_of_range("Block of " + std::to_string(rows) + " x " + std::to_string(columns) + " at (" +
+                                std::to_string(row) + ", " + std::to_string(column) + ") exceeds a " +
+                                std::to_string(rowCount) + " x " + std::to_string(columnCount) + " view");
+    }
+    T* start = rows == 0 || columns == 0 ? first : &(*this)(row, column);
+    return MatrixView{start, rows, columns, rowStep, columnStep};
+}
+
+/**
+ * @tparam T The element type
+ * @return The transpose, viewing the same elements
+ */
+template<typename T>
+MatrixView<T> MatrixView<T>::transposed() const noexcept
+{
+    return MatrixView{first, columnCount, rowCount, columnStep, rowStep};
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_MATRIXVIEW_CPP
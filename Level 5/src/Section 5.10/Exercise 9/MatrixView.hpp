@@ -0,0 +1,67 @@
+//
+// A non-owning view of a dense matrix: a pointer to the first element, the extents, and the distance
+// between consecutive rows and columns. A row-major matrix has column stride 1, a column-major matrix row
+// stride 1, so the same factorization code runs on both. Blocks and the transpose are views of the same
+// storage, made in O(1). MatrixView<const T> is the read-only view; a MatrixView<T> converts to it.
+//
+// Element access does not check its indices; block() does.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_MATRIXVIEW_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_MATRIXVIEW_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include <boost/numeric/ublas/matrix.hpp>
+
+template<typename T>
+class MatrixView
+{
+private:
+    T* first;
+    std::size_t rowCount;
+    std::size_t columnCount;
+    std::ptrdiff_t rowStep;
+    std::ptrdiff_t columnStep;
+
+public:
+    using value_type = std::remove_const_t<T>;
+
+    MatrixView(T* data, std::size_t rows, std::size_t columns, std::ptrdiff_t rowStride, std::ptrdiff_t columnStride);
+    template<typename U> requires std::is_same_v<const U, T>
+    MatrixView(const MatrixView<U>& other);
+    template<typename Layout, typename Storage>
+    MatrixView(boost::numeric::ublas::matrix<value_type, Layout, Storage>& matrix) requires (!std::is_const_v<T>);
+    template<typename Layout, typename Storage>
+    MatrixView(const boost::numeric::ublas::matrix<value_type, Layout, Storage>& matrix) requires std::is_const_v<T>;
+    MatrixView(const MatrixView& other) = default;
+    ~MatrixView() = default;
+
+    // Operator Overloads
+    MatrixView& operator=(const MatrixView& other) = default;
+    T& operator()(std::size_t row, std::size_t column) const noexcept
+    {
+        return first[static_cast<std::ptrdiff_t>(row) * rowStep + static_cast<std::ptrdiff_t>(column) * columnStep];
+    }
+
+    // Accessors
+    T* data() const noexcept { return first; }
+    std::size_t rows() const noexcept { return rowCount; }
+    std::size_t columns() const noexcept { return columnCount; }
+    std::ptrdiff_t rowStride() const noexcept { return rowStep; }
+    std::ptrdiff_t columnStride() const noexcept { return columnStep; }
+
+    // Core Functionality
+    MatrixView block(std::size_t row, std::size_t column, std::size_t rows, std::size_t columns) const;
+    MatrixView transposed() const noexcept;
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_MATRIXVIEW_CPP
+#include "MatrixView.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_MATRIXVIEW_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_MATRIXVIEW_HPP
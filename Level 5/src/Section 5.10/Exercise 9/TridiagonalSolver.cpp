@@ -0,0 +1,67 @@
+//
+// The Thomas algorithm: an O(n) solver for tridiagonal systems, factored once and solved many times
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TRIDIAGONALSOLVER_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_TRIDIAGONALSOLVER_CPP
+
+#include <stdexcept>
+#include <string>
+
+#include "TridiagonalSolver.hpp"
+
+/**
+ * Overloaded ctor: factors the matrix
+ * @tparam T The element type
+ * @param subDiagonal The n - 1 elements below the diagonal
+ * @param diagonal The n diagonal elements
+ * @param superDiagonal The n - 1 elements above the diagonal
+ * @throws std::invalid_argument if the sizes do not match
+ * @throws std::domain_error if a pivot is zero
+ */
+template<typename T>
+TridiagonalSolver<T>::TridiagonalSolver(const std::vector<T>& subDiagonal, const std::vector<T>& diagonal,
+                                        const std::vector<T>& superDiagonal)
+    : lower{subDiagonal}, factors(diagonal.size()), inverses(diagonal.size())
+{
+    const std::size_t n = diagonal.size();
+    if (n == 0 || subDiagonal.size() != n - 1 || superDiagonal.size() != n - 1)
+    {
+        throw std::invalid_argument("Expected diagonals of n - 1, n and n - 1 elements, got " +
+                                    std::to_string(subDiagonal.size()) + ", " + std::to_string(n) + " and " +
+                                    std::to_string(superDiagonal.size()));
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const T pivot = i == 0 ? diagonal[0] : diagonal[i] - lower[i - 1] * factors[i - 1];
+        if (pivot == T{}) throw std::domain_error("Zero pivot in row " + std::to_string(i));
+
+        inverses[i] = T{1} / pivot;
+        factors[i] = i + 1 < n ? superDiagonal[i] * inverses[i] : T{};
+    }
+}
+
+/**
+ * Solves the system in place with a forward and a backward sweep
+ * @tparam T The element type
+ * @param values The right-hand side; overwritten by the solution
+ * @throws std::invalid_argument if values does not have size() elements
+ */
+template<typename T>
+void TridiagonalSolver<T>::solve(std::span<T> values) const
+{
+    const std::size_t n = inverses.size();
+    if (values.size() != n)
+    {
+        throw std::invalid_argument("Expected " + std::to_string(n) + " values, got " + std::to_string(values.size()));
+    }
+
+    values[0] *= inverses[0];
+    for (std::size_t i = 1; i < n; ++i) values[i] = (values[i] - lower[i - 1] * values[i - 1]) * inverses[i];
+    for (std::size_t i = n - 1; i-- > 0;) values[i] -= factors[i] * values[i + 1];
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_TRIDIAGONALSOLVER_CPP
@@ -0,0 +1,48 @@
+//
+// The Thomas algorithm for tridiagonal systems, as they come out of implicit finite difference schemes
+// (e.g. Crank-Nicolson for the heat equation). The matrix is factored once in the ctor; every solve() is
+// then one forward and one backward sweep over the right-hand side, in place: O(n) with no allocation, so a
+// time-stepping loop can call it every step. There is no pivoting, which is stable for the diagonally
+// dominant matrices these schemes produce.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TRIDIAGONALSOLVER_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_TRIDIAGONALSOLVER_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+template<typename T>
+class TridiagonalSolver
+{
+private:
+    std::vector<T> lower;       // Sub-diagonal, a[i] in row i + 1
+    std::vector<T> factors;     // Upper diagonal of the normalised upper factor
+    std::vector<T> inverses;    // Reciprocals of the pivots
+
+public:
+    TridiagonalSolver(const std::vector<T>& subDiagonal, const std::vector<T>& diagonal, const std::vector<T>& superDiagonal);
+    TridiagonalSolver(const TridiagonalSolver& other) = default;
+    TridiagonalSolver(TridiagonalSolver&& other) noexcept = default;
+    ~TridiagonalSolver() = default;
+
+    // Operator Overloads
+    TridiagonalSolver& operator=(const TridiagonalSolver& other) = default;
+    TridiagonalSolver& operator=(TridiagonalSolver&& other) noexcept = default;
+
+    // Accessors
+    std::size_t size() const noexcept { return inverses.size(); }
+
+    // Core Functionality
+    void solve(std::span<T> values) const;
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TRIDIAGONALSOLVER_CPP
+#include "TridiagonalSolver.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_TRIDIAGONALSOLVER_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_TRIDIAGONALSOLVER_HPP
@@ -0,0 +1,403 @@
+//
+// Tests the blocked LU and Cholesky factorizations, the triangular solves and the tridiagonal solver on
+// row-major and column-major uBLAS matrices: LU against uBLAS lu_factorize/lu_substitute (same pivots, same
+// factors), Cholesky and the solves by multiplying back, and the Thomas solver on Crank-Nicolson steps of
+// the heat equation. Benchmarks report GFLOP/s next to uBLAS.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+
+#include "DenseSolver.hpp"
+#include "MatrixView.hpp"
+#include "StopWatch.hpp"
+#include "ThreadPool.hpp"
+#include "TridiagonalSolver.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+double sink = 0;
+
+template<typename Layout>
+ublas::matrix<double, Layout> randomMatrix(std::size_t rows, std::size_t columns, std::mt19937_64& engine)
+{
+    std::uniform_real_distribution<double> distribution{-1.0, 1.0};
+    ublas::matrix<double, Layout> matrix(rows, columns);
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        for (std::size_t j = 0; j < columns; ++j) matrix(i, j) = distribution(engine);
+    }
+    return matrix;
+}
+
+// M M^T + n I is symmetric positive definite
+template<typename Layout>
+ublas::matrix<double, Layout> randomSpd(std::size_t n, std::mt19937_64& engine)
+{
+    ublas::matrix<double, Layout> m = randomMatrix<Layout>(n, n, engine);
+    ublas::matrix<double, Layout> spd = ublas::prod(m, ublas::trans(m));
+    for (std::size_t i = 0; i < n; ++i) spd(i, i) += static_cast<double>(n);
+    return spd;
+}
+
+template<typename Matrix, typename Other>
+double maxDifference(const Matrix& lhs, const Other& rhs)
+{
+    double difference = 0;
+    for (std::size_t i = 0; i < lhs.size1(); ++i)
+    {
+        for (std::size_t j = 0; j < lhs.size2(); ++j) difference = std::max(difference, std::abs(lhs(i, j) - rhs(i, j)));
+    }
+    return difference;
+}
+
+// Views of both layouts address the uBLAS elements; blocks and transposes share them
+void test_MatrixView()
+{
+    ublas::matrix<double, ublas::row_major> rows(3, 4);
+    ublas::matrix<double, ublas::column_major> columns(3, 4);
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = 0; j < 4; ++j) rows(i, j) = columns(i, j) = static_cast<double>(10 * i + j);
+    }
+
+    MatrixView<double> rowView{rows};
+    MatrixView<const double> columnView{static_cast<const ublas::matrix<double, ublas::column_major>&>(columns)};
+    assert(1 == rowView.columnStride() && 4 == rowView.rowStride());
+    assert(1 == columnView.rowStride() && 3 == columnView.columnStride());
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = 0; j < 4; ++j) assert(rowView(i, j) == columnView(i, j));
+    }
+
+    MatrixView<double> block = rowView.block(1, 2, 2, 2);
+    assert(12 == block(0, 0) && 23 == block(1, 1));
+    block(1, 0) = -1;
+    assert(-1 == rows(2, 2));
+
+    MatrixView<const double> transposed = columnView.block(0, 1, 3, 3).transposed();
+    assert(3 == transposed.rows() && 3 == transposed.columns());
+    assert(21 == transposed(0, 2) && 3 == transposed(2, 0));
+
+    bool thrown = false;
+    try { rowView.block(2, 0, 2, 1); }
+    catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+}
+
+// Same pivots and factors as uBLAS lu_factorize, and the same solution as lu_substitute
+template<typename Layout>
+void test_LuFactorize(ThreadPool* pool)
+{
+    std::mt19937_64 engine{11};
+    for (std::size_t n : {1, 7, 64, 65, 200})
+    {
+        ublas::matrix<double, Layout> a = randomMatrix<Layout>(n, n, engine);
+        ublas::matrix<double, Layout> expected = a;
+        ublas::permutation_matrix<std::size_t> permutation(n);
+        assert(0 == ublas::lu_factorize(expected, permutation));
+
+        ublas::matrix<double, Layout> lu = a;
+        std::vector<std::size_t> pivots = DenseSolver<double>::luFactorize(lu, pool);
+        for (std::size_t k = 0; k < n; ++k) assert(permutation(k) == pivots[k]);
+        assert(maxDifference(lu, expected) < 1e-10);
+
+        // Three right-hand sides at once
+        ublas::matrix<double, Layout> x = randomMatrix<Layout>(n, 3, engine);
+        ublas::matrix<double, Layout> b = ublas::prod(a, x);
+        DenseSolver<double>::luSolve(lu, pivots, b, pool);
+        assert(maxDifference(b, x) < 1e-8);
+
+        ublas::vector<double> column = ublas::column(ublas::matrix<double, Layout>(ublas::prod(a, x)), 0);
+        ublas::lu_substitute(expected, permutation, column);
+        for (std::size_t i = 0; i < n; ++i) assert(std::abs(column(i) - b(i, 0)) < 1e-8);
+    }
+}
+
+// L L^T gives back A, and solving with L recovers the right-hand sides
+template<typename Layout>
+void test_Cholesky(ThreadPool* pool)
+{
+    std::mt19937_64 engine{12};
+    for (std::size_t n : {1, 5, 64, 130, 257})
+    {
+        ublas::matrix<double, Layout> a = randomSpd<Layout>(n, engine);
+        ublas::matrix<double, Layout> l = a;
+        DenseSolver<double>::choleskyFactorize(l, pool);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            for (std::size_t j = i + 1; j < n; ++j) assert(0 == l(i, j));
+        }
+        ublas::matrix<double, Layout> product = ublas::prod(l, ublas::trans(l));
+        assert(maxDifference(product, a) < 1e-9 * static_cast<double>(n));
+
+        ublas::matrix<double, Layout> x = randomMatrix<Layout>(n, 70, engine);
+        ublas::matrix<double, Layout> b = ublas::prod(a, x);
+        DenseSolver<double>::choleskySolve(l, b, pool);
+        assert(maxDifference(b, x) < 1e-9);
+    }
+}
+
+// Forward and back substitution with many right-hand sides, including mixed layouts
+template<typename Layout, typename RhsLayout>
+void test_TriangularSolves(ThreadPool* pool)
+{
+    std::mt19937_64 engine{13};
+    const std::size_t n = 150;
+    ublas::matrix<double, Layout> t = randomMatrix<Layout>(n, n, engine);
+    t /= static_cast<double>(n);
+    for (std::size_t i = 0; i < n; ++i) t(i, i) += 1.0;
+
+    ublas::matrix<double, Layout> lower(ublas::zero_matrix<double>(n, n));
+    ublas::matrix<double, Layout> upper(ublas::zero_matrix<double>(n, n));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = 0; j <= i; ++j) lower(i, j) = t(i, j);
+        for (std::size_t j = i; j < n; ++j) upper(i, j) = t(i, j);
+    }
+
+    ublas::matrix<double, RhsLayout> x = randomMatrix<RhsLayout>(n, 100, engine);
+    ublas::matrix<double, RhsLayout> b = ublas::prod(lower, x);
+    DenseSolver<double>::solveLower(t, b, false, pool);
+    assert(maxDifference(b, x) < 1e-10);
+
+    b = ublas::prod(upper, x);
+    DenseSolver<double>::solveUpper(t, b, false, pool);
+    assert(maxDifference(b, x) < 1e-10);
+
+    // The unit diagonal is implied, not read
+    for (std::size_t i = 0; i < n; ++i) lower(i, i) = 1.0;
+    b = ublas::prod(lower, x);
+    DenseSolver<double>::solveLower(t, b, true, pool);
+    assert(maxDifference(b, x) < 1e-10);
+}
+
+// Singular, indefinite and mismatched inputs are rejected
+void test_Errors()
+{
+    ublas::matrix<double> singular(3, 3);
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = 0; j < 3; ++j) singular(i, j) = j == 1 ? 0.0 : static_cast<double>(i + j + 1);
+    }
+    bool thrown = false;
+    try { DenseSolver<double>::luFactorize(singular); }
+    catch (const std::domain_error&) { thrown = true; }
+    assert(thrown);
+
+    ublas::matrix<double> indefinite(ublas::identity_matrix<double>(3));
+    indefinite(2, 2) = -1;
+    thrown = false;
+    try { DenseSolver<double>::choleskyFactorize(indefinite); }
+    catch (const std::domain_error&) { thrown = true; }
+    assert(thrown);
+
+    ublas::matrix<double> rectangular(3, 4);
+    thrown = false;
+    try { DenseSolver<double>::luFactorize(rectangular); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    ublas::matrix<double> identity(ublas::identity_matrix<double>(3));
+    ublas::matrix<double> tall(4, 3);
+    thrown = false;
+    try { DenseSolver<double>::solveLower(identity, tall); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { TridiagonalSolver<double> solver({1.0}, {1.0, 2.0}, {}); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// Crank-Nicolson for u_t = u_xx with u = 0 at both ends: every step solves
+// (I - r/2 D) u' = (I + r/2 D) u. The Thomas solver matches a dense LU of the same matrix, and the
+// lowest Fourier mode decays at the rate the scheme predicts.
+void test_TridiagonalSolver()
+{
+    const std::size_t n = 199;
+    const double pi = std::acos(-1.0);
+    const double h = 1.0 / static_cast<double>(n + 1);
+    const double dt = 1e-4;
+    const double r = dt / (h * h);
+
+    TridiagonalSolver<double> solver(std::vector<double>(n - 1, -r / 2), std::vector<double>(n, 1 + r), std::vector<double>(n - 1, -r / 2));
+    assert(n == solver.size());
+
+    ublas::matrix<double> dense(ublas::zero_matrix<double>(n, n));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        dense(i, i) = 1 + r;
+        if (i > 0) dense(i, i - 1) = -r / 2;
+        if (i + 1 < n) dense(i, i + 1) = -r / 2;
+    }
+    std::vector<std::size_t> pivots = DenseSolver<double>::luFactorize(dense);
+
+    std::vector<double> u(n);
+    for (std::size_t i = 0; i < n; ++i) u[i] = std::sin(pi * static_cast<double>(i + 1) * h);
+    std::vector<double> rhs(n);
+    const int steps = 100;
+    for (int step = 0; step < steps; ++step)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double left = i > 0 ? u[i - 1] : 0.0;
+            const double right = i + 1 < n ? u[i + 1] : 0.0;
+            rhs[i] = (1 - r) * u[i] + r / 2 * (left + right);
+        }
+
+        ublas::matrix<double> column(n, 1);
+        for (std::size_t i = 0; i < n; ++i) column(i, 0) = rhs[i];
+        DenseSolver<double>::luSolve(dense, pivots, column);
+
+        solver.solve(rhs);
+        for (std::size_t i = 0; i < n; ++i) assert(std::abs(rhs[i] - column(i, 0)) < 1e-12);
+        u = rhs;
+    }
+
+    // Eigenvalue of the discrete Laplacian for the first mode, and the Crank-Nicolson amplification factor
+    const double lambda = 4 / (h * h) * std::pow(std::sin(pi * h / 2), 2);
+    const double growth = std::pow((1 - dt * lambda / 2) / (1 + dt * lambda / 2), steps);
+    const std::size_t middle = n / 2;
+    assert(std::abs(u[middle] - growth * std::sin(pi * static_cast<double>(middle + 1) * h)) < 1e-12);
+}
+
+// GFLOP/s of uBLAS lu_factorize and the blocked LU and Cholesky, sequential and on a pool
+template<typename Layout>
+void benchmark_Factorizations(const std::string& layout, std::size_t n, ThreadPool& pool)
+{
+    std::mt19937_64 engine{21};
+    const ublas::matrix<double, Layout> a = randomMatrix<Layout>(n, n, engine);
+    const ublas::matrix<double, Layout> spd = randomSpd<Layout>(n, engine);
+    const double luFlops = 2.0 / 3.0 * std::pow(static_cast<double>(n), 3);
+    const double choleskyFlops = luFlops / 2;
+
+    ublas::matrix<double, Layout> work = a;
+    ublas::permutation_matrix<std::size_t> permutation(n);
+    StopWatch stopWatch;
+    stopWatch.Start();
+    sink += static_cast<double>(ublas::lu_factorize(work, permutation));
+    stopWatch.Stop();
+    double ublasTime = stopWatch.ElapsedTime();
+
+    work = a;
+    stopWatch.Start();
+    sink += static_cast<double>(DenseSolver<double>::luFactorize(work).back());
+    stopWatch.Stop();
+    double luTime = stopWatch.ElapsedTime();
+    work = a;
+    stopWatch.Start();
+    sink += static_cast<double>(DenseSolver<double>::luFactorize(work, &pool).back());
+    stopWatch.Stop();
+    double luPoolTime = stopWatch.ElapsedTime();
+    work = spd;
+    stopWatch.Start();
+    DenseSolver<double>::choleskyFactorize(work);
+    sink += work(0, 0);
+    stopWatch.Stop();
+    double choleskyTime = stopWatch.ElapsedTime();
+    work = spd;
+    stopWatch.Start();
+    DenseSolver<double>::choleskyFactorize(work, &pool);
+    sink += work(0, 0);
+    stopWatch.Stop();
+    double choleskyPoolTime = stopWatch.ElapsedTime();
+
+    std::cout << layout << "\t" << n << "\t" << 1e-9 * luFlops / ublasTime << "\t\t" << 1e-9 * luFlops / luTime << "\t\t"
+              << 1e-9 * luFlops / luPoolTime << "\t\t" << 1e-9 * choleskyFlops / choleskyTime << "\t\t"
+              << 1e-9 * choleskyFlops / choleskyPoolTime << std::endl;
+}
+
+// GFLOP/s of a triangular solve with many right-hand sides
+template<typename Layout>
+void benchmark_TriangularSolve(const std::string& layout, std::size_t n, std::size_t rightHandSides, ThreadPool& pool)
+{
+    std::mt19937_64 engine{22};
+    ublas::matrix<double, Layout> t = randomMatrix<Layout>(n, n, engine);
+    for (std::size_t i = 0; i < n; ++i) t(i, i) += static_cast<double>(n);
+    const ublas::matrix<double, Layout> b = randomMatrix<Layout>(n, rightHandSides, engine);
+    const double flops = static_cast<double>(n) * static_cast<double>(n) * static_cast<double>(rightHandSides);
+
+    ublas::matrix<double, Layout> x = b;
+    StopWatch stopWatch;
+    stopWatch.Start();
+    DenseSolver<double>::solveLower(t, x);
+    sink += x(0, 0);
+    stopWatch.Stop();
+    double sequential = stopWatch.ElapsedTime();
+    x = b;
+    stopWatch.Start();
+    DenseSolver<double>::solveLower(t, x, false, &pool);
+    sink += x(0, 0);
+    stopWatch.Stop();
+    double parallel = stopWatch.ElapsedTime();
+    std::cout << layout << "\t" << n << "\t" << rightHandSides << "\t" << 1e-9 * flops / sequential << "\t\t"
+              << 1e-9 * flops / parallel << std::endl;
+}
+
+// Nanoseconds per unknown of a Thomas solve
+void benchmark_Tridiagonal(std::size_t n)
+{
+    TridiagonalSolver<double> solver(std::vector<double>(n - 1, -1.0), std::vector<double>(n, 4.0), std::vector<double>(n - 1, -1.0));
+    std::vector<double> values(n, 1.0);
+    constexpr int SOLVES = 20;
+    StopWatch stopWatch;
+    stopWatch.Start();
+    for (int i = 0; i < SOLVES; ++i) solver.solve(values);
+    stopWatch.Stop();
+    double time = stopWatch.ElapsedTime();
+    sink += values[n / 2];
+    std::cout << n << "\t\t" << 1e9 * time / (SOLVES * static_cast<double>(n)) << "\t\t"
+              << 1e-9 * 5.0 * static_cast<double>(n) * SOLVES / time << std::endl;
+}
+
+int main()
+{
+    ThreadPool pool{4};
+    test_MatrixView();
+    for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool})
+    {
+        test_LuFactorize<ublas::row_major>(threads);
+        test_LuFactorize<ublas::column_major>(threads);
+        test_Cholesky<ublas::row_major>(threads);
+        test_Cholesky<ublas::column_major>(threads);
+        test_TriangularSolves<ublas::row_major, ublas::row_major>(threads);
+        test_TriangularSolves<ublas::column_major, ublas::column_major>(threads);
+        test_TriangularSolves<ublas::row_major, ublas::column_major>(threads);
+    }
+    test_Errors();
+    test_TridiagonalSolver();
+
+    ThreadPool machine;
+    std::cout << "GFLOP/s on " << machine.size() << " threads" << std::endl;
+    std::cout << "layout\tn\tuBLAS LU\tLU\t\tLU threads\tCholesky\tCholesky threads" << std::endl;
+    for (std::size_t n : {256, 512})
+    {
+        benchmark_Factorizations<ublas::row_major>("row", n, machine);
+        benchmark_Factorizations<ublas::column_major>("column", n, machine);
+    }
+
+    std::cout << "layout\tn\tRHS\tsolveLower\tsolveLower threads" << std::endl;
+    benchmark_TriangularSolve<ublas::row_major>("row", 1024, 256, machine);
+    benchmark_TriangularSolve<ublas::column_major>("column", 1024, 256, machine);
+
+    std::cout << "unknowns\tns/unknown\tGFLOP/s" << std::endl;
+    for (std::size_t n : {1000, 1000000}) benchmark_Tridiagonal(n);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,380 @@
+//
+// Sifts of the d-ary heap, the handle table, and the updates by handle
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_INDEXEDHEAP_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_INDEXEDHEAP_CPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "IndexedHeap.hpp"
+
+/**
+ * Default ctor: an empty heap
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param compare The comparator
+ */
+template<typename T, typename Compare, std::size_t D>
+IndexedHeap<T, Compare, D>::IndexedHeap(const Compare& compare)
+    : entries{}, positions{}, freeHandles{}, compare{compare}
+{
+
+}
+
+/**
+ * Overloaded ctor: a heap of values, heapified bottom-up in O(n). The handle of values[i] is i.
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param values The elements
+ * @param compare The comparator
+ * @throws std::length_error if there are more values than handles
+ */
+template<typename T, typename Compare, std::size_t D>
+IndexedHeap<T, Compare, D>::IndexedHeap(std::vector<T> values, const Compare& compare)
+    : entries{}, positions(values.size()), freeHandles{}, compare{compare}
+{
+    if (values.size() >= ABSENT) throw std::length_error(std::to_string(values.size()) + " values exceed the handles of a heap");
+    entries.reserve(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        entries.push_back(Entry{std::move(values[i]), static_cast<Handle>(i)});
+        positions[i] = static_cast<std::uint32_t>(i);
+    }
+    if (entries.size() < 2) return;
+    for (std::size_t parent = (entries.size() - 2) / D + 1; parent-- > 0;) siftDown(parent);
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param handle A handle
+ * @return The position of its element
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ */
+template<typename T, typename Compare, std::size_t D>
+std::uint32_t IndexedHeap<T, Compare, D>::checkedPosition(Handle handle) const
+{
+    if (!contains(handle)) throw std::out_of_range("Handle " + std::to_string(handle) + " is not in the heap");
+    return positions[handle];
+}
+
+/**
+ * Moves an entry to a position and records the position under its handle
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param entry The entry
+ * @param position Its new position
+ */
+template<typename T, typename Compare, std::size_t D>
+void IndexedHeap<T, Compare, D>::place(Entry&& entry, std::size_t position) noexcept
+{
+    positions[entry.handle] = static_cast<std::uint32_t>(position);
+    entries[position] = std::move(entry);
+}
+
+/**
+ * Moves the entry at position up past the parents that it comes before, moving them down into the hole
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param position The position of an entry that may come before its parent
+ */
+template<typename T, typename Compare, std::size_t D>
+void IndexedHeap<T, Compare, D>::siftUp(std::size_t position)
+{
+    Entry entry = std::move(entries[position]);
+    while (position > 0)
+    {
+        const std::size_t parent = (position - 1) / D;
+        if (!compare(entry.value, entries[parent].value)) break;
+        place(std::move(entries[parent]), position);
+        position = parent;
+    }
+    place(std::move(entry), position);
+}
+
+/**
+ * Moves the entry at position down past the children that come before it, the first of the D children
+ * moving up into the hole each time
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param position The position of an entry that may come after one of its children
+ */
+template<typename T, typename Compare, std::size_t D>
+void IndexedHeap<T, Compare, D>::siftDown(std::size_t position)
+{
+    const std::size_t n = entries.size();
+    Entry entry = std::move(entries[position]);
+    while (true)
+    {
+        const std::size_t first = D * position + 1;
+        if (first >= n) break;
+        const std::size_t last = std::min(first + D, n);
+        std::size_t best = first;
+        for (std::size_t child = first + 1; child < last; ++child)
+        {
+            if (compare(entries[child].value, entries[best].value)) best = child;
+        }
+        if (!compare(entries[best].value, entry.value)) break;
+        place(std::move(entries[best]), position);
+        position = best;
+    }
+    place(std::move(entry), position);
+}
+
+/**
+ * Removes the entry at position: the last entry takes its place and moves up or down from there
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param position The position of the entry
+ */
+template<typename T, typename Compare, std::size_t D>
+void IndexedHeap<T, Compare, D>::remove(std::size_t position)
+{
+    const Handle handle = entries[position].handle;
+    positions[handle] = ABSENT;
+    freeHandles.push_back(handle);
+
+    if (position + 1 == entries.size())
+    {
+        entries.pop_back();
+        return;
+    }
+    Entry last = std::move(entries.back());
+    entries.pop_back();
+    if (position > 0 && compare(last.value, entries[(position - 1) / D].value))
+    {
+        place(std::move(last), position);
+        siftUp(position);
+        return;
+    }
+
+    // The last entry almost always belongs near the bottom: move the hole down to a leaf along the first
+    // children without comparing them to it, then move the entry up from there (Floyd), as std::pop_heap does
+    const std::size_t n = entries.size();
+    while (true)
+    {
+        const std::size_t first = D * position + 1;
+        if (first >= n) break;
+        const std::size_t end = std::min(first + D, n);
+        std::size_t best = first;
+        for (std::size_t child = first + 1; child < end; ++child)
+        {
+            if (compare(entries[child].value, entries[best].value)) best = child;
+        }
+        place(std::move(entries[best]), position);
+        position = best;
+    }
+    place(std::move(last), position);
+    siftUp(position);
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param handle The handle of an element
+ * @return The element
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ */
+template<typename T, typename Compare, std::size_t D>
+const T& IndexedHeap<T, Compare, D>::operator[](Handle handle) const
+{
+    return entries[checkedPosition(handle)].value;
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @return The first element under Compare
+ * @throws std::out_of_range if the heap is empty
+ */
+template<typename T, typename Compare, std::size_t D>
+const T& IndexedHeap<T, Compare, D>::top() const
+{
+    if (entries.empty()) throw std::out_of_range("top() of an empty heap");
+    return entries.front().value;
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @return The handle of the first element under Compare
+ * @throws std::out_of_range if the heap is empty
+ */
+template<typename T, typename Compare, std::size_t D>
+typename IndexedHeap<T, Compare, D>::Handle IndexedHeap<T, Compare, D>::topHandle() const
+{
+    if (entries.empty()) throw std::out_of_range("topHandle() of an empty heap");
+    return entries.front().handle;
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param value The element
+ * @return Its handle, valid until it leaves the heap; handles of elements that left are reused
+ */
+template<typename T, typename Compare, std::size_t D>
+typename IndexedHeap<T, Compare, D>::Handle IndexedHeap<T, Compare, D>::push(const T& value)
+{
+    return push(T{value});
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param value The element
+ * @return Its handle, valid until it leaves the heap; handles of elements that left are reused
+ * @throws std::length_error if every handle is in use
+ */
+template<typename T, typename Compare, std::size_t D>
+typename IndexedHeap<T, Compare, D>::Handle IndexedHeap<T, Compare, D>::push(T&& value)
+{
+    Handle handle;
+    if (!freeHandles.empty())
+    {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }
+    else
+    {
+        if (positions.size() >= ABSENT) throw std::length_error("Every handle of the heap is in use");
+        handle = static_cast<Handle>(positions.size());
+        positions.push_back(ABSENT);
+    }
+    entries.push_back(Entry{std::move(value), handle});
+    positions[handle] = static_cast<std::uint32_t>(entries.size() - 1);
+    siftUp(entries.size() - 1);
+    return handle;
+}
+
+/**
+ * Removes the first element
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @throws std::out_of_range if the heap is empty
+ */
+template<typename T, typename Compare, std::size_t D>
+void IndexedHeap<T, Compare, D>::pop()
+{
+    if (entries.empty()) throw std::out_of_range("pop() of an empty heap");
+    remove(0);
+}
+
+/**
+ * Replaces an element by one that comes no later under Compare, e.g. a shorter distance in a min-heap
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param handle The handle of the element
+ * @param value Its new value
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ * @throws std::invalid_argument if the new value comes after the old one
+ */
+template<typename T, typename Compare, std::size_t D>
+void IndexedHeap<T, Compare, D>::decreaseKey(Handle handle, const T& value)
+{
+    const std::uint32_t position = checkedPosition(handle);
+    if (compare(entries[position].value, value)) throw std::invalid_argument("decreaseKey() would move handle " + std::to_string(handle) + " down");
+    entries[position].value = value;
+    siftUp(position);
+}
+
+/**
+ * Replaces an element by one that comes no earlier under Compare
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param handle The handle of the element
+ * @param value Its new value
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ * @throws std::invalid_argument if the new value comes before the old one
+ */
+template<typename T, typename Compare, std::size_t D>
+void IndexedHeap<T, Compare, D>::increaseKey(Handle handle, const T& value)
+{
+    const std::uint32_t position = checkedPosition(handle);
+    if (compare(value, entries[position].value)) throw std::invalid_argument("increaseKey() would move handle " + std::to_string(handle) + " up");
+    entries[position].value = value;
+    siftDown(position);
+}
+
+/**
+ * Replaces an element, moving it up or down as the new value requires
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param handle The handle of the element
+ * @param value Its new value
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ */
+template<typename T, typename Compare, std::size_t D>
+void IndexedHeap<T, Compare, D>::update(Handle handle, const T& value)
+{
+    const std::uint32_t position = checkedPosition(handle);
+    const bool earlier = compare(value, entries[position].value);
+    entries[position].value = value;
+    if (earlier) siftUp(position);
+    else siftDown(position);
+}
+
+/**
+ * Removes an element wherever it is
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param handle The handle of the element
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ */
+template<typename T, typename Compare, std::size_t D>
+void IndexedHeap<T, Compare, D>::erase(Handle handle)
+{
+    remove(checkedPosition(handle));
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ * @param capacity The number of elements to make room for
+ */
+template<typename T, typename Compare, std::size_t D>
+void IndexedHeap<T, Compare, D>::reserve(std::size_t capacity)
+{
+    entries.reserve(capacity);
+    positions.reserve(capacity);
+}
+
+/**
+ * Removes every element; all handles become free
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @tparam D The number of children per node
+ */
+template<typename T, typename Compare, std::size_t D>
+void IndexedHeap<T, Compare, D>::clear() noexcept
+{
+    entries.clear();
+    positions.clear();
+    freeHandles.clear();
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_INDEXEDHEAP_CPP
@@ -0,0 +1,94 @@
+//
+// A d-ary heap whose elements can be found again. Exercises 1 and 2 use std::make_heap, push_heap, pop_heap
+// and std::priority_queue, which only give access to the top: to change the priority of an order about to
+// expire, or of a vertex whose distance just fell, the element must be searched for in O(n) or pushed again
+// and its stale copy skipped when it surfaces.
+//
+// push() returns a handle, a small integer that stays valid until its element leaves the heap. The heap
+// keeps each element's position by handle, so decreaseKey(), increaseKey(), update() and erase() find the
+// element in O(1) and restore the heap in O(log n). top() is the first element under Compare, the smallest
+// with std::less: a min-heap, as shortest paths and expiry queues want; std::greater gives the max-heap of
+// std::priority_queue's default.
+//
+// The tree has D children per node (4 by default) instead of 2: half as many levels, and a node's children
+// are adjacent in memory, so the comparisons of one level of a sift-down fall in one or two cache lines.
+// Elements are stored in the heap array next to their handles, not behind pointers. Sifts move a hole
+// instead of swapping. The constructor from a vector heapifies bottom-up in O(n), like std::make_heap.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_INDEXEDHEAP_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_INDEXEDHEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+template<typename T, typename Compare = std::less<T>, std::size_t D = 4>
+class IndexedHeap
+{
+    static_assert(D >= 2, "A heap has at least two children per node");
+
+public:
+    using Handle = std::uint32_t;
+
+private:
+    static constexpr std::uint32_t ABSENT = std::numeric_limits<std::uint32_t>::max();
+
+    struct Entry
+    {
+        T value;
+        Handle handle;
+    };
+
+    std::vector<Entry> entries;                 // The heap, in breadth-first order
+    std::vector<std::uint32_t> positions;       // Position of each handle in entries, ABSENT if free
+    std::vector<Handle> freeHandles;
+    Compare compare;
+
+    std::uint32_t checkedPosition(Handle handle) const;
+    void place(Entry&& entry, std::size_t position) noexcept;
+    void siftUp(std::size_t position);
+    void siftDown(std::size_t position);
+    void remove(std::size_t position);
+
+public:
+    explicit IndexedHeap(const Compare& compare = Compare{});
+    explicit IndexedHeap(std::vector<T> values, const Compare& compare = Compare{});
+    IndexedHeap(const IndexedHeap& source) = default;
+    IndexedHeap(IndexedHeap&& source) noexcept = default;
+    ~IndexedHeap() = default;
+
+    // Operator overloads
+    IndexedHeap& operator=(const IndexedHeap& source) = default;
+    IndexedHeap& operator=(IndexedHeap&& source) noexcept = default;
+    const T& operator[](Handle handle) const;
+
+    // Accessors
+    std::size_t size() const noexcept { return entries.size(); }
+    bool empty() const noexcept { return entries.empty(); }
+    bool contains(Handle handle) const noexcept { return handle < positions.size() && positions[handle] != ABSENT; }
+    const T& top() const;
+    Handle topHandle() const;
+
+    // Core functionality
+    Handle push(const T& value);
+    Handle push(T&& value);
+    void pop();
+    void decreaseKey(Handle handle, const T& value);
+    void increaseKey(Handle handle, const T& value);
+    void update(Handle handle, const T& value);
+    void erase(Handle handle);
+    void reserve(std::size_t capacity);
+    void clear() noexcept;
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_INDEXEDHEAP_CPP
+#include "IndexedHeap.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_INDEXEDHEAP_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_INDEXEDHEAP_HPP
@@ -0,0 +1,358 @@
+//
+// Links, cuts and the two-pass merge of the pairing heap
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_PAIRINGHEAP_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_PAIRINGHEAP_CPP
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "PairingHeap.hpp"
+
+/**
+ * Default ctor: an empty heap
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param compare The comparator
+ */
+template<typename T, typename Compare>
+PairingHeap<T, Compare>::PairingHeap(const Compare& compare)
+    : nodes{}, freeHandles{}, root{NONE}, count{0}, compare{compare}
+{
+
+}
+
+/**
+ * Overloaded ctor: a heap of values, one O(1) push each. The handle of values[i] is i.
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param values The elements
+ * @param compare The comparator
+ */
+template<typename T, typename Compare>
+PairingHeap<T, Compare>::PairingHeap(std::vector<T> values, const Compare& compare)
+    : nodes{}, freeHandles{}, root{NONE}, count{0}, compare{compare}
+{
+    nodes.reserve(values.size());
+    for (T& value : values) push(std::move(value));
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param handle A handle
+ * @return The handle
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ */
+template<typename T, typename Compare>
+typename PairingHeap<T, Compare>::Handle PairingHeap<T, Compare>::checked(Handle handle) const
+{
+    if (!contains(handle)) throw std::out_of_range("Handle " + std::to_string(handle) + " is not in the heap");
+    return handle;
+}
+
+/**
+ * Links two trees: the root that comes later becomes the first child of the other
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param first The root of a tree without siblings or parent
+ * @param second The root of another such tree
+ * @return The root of the linked tree
+ */
+template<typename T, typename Compare>
+typename PairingHeap<T, Compare>::Handle PairingHeap<T, Compare>::link(Handle first, Handle second) noexcept
+{
+    if (compare(nodes[second].value, nodes[first].value)) std::swap(first, second);
+    Node& parent = nodes[first];
+    Node& child = nodes[second];
+    child.next = parent.child;
+    if (parent.child != NONE) nodes[parent.child].previous = second;
+    child.previous = first;
+    parent.child = second;
+    return first;
+}
+
+/**
+ * Detaches a node that is not the root, with its subtree, from its parent and siblings
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param handle The node
+ */
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::cut(Handle handle) noexcept
+{
+    Node& node = nodes[handle];
+    if (nodes[node.previous].child == handle) nodes[node.previous].child = node.next;
+    else nodes[node.previous].next = node.next;
+    if (node.next != NONE) nodes[node.next].previous = node.previous;
+    node.previous = node.next = NONE;
+}
+
+/**
+ * The two-pass merge of a list of siblings: link them in pairs from left to right, then link the pairs from
+ * right to left into one tree. The pairs are kept on a stack threaded through their next links, so the merge
+ * does not allocate.
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param first The first of the siblings, or NONE
+ * @return The root of the merged tree, without siblings or parent, or NONE
+ */
+template<typename T, typename Compare>
+typename PairingHeap<T, Compare>::Handle PairingHeap<T, Compare>::mergePairs(Handle first) noexcept
+{
+    Handle pairs = NONE;
+    while (first != NONE)
+    {
+        const Handle a = first;
+        const Handle b = nodes[a].next;
+        nodes[a].previous = nodes[a].next = NONE;
+        Handle linked = a;
+        if (b == NONE) first = NONE;
+        else
+        {
+            first = nodes[b].next;
+            nodes[b].previous = nodes[b].next = NONE;
+            linked = link(a, b);
+        }
+        nodes[linked].next = pairs;
+        pairs = linked;
+    }
+    if (pairs == NONE) return NONE;
+
+    Handle result = pairs;
+    pairs = nodes[result].next;
+    nodes[result].next = NONE;
+    while (pairs != NONE)
+    {
+        const Handle pair = pairs;
+        pairs = nodes[pair].next;
+        nodes[pair].next = NONE;
+        result = link(result, pair);
+    }
+    return result;
+}
+
+/**
+ * Returns the node of an element that left the heap to the free handles
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param handle The node
+ */
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::release(Handle handle)
+{
+    nodes[handle].live = false;
+    freeHandles.push_back(handle);
+    --count;
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param handle The handle of an element
+ * @return The element
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ */
+template<typename T, typename Compare>
+const T& PairingHeap<T, Compare>::operator[](Handle handle) const
+{
+    return nodes[checked(handle)].value;
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @return The first element under Compare
+ * @throws std::out_of_range if the heap is empty
+ */
+template<typename T, typename Compare>
+const T& PairingHeap<T, Compare>::top() const
+{
+    if (root == NONE) throw std::out_of_range("top() of an empty heap");
+    return nodes[root].value;
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @return The handle of the first element under Compare
+ * @throws std::out_of_range if the heap is empty
+ */
+template<typename T, typename Compare>
+typename PairingHeap<T, Compare>::Handle PairingHeap<T, Compare>::topHandle() const
+{
+    if (root == NONE) throw std::out_of_range("topHandle() of an empty heap");
+    return root;
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param value The element
+ * @return Its handle, valid until it leaves the heap; handles of elements that left are reused
+ */
+template<typename T, typename Compare>
+typename PairingHeap<T, Compare>::Handle PairingHeap<T, Compare>::push(const T& value)
+{
+    return push(T{value});
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param value The element
+ * @return Its handle, valid until it leaves the heap; handles of elements that left are reused
+ * @throws std::length_error if every handle is in use
+ */
+template<typename T, typename Compare>
+typename PairingHeap<T, Compare>::Handle PairingHeap<T, Compare>::push(T&& value)
+{
+    Handle handle;
+    if (!freeHandles.empty())
+    {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+        nodes[handle] = Node{std::move(value), NONE, NONE, NONE, true};
+    }
+    else
+    {
+        if (nodes.size() >= NONE) throw std::length_error("Every handle of the heap is in use");
+        handle = static_cast<Handle>(nodes.size());
+        nodes.push_back(Node{std::move(value), NONE, NONE, NONE, true});
+    }
+    root = root == NONE ? handle : link(root, handle);
+    ++count;
+    return handle;
+}
+
+/**
+ * Removes the first element
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @throws std::out_of_range if the heap is empty
+ */
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::pop()
+{
+    if (root == NONE) throw std::out_of_range("pop() of an empty heap");
+    const Handle old = root;
+    root = mergePairs(nodes[old].child);
+    nodes[old].child = NONE;
+    release(old);
+}
+
+/**
+ * Replaces an element by one that comes no later under Compare: its subtree is cut and linked to the root
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param handle The handle of the element
+ * @param value Its new value
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ * @throws std::invalid_argument if the new value comes after the old one
+ */
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::decreaseKey(Handle handle, const T& value)
+{
+    Node& node = nodes[checked(handle)];
+    if (compare(node.value, value)) throw std::invalid_argument("decreaseKey() would move handle " + std::to_string(handle) + " down");
+    node.value = value;
+    if (handle == root) return;
+    cut(handle);
+    root = link(root, handle);
+}
+
+/**
+ * Replaces an element by one that comes no earlier under Compare: its children are merged into a tree of
+ * their own, and both the node alone and that tree are linked back to the root
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param handle The handle of the element
+ * @param value Its new value
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ * @throws std::invalid_argument if the new value comes before the old one
+ */
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::increaseKey(Handle handle, const T& value)
+{
+    Node& node = nodes[checked(handle)];
+    if (compare(value, node.value)) throw std::invalid_argument("increaseKey() would move handle " + std::to_string(handle) + " up");
+    node.value = value;
+
+    const Handle children = mergePairs(node.child);
+    nodes[handle].child = NONE;
+    if (handle == root) root = children == NONE ? handle : link(children, handle);
+    else
+    {
+        cut(handle);
+        root = link(root, handle);
+        if (children != NONE) root = link(root, children);
+    }
+}
+
+/**
+ * Replaces an element, as decreaseKey() or increaseKey() as the new value requires
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param handle The handle of the element
+ * @param value Its new value
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ */
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::update(Handle handle, const T& value)
+{
+    if (compare(value, nodes[checked(handle)].value)) decreaseKey(handle, value);
+    else increaseKey(handle, value);
+}
+
+/**
+ * Removes an element wherever it is: its children are merged and linked to the root
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param handle The handle of the element
+ * @throws std::out_of_range if the handle does not name an element of the heap
+ */
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::erase(Handle handle)
+{
+    if (checked(handle) == root)
+    {
+        pop();
+        return;
+    }
+    cut(handle);
+    const Handle children = mergePairs(nodes[handle].child);
+    nodes[handle].child = NONE;
+    if (children != NONE) root = link(root, children);
+    release(handle);
+}
+
+/**
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ * @param capacity The number of elements to make room for
+ */
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::reserve(std::size_t capacity)
+{
+    nodes.reserve(capacity);
+}
+
+/**
+ * Removes every element; all handles become free
+ * @tparam T The type of the elements
+ * @tparam Compare The order of the elements, top() being the first
+ */
+template<typename T, typename Compare>
+void PairingHeap<T, Compare>::clear() noexcept
+{
+    nodes.clear();
+    freeHandles.clear();
+    root = NONE;
+    count = 0;
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_PAIRINGHEAP_CPP
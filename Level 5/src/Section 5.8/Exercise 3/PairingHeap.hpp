@@ -0,0 +1,90 @@
+//
+// A pairing heap with the interface of IndexedHeap. A pairing heap is a tree of any shape kept in heap
+// order: push() and decreaseKey() link a single node to the root in O(1), and pop() links the root's
+// children in pairs and then the pairs into one tree, O(log n) amortised. Where IndexedHeap pays O(log n)
+// per decreaseKey(), here it is one cut and one link, which pays off when updates far outnumber pops, as in
+// Dijkstra's algorithm on dense graphs; in exchange every step follows a pointer.
+//
+// The nodes live in one vector indexed by handle, with free handles reused, so that nodes are not allocated
+// one by one and a handle is the index of its node. Each node links to its first child, its next sibling
+// and its previous sibling, or its parent if it is a first child; cuts are O(1).
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_PAIRINGHEAP_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_PAIRINGHEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+template<typename T, typename Compare = std::less<T>>
+class PairingHeap
+{
+public:
+    using Handle = std::uint32_t;
+
+private:
+    static constexpr Handle NONE = std::numeric_limits<Handle>::max();
+
+    struct Node
+    {
+        T value;
+        Handle child;
+        Handle next;            // Next sibling
+        Handle previous;        // Previous sibling, or the parent of a first child; NONE for the root
+        bool live;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Handle> freeHandles;
+    Handle root;
+    std::size_t count;
+    Compare compare;
+
+    Handle checked(Handle handle) const;
+    Handle link(Handle first, Handle second) noexcept;
+    void cut(Handle handle) noexcept;
+    Handle mergePairs(Handle first) noexcept;
+    void release(Handle handle);
+
+public:
+    explicit PairingHeap(const Compare& compare = Compare{});
+    explicit PairingHeap(std::vector<T> values, const Compare& compare = Compare{});
+    PairingHeap(const PairingHeap& source) = default;
+    PairingHeap(PairingHeap&& source) noexcept = default;
+    ~PairingHeap() = default;
+
+    // Operator overloads
+    PairingHeap& operator=(const PairingHeap& source) = default;
+    PairingHeap& operator=(PairingHeap&& source) noexcept = default;
+    const T& operator[](Handle handle) const;
+
+    // Accessors
+    std::size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+    bool contains(Handle handle) const noexcept { return handle < nodes.size() && nodes[handle].live; }
+    const T& top() const;
+    Handle topHandle() const;
+
+    // Core functionality
+    Handle push(const T& value);
+    Handle push(T&& value);
+    void pop();
+    void decreaseKey(Handle handle, const T& value);
+    void increaseKey(Handle handle, const T& value);
+    void update(Handle handle, const T& value);
+    void erase(Handle handle);
+    void reserve(std::size_t capacity);
+    void clear() noexcept;
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_PAIRINGHEAP_CPP
+#include "PairingHeap.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_PAIRINGHEAP_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_PAIRINGHEAP_HPP
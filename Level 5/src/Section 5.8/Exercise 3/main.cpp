@@ -0,0 +1,485 @@
+//
+// Heaps that can change an element's priority in place. Exercises 1 and 2 can only pop the top of a heap;
+// IndexedHeap (d-ary, elements found by handle) and PairingHeap add decreaseKey, increaseKey, update and
+// erase. Tests run random mixes of every operation against a std::multiset, sort through the O(n) bulk
+// constructor, and compare Dijkstra's shortest paths with those of the usual std::priority_queue that pushes
+// duplicates and skips stale entries. Benchmarks report nanoseconds per operation for push/pop, for updates
+// mixed with pops, and for Dijkstra, next to std::push_heap/pop_heap and std::priority_queue.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "IndexedHeap.hpp"
+#include "PairingHeap.hpp"
+#include "StopWatch.hpp"
+
+std::uint64_t sink = 0;
+
+// Random pushes, pops, updates in both directions and erasures, checked against a multiset of (value, handle)
+template<typename Heap>
+void test_RandomOperations()
+{
+    std::mt19937_64 engine{42};
+    std::uniform_int_distribution<int> values{0, 1000};
+    std::uniform_int_distribution<int> operations{0, 9};
+    Heap heap;
+    std::set<std::pair<int, std::uint32_t>> reference;
+    std::vector<std::uint32_t> live;
+
+    auto randomLive = [&] { return std::uniform_int_distribution<std::size_t>{0, live.size() - 1}(engine); };
+    auto forget = [&](std::uint32_t handle)
+    {
+        live.erase(std::find(live.begin(), live.end(), handle));
+        assert(!heap.contains(handle));
+    };
+
+    for (int step = 0; step < 200'000; ++step)
+    {
+        const int operation = live.empty() ? 0 : operations(engine);
+        if (operation <= 3)
+        {
+            const int value = values(engine);
+            const std::uint32_t handle = heap.push(value);
+            assert(!reference.contains({value, handle}) && heap[handle] == value);
+            reference.insert({value, handle});
+            live.push_back(handle);
+        }
+        else if (operation == 4)
+        {
+            const std::uint32_t handle = heap.topHandle();
+            assert(reference.begin()->first == heap.top() && heap[handle] == heap.top());
+            reference.erase({heap.top(), handle});
+            heap.pop();
+            forget(handle);
+        }
+        else if (operation <= 6)
+        {
+            const std::uint32_t handle = live[randomLive()];
+            const int value = heap[handle];
+            const int lower = value - std::uniform_int_distribution<int>{0, 200}(engine);
+            reference.erase({value, handle});
+            reference.insert({lower, handle});
+            heap.decreaseKey(handle, lower);
+        }
+        else if (operation == 7)
+        {
+            const std::uint32_t handle = live[randomLive()];
+            const int value = heap[handle];
+            const int higher = value + std::uniform_int_distribution<int>{0, 200}(engine);
+            reference.erase({value, handle});
+            reference.insert({higher, handle});
+            heap.increaseKey(handle, higher);
+        }
+        else if (operation == 8)
+        {
+            const std::uint32_t handle = live[randomLive()];
+            const int value = values(engine);
+            reference.erase({heap[handle], handle});
+            reference.insert({value, handle});
+            heap.update(handle, value);
+        }
+        else
+        {
+            const std::uint32_t handle = live[randomLive()];
+            reference.erase({heap[handle], handle});
+            heap.erase(handle);
+            forget(handle);
+        }
+
+        assert(heap.size() == reference.size());
+        if (!reference.empty()) assert(heap.top() == reference.begin()->first);
+    }
+
+    // Drain in order
+    while (!heap.empty())
+    {
+        assert(heap.top() == reference.begin()->first);
+        reference.erase(reference.begin());
+        heap.pop();
+    }
+    assert(reference.empty());
+}
+
+// The bulk constructor, handles 0 to n - 1, and heapsort in either order
+template<typename Heap>
+void test_BulkConstruction(std::size_t n)
+{
+    std::mt19937_64 engine{n};
+    std::vector<int> values(n);
+    for (int& value : values) value = static_cast<int>(engine() % 100);
+
+    Heap heap(values);
+    assert(heap.size() == n);
+    for (std::size_t i = 0; i < n; ++i) assert(heap[static_cast<std::uint32_t>(i)] == values[i]);
+
+    std::vector<int> sorted;
+    while (!heap.empty())
+    {
+        sorted.push_back(heap.top());
+        heap.pop();
+    }
+    std::vector<int> expected = values;
+    std::sort(expected.begin(), expected.end());
+    assert(sorted == expected);
+}
+
+void test_MaxHeap()
+{
+    const std::vector<int> data{10, 5, 20, 30, 25, 7, 40};
+    IndexedHeap<int, std::greater<>> indexed(data);
+    PairingHeap<int, std::greater<>> pairing(data);
+    std::priority_queue<int> queue(data.begin(), data.end());
+    while (!queue.empty())
+    {
+        assert(indexed.top() == queue.top() && pairing.top() == queue.top());
+        indexed.pop();
+        pairing.pop();
+        queue.pop();
+    }
+
+    // Raising a priority in a max-heap is a decreaseKey: the element moves towards the top
+    IndexedHeap<int, std::greater<>> raise(data);
+    raise.decreaseKey(1, 50);
+    assert(raise.top() == 50 && raise.topHandle() == 1);
+}
+
+template<typename Heap>
+void test_Errors()
+{
+    Heap heap;
+    bool thrown = false;
+    try { heap.top(); }
+    catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { heap.pop(); }
+    catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+
+    const auto handle = heap.push(5);
+    thrown = false;
+    try { heap.decreaseKey(handle, 6); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { heap.increaseKey(handle, 4); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    heap.erase(handle);
+    assert(heap.empty() && !heap.contains(handle));
+    thrown = false;
+    try { heap.erase(handle); }
+    catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+}
+
+// A random directed graph with n vertices, degree out-edges each and weights 1 to 1000
+struct Graph
+{
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> targets;
+    std::vector<std::uint32_t> weights;
+};
+
+Graph randomGraph(std::uint32_t n, std::uint32_t degree)
+{
+    std::mt19937_64 engine{n};
+    Graph graph;
+    for (std::uint32_t v = 0; v < n; ++v)
+    {
+        graph.offsets.push_back(static_cast<std::uint32_t>(graph.targets.size()));
+        for (std::uint32_t e = 0; e < degree; ++e)
+        {
+            graph.targets.push_back(static_cast<std::uint32_t>(engine() % n));
+            graph.weights.push_back(static_cast<std::uint32_t>(1 + engine() % 1000));
+        }
+    }
+    graph.offsets.push_back(static_cast<std::uint32_t>(graph.targets.size()));
+    return graph;
+}
+
+constexpr std::uint64_t UNREACHED = std::numeric_limits<std::uint64_t>::max();
+
+// Dijkstra with std::priority_queue: improved distances are pushed again and stale entries skipped on pop
+std::vector<std::uint64_t> dijkstraLazy(const Graph& graph, std::uint32_t source)
+{
+    std::vector<std::uint64_t> distance(graph.offsets.size() - 1, UNREACHED);
+    using Item = std::pair<std::uint64_t, std::uint32_t>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<>> queue;
+    distance[source] = 0;
+    queue.push({0, source});
+    while (!queue.empty())
+    {
+        const auto [d, v] = queue.top();
+        queue.pop();
+        if (d != distance[v]) continue;
+        for (std::uint32_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+        {
+            const std::uint64_t candidate = d + graph.weights[e];
+            if (candidate < distance[graph.targets[e]])
+            {
+                distance[graph.targets[e]] = candidate;
+                queue.push({candidate, graph.targets[e]});
+            }
+        }
+    }
+    return distance;
+}
+
+// Dijkstra with a heap of (distance, vertex) and one handle per vertex: improvements are decreaseKey
+template<typename Heap>
+std::vector<std::uint64_t> dijkstraIndexed(const Graph& graph, std::uint32_t source)
+{
+    constexpr std::uint32_t NO_HANDLE = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::uint64_t> distance(graph.offsets.size() - 1, UNREACHED);
+    std::vector<std::uint32_t> handles(distance.size(), NO_HANDLE);
+    Heap heap;
+    distance[source] = 0;
+    handles[source] = heap.push({0, source});
+    while (!heap.empty())
+    {
+        const auto [d, v] = heap.top();
+        heap.pop();
+        for (std::uint32_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+        {
+            const std::uint32_t w = graph.targets[e];
+            const std::uint64_t candidate = d + graph.weights[e];
+            if (candidate < distance[w])
+            {
+                if (distance[w] == UNREACHED) handles[w] = heap.push({candidate, w});
+                else heap.decreaseKey(handles[w], {candidate, w});
+                distance[w] = candidate;
+            }
+        }
+    }
+    return distance;
+}
+
+using DistanceVertex = std::pair<std::uint64_t, std::uint32_t>;
+using Indexed4 = IndexedHeap<DistanceVertex, std::less<>, 4>;
+using Indexed8 = IndexedHeap<DistanceVertex, std::less<>, 8>;
+using Indexed2 = IndexedHeap<DistanceVertex, std::less<>, 2>;
+using Pairing = PairingHeap<DistanceVertex, std::less<>>;
+
+void test_Dijkstra()
+{
+    for (std::uint32_t n : {1u, 10u, 1000u, 20000u})
+    {
+        const Graph graph = randomGraph(n, 4);
+        const std::vector<std::uint64_t> expected = dijkstraLazy(graph, 0);
+        assert(dijkstraIndexed<Indexed4>(graph, 0) == expected);
+        assert(dijkstraIndexed<Indexed8>(graph, 0) == expected);
+        assert(dijkstraIndexed<Indexed2>(graph, 0) == expected);
+        assert(dijkstraIndexed<Pairing>(graph, 0) == expected);
+    }
+}
+
+// n random pushes, then n pops
+template<typename Heap>
+double pushPop(const std::vector<std::uint64_t>& keys)
+{
+    StopWatch stopWatch;
+    stopWatch.Start();
+    {
+        Heap heap;
+        heap.reserve(keys.size());
+        for (std::uint64_t key : keys) heap.push(key);
+        while (!heap.empty())
+        {
+            sink += heap.top();
+            heap.pop();
+        }
+    }
+    stopWatch.Stop();
+    return stopWatch.ElapsedTime();
+}
+
+void benchmark_PushPop(std::size_t n)
+{
+    std::mt19937_64 engine{n};
+    std::vector<std::uint64_t> keys(n);
+    for (std::uint64_t& key : keys) key = engine();
+
+    StopWatch stopWatch;
+    stopWatch.Start();
+    {
+        std::vector<std::uint64_t> heap;
+        heap.reserve(n);
+        for (std::uint64_t key : keys)
+        {
+            heap.push_back(key);
+            std::push_heap(heap.begin(), heap.end(), std::greater<>{});
+        }
+        while (!heap.empty())
+        {
+            sink += heap.front();
+            std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+            heap.pop_back();
+        }
+    }
+    stopWatch.Stop();
+    const double stdHeap = stopWatch.ElapsedTime();
+    stopWatch.Start();
+    {
+        std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<>> heap(std::greater<>{}, keys);
+        while (!heap.empty())
+        {
+            sink += heap.top();
+            heap.pop();
+        }
+    }
+    stopWatch.Stop();
+    const double queue = stopWatch.ElapsedTime();
+
+    const double scale = 1e9 / static_cast<double>(2 * n);
+    std::cout << n << "\t\t" << scale * stdHeap << "\t\t" << scale * queue << "\t\t"
+              << scale * pushPop<IndexedHeap<std::uint64_t, std::less<>, 2>>(keys) << "\t\t"
+              << scale * pushPop<IndexedHeap<std::uint64_t, std::less<>, 4>>(keys) << "\t\t"
+              << scale * pushPop<IndexedHeap<std::uint64_t, std::less<>, 8>>(keys) << "\t\t"
+              << scale * pushPop<PairingHeap<std::uint64_t, std::less<>>>(keys) << std::endl;
+}
+
+// An expiry queue of n orders: each round changes the priority of a random order, and every other round the
+// first order expires and comes back with a new priority. The std heap has no update, so it pushes the new
+// priority and skips stale entries when they reach the top.
+void benchmark_Updates(std::size_t n, std::size_t rounds)
+{
+    std::mt19937_64 engine{n + 1};
+    std::vector<std::uint64_t> keys(rounds);
+    for (std::uint64_t& key : keys) key = engine() >> 1;
+    std::vector<std::uint32_t> targets(rounds);
+    for (std::uint32_t& target : targets) target = static_cast<std::uint32_t>(engine() % n);
+    std::vector<DistanceVertex> entries(n);
+    for (std::uint32_t i = 0; i < n; ++i) entries[i] = {keys[i], i};
+
+    auto mix = [&]<typename Heap>(Heap heap)
+    {
+        StopWatch stopWatch;
+        stopWatch.Start();
+        {
+            std::vector<std::uint32_t> handles(n);
+            for (std::uint32_t i = 0; i < n; ++i) handles[i] = i;
+            for (std::size_t i = 0; i < rounds; ++i)
+            {
+                const std::uint32_t id = targets[i];
+                heap.update(handles[id], {keys[i], id});
+                if (i % 2 == 0)
+                {
+                    const std::uint32_t expired = heap.top().second;
+                    sink += heap.top().first;
+                    heap.pop();
+                    handles[expired] = heap.push({keys[rounds - 1 - i], expired});
+                }
+            }
+        }
+        stopWatch.Stop();
+        return stopWatch.ElapsedTime();
+    };
+
+    StopWatch stopWatch;
+    stopWatch.Start();
+    {
+        std::vector<std::uint64_t> current(n);
+        for (std::uint32_t i = 0; i < n; ++i) current[i] = keys[i];
+        std::priority_queue<DistanceVertex, std::vector<DistanceVertex>, std::greater<>> queue(std::greater<>{}, entries);
+        for (std::size_t i = 0; i < rounds; ++i)
+        {
+            const std::uint32_t id = targets[i];
+            current[id] = keys[i];
+            queue.push({keys[i], id});
+            if (i % 2 == 0)
+            {
+                while (queue.top().first != current[queue.top().second]) queue.pop();
+                const std::uint32_t expired = queue.top().second;
+                sink += queue.top().first;
+                queue.pop();
+                current[expired] = keys[rounds - 1 - i];
+                queue.push({current[expired], expired});
+            }
+        }
+    }
+    stopWatch.Stop();
+    const double lazy = stopWatch.ElapsedTime();
+
+    const double scale = 1e9 / static_cast<double>(rounds);
+    std::cout << n << "\t\t" << scale * lazy << "\t\t" << scale * mix(Indexed2(entries))
+              << "\t\t" << scale * mix(Indexed4(entries)) << "\t\t" << scale * mix(Indexed8(entries)) << "\t\t"
+              << scale * mix(Pairing(entries)) << std::endl;
+}
+
+void benchmark_Dijkstra(std::uint32_t n, std::uint32_t degree)
+{
+    const Graph graph = randomGraph(n, degree);
+    StopWatch stopWatch;
+    stopWatch.Start();
+    sink += dijkstraLazy(graph, 0).back();
+    stopWatch.Stop();
+    const double lazy = stopWatch.ElapsedTime();
+    stopWatch.Start();
+    sink += dijkstraIndexed<Indexed4>(graph, 0).back();
+    stopWatch.Stop();
+    const double indexed4 = stopWatch.ElapsedTime();
+    stopWatch.Start();
+    sink += dijkstraIndexed<Indexed8>(graph, 0).back();
+    stopWatch.Stop();
+    const double indexed8 = stopWatch.ElapsedTime();
+    stopWatch.Start();
+    sink += dijkstraIndexed<Pairing>(graph, 0).back();
+    stopWatch.Stop();
+    const double pairing = stopWatch.ElapsedTime();
+    std::cout << n << "\t" << degree << "\t" << 1e3 * lazy << "\t\t" << 1e3 * indexed4 << "\t\t" << 1e3 * indexed8
+              << "\t\t" << 1e3 * pairing << std::endl;
+}
+
+int main()
+{
+    test_RandomOperations<IndexedHeap<int>>();
+    test_RandomOperations<IndexedHeap<int, std::less<>, 2>>();
+    test_RandomOperations<IndexedHeap<int, std::less<>, 8>>();
+    test_RandomOperations<PairingHeap<int>>();
+    for (std::size_t n : {0, 1, 2, 3, 4, 5, 17, 1000, 4097})
+    {
+        test_BulkConstruction<IndexedHeap<int>>(n);
+        test_BulkConstruction<IndexedHeap<int, std::less<>, 3>>(n);
+        test_BulkConstruction<PairingHeap<int>>(n);
+    }
+    test_MaxHeap();
+    test_Errors<IndexedHeap<int>>();
+    test_Errors<PairingHeap<int>>();
+    test_Dijkstra();
+
+    std::cout << "ns per push or pop of random 64-bit keys" << std::endl;
+    std::cout << "n\t\tpush_heap\tpriority_queue\tbinary\t\t4-ary\t\t8-ary\t\tpairing" << std::endl;
+    for (std::size_t n : {std::size_t{1} << 10, std::size_t{1} << 16, std::size_t{1} << 20, std::size_t{1} << 23}) benchmark_PushPop(n);
+
+    std::cout << "ns per round of an update, with a pop and a push every other round" << std::endl;
+    std::cout << "n\t\tlazy queue\tbinary\t\t4-ary\t\t8-ary\t\tpairing" << std::endl;
+    for (std::size_t n : {std::size_t{1} << 10, std::size_t{1} << 16, std::size_t{1} << 20}) benchmark_Updates(n, std::size_t{1} << 22);
+
+    std::cout << "ms per single-source shortest paths" << std::endl;
+    std::cout << "n\tdegree\tlazy queue\t4-ary\t\t8-ary\t\tpairing" << std::endl;
+    benchmark_Dijkstra(1 << 16, 16);
+    benchmark_Dijkstra(1 << 20, 8);
+    benchmark_Dijkstra(1 << 14, 256);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,319 @@
+//
+// A Pipeline runs the Exercise 6 layers as stages, either fused on the caller's thread or each on its own
+// (optionally pinned) thread connected by SPSC rings with back-pressure.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_PIPELINE_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_PIPELINE_CPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "Pipeline.hpp"
+
+/**
+ * Overloaded ctor. In threaded mode this creates the rings and starts one thread per stage.
+ * @tparam T Data type flowing through the pipeline
+ * @tparam Stages The stage algorithms, each taking T& or std::span<T>
+ * @param settings Mode, batch size, ring capacity and cores to pin the stages to
+ * @param algorithms The stages, from the first (Hardware) to the last (CommunicationLayer)
+ */
+template<typename T, typename... Stages>
+Pipeline<T, Stages...>::Pipeline(PipelineOptions settings, Stages... algorithms)
+    : stages{std::move(algorithms)...}, options{std::move(settings)}, start{std::chrono::steady_clock::now()}
+{
+    options.batchSize = std::max<std::size_t>(options.batchSize, 1);
+    if (options.mode == PipelineMode::Fused)
+    {
+        scratch.resize(options.batchSize);
+        return;
+    }
+
+    for (auto& queue : queues) queue = std::make_unique<SpscRing<T>>(options.queueCapacity);
+    startThreads(std::make_index_sequence<STAGES>{});
+}
+
+/**
+ * Dtor. Waits until every value has passed through the pipeline, then stops and joins the stage threads.
+ */
+template<typename T, typename... Stages>
+Pipeline<T, Stages...>::~Pipeline()
+{
+    if (options.mode == PipelineMode::Fused) return;
+
+    flush();
+    running.store(false, std::memory_order_release);
+    for (auto& thread : threads) thread.join();
+}
+
+/**
+ * Adds to a counter that only the calling thread writes
+ * @param counter The counter
+ * @param amount The amount to add
+ */
+template<typename T, typename... Stages>
+void Pipeline<T, Stages...>::add(std::atomic<std::uint64_t>& counter, std::uint64_t amount) noexcept
+{
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_release);
+}
+
+/**
+ * Hints to the processor that the thread is spinning
+ */
+template<typename T, typename... Stages>
+void Pipeline<T, Stages...>::cpuRelax() noexcept
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/**
+ * Pins a thread to one core. Only supported on Linux; elsewhere the thread is left to the scheduler.
+ * @param thread The thread
+ * @param core The core
+ * @return True if the thread was pinned
+ */
+template<typename T, typename... Stages>
+bool Pipeline<T, Stages...>::pin(std::thread& thread, int core) noexcept
+{
+#if defined(__linux__)
+    if (core < 0 || core >= CPU_SETSIZE) return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+    (void) thread;
+    (void) core;
+    return false;
+#endif
+}
+
+/**
+ * Applies one stage to a batch, in a single call if the stage accepts a std::span
+ * @tparam I Index of the stage
+ * @param values The batch
+ * @param count Number of values in the batch
+ */
+template<typename T, typename... Stages>
+template<std::size_t I>
+void Pipeline<T, Stages...>::apply(T* values, std::size_t count)
+{
+    auto& stage = std::get<I>(stages);
+    if constexpr (std::is_invocable_v<decltype(stage), std::span<T>>)
+    {
+        stage(std::span<T>{values, count});
+    }
+    else
+    {
+        for (std::size_t i = 0; i < count; ++i) stage(values[i]);
+    }
+}
+
+/**
+ * Applies every stage to a batch, stage by stage, and counts the batch for each of them (fused mode)
+ * @param values The batch
+ * @param count Number of values in the batch
+ */
+template<typename T, typename... Stages>
+template<std::size_t... I>
+void Pipeline<T, Stages...>::applyAll(T* values, std::size_t count, std::index_sequence<I...>)
+{
+    (apply<I>(values, count), ...);
+    for (Counters& stage : counters)
+    {
+        add(stage.processed, count);
+        add(stage.batches, 1);
+    }
+}
+
+/**
+ * Starts one thread per stage and pins it if cores were given
+ */
+template<typename T, typename... Stages>
+template<std::size_t... I>
+void Pipeline<T, Stages...>::startThreads(std::index_sequence<I...>)
+{
+    threads.reserve(STAGES);
+    (threads.emplace_back([this] { runStage<I>(); }), ...);
+
+    if (options.cores.empty()) return;
+    for (std::size_t i = 0; i < STAGES; ++i)
+    {
+        int core = options.cores[i % options.cores.size()];
+        if (pin(threads[i], core)) counters[i].core = core;
+    }
+}
+
+/**
+ * Stage thread: takes batches from the stage's ring, applies the stage and forwards them to the next ring
+ * @tparam I Index of the stage
+ */
+template<typename T, typename... Stages>
+template<std::size_t I>
+void Pipeline<T, Stages...>::runStage()
+{
+    SpscRing<T>& queue = *queues[I];
+    Counters& own = counters[I];
+    std::vector<T> batch(options.batchSize);
+
+    int idle = 0;
+    while (true)
+    {
+        std::size_t count = queue.pop(batch.data(), batch.size());
+        if (count == 0)
+        {
+            if (!running.load(std::memory_order_acquire)) return;
+            if (++idle < IDLE_SPINS) cpuRelax();
+            else std::this_thread::yield();
+            continue;
+        }
+        idle = 0;
+
+        std::size_t depth = count + queue.size();
+        if (depth > own.maxQueueDepth.load(std::memory_order_relaxed)) own.maxQueueDepth.store(depth, std::memory_order_relaxed);
+
+        apply<I>(batch.data(), count);
+        if constexpr (I + 1 < STAGES) forward(I + 1, batch.data(), count);
+
+        add(own.batches, 1);
+        add(own.processed, count);
+    }
+}
+
+/**
+ * Hands values to a stage, waiting while its ring is full
+ * @param stage Index of the receiving stage
+ * @param values The values
+ * @param count Number of values
+ */
+template<typename T, typename... Stages>
+void Pipeline<T, Stages...>::forward(std::size_t stage, const T* values, std::size_t count)
+{
+    SpscRing<T>& queue = *queues[stage];
+    bool stalled = false;
+    int idle = 0;
+    while (true)
+    {
+        std::size_t n = queue.push(values, count);
+        values += n;
+        count -= n;
+        if (count == 0) return;
+
+        if (!stalled)
+        {
+            add(counters[stage].stalls, 1);
+            stalled = true;
+        }
+        if (++idle < IDLE_SPINS) cpuRelax();
+        else std::this_thread::yield();
+    }
+}
+
+/**
+ * Returns the counters of a stage
+ * @param stage Index of the stage, 0 being the first
+ * @return Values processed, batches, back-pressure stalls, queue depth, throughput and pinned core
+ * @throws std::out_of_range if there is no such stage
+ */
+template<typename T, typename... Stages>
+StageStatistics Pipeline<T, Stages...>::statistics(std::size_t stage) const
+{
+    if (stage >= STAGES) throw std::out_of_range("Stage " + std::to_string(stage) + " is out of range");
+
+    const Counters& own = counters[stage];
+    std::uint64_t processed = own.processed.load(std::memory_order_acquire);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return StageStatistics{processed,
+                           own.batches.load(std::memory_order_acquire),
+                           own.stalls.load(std::memory_order_acquire),
+                           queues[stage] ? queues[stage]->size() : 0,
+                           own.maxQueueDepth.load(std::memory_order_relaxed),
+                           seconds > 0 ? static_cast<double>(processed) / seconds : 0.0,
+                           own.core};
+}
+
+/**
+ * Sends one value through the pipeline. In threaded mode this waits while the first stage's ring is full.
+ * @param value The value
+ */
+template<typename T, typename... Stages>
+void Pipeline<T, Stages...>::push(const T& value)
+{
+    if (options.mode == PipelineMode::Fused)
+    {
+        T copy = value;
+        applyAll(&copy, 1, std::make_index_sequence<STAGES>{});
+        return;
+    }
+
+    forward(0, &value, 1);
+    ++ingested;
+}
+
+/**
+ * Sends a block of values through the pipeline, in batches
+ * @param values The values
+ */
+template<typename T, typename... Stages>
+void Pipeline<T, Stages...>::push(std::span<const T> values)
+{
+    if (options.mode == PipelineMode::Fused)
+    {
+        for (std::size_t first = 0; first < values.size(); first += scratch.size())
+        {
+            std::size_t count = std::min(scratch.size(), values.size() - first);
+            std::copy_n(values.begin() + first, count, scratch.begin());
+            applyAll(scratch.data(), count, std::make_index_sequence<STAGES>{});
+        }
+        return;
+    }
+
+    forward(0, values.data(), values.size());
+    ingested += values.size();
+}
+
+/**
+ * Waits until every value pushed so far has left the last stage
+ */
+template<typename T, typename... Stages>
+void Pipeline<T, Stages...>::flush()
+{
+    if (options.mode == PipelineMode::Fused) return;
+
+    while (counters[STAGES - 1].processed.load(std::memory_order_acquire) != ingested) std::this_thread::yield();
+}
+
+/**
+ * Creates a Pipeline, deducing the stage types from the algorithms
+ * @tparam T Data type flowing through the pipeline
+ * @tparam Stages The stage algorithms, each taking T& or std::span<T>
+ * @param settings Mode, batch size, ring capacity and cores to pin the stages to
+ * @param algorithms The stages, from first to last
+ * @return The pipeline
+ */
+template<typename T, typename... Stages>
+Pipeline<T, Stages...> makePipeline(PipelineOptions settings, Stages... algorithms)
+{
+    return Pipeline<T, Stages...>(std::move(settings), std::move(algorithms)...);
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_PIPELINE_CPP
@@ -0,0 +1,137 @@
+//
+// A Pipeline runs the layers of Exercise 6 (Hardware -> DataLayer -> CommunicationLayer) as stages. In
+// Exercise 6 every layer runs synchronously on the caller's thread, one value at a time, inside signals2's
+// slot-call machinery. Here each stage can instead run on its own thread, optionally pinned to a core:
+//
+//  - Stage i reads from its own SpscRing, applies its algorithm to a whole batch and forwards the batch to
+//    stage i + 1. When the next ring is full the stage waits (back-pressure), so a slow stage throttles the
+//    stages in front of it and ultimately push() instead of letting queues grow without bound.
+//  - With every stage on its own core, the stages work on different batches at the same time, so ingest
+//    throughput is limited by the slowest stage rather than by the sum of all stages.
+//  - The fused mode runs every stage inline in push(). For cheap stages or small workloads that avoids the
+//    cross-core hand-off entirely, and the compiler can inline all the algorithms into one loop.
+//
+// A stage is any callable taking T& (applied to every value) or std::span<T> (applied to a whole batch).
+// Stages are template parameters, so neither mode pays for std::function or a virtual call. Per-stage
+// counters report values processed, batches, throughput, queue depth and back-pressure stalls.
+//
+// push() and flush() must be called from a single producer thread, just like emitting the Exercise 6 signal.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_PIPELINE_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_PIPELINE_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "SpscRing.hpp"
+
+enum class PipelineMode
+{
+    Fused,      // Every stage runs inline on the thread that calls push()
+    Threaded    // Every stage runs on its own thread
+};
+
+struct PipelineOptions
+{
+    PipelineMode mode = PipelineMode::Threaded;
+    std::size_t batchSize = 64;         // Largest number of values a stage processes at once
+    std::size_t queueCapacity = 4096;   // Capacity of each stage's input ring
+    std::vector<int> cores{};           // Stage i is pinned to cores[i % cores.size()]; empty means unpinned
+};
+
+struct StageStatistics
+{
+    std::uint64_t processed;      // Values that left the stage
+    std::uint64_t batches;        // Number of times the stage ran its algorithm
+    std::uint64_t stalls;         // Times the upstream side found this stage's input ring full
+    std::size_t queueDepth;       // Values currently waiting in the input ring
+    std::size_t maxQueueDepth;    // Largest queue depth seen by the stage
+    double throughput;            // Values per second since the pipeline was created
+    int core;                     // Core the stage is pinned to, or -1
+};
+
+template<typename T, typename... Stages>
+class Pipeline
+{
+private:
+    static constexpr std::size_t STAGES = sizeof...(Stages);
+    static constexpr int IDLE_SPINS = 256;
+    static_assert(STAGES > 0, "A Pipeline needs at least one stage");
+
+    // Every counter has a single writer, so it is updated with a plain load and store
+    struct alignas(64) Counters
+    {
+        std::atomic<std::uint64_t> processed{0};
+        std::atomic<std::uint64_t> batches{0};
+        std::atomic<std::uint64_t> stalls{0};
+        std::atomic<std::size_t> maxQueueDepth{0};
+        int core{-1};
+    };
+
+    std::tuple<Stages...> stages;
+    PipelineOptions options;
+    std::array<std::unique_ptr<SpscRing<T>>, STAGES> queues;   // queues[i] feeds stage i
+    std::array<Counters, STAGES> counters;
+    std::vector<T> scratch;                                    // Fused mode batch buffer
+    std::uint64_t ingested{0};
+    std::atomic<bool> running{true};
+    std::chrono::steady_clock::time_point start;
+    std::vector<std::thread> threads;
+
+    static void add(std::atomic<std::uint64_t>& counter, std::uint64_t amount) noexcept;
+    static void cpuRelax() noexcept;
+    static bool pin(std::thread& thread, int core) noexcept;
+
+    template<std::size_t I>
+    void apply(T* values, std::size_t count);
+    template<std::size_t... I>
+    void applyAll(T* values, std::size_t count, std::index_sequence<I...>);
+    template<std::size_t... I>
+    void startThreads(std::index_sequence<I...>);
+    template<std::size_t I>
+    void runStage();
+    void forward(std::size_t stage, const T* values, std::size_t count);
+
+public:
+    Pipeline() = delete;
+    explicit Pipeline(PipelineOptions settings, Stages... algorithms);
+    Pipeline(const Pipeline& other) = delete;
+    Pipeline(Pipeline&& other) = delete;
+    ~Pipeline();
+
+    // Operator Overloads
+    Pipeline& operator=(const Pipeline& other) = delete;
+    Pipeline& operator=(Pipeline&& other) = delete;
+
+    // Accessors
+    PipelineMode mode() const noexcept { return options.mode; }
+    std::size_t stageCount() const noexcept { return STAGES; }
+    StageStatistics statistics(std::size_t stage) const;
+
+    // Core Functionality
+    void push(const T& value);
+    void push(std::span<const T> values);
+    void flush();
+};
+
+template<typename T, typename... Stages>
+Pipeline<T, Stages...> makePipeline(PipelineOptions settings, Stages... algorithms);
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_PIPELINE_CPP
+#include "Pipeline.cpp"
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_PIPELINE_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_PIPELINE_HPP
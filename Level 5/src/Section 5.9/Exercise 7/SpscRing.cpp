@@ -0,0 +1,82 @@
+//
+// A bounded single-producer/single-consumer ring buffer that connects two pipeline stages.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SPSCRING_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SPSCRING_CPP
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#include "SpscRing.hpp"
+
+/**
+ * Overloaded ctor
+ * @tparam T Data type of the elements
+ * @param capacity Maximum number of elements in flight, rounded up to a power of two
+ */
+template<typename T>
+SpscRing<T>::SpscRing(std::size_t capacity)
+    : buffer{std::make_unique<T[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2)))},
+      mask{std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1}
+{
+}
+
+/**
+ * Returns the number of elements waiting in the ring. Exact when called by the producer or the consumer
+ * while the other side is idle, otherwise a snapshot.
+ * @tparam T Data type of the elements
+ * @return The queue depth
+ */
+template<typename T>
+std::size_t SpscRing<T>::size() const noexcept
+{
+    std::size_t first = head.load(std::memory_order_acquire);
+    std::size_t last = tail.load(std::memory_order_acquire);
+    return last - first;
+}
+
+/**
+ * Appends up to count values. Must only be called by the producer.
+ * @tparam T Data type of the elements
+ * @param values The values to append
+ * @param count Number of values
+ * @return Number of values appended; fewer than count when the ring fills up
+ */
+template<typename T>
+std::size_t SpscRing<T>::push(const T* values, std::size_t count)
+{
+    const std::size_t last = tail.load(std::memory_order_relaxed);
+    if (last - cachedHead + count > capacity()) cachedHead = head.load(std::memory_order_acquire);
+
+    const std::size_t n = std::min(count, capacity() - (last - cachedHead));
+    for (std::size_t i = 0; i < n; ++i) buffer[(last + i) & mask] = values[i];
+
+    tail.store(last + n, std::memory_order_release);
+    return n;
+}
+
+/**
+ * Removes up to count values, oldest first. Must only be called by the consumer.
+ * @tparam T Data type of the elements
+ * @param values Receives the values
+ * @param count Largest number of values to remove
+ * @return Number of values removed; zero when the ring is empty
+ */
+template<typename T>
+std::size_t SpscRing<T>::pop(T* values, std::size_t count)
+{
+    const std::size_t first = head.load(std::memory_order_relaxed);
+    if (cachedTail - first < count) cachedTail = tail.load(std::memory_order_acquire);
+
+    const std::size_t n = std::min(count, cachedTail - first);
+    for (std::size_t i = 0; i < n; ++i) values[i] = std::move(buffer[(first + i) & mask]);
+
+    head.store(first + n, std::memory_order_release);
+    return n;
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SPSCRING_CPP
@@ -0,0 +1,56 @@
+//
+// A bounded single-producer/single-consumer ring buffer that connects two pipeline stages. The producer only
+// writes tail and the consumer only writes head, so neither needs a lock or a CAS. Each side keeps a cached
+// copy of the other side's index and only reloads it when the cached value says the ring is full (or empty),
+// which keeps the two cache lines from bouncing between cores on every element. Values are moved in batches:
+// one index update publishes a whole batch.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SPSCRING_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+template<typename T>
+class SpscRing
+{
+private:
+    std::unique_ptr<T[]> buffer;
+    std::size_t mask;
+
+    alignas(64) std::atomic<std::size_t> head{0};   // Next element to pop, written by the consumer
+    std::size_t cachedTail{0};                       // Consumer's copy of tail
+
+    alignas(64) std::atomic<std::size_t> tail{0};   // Next free slot, written by the producer
+    std::size_t cachedHead{0};                       // Producer's copy of head
+
+public:
+    SpscRing() = delete;
+    explicit SpscRing(std::size_t capacity);
+    SpscRing(const SpscRing<T>& other) = delete;
+    SpscRing(SpscRing<T>&& other) = delete;
+    ~SpscRing() = default;
+
+    // Operator Overloads
+    SpscRing<T>& operator=(const SpscRing<T>& other) = delete;
+    SpscRing<T>& operator=(SpscRing<T>&& other) = delete;
+
+    // Accessors
+    std::size_t capacity() const noexcept { return mask + 1; }
+    std::size_t size() const noexcept;
+
+    // Core Functionality
+    std::size_t push(const T* values, std::size_t count);
+    std::size_t pop(T* values, std::size_t count);
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SPSCRING_CPP
+#include "SpscRing.cpp"
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SPSCRING_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SPSCRING_HPP
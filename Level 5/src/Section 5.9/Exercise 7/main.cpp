@@ -0,0 +1,288 @@
+//
+// Runs the Hardware -> DataLayer -> CommunicationLayer chain of Exercise 6 as a Pipeline, fused on one thread
+// and with every layer on its own thread, and checks that both produce exactly what the signals2 chain
+// produces. A benchmark compares the ingest throughput of the signals2 chain, the fused pipeline and the
+// threaded pipeline as the work is split across more stages.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/signals2.hpp>
+
+#include "Pipeline.hpp"
+#include "SpscRing.hpp"
+#include "StopWatch.hpp"
+
+// Used for code maintainability
+using value_type = double;
+
+// The Exercise 6 algorithms
+auto validation = [](value_type& value) { if (value < 2 || value > 5) value = 3; };
+auto modifier = [](value_type& value) { value *= value; };
+
+// Synthetic stage of adjustable cost, for the scaling benchmark
+struct Work
+{
+    int iterations;
+
+    void operator()(value_type& value) const
+    {
+        for (int i = 0; i < iterations; ++i) value = std::sqrt(value * value + 1.0) - 0.5;
+    }
+};
+
+// Values spread across the valid and invalid ranges of the Hardware layer
+std::vector<value_type> makeInput(std::size_t count)
+{
+    std::vector<value_type> input(count);
+    for (std::size_t i = 0; i < count; ++i) input[i] = static_cast<value_type>(i % 97) / 10.0 - 1.0;
+    return input;
+}
+
+// Runs the input through the signals2 chain of Exercise 6, recording what the Communication layer receives
+std::vector<value_type> runSignals(const std::vector<value_type>& input)
+{
+    std::vector<value_type> output;
+    boost::signals2::signal<void (value_type&)> signalExterior, signalHardware, signalData;
+    signalExterior.connect([&signalHardware](value_type& value) { validation(value); signalHardware(value); });
+    signalHardware.connect([&signalData](value_type& value) { modifier(value); signalData(value); });
+    signalData.connect([&output](value_type& value) { output.push_back(value); });
+
+    for (value_type value : input) signalExterior(value);
+    return output;
+}
+
+// Test the SPSC ring on its own: wrap-around, partial pushes when full and partial pops
+void test_SpscRing()
+{
+    SpscRing<int> ring{5};
+    assert(8 == ring.capacity());
+
+    std::vector<int> values{1, 2, 3, 4, 5, 6};
+    std::vector<int> out(8);
+    for (int round = 0; round < 10; ++round)
+    {
+        assert(6 == ring.push(values.data(), 6));
+        assert(2 == ring.push(values.data(), 6));
+        assert(8 == ring.size());
+        assert(0 == ring.push(values.data(), 1));
+
+        assert(3 == ring.pop(out.data(), 3));
+        assert(1 == out[0] && 3 == out[2]);
+        assert(5 == ring.pop(out.data(), 8));
+        assert(4 == out[0] && 6 == out[2] && 1 == out[3] && 2 == out[4]);
+        assert(0 == ring.pop(out.data(), 8));
+    }
+
+    // A producer and a consumer thread pass a sequence through a small ring
+    SpscRing<int> shared{16};
+    constexpr int COUNT = 200000;
+    std::thread producer([&shared]
+    {
+        std::vector<int> block(7);
+        for (int next = 0; next < COUNT;)
+        {
+            int n = std::min<int>(7, COUNT - next);
+            for (int i = 0; i < n; ++i) block[i] = next + i;
+            int pushed = static_cast<int>(shared.push(block.data(), n));
+            if (pushed == 0) std::this_thread::yield();
+            next += pushed;
+        }
+    });
+
+    std::vector<int> block(5);
+    for (int expected = 0; expected < COUNT;)
+    {
+        std::size_t n = shared.pop(block.data(), block.size());
+        if (n == 0) std::this_thread::yield();
+        for (std::size_t i = 0; i < n; ++i) assert(expected++ == block[i]);
+    }
+    producer.join();
+}
+
+// Both modes deliver the same values, in the same order, as the signals2 chain
+void test_MatchesSignals(PipelineMode mode)
+{
+    std::vector<value_type> input = makeInput(10000);
+    std::vector<value_type> expected = runSignals(input);
+
+    std::vector<value_type> output;
+    auto communication = [&output](value_type& value) { output.push_back(value); };
+    {
+        auto pipeline = makePipeline<value_type>({.mode = mode, .batchSize = 32, .queueCapacity = 256},
+                                                 validation, modifier, communication);
+        assert(3 == pipeline.stageCount());
+
+        // Single values and blocks may be mixed
+        for (std::size_t i = 0; i < 1000; ++i) pipeline.push(input[i]);
+        pipeline.push(std::span<const value_type>{input}.subspan(1000));
+        pipeline.flush();
+
+        for (std::size_t stage = 0; stage < 3; ++stage)
+        {
+            StageStatistics statistics = pipeline.statistics(stage);
+            assert(input.size() == statistics.processed);
+            assert(statistics.batches >= input.size() / 32);
+            assert(0 == statistics.queueDepth);
+        }
+    }
+    assert(expected == output);
+}
+
+// A slow last stage pushes back on the earlier stages and on push() without losing or reordering values
+void test_BackPressure()
+{
+    std::vector<value_type> output;
+    auto slow = [&output](value_type& value)
+    {
+        output.push_back(value);
+        if (output.size() % 64 == 0) std::this_thread::sleep_for(std::chrono::microseconds(50));
+    };
+
+    auto pipeline = makePipeline<value_type>({.batchSize = 8, .queueCapacity = 16}, modifier, slow);
+    std::vector<value_type> input = makeInput(20000);
+    pipeline.push(std::span<const value_type>{input});
+    pipeline.flush();
+
+    assert(input.size() == output.size());
+    for (std::size_t i = 0; i < input.size(); ++i) assert(input[i] * input[i] == output[i]);
+
+    StageStatistics first = pipeline.statistics(0);
+    StageStatistics last = pipeline.statistics(1);
+    assert(first.stalls > 0 || last.stalls > 0);
+    assert(first.maxQueueDepth <= 16 && last.maxQueueDepth <= 16);
+
+    std::string message;
+    try { pipeline.statistics(2); }
+    catch (const std::out_of_range& e) { message = e.what(); }
+    assert("Stage 2 is out of range" == message);
+}
+
+// Stages taking a std::span receive whole batches, never larger than the batch size
+void test_BatchStage()
+{
+    std::size_t largest = 0;
+    value_type total = 0;
+    auto sum = [&largest, &total](std::span<value_type> batch)
+    {
+        largest = std::max(largest, batch.size());
+        for (value_type value : batch) total += value;
+    };
+
+    for (PipelineMode mode : {PipelineMode::Fused, PipelineMode::Threaded})
+    {
+        largest = 0;
+        total = 0;
+        auto pipeline = makePipeline<value_type>({.mode = mode, .batchSize = 50}, sum);
+        std::vector<value_type> input(1000, 1.0);
+        pipeline.push(std::span<const value_type>{input});
+        pipeline.flush();
+
+        assert(1000 == total);
+        assert(largest <= 50);
+        if (mode == PipelineMode::Fused) assert(20 == pipeline.statistics(0).batches);
+    }
+}
+
+// Stages are pinned round-robin to the given cores
+void test_Pinning()
+{
+    auto pipeline = makePipeline<value_type>({.cores = {0}}, validation, modifier);
+#if defined(__linux__)
+    assert(0 == pipeline.statistics(0).core);
+    assert(0 == pipeline.statistics(1).core);
+#endif
+
+    auto unpinned = makePipeline<value_type>({}, validation);
+    assert(-1 == unpinned.statistics(0).core);
+}
+
+// A pipeline of N stages that share a fixed amount of work per value
+template<std::size_t... I>
+auto makeWorkPipeline(PipelineOptions options, int totalWork, std::index_sequence<I...>)
+{
+    return makePipeline<value_type>(std::move(options), ((void) I, Work{totalWork / static_cast<int>(sizeof...(I))})...);
+}
+
+// Ingest throughput (millions of values per second) of a pipeline with N stages
+template<std::size_t N>
+double benchmark_Stages(PipelineMode mode, const std::vector<value_type>& input, int totalWork)
+{
+    std::vector<int> cores;
+    for (std::size_t i = 0; i < N; ++i) cores.push_back(static_cast<int>(i % std::max(1U, std::thread::hardware_concurrency())));
+
+    auto pipeline = makeWorkPipeline({.mode = mode, .batchSize = 64, .queueCapacity = 4096, .cores = cores},
+                                     totalWork, std::make_index_sequence<N>{});
+    StopWatch stopWatch;
+    stopWatch.Start();
+    pipeline.push(std::span<const value_type>{input});
+    pipeline.flush();
+    stopWatch.Stop();
+    double seconds = stopWatch.ElapsedTime();
+    return static_cast<double>(input.size()) / seconds / 1e6;
+}
+
+// Ingest throughput of the signals2 chain with the same amount of work split across N layers
+double benchmark_Signals(const std::vector<value_type>& input, int totalWork, int layers)
+{
+    std::vector<boost::signals2::signal<void (value_type&)>> signals(layers + 1);
+    Work work{totalWork / layers};
+    for (int i = 0; i < layers; ++i)
+    {
+        auto* next = &signals[i + 1];
+        signals[i].connect([work, next](value_type& value) { work(value); (*next)(value); });
+    }
+    value_type sink = 0;
+    signals[layers].connect([&sink](value_type& value) { sink += value; });
+
+    StopWatch stopWatch;
+    stopWatch.Start();
+    for (value_type value : input) signals[0](value);
+    stopWatch.Stop();
+    double seconds = stopWatch.ElapsedTime();
+    return static_cast<double>(input.size()) / seconds / 1e6;
+}
+
+int main()
+{
+    test_SpscRing();
+    test_MatchesSignals(PipelineMode::Fused);
+    test_MatchesSignals(PipelineMode::Threaded);
+    test_BackPressure();
+    test_BatchStage();
+    test_Pinning();
+
+    std::vector<value_type> input = makeInput(1 << 18);
+    std::cout << std::fixed << std::setprecision(2)
+              << "Ingest throughput (millions of values/s) on " << std::thread::hardware_concurrency() << " cores\n"
+              << "work/value\tstages\tsignals2\tfused\tthreaded" << std::endl;
+    for (int totalWork : {0, 64, 256})
+    {
+        auto row = [&](int stages, double fused, double threaded)
+        {
+            std::cout << totalWork << "\t\t" << stages << "\t" << benchmark_Signals(input, totalWork, stages)
+                      << "\t\t" << fused << "\t" << threaded << std::endl;
+        };
+        row(1, benchmark_Stages<1>(PipelineMode::Fused, input, totalWork), benchmark_Stages<1>(PipelineMode::Threaded, input, totalWork));
+        row(2, benchmark_Stages<2>(PipelineMode::Fused, input, totalWork), benchmark_Stages<2>(PipelineMode::Threaded, input, totalWork));
+        row(4, benchmark_Stages<4>(PipelineMode::Fused, input, totalWork), benchmark_Stages<4>(PipelineMode::Threaded, input, totalWork));
+    }
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+//
+// The default Combiner of Signal: returns the result of the last slot
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_LASTVALUE_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_LASTVALUE_CPP
+
+#include "LastValue.hpp"
+
+/**
+ * Calls every slot and returns the result of the last one
+ * @tparam T The result type of the slots
+ * @tparam InputIterator A generic type of iterator
+ * @param first A begin iterator for a Signal
+ * @param last An end iterator for a Signal
+ * @return The result of the last slot, or T{} if there are no slots
+ */
+template<typename T>
+template<typename InputIterator>
+T LastValue<T>::operator()(InputIterator first, InputIterator last) const
+{
+    T value{};
+    while (first != last)
+    {
+        value = *first;
+        ++first;
+    }
+    return value;
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_LASTVALUE_CPP
@@ -0,0 +1,25 @@
+//
+// The default Combiner of Signal: calls every slot and returns the result of the last one, or T{} when no
+// slot is connected. This matches boost::signals2's optional_last_value without the optional.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_LASTVALUE_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_LASTVALUE_HPP
+
+template<typename T>
+struct LastValue
+{
+    typedef T result_type;
+
+    template<typename InputIterator>
+    T operator()(InputIterator first, InputIterator last) const;
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_LASTVALUE_CPP
+#include "LastValue.cpp"
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_LASTVALUE_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_LASTVALUE_HPP
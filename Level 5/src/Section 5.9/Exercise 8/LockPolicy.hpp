@@ -0,0 +1,37 @@
+//
+// Lock policies for Signal. A policy is a Lockable type with a THREAD_SAFE flag.
+//
+// NoLock is for signals that are only used from one thread: locking compiles away and emitting walks the
+// slot list directly. MutexLock is for signals that are connected, disconnected and emitted from several
+// threads: a std::mutex guards the slot list, but it is only held long enough to take a snapshot of the
+// list, never while slots run.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_LOCKPOLICY_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_LOCKPOLICY_HPP
+
+#include <mutex>
+
+struct NoLock
+{
+    static constexpr bool THREAD_SAFE = false;
+
+    void lock() noexcept {}
+    void unlock() noexcept {}
+};
+
+class MutexLock
+{
+private:
+    std::mutex mutex;
+
+public:
+    static constexpr bool THREAD_SAFE = true;
+
+    void lock() { mutex.lock(); }
+    void unlock() { mutex.unlock(); }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_LOCKPOLICY_HPP
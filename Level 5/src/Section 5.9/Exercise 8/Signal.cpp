@@ -0,0 +1,172 @@
+//
+// A lightweight signal with pluggable locking, inline slot storage and a parallel emit mode
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SIGNAL_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SIGNAL_CPP
+
+#include <algorithm>
+#include <utility>
+
+#include "Signal.hpp"
+
+/**
+ * Overloaded ctor
+ * @tparam R The result type of the slots
+ * @tparam Args The parameter types of the slots
+ * @tparam Combiner Reduces the slot results to the result of an emit
+ * @tparam LockPolicy NoLock or MutexLock
+ * @param reducer The combiner
+ */
+template<typename R, typename... Args, typename Combiner, typename LockPolicy>
+Signal<R (Args...), Combiner, LockPolicy>::Signal(Combiner reducer)
+    : slots{std::make_shared<const SlotList>()}, combiner{std::move(reducer)}
+{
+}
+
+/**
+ * Installs a new slot list. Must be called with slotsLock held. Under NoLock a list that an emit is still
+ * walking is retired rather than destroyed.
+ * @param list The new slot list
+ */
+template<typename R, typename... Args, typename Combiner, typename LockPolicy>
+void Signal<R (Args...), Combiner, LockPolicy>::replace(std::shared_ptr<const SlotList> list)
+{
+    if constexpr (!LockPolicy::THREAD_SAFE)
+    {
+        if (emitting > 0) retired.push_back(std::move(slots));
+    }
+    slots = std::move(list);
+}
+
+/**
+ * Emits the signal: the combiner receives iterators that call the slots in the order they were connected
+ * @param args The arguments passed to every slot
+ * @return The combiner's result
+ */
+template<typename R, typename... Args, typename Combiner, typename LockPolicy>
+typename Signal<R (Args...), Combiner, LockPolicy>::result_type
+Signal<R (Args...), Combiner, LockPolicy>::operator()(Args... args)
+{
+    Snapshot snapshot{*this};
+    const SlotList& list = *snapshot;
+
+    if constexpr (std::is_void_v<R>)
+    {
+        for (const Connection& connection : list) connection.function(args...);
+    }
+    else
+    {
+        std::tuple<Args&...> arguments{args...};
+        return combiner(SlotCallIterator{list.data(), &arguments},
+                        SlotCallIterator{list.data() + list.size(), &arguments});
+    }
+}
+
+/**
+ * @return The number of connected slots
+ */
+template<typename R, typename... Args, typename Combiner, typename LockPolicy>
+std::size_t Signal<R (Args...), Combiner, LockPolicy>::slotCount() const
+{
+    std::lock_guard<LockPolicy> lock{slotsLock};
+    return slots->size();
+}
+
+/**
+ * @return True if no slot is connected
+ */
+template<typename R, typename... Args, typename Combiner, typename LockPolicy>
+bool Signal<R (Args...), Combiner, LockPolicy>::empty() const
+{
+    return slotCount() == 0;
+}
+
+/**
+ * Connects a slot after the slots already connected
+ * @param slot A callable with the signal's signature
+ * @return An id for disconnect()
+ */
+template<typename R, typename... Args, typename Combiner, typename LockPolicy>
+std::uint64_t Signal<R (Args...), Combiner, LockPolicy>::connect(Slot slot)
+{
+    std::lock_guard<LockPolicy> lock{slotsLock};
+    auto list = std::make_shared<SlotList>();
+    list->reserve(slots->size() + 1);
+    list->insert(list->end(), slots->begin(), slots->end());
+    list->push_back(Connection{nextId, std::move(slot)});
+
+    replace(std::move(list));
+    return nextId++;
+}
+
+/**
+ * Disconnects a slot. An emit that is already running may still call it.
+ * @param id The id returned by connect()
+ * @return False if no slot has that id
+ */
+template<typename R, typename... Args, typename Combiner, typename LockPolicy>
+bool Signal<R (Args...), Combiner, LockPolicy>::disconnect(std::uint64_t id)
+{
+    std::lock_guard<LockPolicy> lock{slotsLock};
+    auto found = std::find_if(slots->begin(), slots->end(), [id](const Connection& c) { return c.id == id; });
+    if (found == slots->end()) return false;
+
+    auto list = std::make_shared<SlotList>();
+    list->reserve(slots->size() - 1);
+    list->insert(list->end(), slots->begin(), found);
+    list->insert(list->end(), found + 1, slots->end());
+
+    replace(std::move(list));
+    return true;
+}
+
+/**
+ * Disconnects every slot
+ */
+template<typename R, typename... Args, typename Combiner, typename LockPolicy>
+void Signal<R (Args...), Combiner, LockPolicy>::disconnectAll()
+{
+    std::lock_guard<LockPolicy> lock{slotsLock};
+    replace(std::make_shared<const SlotList>());
+}
+
+/**
+ * Emits the signal with the slots running in parallel on a thread pool, then reduces their results, in
+ * connection order, with the combiner
+ * @param pool The thread pool
+ * @param args The arguments passed to every slot; slots must not modify them
+ * @return The combiner's result
+ * @throws The first exception thrown by a slot, once every slot has finished
+ */
+template<typename R, typename... Args, typename Combiner, typename LockPolicy>
+typename Signal<R (Args...), Combiner, LockPolicy>::result_type
+Signal<R (Args...), Combiner, LockPolicy>::emitParallel(ThreadPool& pool, Args... args)
+{
+    Snapshot snapshot{*this};
+    const SlotList& list = *snapshot;
+
+    if constexpr (std::is_void_v<R>)
+    {
+        pool.parallelFor(list.size(), [&](std::size_t i) { list[i].function(args...); });
+    }
+    else
+    {
+        static_assert(std::is_default_constructible_v<R>, "emitParallel() needs default constructible results");
+
+        std::lock_guard<LockPolicy> lock{resultsLock};
+        if (resultCapacity < list.size())
+        {
+            results = std::make_unique<Result[]>(list.size());
+            resultCapacity = list.size();
+        }
+
+        Result* out = results.get();
+        pool.parallelFor(list.size(), [&](std::size_t i) { out[i] = list[i].function(args...); });
+        return combiner(out, out + list.size());
+    }
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SIGNAL_CPP
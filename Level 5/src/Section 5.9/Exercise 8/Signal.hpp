@@ -0,0 +1,186 @@
+//
+// A lightweight signal with the same shape as boost::signals2::signal: Signal<double (double, double),
+// SumCombiner<double>> connects slots, and emitting it hands the combiner a pair of iterators that call the
+// slots one by one as they are dereferenced (so BootstrapCheck can stop at the first false).
+//
+// boost::signals2 locks the signal's mutex on every emit, and the mutex of every connection as its slot is
+// reached, even when everything runs on one thread. This Signal avoids that and never allocates on emit:
+//
+//  - The slot list is an immutable vector behind a shared_ptr. connect/disconnect build a new list
+//    (copy-on-write), so an emit simply walks the current list.
+//  - The LockPolicy decides what that costs. With NoLock emitting takes no lock and no reference count;
+//    a list replaced while an emit is walking it is kept alive until the outermost emit returns. With
+//    MutexLock the mutex is only held to copy the shared_ptr, never while slots run.
+//  - Slots are SlotFunctions, which store small callables inline, so connecting a lambda does not allocate
+//    either.
+//
+// emitParallel() runs the slots on a ThreadPool and reduces their results with the combiner once all of them
+// are done. It suits slots that are independent and expensive; the slots must be safe to run concurrently
+// and must not modify their (shared) arguments, and a combiner cannot short-circuit because every slot has
+// already run. Results go into a buffer owned by the signal that only grows when slots are added.
+//
+// As in signals2, an emit that has started calls the slots that were connected when it started. Signatures
+// with rvalue reference parameters are not supported.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SIGNAL_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SIGNAL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "LastValue.hpp"
+#include "LockPolicy.hpp"
+#include "SlotFunction.hpp"
+#include "ThreadPool.hpp"
+
+template<typename Signature, typename Combiner = LastValue<typename SlotFunction<Signature>::result_type>,
+         typename LockPolicy = NoLock>
+class Signal;
+
+template<typename R, typename... Args, typename Combiner, typename LockPolicy>
+class Signal<R (Args...), Combiner, LockPolicy>
+{
+    static_assert((!std::is_rvalue_reference_v<Args> && ...), "Signal parameters cannot be rvalue references");
+
+public:
+    using Slot = SlotFunction<R (Args...)>;
+    using result_type = typename Combiner::result_type;
+
+private:
+    struct Connection
+    {
+        std::uint64_t id;
+        Slot function;
+    };
+
+    using SlotList = std::vector<Connection>;
+    using Result = std::conditional_t<std::is_void_v<R>, char, R>;
+
+    // Keeps the slot list that an emit walks alive until the emit returns
+    class Snapshot
+    {
+    private:
+        Signal& signal;
+        std::shared_ptr<const SlotList> owner;
+        const SlotList* list;
+
+    public:
+        explicit Snapshot(Signal& signal) : signal{signal}, list{nullptr}
+        {
+            if constexpr (LockPolicy::THREAD_SAFE)
+            {
+                std::lock_guard<LockPolicy> lock{signal.slotsLock};
+                owner = signal.slots;
+                list = owner.get();
+            }
+            else
+            {
+                list = signal.slots.get();
+                ++signal.emitting;
+            }
+        }
+
+        ~Snapshot()
+        {
+            if constexpr (!LockPolicy::THREAD_SAFE)
+            {
+                if (--signal.emitting == 0 && !signal.retired.empty()) signal.retired.clear();
+            }
+        }
+
+        const SlotList& operator*() const noexcept { return *list; }
+    };
+
+    // Input iterator handed to the combiner. Dereferencing it calls the slot, once.
+    class SlotCallIterator
+    {
+    private:
+        const Connection* current;
+        std::tuple<Args&...>* arguments;
+        mutable std::optional<R> result;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = R;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const R*;
+        using reference = const R&;
+
+        SlotCallIterator(const Connection* current, std::tuple<Args&...>* arguments)
+            : current{current}, arguments{arguments}
+        {
+        }
+
+        const R& operator*() const
+        {
+            if (!result) result.emplace(std::apply(current->function, *arguments));
+            return *result;
+        }
+
+        SlotCallIterator& operator++()
+        {
+            ++current;
+            result.reset();
+            return *this;
+        }
+
+        SlotCallIterator operator++(int)
+        {
+            SlotCallIterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const SlotCallIterator& other) const noexcept { return current == other.current; }
+    };
+
+    std::shared_ptr<const SlotList> slots;
+    std::vector<std::shared_ptr<const SlotList>> retired;   // NoLock only: lists replaced during an emit
+    std::size_t emitting{0};                                 // NoLock only: depth of nested emits
+    std::uint64_t nextId{1};
+    Combiner combiner;
+    mutable LockPolicy slotsLock;
+    LockPolicy resultsLock;
+    std::unique_ptr<Result[]> results;
+    std::size_t resultCapacity{0};
+
+    void replace(std::shared_ptr<const SlotList> list);
+
+public:
+    explicit Signal(Combiner reducer = Combiner{});
+    Signal(const Signal& other) = delete;
+    Signal(Signal&& other) = delete;
+    ~Signal() = default;
+
+    // Operator Overloads
+    Signal& operator=(const Signal& other) = delete;
+    Signal& operator=(Signal&& other) = delete;
+    result_type operator()(Args... args);
+
+    // Accessors
+    std::size_t slotCount() const;
+    bool empty() const;
+
+    // Core Functionality
+    std::uint64_t connect(Slot slot);
+    bool disconnect(std::uint64_t id);
+    void disconnectAll();
+    result_type emitParallel(ThreadPool& pool, Args... args);
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SIGNAL_CPP
+#include "Signal.cpp"
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SIGNAL_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SIGNAL_HPP
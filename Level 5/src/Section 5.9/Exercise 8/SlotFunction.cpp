@@ -0,0 +1,171 @@
+//
+// A SlotFunction holds any callable with a given signature and stores small callables inline.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SLOTFUNCTION_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SLOTFUNCTION_CPP
+
+#include <functional>
+#include <new>
+#include <utility>
+
+#include "SlotFunction.hpp"
+
+/**
+ * Default ctor. An empty SlotFunction throws std::bad_function_call when called.
+ */
+template<typename R, typename... Args, std::size_t Capacity>
+SlotFunction<R (Args...), Capacity>::SlotFunction() noexcept : invoker{nullptr}, manager{nullptr}, inlined{true}
+{
+}
+
+/**
+ * Overloaded ctor that stores a copy of a callable, inline if it is small enough
+ * @tparam F Type of the callable
+ * @param callable A function pointer, function object or lambda with a compatible signature
+ */
+template<typename R, typename... Args, std::size_t Capacity>
+template<typename F>
+requires (!std::is_same_v<std::decay_t<F>, SlotFunction<R (Args...), Capacity>> &&
+          std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+SlotFunction<R (Args...), Capacity>::SlotFunction(F&& callable)
+    : invoker{&invoke<std::decay_t<F>>}, manager{&manage<std::decay_t<F>>}, inlined{STORED_INLINE<std::decay_t<F>>}
+{
+    using Callable = std::decay_t<F>;
+    if constexpr (STORED_INLINE<Callable>) ::new (static_cast<void*>(storage)) Callable(std::forward<F>(callable));
+    else *reinterpret_cast<Callable**>(storage) = new Callable(std::forward<F>(callable));
+}
+
+/**
+ * Copy ctor
+ * @param other The SlotFunction to copy
+ */
+template<typename R, typename... Args, std::size_t Capacity>
+SlotFunction<R (Args...), Capacity>::SlotFunction(const SlotFunction& other)
+    : invoker{other.invoker}, manager{other.manager}, inlined{other.inlined}
+{
+    if (manager) manager(Operation::Copy, storage, other.storage);
+}
+
+/**
+ * Move ctor. Leaves other empty.
+ * @param other The SlotFunction to move
+ */
+template<typename R, typename... Args, std::size_t Capacity>
+SlotFunction<R (Args...), Capacity>::SlotFunction(SlotFunction&& other) noexcept
+    : invoker{other.invoker}, manager{other.manager}, inlined{other.inlined}
+{
+    if (manager) manager(Operation::Move, storage, other.storage);
+    other.invoker = nullptr;
+    other.manager = nullptr;
+}
+
+/**
+ * Dtor
+ */
+template<typename R, typename... Args, std::size_t Capacity>
+SlotFunction<R (Args...), Capacity>::~SlotFunction()
+{
+    if (manager) manager(Operation::Destroy, nullptr, storage);
+}
+
+/**
+ * Calls the stored callable
+ * @tparam F Type of the callable
+ * @param storage The inline buffer, holding either the callable or a pointer to it
+ * @param args The arguments of the call
+ * @return The result of the call
+ */
+template<typename R, typename... Args, std::size_t Capacity>
+template<typename F>
+R SlotFunction<R (Args...), Capacity>::invoke(void* storage, Args&&... args)
+{
+    F* callable;
+    if constexpr (STORED_INLINE<F>) callable = std::launder(reinterpret_cast<F*>(storage));
+    else callable = *reinterpret_cast<F**>(storage);
+
+    if constexpr (std::is_void_v<R>) std::invoke(*callable, std::forward<Args>(args)...);
+    else return std::invoke(*callable, std::forward<Args>(args)...);
+}
+
+/**
+ * Copies, moves or destroys the stored callable
+ * @tparam F Type of the callable
+ * @param operation What to do
+ * @param destination Buffer that receives the copy or moved callable
+ * @param source Buffer holding the callable
+ */
+template<typename R, typename... Args, std::size_t Capacity>
+template<typename F>
+void SlotFunction<R (Args...), Capacity>::manage(Operation operation, void* destination, void* source)
+{
+    if constexpr (STORED_INLINE<F>)
+    {
+        F* callable = std::launder(static_cast<F*>(source));
+        switch (operation)
+        {
+            case Operation::Copy: ::new (destination) F(*callable); break;
+            case Operation::Move: ::new (destination) F(std::move(*callable)); callable->~F(); break;
+            case Operation::Destroy: callable->~F(); break;
+        }
+    }
+    else
+    {
+        F*& callable = *static_cast<F**>(source);
+        switch (operation)
+        {
+            case Operation::Copy: *static_cast<F**>(destination) = new F(*callable); break;
+            case Operation::Move: *static_cast<F**>(destination) = callable; callable = nullptr; break;
+            case Operation::Destroy: delete callable; break;
+        }
+    }
+}
+
+/**
+ * Copy assignment operator
+ * @param other The SlotFunction to copy
+ * @return This SlotFunction
+ */
+template<typename R, typename... Args, std::size_t Capacity>
+SlotFunction<R (Args...), Capacity>& SlotFunction<R (Args...), Capacity>::operator=(const SlotFunction& other)
+{
+    if (this != &other) *this = SlotFunction{other};
+    return *this;
+}
+
+/**
+ * Move assignment operator. Leaves other empty.
+ * @param other The SlotFunction to move
+ * @return This SlotFunction
+ */
+template<typename R, typename... Args, std::size_t Capacity>
+SlotFunction<R (Args...), Capacity>& SlotFunction<R (Args...), Capacity>::operator=(SlotFunction&& other) noexcept
+{
+    if (this == &other) return *this;
+
+    if (manager) manager(Operation::Destroy, nullptr, storage);
+    invoker = other.invoker;
+    manager = other.manager;
+    inlined = other.inlined;
+    if (manager) manager(Operation::Move, storage, other.storage);
+    other.invoker = nullptr;
+    other.manager = nullptr;
+    return *this;
+}
+
+/**
+ * Calls the stored callable
+ * @param args The arguments of the call
+ * @return The result of the call
+ * @throws std::bad_function_call if the SlotFunction is empty
+ */
+template<typename R, typename... Args, std::size_t Capacity>
+R SlotFunction<R (Args...), Capacity>::operator()(Args... args) const
+{
+    if (!invoker) throw std::bad_function_call();
+    return invoker(storage, std::forward<Args>(args)...);
+}
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SLOTFUNCTION_CPP
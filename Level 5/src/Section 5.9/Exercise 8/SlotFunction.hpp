@@ -0,0 +1,70 @@
+//
+// A SlotFunction holds any callable with a given signature, like std::function, but stores callables of up
+// to Capacity bytes inside the object itself instead of on the heap. Lambdas capturing a few references or
+// values, function pointers and boost::ref/std::ref wrappers all fit, so connecting them to a Signal does
+// not allocate and calling them is one indirect call through a function pointer. Larger callables are
+// moved to the heap once, when the SlotFunction is created.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SLOTFUNCTION_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SLOTFUNCTION_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+template<typename Signature, std::size_t Capacity = 4 * sizeof(void*)>
+class SlotFunction;
+
+template<typename R, typename... Args, std::size_t Capacity>
+class SlotFunction<R (Args...), Capacity>
+{
+private:
+    enum class Operation { Copy, Move, Destroy };
+
+    using Invoker = R (*)(void* storage, Args&&... args);
+    using Manager = void (*)(Operation operation, void* destination, void* source);
+
+    template<typename F>
+    static constexpr bool STORED_INLINE = sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) &&
+                                          std::is_nothrow_move_constructible_v<F>;
+
+    alignas(std::max_align_t) mutable unsigned char storage[Capacity];
+    Invoker invoker;
+    Manager manager;
+    bool inlined;
+
+    template<typename F>
+    static R invoke(void* storage, Args&&... args);
+    template<typename F>
+    static void manage(Operation operation, void* destination, void* source);
+
+public:
+    using result_type = R;
+
+    SlotFunction() noexcept;
+    template<typename F>
+    requires (!std::is_same_v<std::decay_t<F>, SlotFunction<R (Args...), Capacity>> &&
+              std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    SlotFunction(F&& callable);
+    SlotFunction(const SlotFunction& other);
+    SlotFunction(SlotFunction&& other) noexcept;
+    ~SlotFunction();
+
+    // Operator Overloads
+    SlotFunction& operator=(const SlotFunction& other);
+    SlotFunction& operator=(SlotFunction&& other) noexcept;
+    explicit operator bool() const noexcept { return invoker != nullptr; }
+    R operator()(Args... args) const;
+
+    // Accessors
+    bool isInline() const noexcept { return inlined; }
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SLOTFUNCTION_CPP
+#include "SlotFunction.cpp"
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SLOTFUNCTION_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SLOTFUNCTION_HPP
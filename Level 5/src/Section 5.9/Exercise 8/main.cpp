@@ -0,0 +1,333 @@
+//
+// Tests the lightweight Signal against the boost::signals2 exercises: the SumCombiner of Exercise 4, the
+// BootstrapCheck of Exercise 3, connecting and disconnecting (also from inside a slot), thread safety with
+// MutexLock and parallel emits reduced by SumCombiner. Global operator new is replaced to count heap
+// allocations, which shows that emitting does not allocate. Benchmarks compare emit latency and throughput
+// with boost::signals2.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/signals2.hpp>
+
+#include "BootstrapCheck.hpp"
+#include "LockPolicy.hpp"
+#include "Signal.hpp"
+#include "SlotFunction.hpp"
+#include "StopWatch.hpp"
+#include "SumCombiner.hpp"
+#include "ThreadPool.hpp"
+
+// Counts every call to the global operator new. The replacements are kept out of line so that the compiler
+// does not pair an inlined std::free with an operator new call and warn about a mismatch.
+std::atomic<std::size_t> allocations{0};
+
+[[gnu::noinline]] void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+[[gnu::noinline]] void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+double sink = 0;
+
+// A slot whose cost can be tuned, for the parallel emit
+double expensive(double x, int iterations)
+{
+    double value = x;
+    for (int i = 0; i < iterations; ++i) value = std::sqrt(value * value + 1.0) - 0.5;
+    return value;
+}
+
+// Small callables are stored inline, large ones on the heap; both are copied, moved and destroyed properly
+void test_SlotFunction()
+{
+    auto token = std::make_shared<int>(7);
+    {
+        SlotFunction<double (double, double)> small = [token](double lhs, double rhs) { return lhs + rhs + *token; };
+        assert(small.isInline());
+        assert(10 == small(1, 2));
+
+        std::array<double, 16> weights{};
+        weights.fill(2);
+        SlotFunction<double (double, double)> large = [token, weights](double lhs, double rhs) { return weights[0] * (lhs + rhs); };
+        assert(!large.isInline());
+        assert(6 == large(1, 2));
+        assert(3 == token.use_count());
+
+        SlotFunction<double (double, double)> copy = small;
+        SlotFunction<double (double, double)> moved = std::move(large);
+        assert(4 == token.use_count());
+        assert(10 == copy(1, 2) && 6 == moved(1, 2));
+        assert(!large);
+
+        copy = moved;
+        assert(6 == copy(1, 2));
+        moved = std::move(small);
+        assert(10 == moved(1, 2));
+    }
+    assert(1 == token.use_count());
+
+    SlotFunction<void ()> empty;
+    bool thrown = false;
+    try { empty(); }
+    catch (const std::bad_function_call&) { thrown = true; }
+    assert(thrown);
+
+    // Slots taking a reference see the caller's object, as in Exercise 6
+    SlotFunction<void (double&)> square = [](double& value) { value *= value; };
+    double value = 3;
+    square(value);
+    assert(9 == value);
+}
+
+// The combiners of Exercises 3 and 4 give the same results as with signals2
+void test_Combiners()
+{
+    auto slotA = [](double lhs, double rhs) -> double { return lhs + rhs; };
+    auto slotB = [](double lhs, double rhs) -> double { return lhs * rhs; };
+    auto slotC = [](double lhs, double rhs) -> double { return lhs - rhs; };
+
+    boost::signals2::signal<double (double x, double y), SumCombiner<double>> reference;
+    Signal<double (double, double), SumCombiner<double>> sum;
+    for (auto slot : {+slotA, +slotB, +slotC})
+    {
+        reference.connect(slot);
+        sum.connect(slot);
+    }
+
+    assert(25 == sum(5, 3));
+    assert(120 == sum(10, 10));
+    assert(reference(1.5, 2.25) == sum(1.5, 2.25));
+    assert(3 == sum.slotCount());
+
+    // BootstrapCheck stops at the first false, so the third slot is never called
+    int calls = 0;
+    Signal<bool (), BootstrapCheck> check;
+    check.connect([&calls] { ++calls; return true; });
+    check.connect([&calls] { ++calls; return false; });
+    check.connect([&calls] { ++calls; return true; });
+    assert(!check());
+    assert(2 == calls);
+
+    // The default combiner returns the last result
+    Signal<int (int)> last;
+    assert(0 == last(1));
+    last.connect([](int x) { return x + 1; });
+    last.connect([](int x) { return x * 10; });
+    assert(50 == last(5));
+}
+
+// Slots may connect and disconnect slots, including themselves, while the signal is being emitted
+void test_ConnectDisconnect()
+{
+    Signal<void (std::vector<int>&)> signal;
+    std::uint64_t self = 0;
+    std::uint64_t first = signal.connect([](std::vector<int>& calls) { calls.push_back(1); });
+    self = signal.connect([&signal, &self](std::vector<int>& calls)
+    {
+        calls.push_back(2);
+        signal.disconnect(self);
+        signal.connect([](std::vector<int>& more) { more.push_back(3); });
+    });
+
+    std::vector<int> calls;
+    signal(calls);
+    assert((std::vector<int>{1, 2}) == calls);
+
+    calls.clear();
+    signal(calls);
+    assert((std::vector<int>{1, 3}) == calls);
+
+    assert(signal.disconnect(first));
+    assert(!signal.disconnect(first));
+    assert(1 == signal.slotCount());
+    signal.disconnectAll();
+    assert(signal.empty());
+
+    // A slot may emit the signal it is connected to
+    Signal<int (int), SumCombiner<int>> recursive;
+    recursive.connect([&recursive](int depth) { return depth == 0 ? 1 : 1 + recursive(depth - 1); });
+    assert(4 == recursive(3));
+}
+
+// Emitting never allocates, with either lock policy and in parallel once the result buffer has grown
+void test_NoAllocation()
+{
+    Signal<double (double, double), SumCombiner<double>, NoLock> single;
+    Signal<double (double, double), SumCombiner<double>, MutexLock> shared;
+    for (int i = 0; i < 4; ++i)
+    {
+        single.connect([i](double lhs, double rhs) { return lhs * i + rhs; });
+        shared.connect([i](double lhs, double rhs) { return lhs * i + rhs; });
+    }
+
+    ThreadPool pool{4};
+    double total = shared.emitParallel(pool, 1, 1);
+
+    std::size_t before = allocations.load();
+    for (int i = 0; i < 10000; ++i)
+    {
+        total += single(i, 1);
+        total += shared(i, 1);
+        total += shared.emitParallel(pool, i, 1);
+    }
+    assert(before == allocations.load());
+    assert(total > 0);
+}
+
+// A parallel emit gives exactly the sequential result, and passes on the exceptions of its slots
+void test_ParallelEmit()
+{
+    Signal<double (double), SumCombiner<double>, MutexLock> signal;
+    for (int i = 0; i < 32; ++i) signal.connect([i](double x) { return expensive(x + i, 1000 * (i % 4)); });
+
+    ThreadPool pool{4};
+    assert(4 == pool.size());
+    for (double x : {0.5, 2.0, 7.0}) assert(signal(x) == signal.emitParallel(pool, x));
+
+    Signal<void (int)> failing;
+    std::atomic<int> calls{0};
+    for (int i = 0; i < 8; ++i)
+    {
+        failing.connect([&calls, i](int) { ++calls; if (i == 5) throw std::runtime_error("Slot 5 failed"); });
+    }
+    std::string message;
+    try { failing.emitParallel(pool, 0); }
+    catch (const std::runtime_error& e) { message = e.what(); }
+    assert("Slot 5 failed" == message);
+    assert(8 == calls.load());
+}
+
+// With MutexLock, threads can emit while another thread connects and disconnects slots
+void test_ThreadSafe()
+{
+    Signal<int (), SumCombiner<int>, MutexLock> signal;
+    signal.connect([] { return 1; });
+
+    std::atomic<bool> done{false};
+    std::thread churn([&]
+    {
+        while (!done.load())
+        {
+            std::uint64_t id = signal.connect([] { return 100; });
+            signal.disconnect(id);
+        }
+    });
+
+    std::vector<std::thread> emitters;
+    for (int t = 0; t < 2; ++t)
+    {
+        emitters.emplace_back([&signal]
+        {
+            for (int i = 0; i < 20000; ++i)
+            {
+                int result = signal();
+                assert(1 == result || 101 == result);
+            }
+        });
+    }
+    for (auto& emitter : emitters) emitter.join();
+    done.store(true);
+    churn.join();
+    assert(1 == signal());
+}
+
+// Nanoseconds per emit, and heap allocations per emit, of a signal with the given number of slots
+template<typename SignalType>
+void benchmark_Emit(const std::string& name, std::size_t slotCount)
+{
+    SignalType signal;
+    for (std::size_t i = 0; i < slotCount; ++i) signal.connect([i](double lhs, double rhs) { return lhs * static_cast<double>(i) + rhs; });
+
+    constexpr int EMITS = 200000;
+    std::size_t before = allocations.load();
+    StopWatch stopWatch;
+    stopWatch.Start();
+    for (int i = 0; i < EMITS; ++i) sink += signal(i, 1);
+    stopWatch.Stop();
+    double nanoseconds = 1e9 * stopWatch.ElapsedTime();
+    double allocationsPerEmit = static_cast<double>(allocations.load() - before) / EMITS;
+
+    std::cout << name << "\t" << slotCount << "\t" << nanoseconds / EMITS << "\t\t"
+              << 1e3 * EMITS * slotCount / nanoseconds << "\t\t" << allocationsPerEmit << std::endl;
+}
+
+// Sequential and parallel emits of 16 slots of the given cost
+void benchmark_ParallelEmit(int iterations)
+{
+    Signal<double (double), SumCombiner<double>> signal;
+    for (int i = 0; i < 16; ++i) signal.connect([i, iterations](double x) { return expensive(x + i, iterations); });
+    ThreadPool pool;
+
+    const int emits = std::max(10, 2000000 / (16 * (iterations + 1)));
+    StopWatch stopWatch;
+    stopWatch.Start();
+    for (int i = 0; i < emits; ++i) sink += signal(i);
+    stopWatch.Stop();
+    double sequential = 1e6 * stopWatch.ElapsedTime();
+
+    stopWatch.Start();
+    for (int i = 0; i < emits; ++i) sink -= signal.emitParallel(pool, i);
+    stopWatch.Stop();
+    double parallel = 1e6 * stopWatch.ElapsedTime();
+
+    std::cout << iterations << "\t\t" << pool.size() << "\t" << sequential / emits << "\t\t\t" << parallel / emits
+              << std::endl;
+}
+
+int main()
+{
+    test_SlotFunction();
+    test_Combiners();
+    test_ConnectDisconnect();
+    test_NoAllocation();
+    test_ParallelEmit();
+    test_ThreadSafe();
+
+    using Signature = double (double, double);
+    using Boost = boost::signals2::signal<Signature, SumCombiner<double>>;
+    using BoostDummy = boost::signals2::signal_type<Signature, boost::signals2::keywords::combiner_type<SumCombiner<double>>,
+                                                    boost::signals2::keywords::mutex_type<boost::signals2::dummy_mutex>>::type;
+
+    std::cout << "signal\t\t\tslots\tns/emit\t\tslot calls/us\tallocations/emit" << std::endl;
+    for (std::size_t slots : {1, 4, 16})
+    {
+        benchmark_Emit<Boost>("signals2\t\t", slots);
+        benchmark_Emit<BoostDummy>("signals2 dummy_mutex\t", slots);
+        benchmark_Emit<Signal<Signature, SumCombiner<double>, NoLock>>("Signal NoLock\t\t", slots);
+        benchmark_Emit<Signal<Signature, SumCombiner<double>, MutexLock>>("Signal MutexLock\t", slots);
+    }
+
+    std::cout << "work/slot\tthreads\tsequential us/emit\tparallel us/emit" << std::endl;
+    for (int iterations : {10, 1000, 100000}) benchmark_ParallelEmit(iterations);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
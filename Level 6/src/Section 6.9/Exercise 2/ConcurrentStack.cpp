@@ -0,0 +1,340 @@
+//
+// A ConcurrentStack is a bounded lock-free Treiber stack over a preallocated node array, with tagged indices
+// guarding against ABA and an elimination array that pairs up pushes and pops under contention.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_CONCURRENTSTACK_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_CONCURRENTSTACK_CPP
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "ConcurrentStack.hpp"
+
+/**
+ * Overloaded ctor. Allocates every node up front and links them into the list of unused nodes. As with the
+ * State pattern Stack, a capacity of less than one is replaced by a capacity of one.
+ * @tparam T The data type contained in the stack
+ * @param capacity The maximum number of elements
+ * @param elimination Whether contended operations try the elimination array
+ * @throws std::invalid_argument if the capacity does not fit a 32-bit node index
+ */
+template<typename T>
+ConcurrentStack<T>::ConcurrentStack(std::size_t capacity, bool elimination)
+    : size{1}, elimination{elimination}, head{pack(NIL, 0)}, unused{pack(0, 0)}
+{
+    if (capacity >= NIL) throw std::invalid_argument("Capacity " + std::to_string(capacity) + " is too large");
+    if (capacity > 1) size = static_cast<std::uint32_t>(capacity);
+
+    nodes = std::make_unique<Node[]>(size);
+    for (std::uint32_t i = 0; i + 1 < size; ++i) nodes[i].next.store(i + 1, std::memory_order_relaxed);
+}
+
+/**
+ * Packs a node index and an ABA tag into one word
+ * @tparam T The data type contained in the stack
+ * @param index The node index, or NIL
+ * @param tag The tag
+ * @return The packed word
+ */
+template<typename T>
+constexpr std::uint64_t ConcurrentStack<T>::pack(std::uint32_t index, std::uint32_t tag) noexcept
+{
+    return (static_cast<std::uint64_t>(tag) << 32) | index;
+}
+
+/**
+ * @tparam T The data type contained in the stack
+ * @param word A packed word
+ * @return The node index of a packed word
+ */
+template<typename T>
+constexpr std::uint32_t ConcurrentStack<T>::indexOf(std::uint64_t word) noexcept
+{
+    return static_cast<std::uint32_t>(word);
+}
+
+/**
+ * @tparam T The data type contained in the stack
+ * @param word A packed word
+ * @return The tag of a packed word
+ */
+template<typename T>
+constexpr std::uint32_t ConcurrentStack<T>::tagOf(std::uint64_t word) noexcept
+{
+    return static_cast<std::uint32_t>(word >> 32);
+}
+
+/**
+ * Picks an elimination slot with a per-thread xorshift generator
+ * @tparam T The data type contained in the stack
+ * @param slots The elimination array
+ * @return A slot
+ */
+template<typename T>
+typename ConcurrentStack<T>::Slot& ConcurrentStack<T>::randomSlot(std::array<Slot, ELIMINATION_SLOTS>& slots) noexcept
+{
+    thread_local std::uint32_t state = static_cast<std::uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1U;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return slots[state % ELIMINATION_SLOTS];
+}
+
+/**
+ * Hints to the processor that the thread is spinning
+ * @tparam T The data type contained in the stack
+ */
+template<typename T>
+void ConcurrentStack<T>::cpuRelax() noexcept
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/**
+ * Makes one attempt to unlink the first node of a list
+ * @tparam T The data type contained in the stack
+ * @param list The head of the stack or of the unused list
+ * @param index Receives the unlinked node on success
+ * @return Success, Empty if the list has no nodes, or Contended if another thread changed the head first
+ */
+template<typename T>
+typename ConcurrentStack<T>::Attempt ConcurrentStack<T>::popOnce(std::atomic<std::uint64_t>& list,
+                                                                 std::uint32_t& index) noexcept
+{
+    std::uint64_t top = list.load(std::memory_order_acquire);
+    if (indexOf(top) == NIL) return Attempt::Empty;
+
+    // The node may be popped and reused concurrently, in which case next is stale but the tag has moved on
+    std::uint32_t next = nodes[indexOf(top)].next.load(std::memory_order_relaxed);
+    if (!list.compare_exchange_weak(top, pack(next, tagOf(top) + 1), std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        return Attempt::Contended;
+    }
+
+    index = indexOf(top);
+    return Attempt::Success;
+}
+
+/**
+ * Makes one attempt to link a node at the front of a list
+ * @tparam T The data type contained in the stack
+ * @param list The head of the stack or of the unused list
+ * @param index The node, owned by the calling thread
+ * @return True if the node was linked
+ */
+template<typename T>
+bool ConcurrentStack<T>::pushOnce(std::atomic<std::uint64_t>& list, std::uint32_t index) noexcept
+{
+    std::uint64_t top = list.load(std::memory_order_relaxed);
+    nodes[index].next.store(indexOf(top), std::memory_order_relaxed);
+    return list.compare_exchange_weak(top, pack(index, tagOf(top) + 1), std::memory_order_release, std::memory_order_relaxed);
+}
+
+/**
+ * Takes a node from the unused list
+ * @tparam T The data type contained in the stack
+ * @return The node, or NIL if every node is in use (the stack is full)
+ */
+template<typename T>
+std::uint32_t ConcurrentStack<T>::acquireNode() noexcept
+{
+    std::uint32_t index = NIL;
+    while (true)
+    {
+        Attempt attempt = popOnce(unused, index);
+        if (attempt == Attempt::Success) return index;
+        if (attempt == Attempt::Empty) return NIL;
+    }
+}
+
+/**
+ * Returns a node to the unused list
+ * @tparam T The data type contained in the stack
+ * @param index The node, owned by the calling thread
+ */
+template<typename T>
+void ConcurrentStack<T>::releaseNode(std::uint32_t index) noexcept
+{
+    while (!pushOnce(unused, index)) cpuRelax();
+}
+
+/**
+ * Links a node holding a new element onto the stack, or hands it straight to a popper through the
+ * elimination array when the head is contended
+ * @tparam T The data type contained in the stack
+ * @param index The node, owned by the calling thread
+ */
+template<typename T>
+void ConcurrentStack<T>::publish(std::uint32_t index) noexcept
+{
+    while (!pushOnce(head, index))
+    {
+        if (elimination && eliminatePush(index)) return;
+    }
+}
+
+/**
+ * Offers a node in a random elimination slot and waits briefly for a popper to take it
+ * @tparam T The data type contained in the stack
+ * @param index The node, owned by the calling thread
+ * @return True if a popper took the node, false if the offer was withdrawn or the slot was busy
+ */
+template<typename T>
+bool ConcurrentStack<T>::eliminatePush(std::uint32_t index) noexcept
+{
+    Slot& slot = randomSlot(slots);
+    std::uint64_t current = slot.offer.load(std::memory_order_relaxed);
+    if (indexOf(current) != NIL) return false;
+
+    std::uint64_t offer = pack(index, tagOf(current) + 1);
+    if (!slot.offer.compare_exchange_strong(current, offer, std::memory_order_release, std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    for (int spin = 0; spin < ELIMINATION_SPINS; ++spin)
+    {
+        if (slot.offer.load(std::memory_order_acquire) != offer) return true;
+        cpuRelax();
+    }
+
+    // Withdraw the offer; failing to do so means a popper took it in the meantime
+    return !slot.offer.compare_exchange_strong(offer, pack(NIL, tagOf(offer) + 1), std::memory_order_relaxed);
+}
+
+/**
+ * Looks for an offered node in a random elimination slot
+ * @tparam T The data type contained in the stack
+ * @param index Receives the node on success
+ * @return True if a node was taken
+ */
+template<typename T>
+bool ConcurrentStack<T>::eliminatePop(std::uint32_t& index) noexcept
+{
+    Slot& slot = randomSlot(slots);
+    for (int spin = 0; spin < ELIMINATION_SPINS; ++spin)
+    {
+        std::uint64_t current = slot.offer.load(std::memory_order_acquire);
+        if (indexOf(current) != NIL &&
+            slot.offer.compare_exchange_strong(current, pack(NIL, tagOf(current) + 1), std::memory_order_acq_rel,
+                                               std::memory_order_acquire))
+        {
+            index = indexOf(current);
+            return true;
+        }
+        cpuRelax();
+    }
+    return false;
+}
+
+/**
+ * Returns a snapshot of the stack's state. Other threads may change it as soon as it has been read.
+ * @tparam T The data type contained in the stack
+ * @return Empty, Full or NotFullNotEmpty
+ */
+template<typename T>
+StackStatus ConcurrentStack<T>::status() const noexcept
+{
+    if (indexOf(head.load(std::memory_order_acquire)) == NIL) return StackStatus::Empty;
+    if (indexOf(unused.load(std::memory_order_acquire)) == NIL) return StackStatus::Full;
+    return StackStatus::NotFullNotEmpty;
+}
+
+/**
+ * Pushes an element onto the stack unless it is full. Full means that every node is in use, which includes
+ * a node that a concurrent pop has removed from the stack but not yet returned.
+ * @tparam T The data type contained in the stack
+ * @param element The element to push
+ * @return False if the stack was full
+ */
+template<typename T>
+bool ConcurrentStack<T>::tryPush(const T& element)
+{
+    std::uint32_t index = acquireNode();
+    if (index == NIL) return false;
+
+    nodes[index].value = element;
+    publish(index);
+    return true;
+}
+
+/**
+ * Pushes an element onto the stack unless it is full
+ * @tparam T The data type contained in the stack
+ * @param element The element to move onto the stack
+ * @return False if the stack was full, in which case element is left unchanged
+ */
+template<typename T>
+bool ConcurrentStack<T>::tryPush(T&& element)
+{
+    std::uint32_t index = acquireNode();
+    if (index == NIL) return false;
+
+    nodes[index].value = std::move(element);
+    publish(index);
+    return true;
+}
+
+/**
+ * Removes and returns the element at the top of the stack unless it is empty
+ * @tparam T The data type contained in the stack
+ * @return The element, or an empty optional if the stack was empty
+ */
+template<typename T>
+std::optional<T> ConcurrentStack<T>::tryPop()
+{
+    std::uint32_t index = NIL;
+    while (true)
+    {
+        Attempt attempt = popOnce(head, index);
+        if (attempt == Attempt::Success) break;
+        if (attempt == Attempt::Empty) return std::nullopt;
+        if (elimination && eliminatePop(index)) break;
+    }
+
+    std::optional<T> element{std::move(nodes[index].value)};
+    releaseNode(index);
+    return element;
+}
+
+/**
+ * Push an element onto the stack
+ * @tparam T The data type contained in the stack
+ * @param element The element to push
+ * @throws std::out_of_range if the stack is full
+ */
+template<typename T>
+void ConcurrentStack<T>::push(const T& element)
+{
+    if (!tryPush(element)) throw std::out_of_range("Full Stack");
+}
+
+/**
+ * Removes and returns an element from the top of the stack
+ * @tparam T The data type contained in the stack
+ * @return The element at the top of the stack
+ * @throws std::out_of_range if the stack is empty
+ */
+template<typename T>
+T ConcurrentStack<T>::pop()
+{
+    std::optional<T> element = tryPop();
+    if (!element) throw std::out_of_range("Empty Stack");
+    return std::move(*element);
+}
+
+#endif
@@ -0,0 +1,105 @@
+//
+// A ConcurrentStack is a bounded lock-free stack (Treiber stack) that can be shared by any number of threads,
+// e.g. as a free-list of reusable buffers. All nodes are allocated up front in one array and linked by index,
+// and both the stack itself and the list of unused nodes are Treiber stacks whose head packs a 32-bit node
+// index with a 32-bit tag. Every successful CAS bumps the tag, so a head that was popped and pushed back in
+// between (the ABA problem) no longer compares equal. Nodes are never freed while the stack is alive, so a
+// thread that reads the next index of a node that was just popped by another thread reads valid memory and
+// simply fails its CAS.
+//
+// Under contention a failed CAS on the head falls back to an elimination array: a pusher offers its node in
+// a random slot for a short time and a popper that finds the offer takes the node directly, so the pair
+// completes without touching the head at all.
+//
+// The empty/full signalling of the State pattern Stack is kept without virtual dispatch: push() and pop()
+// throw std::out_of_range("Full Stack") and ("Empty Stack") as before, tryPush()/tryPop() report the same
+// conditions through their return value and status() returns a StackStatus snapshot.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_CONCURRENTSTACK_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_CONCURRENTSTACK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "StackStatus.hpp"
+
+template<typename T>
+class ConcurrentStack
+{
+private:
+    static constexpr std::uint32_t NIL = 0xFFFFFFFF;
+    static constexpr std::size_t ELIMINATION_SLOTS = 16;
+    static constexpr int ELIMINATION_SPINS = 64;
+
+    struct Node
+    {
+        T value{};
+        std::atomic<std::uint32_t> next{NIL};
+    };
+
+    // Holds pack(node, tag) while a pusher offers its node, pack(NIL, tag) otherwise
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint64_t> offer{NIL};
+    };
+
+    // Result of a single CAS attempt on a list head
+    enum class Attempt { Success, Empty, Contended };
+
+    std::unique_ptr<Node[]> nodes;
+    std::uint32_t size;
+    bool elimination;
+    alignas(64) std::atomic<std::uint64_t> head;
+    alignas(64) std::atomic<std::uint64_t> unused;
+    std::array<Slot, ELIMINATION_SLOTS> slots{};
+
+    static constexpr std::uint64_t pack(std::uint32_t index, std::uint32_t tag) noexcept;
+    static constexpr std::uint32_t indexOf(std::uint64_t word) noexcept;
+    static constexpr std::uint32_t tagOf(std::uint64_t word) noexcept;
+    static Slot& randomSlot(std::array<Slot, ELIMINATION_SLOTS>& slots) noexcept;
+    static void cpuRelax() noexcept;
+
+    Attempt popOnce(std::atomic<std::uint64_t>& list, std::uint32_t& index) noexcept;
+    bool pushOnce(std::atomic<std::uint64_t>& list, std::uint32_t index) noexcept;
+    std::uint32_t acquireNode() noexcept;
+    void releaseNode(std::uint32_t index) noexcept;
+    void publish(std::uint32_t index) noexcept;
+    bool eliminatePush(std::uint32_t index) noexcept;
+    bool eliminatePop(std::uint32_t& index) noexcept;
+
+public:
+    ConcurrentStack() = delete;
+    explicit ConcurrentStack(std::size_t capacity, bool elimination = true);
+    ConcurrentStack(const ConcurrentStack<T>& other) = delete;
+    ConcurrentStack(ConcurrentStack<T>&& other) = delete;
+    ~ConcurrentStack() = default;
+
+    // Operator Overloads
+    ConcurrentStack<T>& operator=(const ConcurrentStack<T>& other) = delete;
+    ConcurrentStack<T>& operator=(ConcurrentStack<T>&& other) = delete;
+
+    // Accessors
+    std::size_t capacity() const noexcept { return size; }
+    StackStatus status() const noexcept;
+
+    // Core Functionality
+    bool tryPush(const T& element);
+    bool tryPush(T&& element);
+    std::optional<T> tryPop();
+    void push(const T& element);
+    T pop();
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_CONCURRENTSTACK_CPP
+#include "ConcurrentStack.cpp"
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_CONCURRENTSTACK_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_CONCURRENTSTACK_HPP
@@ -0,0 +1,111 @@
+//
+// A LockedStack is a bounded stack protected by a single std::mutex
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_LOCKEDSTACK_CPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_LOCKEDSTACK_CPP
+
+#include <stdexcept>
+#include <utility>
+
+#include "LockedStack.hpp"
+
+/**
+ * Overloaded ctor. A capacity of less than one is replaced by a capacity of one.
+ * @tparam T The data type contained in the stack
+ * @param capacity The maximum number of elements
+ */
+template<typename T>
+LockedStack<T>::LockedStack(std::size_t capacity) : size{capacity < 1 ? 1 : capacity}
+{
+    stack.reserve(size);
+}
+
+/**
+ * Returns a snapshot of the stack's state
+ * @tparam T The data type contained in the stack
+ * @return Empty, Full or NotFullNotEmpty
+ */
+template<typename T>
+StackStatus LockedStack<T>::status() const
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    if (stack.empty()) return StackStatus::Empty;
+    if (stack.size() == size) return StackStatus::Full;
+    return StackStatus::NotFullNotEmpty;
+}
+
+/**
+ * Pushes an element onto the stack unless it is full
+ * @tparam T The data type contained in the stack
+ * @param element The element to push
+ * @return False if the stack was full
+ */
+template<typename T>
+bool LockedStack<T>::tryPush(const T& element)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    if (stack.size() == size) return false;
+    stack.push_back(element);
+    return true;
+}
+
+/**
+ * Pushes an element onto the stack unless it is full
+ * @tparam T The data type contained in the stack
+ * @param element The element to move onto the stack
+ * @return False if the stack was full, in which case element is left unchanged
+ */
+template<typename T>
+bool LockedStack<T>::tryPush(T&& element)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    if (stack.size() == size) return false;
+    stack.push_back(std::move(element));
+    return true;
+}
+
+/**
+ * Removes and returns the element at the top of the stack unless it is empty
+ * @tparam T The data type contained in the stack
+ * @return The element, or an empty optional if the stack was empty
+ */
+template<typename T>
+std::optional<T> LockedStack<T>::tryPop()
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    if (stack.empty()) return std::nullopt;
+    std::optional<T> element{std::move(stack.back())};
+    stack.pop_back();
+    return element;
+}
+
+/**
+ * Push an element onto the stack
+ * @tparam T The data type contained in the stack
+ * @param element The element to push
+ * @throws std::out_of_range if the stack is full
+ */
+template<typename T>
+void LockedStack<T>::push(const T& element)
+{
+    if (!tryPush(element)) throw std::out_of_range("Full Stack");
+}
+
+/**
+ * Removes and returns an element from the top of the stack
+ * @tparam T The data type contained in the stack
+ * @return The element at the top of the stack
+ * @throws std::out_of_range if the stack is empty
+ */
+template<typename T>
+T LockedStack<T>::pop()
+{
+    std::optional<T> element = tryPop();
+    if (!element) throw std::out_of_range("Empty Stack");
+    return std::move(*element);
+}
+
+#endif
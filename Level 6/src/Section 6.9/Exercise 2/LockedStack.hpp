@@ -0,0 +1,54 @@
+//
+// A LockedStack is a bounded stack protected by a single std::mutex. It offers the same interface as
+// ConcurrentStack and is the baseline that the lock-free stack is benchmarked against.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_LOCKEDSTACK_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_LOCKEDSTACK_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "StackStatus.hpp"
+
+template<typename T>
+class LockedStack
+{
+private:
+    std::vector<T> stack;
+    std::size_t size;
+    mutable std::mutex mutex;
+
+public:
+    LockedStack() = delete;
+    explicit LockedStack(std::size_t capacity);
+    LockedStack(const LockedStack<T>& other) = delete;
+    LockedStack(LockedStack<T>&& other) = delete;
+    ~LockedStack() = default;
+
+    // Operator Overloads
+    LockedStack<T>& operator=(const LockedStack<T>& other) = delete;
+    LockedStack<T>& operator=(LockedStack<T>&& other) = delete;
+
+    // Accessors
+    std::size_t capacity() const noexcept { return size; }
+    StackStatus status() const;
+
+    // Core Functionality
+    bool tryPush(const T& element);
+    bool tryPush(T&& element);
+    std::optional<T> tryPop();
+    void push(const T& element);
+    T pop();
+};
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_LOCKEDSTACK_CPP
+#include "LockedStack.cpp"
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_LOCKEDSTACK_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_LOCKEDSTACK_HPP
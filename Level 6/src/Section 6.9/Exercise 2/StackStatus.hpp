@@ -0,0 +1,21 @@
+//
+// The three states of a bounded stack from Exercise 1 (EmptyState, NotFullNotEmptyState and FullState),
+// reported as a value instead of being dispatched through virtual State singletons. Concurrent stacks can
+// only report a snapshot, since another thread may push or pop right after the status is read.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_STACKSTATUS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_STACKSTATUS_HPP
+
+#include <cstdint>
+
+enum class StackStatus : std::uint8_t
+{
+    Empty,
+    NotFullNotEmpty,
+    Full
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_STACKSTATUS_HPP
@@ -0,0 +1,193 @@
+//
+// Tests the lock-free ConcurrentStack and the mutex-protected LockedStack: the Empty/NotFullNotEmpty/Full
+// transitions of Exercise 1, conservation of elements across many threads and use as a shared free-list of
+// buffers. A benchmark compares both stacks from 1 to 64 threads.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "ConcurrentStack.hpp"
+#include "LockedStack.hpp"
+#include "StopWatch.hpp"
+
+// Runs function(t) on the given number of threads, all released at the same time
+template<typename Function>
+void runThreads(unsigned threads, Function function)
+{
+    std::atomic<bool> go{false};
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&go, &function, t]
+        {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            function(t);
+        });
+    }
+    go.store(true, std::memory_order_release);
+    for (auto& thread : pool) thread.join();
+}
+
+// Test the Empty -> NotFullNotEmpty -> Full transitions and the exceptions of the State pattern Stack
+template<typename Stack>
+void test_StackTransitions()
+{
+    Stack stack{3};
+    assert(StackStatus::Empty == stack.status());
+
+    stack.push(1);
+    assert(StackStatus::NotFullNotEmpty == stack.status());
+    stack.push(2);
+    stack.push(3);
+    assert(StackStatus::Full == stack.status());
+    assert(!stack.tryPush(4));
+
+    std::string message;
+    try { stack.push(4); }
+    catch (const std::out_of_range& e) { message = e.what(); }
+    assert("Full Stack" == message);
+
+    assert(3 == stack.pop());
+    assert(2 == stack.pop());
+    assert(1 == stack.pop());
+    assert(StackStatus::Empty == stack.status());
+    assert(!stack.tryPop().has_value());
+
+    message.clear();
+    try { stack.pop(); }
+    catch (const std::out_of_range& e) { message = e.what(); }
+    assert("Empty Stack" == message);
+
+    // As in Exercise 1 a capacity of less than one becomes one
+    Stack single{0};
+    assert(1 == single.capacity());
+    single.push(7);
+    assert(StackStatus::Full == single.status());
+}
+
+// Every element that was pushed is popped exactly once, while threads push and pop concurrently
+template<typename Stack>
+void test_Conservation(unsigned threads, std::size_t capacity)
+{
+    constexpr std::uint32_t ITERATIONS = 20000;
+    Stack stack{capacity};
+    std::vector<std::atomic<int>> pushed(threads * ITERATIONS);
+    std::vector<std::atomic<int>> popped(threads * ITERATIONS);
+
+    runThreads(threads, [&](unsigned t)
+    {
+        for (std::uint32_t i = 0; i < ITERATIONS; ++i)
+        {
+            std::uint32_t value = t * ITERATIONS + i;
+            if (stack.tryPush(value)) pushed[value].fetch_add(1, std::memory_order_relaxed);
+            if (i % 3 != 0)
+            {
+                if (auto element = stack.tryPop()) popped[*element].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    while (auto element = stack.tryPop()) popped[*element].fetch_add(1);
+    for (std::size_t value = 0; value < pushed.size(); ++value) assert(pushed[value].load() == popped[value].load());
+}
+
+// Threads check buffers out of a shared free-list, fill them and verify nobody else wrote to them
+template<typename Stack>
+void test_BufferFreeList(unsigned threads)
+{
+    constexpr std::size_t BUFFERS = 8;
+    Stack freeList{BUFFERS};
+    for (std::size_t i = 0; i < BUFFERS; ++i) freeList.push(std::make_shared<std::vector<unsigned>>(64));
+
+    std::atomic<std::size_t> misses{0};
+    runThreads(threads, [&](unsigned t)
+    {
+        for (int i = 0; i < 20000; ++i)
+        {
+            auto buffer = freeList.tryPop();
+            if (!buffer) { misses.fetch_add(1, std::memory_order_relaxed); continue; }
+
+            for (unsigned& word : **buffer) word = t;
+            for (unsigned word : **buffer) assert(word == t);
+            freeList.push(*buffer);
+        }
+    });
+
+    // Every buffer made it back
+    std::size_t returned = 0;
+    while (freeList.tryPop()) ++returned;
+    assert(BUFFERS == returned);
+}
+
+// Pops and pushes back a buffer handle, as a free-list would, and reports millions of operations per second
+template<typename Stack>
+double benchmark_FreeList(unsigned threads, std::size_t operations, bool elimination)
+{
+    constexpr std::size_t CAPACITY = 1024;
+    std::unique_ptr<Stack> stack;
+    if constexpr (std::is_constructible_v<Stack, std::size_t, bool>) stack = std::make_unique<Stack>(CAPACITY, elimination);
+    else stack = std::make_unique<Stack>(CAPACITY);
+
+    std::vector<std::uint64_t> buffers(CAPACITY / 2);
+    for (std::uint64_t& buffer : buffers) stack->push(&buffer);
+
+    const std::size_t perThread = operations / threads;
+    StopWatch stopWatch;
+    stopWatch.Start();
+    runThreads(threads, [&](unsigned)
+    {
+        for (std::size_t i = 0; i < perThread; ++i)
+        {
+            if (auto buffer = stack->tryPop())
+            {
+                ++**buffer;
+                stack->tryPush(*buffer);
+            }
+        }
+    });
+    stopWatch.Stop();
+    double seconds = stopWatch.ElapsedTime();
+    return 2.0 * static_cast<double>(perThread * threads) / seconds / 1e6;
+}
+
+int main()
+{
+    test_StackTransitions<ConcurrentStack<int>>();
+    test_StackTransitions<LockedStack<int>>();
+
+    for (unsigned threads : {2U, 8U})
+    {
+        test_Conservation<ConcurrentStack<std::uint32_t>>(threads, 64);
+        test_Conservation<ConcurrentStack<std::uint32_t>>(threads, 4096);
+        test_Conservation<LockedStack<std::uint32_t>>(threads, 64);
+        test_BufferFreeList<ConcurrentStack<std::shared_ptr<std::vector<unsigned>>>>(threads);
+        test_BufferFreeList<LockedStack<std::shared_ptr<std::vector<unsigned>>>>(threads);
+    }
+
+    std::cout << "Free-list pop/push throughput (Mops/s)\n"
+              << "threads\tmutex\tTreiber\tTreiber+elimination" << std::endl;
+    for (unsigned threads : {1U, 2U, 4U, 8U, 16U, 32U, 64U})
+    {
+        const std::size_t operations = 1 << 21;
+        std::cout << threads
+                  << "\t" << benchmark_FreeList<LockedStack<std::uint64_t*>>(threads, operations, false)
+                  << "\t" << benchmark_FreeList<ConcurrentStack<std::uint64_t*>>(threads, operations, false)
+                  << "\t" << benchmark_FreeList<ConcurrentStack<std::uint64_t*>>(threads, operations, true)
+                  << std::endl;
+    }
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
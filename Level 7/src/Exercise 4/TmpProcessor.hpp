@@ -4,23 +4,26 @@
 // This illustrates a next generation design for the Template Method Pattern
 // using universal funtion wrappers.
 //
+// The aliases below are InplaceFunctions, so the ctor copies main()'s three lambdas into _factory, _compute
+// and _dispatch without allocating.
+//
 // Created by Michael Lewis on 8/23/23.
 //
 
 #ifndef ADVANCED_CPP_AND_MODERN_DESIGN_TMPPROCESSOR_HPP
 #define ADVANCED_CPP_AND_MODERN_DESIGN_TMPPROCESSOR_HPP
 
-#include <functional>
+#include "InplaceFunction.hpp"
 
 // Alias for universal function wrappers
 template<typename T>
-using FactoryFunction = std::function<T ()>;
+using FactoryFunction = InplaceFunction<T ()>;
 
 template<typename T>
-using ComputeFunction = std::function<T (const T& t)>;
+using ComputeFunction = InplaceFunction<T (const T& t)>;
 
 template<typename T>
-using DispatchFunction = std::function<void (T& t)>;
+using DispatchFunction = InplaceFunction<void (T& t)>;
 
 
 // Class with Input-Processing-Output
@@ -13,14 +13,16 @@
 #define ADVANCED_CPP_AND_MODERN_DESIGN_SUBJECT_HPP
 
 #include <list>
-#include <functional>
 #include <memory>
 
+#include "InplaceFunction.hpp"
+
 template<typename T>
 class Subject
 {
 private:
-    using ObserverPtr = std::shared_ptr<std::function<void (double)>>;
+    using Observer = InplaceFunction<void (double)>;
+    using ObserverPtr = std::shared_ptr<Observer>;
     std::list<ObserverPtr> observers;
 
 public:
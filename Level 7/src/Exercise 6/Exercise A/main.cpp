@@ -8,19 +8,20 @@
 
 #include "Counter.hpp"
 
-// Alias
-using ObserverPtr = std::shared_ptr<std::function<void (double)>>;
+// Aliases
+using Observer = InplaceFunction<void (double)>;
+using ObserverPtr = std::shared_ptr<Observer>;
 
 int main()
 {
     // Create Observers
-    std::function<void (double)> longFormat = [](double value)
+    Observer longFormat = [](double value)
     {
         std::string s = std::to_string((long) value);
         std::cout << "Long Format: " << s << std::endl;
     };
 
-    std::function<void (double)> doubleFormat = [](double value)
+    Observer doubleFormat = [](double value)
     {
         std::string s = std::to_string(value);
         std::cout << "Double Format: " << s << std::endl;
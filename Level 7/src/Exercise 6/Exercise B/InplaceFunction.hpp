@@ -0,0 +1,135 @@
+//
+// Function wrappers that never allocate. std::function keeps a callable in a small buffer only when it is a
+// function pointer or a lambda of no more than two pointers' worth of captures; anything larger goes on the
+// heap, and every copy allocates again. InplaceFunction<Signature, Capacity> stores the callable in Capacity
+// bytes inside the wrapper itself, and a callable that does not fit is a compile error rather than an
+// allocation. UniqueFunction<Signature, Capacity> is the move-only counterpart: it drops the copy operation,
+// so it also holds move-only callables such as a lambda owning a std::unique_ptr or a std::packaged_task.
+//
+// Both are drop-in replacements for std::function in the places that use it: they are built from any
+// callable with a compatible signature, called through a const operator(), compared with nullptr, and
+// calling an empty one throws std::bad_function_call. Copying or moving one copies or moves the callable
+// in place through a table of operations shared by every wrapper of that callable type. An empty wrapper
+// points at a table whose call throws, so a call is one indirect jump with no test for empty.
+//
+// Callables must be nothrow move constructible, so that moving a wrapper cannot throw.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_INPLACEFUNCTION_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_INPLACEFUNCTION_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename Signature, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+class BasicInplaceFunction;
+
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Alignment, bool Copyable>
+class BasicInplaceFunction<R (Args...), Capacity, Alignment, Copyable>
+{
+private:
+    // What a wrapper needs to know about the callable it holds
+    struct Operations
+    {
+        R (*invoke)(void* target, Args&&... args);
+        void (*copy)(void* destination, const void* source);        // Null for UniqueFunction
+        void (*relocate)(void* destination, void* source) noexcept;  // Move constructs, then destroys the source
+        void (*destroy)(void* target) noexcept;
+    };
+
+    template<typename F>
+    static R invokeTarget(void* target, Args&&... args);
+
+    template<typename F>
+    static void copyTarget(void* destination, const void* source)
+    {
+        if constexpr (Copyable) ::new (destination) F(*static_cast<const F*>(source));
+    }
+
+    template<typename F>
+    static void relocateTarget(void* destination, void* source) noexcept
+    {
+        ::new (destination) F(std::move(*static_cast<F*>(source)));
+        static_cast<F*>(source)->~F();
+    }
+
+    template<typename F>
+    static void destroyTarget(void* target) noexcept { static_cast<F*>(target)->~F(); }
+
+    template<typename F>
+    static constexpr Operations OPERATIONS{&invokeTarget<F>, Copyable ? &copyTarget<F> : nullptr, &relocateTarget<F>,
+                                           &destroyTarget<F>};
+
+    [[noreturn]] static R invokeEmpty(void*, Args&&...) { throw std::bad_function_call(); }
+
+    static void relocateEmpty(void*, void*) noexcept {}
+    static void destroyEmpty(void*) noexcept {}
+
+    static constexpr Operations EMPTY{&invokeEmpty, nullptr, &relocateEmpty, &destroyEmpty};
+
+    alignas(Alignment) mutable std::byte storage[Capacity];
+    const Operations* operations;
+
+    template<typename F>
+    void emplace(F&& callable);
+
+public:
+    using result_type = R;
+
+    BasicInplaceFunction() noexcept : operations{&EMPTY} {}
+    BasicInplaceFunction(std::nullptr_t) noexcept : operations{&EMPTY} {}
+
+    template<typename F>
+    requires (!std::same_as<std::remove_cvref_t<F>, BasicInplaceFunction>)
+             && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>
+    BasicInplaceFunction(F&& callable);
+
+    BasicInplaceFunction(const BasicInplaceFunction& source) requires (Copyable);
+    BasicInplaceFunction(BasicInplaceFunction&& source) noexcept;
+    ~BasicInplaceFunction() { operations->destroy(storage); }
+
+    // Operator overloads
+    BasicInplaceFunction& operator=(const BasicInplaceFunction& source) requires (Copyable);
+    BasicInplaceFunction& operator=(BasicInplaceFunction&& source) noexcept;
+    BasicInplaceFunction& operator=(std::nullptr_t) noexcept;
+
+    template<typename F>
+    requires (!std::same_as<std::remove_cvref_t<F>, BasicInplaceFunction>)
+             && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>
+    BasicInplaceFunction& operator=(F&& callable);
+
+    R operator()(Args... args) const { return operations->invoke(storage, std::forward<Args>(args)...); }
+    explicit operator bool() const noexcept { return operations != &EMPTY; }
+    friend bool operator==(const BasicInplaceFunction& function, std::nullptr_t) noexcept { return !function; }
+
+    // Accessors
+    static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+    template<typename F>
+    static constexpr bool fits() noexcept
+    {
+        return sizeof(F) <= Capacity && Alignment % alignof(F) == 0;
+    }
+
+    // Core functionality
+    void swap(BasicInplaceFunction& other) noexcept;
+};
+
+template<typename Signature, std::size_t Capacity = 32, std::size_t Alignment = alignof(std::max_align_t)>
+using InplaceFunction = BasicInplaceFunction<Signature, Capacity, Alignment, true>;
+
+template<typename Signature, std::size_t Capacity = 32, std::size_t Alignment = alignof(std::max_align_t)>
+using UniqueFunction = BasicInplaceFunction<Signature, Capacity, Alignment, false>;
+
+// ********** Template Definitions **********
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_INPLACEFUNCTION_CPP
+#include "InplaceFunction.cpp"
+#endif // ADVANCED_CPP_AND_MODERN_DESIGN_INPLACEFUNCTION_CPP
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_INPLACEFUNCTION_HPP
@@ -17,12 +17,13 @@
 
 #include <list>
 #include <deque>
-#include <functional>
 #include <memory>
 
 #include "Counter.hpp"
+#include "InplaceFunction.hpp"
 
-using ObserverPtr = std::shared_ptr<std::function<void (double)>>;
+using Observer = InplaceFunction<void (double)>;
+using ObserverPtr = std::shared_ptr<Observer>;
 
 template<typename T, template<typename S, typename Alloc> class Container, typename TAlloc>
 class Subject
@@ -8,21 +8,22 @@
 
 #include "Counter.hpp"
 
-// Alias
-using ObserverPtr = std::shared_ptr<std::function<void (double)>>;
+// Aliases
+using Observer = InplaceFunction<void (double)>;
+using ObserverPtr = std::shared_ptr<Observer>;
 
 void test_ListObservers()
 {
     std::cout << "\n*** Using std::list as the container ***" << std::endl;
 
     // Create Observers
-    std::function<void (double)> longFormat = [](double value)
+    Observer longFormat = [](double value)
     {
         std::string s = std::to_string((long) value);
         std::cout << "Long Format: " << s << std::endl;
     };
 
-    std::function<void (double)> doubleFormat = [](double value)
+    Observer doubleFormat = [](double value)
     {
         std::string s = std::to_string(value);
         std::cout << "Double Format: " << s << std::endl;
@@ -48,13 +49,13 @@ void test_DequeObservers()
     std::cout << "\n*** Using std::deque as the container ***" << std::endl;
 
     // Create Observers
-    std::function<void (double)> longFormat = [](double value)
+    Observer longFormat = [](double value)
     {
         std::string s = std::to_string((long) value);
         std::cout << "Long Format: " << s << std::endl;
     };
 
-    std::function<void (double)> doubleFormat = [](double value)
+    Observer doubleFormat = [](double value)
     {
         std::string s = std::to_string(value);
         std::cout << "Double Format: " << s << std::endl;
@@ -0,0 +1,63 @@
+//
+// Concrete Subject used to illustrate state changes. Each change is published to the observers
+// asynchronously through the CRTP Subject.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_COUNTER_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_COUNTER_HPP
+
+#include <cstddef>
+
+#include "Subject.hpp"
+
+class Counter : public Subject<Counter>
+{
+private:
+    double value;
+
+public:
+    /**
+     * Overloaded ctor
+     * @param workers Number of threads that deliver notifications
+     * @param history Number of values kept for observers that lag behind
+     */
+    explicit Counter(std::size_t workers = 1, std::size_t history = 1024) : Subject<Counter>(workers, history), value{0} {}
+    Counter(const Counter& counter) = delete;
+    Counter(Counter&& other) = delete;
+    ~Counter() override = default;
+
+    // Operator Overloads
+    Counter& operator=(const Counter& other) = delete;
+    Counter& operator=(Counter&& other) = delete;
+
+    /**
+     * Increments the counter by one and notifies all the observers
+     */
+    void increaseCounter()
+    {
+        ++value;
+        Subject<Counter>::notify();
+    }
+
+    /**
+     * Decrements the counter by one and notifies all the observers
+     */
+    void decreaseCounter()
+    {
+        --value;
+        Subject<Counter>::notify();
+    }
+
+    /**
+     * Returns the value of the counter
+     * @return The value of the counter
+     */
+    double getCounter() const
+    {
+        return value;
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_COUNTER_HPP
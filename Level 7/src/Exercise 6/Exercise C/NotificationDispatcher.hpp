@@ -0,0 +1,346 @@
+//
+// Asynchronous, coalescing delivery of Subject updates.
+//
+// Exercise B notifies every observer synchronously, so the thread that changes the counter pays for every
+// attached observer. A NotificationDispatcher moves that cost onto its own worker threads:
+//
+//  - publish() writes the new value into one slot of a broadcast ring buffer and advances the published
+//    sequence number. That is O(1) no matter how many observers are attached, and it never takes a lock.
+//  - Each observer has its own cursor into the ring, which acts as a bounded per-observer queue: the values
+//    between the cursor and the published sequence are the ones still waiting for delivery. When an
+//    observer falls more than its queue capacity behind (or the ring wraps around it), the values it
+//    missed are coalesced and only the latest one is delivered.
+//  - Workers hand each observer all of its pending values at once, up to maxBatch, as a std::span. Observers
+//    are held in UniqueFunctions, so a subscription keeps its callable inline rather than on the heap.
+//  - The observers live in a copy-on-write array behind an atomic shared_ptr. attach/detach copy the array
+//    under a mutex that only they take, so they never block publish() or the workers that are delivering.
+//
+// publish() is meant to be called by one thread at a time, just like Counter::increaseCounter(). Values must
+// be trivially copyable so a ring slot can be read while the publisher overwrites it; readers detect that
+// through the slot's sequence number and skip ahead.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_NOTIFICATIONDISPATCHER_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_NOTIFICATIONDISPATCHER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "InplaceFunction.hpp"
+
+template<typename V>
+requires std::is_trivially_copyable_v<V>
+class NotificationDispatcher
+{
+public:
+    using BatchObserver = UniqueFunction<void (std::span<const V>)>;
+
+    // Per-observer delivery counters
+    struct Statistics
+    {
+        std::uint64_t delivered;
+        std::uint64_t coalesced;
+        std::uint64_t batches;
+    };
+
+private:
+    // A ring slot holds the value published with sequence number `sequence`
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<V> value{};
+    };
+
+    struct Subscription
+    {
+        std::uint64_t id;
+        BatchObserver observer;
+        std::size_t capacity;
+        std::size_t maxBatch;
+        std::atomic<std::uint64_t> cursor;     // Next sequence to deliver; only the owning worker advances it
+        std::atomic<bool> active{true};
+        std::atomic<std::uint64_t> delivered{0};
+        std::atomic<std::uint64_t> coalesced{0};
+        std::atomic<std::uint64_t> batches{0};
+        std::vector<V> batch;                  // Scratch space, only touched by the owning worker
+
+        Subscription(std::uint64_t id, BatchObserver observer, std::size_t capacity, std::size_t maxBatch,
+                     std::uint64_t cursor)
+            : id{id}, observer{std::move(observer)}, capacity{capacity}, maxBatch{maxBatch}, cursor{cursor}
+        {
+            batch.reserve(maxBatch);
+        }
+    };
+
+    using SubscriptionArray = std::vector<std::shared_ptr<Subscription>>;
+
+    static constexpr int IDLE_SPINS = 64;
+
+    std::vector<Slot> ring;
+    std::uint64_t mask;
+    std::size_t workerCount;
+    alignas(64) std::atomic<std::uint64_t> published{0};
+    alignas(64) std::atomic<std::uint32_t> sleepers{0};
+    std::atomic<std::uint32_t> wake{0};
+    std::atomic<bool> running{true};
+    std::atomic<std::shared_ptr<const SubscriptionArray>> subscriptions{std::make_shared<const SubscriptionArray>()};
+    std::mutex writers;
+    std::uint64_t nextId{0};
+    std::vector<std::thread> workers;
+
+    /**
+     * Reads the value published with the given sequence number
+     * @param sequence The sequence number
+     * @param value Receives the value
+     * @return False if the slot has already been overwritten by a newer value
+     */
+    bool read(std::uint64_t sequence, V& value) const noexcept
+    {
+        const Slot& slot = ring[sequence & mask];
+        std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        value = slot.value.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return before == sequence && slot.sequence.load(std::memory_order_relaxed) == sequence;
+    }
+
+    /**
+     * Delivers everything a subscription has pending, up to its batch size, coalescing whatever it lags by
+     * beyond its queue capacity
+     * @param subscription The subscription, owned by the calling worker
+     * @param head The latest published sequence number
+     * @return True if anything was delivered
+     */
+    bool deliver(Subscription& subscription, std::uint64_t head)
+    {
+        std::uint64_t cursor = subscription.cursor.load(std::memory_order_relaxed);
+        if (cursor > head) return false;
+
+        // Too far behind; keep only the latest value
+        if (head - cursor + 1 > subscription.capacity)
+        {
+            subscription.coalesced.fetch_add(head - cursor, std::memory_order_relaxed);
+            cursor = head;
+        }
+
+        subscription.batch.clear();
+        while (cursor <= head && subscription.batch.size() < subscription.maxBatch)
+        {
+            V value;
+            if (read(cursor, value))
+            {
+                subscription.batch.push_back(value);
+                ++cursor;
+                continue;
+            }
+
+            // The publisher lapped this cursor while it was reading; jump to the newest value
+            std::uint64_t latest = published.load(std::memory_order_acquire);
+            subscription.coalesced.fetch_add(latest - cursor, std::memory_order_relaxed);
+            cursor = latest;
+            head = latest;
+        }
+
+        if (!subscription.batch.empty())
+        {
+            subscription.observer(std::span<const V>{subscription.batch});
+            subscription.delivered.fetch_add(subscription.batch.size(), std::memory_order_relaxed);
+            subscription.batches.fetch_add(1, std::memory_order_relaxed);
+        }
+        subscription.cursor.store(cursor, std::memory_order_release);
+        return !subscription.batch.empty();
+    }
+
+    /**
+     * Worker loop: sweeps the subscriptions owned by this worker and sleeps when nothing new was published
+     * @param worker Index of this worker
+     */
+    void run(std::size_t worker)
+    {
+        int idle = 0;
+        while (true)
+        {
+            const bool stopping = !running.load(std::memory_order_acquire);
+            const std::uint64_t head = published.load(std::memory_order_acquire);
+            std::shared_ptr<const SubscriptionArray> current = subscriptions.load(std::memory_order_acquire);
+
+            bool progress = false;
+            for (const auto& subscription : *current)
+            {
+                if (subscription->id % workerCount != worker) continue;
+                if (!subscription->active.load(std::memory_order_acquire)) continue;
+                progress |= deliver(*subscription, head);
+            }
+
+            if (stopping && !progress) return;
+            if (progress) { idle = 0; continue; }
+            if (++idle < IDLE_SPINS) { std::this_thread::yield(); continue; }
+
+            // Sleep until publish() or the destructor bumps wake. Registering as a sleeper before re-reading
+            // published guarantees that either the publisher sees the sleeper or this thread sees the value.
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            std::uint32_t token = wake.load(std::memory_order_seq_cst);
+            if (published.load(std::memory_order_seq_cst) == head && running.load(std::memory_order_seq_cst))
+            {
+                wake.wait(token, std::memory_order_seq_cst);
+            }
+            sleepers.fetch_sub(1, std::memory_order_seq_cst);
+            idle = 0;
+        }
+    }
+
+    /**
+     * Wakes every sleeping worker
+     */
+    void wakeWorkers() noexcept
+    {
+        wake.fetch_add(1, std::memory_order_seq_cst);
+        wake.notify_all();
+    }
+
+public:
+    /**
+     * Overloaded ctor. Starts the worker threads.
+     * @param workerCount Number of delivery threads; observers are spread across them
+     * @param ringCapacity Number of values retained for lagging observers, rounded up to a power of two
+     */
+    explicit NotificationDispatcher(std::size_t workerCount = 1, std::size_t ringCapacity = 1024)
+        : ring(std::bit_ceil(std::max<std::size_t>(ringCapacity, 2))), mask{ring.size() - 1}, workerCount{workerCount}
+    {
+        if (workerCount == 0) throw std::invalid_argument("A NotificationDispatcher needs at least one worker");
+        workers.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i) workers.emplace_back([this, i] { run(i); });
+    }
+
+    NotificationDispatcher(const NotificationDispatcher& other) = delete;
+    NotificationDispatcher(NotificationDispatcher&& other) = delete;
+
+    /**
+     * Dtor. Delivers what is still pending, then stops and joins the workers.
+     */
+    ~NotificationDispatcher()
+    {
+        running.store(false, std::memory_order_seq_cst);
+        wakeWorkers();
+        for (auto& worker : workers) worker.join();
+    }
+
+    // Operator Overloads
+    NotificationDispatcher& operator=(const NotificationDispatcher& other) = delete;
+    NotificationDispatcher& operator=(NotificationDispatcher&& other) = delete;
+
+    /**
+     * Publishes a new value to every attached observer. O(1) and lock free; the workers do the delivery.
+     * @param value The new value
+     */
+    void publish(const V& value) noexcept
+    {
+        const std::uint64_t sequence = published.load(std::memory_order_relaxed) + 1;
+        Slot& slot = ring[sequence & mask];
+
+        // Invalidate the slot before overwriting it so a reader that races with the write discards it
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.value.store(value, std::memory_order_relaxed);
+        slot.sequence.store(sequence, std::memory_order_release);
+
+        published.store(sequence, std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_seq_cst) != 0) wakeWorkers();
+    }
+
+    /**
+     * Attaches an observer that receives its pending values in batches
+     * @param observer Called on a worker thread with up to maxBatch values, oldest first
+     * @param capacity How far the observer may fall behind before older values are coalesced
+     * @param maxBatch Largest number of values passed in one call
+     * @return An id for detach() and statistics()
+     */
+    std::uint64_t attach(BatchObserver observer, std::size_t capacity = 64, std::size_t maxBatch = 32)
+    {
+        capacity = std::clamp<std::size_t>(capacity, 1, ring.size());
+        maxBatch = std::max<std::size_t>(maxBatch, 1);
+
+        std::lock_guard<std::mutex> lock{writers};
+        auto subscription = std::make_shared<Subscription>(nextId++, std::move(observer), capacity, maxBatch,
+                                                           published.load(std::memory_order_acquire) + 1);
+
+        auto copy = std::make_shared<SubscriptionArray>(*subscriptions.load(std::memory_order_acquire));
+        copy->push_back(subscription);
+        subscriptions.store(std::move(copy), std::memory_order_release);
+        return subscription->id;
+    }
+
+    /**
+     * Detaches an observer. A batch that is already being delivered to it runs to completion.
+     * @param id The id returned by attach()
+     * @return False if no observer has that id
+     */
+    bool detach(std::uint64_t id)
+    {
+        std::lock_guard<std::mutex> lock{writers};
+        auto copy = std::make_shared<SubscriptionArray>(*subscriptions.load(std::memory_order_acquire));
+        auto it = std::find_if(copy->begin(), copy->end(), [id](const auto& s) { return s->id == id; });
+        if (it == copy->end()) return false;
+
+        (*it)->active.store(false, std::memory_order_release);
+        copy->erase(it);
+        subscriptions.store(std::move(copy), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Blocks until every attached observer has received (or coalesced) every value published so far
+     */
+    void flush() const
+    {
+        const std::uint64_t target = published.load(std::memory_order_acquire);
+        std::shared_ptr<const SubscriptionArray> current = subscriptions.load(std::memory_order_acquire);
+        for (const auto& subscription : *current)
+        {
+            while (subscription->active.load(std::memory_order_acquire) &&
+                   subscription->cursor.load(std::memory_order_acquire) <= target)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * Returns the delivery counters of an observer
+     * @param id The id returned by attach()
+     * @return Values delivered, values coalesced away and number of batches
+     * @throws std::out_of_range if no observer has that id
+     */
+    Statistics statistics(std::uint64_t id) const
+    {
+        std::shared_ptr<const SubscriptionArray> current = subscriptions.load(std::memory_order_acquire);
+        for (const auto& subscription : *current)
+        {
+            if (subscription->id != id) continue;
+            return Statistics{subscription->delivered.load(), subscription->coalesced.load(), subscription->batches.load()};
+        }
+        throw std::out_of_range("No observer with id " + std::to_string(id));
+    }
+
+    /**
+     * @return Number of values published so far
+     */
+    std::uint64_t publishedCount() const noexcept
+    {
+        return published.load(std::memory_order_acquire);
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_NOTIFICATIONDISPATCHER_HPP
@@ -0,0 +1,142 @@
+//
+// Next Generation Observer Pattern with asynchronous delivery
+//
+// As in Exercise B the derived Counter is passed to Subject through CRTP so that notify() can read the counter
+// without it being passed in. Instead of calling every observer in a loop, notify() publishes the value to a
+// NotificationDispatcher, so increaseCounter() and decreaseCounter() cost the same whether zero or a
+// thousand observers are attached. Observers run on the dispatcher's worker threads; slow observers only
+// receive the latest value once they fall too far behind, and batch observers receive pending values
+// together.
+//
+// Observers are InplaceFunctions, so std::make_shared<Observer> is the only allocation an observer costs.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SUBJECT_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SUBJECT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "NotificationDispatcher.hpp"
+
+using Observer = InplaceFunction<void (double)>;
+using ObserverPtr = std::shared_ptr<Observer>;
+
+template<typename T, typename V = double>
+class Subject
+{
+public:
+    using BatchObserver = typename NotificationDispatcher<V>::BatchObserver;
+    using Statistics = typename NotificationDispatcher<V>::Statistics;
+
+private:
+    NotificationDispatcher<V> dispatcher;
+    std::vector<std::pair<ObserverPtr, std::uint64_t>> attached;  // Only used by attach/detach
+    std::mutex attachedMutex;
+
+public:
+    /**
+     * Overloaded ctor
+     * @param workers Number of threads that deliver notifications
+     * @param history Number of values kept for observers that lag behind
+     */
+    explicit Subject(std::size_t workers = 1, std::size_t history = 1024) : dispatcher{workers, history} {}
+    Subject(const Subject& other) = delete;
+    Subject(Subject&& other) = delete;
+    virtual ~Subject() = default;
+
+    // Operator Overloads
+    Subject& operator=(const Subject& other) = delete;
+    Subject& operator=(Subject&& other) = delete;
+
+    /**
+     * Attach or "subscribe" the observer to receive every value, one call per value, on a worker thread
+     * @param observerPtr The Observer that is interested in receiving updates upon state changes
+     * @param capacity How far the observer may fall behind before it only receives the latest value
+     * @return An id for detach() and statistics()
+     */
+    std::uint64_t attach(const ObserverPtr& observerPtr, std::size_t capacity = 64)
+    {
+        std::uint64_t id = dispatcher.attach([observerPtr](std::span<const V> values)
+        {
+            for (const V& value : values) (*observerPtr)(value);
+        }, capacity);
+
+        std::lock_guard<std::mutex> lock{attachedMutex};
+        attached.emplace_back(observerPtr, id);
+        return id;
+    }
+
+    /**
+     * Attach an observer that receives pending values in batches
+     * @param observer Called with up to maxBatch values, oldest first
+     * @param capacity How far the observer may fall behind before it only receives the latest value
+     * @param maxBatch Largest number of values passed in one call
+     * @return An id for detach() and statistics()
+     */
+    std::uint64_t attachBatch(BatchObserver observer, std::size_t capacity = 64, std::size_t maxBatch = 32)
+    {
+        return dispatcher.attach(std::move(observer), capacity, maxBatch);
+    }
+
+    /**
+     * Detach or "unsubscribe" the observer from further notifications
+     * @param observerPtr The Observer no longer interested in receiving updates upon state changes
+     */
+    void detach(const ObserverPtr& observerPtr)
+    {
+        std::lock_guard<std::mutex> lock{attachedMutex};
+        auto it = std::find_if(attached.begin(), attached.end(), [&](const auto& a) { return a.first == observerPtr; });
+        if (it == attached.end()) return;
+
+        dispatcher.detach(it->second);
+        attached.erase(it);
+    }
+
+    /**
+     * Detach an observer by the id it was attached under
+     * @param id The id returned by attach() or attachBatch()
+     */
+    void detach(std::uint64_t id)
+    {
+        std::lock_guard<std::mutex> lock{attachedMutex};
+        std::erase_if(attached, [id](const auto& a) { return a.second == id; });
+        dispatcher.detach(id);
+    }
+
+    /**
+     * Publishes the current counter to all the observers. Delivery happens asynchronously.
+     */
+    void notify()
+    {
+        dispatcher.publish(static_cast<T*>(this)->getCounter());
+    }
+
+    /**
+     * Waits until every observer has received the values published so far
+     */
+    void flush() const
+    {
+        dispatcher.flush();
+    }
+
+    /**
+     * Returns the delivery counters of an observer
+     * @param id The id returned by attach() or attachBatch()
+     * @return Values delivered, values coalesced away and number of batches
+     */
+    Statistics statistics(std::uint64_t id) const
+    {
+        return dispatcher.statistics(id);
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SUBJECT_HPP
@@ -0,0 +1,206 @@
+//
+// Next Generation Observer Pattern with asynchronous, coalescing delivery
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Counter.hpp"
+#include "StopWatch.hpp"
+
+// Every value arrives, in order, when the observer keeps up
+void test_OrderedDelivery()
+{
+    std::vector<double> received;
+    ObserverPtr recorder = std::make_shared<Observer>([&received](double value)
+    {
+        received.push_back(value);
+    });
+
+    Counter counter;
+    std::uint64_t id = counter.attach(recorder, 1024);
+    for (int i = 0; i < 500; ++i) counter.increaseCounter();
+    for (int i = 0; i < 100; ++i) counter.decreaseCounter();
+    counter.flush();
+
+    assert(600 == received.size());
+    for (int i = 0; i < 500; ++i) assert(i + 1 == received[i]);
+    assert(400 == received.back());
+    assert(0 == counter.statistics(id).coalesced);
+}
+
+// A slow observer only receives the latest value once it falls behind, and always ends on the final value
+void test_Coalescing()
+{
+    std::vector<double> received;
+    ObserverPtr slow = std::make_shared<Observer>([&received](double value)
+    {
+        received.push_back(value);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    });
+
+    Counter counter;
+    std::uint64_t id = counter.attach(slow, 4);
+    for (int i = 0; i < 20000; ++i) counter.increaseCounter();
+    counter.flush();
+
+    auto statistics = counter.statistics(id);
+    assert(20000 == statistics.delivered + statistics.coalesced);
+    assert(statistics.coalesced > 0);
+    assert(received.size() == statistics.delivered);
+    assert(20000 == received.back());
+    for (std::size_t i = 1; i < received.size(); ++i) assert(received[i - 1] < received[i]);
+}
+
+// Batch observers receive their pending values together, without gaps
+void test_BatchDelivery()
+{
+    std::vector<double> received;
+    std::size_t largest = 0;
+    Counter counter{1, 8192};
+    std::uint64_t id = counter.attachBatch([&](std::span<const double> values)
+    {
+        largest = std::max(largest, values.size());
+        received.insert(received.end(), values.begin(), values.end());
+    }, 8192, 16);
+
+    for (int i = 0; i < 5000; ++i) counter.increaseCounter();
+    counter.flush();
+
+    auto statistics = counter.statistics(id);
+    assert(5000 == received.size());
+    for (int i = 0; i < 5000; ++i) assert(i + 1 == received[i]);
+    assert(largest <= 16);
+    assert(statistics.batches <= statistics.delivered);
+    std::cout << "5000 updates delivered in " << statistics.batches << " batches (largest " << largest << ")" << std::endl;
+}
+
+// Observers can be attached and detached from another thread while the counter is being updated
+void test_AttachDetachWhileNotifying()
+{
+    Counter counter{2};
+    std::atomic<long> churned{0};
+    std::atomic<long> calls{0};
+    std::atomic<bool> done{false};
+
+    std::thread churn([&]
+    {
+        while (!done.load())
+        {
+            ObserverPtr observer = std::make_shared<Observer>([&churned](double) { ++churned; });
+            counter.attach(observer);
+            std::this_thread::yield();
+            counter.detach(observer);
+        }
+    });
+
+    ObserverPtr steady = std::make_shared<Observer>([&calls](double) { ++calls; });
+    std::uint64_t id = counter.attach(steady, 1024);
+    for (int i = 0; i < 100000; ++i) counter.increaseCounter();
+    done.store(true);
+    churn.join();
+    counter.flush();
+
+    auto statistics = counter.statistics(id);
+    assert(100000 == statistics.delivered + statistics.coalesced);
+
+    // Nothing is delivered to a detached observer once flush() has returned
+    counter.detach(steady);
+    long before = calls.load();
+    for (int i = 0; i < 1000; ++i) counter.increaseCounter();
+    counter.flush();
+    assert(before == calls.load());
+}
+
+// An observer detached by id can be attached again and detached by pointer
+void test_DetachReattach()
+{
+    std::atomic<long> calls{0};
+    ObserverPtr observer = std::make_shared<Observer>([&calls](double) { ++calls; });
+
+    Counter counter;
+    std::uint64_t id = counter.attach(observer, 1024);
+    counter.increaseCounter();
+    counter.flush();
+    assert(1 == calls.load());
+
+    counter.detach(id);
+    counter.increaseCounter();
+    counter.flush();
+    assert(1 == calls.load());
+
+    counter.attach(observer, 1024);
+    counter.increaseCounter();
+    counter.flush();
+    assert(2 == calls.load());
+
+    counter.detach(observer);
+    counter.increaseCounter();
+    counter.flush();
+    assert(2 == calls.load());
+}
+
+// Cost of one increaseCounter() for the synchronous Exercise B notify loop and the asynchronous Subject
+void benchmark_UpdateCost()
+{
+    std::cout << "observers\tsynchronous ns/update\tasynchronous ns/update" << std::endl;
+    for (int observerCount : {0, 1, 16, 256})
+    {
+        std::atomic<double> sink{0};
+        std::vector<ObserverPtr> observers;
+        for (int i = 0; i < observerCount; ++i)
+        {
+            observers.push_back(std::make_shared<Observer>([&sink](double value)
+            {
+                sink.store(sink.load(std::memory_order_relaxed) + std::sqrt(value), std::memory_order_relaxed);
+            }));
+        }
+
+        const int updates = 20000;
+
+        // Exercise B: notify() calls every observer on the updating thread
+        double value = 0;
+        StopWatch stopWatch;
+        stopWatch.Start();
+        for (int i = 0; i < updates; ++i)
+        {
+            ++value;
+            for (const auto& observer : observers) (*observer)(value);
+        }
+        stopWatch.Stop();
+        double synchronous = 1e9 * stopWatch.ElapsedTime();
+
+        Counter counter;
+        for (const auto& observer : observers) counter.attach(observer, 8);
+        stopWatch.Start();
+        for (int i = 0; i < updates; ++i) counter.increaseCounter();
+        stopWatch.Stop();
+        double asynchronous = 1e9 * stopWatch.ElapsedTime();
+        counter.flush();
+
+        std::cout << observerCount << "\t\t" << synchronous / updates << "\t\t\t" << asynchronous / updates << std::endl;
+    }
+}
+
+int main()
+{
+    test_OrderedDelivery();
+    test_Coalescing();
+    test_BatchDelivery();
+    test_AttachDetachWhileNotifying();
+    test_DetachReattach();
+
+    benchmark_UpdateCost();
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+//
+// A Count-Sketch: the Count-Min sketch's table, but each row also hashes a key to a sign and adds the count
+// with that sign, and a key's estimate is the median over the rows of its counter times its sign. Collisions
+// then cancel on average instead of piling up, so estimates are unbiased, may fall on either side of the
+// true count, and err by about the square root of the sum of squared counts over width instead of by a share
+// of the total. On skewed streams such as symbol activity that is much tighter for the heavy keys. Counts may
+// be negative, so it also tracks a stream of additions and removals.
+//
+// Sketches with the same width, depth and seed merge by adding their tables.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_COUNTSKETCH_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_COUNTSKETCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "SketchSupport.hpp"
+
+class CountSketch
+{
+private:
+    static constexpr std::uint8_t VERSION = 1;
+    static constexpr std::size_t MAX_DEPTH = 31;
+
+    std::size_t columns;                    // A power of two
+    std::size_t rows;
+    std::uint64_t seed;
+    std::vector<std::int64_t> counters;     // Row after row
+
+    // The row's hash of a key: its low bits pick the counter and its top bit the sign
+    static std::uint64_t rowHash(std::size_t row, std::uint64_t hash) noexcept
+    {
+        return mix64(hash + (row + 1) * 0xD6E8FEB86659FD93ULL);
+    }
+
+public:
+    /**
+     * Overloaded ctor: an empty sketch
+     * @param width The number of counters per row, a power of two
+     * @param depth The number of rows, odd and at most 31
+     * @param seed Selects the hash function of the keys
+     * @throws std::invalid_argument if width or depth is out of range
+     */
+    explicit CountSketch(std::size_t width = 2048, std::size_t depth = 5, std::uint64_t seed = 0)
+        : columns{width}, rows{depth}, seed{seed}, counters{}
+    {
+        if (width < 2 || !std::has_single_bit(width) || width > std::numeric_limits<std::uint32_t>::max())
+            throw std::invalid_argument("The width of a Count-Sketch must be a power of two, not " + std::to_string(width));
+        if (depth % 2 == 0 || depth > MAX_DEPTH)
+            throw std::invalid_argument("The depth of a Count-Sketch must be odd and at most 31, not " + std::to_string(depth));
+        counters.assign(width * depth, 0);
+    }
+
+    CountSketch(const CountSketch& source) = default;
+    CountSketch(CountSketch&& source) noexcept = default;
+    ~CountSketch() = default;
+
+    // Operator overloads
+    CountSketch& operator=(const CountSketch& source) = default;
+    CountSketch& operator=(CountSketch&& source) noexcept = default;
+    bool operator==(const CountSketch& other) const = default;
+
+    // Accessors
+    std::size_t width() const noexcept { return columns; }
+    std::size_t depth() const noexcept { return rows; }
+    std::size_t bytes() const noexcept { return counters.size() * sizeof(std::int64_t); }
+
+    // Core functionality
+    /**
+     * @param hash The hash of a key
+     * @param count Its number of new occurrences, negative for removals
+     */
+    void addHash(std::uint64_t hash, std::int64_t count = 1) noexcept
+    {
+        for (std::size_t row = 0; row < rows; ++row)
+        {
+            const std::uint64_t h = rowHash(row, hash);
+            counters[row * columns + (h & (columns - 1))] += (h >> 63) ? -count : count;
+        }
+    }
+
+    /**
+     * @param hash The hash of a key
+     * @return Its estimated count
+     */
+    std::int64_t estimateHash(std::uint64_t hash) const noexcept
+    {
+        std::array<std::int64_t, MAX_DEPTH> estimates;
+        for (std::size_t row = 0; row < rows; ++row)
+        {
+            const std::uint64_t h = rowHash(row, hash);
+            const std::int64_t counter = counters[row * columns + (h & (columns - 1))];
+            estimates[row] = (h >> 63) ? -counter : counter;
+        }
+        std::nth_element(estimates.begin(), estimates.begin() + rows / 2, estimates.begin() + rows);
+        return estimates[rows / 2];
+    }
+
+    template<typename K>
+    void add(const K& key, std::int64_t count = 1) noexcept { addHash(sketchHash(key, seed), count); }
+
+    template<typename K>
+    std::int64_t estimate(const K& key) const noexcept { return estimateHash(sketchHash(key, seed)); }
+
+    /**
+     * Adds the counts of another sketch, as if this one had seen its stream too
+     * @param other A sketch of the same width, depth and seed
+     * @throws std::invalid_argument if the shapes or seeds differ
+     */
+    void merge(const CountSketch& other)
+    {
+        if (other.columns != columns || other.rows != rows || other.seed != seed)
+            throw std::invalid_argument("Only Count-Sketches of the same width, depth and seed can be merged");
+        // Two's complement addition is the same on the unsigned view of the counters
+        SketchKernels::add(std::span<std::uint64_t>(reinterpret_cast<std::uint64_t*>(counters.data()), counters.size()),
+                           std::span<const std::uint64_t>(reinterpret_cast<const std::uint64_t*>(other.counters.data()), other.counters.size()));
+    }
+
+    /**
+     * Empties the sketch
+     */
+    void clear() noexcept
+    {
+        std::fill(counters.begin(), counters.end(), 0);
+    }
+
+    /**
+     * @return The sketch as bytes: the tag "CSKT", the version, width, depth, seed and the counters
+     */
+    std::vector<std::uint8_t> serialize() const
+    {
+        SketchWriter writer("CSKT", VERSION);
+        writer.put(static_cast<std::uint32_t>(columns));
+        writer.put(static_cast<std::uint32_t>(rows));
+        writer.put(seed);
+        writer.put(std::span<const std::int64_t>(counters));
+        return writer.release();
+    }
+
+    /**
+     * @param bytes A sketch as serialize() wrote it
+     * @return The sketch
+     * @throws std::invalid_argument if the bytes are not such a sketch
+     */
+    static CountSketch deserialize(std::span<const std::uint8_t> bytes)
+    {
+        SketchReader reader(bytes, "CSKT", VERSION);
+        const auto width = reader.get<std::uint32_t>();
+        const auto depth = reader.get<std::uint32_t>();
+        CountSketch sketch(width, depth, reader.get<std::uint64_t>());
+        reader.get(std::span<std::int64_t>(sketch.counters));
+        reader.finish();
+        return sketch;
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_COUNTSKETCH_HPP
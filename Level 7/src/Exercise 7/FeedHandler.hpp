@@ -11,13 +11,16 @@
 // of advanced compiler diagnostics which can greatly improve developer productivity over the often
 // difficult to decipher template error messages
 //
+// Each event handled is recorded in the handler's FeedStatistics, which keep per-symbol and per-exchange
+// counts, volumes and rankings in constant memory. A handler per feed line merges into the whole feed's.
+//
 // Created by Michael Lewis on 8/31/23.
 //
 
 #ifndef ADVANCED_CPP_AND_MODERN_DESIGN_FEEDHANDLER_HPP
 #define ADVANCED_CPP_AND_MODERN_DESIGN_FEEDHANDLER_HPP
 
-#include <iostream>
+#include "FeedStatistics.hpp"
 
 
 // Represents a set of constraints for a quote
@@ -49,22 +52,28 @@ concept TradeEvent = requires (const T& trade)
 
 class FeedHandler
 {
+private:
+    FeedStatistics stats;
+
 public:
     FeedHandler() = default;
     ~FeedHandler() = default;
 
+    // Accessors
+    const FeedStatistics& statistics() const noexcept { return stats; }
+
     template<typename T>
     requires QuoteEvent<T>
     void handle(const T& t)
     {
-        std::cout << "Processing a quote" << std::endl;
+        stats.recordQuote(t.getSymbol(), t.getBidExchange(), t.getAskExchange());
     }
 
     template<typename T>
     requires TradeEvent<T>
     void handle(const T& t)
     {
-        std::cout << "Processing a trade" << std::endl;
+        stats.recordTrade(t.getSymbol(), t.getExchange(), t.getSize());
     }
 };
 
@@ -0,0 +1,208 @@
+//
+// Per-symbol and per-exchange statistics of a market data feed in constant memory. Counting exactly in maps
+// keyed by symbol grows with every symbol and listing the feed ever shows; these sketches stay at their
+// initial size, under 200 KB in all:
+//
+//  - events(symbol), volume(symbol) and exchangeVolume(exchange): Count-Min estimates of quotes and trades,
+//    and of traded size, never below the true value.
+//  - distinctSymbols() and distinctListings(): HyperLogLog counts of distinct symbols and of distinct
+//    (symbol, exchange) pairs.
+//  - mostActive(), mostTraded() and busiestExchanges(): SpaceSaving heavy hitters by events and traded size.
+//
+// A symbol is hashed once for all the sketches it updates. Statistics kept by several threads, one per feed
+// line say, merge into those of the whole feed, and serialize() lets them be shipped or stored.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_FEEDSTATISTICS_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_FEEDSTATISTICS_HPP
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CountMinSketch.hpp"
+#include "HyperLogLog.hpp"
+#include "SketchSupport.hpp"
+#include "SpaceSaving.hpp"
+
+class FeedStatistics
+{
+public:
+    using Ranking = std::vector<SpaceSaving<std::string>::Entry>;
+
+private:
+    static constexpr std::uint8_t VERSION = 1;
+
+    std::uint64_t quotes;
+    std::uint64_t trades;
+    CountMinSketch symbolEvents;
+    CountMinSketch symbolVolume;
+    CountMinSketch venueVolume;
+    HyperLogLog symbols;
+    HyperLogLog listings;
+    SpaceSaving<std::string> activeSymbols;
+    SpaceSaving<std::string> tradedSymbols;
+    SpaceSaving<std::string> venues;
+
+    static std::uint64_t listingHash(std::uint64_t symbolHash, std::string_view exchange) noexcept
+    {
+        return mix64(symbolHash ^ std::rotl(sketchHash(exchange), 17));
+    }
+
+    // Sizes are counted in whole units; negative or invalid sizes count as none
+    static std::uint64_t units(double size) noexcept
+    {
+        return size >= 1 ? static_cast<std::uint64_t>(std::llround(size)) : 0;
+    }
+
+public:
+    /**
+     * Overloaded ctor: empty statistics
+     * @param heavyHitters The number of symbols and exchanges each ranking tracks
+     */
+    explicit FeedStatistics(std::size_t heavyHitters = 64)
+        : quotes{0}, trades{0}, symbolEvents{}, symbolVolume{}, venueVolume{256, 4}, symbols{}, listings{},
+          activeSymbols{heavyHitters}, tradedSymbols{heavyHitters}, venues{heavyHitters}
+    {
+
+    }
+
+    FeedStatistics(const FeedStatistics& source) = default;
+    FeedStatistics(FeedStatistics&& source) noexcept = default;
+    ~FeedStatistics() = default;
+
+    // Operator overloads
+    FeedStatistics& operator=(const FeedStatistics& source) = default;
+    FeedStatistics& operator=(FeedStatistics&& source) noexcept = default;
+
+    // Accessors
+    std::uint64_t quoteCount() const noexcept { return quotes; }
+    std::uint64_t tradeCount() const noexcept { return trades; }
+    std::uint64_t events(std::string_view symbol) const noexcept { return symbolEvents.estimate(symbol); }
+    std::uint64_t volume(std::string_view symbol) const noexcept { return symbolVolume.estimate(symbol); }
+    std::uint64_t exchangeVolume(std::string_view exchange) const noexcept { return venueVolume.estimate(exchange); }
+    double distinctSymbols() const { return symbols.estimate(); }
+    double distinctListings() const { return listings.estimate(); }
+    Ranking mostActive(std::size_t n) const { return activeSymbols.top(n); }
+    Ranking mostTraded(std::size_t n) const { return tradedSymbols.top(n); }
+    Ranking busiestExchanges(std::size_t n) const { return venues.top(n); }
+
+    /**
+     * @return The memory the sketches hold, which does not grow with the feed beyond the heavy hitters' keys
+     */
+    std::size_t bytes() const noexcept
+    {
+        return symbolEvents.bytes() + symbolVolume.bytes() + venueVolume.bytes() + symbols.bytes() + listings.bytes() +
+               (activeSymbols.capacity() + tradedSymbols.capacity() + venues.capacity()) * sizeof(SpaceSaving<std::string>::Entry);
+    }
+
+    // Core functionality
+    /**
+     * @param symbol The symbol quoted
+     * @param bidExchange The exchange of the bid, or empty
+     * @param askExchange The exchange of the ask, or empty
+     */
+    void recordQuote(std::string_view symbol, std::string_view bidExchange, std::string_view askExchange)
+    {
+        const std::uint64_t hash = sketchHash(symbol);
+        ++quotes;
+        symbolEvents.addHash(hash);
+        symbols.addHash(hash);
+        activeSymbols.add(symbol);
+        if (!bidExchange.empty()) listings.addHash(listingHash(hash, bidExchange));
+        if (!askExchange.empty() && askExchange != bidExchange) listings.addHash(listingHash(hash, askExchange));
+    }
+
+    /**
+     * @param symbol The symbol traded
+     * @param exchange The exchange of the trade, or empty
+     * @param size The size traded
+     */
+    void recordTrade(std::string_view symbol, std::string_view exchange, double size)
+    {
+        const std::uint64_t hash = sketchHash(symbol);
+        const std::uint64_t traded = units(size);
+        ++trades;
+        symbolEvents.addHash(hash);
+        symbolVolume.addHash(hash, traded);
+        symbols.addHash(hash);
+        activeSymbols.add(symbol);
+        tradedSymbols.add(symbol, traded);
+        if (!exchange.empty())
+        {
+            listings.addHash(listingHash(hash, exchange));
+            venueVolume.add(exchange, traded);
+            venues.add(exchange, traded);
+        }
+    }
+
+    /**
+     * Adds the statistics of another part of the feed
+     * @param other Statistics with the same number of heavy hitters
+     */
+    void merge(const FeedStatistics& other)
+    {
+        quotes += other.quotes;
+        trades += other.trades;
+        symbolEvents.merge(other.symbolEvents);
+        symbolVolume.merge(other.symbolVolume);
+        venueVolume.merge(other.venueVolume);
+        symbols.merge(other.symbols);
+        listings.merge(other.listings);
+        activeSymbols.merge(other.activeSymbols);
+        tradedSymbols.merge(other.tradedSymbols);
+        venues.merge(other.venues);
+    }
+
+    /**
+     * @return The statistics as bytes: the tag "FDST", the version, the counts of quotes and trades, then each
+     * sketch serialized as a block
+     */
+    std::vector<std::uint8_t> serialize() const
+    {
+        SketchWriter writer("FDST", VERSION);
+        writer.put(quotes);
+        writer.put(trades);
+        writer.putBlock(symbolEvents.serialize());
+        writer.putBlock(symbolVolume.serialize());
+        writer.putBlock(venueVolume.serialize());
+        writer.putBlock(symbols.serialize());
+        writer.putBlock(listings.serialize());
+        writer.putBlock(activeSymbols.serialize());
+        writer.putBlock(tradedSymbols.serialize());
+        writer.putBlock(venues.serialize());
+        return writer.release();
+    }
+
+    /**
+     * @param bytes Statistics as serialize() wrote them
+     * @return The statistics
+     * @throws std::invalid_argument if the bytes are not such statistics
+     */
+    static FeedStatistics deserialize(std::span<const std::uint8_t> bytes)
+    {
+        SketchReader reader(bytes, "FDST", VERSION);
+        FeedStatistics statistics;
+        statistics.quotes = reader.get<std::uint64_t>();
+        statistics.trades = reader.get<std::uint64_t>();
+        statistics.symbolEvents = CountMinSketch::deserialize(reader.getBlock());
+        statistics.symbolVolume = CountMinSketch::deserialize(reader.getBlock());
+        statistics.venueVolume = CountMinSketch::deserialize(reader.getBlock());
+        statistics.symbols = HyperLogLog::deserialize(reader.getBlock());
+        statistics.listings = HyperLogLog::deserialize(reader.getBlock());
+        statistics.activeSymbols = SpaceSaving<std::string>::deserialize(reader.getBlock());
+        statistics.tradedSymbols = SpaceSaving<std::string>::deserialize(reader.getBlock());
+        statistics.venues = SpaceSaving<std::string>::deserialize(reader.getBlock());
+        reader.finish();
+        return statistics;
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_FEEDSTATISTICS_HPP
@@ -0,0 +1,382 @@
+//
+// What the streaming sketches share: the 64-bit hash of a key, the byte format they serialize to, and the
+// element-wise kernels behind merge().
+//
+// A sketch sees a key only through its hash, so a key hashed once can update several sketches. sketchHash()
+// covers strings, such as symbols and exchange codes, and integers; other key types provide an overload.
+//
+// Serialized sketches are little-endian byte strings that start with a four-byte tag naming the sketch and
+// a version byte, so that a sketch built on one thread, process or host can be merged on another. A
+// SketchReader throws std::invalid_argument on input that is truncated or of the wrong kind.
+//
+// merge() adds counters or takes the maximum of registers over the whole sketch. Those loops run on AVX2 when
+// the CPU has it, chosen at run time, and otherwise on portable loops that give the same results.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SKETCHSUPPORT_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SKETCHSUPPORT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SKETCHSUPPORT_X86
+#endif
+
+/**
+ * The finalizer of MurmurHash3: every input bit affects every output bit
+ * @param x A 64-bit value
+ * @return Its mix
+ */
+inline std::uint64_t mix64(std::uint64_t x) noexcept
+{
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * Hashes a string eight bytes at a time, with a multiply and a rotation per word and mix64() at the end
+ * @param key The bytes
+ * @param seed Selects one of a family of hash functions
+ * @return The 64-bit hash
+ */
+inline std::uint64_t sketchHash(std::string_view key, std::uint64_t seed = 0) noexcept
+{
+    constexpr std::uint64_t K0 = 0x9E3779B97F4A7C15ULL;
+    constexpr std::uint64_t K1 = 0xC2B2AE3D27D4EB4FULL;
+    constexpr std::uint64_t K2 = 0x165667B19E3779F9ULL;
+
+    const char* bytes = key.data();
+    std::size_t size = key.size();
+    std::uint64_t h = seed ^ (size * K0);
+    for (; size >= 8; bytes += 8, size -= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, 8);
+        h = std::rotl((h ^ word) * K1, 31) * K2;
+    }
+    if (size > 0)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes, size);
+        h = std::rotl((h ^ word) * K1, 31) * K2;
+    }
+    return mix64(h);
+}
+
+/**
+ * @tparam K An integer type
+ * @param key The key
+ * @param seed Selects one of a family of hash functions
+ * @return The 64-bit hash
+ */
+template<std::integral K>
+std::uint64_t sketchHash(K key, std::uint64_t seed = 0) noexcept
+{
+    return mix64(static_cast<std::uint64_t>(key) ^ mix64(seed + 0x9E3779B97F4A7C15ULL));
+}
+
+// Appends values to a serialized sketch
+class SketchWriter
+{
+private:
+    std::vector<std::uint8_t> bytes;
+
+public:
+    /**
+     * Starts a serialized sketch with its tag and version
+     * @param tag Four characters naming the sketch
+     * @param version The version of its format
+     */
+    SketchWriter(std::string_view tag, std::uint8_t version)
+    {
+        bytes.insert(bytes.end(), tag.begin(), tag.end());
+        bytes.push_back(version);
+    }
+
+    /**
+     * @tparam T An integer type
+     * @param value Appended in little-endian order
+     */
+    template<std::integral T>
+    void put(T value)
+    {
+        const auto bits = static_cast<std::make_unsigned_t<T>>(value);
+        for (std::size_t i = 0; i < sizeof(T); ++i) bytes.push_back(static_cast<std::uint8_t>(bits >> 8 * i));
+    }
+
+    /**
+     * @param value Appended as its length and its bytes
+     */
+    void put(std::string_view value)
+    {
+        put(static_cast<std::uint32_t>(value.size()));
+        bytes.insert(bytes.end(), value.begin(), value.end());
+    }
+
+    /**
+     * @tparam T An integer type
+     * @param values Appended one after the other, without their count
+     */
+    template<std::integral T>
+    void put(std::span<const T> values)
+    {
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            const auto* first = reinterpret_cast<const std::uint8_t*>(values.data());
+            bytes.insert(bytes.end(), first, first + values.size_bytes());
+        }
+        else
+        {
+            for (T value : values) put(value);
+        }
+    }
+
+    /**
+     * @param block Appended as its length and its bytes, e.g. a sketch serialized inside another
+     */
+    void putBlock(std::span<const std::uint8_t> block)
+    {
+        put(static_cast<std::uint32_t>(block.size()));
+        bytes.insert(bytes.end(), block.begin(), block.end());
+    }
+
+    std::vector<std::uint8_t> release() noexcept { return std::move(bytes); }
+};
+
+// Reads the values of a serialized sketch back, in the order they were written
+class SketchReader
+{
+private:
+    std::span<const std::uint8_t> bytes;
+    std::size_t offset;
+
+    void require(std::size_t size) const
+    {
+        if (bytes.size() - offset < size)
+        {
+            throw std::invalid_argument("A serialized sketch ends after " + std::to_string(bytes.size()) +
+                                        " bytes, " + std::to_string(offset + size) + " needed");
+        }
+    }
+
+public:
+    /**
+     * Checks the tag and version of a serialized sketch
+     * @param bytes The serialized sketch
+     * @param tag The four characters naming the sketch expected
+     * @param version The version of the format expected
+     * @throws std::invalid_argument if the sketch is of another kind or version
+     */
+    SketchReader(std::span<const std::uint8_t> bytes, std::string_view tag, std::uint8_t version)
+        : bytes{bytes}, offset{0}
+    {
+        require(tag.size() + 1);
+        if (!std::equal(tag.begin(), tag.end(), bytes.begin()) || bytes[tag.size()] != version)
+        {
+            throw std::invalid_argument("Not a serialized " + std::string(tag) + " version " + std::to_string(version));
+        }
+        offset = tag.size() + 1;
+    }
+
+    /**
+     * @tparam T An integer type
+     * @return The next value
+     * @throws std::invalid_argument if the bytes run out
+     */
+    template<std::integral T>
+    T get()
+    {
+        require(sizeof(T));
+        std::make_unsigned_t<T> bits = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+        {
+            bits |= static_cast<std::make_unsigned_t<T>>(static_cast<std::make_unsigned_t<T>>(bytes[offset + i]) << 8 * i);
+        }
+        offset += sizeof(T);
+        return static_cast<T>(bits);
+    }
+
+    /**
+     * @return The next string
+     * @throws std::invalid_argument if the bytes run out
+     */
+    std::string getString()
+    {
+        const auto size = get<std::uint32_t>();
+        require(size);
+        std::string value(reinterpret_cast<const char*>(bytes.data() + offset), size);
+        offset += size;
+        return value;
+    }
+
+    /**
+     * @return The next block of bytes
+     * @throws std::invalid_argument if the bytes run out
+     */
+    std::span<const std::uint8_t> getBlock()
+    {
+        const auto size = get<std::uint32_t>();
+        require(size);
+        const std::span<const std::uint8_t> block = bytes.subspan(offset, size);
+        offset += size;
+        return block;
+    }
+
+    /**
+     * @tparam T An integer type
+     * @param values Receives the next values.size() values
+     * @throws std::invalid_argument if the bytes run out
+     */
+    template<std::integral T>
+    void get(std::span<T> values)
+    {
+        require(values.size_bytes());
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            std::memcpy(values.data(), bytes.data() + offset, values.size_bytes());
+            offset += values.size_bytes();
+        }
+        else
+        {
+            for (T& value : values) value = get<T>();
+        }
+    }
+
+    /**
+     * @throws std::invalid_argument if bytes are left over
+     */
+    void finish() const
+    {
+        if (offset != bytes.size())
+        {
+            throw std::invalid_argument("A serialized sketch has " + std::to_string(bytes.size() - offset) + " bytes too many");
+        }
+    }
+};
+
+// The element-wise loops of merge()
+class SketchKernels
+{
+private:
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SKETCHSUPPORT_X86
+    __attribute__((target("avx2")))
+    static void addAvx2(std::uint64_t* target, const std::uint64_t* source, std::size_t size) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            auto* t = reinterpret_cast<__m256i*>(target + i);
+            const auto* s = reinterpret_cast<const __m256i*>(source + i);
+            _mm256_storeu_si256(t, _mm256_add_epi64(_mm256_loadu_si256(t), _mm256_loadu_si256(s)));
+            _mm256_storeu_si256(t + 1, _mm256_add_epi64(_mm256_loadu_si256(t + 1), _mm256_loadu_si256(s + 1)));
+        }
+        for (; i < size; ++i) target[i] += source[i];
+    }
+
+    __attribute__((target("avx2")))
+    static void maxAvx2(std::uint8_t* target, const std::uint8_t* source, std::size_t size) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 64 <= size; i += 64)
+        {
+            auto* t = reinterpret_cast<__m256i*>(target + i);
+            const auto* s = reinterpret_cast<const __m256i*>(source + i);
+            _mm256_storeu_si256(t, _mm256_max_epu8(_mm256_loadu_si256(t), _mm256_loadu_si256(s)));
+            _mm256_storeu_si256(t + 1, _mm256_max_epu8(_mm256_loadu_si256(t + 1), _mm256_loadu_si256(s + 1)));
+        }
+        for (; i < size; ++i) target[i] = std::max(target[i], source[i]);
+    }
+#endif
+
+    static std::atomic<bool>& simdSwitch()
+    {
+        static std::atomic<bool> enabled{simdSupported()};
+        return enabled;
+    }
+
+public:
+    /**
+     * @return True if the CPU supports AVX2
+     */
+    static bool simdSupported()
+    {
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SKETCHSUPPORT_X86
+        static const bool supported = []
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+        }();
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @return True if the kernels use AVX2
+     */
+    static bool simdEnabled() { return simdSwitch().load(std::memory_order_relaxed); }
+
+    /**
+     * Switches AVX2 on or off, e.g. to compare it with the portable loops. It cannot be switched on where it
+     * is not supported.
+     * @param enabled Whether to use AVX2
+     */
+    static void enableSimd(bool enabled) { simdSwitch().store(enabled && simdSupported(), std::memory_order_relaxed); }
+
+    /**
+     * target[i] += source[i]
+     * @param target The counters merged into
+     * @param source The counters merged, as many
+     */
+    static void add(std::span<std::uint64_t> target, std::span<const std::uint64_t> source) noexcept
+    {
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SKETCHSUPPORT_X86
+        if (simdEnabled())
+        {
+            addAvx2(target.data(), source.data(), target.size());
+            return;
+        }
+#endif
+        for (std::size_t i = 0; i < target.size(); ++i) target[i] += source[i];
+    }
+
+    /**
+     * target[i] = max(target[i], source[i])
+     * @param target The registers merged into
+     * @param source The registers merged, as many
+     */
+    static void max(std::span<std::uint8_t> target, std::span<const std::uint8_t> source) noexcept
+    {
+#ifdef ADVANCED_CPP_AND_MODERN_DESIGN_SKETCHSUPPORT_X86
+        if (simdEnabled())
+        {
+            maxAvx2(target.data(), source.data(), target.size());
+            return;
+        }
+#endif
+        for (std::size_t i = 0; i < target.size(); ++i) target[i] = std::max(target[i], source[i]);
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SKETCHSUPPORT_HPP
@@ -0,0 +1,331 @@
+//
+// SpaceSaving: the heavy hitters of a stream, such as the most active symbols or the busiest exchanges, with
+// a fixed number of counters. A key that has a counter adds to it. A new key takes over the smallest counter,
+// inheriting its count as its possible error, so a counter's count never falls below its key's true count and
+// count - error never exceeds it. Any key with more than total / capacity of the stream has a counter, and
+// the largest counts are the heavy hitters, each within the smallest count of its true count.
+//
+// The counters sit in a min-heap so that the smallest is found in O(1) and a count that grows moves in
+// O(log capacity); a hash map finds a key's counter. A key that takes over a counter reuses the map node of the
+// key it evicts, so a long tail of rare keys does not allocate. The default hash is transparent, so a
+// SpaceSaving<std::string> is updated from a std::string_view without building a string for keys it has.
+//
+// Summaries merge as in parallel SpaceSaving (Cafaro et al.): a key's counts add up, a key missing from one
+// summary is charged that summary's smallest count as both count and error, and the largest counts are kept.
+// The guarantees above hold for the merged summary over the combined stream.
+//
+// Created by Michael Lewis on 10/19/26.
+//
+
+#ifndef ADVANCED_CPP_AND_MODERN_DESIGN_SPACESAVING_HPP
+#define ADVANCED_CPP_AND_MODERN_DESIGN_SPACESAVING_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SketchSupport.hpp"
+
+// A transparent hash over sketchHash(), for strings looked up by std::string_view and for integers
+struct SketchKeyHash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view key) const noexcept { return sketchHash(key); }
+
+    template<std::integral K>
+    std::size_t operator()(K key) const noexcept { return sketchHash(key); }
+};
+
+template<typename K, typename Hash = SketchKeyHash>
+class SpaceSaving
+{
+public:
+    struct Entry
+    {
+        K key;
+        std::uint64_t count;        // No less than the key's true count
+        std::uint64_t error;        // count - error is no more than the key's true count
+    };
+
+private:
+    static constexpr std::uint8_t VERSION = 1;
+
+    struct Counter
+    {
+        Entry entry;
+        std::uint32_t position;     // In heap
+    };
+
+    std::size_t limit;
+    std::uint64_t total;
+    std::vector<Counter> counters;
+    std::vector<std::uint32_t> heap;                            // Indices of counters, smallest count first
+    std::unordered_map<K, std::uint32_t, Hash, std::equal_to<>> index;
+
+    std::uint64_t countAt(std::size_t position) const noexcept { return counters[heap[position]].entry.count; }
+
+    void place(std::size_t position, std::uint32_t counter) noexcept
+    {
+        heap[position] = counter;
+        counters[counter].position = static_cast<std::uint32_t>(position);
+    }
+
+    void siftUp(std::size_t position) noexcept
+    {
+        const std::uint32_t counter = heap[position];
+        const std::uint64_t count = counters[counter].entry.count;
+        while (position > 0)
+        {
+            const std::size_t parent = (position - 1) / 2;
+            if (countAt(parent) <= count) break;
+            place(position, heap[parent]);
+            position = parent;
+        }
+        place(position, counter);
+    }
+
+    void siftDown(std::size_t position) noexcept
+    {
+        const std::uint32_t counter = heap[position];
+        const std::uint64_t count = counters[counter].entry.count;
+        while (true)
+        {
+            std::size_t child = 2 * position + 1;
+            if (child >= heap.size()) break;
+            if (child + 1 < heap.size() && countAt(child + 1) < countAt(child)) ++child;
+            if (countAt(child) >= count) break;
+            place(position, heap[child]);
+            position = child;
+        }
+        place(position, counter);
+    }
+
+    /**
+     * Replaces the counters
+     * @param entries At most capacity entries
+     */
+    void rebuild(std::vector<Entry> entries)
+    {
+        counters.clear();
+        heap.clear();
+        index.clear();
+        for (Entry& entry : entries)
+        {
+            const auto counter = static_cast<std::uint32_t>(counters.size());
+            if (!index.emplace(entry.key, counter).second) throw std::invalid_argument("A SpaceSaving summary has a key twice");
+            counters.push_back(Counter{std::move(entry), counter});
+            heap.push_back(counter);
+        }
+        for (std::size_t position = heap.size() / 2; position-- > 0;) siftDown(position);
+    }
+
+public:
+    /**
+     * Overloaded ctor: an empty summary
+     * @param capacity The number of counters
+     * @throws std::invalid_argument if the capacity is 0 or too large for the counters' indices
+     */
+    explicit SpaceSaving(std::size_t capacity = 64)
+        : limit{capacity}, total{0}, counters{}, heap{}, index{}
+    {
+        if (capacity == 0 || capacity > std::numeric_limits<std::uint32_t>::max())
+            throw std::invalid_argument("A SpaceSaving summary cannot have " + std::to_string(capacity) + " counters");
+    }
+
+    SpaceSaving(const SpaceSaving& source) = default;
+    SpaceSaving(SpaceSaving&& source) noexcept = default;
+    ~SpaceSaving() = default;
+
+    // Operator overloads
+    SpaceSaving& operator=(const SpaceSaving& source) = default;
+    SpaceSaving& operator=(SpaceSaving&& source) noexcept = default;
+
+    // Accessors
+    std::size_t capacity() const noexcept { return limit; }
+    std::size_t size() const noexcept { return counters.size(); }
+    std::uint64_t totalCount() const noexcept { return total; }
+
+    /**
+     * @return The smallest count once every counter is in use, which bounds the count of any key without one;
+     * 0 before
+     */
+    std::uint64_t minimum() const noexcept { return counters.size() < limit ? 0 : countAt(0); }
+
+    /**
+     * @param key A key
+     * @return An upper bound on its count: its counter's count, or minimum() if it has none
+     */
+    template<typename Key>
+    std::uint64_t estimate(const Key& key) const
+    {
+        const auto found = index.find(key);
+        return found == index.end() ? minimum() : counters[found->second].entry.count;
+    }
+
+    /**
+     * @param n The number of entries wanted
+     * @return The n entries with the largest counts, largest first
+     */
+    std::vector<Entry> top(std::size_t n) const
+    {
+        std::vector<Entry> entries;
+        entries.reserve(counters.size());
+        for (const Counter& counter : counters) entries.push_back(counter.entry);
+        n = std::min(n, entries.size());
+        std::partial_sort(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(n), entries.end(),
+                          [](const Entry& a, const Entry& b) { return a.count > b.count; });
+        entries.resize(n);
+        return entries;
+    }
+
+    // Core functionality
+    /**
+     * @param key A key
+     * @param weight Its number of new occurrences, or their weight
+     */
+    template<typename Key>
+    void add(const Key& key, std::uint64_t weight = 1)
+    {
+        if (weight == 0) return;
+        total += weight;
+
+        if (const auto found = index.find(key); found != index.end())
+        {
+            Counter& counter = counters[found->second];
+            counter.entry.count += weight;
+            siftDown(counter.position);
+            return;
+        }
+
+        if (counters.size() < limit)
+        {
+            const auto counter = static_cast<std::uint32_t>(counters.size());
+            counters.push_back(Counter{Entry{K(key), weight, 0}, counter});
+            heap.push_back(counter);
+            index.emplace(counters.back().entry.key, counter);
+            siftUp(heap.size() - 1);
+            return;
+        }
+
+        // Take over the smallest counter, and the map node of the key it held
+        Counter& smallest = counters[heap[0]];
+        auto node = index.extract(smallest.entry.key);
+        smallest.entry.key = K(key);
+        node.key() = smallest.entry.key;
+        index.insert(std::move(node));
+        smallest.entry.error = smallest.entry.count;
+        smallest.entry.count += weight;
+        siftDown(0);
+    }
+
+    /**
+     * Adds the stream of another summary
+     * @param other A summary of any capacity; this one keeps its own
+     */
+    void merge(const SpaceSaving& other)
+    {
+        const std::uint64_t mine = minimum();
+        const std::uint64_t theirs = other.minimum();
+        std::vector<Entry> entries;
+        entries.reserve(counters.size() + other.counters.size());
+        for (const Counter& counter : counters)
+        {
+            const auto found = other.index.find(counter.entry.key);
+            if (found == other.index.end())
+            {
+                entries.push_back(Entry{counter.entry.key, counter.entry.count + theirs, counter.entry.error + theirs});
+            }
+            else
+            {
+                const Entry& match = other.counters[found->second].entry;
+                entries.push_back(Entry{counter.entry.key, counter.entry.count + match.count, counter.entry.error + match.error});
+            }
+        }
+        for (const Counter& counter : other.counters)
+        {
+            if (index.contains(counter.entry.key)) continue;
+            entries.push_back(Entry{counter.entry.key, counter.entry.count + mine, counter.entry.error + mine});
+        }
+
+        const std::size_t kept = std::min(limit, entries.size());
+        std::partial_sort(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(kept), entries.end(),
+                          [](const Entry& a, const Entry& b) { return a.count > b.count; });
+        entries.resize(kept);
+        rebuild(std::move(entries));
+        total += other.total;
+    }
+
+    /**
+     * Empties the summary
+     */
+    void clear() noexcept
+    {
+        counters.clear();
+        heap.clear();
+        index.clear();
+        total = 0;
+    }
+
+    /**
+     * @return The summary as bytes: the tag "SPSV", the version, capacity, total and number of entries, then
+     * each entry's key, count and error
+     */
+    std::vector<std::uint8_t> serialize() const
+    {
+        SketchWriter writer("SPSV", VERSION);
+        writer.put(static_cast<std::uint64_t>(limit));
+        writer.put(total);
+        writer.put(static_cast<std::uint32_t>(counters.size()));
+        for (const Counter& counter : counters)
+        {
+            if constexpr (std::integral<K>) writer.put(counter.entry.key);
+            else writer.put(std::string_view(counter.entry.key));
+            writer.put(counter.entry.count);
+            writer.put(counter.entry.error);
+        }
+        return writer.release();
+    }
+
+    /**
+     * @param bytes A summary as serialize() wrote it
+     * @return The summary
+     * @throws std::invalid_argument if the bytes are not such a summary
+     */
+    static SpaceSaving deserialize(std::span<const std::uint8_t> bytes)
+    {
+        SketchReader reader(bytes, "SPSV", VERSION);
+        const auto capacity = reader.get<std::uint64_t>();
+        SpaceSaving summary(static_cast<std::size_t>(std::min<std::uint64_t>(capacity, std::numeric_limits<std::size_t>::max())));
+        summary.total = reader.get<std::uint64_t>();
+        const auto size = reader.get<std::uint32_t>();
+        if (size > capacity) throw std::invalid_argument("A serialized SpaceSaving summary has more entries than counters");
+
+        std::vector<Entry> entries;
+        for (std::uint32_t i = 0; i < size; ++i)
+        {
+            Entry entry;
+            if constexpr (std::integral<K>) entry.key = reader.get<K>();
+            else entry.key = K(reader.getString());
+            entry.count = reader.get<std::uint64_t>();
+            entry.error = reader.get<std::uint64_t>();
+            if (entry.error > entry.count) throw std::invalid_argument("A serialized SpaceSaving entry has an error above its count");
+            entries.push_back(std::move(entry));
+        }
+        reader.finish();
+        summary.rebuild(std::move(entries));
+        return summary;
+    }
+};
+
+#endif //ADVANCED_CPP_AND_MODERN_DESIGN_SPACESAVING_HPP
@@ -1,12 +1,55 @@
 //
 // Concepts - Basic Illustration
 //
+// The FeedHandler records what it handles in FeedStatistics: Count-Min and Count-Sketch counts, HyperLogLog
+// distinct counts and SpaceSaving heavy hitters. The tests check each sketch against exact counts over a
+// skewed stream of symbols, that sketches kept by several threads merge into those of the whole stream, and
+// that serialization round-trips. The benchmarks report ns per event and memory for the sketches against
+// exact maps, and the time to merge tables with the AVX2 kernels and without.
+//
 // Created by Michael Lewis on 8/31/23.
 //
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "Quote.hpp"
+#include "StopWatch.hpp"
 #include "Trade.hpp"
 #include "FeedHandler.hpp"
+#include "CountSketch.hpp"
+
+// A stream of n symbols out of a universe of the given size, the i-th most active with weight 1 / (i + 1)
+std::vector<std::string> zipfStream(std::size_t n, std::size_t universe, std::uint64_t seed)
+{
+    std::vector<double> weights(universe);
+    for (std::size_t i = 0; i < universe; ++i) weights[i] = 1.0 / static_cast<double>(i + 1);
+    std::discrete_distribution<std::size_t> ranks(weights.begin(), weights.end());
+    std::mt19937_64 engine{seed};
+
+    std::vector<std::string> stream;
+    stream.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) stream.push_back("SYM" + std::to_string(ranks(engine)) + ".US");
+    return stream;
+}
+
+std::unordered_map<std::string, std::uint64_t> exactCounts(const std::vector<std::string>& stream)
+{
+    std::unordered_map<std::string, std::uint64_t> counts;
+    for (const std::string& symbol : stream) ++counts[symbol];
+    return counts;
+}
 
 // Test that a valid quote object can be processed by the FeedHandler
 void test_Quote()
@@ -16,10 +59,19 @@ void test_Quote()
     quote.setBidSize(188.93);
     quote.setBidSize(1000);
     quote.setBidExchange("XNAS");
+    quote.setAskExchange("ARCX");
     quote.setTimestamp("20230831T12:59:59");
 
     FeedHandler handler;
     handler.handle(quote);
+
+    const FeedStatistics& statistics = handler.statistics();
+    assert(1 == statistics.quoteCount());
+    assert(1 == statistics.events("AAPL.US"));
+    assert(0 == statistics.volume("AAPL.US"));
+    assert(1 == std::lround(statistics.distinctSymbols()));
+    assert(2 == std::lround(statistics.distinctListings()));
+    assert("AAPL.US" == statistics.mostActive(1).front().key);
 }
 
 // Test that a valid trade object can be processed by the FeedHandler
@@ -36,12 +88,492 @@ void test_Trade()
 
     FeedHandler handler;
     handler.handle(trade);
+
+    const FeedStatistics& statistics = handler.statistics();
+    assert(1 == statistics.tradeCount());
+    assert(1 == statistics.events("AAPL.US"));
+    assert(1000 == statistics.volume("AAPL.US"));
+    assert(1000 == statistics.exchangeVolume("XNAS"));
+    assert("AAPL.US" == statistics.mostTraded(1).front().key);
+    assert("XNAS" == statistics.busiestExchanges(1).front().key);
+}
+
+// Equal keys hash equally whatever their type, and the seed changes the hash
+void test_Hashing()
+{
+    const std::string symbol = "MSFT.US";
+    assert(sketchHash(symbol) == sketchHash(std::string_view("MSFT.US")));
+    assert(sketchHash(symbol) != sketchHash(symbol, 1));
+    assert(sketchHash(std::uint32_t{7}) == sketchHash(std::uint64_t{7}));
+    assert(sketchHash(std::string_view("AB")) != sketchHash(std::string_view("BA")));
+
+    // The low bits of the hashes of consecutive keys spread evenly
+    std::vector<int> buckets(64);
+    for (std::uint64_t i = 0; i < 64'000; ++i) ++buckets[sketchHash(i) & 63];
+    for (int bucket : buckets) assert(bucket > 800 && bucket < 1200);
+}
+
+// Count-Min estimates are never below the true counts, and within the error bound nearly always
+void test_CountMin()
+{
+    const auto stream = zipfStream(200'000, 20'000, 1);
+    const auto counts = exactCounts(stream);
+
+    CountMinSketch sketch;
+    CountMinSketch conservative;
+    for (const std::string& symbol : stream)
+    {
+        sketch.add(symbol);
+        conservative.addConservative(symbol);
+    }
+    assert(stream.size() == sketch.totalCount());
+
+    std::size_t outside = 0;
+    std::uint64_t plain = 0, tight = 0;
+    for (const auto& [symbol, count] : counts)
+    {
+        const std::uint64_t estimate = sketch.estimate(symbol);
+        assert(estimate >= count);
+        assert(conservative.estimate(symbol) >= count);
+        assert(conservative.estimate(symbol) <= estimate);
+        if (static_cast<double>(estimate - count) > sketch.errorBound()) ++outside;
+        plain += estimate - count;
+        tight += conservative.estimate(symbol) - count;
+    }
+    assert(outside * 50 < counts.size());
+    assert(tight < plain);
+
+    const CountMinSketch sized = CountMinSketch::fromError(0.001, 0.01);
+    assert(4096 == sized.width() && 5 == sized.depth());
+
+    bool thrown = false;
+    try { CountMinSketch(1000, 4); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// Sketches counted by threads over parts of a stream merge into the sketch of the whole stream
+void test_CountMinMerge()
+{
+    constexpr std::size_t THREADS = 4;
+    const auto stream = zipfStream(100'000, 5'000, 2);
+
+    std::vector<CountMinSketch> parts(THREADS);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (std::size_t i = t; i < stream.size(); i += THREADS) parts[t].add(stream[i]);
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    CountMinSketch whole;
+    for (const std::string& symbol : stream) whole.add(symbol);
+    CountMinSketch merged;
+    for (const CountMinSketch& part : parts) merged.merge(part);
+    assert(whole == merged);
+
+    const auto bytes = merged.serialize();
+    assert(CountMinSketch::deserialize(bytes) == whole);
+
+    bool thrown = false;
+    try { merged.merge(CountMinSketch(2048, 4, 99)); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    auto truncated = bytes;
+    truncated.pop_back();
+    try { CountMinSketch::deserialize(truncated); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+
+    thrown = false;
+    try { CountSketch::deserialize(bytes); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// Count-Sketch estimates of the heavy symbols are close on either side, and removals cancel additions
+void test_CountSketch()
+{
+    const auto stream = zipfStream(200'000, 20'000, 3);
+    const auto counts = exactCounts(stream);
+
+    CountSketch sketch;
+    for (const std::string& symbol : stream) sketch.add(symbol);
+
+    double squares = 0;
+    for (const auto& [symbol, count] : counts) squares += static_cast<double>(count) * static_cast<double>(count);
+    const double bound = 3 * std::sqrt(squares / static_cast<double>(sketch.width()));
+    for (int rank = 0; rank < 20; ++rank)
+    {
+        const std::string symbol = "SYM" + std::to_string(rank) + ".US";
+        const auto error = std::abs(sketch.estimate(symbol) - static_cast<std::int64_t>(counts.at(symbol)));
+        assert(static_cast<double>(error) <= bound);
+    }
+
+    CountSketch halves[2];
+    for (std::size_t i = 0; i < stream.size(); ++i) halves[i % 2].add(stream[i]);
+    halves[0].merge(halves[1]);
+    assert(halves[0] == sketch);
+    assert(CountSketch::deserialize(sketch.serialize()) == sketch);
+
+    for (const std::string& symbol : stream) sketch.add(symbol, -1);
+    assert(CountSketch() == sketch);
+}
+
+// HyperLogLog estimates stay within a few standard errors, in sparse and dense mode
+void test_HyperLogLog()
+{
+    for (std::uint64_t distinct : {10ULL, 1'000ULL, 3'000ULL, 50'000ULL, 1'000'000ULL})
+    {
+        HyperLogLog sketch;
+        for (std::uint64_t i = 0; i < distinct; ++i)
+        {
+            sketch.add(i);
+            sketch.add(i);
+        }
+        const double error = std::abs(sketch.estimate() / static_cast<double>(distinct) - 1);
+        assert(error < 4 * sketch.standardError());
+        assert(sketch.isSparse() == (distinct <= 3'000));
+    }
+
+    // Small sparse sketches are exact up to hash collisions
+    HyperLogLog few;
+    for (std::uint64_t i = 0; i < 100; ++i) few.add("KEY" + std::to_string(i));
+    assert(100 == std::lround(few.estimate()));
+    assert(few.isSparse() && few.bytes() < 2048);
+
+    bool thrown = false;
+    try { HyperLogLog(3); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// Sketches of overlapping streams merge into the sketch of their union, whatever their modes
+void test_HyperLogLogMerge()
+{
+    const auto fill = [](std::uint64_t from, std::uint64_t to)
+    {
+        HyperLogLog sketch;
+        for (std::uint64_t i = from; i < to; ++i) sketch.add(i);
+        return sketch;
+    };
+
+    for (auto [size, overlap] : {std::pair{500ULL, 200ULL}, std::pair{2'000ULL, 1'000ULL}, std::pair{200'000ULL, 50'000ULL}})
+    {
+        HyperLogLog left = fill(0, size);
+        const HyperLogLog right = fill(size - overlap, 2 * size - overlap);
+        const HyperLogLog whole = fill(0, 2 * size - overlap);
+        left.merge(right);
+        assert(left.estimate() == whole.estimate());
+        const double error = std::abs(left.estimate() / static_cast<double>(2 * size - overlap) - 1);
+        assert(error < 4 * left.standardError());
+
+        const HyperLogLog copy = HyperLogLog::deserialize(left.serialize());
+        assert(copy == left);
+        assert(copy.estimate() == left.estimate());
+    }
+
+    // A sparse sketch merges into a dense one
+    HyperLogLog dense = fill(0, 100'000);
+    dense.merge(fill(100'000, 100'100));
+    const double error = std::abs(dense.estimate() / 100'100.0 - 1);
+    assert(error < 4 * dense.standardError());
+
+    bool thrown = false;
+    try { dense.merge(HyperLogLog(12)); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// SpaceSaving finds every symbol above total / capacity, with counts bracketing the true ones
+void test_SpaceSaving()
+{
+    const auto stream = zipfStream(200'000, 20'000, 4);
+    const auto counts = exactCounts(stream);
+
+    SpaceSaving<std::string> summary(100);
+    for (const std::string& symbol : stream) summary.add(std::string_view(symbol));
+    assert(100 == summary.size());
+    assert(stream.size() == summary.totalCount());
+
+    for (const auto& [symbol, count] : counts)
+    {
+        assert(summary.estimate(symbol) >= count);
+        if (count > stream.size() / 100) assert(summary.estimate(std::string_view(symbol)) > summary.minimum());
+    }
+    const auto top = summary.top(10);
+    for (std::size_t i = 0; i < top.size(); ++i)
+    {
+        assert(top[i].count >= counts.at(top[i].key));
+        assert(top[i].count - top[i].error <= counts.at(top[i].key));
+        assert(i == 0 || top[i - 1].count >= top[i].count);
+    }
+    assert("SYM0.US" == top.front().key);
+
+    // Summaries of halves of the stream merge into one that keeps the guarantees
+    SpaceSaving<std::string> halves[2] = {SpaceSaving<std::string>(100), SpaceSaving<std::string>(100)};
+    for (std::size_t i = 0; i < stream.size(); ++i) halves[i % 2].add(stream[i]);
+    halves[0].merge(halves[1]);
+    assert(stream.size() == halves[0].totalCount());
+    for (const auto& [symbol, count] : counts)
+    {
+        assert(halves[0].estimate(symbol) >= count);
+        if (count > stream.size() / 100) assert(halves[0].estimate(symbol) > halves[0].minimum());
+    }
+    for (const auto& entry : halves[0].top(100)) assert(entry.count - entry.error <= counts.at(entry.key));
+
+    const auto copy = SpaceSaving<std::string>::deserialize(summary.serialize());
+    assert(copy.top(100).size() == 100);
+    for (const auto& entry : summary.top(100)) assert(copy.estimate(entry.key) == entry.count);
+
+    SpaceSaving<std::uint32_t> integers(4);
+    for (std::uint32_t key : {1, 1, 1, 2, 3, 4, 5}) integers.add(key);
+    assert(1 == integers.top(1).front().key && 3 == integers.top(1).front().count);
+    assert(2 == integers.estimate(5u) && 1 == integers.minimum());
+
+    bool thrown = false;
+    try { SpaceSaving<std::string>(0); }
+    catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+}
+
+// FeedHandlers on several threads, one per feed line, merge into the statistics of the whole feed
+void test_FeedStatistics()
+{
+    constexpr std::size_t THREADS = 4;
+    const auto stream = zipfStream(100'000, 8'000, 5);
+    const std::vector<std::string> exchanges = {"XNAS", "XNYS", "ARCX", "BATS", "EDGX"};
+
+    const auto event = [&](FeedHandler& handler, std::size_t i)
+    {
+        if (i % 4 == 0)
+        {
+            Trade trade;
+            trade.setSymbol(stream[i]);
+            trade.setExchange(exchanges[i % exchanges.size()]);
+            trade.setSize(static_cast<double>(100 * (i % 7 + 1)));
+            handler.handle(trade);
+        }
+        else
+        {
+            Quote quote;
+            quote.setSymbol(stream[i]);
+            quote.setBidExchange(exchanges[i % exchanges.size()]);
+            quote.setAskExchange(exchanges[(i + 1) % exchanges.size()]);
+            handler.handle(quote);
+        }
+    };
+
+    std::vector<FeedHandler> lines(THREADS);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (std::size_t i = t; i < stream.size(); i += THREADS) event(lines[t], i);
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    FeedHandler whole;
+    for (std::size_t i = 0; i < stream.size(); ++i) event(whole, i);
+    FeedStatistics merged;
+    for (const FeedHandler& line : lines) merged.merge(line.statistics());
+
+    const FeedStatistics& statistics = whole.statistics();
+    assert(merged.quoteCount() == statistics.quoteCount() && 75'000 == merged.quoteCount());
+    assert(merged.tradeCount() == statistics.tradeCount());
+    const auto counts = exactCounts(stream);
+    for (int rank = 0; rank < 50; ++rank)
+    {
+        const std::string symbol = "SYM" + std::to_string(rank) + ".US";
+        assert(merged.events(symbol) == statistics.events(symbol));
+        assert(merged.events(symbol) >= counts.at(symbol));
+        assert(merged.volume(symbol) == statistics.volume(symbol));
+    }
+    std::uint64_t volume = 0;
+    for (std::size_t i = 0; i < stream.size(); i += 4) volume += 100 * (i % 7 + 1);
+    for (const std::string& exchange : exchanges) volume -= std::min(volume, merged.exchangeVolume(exchange));
+    assert(0 == volume);
+
+    const auto exact = static_cast<double>(counts.size());
+    assert(std::abs(merged.distinctSymbols() / exact - 1) < 0.04);
+    assert(std::abs(merged.distinctSymbols() - statistics.distinctSymbols()) < 1e-9 * exact);
+    assert(merged.distinctListings() > merged.distinctSymbols());
+    assert("SYM0.US" == merged.mostActive(1).front().key);
+    assert(exchanges.size() == merged.busiestExchanges(10).size());
+
+    const FeedStatistics copy = FeedStatistics::deserialize(merged.serialize());
+    assert(copy.quoteCount() == merged.quoteCount());
+    assert(copy.events("SYM1.US") == merged.events("SYM1.US"));
+    assert(copy.distinctListings() == merged.distinctListings());
+    assert(copy.mostTraded(5).front().key == merged.mostTraded(5).front().key);
+    assert(merged.bytes() < 300'000);
+}
+
+// The AVX2 kernels agree with the portable ones, including on tails shorter than a vector
+void test_Kernels()
+{
+    std::mt19937_64 engine{6};
+    for (std::size_t size : {0, 3, 31, 32, 33, 1000})
+    {
+        std::vector<std::uint64_t> counters(size), others(size);
+        std::vector<std::uint8_t> registers(size), ranks(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            counters[i] = engine();
+            others[i] = engine();
+            registers[i] = static_cast<std::uint8_t>(engine() % 64);
+            ranks[i] = static_cast<std::uint8_t>(engine() % 64);
+        }
+
+        auto sums = counters;
+        auto maxima = registers;
+        SketchKernels::enableSimd(false);
+        SketchKernels::add(sums, others);
+        SketchKernels::max(maxima, ranks);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            assert(sums[i] == counters[i] + others[i]);
+            assert(maxima[i] == std::max(registers[i], ranks[i]));
+        }
+
+        SketchKernels::enableSimd(true);
+        auto fastSums = counters;
+        auto fastMaxima = registers;
+        SketchKernels::add(fastSums, others);
+        SketchKernels::max(fastMaxima, ranks);
+        assert(fastSums == sums);
+        assert(fastMaxima == maxima);
+    }
+    assert(SketchKernels::simdEnabled() == SketchKernels::simdSupported());
+}
+
+// ns per symbol event and bytes held: each sketch against the exact map it replaces
+void benchmark_Counting(std::size_t n, std::size_t universe)
+{
+    const auto stream = zipfStream(n, universe, 7);
+    const auto perEvent = [n](double elapsed) { return elapsed * 1e9 / static_cast<double>(n); };
+
+    CountMinSketch countMin;
+    StopWatch stopWatch;
+    stopWatch.Start();
+    for (const std::string& symbol : stream) countMin.add(symbol);
+    stopWatch.Stop();
+    const double countMinTime = stopWatch.ElapsedTime();
+    HyperLogLog distinct;
+    stopWatch.Start();
+    for (const std::string& symbol : stream) distinct.add(symbol);
+    stopWatch.Stop();
+    const double hllTime = stopWatch.ElapsedTime();
+    SpaceSaving<std::string> top(64);
+    stopWatch.Start();
+    for (const std::string& symbol : stream) top.add(std::string_view(symbol));
+    stopWatch.Stop();
+    const double topTime = stopWatch.ElapsedTime();
+    FeedStatistics statistics;
+    stopWatch.Start();
+    for (std::size_t i = 0; i < n; ++i) statistics.recordTrade(stream[i], "XNAS", 100);
+    stopWatch.Stop();
+    const double feedTime = stopWatch.ElapsedTime();
+
+    std::map<std::string, std::uint64_t> ordered;
+    stopWatch.Start();
+    for (const std::string& symbol : stream) ++ordered[symbol];
+    stopWatch.Stop();
+    const double mapTime = stopWatch.ElapsedTime();
+    std::unordered_map<std::string, std::uint64_t> hashed;
+    stopWatch.Start();
+    for (const std::string& symbol : stream) ++hashed[symbol];
+    stopWatch.Stop();
+    const double hashTime = stopWatch.ElapsedTime();
+    std::unordered_set<std::string> seen;
+    stopWatch.Start();
+    for (const std::string& symbol : stream) seen.insert(symbol);
+    stopWatch.Stop();
+    const double setTime = stopWatch.ElapsedTime();
+
+    // The exact containers are the reference for the sketches
+    std::uint64_t total = 0;
+    for (const auto& [symbol, count] : ordered) total += count;
+    assert(total == n && statistics.tradeCount() == n && countMin.totalCount() == n);
+    assert(ordered.size() == hashed.size() && seen.size() == hashed.size());
+    assert(countMin.estimate(stream[0]) >= hashed[stream[0]]);
+    const double distinctCount = static_cast<double>(seen.size());
+    assert(std::abs(distinct.estimate() - distinctCount) / distinctCount < 4 * distinct.standardError());
+
+    // Nodes of a map hold the key, the count and about four pointers
+    const std::size_t exactBytes = hashed.size() * (sizeof(std::string) + sizeof(std::uint64_t) + 4 * sizeof(void*));
+    std::cout << universe << "\t\t" << perEvent(countMinTime) << "\t\t" << perEvent(hllTime) << "\t\t"
+              << perEvent(topTime) << "\t\t" << perEvent(feedTime) << "\t\t" << perEvent(mapTime) << "\t\t"
+              << perEvent(hashTime) << "\t\t" << perEvent(setTime) << "\t\t" << statistics.bytes() / 1024 << " KB\t"
+              << exactBytes / 1024 << " KB" << std::endl;
+}
+
+// µs to merge a Count-Min table and a dense HyperLogLog, with the AVX2 kernels and without
+void benchmark_Merge(std::size_t width)
+{
+    constexpr int ROUNDS = 200;
+    CountMinSketch target(width, 4), source(width, 4);
+    HyperLogLog registers(16), more(16);
+    for (std::uint64_t i = 0; i < 200'000; ++i)
+    {
+        source.add(i);
+        more.add(i);
+    }
+    registers.merge(more);
+
+    const auto run = [&]
+    {
+        StopWatch stopWatch;
+        stopWatch.Start();
+        for (int i = 0; i < ROUNDS; ++i)
+        {
+            target.merge(source);
+            registers.merge(more);
+        }
+        stopWatch.Stop();
+        return stopWatch.ElapsedTime() * 1e6 / ROUNDS;
+    };
+
+    SketchKernels::enableSimd(false);
+    const double portable = run();
+    SketchKernels::enableSimd(true);
+    const double vectorized = run();
+    // Both runs merged the source into the target ROUNDS times, and the registers only ever saw 200'000 keys
+    assert(target.totalCount() == 2 * ROUNDS * source.totalCount());
+    assert(std::abs(registers.estimate() - 200'000.0) / 200'000.0 < 4 * registers.standardError());
+
+    std::cout << width * 4 * sizeof(std::uint64_t) / 1024 << " KB\t\t" << portable << "\t\t" << vectorized
+              << (SketchKernels::simdSupported() ? "" : " (no AVX2)") << std::endl;
 }
 
 int main()
 {
     test_Quote();
     test_Trade();
+    test_Hashing();
+    test_CountMin();
+    test_CountMinMerge();
+    test_CountSketch();
+    test_HyperLogLog();
+    test_HyperLogLogMerge();
+    test_SpaceSaving();
+    test_FeedStatistics();
+    test_Kernels();
+
+    std::cout << "Symbols\t\tCount-Min\tHyperLogLog\tSpaceSaving\tFeedStats\tmap\t\tunordered_map\tunordered_set\tSketches\tExact (ns per event)" << std::endl;
+    for (std::size_t universe : {1'000, 100'000, 1'000'000}) benchmark_Counting(2'000'000, universe);
+
+    std::cout << "Table\t\tPortable\tAVX2 (µs per merge)" << std::endl;
+    for (std::size_t width : {2048, 32768}) benchmark_Merge(width);
+
+    std::cout << "*** ALL TESTS COMPLETE ***" << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}